@@ -4,8 +4,6 @@ endif()
 
 find_package(Threads REQUIRED MODULE)
 
-find_package(OpenMP REQUIRED MODULE)
-
 find_package(Boost 1.86.0 REQUIRED CONFIG
   COMPONENTS
     serialization
@@ -172,3 +172,32 @@ function(boyle_cxx_test)
 
   add_test(NAME ${BOYLE_CXX_TEST_NAME} COMMAND ${BOYLE_CXX_TEST_NAME})
 endfunction()
+
+function(boyle_cxx_binary)
+  if(NOT BOYLE_BUILD_TOOLS)
+    return()
+  endif()
+
+  cmake_parse_arguments(BOYLE_CXX_BINARY
+    ""
+    "NAME"
+    "SRCS;COPTS;DEFINES;LINKOPTS;DEPS"
+    ${ARGN}
+  )
+
+  add_executable(${BOYLE_CXX_BINARY_NAME} ${BOYLE_CXX_BINARY_SRCS})
+  set_property(TARGET ${BOYLE_CXX_BINARY_NAME} PROPERTY FOLDER ${BOYLE_IDE_FOLDER}/tools)
+  target_include_directories(${BOYLE_CXX_BINARY_NAME}
+    PRIVATE
+      "$<BUILD_INTERFACE:${CMAKE_SOURCE_DIR}/src>"
+      "$<INSTALL_INTERFACE:${CMAKE_INSTALL_INCLUDEDIR}>"
+  )
+  target_compile_options(${BOYLE_CXX_BINARY_NAME} PRIVATE ${BOYLE_CXX_BINARY_COPTS})
+  target_compile_definitions(${BOYLE_CXX_BINARY_NAME} PRIVATE ${BOYLE_CXX_BINARY_DEFINES})
+  target_link_options(${BOYLE_CXX_BINARY_NAME} PRIVATE ${BOYLE_CXX_BINARY_LINKOPTS})
+  target_link_libraries(${BOYLE_CXX_BINARY_NAME}
+    PRIVATE
+      cxxopts::cxxopts
+      ${BOYLE_CXX_BINARY_DEPS}
+  )
+endfunction()
@@ -0,0 +1,131 @@
+/**
+ * @file alloc_counter.cpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2025-02-05
+ *
+ * @copyright Copyright (c) 2025 Boyle Development Team.
+ *            All rights reserved.
+ *
+ */
+
+#include "boyle/common/utils/alloc_counter.hpp"
+
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+// Trivially constructible, so it is constant-initialized and safe to touch from operator new at
+// any point of a thread's lifetime.
+thread_local ::boyle::common::AllocStats t_alloc_stats{};
+
+[[using gnu: always_inline]]
+inline auto countedAlloc(std::size_t size) noexcept -> void* {
+    ++t_alloc_stats.allocations;
+    t_alloc_stats.bytes += size;
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+[[using gnu: always_inline]]
+inline auto countedAlignedAlloc(std::size_t size, std::align_val_t align) noexcept -> void* {
+    ++t_alloc_stats.allocations;
+    t_alloc_stats.bytes += size;
+    const auto alignment{static_cast<std::size_t>(align)};
+    return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+}
+
+[[using gnu: always_inline]]
+inline auto countedFree(void* ptr) noexcept -> void {
+    if (ptr != nullptr) {
+        ++t_alloc_stats.deallocations;
+        std::free(ptr);
+    }
+    return;
+}
+
+} // namespace
+
+namespace boyle::common::detail {
+
+auto threadAllocStats() noexcept -> AllocStats& { return t_alloc_stats; }
+
+} // namespace boyle::common::detail
+
+// NOLINTBEGIN(cert-dcl58-cpp, misc-new-delete-overloads)
+
+auto operator new(std::size_t size) -> void* {
+    void* const ptr{countedAlloc(size)};
+    if (ptr == nullptr) [[unlikely]] {
+        throw std::bad_alloc{};
+    }
+    return ptr;
+}
+
+auto operator new[](std::size_t size) -> void* { return ::operator new(size); }
+
+auto operator new(std::size_t size, const std::nothrow_t& /*tag*/) noexcept -> void* {
+    return countedAlloc(size);
+}
+
+auto operator new[](std::size_t size, const std::nothrow_t& /*tag*/) noexcept -> void* {
+    return countedAlloc(size);
+}
+
+auto operator new(std::size_t size, std::align_val_t align) -> void* {
+    void* const ptr{countedAlignedAlloc(size, align)};
+    if (ptr == nullptr) [[unlikely]] {
+        throw std::bad_alloc{};
+    }
+    return ptr;
+}
+
+auto operator new[](std::size_t size, std::align_val_t align) -> void* {
+    return ::operator new(size, align);
+}
+
+auto operator new(std::size_t size, std::align_val_t align, const std::nothrow_t& /*tag*/) noexcept
+    -> void* {
+    return countedAlignedAlloc(size, align);
+}
+
+auto operator new[](
+    std::size_t size, std::align_val_t align, const std::nothrow_t& /*tag*/
+) noexcept -> void* {
+    return countedAlignedAlloc(size, align);
+}
+
+auto operator delete(void* ptr) noexcept -> void { countedFree(ptr); }
+
+auto operator delete[](void* ptr) noexcept -> void { countedFree(ptr); }
+
+auto operator delete(void* ptr, std::size_t /*size*/) noexcept -> void { countedFree(ptr); }
+
+auto operator delete[](void* ptr, std::size_t /*size*/) noexcept -> void { countedFree(ptr); }
+
+auto operator delete(void* ptr, std::align_val_t /*align*/) noexcept -> void { countedFree(ptr); }
+
+auto operator delete[](void* ptr, std::align_val_t /*align*/) noexcept -> void {
+    countedFree(ptr);
+}
+
+auto operator delete(void* ptr, std::size_t /*size*/, std::align_val_t /*align*/) noexcept
+    -> void {
+    countedFree(ptr);
+}
+
+auto operator delete[](void* ptr, std::size_t /*size*/, std::align_val_t /*align*/) noexcept
+    -> void {
+    countedFree(ptr);
+}
+
+auto operator delete(void* ptr, const std::nothrow_t& /*tag*/) noexcept -> void {
+    countedFree(ptr);
+}
+
+auto operator delete[](void* ptr, const std::nothrow_t& /*tag*/) noexcept -> void {
+    countedFree(ptr);
+}
+
+// NOLINTEND(cert-dcl58-cpp, misc-new-delete-overloads)
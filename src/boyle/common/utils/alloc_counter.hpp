@@ -0,0 +1,97 @@
+/**
+ * @file alloc_counter.hpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2025-02-05
+ *
+ * @copyright Copyright (c) 2025 Boyle Development Team.
+ *            All rights reserved.
+ *
+ */
+
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <utility>
+
+/**
+ * @brief doctest assertions that the expression performs no heap allocation on the calling
+ * thread. Only usable in targets linked against common_alloc_counter.
+ */
+#define CHECK_NO_ALLOC(...) \
+    CHECK_EQ(::boyle::common::countAllocations([&]() -> void { (void)(__VA_ARGS__); }), 0)
+#define REQUIRE_NO_ALLOC(...) \
+    REQUIRE_EQ(::boyle::common::countAllocations([&]() -> void { (void)(__VA_ARGS__); }), 0)
+
+namespace boyle::common {
+
+struct [[nodiscard]] AllocStats final {
+    std::size_t allocations{0};
+    std::size_t deallocations{0};
+    std::size_t bytes{0};
+};
+
+namespace detail {
+
+/**
+ * @brief Counters of the calling thread, bumped by the replacement global operator new/delete
+ * defined next to it in alloc_counter.cpp. Referencing this function is what makes the linker pull
+ * the replacements in.
+ */
+auto threadAllocStats() noexcept -> AllocStats&;
+
+} // namespace detail
+
+/**
+ * @brief Counts the heap allocations made by the calling thread since construction or the last
+ * reset. Allocations on other threads are not seen.
+ */
+class [[nodiscard]] AllocCounter final {
+  public:
+    AllocCounter(const AllocCounter& other) noexcept = delete;
+    auto operator=(const AllocCounter& other) noexcept -> AllocCounter& = delete;
+    AllocCounter(AllocCounter&& other) noexcept = delete;
+    auto operator=(AllocCounter&& other) noexcept -> AllocCounter& = delete;
+    ~AllocCounter() noexcept = default;
+
+    [[using gnu: always_inline]]
+    AllocCounter() noexcept
+        : m_start{detail::threadAllocStats()} {}
+
+    [[using gnu: always_inline]]
+    auto reset() noexcept -> void {
+        m_start = detail::threadAllocStats();
+        return;
+    }
+
+    [[using gnu: always_inline]]
+    auto allocations() const noexcept -> std::size_t {
+        return detail::threadAllocStats().allocations - m_start.allocations;
+    }
+
+    [[using gnu: always_inline]]
+    auto deallocations() const noexcept -> std::size_t {
+        return detail::threadAllocStats().deallocations - m_start.deallocations;
+    }
+
+    [[using gnu: always_inline]]
+    auto bytes() const noexcept -> std::size_t {
+        return detail::threadAllocStats().bytes - m_start.bytes;
+    }
+
+  private:
+    AllocStats m_start;
+};
+
+template <std::invocable Func>
+[[using gnu: always_inline]]
+inline auto countAllocations(Func&& func) -> std::size_t {
+    const AllocCounter counter{};
+    std::invoke(std::forward<Func>(func));
+    return counter.allocations();
+}
+
+} // namespace boyle::common
@@ -18,7 +18,21 @@
 
 #include "spdlog/fmt/chrono.h"
 
+#include "boyle/common/utils/latency_histogram.hpp"
 #include "boyle/common/utils/logging.hpp"
+#include "boyle/common/utils/macros.hpp"
+
+/**
+ * @brief Times the enclosing scope into the calling thread's shard of the named latency histogram
+ * instead of logging it.
+ */
+#define BOYLE_CHRONO_HISTOGRAM(name)                                                           \
+    thread_local ::boyle::common::LatencyHistogram& BOYLE_CONCAT(                              \
+        boyle_chrono_histogram_, __LINE__                                                      \
+    ){::boyle::common::LatencyRegistry::getInstance()->histogram(name)};                       \
+    const ::boyle::common::ChronoInspector<> BOYLE_CONCAT(boyle_chrono_inspector_, __LINE__) { \
+        BOYLE_CONCAT(boyle_chrono_histogram_, __LINE__)                                        \
+    }
 
 namespace boyle::common {
 
@@ -36,6 +50,10 @@ class [[nodiscard]] ChronoInspector final {
     ChronoInspector(ChronoInspector&& other) noexcept = delete;
     auto operator=(ChronoInspector&& other) noexcept -> ChronoInspector& = delete;
     ~ChronoInspector() noexcept {
+        if (m_histogram != nullptr) {
+            m_histogram->record(elapsed<std::chrono::nanoseconds>().count());
+            return;
+        }
         m_logger->log(
             m_source_loc, boyle::common::LogLevel::trace, "{0:s}: {1}.", m_info, elapsed()
         );
@@ -65,6 +83,14 @@ class [[nodiscard]] ChronoInspector final {
           },
           m_info{info}, m_start{clock_type::now()} {}
 
+    /**
+     * @brief Histogram mode: the elapsed time is recorded into the histogram on destruction and
+     * nothing is logged.
+     */
+    [[using gnu: always_inline]]
+    explicit ChronoInspector(LatencyHistogram& histogram) noexcept
+        : m_histogram{&histogram}, m_start{clock_type::now()} {}
+
     [[using gnu: always_inline]]
     auto reset() noexcept -> void {
         m_start = clock_type::now();
@@ -78,9 +104,10 @@ class [[nodiscard]] ChronoInspector final {
     }
 
   private:
-    std::shared_ptr<boyle::common::Logger> m_logger;
-    spdlog::source_loc m_source_loc;
-    std::string_view m_info;
+    std::shared_ptr<boyle::common::Logger> m_logger{nullptr};
+    spdlog::source_loc m_source_loc{};
+    std::string_view m_info{};
+    LatencyHistogram* m_histogram{nullptr};
     time_point m_start;
 };
 
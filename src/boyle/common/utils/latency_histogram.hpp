@@ -0,0 +1,430 @@
+/**
+ * @file latency_histogram.hpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2025-01-20
+ *
+ * @copyright Copyright (c) 2025 Boyle Development Team.
+ *            All rights reserved.
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "spdlog/fmt/chrono.h"
+
+#include "boyle/common/utils/logging.hpp"
+#include "boyle/common/utils/macros.hpp"
+
+namespace boyle::common {
+
+/**
+ * @brief Log-linear (HDR-style) histogram of nanosecond latencies written by a single thread.
+ * Values below 64 ns are exact, larger values fall into buckets of 1/32 of their power-of-two
+ * range, so every recorded value is known to within ~3%. Readers on other threads merge the
+ * counts with relaxed loads while the owner keeps recording.
+ */
+class [[nodiscard]] LatencyHistogram final {
+  public:
+    static constexpr std::size_t kSubBucketBits{5};
+    static constexpr std::size_t kSubBucketCount{std::size_t{1} << kSubBucketBits};
+    static constexpr std::size_t kMaxValueBits{46};
+    static constexpr std::size_t kNumBuckets{
+        (kMaxValueBits - kSubBucketBits + 1) * kSubBucketCount
+    };
+    static constexpr std::uint64_t kMaxValue{(std::uint64_t{1} << kMaxValueBits) - 1};
+
+    LatencyHistogram() noexcept = default;
+    LatencyHistogram(const LatencyHistogram& other) noexcept = delete;
+    auto operator=(const LatencyHistogram& other) noexcept -> LatencyHistogram& = delete;
+    LatencyHistogram(LatencyHistogram&& other) noexcept = delete;
+    auto operator=(LatencyHistogram&& other) noexcept -> LatencyHistogram& = delete;
+    ~LatencyHistogram() noexcept = default;
+
+    [[using gnu: const, always_inline]]
+    static constexpr auto bucketIndex(std::uint64_t value) noexcept -> std::size_t {
+        value = std::min(value, kMaxValue);
+        const auto width{static_cast<std::size_t>(std::bit_width(value))};
+        const std::size_t shift{width > kSubBucketBits + 1 ? width - kSubBucketBits - 1 : 0};
+        return shift * kSubBucketCount + static_cast<std::size_t>(value >> shift);
+    }
+
+    [[using gnu: const, always_inline]]
+    static constexpr auto bucketLowerBound(std::size_t index) noexcept -> std::uint64_t {
+        if (index < kSubBucketCount * 2) {
+            return index;
+        }
+        const std::size_t shift{index / kSubBucketCount - 1};
+        return static_cast<std::uint64_t>(index - shift * kSubBucketCount) << shift;
+    }
+
+    [[using gnu: const, always_inline]]
+    static constexpr auto bucketUpperBound(std::size_t index) noexcept -> std::uint64_t {
+        return index + 1 < kNumBuckets ? bucketLowerBound(index + 1) - 1 : kMaxValue;
+    }
+
+    [[using gnu: always_inline, hot]]
+    auto record(std::int64_t nanoseconds) noexcept -> void {
+        const auto value{static_cast<std::uint64_t>(std::max<std::int64_t>(nanoseconds, 0))};
+        m_counts[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+        m_total.fetch_add(1, std::memory_order_relaxed);
+        m_sum.fetch_add(value, std::memory_order_relaxed);
+        if (value < m_min.load(std::memory_order_relaxed)) {
+            m_min.store(value, std::memory_order_relaxed);
+        }
+        if (value > m_max.load(std::memory_order_relaxed)) {
+            m_max.store(value, std::memory_order_relaxed);
+        }
+        return;
+    }
+
+    [[using gnu: always_inline]]
+    auto count() const noexcept -> std::uint64_t {
+        return m_total.load(std::memory_order_relaxed);
+    }
+
+    [[using gnu: always_inline]]
+    auto count(std::size_t index) const noexcept -> std::uint64_t {
+        return m_counts[index].load(std::memory_order_relaxed);
+    }
+
+    [[using gnu: always_inline]]
+    auto sum() const noexcept -> std::uint64_t {
+        return m_sum.load(std::memory_order_relaxed);
+    }
+
+    [[using gnu: always_inline]]
+    auto min() const noexcept -> std::uint64_t {
+        return m_min.load(std::memory_order_relaxed);
+    }
+
+    [[using gnu: always_inline]]
+    auto max() const noexcept -> std::uint64_t {
+        return m_max.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Clears the histogram. Recordings racing with the reset may survive it or be lost.
+     */
+    [[using gnu: always_inline]]
+    auto reset() noexcept -> void {
+        for (std::atomic<std::uint64_t>& count : m_counts) {
+            count.store(0, std::memory_order_relaxed);
+        }
+        m_total.store(0, std::memory_order_relaxed);
+        m_sum.store(0, std::memory_order_relaxed);
+        m_min.store(std::numeric_limits<std::uint64_t>::max(), std::memory_order_relaxed);
+        m_max.store(0, std::memory_order_relaxed);
+        return;
+    }
+
+  private:
+    std::array<std::atomic<std::uint64_t>, kNumBuckets> m_counts{};
+    std::atomic<std::uint64_t> m_total{0};
+    std::atomic<std::uint64_t> m_sum{0};
+    std::atomic<std::uint64_t> m_min{std::numeric_limits<std::uint64_t>::max()};
+    std::atomic<std::uint64_t> m_max{0};
+};
+
+/**
+ * @brief Plain copy of one or more LatencyHistogram merged together, used for queries.
+ */
+class [[nodiscard]] LatencySnapshot final {
+  public:
+    LatencySnapshot() : m_counts(LatencyHistogram::kNumBuckets, 0) {}
+    LatencySnapshot(const LatencySnapshot& other) = default;
+    auto operator=(const LatencySnapshot& other) -> LatencySnapshot& = default;
+    LatencySnapshot(LatencySnapshot&& other) noexcept = default;
+    auto operator=(LatencySnapshot&& other) noexcept -> LatencySnapshot& = default;
+    ~LatencySnapshot() noexcept = default;
+
+    [[using gnu: always_inline]]
+    auto merge(const LatencyHistogram& histogram) noexcept -> void {
+        for (std::size_t i{0}; i < LatencyHistogram::kNumBuckets; ++i) {
+            const std::uint64_t count{histogram.count(i)};
+            m_counts[i] += count;
+            m_total += count;
+        }
+        m_sum += histogram.sum();
+        m_min = std::min(m_min, histogram.min());
+        m_max = std::max(m_max, histogram.max());
+        return;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto count() const noexcept -> std::uint64_t {
+        return m_total;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto min() const noexcept -> std::chrono::nanoseconds {
+        return std::chrono::nanoseconds{m_total == 0 ? 0 : static_cast<std::int64_t>(m_min)};
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto max() const noexcept -> std::chrono::nanoseconds {
+        return std::chrono::nanoseconds{static_cast<std::int64_t>(m_max)};
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto mean() const noexcept -> std::chrono::nanoseconds {
+        return std::chrono::nanoseconds{
+            m_total == 0 ? 0 : static_cast<std::int64_t>(m_sum / m_total)
+        };
+    }
+
+    /**
+     * @brief Smallest bucket midpoint that at least the given fraction of samples do not exceed,
+     * clamped to the observed range.
+     */
+    [[using gnu: pure]]
+    auto percentile(double fraction) const noexcept -> std::chrono::nanoseconds {
+        if (m_total == 0) {
+            return std::chrono::nanoseconds{0};
+        }
+        const auto rank{std::max<std::uint64_t>(
+            static_cast<std::uint64_t>(std::ceil(std::clamp(fraction, 0.0, 1.0) * m_total)), 1
+        )};
+        std::uint64_t accumulated{0};
+        for (std::size_t i{0}; i < LatencyHistogram::kNumBuckets; ++i) {
+            accumulated += m_counts[i];
+            if (accumulated >= rank) {
+                const std::uint64_t lower{LatencyHistogram::bucketLowerBound(i)};
+                const std::uint64_t upper{LatencyHistogram::bucketUpperBound(i)};
+                const std::uint64_t value{std::clamp(lower + (upper - lower) / 2, m_min, m_max)};
+                return std::chrono::nanoseconds{static_cast<std::int64_t>(value)};
+            }
+        }
+        return max();
+    }
+
+  private:
+    std::vector<std::uint64_t> m_counts;
+    std::uint64_t m_total{0};
+    std::uint64_t m_sum{0};
+    std::uint64_t m_min{std::numeric_limits<std::uint64_t>::max()};
+    std::uint64_t m_max{0};
+};
+
+struct [[nodiscard]] LatencyStats final {
+    std::string name;
+    std::uint64_t count;
+    std::chrono::nanoseconds min;
+    std::chrono::nanoseconds mean;
+    std::chrono::nanoseconds p50;
+    std::chrono::nanoseconds p90;
+    std::chrono::nanoseconds p99;
+    std::chrono::nanoseconds p999;
+    std::chrono::nanoseconds max;
+};
+
+/**
+ * @brief Process-wide set of named latency histograms. Every thread records into its own shard of
+ * a name, so recording never contends; shards are merged when a snapshot or report is taken.
+ */
+class LatencyRegistry final {
+  public:
+    MAKE_SINGLETON(LatencyRegistry);
+    ~LatencyRegistry() noexcept { stopReporter(); }
+
+    /**
+     * @brief The calling thread's shard of the named histogram. Repeated calls from one thread
+     * return the same shard, and the shards of exited threads are handed over to new ones, so a
+     * name never holds more shards than threads recording it at once. The reference stays valid
+     * for the lifetime of the process; call sites still cache it in a thread_local to skip the
+     * lookup.
+     */
+    auto histogram(std::string_view name) -> LatencyHistogram& {
+        thread_local const ThreadLease lease{};
+        const std::thread::id self{std::this_thread::get_id()};
+        const std::lock_guard<std::mutex> lock{m_mutex};
+        Entry& entry{findOrInsert(name)};
+        Shard* released{nullptr};
+        for (Shard& shard : entry.shards) {
+            if (shard.owner == self) {
+                return *shard.histogram;
+            }
+            if (released == nullptr && shard.owner == std::thread::id{}) {
+                released = &shard;
+            }
+        }
+        if (released != nullptr) {
+            released->owner = self;
+            return *released->histogram;
+        }
+        entry.shards.push_back(Shard{self, std::make_unique<LatencyHistogram>()});
+        return *entry.shards.back().histogram;
+    }
+
+    [[nodiscard]]
+    auto numShards(std::string_view name) const -> std::size_t {
+        const std::lock_guard<std::mutex> lock{m_mutex};
+        for (const Entry& entry : m_entries) {
+            if (entry.name == name) {
+                return entry.shards.size();
+            }
+        }
+        return 0;
+    }
+
+    [[nodiscard]]
+    auto snapshot(std::string_view name) const -> LatencySnapshot {
+        const std::lock_guard<std::mutex> lock{m_mutex};
+        LatencySnapshot result{};
+        for (const Entry& entry : m_entries) {
+            if (entry.name == name) {
+                for (const Shard& shard : entry.shards) {
+                    result.merge(*shard.histogram);
+                }
+            }
+        }
+        return result;
+    }
+
+    [[nodiscard]]
+    auto report() const -> std::vector<LatencyStats> {
+        const std::lock_guard<std::mutex> lock{m_mutex};
+        std::vector<LatencyStats> result;
+        result.reserve(m_entries.size());
+        for (const Entry& entry : m_entries) {
+            LatencySnapshot snapshot{};
+            for (const Shard& shard : entry.shards) {
+                snapshot.merge(*shard.histogram);
+            }
+            result.push_back(LatencyStats{
+                .name = entry.name,
+                .count = snapshot.count(),
+                .min = snapshot.min(),
+                .mean = snapshot.mean(),
+                .p50 = snapshot.percentile(0.5),
+                .p90 = snapshot.percentile(0.9),
+                .p99 = snapshot.percentile(0.99),
+                .p999 = snapshot.percentile(0.999),
+                .max = snapshot.max()
+            });
+        }
+        return result;
+    }
+
+    auto logReport(const std::shared_ptr<Logger>& logger) const -> void {
+        for (const LatencyStats& stats : report()) {
+            logger->info(
+                "{0:s}: count = {1:d}, min = {2}, mean = {3}, p50 = {4}, p90 = {5}, p99 = {6}, "
+                "p99.9 = {7}, max = {8}.",
+                stats.name, stats.count, stats.min, stats.mean, stats.p50, stats.p90, stats.p99,
+                stats.p999, stats.max
+            );
+        }
+        return;
+    }
+
+    [[using gnu: always_inline]]
+    auto startReporter(
+        std::shared_ptr<Logger> logger, std::chrono::milliseconds period = std::chrono::seconds{10}
+    ) -> void {
+        stopReporter();
+        m_reporter =
+            std::jthread{[this, logger = std::move(logger), period](std::stop_token stop_token
+                         ) -> void {
+                auto next{std::chrono::steady_clock::now() + period};
+                while (!stop_token.stop_requested()) {
+                    if (std::chrono::steady_clock::now() >= next) {
+                        logReport(logger);
+                        next += period;
+                    }
+                    std::this_thread::sleep_for(std::chrono::milliseconds{10});
+                }
+            }};
+        return;
+    }
+
+    [[using gnu: always_inline]]
+    auto stopReporter() noexcept -> void {
+        if (m_reporter.joinable()) {
+            m_reporter.request_stop();
+            m_reporter.join();
+        }
+        return;
+    }
+
+    auto reset() -> void {
+        const std::lock_guard<std::mutex> lock{m_mutex};
+        for (Entry& entry : m_entries) {
+            for (Shard& shard : entry.shards) {
+                shard.histogram->reset();
+            }
+        }
+        return;
+    }
+
+  private:
+    struct Shard final {
+        std::thread::id owner;
+        std::unique_ptr<LatencyHistogram> histogram;
+    };
+
+    struct Entry final {
+        std::string name;
+        std::vector<Shard> shards;
+    };
+
+    /**
+     * @brief Releases the shards of a thread that called histogram() once it exits. Their counts
+     * stay in the registry.
+     */
+    struct ThreadLease final {
+        ~ThreadLease() noexcept { LatencyRegistry::getInstance()->releaseThread(); }
+    };
+
+    LatencyRegistry() noexcept = default;
+
+    auto releaseThread() noexcept -> void {
+        try {
+            const std::thread::id self{std::this_thread::get_id()};
+            const std::lock_guard<std::mutex> lock{m_mutex};
+            for (Entry& entry : m_entries) {
+                for (Shard& shard : entry.shards) {
+                    if (shard.owner == self) {
+                        shard.owner = std::thread::id{};
+                    }
+                }
+            }
+        } catch (...) {
+            // Shards that stay owned are only merged from now on.
+        }
+        return;
+    }
+
+    auto findOrInsert(std::string_view name) -> Entry& {
+        for (Entry& entry : m_entries) {
+            if (entry.name == name) {
+                return entry;
+            }
+        }
+        return m_entries.emplace_back(Entry{std::string{name}, {}});
+    }
+
+    mutable std::mutex m_mutex{};
+    std::vector<Entry> m_entries{};
+    std::jthread m_reporter{};
+};
+
+} // namespace boyle::common
@@ -12,8 +12,16 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <memory>
+#include <mutex>
 #include <string_view>
+#include <utility>
+#include <vector>
 
 #include "spdlog/async.h"
 #include "spdlog/sinks/basic_file_sink.h"
@@ -133,12 +141,261 @@
 #define BOYLE_LOG_CRITICAL_IF(condition, ...) \
     BOYLE_LOG_LOGGER_CRITICAL_IF(spdlog::default_logger_raw(), condition, __VA_ARGS__)
 
+#define BOYLE_LOG_LOGGER_CALL_EVERY_N(logger, level, n, ...)                                 \
+    BOYLE_LOG_LOGGER_CALL_IF(                                                                \
+        logger, level,                                                                       \
+        ([&]() noexcept -> bool {                                                            \
+            static ::boyle::common::LogEveryN boyle_log_gate{static_cast<std::uint64_t>(n)}; \
+            return boyle_log_gate();                                                         \
+        }()),                                                                                \
+        __VA_ARGS__                                                                          \
+    )
+
+#define BOYLE_LOG_LOGGER_CALL_THROTTLED(logger, level, period, ...)     \
+    BOYLE_LOG_LOGGER_CALL_IF(                                           \
+        logger, level,                                                  \
+        ([&]() noexcept -> bool {                                       \
+            static ::boyle::common::LogThrottle boyle_log_gate{period}; \
+            return boyle_log_gate();                                    \
+        }()),                                                           \
+        __VA_ARGS__                                                     \
+    )
+
+#define BOYLE_LOG_LOGGER_TRACE_EVERY_N(logger, n, ...) \
+    BOYLE_LOG_LOGGER_CALL_EVERY_N(logger, spdlog::level::trace, n, __VA_ARGS__)
+
+#define BOYLE_LOG_LOGGER_DEBUG_EVERY_N(logger, n, ...) \
+    BOYLE_LOG_LOGGER_CALL_EVERY_N(logger, spdlog::level::debug, n, __VA_ARGS__)
+
+#define BOYLE_LOG_LOGGER_INFO_EVERY_N(logger, n, ...) \
+    BOYLE_LOG_LOGGER_CALL_EVERY_N(logger, spdlog::level::info, n, __VA_ARGS__)
+
+#define BOYLE_LOG_LOGGER_WARN_EVERY_N(logger, n, ...) \
+    BOYLE_LOG_LOGGER_CALL_EVERY_N(logger, spdlog::level::warn, n, __VA_ARGS__)
+
+#define BOYLE_LOG_LOGGER_ERROR_EVERY_N(logger, n, ...) \
+    BOYLE_LOG_LOGGER_CALL_EVERY_N(logger, spdlog::level::err, n, __VA_ARGS__)
+
+#define BOYLE_LOG_LOGGER_CRITICAL_EVERY_N(logger, n, ...) \
+    BOYLE_LOG_LOGGER_CALL_EVERY_N(logger, spdlog::level::critical, n, __VA_ARGS__)
+
+#define BOYLE_LOG_TRACE_EVERY_N(n, ...) \
+    BOYLE_LOG_LOGGER_TRACE_EVERY_N(spdlog::default_logger_raw(), n, __VA_ARGS__)
+
+#define BOYLE_LOG_DEBUG_EVERY_N(n, ...) \
+    BOYLE_LOG_LOGGER_DEBUG_EVERY_N(spdlog::default_logger_raw(), n, __VA_ARGS__)
+
+#define BOYLE_LOG_INFO_EVERY_N(n, ...) \
+    BOYLE_LOG_LOGGER_INFO_EVERY_N(spdlog::default_logger_raw(), n, __VA_ARGS__)
+
+#define BOYLE_LOG_WARN_EVERY_N(n, ...) \
+    BOYLE_LOG_LOGGER_WARN_EVERY_N(spdlog::default_logger_raw(), n, __VA_ARGS__)
+
+#define BOYLE_LOG_ERROR_EVERY_N(n, ...) \
+    BOYLE_LOG_LOGGER_ERROR_EVERY_N(spdlog::default_logger_raw(), n, __VA_ARGS__)
+
+#define BOYLE_LOG_CRITICAL_EVERY_N(n, ...) \
+    BOYLE_LOG_LOGGER_CRITICAL_EVERY_N(spdlog::default_logger_raw(), n, __VA_ARGS__)
+
+#define BOYLE_LOG_LOGGER_TRACE_THROTTLED(logger, period, ...) \
+    BOYLE_LOG_LOGGER_CALL_THROTTLED(logger, spdlog::level::trace, period, __VA_ARGS__)
+
+#define BOYLE_LOG_LOGGER_DEBUG_THROTTLED(logger, period, ...) \
+    BOYLE_LOG_LOGGER_CALL_THROTTLED(logger, spdlog::level::debug, period, __VA_ARGS__)
+
+#define BOYLE_LOG_LOGGER_INFO_THROTTLED(logger, period, ...) \
+    BOYLE_LOG_LOGGER_CALL_THROTTLED(logger, spdlog::level::info, period, __VA_ARGS__)
+
+#define BOYLE_LOG_LOGGER_WARN_THROTTLED(logger, period, ...) \
+    BOYLE_LOG_LOGGER_CALL_THROTTLED(logger, spdlog::level::warn, period, __VA_ARGS__)
+
+#define BOYLE_LOG_LOGGER_ERROR_THROTTLED(logger, period, ...) \
+    BOYLE_LOG_LOGGER_CALL_THROTTLED(logger, spdlog::level::err, period, __VA_ARGS__)
+
+#define BOYLE_LOG_LOGGER_CRITICAL_THROTTLED(logger, period, ...) \
+    BOYLE_LOG_LOGGER_CALL_THROTTLED(logger, spdlog::level::critical, period, __VA_ARGS__)
+
+#define BOYLE_LOG_TRACE_THROTTLED(period, ...) \
+    BOYLE_LOG_LOGGER_TRACE_THROTTLED(spdlog::default_logger_raw(), period, __VA_ARGS__)
+
+#define BOYLE_LOG_DEBUG_THROTTLED(period, ...) \
+    BOYLE_LOG_LOGGER_DEBUG_THROTTLED(spdlog::default_logger_raw(), period, __VA_ARGS__)
+
+#define BOYLE_LOG_INFO_THROTTLED(period, ...) \
+    BOYLE_LOG_LOGGER_INFO_THROTTLED(spdlog::default_logger_raw(), period, __VA_ARGS__)
+
+#define BOYLE_LOG_WARN_THROTTLED(period, ...) \
+    BOYLE_LOG_LOGGER_WARN_THROTTLED(spdlog::default_logger_raw(), period, __VA_ARGS__)
+
+#define BOYLE_LOG_ERROR_THROTTLED(period, ...) \
+    BOYLE_LOG_LOGGER_ERROR_THROTTLED(spdlog::default_logger_raw(), period, __VA_ARGS__)
+
+#define BOYLE_LOG_CRITICAL_THROTTLED(period, ...) \
+    BOYLE_LOG_LOGGER_CRITICAL_THROTTLED(spdlog::default_logger_raw(), period, __VA_ARGS__)
+
 namespace boyle::common {
 
 using Logger = spdlog::logger;
 using LogLevel = spdlog::level::level_enum;
 
-[[using gnu: pure]]
+enum class LogOverflowPolicy : std::uint8_t {
+    BLOCK = 0,
+    OVERRUN_OLDEST = 1,
+    DISCARD_NEW = 2
+};
+
+/**
+ * @brief Settings of the async thread pool shared by every logger made with makeLogger(). The
+ * default overruns the oldest queued message when the queue is full, so that a log storm on a
+ * planning thread never waits for the sinks.
+ */
+struct [[nodiscard]] LoggingConfig final {
+    std::size_t queue_size{8192};
+    std::size_t num_threads{1};
+    LogOverflowPolicy overflow_policy{LogOverflowPolicy::OVERRUN_OLDEST};
+};
+
+/**
+ * @brief Lock-free per-call-site gate that lets the 1st, (n + 1)-th, (2n + 1)-th, ... call pass.
+ */
+class [[nodiscard]] LogEveryN final {
+  public:
+    LogEveryN() noexcept = delete;
+    LogEveryN(const LogEveryN& other) noexcept = delete;
+    auto operator=(const LogEveryN& other) noexcept -> LogEveryN& = delete;
+    LogEveryN(LogEveryN&& other) noexcept = delete;
+    auto operator=(LogEveryN&& other) noexcept -> LogEveryN& = delete;
+    ~LogEveryN() noexcept = default;
+
+    [[using gnu: always_inline]]
+    explicit LogEveryN(std::uint64_t n) noexcept
+        : m_n{n == 0 ? 1 : n} {}
+
+    [[using gnu: always_inline, hot]]
+    auto operator()() noexcept -> bool {
+        return m_count.fetch_add(1, std::memory_order_relaxed) % m_n == 0;
+    }
+
+  private:
+    const std::uint64_t m_n;
+    std::atomic<std::uint64_t> m_count{0};
+};
+
+/**
+ * @brief Lock-free per-call-site gate that lets at most one call pass per period; concurrent
+ * callers race on a single compare-exchange and the losers are suppressed.
+ */
+class [[nodiscard]] LogThrottle final {
+  public:
+    using clock_type = std::chrono::steady_clock;
+
+    LogThrottle() noexcept = delete;
+    LogThrottle(const LogThrottle& other) noexcept = delete;
+    auto operator=(const LogThrottle& other) noexcept -> LogThrottle& = delete;
+    LogThrottle(LogThrottle&& other) noexcept = delete;
+    auto operator=(LogThrottle&& other) noexcept -> LogThrottle& = delete;
+    ~LogThrottle() noexcept = default;
+
+    template <typename Rep, typename Period>
+    [[using gnu: always_inline]]
+    explicit LogThrottle(std::chrono::duration<Rep, Period> period) noexcept
+        : m_period{std::chrono::duration_cast<clock_type::duration>(period).count()} {}
+
+    [[using gnu: always_inline, hot]]
+    auto operator()() noexcept -> bool {
+        const clock_type::rep now{clock_type::now().time_since_epoch().count()};
+        clock_type::rep next{m_next.load(std::memory_order_relaxed)};
+        return now >= next &&
+               m_next.compare_exchange_strong(next, now + m_period, std::memory_order_relaxed);
+    }
+
+  private:
+    const clock_type::rep m_period;
+    std::atomic<clock_type::rep> m_next{std::numeric_limits<clock_type::rep>::lowest()};
+};
+
+namespace detail {
+
+struct LoggingState final {
+    std::mutex mutex{};
+    LoggingConfig config{};
+    std::shared_ptr<spdlog::details::thread_pool> thread_pool{nullptr};
+};
+
+[[using gnu: always_inline]]
+inline auto loggingState() noexcept -> LoggingState& {
+    static LoggingState state{};
+    return state;
+}
+
+[[using gnu: const, always_inline]]
+inline auto toSpdlogPolicy(LogOverflowPolicy policy) noexcept -> spdlog::async_overflow_policy {
+    switch (policy) {
+    case LogOverflowPolicy::BLOCK:
+        return spdlog::async_overflow_policy::block;
+#if SPDLOG_VERSION >= 11200
+    case LogOverflowPolicy::DISCARD_NEW:
+        return spdlog::async_overflow_policy::discard_new;
+#endif
+    default:
+        return spdlog::async_overflow_policy::overrun_oldest;
+    }
+}
+
+[[using gnu: always_inline]]
+inline auto sharedThreadPool(LoggingState& state) -> std::shared_ptr<spdlog::details::thread_pool> {
+    if (state.thread_pool == nullptr) {
+        state.thread_pool = std::make_shared<spdlog::details::thread_pool>(
+            state.config.queue_size, state.config.num_threads
+        );
+        spdlog::details::registry::instance().set_tp(state.thread_pool);
+    }
+    return state.thread_pool;
+}
+
+} // namespace detail
+
+/**
+ * @brief Sets up the shared async thread pool. Only takes effect before the first makeLogger()
+ * call, since replacing the pool would orphan the loggers already bound to it; returns whether the
+ * configuration was applied.
+ */
+inline auto configureLogging(const LoggingConfig& config) -> bool {
+    detail::LoggingState& state{detail::loggingState()};
+    const std::lock_guard<std::mutex> lock{state.mutex};
+    if (state.thread_pool != nullptr) {
+        return false;
+    }
+    state.config = config;
+    detail::sharedThreadPool(state);
+    return true;
+}
+
+[[using gnu: always_inline]] [[nodiscard]]
+inline auto loggingConfig() -> LoggingConfig {
+    detail::LoggingState& state{detail::loggingState()};
+    const std::lock_guard<std::mutex> lock{state.mutex};
+    return state.config;
+}
+
+/**
+ * @brief Messages the shared thread pool has thrown away because its queue was full, whether by
+ * overrunning the oldest or by discarding the newest.
+ */
+[[using gnu: always_inline]] [[nodiscard]]
+inline auto droppedLogMessages() -> std::size_t {
+    detail::LoggingState& state{detail::loggingState()};
+    const std::lock_guard<std::mutex> lock{state.mutex};
+    if (state.thread_pool == nullptr) {
+        return 0;
+    }
+#if SPDLOG_VERSION >= 11200
+    return state.thread_pool->overrun_counter() + state.thread_pool->discard_counter();
+#else
+    return state.thread_pool->overrun_counter();
+#endif
+}
+
 inline auto makeLogger(std::string_view name, std::string_view log_file = "")
     -> std::shared_ptr<Logger> {
     std::vector<std::shared_ptr<spdlog::sinks::sink>> sinks{};
@@ -155,10 +412,11 @@ inline auto makeLogger(std::string_view name, std::string_view log_file = "")
         sinks.push_back(file_sink);
     }
 
-    spdlog::init_thread_pool(8192, 1);
-
+    detail::LoggingState& state{detail::loggingState()};
+    const std::lock_guard<std::mutex> lock{state.mutex};
     return std::make_shared<spdlog::async_logger>(
-        name.data(), sinks.cbegin(), sinks.cend(), spdlog::thread_pool()
+        name.data(), sinks.cbegin(), sinks.cend(), detail::sharedThreadPool(state),
+        detail::toSpdlogPolicy(state.config.overflow_policy)
     );
 }
 
@@ -12,6 +12,9 @@
 
 #pragma once
 
+#define BOYLE_CONCAT_IMPL(lhs, rhs) lhs##rhs
+#define BOYLE_CONCAT(lhs, rhs) BOYLE_CONCAT_IMPL(lhs, rhs)
+
 #define ENABLE_COPY(ClassName)                            \
     ClassName(const ClassName& other) noexcept = default; \
     auto operator=(const ClassName& other) noexcept -> ClassName& = default
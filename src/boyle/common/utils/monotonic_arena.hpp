@@ -0,0 +1,127 @@
+/**
+ * @file monotonic_arena.hpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2025-02-10
+ *
+ * @copyright Copyright (c) 2025 Boyle Development Team.
+ *            All rights reserved.
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+
+namespace boyle::common {
+
+/**
+ * @brief Bump allocator for the temporaries of one planning cycle. Allocations are carved out of
+ * an owned buffer; once it is exhausted further chunks come from the upstream resource and are
+ * counted as overflow, which tells how to size the buffer. Deallocation is a no-op and reset()
+ * hands the whole buffer back at once. Not thread-safe: keep one arena per planner thread.
+ */
+class [[nodiscard]] MonotonicArena final {
+  public:
+    static constexpr std::size_t kDefaultCapacity{std::size_t{1} << 20};
+
+    MonotonicArena(const MonotonicArena& other) noexcept = delete;
+    auto operator=(const MonotonicArena& other) noexcept -> MonotonicArena& = delete;
+    MonotonicArena(MonotonicArena&& other) noexcept = delete;
+    auto operator=(MonotonicArena&& other) noexcept -> MonotonicArena& = delete;
+    ~MonotonicArena() noexcept = default;
+
+    [[using gnu: always_inline]]
+    MonotonicArena()
+        : MonotonicArena(kDefaultCapacity) {}
+
+    [[using gnu: always_inline]]
+    explicit MonotonicArena(
+        std::size_t capacity, std::pmr::memory_resource* upstream = std::pmr::new_delete_resource()
+    )
+        : m_buffer{std::make_unique_for_overwrite<std::byte[]>(capacity)}, m_capacity{capacity},
+          m_upstream{upstream}, m_resource{m_buffer.get(), m_capacity, &m_upstream} {}
+
+    [[using gnu: always_inline]]
+    auto resource() noexcept -> std::pmr::memory_resource* {
+        return &m_resource;
+    }
+
+    template <typename T = std::byte>
+    [[using gnu: always_inline]]
+    auto allocator() noexcept -> std::pmr::polymorphic_allocator<T> {
+        return std::pmr::polymorphic_allocator<T>{&m_resource};
+    }
+
+    /**
+     * @brief Releases every allocation made since the last reset. Objects still using the arena
+     * must be gone by then: a QpProblem, DokMatrix, LilMatrix or pmr piecewise function built on
+     * the arena has to be destroyed before the reset, one that outlives it is left dangling.
+     */
+    [[using gnu: always_inline]]
+    auto reset() noexcept -> void {
+        m_resource.release();
+        m_upstream.clear();
+        return;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto capacity() const noexcept -> std::size_t {
+        return m_capacity;
+    }
+
+    /**
+     * @brief Bytes taken from the upstream resource since the last reset because the buffer ran
+     * out.
+     */
+    [[using gnu: pure, always_inline]]
+    auto overflow() const noexcept -> std::size_t {
+        return m_upstream.bytes();
+    }
+
+  private:
+    class CountingResource final : public std::pmr::memory_resource {
+      public:
+        explicit CountingResource(std::pmr::memory_resource* upstream) noexcept
+            : m_upstream{upstream} {}
+
+        [[using gnu: pure, always_inline]]
+        auto bytes() const noexcept -> std::size_t {
+            return m_bytes;
+        }
+
+        [[using gnu: always_inline]]
+        auto clear() noexcept -> void {
+            m_bytes = 0;
+            return;
+        }
+
+      private:
+        auto do_allocate(std::size_t bytes, std::size_t alignment) -> void* override {
+            m_bytes += bytes;
+            return m_upstream->allocate(bytes, alignment);
+        }
+
+        auto do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) -> void override {
+            m_upstream->deallocate(ptr, bytes, alignment);
+            return;
+        }
+
+        auto do_is_equal(const std::pmr::memory_resource& other) const noexcept -> bool override {
+            return this == &other;
+        }
+
+        std::pmr::memory_resource* m_upstream;
+        std::size_t m_bytes{0};
+    };
+
+    std::unique_ptr<std::byte[]> m_buffer;
+    std::size_t m_capacity;
+    CountingResource m_upstream;
+    std::pmr::monotonic_buffer_resource m_resource;
+};
+
+} // namespace boyle::common
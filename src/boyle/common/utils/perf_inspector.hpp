@@ -0,0 +1,270 @@
+/**
+ * @file perf_inspector.hpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2025-01-27
+ *
+ * @copyright Copyright (c) 2025 Boyle Development Team.
+ *            All rights reserved.
+ *
+ */
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <source_location>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "spdlog/fmt/chrono.h"
+
+#include "boyle/common/utils/logging.hpp"
+
+namespace boyle::common {
+
+enum class PerfEvent : std::uint8_t {
+    CYCLES = 0,
+    INSTRUCTIONS = 1,
+    CACHE_MISSES = 2,
+    BRANCH_MISSES = 3,
+    CONTEXT_SWITCHES = 4
+};
+
+inline constexpr std::size_t kNumPerfEvents{5};
+
+/**
+ * @brief Counter values of one thread; a counter the kernel refused to open stays invalid.
+ */
+struct [[nodiscard]] PerfCounterValues final {
+    std::array<std::uint64_t, kNumPerfEvents> values{};
+    std::array<bool, kNumPerfEvents> valid{};
+
+    [[using gnu: pure, always_inline]]
+    auto operator[](PerfEvent event) const noexcept -> std::uint64_t {
+        return values[static_cast<std::size_t>(event)];
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto available(PerfEvent event) const noexcept -> bool {
+        return valid[static_cast<std::size_t>(event)];
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto operator-(const PerfCounterValues& other) const noexcept -> PerfCounterValues {
+        PerfCounterValues result{};
+        for (std::size_t i{0}; i < kNumPerfEvents; ++i) {
+            result.valid[i] = valid[i] && other.valid[i];
+            result.values[i] = result.valid[i] ? values[i] - other.values[i] : 0;
+        }
+        return result;
+    }
+};
+
+/**
+ * @brief Hardware and software counters of the calling thread, opened as one perf_event group so
+ * that a snapshot costs a single read(2). Counters that cannot be opened (non-Linux builds,
+ * containers, perf_event_paranoid, virtual machines without a PMU) are left out and reported as
+ * unavailable instead of failing. Multiplexed counters are scaled by enabled / running time.
+ */
+class [[nodiscard]] PerfCounters final {
+  public:
+    PerfCounters(const PerfCounters& other) noexcept = delete;
+    auto operator=(const PerfCounters& other) noexcept -> PerfCounters& = delete;
+    PerfCounters(PerfCounters&& other) noexcept = delete;
+    auto operator=(PerfCounters&& other) noexcept -> PerfCounters& = delete;
+
+    ~PerfCounters() noexcept {
+#if defined(__linux__)
+        for (const int fd : m_fds) {
+            if (fd >= 0) {
+                ::close(fd);
+            }
+        }
+#endif
+    }
+
+    PerfCounters() noexcept {
+#if defined(__linux__)
+        constexpr std::array<std::pair<std::uint32_t, std::uint64_t>, kNumPerfEvents> kConfigs{
+            std::pair<std::uint32_t, std::uint64_t>{PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+            {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES}
+        };
+        for (std::size_t i{0}; i < kNumPerfEvents; ++i) {
+            perf_event_attr attr{};
+            attr.type = kConfigs[i].first;
+            attr.size = sizeof(perf_event_attr);
+            attr.config = kConfigs[i].second;
+            attr.disabled = m_leader < 0 ? 1 : 0;
+            attr.exclude_kernel = attr.type == PERF_TYPE_HARDWARE ? 1 : 0;
+            attr.exclude_hv = 1;
+            attr.read_format =
+                PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            const auto fd{static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, m_leader, 0)
+            )};
+            m_fds[i] = fd;
+            if (fd < 0) {
+                continue;
+            }
+            m_slots[m_num_opened++] = i;
+            if (m_leader < 0) {
+                m_leader = fd;
+            }
+        }
+        if (m_leader >= 0) {
+            ::ioctl(m_leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+            ::ioctl(m_leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        }
+#endif
+    }
+
+    /**
+     * @brief The counters of the calling thread, opened on first use.
+     */
+    [[using gnu: always_inline]]
+    static auto forThisThread() noexcept -> PerfCounters& {
+        thread_local PerfCounters counters{};
+        return counters;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto available() const noexcept -> bool {
+        return m_leader >= 0;
+    }
+
+    [[using gnu: always_inline, hot]]
+    auto read() const noexcept -> PerfCounterValues {
+        PerfCounterValues result{};
+#if defined(__linux__)
+        if (m_leader < 0) {
+            return result;
+        }
+        std::array<std::uint64_t, 3 + kNumPerfEvents> buffer{};
+        const ::ssize_t bytes{::read(m_leader, buffer.data(), sizeof(buffer))};
+        if (bytes < static_cast<::ssize_t>(sizeof(std::uint64_t) * 3) ||
+            buffer[0] != m_num_opened) [[unlikely]] {
+            return result;
+        }
+        const std::uint64_t time_enabled{buffer[1]};
+        const std::uint64_t time_running{buffer[2]};
+        for (std::size_t i{0}; i < m_num_opened; ++i) {
+            std::uint64_t value{buffer[3 + i]};
+            if (time_running != 0 && time_running < time_enabled) {
+                value = static_cast<std::uint64_t>(
+                    static_cast<double>(value) * static_cast<double>(time_enabled) /
+                    static_cast<double>(time_running)
+                );
+            }
+            result.values[m_slots[i]] = value;
+            result.valid[m_slots[i]] = time_running != 0;
+        }
+#endif
+        return result;
+    }
+
+  private:
+    std::array<int, kNumPerfEvents> m_fds{-1, -1, -1, -1, -1};
+    std::array<std::size_t, kNumPerfEvents> m_slots{};
+    std::size_t m_num_opened{0};
+    int m_leader{-1};
+};
+
+/**
+ * @brief ChronoInspector variant that also reports the calling thread's cycles, instructions,
+ * cache misses, branch misses and context switches spent in the scope. Unavailable counters are
+ * printed as "n/a".
+ */
+template <typename Clock = std::chrono::steady_clock, typename Duration = Clock::duration>
+    requires std::chrono::is_clock_v<Clock>
+class [[nodiscard]] PerfInspector final {
+  public:
+    using clock_type = Clock;
+    using time_point = typename clock_type::time_point;
+    using duration = Duration;
+
+    PerfInspector() noexcept = delete;
+    PerfInspector(const PerfInspector& other) noexcept = delete;
+    auto operator=(const PerfInspector& other) noexcept -> PerfInspector& = delete;
+    PerfInspector(PerfInspector&& other) noexcept = delete;
+    auto operator=(PerfInspector&& other) noexcept -> PerfInspector& = delete;
+    ~PerfInspector() noexcept {
+        const duration elapsed_time{elapsed()};
+        const PerfCounterValues delta{counters()};
+        m_logger->log(
+            m_source_loc, boyle::common::LogLevel::trace,
+            "{0:s}: {1}, cycles = {2:s}, instructions = {3:s}, cache misses = {4:s}, branch "
+            "misses = {5:s}, context switches = {6:s}.",
+            m_info, elapsed_time, format(delta, PerfEvent::CYCLES),
+            format(delta, PerfEvent::INSTRUCTIONS), format(delta, PerfEvent::CACHE_MISSES),
+            format(delta, PerfEvent::BRANCH_MISSES), format(delta, PerfEvent::CONTEXT_SWITCHES)
+        );
+    }
+
+    [[using gnu: always_inline]]
+    explicit PerfInspector(
+        std::string_view info,
+        const std::source_location& source_loc = std::source_location::current()
+    ) noexcept
+        : PerfInspector(::boyle::common::getDefaultLogger(), info, source_loc) {}
+
+    [[using gnu: always_inline]]
+    explicit PerfInspector(
+        std::shared_ptr<boyle::common::Logger> logger, std::string_view info,
+        const std::source_location& source_loc = std::source_location::current()
+    ) noexcept
+        : m_logger{std::move(logger)},
+          m_source_loc{
+              source_loc.file_name(), static_cast<int>(source_loc.line()),
+              source_loc.function_name()
+          },
+          m_info{info}, m_counters{PerfCounters::forThisThread()},
+          m_start_counters{m_counters.read()}, m_start{clock_type::now()} {}
+
+    [[using gnu: always_inline]]
+    auto reset() noexcept -> void {
+        m_start_counters = m_counters.read();
+        m_start = clock_type::now();
+        return;
+    }
+
+    template <typename OtherDuration = duration>
+    [[using gnu: pure, always_inline]]
+    auto elapsed() const noexcept -> OtherDuration {
+        return std::chrono::duration_cast<OtherDuration>(clock_type::now() - m_start);
+    }
+
+    [[using gnu: always_inline]]
+    auto counters() const noexcept -> PerfCounterValues {
+        return m_counters.read() - m_start_counters;
+    }
+
+  private:
+    [[using gnu: pure]]
+    static auto format(const PerfCounterValues& values, PerfEvent event) -> std::string {
+        return values.available(event) ? fmt::format("{0:d}", values[event]) : std::string{"n/a"};
+    }
+
+    std::shared_ptr<boyle::common::Logger> m_logger;
+    spdlog::source_loc m_source_loc;
+    std::string_view m_info;
+    const PerfCounters& m_counters;
+    PerfCounterValues m_start_counters;
+    time_point m_start;
+};
+
+} // namespace boyle::common
@@ -0,0 +1,480 @@
+/**
+ * @file task_scheduler.hpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2025-02-18
+ *
+ * @copyright Copyright (c) 2025 Boyle Development Team.
+ *            All rights reserved.
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "boyle/common/utils/macros.hpp"
+
+namespace boyle::common {
+
+enum class TaskPriority : std::uint8_t {
+    REAL_TIME = 0,
+    BACKGROUND = 1
+};
+
+inline constexpr std::size_t kNumTaskPriorities{2};
+
+struct [[nodiscard]] SchedulerConfig final {
+    /**
+     * @brief Number of worker threads; 0 takes one less than the hardware concurrency, since the
+     * thread waiting on a fork-join also runs tasks.
+     */
+    std::size_t num_threads{0};
+    /**
+     * @brief CPUs the workers are pinned to, worker i to cpu_affinity[i % size]. Empty leaves the
+     * placement to the OS. Pinning failures are ignored.
+     */
+    std::vector<int> cpu_affinity{};
+};
+
+/**
+ * @brief Work-stealing thread pool shared by the parallel algorithms of the library. Every worker
+ * owns one deque per priority; it pushes and pops its own tasks at the back and steals from the
+ * front of the others', always draining real-time tasks before background ones. A thread waiting
+ * on a TaskGroup runs pending tasks instead of sleeping, so nested fork-joins cannot deadlock.
+ */
+class TaskScheduler final {
+  public:
+    using Task = std::move_only_function<void()>;
+
+    MAKE_SINGLETON(TaskScheduler);
+
+    /**
+     * @brief Sets the configuration of the global instance. Only takes effect before the first
+     * getInstance() call; returns whether the configuration was applied.
+     */
+    static auto configure(SchedulerConfig config) -> bool {
+        GlobalConfig& global{globalConfig()};
+        const std::lock_guard<std::mutex> lock{global.mutex};
+        if (global.used) {
+            return false;
+        }
+        global.config = std::move(config);
+        return true;
+    }
+
+    ~TaskScheduler() noexcept {
+        {
+            const std::lock_guard<std::mutex> lock{m_sleep_mutex};
+            m_stopping = true;
+        }
+        m_sleep_cv.notify_all();
+        m_threads.clear();
+    }
+
+    TaskScheduler()
+        : TaskScheduler(takeGlobalConfig()) {}
+
+    explicit TaskScheduler(const SchedulerConfig& config)
+        : m_workers(
+              config.num_threads != 0
+                  ? config.num_threads
+                  : std::max<std::size_t>(std::thread::hardware_concurrency(), 2) - 1
+          ) {
+        m_threads.reserve(m_workers.size());
+        for (std::size_t i{0}; i < m_workers.size(); ++i) {
+            const int cpu{config.cpu_affinity.empty()
+                              ? -1
+                              : config.cpu_affinity[i % config.cpu_affinity.size()]};
+            m_threads.emplace_back([this, i, cpu]() -> void {
+                pinToCpu(cpu);
+                workerLoop(i);
+            });
+        }
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto num_workers() const noexcept -> std::size_t {
+        return m_workers.size();
+    }
+
+    /**
+     * @brief Queues a task. From a worker of this scheduler it goes to the worker's own deque,
+     * otherwise the workers are picked round-robin.
+     */
+    auto submit(Task task, TaskPriority priority = TaskPriority::REAL_TIME) -> void {
+        const std::size_t index{
+            t_scheduler == this ? t_worker_index
+                                : m_next_worker.fetch_add(1, std::memory_order_relaxed) %
+                                      m_workers.size()
+        };
+        Worker& worker{m_workers[index]};
+        {
+            const std::lock_guard<std::mutex> lock{worker.mutex};
+            worker.queues[static_cast<std::size_t>(priority)].push_back(std::move(task));
+        }
+        {
+            const std::lock_guard<std::mutex> lock{m_sleep_mutex};
+            m_num_pending.fetch_add(1, std::memory_order_release);
+        }
+        m_sleep_cv.notify_one();
+        return;
+    }
+
+    /**
+     * @brief Runs one pending task on the calling thread, if there is any.
+     */
+    auto tryRunOne() -> bool {
+        Task task{pop(t_scheduler == this ? t_worker_index : m_workers.size())};
+        if (!task) {
+            return false;
+        }
+        task();
+        return true;
+    }
+
+    /**
+     * @brief Calls func(i) for every i in [first, last), split into chunks of grain indices (0
+     * picks about four chunks per thread). The calling thread runs the first chunk itself and then
+     * helps with the rest. Chunks not yet started are skipped once stop_token is triggered.
+     */
+    template <std::integral Index, typename Func>
+        requires std::invocable<Func&, Index>
+    auto parallelFor(
+        Index first, Index last, Func&& func, TaskPriority priority = TaskPriority::REAL_TIME,
+        std::stop_token stop_token = {}, Index grain = 0
+    ) -> void;
+
+    /**
+     * @brief Folds map(i) over [first, last) with reduce, starting every chunk from identity. The
+     * chunk partials are combined in index order, so the result is reproducible for a fixed grain.
+     */
+    template <std::integral Index, typename T, typename Map, typename Reduce>
+        requires std::invocable<Map&, Index> && std::invocable<Reduce&, T, T>
+    auto parallelReduce(
+        Index first, Index last, T identity, Map&& map, Reduce&& reduce,
+        TaskPriority priority = TaskPriority::REAL_TIME, std::stop_token stop_token = {},
+        Index grain = 0
+    ) -> T;
+
+  private:
+    struct Worker final {
+        std::mutex mutex{};
+        std::array<std::deque<Task>, kNumTaskPriorities> queues{};
+    };
+
+    struct GlobalConfig final {
+        std::mutex mutex{};
+        SchedulerConfig config{};
+        bool used{false};
+    };
+
+    [[using gnu: always_inline]]
+    static auto globalConfig() noexcept -> GlobalConfig& {
+        static GlobalConfig global{};
+        return global;
+    }
+
+    [[using gnu: always_inline]]
+    static auto takeGlobalConfig() -> SchedulerConfig {
+        GlobalConfig& global{globalConfig()};
+        const std::lock_guard<std::mutex> lock{global.mutex};
+        global.used = true;
+        return global.config;
+    }
+
+    static auto pinToCpu([[maybe_unused]] int cpu) noexcept -> void {
+#if defined(__linux__)
+        if (cpu < 0 || cpu >= CPU_SETSIZE) {
+            return;
+        }
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        CPU_SET(cpu, &cpu_set);
+        ::pthread_setaffinity_np(::pthread_self(), sizeof(cpu_set), &cpu_set);
+#endif
+        return;
+    }
+
+    /**
+     * @brief Takes the most urgent task: the back of the own deque first, then the front of the
+     * other workers' deques. self == num_workers() means the caller is not a worker.
+     */
+    auto pop(std::size_t self) -> Task {
+        if (m_num_pending.load(std::memory_order_acquire) == 0) {
+            return Task{};
+        }
+        const std::size_t num_workers{m_workers.size()};
+        for (std::size_t priority{0}; priority < kNumTaskPriorities; ++priority) {
+            if (self < num_workers) {
+                Worker& worker{m_workers[self]};
+                const std::lock_guard<std::mutex> lock{worker.mutex};
+                std::deque<Task>& queue{worker.queues[priority]};
+                if (!queue.empty()) {
+                    Task task{std::move(queue.back())};
+                    queue.pop_back();
+                    m_num_pending.fetch_sub(1, std::memory_order_relaxed);
+                    return task;
+                }
+            }
+            for (std::size_t offset{1}; offset <= num_workers; ++offset) {
+                const std::size_t victim{(self + offset) % num_workers};
+                if (victim == self) {
+                    continue;
+                }
+                Worker& worker{m_workers[victim]};
+                const std::lock_guard<std::mutex> lock{worker.mutex};
+                std::deque<Task>& queue{worker.queues[priority]};
+                if (!queue.empty()) {
+                    Task task{std::move(queue.front())};
+                    queue.pop_front();
+                    m_num_pending.fetch_sub(1, std::memory_order_relaxed);
+                    return task;
+                }
+            }
+        }
+        return Task{};
+    }
+
+    auto workerLoop(std::size_t index) -> void {
+        t_scheduler = this;
+        t_worker_index = index;
+        while (true) {
+            Task task{pop(index)};
+            if (task) {
+                task();
+                continue;
+            }
+            std::unique_lock<std::mutex> lock{m_sleep_mutex};
+            if (m_stopping && m_num_pending.load(std::memory_order_acquire) == 0) {
+                break;
+            }
+            m_sleep_cv.wait(lock, [this]() noexcept -> bool {
+                return m_stopping || m_num_pending.load(std::memory_order_acquire) != 0;
+            });
+        }
+        t_scheduler = nullptr;
+        return;
+    }
+
+    static inline thread_local const TaskScheduler* t_scheduler{nullptr};
+    static inline thread_local std::size_t t_worker_index{0};
+
+    std::vector<Worker> m_workers;
+    std::atomic<std::size_t> m_next_worker{0};
+    std::atomic<std::size_t> m_num_pending{0};
+    std::mutex m_sleep_mutex{};
+    std::condition_variable m_sleep_cv{};
+    bool m_stopping{false};
+    std::vector<std::jthread> m_threads{};
+};
+
+/**
+ * @brief Fork-join scope over a TaskScheduler. Tasks run through the group are skipped once the
+ * group is cancelled, either by cancel(), by a triggered parent stop token, or by a task throwing;
+ * long-running tasks should poll stop_token() themselves. wait() helps running pending tasks and
+ * rethrows the first exception a task threw.
+ */
+class [[nodiscard]] TaskGroup final {
+  public:
+    TaskGroup() noexcept = delete;
+    TaskGroup(const TaskGroup& other) noexcept = delete;
+    auto operator=(const TaskGroup& other) noexcept -> TaskGroup& = delete;
+    TaskGroup(TaskGroup&& other) noexcept = delete;
+    auto operator=(TaskGroup&& other) noexcept -> TaskGroup& = delete;
+    ~TaskGroup() noexcept {
+        cancel();
+        drain();
+    }
+
+    [[using gnu: always_inline]]
+    explicit TaskGroup(
+        TaskScheduler& scheduler, TaskPriority priority = TaskPriority::REAL_TIME,
+        std::stop_token stop_token = {}
+    ) noexcept
+        : m_scheduler{scheduler}, m_priority{priority},
+          m_parent_link{std::move(stop_token), Canceller{&m_stop_source}} {}
+
+    template <typename Func>
+        requires std::invocable<Func&>
+    auto run(Func&& func) -> void {
+        m_num_pending.fetch_add(1, std::memory_order_relaxed);
+        m_scheduler.submit(
+            [this, func = std::forward<Func>(func)]() mutable -> void {
+                execute(func);
+                m_num_pending.fetch_sub(1, std::memory_order_release);
+            },
+            m_priority
+        );
+        return;
+    }
+
+    /**
+     * @brief Runs func on the calling thread under the group's cancellation and error handling.
+     */
+    template <typename Func>
+        requires std::invocable<Func&>
+    auto runInline(Func&& func) -> void {
+        execute(func);
+        return;
+    }
+
+    auto wait() -> void {
+        drain();
+        if (m_exception) {
+            std::rethrow_exception(std::exchange(m_exception, nullptr));
+        }
+        return;
+    }
+
+    [[using gnu: always_inline]]
+    auto cancel() noexcept -> void {
+        m_stop_source.request_stop();
+        return;
+    }
+
+    [[using gnu: always_inline]]
+    auto cancelled() const noexcept -> bool {
+        return m_stop_source.stop_requested();
+    }
+
+    [[using gnu: always_inline]]
+    auto stop_token() const noexcept -> std::stop_token {
+        return m_stop_source.get_token();
+    }
+
+  private:
+    struct Canceller final {
+        std::stop_source* stop_source;
+
+        auto operator()() const noexcept -> void { stop_source->request_stop(); }
+    };
+
+    template <typename Func>
+    auto execute(Func& func) noexcept -> void {
+        if (m_stop_source.stop_requested()) {
+            return;
+        }
+        try {
+            std::invoke(func);
+        } catch (...) {
+            const std::lock_guard<std::mutex> lock{m_exception_mutex};
+            if (!m_exception) {
+                m_exception = std::current_exception();
+            }
+            m_stop_source.request_stop();
+        }
+        return;
+    }
+
+    auto drain() noexcept -> void {
+        while (m_num_pending.load(std::memory_order_acquire) != 0) {
+            if (!m_scheduler.tryRunOne()) {
+                std::this_thread::yield();
+            }
+        }
+        return;
+    }
+
+    TaskScheduler& m_scheduler;
+    TaskPriority m_priority;
+    std::atomic<std::size_t> m_num_pending{0};
+    std::stop_source m_stop_source{};
+    std::stop_callback<Canceller> m_parent_link;
+    std::mutex m_exception_mutex{};
+    std::exception_ptr m_exception{nullptr};
+};
+
+template <std::integral Index, typename Func>
+    requires std::invocable<Func&, Index>
+auto TaskScheduler::parallelFor(
+    Index first, Index last, Func&& func, TaskPriority priority, std::stop_token stop_token,
+    Index grain
+) -> void {
+    if (first >= last) {
+        return;
+    }
+    const auto size{static_cast<std::size_t>(last - first)};
+    const std::size_t chunk{
+        grain > 0 ? static_cast<std::size_t>(grain)
+                  : std::max<std::size_t>(1, size / ((m_workers.size() + 1) * 4))
+    };
+    const auto runChunk = [&func, first, size, chunk](std::size_t begin) -> void {
+        const std::size_t end{std::min(size, begin + chunk)};
+        for (std::size_t j{begin}; j < end; ++j) {
+            std::invoke(func, static_cast<Index>(first + static_cast<Index>(j)));
+        }
+    };
+    if (chunk >= size) {
+        if (!stop_token.stop_requested()) {
+            runChunk(0);
+        }
+        return;
+    }
+    TaskGroup group{*this, priority, std::move(stop_token)};
+    for (std::size_t begin{chunk}; begin < size; begin += chunk) {
+        group.run([&runChunk, begin]() -> void { runChunk(begin); });
+    }
+    group.runInline([&runChunk]() -> void { runChunk(0); });
+    group.wait();
+    return;
+}
+
+template <std::integral Index, typename T, typename Map, typename Reduce>
+    requires std::invocable<Map&, Index> && std::invocable<Reduce&, T, T>
+auto TaskScheduler::parallelReduce(
+    Index first, Index last, T identity, Map&& map, Reduce&& reduce, TaskPriority priority,
+    std::stop_token stop_token, Index grain
+) -> T {
+    if (first >= last) {
+        return identity;
+    }
+    const auto size{static_cast<std::size_t>(last - first)};
+    const std::size_t chunk{
+        grain > 0 ? static_cast<std::size_t>(grain)
+                  : std::max<std::size_t>(1, size / ((m_workers.size() + 1) * 4))
+    };
+    std::vector<T> partials((size + chunk - 1) / chunk, identity);
+    parallelFor(
+        std::size_t{0}, partials.size(),
+        [&](std::size_t k) -> void {
+            const std::size_t end{std::min(size, (k + 1) * chunk)};
+            T partial{identity};
+            for (std::size_t j{k * chunk}; j < end; ++j) {
+                partial = std::invoke(
+                    reduce, std::move(partial), std::invoke(map, static_cast<Index>(first + j))
+                );
+            }
+            partials[k] = std::move(partial);
+        },
+        priority, std::move(stop_token), std::size_t{1}
+    );
+    T result{std::move(identity)};
+    for (T& partial : partials) {
+        result = std::invoke(reduce, std::move(result), std::move(partial));
+    }
+    return result;
+}
+
+} // namespace boyle::common
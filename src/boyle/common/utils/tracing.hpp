@@ -0,0 +1,425 @@
+/**
+ * @file tracing.hpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2024-12-10
+ *
+ * @copyright Copyright (c) 2024 Boyle Development Team.
+ *            All rights reserved.
+ *
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "fmt/format.h"
+
+#include "boyle/common/utils/macros.hpp"
+
+#if !defined(BOYLE_ENABLE_TRACING)
+#define BOYLE_ENABLE_TRACING 1
+#endif
+
+#if BOYLE_ENABLE_TRACING == 1
+/**
+ * @brief Records the enclosing scope under the given name, which must be a string literal since
+ * only its address is stored.
+ */
+#define BOYLE_TRACE_SCOPE(name) \
+    const ::boyle::common::TraceScope BOYLE_CONCAT(boyle_trace_scope_, __LINE__) { name }
+#else
+#define BOYLE_TRACE_SCOPE(name) (void)0
+#endif
+
+namespace boyle::common {
+
+struct [[nodiscard]] TraceEvent final {
+    const char* name{nullptr};
+    std::uint32_t thread_id{0};
+    std::int64_t start{0};
+    std::int64_t end{0};
+};
+
+/**
+ * @brief Single-producer single-consumer ring of trace events owned by one traced thread. The
+ * owning thread pushes, the collector pops; a full ring drops the event and counts it. When its
+ * thread exits the ring goes back to the tracer and is handed to the next thread that registers.
+ */
+class [[nodiscard]] TraceBuffer final {
+  public:
+    static constexpr std::size_t kCapacity{std::size_t{1} << 14};
+
+    TraceBuffer() noexcept = delete;
+    TraceBuffer(const TraceBuffer& other) noexcept = delete;
+    auto operator=(const TraceBuffer& other) noexcept -> TraceBuffer& = delete;
+    TraceBuffer(TraceBuffer&& other) noexcept = delete;
+    auto operator=(TraceBuffer&& other) noexcept -> TraceBuffer& = delete;
+    ~TraceBuffer() noexcept = default;
+
+    [[using gnu: always_inline]]
+    explicit TraceBuffer(std::uint32_t thread_id) noexcept
+        : m_thread_id{thread_id} {}
+
+    /**
+     * @brief Hands the ring to a new owning thread. Events the previous owner left behind keep
+     * their thread id and are still drained.
+     */
+    [[using gnu: always_inline]]
+    auto rebind(std::uint32_t thread_id) noexcept -> void {
+        m_thread_id = thread_id;
+        return;
+    }
+
+    [[using gnu: always_inline, hot]]
+    auto push(const char* name, std::int64_t start, std::int64_t end) noexcept -> void {
+        const std::size_t head{m_head.load(std::memory_order_relaxed)};
+        if (head - m_tail.load(std::memory_order_acquire) == kCapacity) [[unlikely]] {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        m_events[head & (kCapacity - 1)] = TraceEvent{name, m_thread_id, start, end};
+        m_head.store(head + 1, std::memory_order_release);
+        return;
+    }
+
+    [[using gnu: always_inline]]
+    auto drain(std::deque<TraceEvent>& events) -> void {
+        const std::size_t tail{m_tail.load(std::memory_order_relaxed)};
+        const std::size_t head{m_head.load(std::memory_order_acquire)};
+        for (std::size_t i{tail}; i < head; ++i) {
+            events.push_back(m_events[i & (kCapacity - 1)]);
+        }
+        m_tail.store(head, std::memory_order_release);
+        return;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto thread_id() const noexcept -> std::uint32_t {
+        return m_thread_id;
+    }
+
+    [[using gnu: always_inline]]
+    auto dropped() const noexcept -> std::size_t {
+        return m_dropped.load(std::memory_order_relaxed);
+    }
+
+  private:
+    alignas(64) std::atomic<std::size_t> m_head{0};
+    alignas(64) std::atomic<std::size_t> m_tail{0};
+    alignas(64) std::atomic<std::size_t> m_dropped{0};
+    std::uint32_t m_thread_id;
+    std::array<TraceEvent, kCapacity> m_events{};
+};
+
+/**
+ * @brief Process-wide trace registry. Recording is off until enable() is called; while off a
+ * traced scope costs one relaxed load. Collected events are exported as Chrome trace JSON, which
+ * chrome://tracing and the Perfetto UI both open. At most capacity() collected events are kept,
+ * the oldest ones are evicted first.
+ */
+class Tracer final {
+  public:
+    using clock_type = std::chrono::steady_clock;
+
+    static constexpr std::size_t kDefaultCapacity{std::size_t{1} << 20};
+
+    MAKE_SINGLETON(Tracer);
+    ~Tracer() noexcept { stopCollector(); }
+
+    [[using gnu: always_inline]]
+    auto enable() noexcept -> void {
+        m_enabled.store(true, std::memory_order_relaxed);
+        return;
+    }
+
+    [[using gnu: always_inline]]
+    auto disable() noexcept -> void {
+        m_enabled.store(false, std::memory_order_relaxed);
+        return;
+    }
+
+    [[using gnu: always_inline]]
+    auto enabled() const noexcept -> bool {
+        return m_enabled.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Nanoseconds since the tracer was created.
+     */
+    [[using gnu: always_inline]]
+    auto now() const noexcept -> std::int64_t {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now() - m_epoch)
+            .count();
+    }
+
+    /**
+     * @brief Records an event from the calling thread. The first call on a thread leases it a
+     * buffer; if that fails the event is dropped and counted, and the next call tries again.
+     */
+    [[using gnu: always_inline, hot]]
+    auto record(const char* name, std::int64_t start, std::int64_t end) noexcept -> void {
+        thread_local ThreadLease lease{};
+        if (lease.buffer == nullptr) [[unlikely]] {
+            lease.buffer = acquireBuffer();
+            if (lease.buffer == nullptr) [[unlikely]] {
+                m_unregistered.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+        }
+        lease.buffer->push(name, start, end);
+        return;
+    }
+
+    /**
+     * @brief Moves every pending event out of the per-thread buffers into the collected set, then
+     * evicts the oldest collected events beyond capacity().
+     */
+    auto collect() -> void {
+        const std::lock_guard<std::mutex> lock{m_mutex};
+        for (const std::unique_ptr<TraceBuffer>& buffer : m_buffers) {
+            buffer->drain(m_events);
+        }
+        evictOverflow();
+        return;
+    }
+
+    [[using gnu: always_inline]]
+    auto setCapacity(std::size_t capacity) -> void {
+        const std::lock_guard<std::mutex> lock{m_mutex};
+        m_capacity = capacity;
+        evictOverflow();
+        return;
+    }
+
+    [[using gnu: always_inline]]
+    auto capacity() const -> std::size_t {
+        const std::lock_guard<std::mutex> lock{m_mutex};
+        return m_capacity;
+    }
+
+    [[using gnu: always_inline]]
+    auto startCollector(std::chrono::milliseconds period = std::chrono::milliseconds{10}) -> void {
+        stopCollector();
+        m_collector = std::jthread{[this, period](std::stop_token stop_token) -> void {
+            while (!stop_token.stop_requested()) {
+                collect();
+                std::this_thread::sleep_for(period);
+            }
+            collect();
+        }};
+        return;
+    }
+
+    [[using gnu: always_inline]]
+    auto stopCollector() noexcept -> void {
+        if (m_collector.joinable()) {
+            m_collector.request_stop();
+            m_collector.join();
+        }
+        return;
+    }
+
+    [[using gnu: always_inline]] [[nodiscard]]
+    auto events() const -> std::vector<TraceEvent> {
+        const std::lock_guard<std::mutex> lock{m_mutex};
+        return std::vector<TraceEvent>{m_events.cbegin(), m_events.cend()};
+    }
+
+    /**
+     * @brief Events that never reached the collected set, either because a thread buffer was full
+     * or because a thread could not get a buffer.
+     */
+    [[using gnu: always_inline]]
+    auto dropped() const -> std::size_t {
+        const std::lock_guard<std::mutex> lock{m_mutex};
+        std::size_t count{m_unregistered.load(std::memory_order_relaxed)};
+        for (const std::unique_ptr<TraceBuffer>& buffer : m_buffers) {
+            count += buffer->dropped();
+        }
+        return count;
+    }
+
+    /**
+     * @brief Collected events evicted to keep the collected set within capacity().
+     */
+    [[using gnu: always_inline]]
+    auto evicted() const -> std::size_t {
+        const std::lock_guard<std::mutex> lock{m_mutex};
+        return m_evicted;
+    }
+
+    /**
+     * @brief Thread buffers allocated so far. Buffers of exited threads are reused, so this
+     * tracks the peak number of traced threads rather than every thread ever traced.
+     */
+    [[using gnu: always_inline]]
+    auto numBuffers() const -> std::size_t {
+        const std::lock_guard<std::mutex> lock{m_mutex};
+        return m_buffers.size();
+    }
+
+    [[using gnu: always_inline]]
+    auto clear() -> void {
+        const std::lock_guard<std::mutex> lock{m_mutex};
+        m_events.clear();
+        return;
+    }
+
+    /**
+     * @brief Writes the collected events as complete ("X") events with microsecond timestamps.
+     */
+    auto exportChromeTrace(std::ostream& os) const -> void {
+        const std::lock_guard<std::mutex> lock{m_mutex};
+        os << R"({"displayTimeUnit":"ns","traceEvents":[)";
+        for (std::size_t i{0}; i < m_events.size(); ++i) {
+            const TraceEvent& event{m_events[i]};
+            os << (i == 0 ? "\n" : ",\n")
+               << fmt::format(
+                      R"({{"name":"{0:s}","cat":"boyle","ph":"X","pid":1,"tid":{1:d},)"
+                      R"("ts":{2:.3f},"dur":{3:.3f}}})",
+                      escape(event.name), event.thread_id, static_cast<double>(event.start) * 1e-3,
+                      static_cast<double>(event.end - event.start) * 1e-3
+                  );
+        }
+        os << "\n]}\n";
+        return;
+    }
+
+    [[using gnu: always_inline]]
+    auto exportChromeTrace(std::string_view file_path) const -> void {
+        std::ofstream ofs{file_path.data(), std::ios::out | std::ios::trunc};
+        exportChromeTrace(ofs);
+        return;
+    }
+
+  private:
+    /**
+     * @brief Gives the buffer of a traced thread back to the tracer when the thread exits.
+     */
+    struct ThreadLease final {
+        TraceBuffer* buffer{nullptr};
+
+        ~ThreadLease() noexcept {
+            if (buffer != nullptr) {
+                Tracer::getInstance()->releaseBuffer(buffer);
+            }
+        }
+    };
+
+    Tracer() noexcept = default;
+
+    /**
+     * @brief Reuses the buffer of an exited thread, or allocates a new one. Returns nullptr when
+     * neither is possible instead of throwing, since it runs inside ~TraceScope().
+     */
+    auto acquireBuffer() noexcept -> TraceBuffer* {
+        try {
+            const std::lock_guard<std::mutex> lock{m_mutex};
+            const std::uint32_t thread_id{m_next_thread_id++};
+            if (!m_free_buffers.empty()) {
+                TraceBuffer* const buffer{m_free_buffers.back()};
+                m_free_buffers.pop_back();
+                buffer->rebind(thread_id);
+                return buffer;
+            }
+            m_buffers.push_back(std::make_unique<TraceBuffer>(thread_id));
+            // releaseBuffer() must not allocate, so the free list always has room for every buffer.
+            m_free_buffers.reserve(m_buffers.size());
+            return m_buffers.back().get();
+        } catch (...) {
+            return nullptr;
+        }
+    }
+
+    auto releaseBuffer(TraceBuffer* buffer) noexcept -> void {
+        try {
+            const std::lock_guard<std::mutex> lock{m_mutex};
+            m_free_buffers.push_back(buffer);
+        } catch (...) {
+            // The buffer stays leased to nobody and is only drained from now on.
+        }
+        return;
+    }
+
+    auto evictOverflow() -> void {
+        if (m_events.size() > m_capacity) {
+            const std::size_t excess{m_events.size() - m_capacity};
+            m_events.erase(
+                m_events.begin(), m_events.begin() + static_cast<std::ptrdiff_t>(excess)
+            );
+            m_evicted += excess;
+        }
+        return;
+    }
+
+    [[using gnu: pure]]
+    static auto escape(std::string_view name) -> std::string {
+        std::string result;
+        result.reserve(name.size());
+        for (const char c : name) {
+            if (c == '"' || c == '\\') {
+                result.push_back('\\');
+            }
+            result.push_back(c);
+        }
+        return result;
+    }
+
+    std::atomic<bool> m_enabled{false};
+    const clock_type::time_point m_epoch{clock_type::now()};
+    mutable std::mutex m_mutex{};
+    std::atomic<std::size_t> m_unregistered{0};
+    std::vector<std::unique_ptr<TraceBuffer>> m_buffers{};
+    std::vector<TraceBuffer*> m_free_buffers{};
+    std::uint32_t m_next_thread_id{0};
+    std::deque<TraceEvent> m_events{};
+    std::size_t m_capacity{kDefaultCapacity};
+    std::size_t m_evicted{0};
+    std::jthread m_collector{};
+};
+
+class [[nodiscard]] TraceScope final {
+  public:
+    TraceScope() noexcept = delete;
+    TraceScope(const TraceScope& other) noexcept = delete;
+    auto operator=(const TraceScope& other) noexcept -> TraceScope& = delete;
+    TraceScope(TraceScope&& other) noexcept = delete;
+    auto operator=(TraceScope&& other) noexcept -> TraceScope& = delete;
+    ~TraceScope() noexcept {
+        if (m_name != nullptr) {
+            Tracer* const tracer{Tracer::getInstance()};
+            tracer->record(m_name, m_start, tracer->now());
+        }
+    }
+
+    [[using gnu: always_inline]]
+    explicit TraceScope(const char* name) noexcept {
+        Tracer* const tracer{Tracer::getInstance()};
+        if (tracer->enabled()) {
+            m_name = name;
+            m_start = tracer->now();
+        }
+    }
+
+  private:
+    const char* m_name{nullptr};
+    std::int64_t m_start{0};
+};
+
+} // namespace boyle::common
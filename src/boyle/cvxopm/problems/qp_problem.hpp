@@ -14,7 +14,9 @@
 
 #include <concepts>
 #include <limits>
+#include <memory_resource>
 #include <span>
+#include <vector>
 
 #include "boost/serialization/access.hpp"
 #include "boost/serialization/vector.hpp"
@@ -39,13 +41,28 @@ class [[nodiscard]] QpProblem final {
     auto operator=(QpProblem&& other) noexcept -> QpProblem& = default;
     ~QpProblem() noexcept = default;
 
+    /**
+     * @brief Places the cost matrix, constraint matrix and vectors of the problem on the given
+     * resource, e.g. a per-cycle arena; the resource has to outlive the problem. Resetting a
+     * common::MonotonicArena frees that storage under the problem, so a problem built on an arena
+     * has to be destroyed before the arena is reset.
+     */
     [[using gnu: always_inline]]
-    QpProblem(std::size_t num_vars, std::size_t num_cons) noexcept
+    explicit QpProblem(std::pmr::memory_resource* resource) noexcept
+        : m_objective_matrix{resource}, m_objective_vector(resource), m_constrain_matrix{resource},
+          m_lower_bounds(resource), m_upper_bounds(resource) {}
+
+    [[using gnu: always_inline]]
+    QpProblem(
+        std::size_t num_vars, std::size_t num_cons,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) noexcept
         : m_num_vars{static_cast<Index>(num_vars)}, m_num_cons{static_cast<Index>(num_cons)},
-          m_objective_matrix{num_vars, num_vars}, m_objective_vector(num_vars, 0.0),
-          m_constrain_matrix{num_cons, num_vars},
-          m_lower_bounds(num_cons, std::numeric_limits<Scalar>::lowest()),
-          m_upper_bounds(num_cons, std::numeric_limits<Scalar>::max()) {}
+          m_objective_matrix{num_vars, num_vars, resource},
+          m_objective_vector(num_vars, 0.0, resource),
+          m_constrain_matrix{num_cons, num_vars, resource},
+          m_lower_bounds(num_cons, std::numeric_limits<Scalar>::lowest(), resource),
+          m_upper_bounds(num_cons, std::numeric_limits<Scalar>::max(), resource) {}
 
     [[using gnu: always_inline]]
     auto resize(std::size_t num_vars, std::size_t num_cons) noexcept -> void {
@@ -83,6 +100,39 @@ class [[nodiscard]] QpProblem final {
         return m_constrain_matrix.nrows();
     }
 
+    /**
+     * @brief Upper triangle of P in the OSQP convention, i.e. cost = 0.5 * x'Px + q'x.
+     */
+    [[using gnu: pure, always_inline]]
+    auto objectiveMatrix() const noexcept -> const ::boyle::math::DokMatrix<Scalar, Index>& {
+        return m_objective_matrix;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto objectiveVector() const noexcept -> const std::pmr::vector<Scalar>& {
+        return m_objective_vector;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto constrainMatrix() const noexcept -> const ::boyle::math::LilMatrix<Scalar, Index>& {
+        return m_constrain_matrix;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto lowerBounds() const noexcept -> const std::pmr::vector<Scalar>& {
+        return m_lower_bounds;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto upperBounds() const noexcept -> const std::pmr::vector<Scalar>& {
+        return m_upper_bounds;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto resource() const noexcept -> std::pmr::memory_resource* {
+        return m_objective_vector.get_allocator().resource();
+    }
+
     [[using gnu: pure]]
     auto cost(std::span<const Scalar> x) const noexcept -> Scalar {
         const Index x_size = x.size();
@@ -186,7 +236,7 @@ class [[nodiscard]] QpProblem final {
         m_objective_matrix.updateCoeff(m_num_vars, m_num_vars, quadratic_coeff * 2.0);
         m_objective_vector.push_back(linear_coeff);
         m_constrain_matrix.resize(m_num_cons + 2, m_num_vars + 1);
-        m_constrain_matrix.updateRow(m_num_cons, {{m_num_vars, 1.0}});
+        m_constrain_matrix.updateCoeff(m_num_cons, m_num_vars, 1.0);
         m_lower_bounds.push_back(0.0);
         m_upper_bounds.push_back(std::numeric_limits<Scalar>::max());
         constrain_vec.emplace(m_num_vars, -1.0);
@@ -241,10 +291,10 @@ class [[nodiscard]] QpProblem final {
     Index m_num_vars{0};
     Index m_num_cons{0};
     ::boyle::math::DokMatrix<Scalar, Index> m_objective_matrix{};
-    std::vector<Scalar> m_objective_vector{};
+    std::pmr::vector<Scalar> m_objective_vector{};
     ::boyle::math::LilMatrix<Scalar, Index> m_constrain_matrix{};
-    std::vector<Scalar> m_lower_bounds{};
-    std::vector<Scalar> m_upper_bounds{};
+    std::pmr::vector<Scalar> m_lower_bounds{};
+    std::pmr::vector<Scalar> m_upper_bounds{};
 };
 
 } // namespace boyle::cvxopm
@@ -0,0 +1,84 @@
+/**
+ * @file qp_capture.cpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2025-03-02
+ *
+ * @copyright Copyright (c) 2025 Boyle Development Team.
+ *            All rights reserved.
+ *
+ */
+
+#include "boyle/cvxopm/qp_capture.hpp"
+
+#include <atomic>
+#include <exception>
+#include <utility>
+
+#include "boyle/common/utils/logging.hpp"
+
+namespace boyle::cvxopm {
+
+namespace {
+
+// OSQP reports status_val 1 for "solved".
+constexpr int kOsqpSolved{1};
+
+std::atomic<std::shared_ptr<const QpCaptureOptions>> g_options{nullptr};
+std::atomic<std::size_t> g_num_captures{0};
+
+} // namespace
+
+auto enableQpCapture(QpCaptureOptions options) -> void {
+    std::filesystem::create_directories(options.directory);
+    g_num_captures.store(0, std::memory_order_relaxed);
+    g_options.store(std::make_shared<const QpCaptureOptions>(std::move(options)));
+    return;
+}
+
+auto disableQpCapture() noexcept -> void {
+    g_options.store(nullptr);
+    return;
+}
+
+auto qpCaptureOptions() noexcept -> std::shared_ptr<const QpCaptureOptions> {
+    return g_options.load(std::memory_order_acquire);
+}
+
+auto captureQpProblem(
+    const QpProblem<double, int>& qp_problem, const Settings<double, int>& settings,
+    std::span<const double> prim_vars_0, std::span<const double> dual_vars_0,
+    const Info<double, int>& info
+) noexcept -> void {
+    const std::shared_ptr<const QpCaptureOptions> options{qpCaptureOptions()};
+    if (options == nullptr) {
+        return;
+    }
+    if (info.run_time < options->min_run_time ||
+        (options->unsolved_only && info.status_val == kOsqpSolved)) {
+        return;
+    }
+    const std::size_t index{g_num_captures.fetch_add(1, std::memory_order_relaxed)};
+    if (index >= options->max_captures) {
+        return;
+    }
+    try {
+        const QpCapture<double, int> capture{
+            .qp_problem = qp_problem,
+            .settings = settings,
+            .prim_vars_0{prim_vars_0.begin(), prim_vars_0.end()},
+            .dual_vars_0{dual_vars_0.begin(), dual_vars_0.end()}
+        };
+        if (options->format == QpCaptureFormat::MATRIX_MARKET) {
+            saveQpCaptureBundle(capture, options->directory / fmt::format("qp_{0:06d}", index));
+        } else {
+            saveQpCapture(capture, options->directory / fmt::format("qp_{0:06d}.qp", index));
+        }
+    } catch (const std::exception& e) {
+        BOYLE_LOG_WARN("Failed to capture QP problem {0:d}: {1:s}", index, e.what());
+    }
+    return;
+}
+
+} // namespace boyle::cvxopm
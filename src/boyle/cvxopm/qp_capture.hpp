@@ -0,0 +1,429 @@
+/**
+ * @file qp_capture.hpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2025-03-02
+ *
+ * @copyright Copyright (c) 2025 Boyle Development Team.
+ *            All rights reserved.
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "boost/archive/binary_iarchive.hpp"
+#include "boost/archive/binary_oarchive.hpp"
+#include "boost/serialization/string.hpp"
+#include "boost/serialization/vector.hpp"
+#include "boost/unordered/unordered_flat_map.hpp"
+#include "fmt/format.h"
+
+#include "boyle/cvxopm/info.hpp"
+#include "boyle/cvxopm/problems/qp_problem.hpp"
+#include "boyle/cvxopm/settings.hpp"
+
+namespace boyle::cvxopm {
+
+enum class QpCaptureFormat : std::uint8_t {
+    BINARY = 0,       // one Boost binary archive per problem, "*.qp"
+    MATRIX_MARKET = 1 // one directory per problem with P/A/q/l/u .mtx files and settings.txt
+};
+
+/**
+ * @brief A QP exactly as it was handed to the solver, with the settings and warm start used.
+ */
+template <std::floating_point Scalar = double, std::integral Index = int>
+struct [[nodiscard]] QpCapture final {
+    QpProblem<Scalar, Index> qp_problem{};
+    Settings<Scalar, Index> settings{};
+    std::vector<Scalar> prim_vars_0{};
+    std::vector<Scalar> dual_vars_0{};
+};
+
+/**
+ * @brief Process-wide switch consulted by OsqpSolver::solve after every solve. Filters keep the
+ * capture cheap enough to leave on in production: only slow or unsolved problems are written.
+ */
+struct [[nodiscard]] QpCaptureOptions final {
+    std::filesystem::path directory{};
+    QpCaptureFormat format{QpCaptureFormat::BINARY};
+    double min_run_time{0.0}; // seconds; problems solved faster are skipped
+    bool unsolved_only{false};
+    std::size_t max_captures{1000};
+};
+
+/**
+ * @brief Creates the directory and starts capturing. Thread-safe with respect to concurrent
+ * solves; problems being solved while the options change use either the old or the new ones.
+ */
+auto enableQpCapture(QpCaptureOptions options) -> void;
+auto disableQpCapture() noexcept -> void;
+auto qpCaptureOptions() noexcept -> std::shared_ptr<const QpCaptureOptions>;
+
+/**
+ * @brief Writes the problem according to the current options if it passes their filters. Never
+ * throws: an I/O failure only costs the capture and is logged.
+ */
+auto captureQpProblem(
+    const QpProblem<double, int>& qp_problem, const Settings<double, int>& settings,
+    std::span<const double> prim_vars_0, std::span<const double> dual_vars_0,
+    const Info<double, int>& info
+) noexcept -> void;
+
+/**
+ * @brief Calls visitor(name, field) for every field of the settings, in declaration order.
+ */
+template <std::floating_point Scalar, std::integral Index>
+auto visitSettings(Settings<Scalar, Index>& settings, auto&& visitor) -> void {
+    visitor("device", settings.device);
+    visitor("linsys_solver", settings.linsys_solver);
+    visitor("allocate_solution", settings.allocate_solution);
+    visitor("verbose", settings.verbose);
+    visitor("profiler_level", settings.profiler_level);
+    visitor("warm_starting", settings.warm_starting);
+    visitor("scaling", settings.scaling);
+    visitor("polishing", settings.polishing);
+    visitor("rho", settings.rho);
+    visitor("rho_is_vec", settings.rho_is_vec);
+    visitor("sigma", settings.sigma);
+    visitor("alpha", settings.alpha);
+    visitor("cg_max_iter", settings.cg_max_iter);
+    visitor("cg_tol_reduction", settings.cg_tol_reduction);
+    visitor("cg_tol_fraction", settings.cg_tol_fraction);
+    visitor("cg_precond", settings.cg_precond);
+    visitor("adaptive_rho", settings.adaptive_rho);
+    visitor("adaptive_rho_interval", settings.adaptive_rho_interval);
+    visitor("adaptive_rho_fraction", settings.adaptive_rho_fraction);
+    visitor("adaptive_rho_tolerance", settings.adaptive_rho_tolerance);
+    visitor("max_iter", settings.max_iter);
+    visitor("eps_abs", settings.eps_abs);
+    visitor("eps_rel", settings.eps_rel);
+    visitor("eps_prim_inf", settings.eps_prim_inf);
+    visitor("eps_dual_inf", settings.eps_dual_inf);
+    visitor("scaled_termination", settings.scaled_termination);
+    visitor("check_termination", settings.check_termination);
+    visitor("time_limit", settings.time_limit);
+    visitor("delta", settings.delta);
+    visitor("polish_refine_iter", settings.polish_refine_iter);
+    return;
+}
+
+inline constexpr std::string_view kQpCaptureTag{"boyle::cvxopm::QpCapture"};
+
+template <std::floating_point Scalar, std::integral Index>
+auto saveQpCapture(const QpCapture<Scalar, Index>& capture, const std::filesystem::path& file_path)
+    -> void {
+    std::ofstream ofs{file_path, std::ios::binary | std::ios::trunc};
+    if (!ofs) [[unlikely]] {
+        throw std::runtime_error(fmt::format("Cannot open {0:s} for writing.", file_path.string()));
+    }
+    boost::archive::binary_oarchive oa{ofs};
+    const std::string tag{kQpCaptureTag};
+    oa << tag;
+    oa << capture;
+    return;
+}
+
+template <std::floating_point Scalar = double, std::integral Index = int>
+auto loadQpCapture(const std::filesystem::path& file_path) -> QpCapture<Scalar, Index> {
+    std::ifstream ifs{file_path, std::ios::binary};
+    if (!ifs) [[unlikely]] {
+        throw std::runtime_error(fmt::format("Cannot open {0:s}.", file_path.string()));
+    }
+    boost::archive::binary_iarchive ia{ifs};
+    std::string tag;
+    ia >> tag;
+    if (tag != kQpCaptureTag) [[unlikely]] {
+        throw std::runtime_error(fmt::format("{0:s} is not a QP capture.", file_path.string()));
+    }
+    QpCapture<Scalar, Index> capture;
+    ia >> capture;
+    return capture;
+}
+
+namespace detail {
+
+template <std::floating_point Scalar>
+auto writeMatrixMarketVector(const std::filesystem::path& file_path, std::span<const Scalar> values)
+    -> void {
+    std::ofstream ofs{file_path, std::ios::trunc};
+    ofs << "%%MatrixMarket matrix array real general\n";
+    ofs << fmt::format("{0:d} 1\n", values.size());
+    for (const Scalar value : values) {
+        ofs << fmt::format("{0:.17g}\n", value);
+    }
+    if (!ofs) [[unlikely]] {
+        throw std::runtime_error(fmt::format("Cannot write {0:s}.", file_path.string()));
+    }
+    return;
+}
+
+template <std::floating_point Scalar, std::integral Index>
+auto writeMatrixMarketMatrix(
+    const std::filesystem::path& file_path, std::size_t nrows, std::size_t ncols,
+    std::vector<std::tuple<Index, Index, Scalar>> triplets, bool symmetric
+) -> void {
+    std::ranges::sort(triplets, [](const auto& lhs, const auto& rhs) noexcept -> bool {
+        return std::tie(std::get<1>(lhs), std::get<0>(lhs)) <
+               std::tie(std::get<1>(rhs), std::get<0>(rhs));
+    });
+    std::ofstream ofs{file_path, std::ios::trunc};
+    ofs << fmt::format(
+        "%%MatrixMarket matrix coordinate real {0:s}\n", symmetric ? "symmetric" : "general"
+    );
+    ofs << fmt::format("{0:d} {1:d} {2:d}\n", nrows, ncols, triplets.size());
+    for (const auto& [row, col, value] : triplets) {
+        ofs << fmt::format("{0:d} {1:d} {2:.17g}\n", row + 1, col + 1, value);
+    }
+    if (!ofs) [[unlikely]] {
+        throw std::runtime_error(fmt::format("Cannot write {0:s}.", file_path.string()));
+    }
+    return;
+}
+
+/**
+ * @brief Opens a Matrix Market file and returns the stream positioned after the size line,
+ * together with the banner and the sizes (rows, cols and, for coordinate files, entries).
+ */
+inline auto openMatrixMarket(const std::filesystem::path& file_path)
+    -> std::tuple<std::ifstream, std::string, std::vector<std::size_t>> {
+    std::ifstream ifs{file_path};
+    std::string banner;
+    if (!std::getline(ifs, banner) || !banner.starts_with("%%MatrixMarket matrix")) [[unlikely]] {
+        throw std::runtime_error(
+            fmt::format("{0:s} is not a Matrix Market file.", file_path.string())
+        );
+    }
+    std::string line;
+    while (std::getline(ifs, line) && (line.empty() || line.front() == '%')) {
+    }
+    std::istringstream iss{line};
+    std::vector<std::size_t> sizes;
+    for (std::size_t size{0}; iss >> size;) {
+        sizes.push_back(size);
+    }
+    const std::size_t expected{banner.find("coordinate") != std::string::npos ? 3UL : 2UL};
+    if (sizes.size() != expected) [[unlikely]] {
+        throw std::runtime_error(fmt::format("Malformed size line in {0:s}.", file_path.string()));
+    }
+    return std::make_tuple(std::move(ifs), std::move(banner), std::move(sizes));
+}
+
+template <std::floating_point Scalar>
+auto readMatrixMarketVector(const std::filesystem::path& file_path) -> std::vector<Scalar> {
+    auto [ifs, banner, sizes] = openMatrixMarket(file_path);
+    if (banner.find("array") == std::string::npos || sizes[1] != 1) [[unlikely]] {
+        throw std::runtime_error(fmt::format("{0:s} is not a dense vector.", file_path.string()));
+    }
+    std::vector<Scalar> values(sizes[0]);
+    for (Scalar& value : values) {
+        if (!(ifs >> value)) [[unlikely]] {
+            throw std::runtime_error(fmt::format("{0:s} is truncated.", file_path.string()));
+        }
+    }
+    return values;
+}
+
+template <std::floating_point Scalar, std::integral Index>
+auto readMatrixMarketMatrix(const std::filesystem::path& file_path)
+    -> std::tuple<std::size_t, std::size_t, std::vector<std::tuple<Index, Index, Scalar>>> {
+    auto [ifs, banner, sizes] = openMatrixMarket(file_path);
+    if (banner.find("coordinate") == std::string::npos) [[unlikely]] {
+        throw std::runtime_error(fmt::format("{0:s} is not a sparse matrix.", file_path.string()));
+    }
+    std::vector<std::tuple<Index, Index, Scalar>> triplets(sizes[2]);
+    for (auto& [row, col, value] : triplets) {
+        if (!(ifs >> row >> col >> value)) [[unlikely]] {
+            throw std::runtime_error(fmt::format("{0:s} is truncated.", file_path.string()));
+        }
+        if (row < 1 || col < 1 || static_cast<std::size_t>(row) > sizes[0] ||
+            static_cast<std::size_t>(col) > sizes[1]) [[unlikely]] {
+            throw std::runtime_error(fmt::format(
+                "Entry ({0:d}, {1:d}) lies outside the {2:d} x {3:d} matrix in {4:s}.", row, col,
+                sizes[0], sizes[1], file_path.string()
+            ));
+        }
+        --row;
+        --col;
+    }
+    return std::make_tuple(sizes[0], sizes[1], std::move(triplets));
+}
+
+} // namespace detail
+
+/**
+ * @brief Writes the capture as a directory of Matrix Market files readable by scipy.io.mmread or
+ * MATLAB: P.mtx (symmetric, lower triangle), A.mtx, q.mtx, l.mtx, u.mtx, x0.mtx and y0.mtx when a
+ * warm start was given, and the settings as "name value" lines in settings.txt.
+ */
+template <std::floating_point Scalar, std::integral Index>
+auto saveQpCaptureBundle(
+    const QpCapture<Scalar, Index>& capture, const std::filesystem::path& directory
+) -> void {
+    std::filesystem::create_directories(directory);
+    const QpProblem<Scalar, Index>& qp_problem{capture.qp_problem};
+
+    std::vector<std::tuple<Index, Index, Scalar>> triplets;
+    triplets.reserve(qp_problem.objectiveMatrix().nnzs());
+    for (const auto& [index_pair, value] : qp_problem.objectiveMatrix().dictionary()) {
+        triplets.emplace_back(index_pair.col, index_pair.row, value);
+    }
+    detail::writeMatrixMarketMatrix(
+        directory / "P.mtx", qp_problem.num_variables(), qp_problem.num_variables(),
+        std::move(triplets), true
+    );
+
+    triplets.clear();
+    triplets.reserve(qp_problem.constrainMatrix().nnzs());
+    for (const auto& [row, row_dictionary] : qp_problem.constrainMatrix().row_dictionaries()) {
+        for (const auto& [col, value] : row_dictionary) {
+            triplets.emplace_back(row, col, value);
+        }
+    }
+    detail::writeMatrixMarketMatrix(
+        directory / "A.mtx", qp_problem.num_constraints(), qp_problem.num_variables(),
+        std::move(triplets), false
+    );
+
+    detail::writeMatrixMarketVector<Scalar>(directory / "q.mtx", qp_problem.objectiveVector());
+    detail::writeMatrixMarketVector<Scalar>(directory / "l.mtx", qp_problem.lowerBounds());
+    detail::writeMatrixMarketVector<Scalar>(directory / "u.mtx", qp_problem.upperBounds());
+    if (!capture.prim_vars_0.empty()) {
+        detail::writeMatrixMarketVector<Scalar>(directory / "x0.mtx", capture.prim_vars_0);
+    }
+    if (!capture.dual_vars_0.empty()) {
+        detail::writeMatrixMarketVector<Scalar>(directory / "y0.mtx", capture.dual_vars_0);
+    }
+
+    std::ofstream ofs{directory / "settings.txt", std::ios::trunc};
+    Settings<Scalar, Index> settings{capture.settings};
+    visitSettings(settings, [&ofs](std::string_view name, const auto& field) -> void {
+        ofs << fmt::format("{0:s} {1}\n", name, field);
+    });
+    return;
+}
+
+template <std::floating_point Scalar = double, std::integral Index = int>
+auto loadQpCaptureBundle(const std::filesystem::path& directory) -> QpCapture<Scalar, Index> {
+    auto [num_vars, p_ncols, p_triplets] =
+        detail::readMatrixMarketMatrix<Scalar, Index>(directory / "P.mtx");
+    auto [num_cons, a_ncols, a_triplets] =
+        detail::readMatrixMarketMatrix<Scalar, Index>(directory / "A.mtx");
+    const std::vector<Scalar> q{detail::readMatrixMarketVector<Scalar>(directory / "q.mtx")};
+    const std::vector<Scalar> l{detail::readMatrixMarketVector<Scalar>(directory / "l.mtx")};
+    const std::vector<Scalar> u{detail::readMatrixMarketVector<Scalar>(directory / "u.mtx")};
+    if (p_ncols != num_vars || a_ncols != num_vars || q.size() != num_vars ||
+        l.size() != num_cons || u.size() != num_cons) [[unlikely]] {
+        throw std::runtime_error(
+            fmt::format("Inconsistent sizes in QP bundle {0:s}.", directory.string())
+        );
+    }
+
+    QpCapture<Scalar, Index> capture{.qp_problem{num_vars, num_cons}};
+    QpProblem<Scalar, Index>& qp_problem{capture.qp_problem};
+    for (const auto& [row, col, value] : p_triplets) {
+        // The file holds the lower triangle of P, whose diagonal is twice the quadratic coeff.
+        qp_problem.updateQuadCostTerm(col, row, row == col ? value * 0.5 : value);
+    }
+    for (std::size_t i{0}; i < num_vars; ++i) {
+        qp_problem.updateLinCostTerm(static_cast<Index>(i), q[i]);
+    }
+    std::vector<boost::unordered_flat_map<Index, Scalar>> rows(num_cons);
+    for (const auto& [row, col, value] : a_triplets) {
+        rows[row].emplace(col, value);
+    }
+    for (std::size_t i{0}; i < num_cons; ++i) {
+        qp_problem.updateConstrainTerm(static_cast<Index>(i), rows[i], l[i], u[i]);
+    }
+
+    if (std::filesystem::exists(directory / "x0.mtx")) {
+        capture.prim_vars_0 = detail::readMatrixMarketVector<Scalar>(directory / "x0.mtx");
+    }
+    if (std::filesystem::exists(directory / "y0.mtx")) {
+        capture.dual_vars_0 = detail::readMatrixMarketVector<Scalar>(directory / "y0.mtx");
+    }
+    if ((!capture.prim_vars_0.empty() && capture.prim_vars_0.size() != num_vars) ||
+        (!capture.dual_vars_0.empty() && capture.dual_vars_0.size() != num_cons)) [[unlikely]] {
+        throw std::runtime_error(
+            fmt::format("Inconsistent warm start sizes in QP bundle {0:s}.", directory.string())
+        );
+    }
+
+    std::ifstream ifs{directory / "settings.txt"};
+    boost::unordered_flat_map<std::string, std::string> entries;
+    for (std::string name, value; ifs >> name >> value;) {
+        entries.emplace(std::move(name), std::move(value));
+    }
+    visitSettings(capture.settings, [&entries](std::string_view name, auto& field) -> void {
+        if (const auto it{entries.find(std::string{name})}; it != entries.cend()) {
+            std::istringstream iss{it->second};
+            iss >> std::boolalpha >> field;
+        }
+    });
+    return capture;
+}
+
+/**
+ * @brief Loads every capture in a directory, both "*.qp" archives and Matrix Market bundle
+ * subdirectories, sorted by path.
+ */
+template <std::floating_point Scalar = double, std::integral Index = int>
+auto loadQpCaptures(const std::filesystem::path& directory)
+    -> std::vector<std::pair<std::filesystem::path, QpCapture<Scalar, Index>>> {
+    std::vector<std::filesystem::path> paths;
+    for (const std::filesystem::directory_entry& entry :
+         std::filesystem::directory_iterator{directory}) {
+        if ((entry.is_regular_file() && entry.path().extension() == ".qp") ||
+            (entry.is_directory() && std::filesystem::exists(entry.path() / "P.mtx"))) {
+            paths.push_back(entry.path());
+        }
+    }
+    std::ranges::sort(paths);
+    std::vector<std::pair<std::filesystem::path, QpCapture<Scalar, Index>>> captures;
+    captures.reserve(paths.size());
+    for (std::filesystem::path& path : paths) {
+        QpCapture<Scalar, Index> capture{
+            std::filesystem::is_directory(path) ? loadQpCaptureBundle<Scalar, Index>(path)
+                                                : loadQpCapture<Scalar, Index>(path)
+        };
+        captures.emplace_back(std::move(path), std::move(capture));
+    }
+    return captures;
+}
+
+} // namespace boyle::cvxopm
+
+namespace boost::serialization {
+
+template <std::floating_point Scalar, std::integral Index>
+[[using gnu: always_inline]]
+inline auto serialize(
+    auto& archive, ::boyle::cvxopm::QpCapture<Scalar, Index>& obj,
+    [[maybe_unused]] const unsigned int version
+) noexcept -> void {
+    archive & obj.qp_problem;
+    archive & obj.settings;
+    archive & obj.prim_vars_0;
+    archive & obj.dual_vars_0;
+    return;
+}
+
+} // namespace boost::serialization
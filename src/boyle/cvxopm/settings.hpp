@@ -79,7 +79,7 @@ template <std::floating_point Scalar, std::integral Index>
 inline auto serialize(
     auto& archive, ::boyle::cvxopm::Settings<Scalar, Index>& obj,
     [[maybe_unused]] const unsigned int version
-) noexcept -> void {
+) -> void {
     archive & obj.device;
     archive & obj.linsys_solver;
     archive & obj.verbose;
@@ -21,6 +21,8 @@ extern "C" {
 #include "osqp.h"
 }
 
+#include "boyle/common/utils/tracing.hpp"
+#include "boyle/cvxopm/qp_capture.hpp"
 #include "boyle/math/sparse_matrix/csc_matrix.hpp"
 
 namespace boyle::cvxopm {
@@ -31,6 +33,7 @@ auto OsqpSolver<OSQPFloat, OSQPInt>::solve(
     const QpProblem<OSQPFloat, OSQPInt>& qp_problem, std::span<const OSQPFloat> prim_vars_0,
     std::span<const OSQPFloat> dual_vars_0
 ) const -> std::pair<::boyle::cvxopm::Result<OSQPFloat, OSQPInt>, Info<OSQPFloat, OSQPInt>> {
+    BOYLE_TRACE_SCOPE("OsqpSolver::solve");
 #if BOYLE_CHECK_PARAMS == 1
     if (!prim_vars_0.empty() && prim_vars_0.size() != qp_problem.num_variables()) [[unlikely]] {
         throw std::invalid_argument(fmt::format(
@@ -169,6 +172,10 @@ auto OsqpSolver<OSQPFloat, OSQPInt>::solve(
         .run_time = solver->info->run_time
     };
 
+    if (qpCaptureOptions() != nullptr) [[unlikely]] {
+        captureQpProblem(qp_problem, settings, prim_vars_0, dual_vars_0, info);
+    }
+
     return std::make_pair(std::move(result), info);
 }
 
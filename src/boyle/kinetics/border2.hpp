@@ -57,7 +57,7 @@ namespace boost::serialization {
 inline auto serialize(
     auto& archive, boyle::math::InstanceOfTemplate<boyle::kinetics::HardBorder2> auto& obj,
     [[maybe_unused]] const unsigned int version
-) noexcept -> void {
+) -> void {
     archive & obj.id;
     archive & obj.chirality;
     archive & obj.bound_points;
@@ -68,7 +68,7 @@ inline auto serialize(
 inline auto serialize(
     auto& archive, boyle::math::InstanceOfTemplate<boyle::kinetics::SoftBorder2> auto& obj,
     [[maybe_unused]] const unsigned int version
-) noexcept -> void {
+) -> void {
     archive & obj.id;
     archive & obj.chirality;
     archive & obj.bound_points;
@@ -0,0 +1,424 @@
+/**
+ * @file collision_checker2.hpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2024-06-14
+ *
+ * @copyright Copyright (c) 2024 Boyle Development Team
+ *            All rights reserved.
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "fmt/format.h"
+
+#include "boyle/common/utils/task_scheduler.hpp"
+#include "boyle/kinetics/obstacle2.hpp"
+#include "boyle/kinetics/path2.hpp"
+#include "boyle/kinetics/trajectory2.hpp"
+#include "boyle/math/aabb_tree2.hpp"
+#include "boyle/math/geometry2.hpp"
+#include "boyle/math/vec2.hpp"
+
+namespace boyle::kinetics {
+
+enum class FootprintShape : std::uint8_t {
+    BOX,
+    DISCS
+};
+
+/**
+ * @brief Vehicle outline relative to the reference point tracked by the path, e.g. the rear axle
+ * center. The disc cover spreads num_discs equal discs along the box centerline.
+ */
+template <std::floating_point T>
+struct [[nodiscard]] VehicleFootprint2 final {
+    using value_type = T;
+    value_type front_length{0.0};
+    value_type rear_length{0.0};
+    value_type half_width{0.0};
+    std::size_t num_discs{3};
+};
+
+template <std::floating_point T>
+struct [[nodiscard]] CollisionResult2 final {
+    using value_type = T;
+    bool collided{false};
+    value_type s{std::numeric_limits<value_type>::quiet_NaN()};
+    value_type t{std::numeric_limits<value_type>::quiet_NaN()};
+    std::uint64_t obstacle_id{std::numeric_limits<std::uint64_t>::max()};
+    std::vector<value_type> ss{};
+    std::vector<value_type> ts{};
+    std::vector<value_type> clearances{};
+};
+
+using VehicleFootprint2f = VehicleFootprint2<float>;
+using VehicleFootprint2d = VehicleFootprint2<double>;
+
+using CollisionResult2f = CollisionResult2<float>;
+using CollisionResult2d = CollisionResult2<double>;
+
+/**
+ * @brief Checks footprints swept along paths or trajectories against static obstacles and
+ * time-indexed obstacle predictions. Poses are grouped into segments whose bounding boxes,
+ * inflated by the clearance horizon, query a BVH over the static obstacles; only the obstacles
+ * that survive are tested with SAT per pose. Clearances are capped at the clearance horizon.
+ */
+template <std::floating_point T>
+class [[nodiscard]] CollisionChecker2 final {
+  public:
+    struct PoseSample final {
+        T s;
+        T t;
+        ::boyle::math::Vec2<T> position;
+        T heading;
+    };
+
+    CollisionChecker2() noexcept = default;
+    CollisionChecker2(const CollisionChecker2& other) = default;
+    auto operator=(const CollisionChecker2& other) -> CollisionChecker2& = default;
+    CollisionChecker2(CollisionChecker2&& other) noexcept = default;
+    auto operator=(CollisionChecker2&& other) noexcept -> CollisionChecker2& = default;
+    ~CollisionChecker2() noexcept = default;
+
+    [[using gnu: always_inline]]
+    explicit CollisionChecker2(
+        VehicleFootprint2<T> footprint, std::vector<StaticObstacle2<T>> static_obstacles,
+        std::vector<DynamicObstacle2<T>> dynamic_obstacles = {},
+        FootprintShape shape = FootprintShape::BOX, T clearance_horizon = 5.0
+    ) noexcept(!BOYLE_CHECK_PARAMS)
+        : m_footprint{footprint}, m_shape{shape}, m_clearance_horizon{clearance_horizon},
+          m_static_obstacles{std::move(static_obstacles)},
+          m_dynamic_obstacles{std::move(dynamic_obstacles)} {
+#if BOYLE_CHECK_PARAMS == 1
+        if (m_footprint.num_discs == 0) [[unlikely]] {
+            throw std::invalid_argument(
+                "Invalid arguments detected! The footprint must be covered by at least one disc."
+            );
+        }
+        for (const DynamicObstacle2<T>& obstacle : m_dynamic_obstacles) {
+            if (obstacle.ts.empty() || obstacle.ts.size() != obstacle.centers.size() ||
+                obstacle.ts.size() != obstacle.headings.size()) [[unlikely]] {
+                throw std::invalid_argument(fmt::format(
+                    "Invalid arguments detected! The prediction of a dynamic obstacle must "
+                    "have matched non-empty sizes: ts.size() = {0:d}, centers.size() = {1:d}, "
+                    "headings.size() = {2:d}.",
+                    obstacle.ts.size(), obstacle.centers.size(), obstacle.headings.size()
+                ));
+            }
+        }
+#endif
+        std::vector<::boyle::math::Aabb2<T>> static_boxes;
+        static_boxes.reserve(m_static_obstacles.size());
+        for (const StaticObstacle2<T>& obstacle : m_static_obstacles) {
+            static_boxes.push_back(::boyle::math::Aabb2<T>::of(obstacle.vertices));
+        }
+        m_static_tree = ::boyle::math::AabbTree2<T>{std::move(static_boxes)};
+        m_dynamic_boxes.reserve(m_dynamic_obstacles.size());
+        for (const DynamicObstacle2<T>& obstacle : m_dynamic_obstacles) {
+            const T radius{std::hypot(obstacle.half_length, obstacle.half_width)};
+            ::boyle::math::Aabb2<T> box{::boyle::math::Aabb2<T>::empty()};
+            for (const ::boyle::math::Vec2<T>& center : obstacle.centers) {
+                box = box.merged(::boyle::math::Aabb2<T>{.lower = center, .upper = center});
+            }
+            m_dynamic_boxes.push_back(box.inflated(radius));
+        }
+    }
+
+    /**
+     * @brief Checks a path against the static obstacles at arc length spacing ds.
+     */
+    [[using gnu: flatten]]
+    auto check(const Path2<T>& path, T ds, bool early_exit = false) const -> CollisionResult2<T> {
+#if BOYLE_CHECK_PARAMS == 1
+        if (ds <= 0.0) [[unlikely]] {
+            throw std::invalid_argument(fmt::format(
+                "Invalid argument detected! The arc length spacing must be positive: ds = {0:.6f}.",
+                ds
+            ));
+        }
+#endif
+        const std::size_t num_samples{
+            static_cast<std::size_t>(std::ceil((path.maxS() - path.minS()) / ds)) + 1
+        };
+        std::vector<PoseSample> poses;
+        poses.reserve(num_samples);
+        for (std::size_t i{0}; i < num_samples; ++i) {
+            const T s{std::min(path.minS() + ds * static_cast<T>(i), path.maxS())};
+            poses.push_back(PoseSample{
+                .s = s,
+                .t = std::numeric_limits<T>::quiet_NaN(),
+                .position = path(s),
+                .heading = path.tangent(s).angle()
+            });
+        }
+        return check(poses, early_exit);
+    }
+
+    /**
+     * @brief Checks a trajectory against the static obstacles and the obstacle predictions at
+     * time spacing dt.
+     */
+    [[using gnu: flatten]]
+    auto check(const Trajectory2<T>& trajectory, T dt, bool early_exit = false) const
+        -> CollisionResult2<T> {
+#if BOYLE_CHECK_PARAMS == 1
+        if (dt <= 0.0) [[unlikely]] {
+            throw std::invalid_argument(fmt::format(
+                "Invalid argument detected! The time spacing must be positive: dt = {0:.6f}.", dt
+            ));
+        }
+#endif
+        const std::size_t num_samples{
+            static_cast<std::size_t>(
+                std::floor((trajectory.maxT() - trajectory.minT()) / dt + ::boyle::math::kEpsilon)
+            ) +
+            1
+        };
+        const std::vector<TrajectoryState2<T>> states{
+            trajectory.sample(trajectory.minT(), dt, num_samples)
+        };
+        std::vector<PoseSample> poses;
+        poses.reserve(num_samples);
+        for (const TrajectoryState2<T>& state : states) {
+            poses.push_back(PoseSample{
+                .s = state.s,
+                .t = state.t,
+                .position = {state.x, state.y},
+                .heading = state.heading
+            });
+        }
+        return check(poses, early_exit);
+    }
+
+    /**
+     * @brief Checks a batch of candidate trajectories, in parallel over candidates.
+     */
+    auto check(std::span<const Trajectory2<T>> trajectories, T dt, bool early_exit = false) const
+        -> std::vector<CollisionResult2<T>> {
+        std::vector<CollisionResult2<T>> results(trajectories.size());
+        const std::int64_t size{static_cast<std::int64_t>(trajectories.size())};
+        ::boyle::common::TaskScheduler::getInstance()->parallelFor(
+            std::int64_t{0}, size,
+            [&](std::int64_t i) -> void {
+                results[i] = check(trajectories[i], dt, early_exit);
+            }
+        );
+        return results;
+    }
+
+    /**
+     * @brief Checks a sequence of poses ordered along the motion. With early_exit the profile
+     * stops at the first colliding pose and clearances are not computed; the collision verdict is
+     * the same as without it.
+     */
+    [[using gnu: flatten, hot]]
+    auto check(std::span<const PoseSample> poses, bool early_exit = false) const
+        -> CollisionResult2<T> {
+        CollisionResult2<T> result;
+        result.ss.reserve(poses.size());
+        result.ts.reserve(poses.size());
+        result.clearances.reserve(poses.size());
+        std::vector<std::size_t> static_candidates;
+        std::vector<std::size_t> dynamic_candidates;
+        const T margin{(early_exit ? T{0.0} : m_clearance_horizon) + footprintOverhang()};
+        for (std::size_t first{0}; first < poses.size(); first += kSegmentSize) {
+            const std::size_t last{std::min(first + kSegmentSize, poses.size())};
+            ::boyle::math::Aabb2<T> segment_box{::boyle::math::Aabb2<T>::empty()};
+            for (std::size_t i{first}; i < last; ++i) {
+                segment_box =
+                    segment_box.merged(::boyle::math::Aabb2<T>::of(footprintBox(poses[i])));
+            }
+            segment_box = segment_box.inflated(margin);
+            static_candidates.clear();
+            m_static_tree.query(segment_box, [&static_candidates](std::size_t index) noexcept {
+                static_candidates.push_back(index);
+            });
+            dynamic_candidates.clear();
+            for (std::size_t i{0}; i < m_dynamic_boxes.size(); ++i) {
+                if (m_dynamic_boxes[i].overlaps(segment_box)) {
+                    dynamic_candidates.push_back(i);
+                }
+            }
+            for (std::size_t i{first}; i < last; ++i) {
+                const PoseSample& pose{poses[i]};
+                const std::array<::boyle::math::Vec2<T>, 4> box{footprintBox(pose)};
+                T clearance{m_clearance_horizon};
+                std::uint64_t obstacle_id{std::numeric_limits<std::uint64_t>::max()};
+                const auto visit = [&](std::span<const ::boyle::math::Vec2<T>> polygon,
+                                       std::uint64_t id) noexcept -> void {
+                    const T distance{
+                        early_exit ? footprintSeparation(pose, box, polygon)
+                                   : footprintDistance(pose, box, polygon)
+                    };
+                    if (distance < clearance) {
+                        clearance = distance;
+                        obstacle_id = id;
+                    }
+                };
+                for (std::size_t index : static_candidates) {
+                    visit(m_static_obstacles[index].vertices, m_static_obstacles[index].id);
+                }
+                if (!std::isnan(pose.t)) {
+                    for (std::size_t index : dynamic_candidates) {
+                        const std::array<::boyle::math::Vec2<T>, 4> obstacle_box{
+                            dynamicObstacleBox(m_dynamic_obstacles[index], pose.t)
+                        };
+                        visit(obstacle_box, m_dynamic_obstacles[index].id);
+                    }
+                }
+                result.ss.push_back(pose.s);
+                result.ts.push_back(pose.t);
+                result.clearances.push_back(std::min(clearance, m_clearance_horizon));
+                if (clearance <= 0.0 && !result.collided) {
+                    result.collided = true;
+                    result.s = pose.s;
+                    result.t = pose.t;
+                    result.obstacle_id = obstacle_id;
+                    if (early_exit) {
+                        return result;
+                    }
+                }
+            }
+        }
+        return result;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto footprint() const noexcept -> const VehicleFootprint2<T>& {
+        return m_footprint;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto shape() const noexcept -> FootprintShape {
+        return m_shape;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto clearanceHorizon() const noexcept -> T {
+        return m_clearance_horizon;
+    }
+
+  private:
+    static constexpr std::size_t kSegmentSize{8};
+
+    [[using gnu: pure, always_inline]]
+    auto footprintBox(const PoseSample& pose) const noexcept
+        -> std::array<::boyle::math::Vec2<T>, 4> {
+        const T half_length{(m_footprint.front_length + m_footprint.rear_length) * 0.5};
+        const ::boyle::math::Vec2<T> center{
+            pose.position + ::boyle::math::Vec2<T>{std::cos(pose.heading), std::sin(pose.heading)} *
+                                (m_footprint.front_length - half_length)
+        };
+        return ::boyle::math::orientedBoxVertices(
+            center, pose.heading, half_length, m_footprint.half_width
+        );
+    }
+
+    /**
+     * @brief How far the footprint shape reaches past footprintBox(). The discs bulge out of the
+     * box sideways and beyond both ends.
+     */
+    [[using gnu: pure, always_inline]]
+    auto footprintOverhang() const noexcept -> T {
+        if (m_shape == FootprintShape::BOX) {
+            return 0.0;
+        }
+        const T spacing{
+            (m_footprint.front_length + m_footprint.rear_length) /
+            static_cast<T>(m_footprint.num_discs)
+        };
+        return std::hypot(spacing * 0.5, m_footprint.half_width) -
+               std::min(spacing * 0.5, m_footprint.half_width);
+    }
+
+    /**
+     * @brief Cheaper stand-in for footprintDistance() that only has to agree with it on the sign:
+     * SAT separation for the box. The disc distance is already cheap and is used as it is.
+     */
+    [[using gnu: pure, always_inline, hot]]
+    auto footprintSeparation(
+        const PoseSample& pose, std::span<const ::boyle::math::Vec2<T>> box,
+        std::span<const ::boyle::math::Vec2<T>> polygon
+    ) const noexcept -> T {
+        if (m_shape == FootprintShape::BOX) {
+            return ::boyle::math::polygonSeparation(box, polygon);
+        }
+        return footprintDistance(pose, box, polygon);
+    }
+
+    [[using gnu: pure, flatten, hot]]
+    auto footprintDistance(
+        const PoseSample& pose, std::span<const ::boyle::math::Vec2<T>> box,
+        std::span<const ::boyle::math::Vec2<T>> polygon
+    ) const noexcept -> T {
+        if (m_shape == FootprintShape::BOX) {
+            return ::boyle::math::polygonDistance(box, polygon);
+        }
+        const std::size_t num_discs{m_footprint.num_discs};
+        const T half_length{(m_footprint.front_length + m_footprint.rear_length) * 0.5};
+        const T spacing{half_length * 2.0 / static_cast<T>(num_discs)};
+        const T radius{std::hypot(spacing * 0.5, m_footprint.half_width)};
+        const ::boyle::math::Vec2<T> direction{std::cos(pose.heading), std::sin(pose.heading)};
+        T result{std::numeric_limits<T>::max()};
+        for (std::size_t i{0}; i < num_discs; ++i) {
+            const ::boyle::math::Vec2<T> center{
+                pose.position +
+                direction * (-m_footprint.rear_length + spacing * (static_cast<T>(i) + 0.5))
+            };
+            result =
+                std::min(result, ::boyle::math::pointPolygonDistance(center, polygon) - radius);
+        }
+        return result;
+    }
+
+    [[using gnu: pure, always_inline]]
+    static auto dynamicObstacleBox(const DynamicObstacle2<T>& obstacle, T t) noexcept
+        -> std::array<::boyle::math::Vec2<T>, 4> {
+        const std::vector<T>& ts{obstacle.ts};
+        const std::size_t pos = std::ranges::upper_bound(ts, t) - ts.cbegin();
+        if (pos == 0 || pos == ts.size()) {
+            const std::size_t index{pos == 0 ? 0 : ts.size() - 1};
+            return ::boyle::math::orientedBoxVertices(
+                obstacle.centers[index], obstacle.headings[index], obstacle.half_length,
+                obstacle.half_width
+            );
+        }
+        const T ratio{(t - ts[pos - 1]) / (ts[pos] - ts[pos - 1])};
+        const T dheading{std::remainder(
+            obstacle.headings[pos] - obstacle.headings[pos - 1], 2.0 * std::numbers::pi_v<T>
+        )};
+        return ::boyle::math::orientedBoxVertices(
+            obstacle.centers[pos - 1] + (obstacle.centers[pos] - obstacle.centers[pos - 1]) * ratio,
+            obstacle.headings[pos - 1] + dheading * ratio, obstacle.half_length,
+            obstacle.half_width
+        );
+    }
+
+    VehicleFootprint2<T> m_footprint{};
+    FootprintShape m_shape{FootprintShape::BOX};
+    T m_clearance_horizon{5.0};
+    std::vector<StaticObstacle2<T>> m_static_obstacles{};
+    std::vector<DynamicObstacle2<T>> m_dynamic_obstacles{};
+    ::boyle::math::AabbTree2<T> m_static_tree{};
+    std::vector<::boyle::math::Aabb2<T>> m_dynamic_boxes{};
+};
+
+using CollisionChecker2f = CollisionChecker2<float>;
+using CollisionChecker2d = CollisionChecker2<double>;
+
+} // namespace boyle::kinetics
@@ -58,7 +58,7 @@ namespace boost::serialization {
 inline auto serialize(
     auto& archive, boyle::math::InstanceOfTemplate<boyle::kinetics::HardFence1> auto& obj,
     [[maybe_unused]] const unsigned int version
-) noexcept -> void {
+) -> void {
     archive & obj.id;
     archive & obj.actio;
     archive & obj.bound_ts;
@@ -70,7 +70,7 @@ inline auto serialize(
 inline auto serialize(
     auto& archive, boyle::math::InstanceOfTemplate<boyle::kinetics::SoftFence1> auto& obj,
     [[maybe_unused]] const unsigned int version
-) noexcept -> void {
+) -> void {
     archive & obj.id;
     archive & obj.actio;
     archive & obj.bound_ts;
@@ -0,0 +1,485 @@
+/**
+ * @file bicycle_mpc_model.cpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2024-06-19
+ *
+ * @copyright Copyright (c) 2024 Boyle Development Team
+ *            All rights reserved.
+ *
+ */
+
+#include "boyle/kinetics/models/bicycle_mpc_model.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <span>
+#include <stdexcept>
+#include <utility>
+
+#include "boost/unordered/unordered_flat_map.hpp"
+#include "fmt/format.h"
+
+#include "boyle/common/utils/logging.hpp"
+#include "boyle/common/utils/tracing.hpp"
+#include "boyle/math/utils.hpp"
+
+namespace {
+
+[[using gnu: const, always_inline]] [[nodiscard]]
+inline auto wrapAngle(double angle) noexcept -> double {
+    return std::remainder(angle, 2.0 * std::numbers::pi);
+}
+
+[[using gnu: const, always_inline]] [[nodiscard]]
+inline auto scaleBound(double bound, double scale) noexcept -> double {
+    if (bound == std::numeric_limits<double>::lowest() ||
+        bound == std::numeric_limits<double>::max()) {
+        return bound;
+    }
+    return bound * scale;
+}
+
+} // namespace
+
+namespace boyle::kinetics {
+
+BicycleMpcModel::BicycleMpcModel(
+    std::size_t num_steps, double dt, double wheelbase, std::pmr::memory_resource* resource
+) noexcept(!BOYLE_CHECK_PARAMS)
+    : m_qp_problem{resource} {
+#if BOYLE_CHECK_PARAMS == 1
+    if (num_steps < 1 || dt <= 0.0 || wheelbase <= 0.0) [[unlikely]] {
+        throw std::invalid_argument(fmt::format(
+            "Invalid arguments detected! num_steps must be positive while dt and wheelbase must be "
+            "larger than zero: num_steps = {0:d}, dt = {1:.6f}, wheelbase = {2:.6f}.",
+            num_steps, dt, wheelbase
+        ));
+    }
+#endif
+    m_num_steps = static_cast<int>(num_steps);
+    m_dt = dt;
+    m_wheelbase = wheelbase;
+    m_qp_problem.resize(
+        m_num_steps * kStageVars + kNumStates, kNumStates + m_num_steps * kStageCons
+    );
+    m_ref_states.resize(m_num_steps + 1);
+    for (int k{0}; k <= m_num_steps; ++k) {
+        m_ref_states[k].t = m_dt * k;
+    }
+    m_ref_headings.resize(m_num_steps + 1, 0.0);
+    m_ref_steerings.resize(m_num_steps + 1, 0.0);
+    setStructure();
+}
+
+BicycleMpcModel::BicycleMpcModel(
+    std::size_t num_steps, double dt, double wheelbase,
+    const ::boyle::cvxopm::Settings<double, int>& settings, std::pmr::memory_resource* resource
+) noexcept(!BOYLE_CHECK_PARAMS)
+    : BicycleMpcModel{num_steps, dt, wheelbase, resource} {
+    m_settings = settings;
+}
+
+auto BicycleMpcModel::num_steps() const noexcept -> std::size_t { return m_num_steps; }
+
+auto BicycleMpcModel::qp_problem() const noexcept
+    -> const ::boyle::cvxopm::QpProblem<double, int>& {
+    return m_qp_problem;
+}
+
+auto BicycleMpcModel::settings() const noexcept -> const ::boyle::cvxopm::Settings<double, int>& {
+    return m_settings;
+}
+
+auto BicycleMpcModel::setStructure() noexcept -> void {
+    BOYLE_TRACE_SCOPE("BicycleMpcModel::setStructure");
+    for (int k{0}; k < m_num_steps; ++k) {
+        m_qp_problem.updateConstrainTerm(
+            steeringRow(k), {{steeringIndex(k), 1.0}}, std::numeric_limits<double>::lowest(),
+            std::numeric_limits<double>::max()
+        );
+        m_qp_problem.updateConstrainTerm(
+            accelRow(k), {{accelIndex(k), 1.0}}, std::numeric_limits<double>::lowest(),
+            std::numeric_limits<double>::max()
+        );
+        m_qp_problem.updateConstrainTerm(
+            velocityRow(k), {{velocityIndex(k + 1), 1.0}}, std::numeric_limits<double>::lowest(),
+            std::numeric_limits<double>::max()
+        );
+    }
+    updateInitialState();
+    updateDynamics();
+    updateSteeringRateBounds();
+    updateCosts();
+    return;
+}
+
+auto BicycleMpcModel::setReference(const Trajectory2d& reference, double t0) noexcept -> void {
+    BOYLE_TRACE_SCOPE("BicycleMpcModel::setReference");
+    reference.sample(t0, m_dt, m_ref_states.size(), m_ref_states);
+    m_ref_headings[0] = m_ref_states[0].heading;
+    m_ref_steerings[0] = std::atan(m_wheelbase * m_ref_states[0].curvature);
+    for (int k{1}; k <= m_num_steps; ++k) {
+        m_ref_headings[k] =
+            m_ref_headings[k - 1] + wrapAngle(m_ref_states[k].heading - m_ref_headings[k - 1]);
+        m_ref_steerings[k] = std::atan(m_wheelbase * m_ref_states[k].curvature);
+    }
+    updateInitialState();
+    updateDynamics();
+    updateCosts();
+    return;
+}
+
+auto BicycleMpcModel::setInitialState(
+    double x, double y, double heading, double velocity, double steering
+) noexcept -> void {
+    BOYLE_TRACE_SCOPE("BicycleMpcModel::setInitialState");
+    m_initial_state = {x, y, heading, velocity};
+    m_initial_steering = steering;
+    updateInitialState();
+    updateSteeringRateBounds();
+    updateCosts();
+    return;
+}
+
+auto BicycleMpcModel::setSteeringRange(double lower_bound, double upper_bound) noexcept -> void {
+    BOYLE_TRACE_SCOPE("BicycleMpcModel::setSteeringRange");
+    for (int k{0}; k < m_num_steps; ++k) {
+        m_qp_problem.updateConstrainTerm(
+            steeringRow(k), {{steeringIndex(k), 1.0}}, lower_bound, upper_bound
+        );
+    }
+    return;
+}
+
+auto BicycleMpcModel::setSteeringRateRange(double lower_bound, double upper_bound) noexcept
+    -> void {
+    BOYLE_TRACE_SCOPE("BicycleMpcModel::setSteeringRateRange");
+    m_steering_rate_range = {lower_bound, upper_bound};
+    updateSteeringRateBounds();
+    return;
+}
+
+auto BicycleMpcModel::setAccelRange(double lower_bound, double upper_bound) noexcept -> void {
+    BOYLE_TRACE_SCOPE("BicycleMpcModel::setAccelRange");
+    for (int k{0}; k < m_num_steps; ++k) {
+        m_qp_problem.updateConstrainTerm(
+            accelRow(k), {{accelIndex(k), 1.0}}, lower_bound, upper_bound
+        );
+    }
+    return;
+}
+
+auto BicycleMpcModel::setVelocityRange(double lower_bound, double upper_bound) noexcept -> void {
+    BOYLE_TRACE_SCOPE("BicycleMpcModel::setVelocityRange");
+    for (int k{0}; k < m_num_steps; ++k) {
+        m_qp_problem.updateConstrainTerm(
+            velocityRow(k), {{velocityIndex(k + 1), 1.0}}, lower_bound, upper_bound
+        );
+    }
+    return;
+}
+
+auto BicycleMpcModel::setTrackingCost(
+    double lateral_weight, double longitudinal_weight, double heading_weight,
+    double velocity_weight
+) noexcept -> void {
+    BOYLE_TRACE_SCOPE("BicycleMpcModel::setTrackingCost");
+    m_lateral_weight = lateral_weight;
+    m_longitudinal_weight = longitudinal_weight;
+    m_heading_weight = heading_weight;
+    m_velocity_weight = velocity_weight;
+    updateCosts();
+    return;
+}
+
+auto BicycleMpcModel::setInputCost(double steering_weight, double accel_weight) noexcept -> void {
+    BOYLE_TRACE_SCOPE("BicycleMpcModel::setInputCost");
+    m_steering_weight = steering_weight;
+    m_accel_weight = accel_weight;
+    updateCosts();
+    return;
+}
+
+auto BicycleMpcModel::setInputRateCost(double steering_rate_weight, double jerk_weight) noexcept
+    -> void {
+    BOYLE_TRACE_SCOPE("BicycleMpcModel::setInputRateCost");
+    m_steering_rate_weight = steering_rate_weight;
+    m_jerk_weight = jerk_weight;
+    updateCosts();
+    return;
+}
+
+auto BicycleMpcModel::setTerminalCostFactor(double factor) noexcept -> void {
+    BOYLE_TRACE_SCOPE("BicycleMpcModel::setTerminalCostFactor");
+    m_terminal_factor = factor;
+    updateCosts();
+    return;
+}
+
+auto BicycleMpcModel::setWarmStart(const BicycleMpcSolution& previous, std::size_t shift_steps)
+    noexcept -> void {
+    BOYLE_TRACE_SCOPE("BicycleMpcModel::setWarmStart");
+    const std::size_t num_vars{m_qp_problem.num_variables()};
+    const std::size_t num_cons{m_qp_problem.num_constraints()};
+    if (previous.prim_vars.size() != num_vars || previous.dual_vars.size() != num_cons)
+        [[unlikely]] {
+        BOYLE_LOG_WARN(
+            "Invalid argument issue detected! The previous solution does not match the problem "
+            "size and is ignored: prim_vars.size() = {0:d}, num_vars = {1:d}, dual_vars.size() = "
+            "{2:d}, num_cons = {3:d}.",
+            previous.prim_vars.size(), num_vars, previous.dual_vars.size(), num_cons
+        );
+        m_prim_vars_0.clear();
+        m_dual_vars_0.clear();
+        return;
+    }
+    const int shift{static_cast<int>(std::min<std::size_t>(shift_steps, m_num_steps))};
+    m_prim_vars_0.resize(num_vars);
+    m_dual_vars_0.resize(num_cons);
+    for (int k{0}; k <= m_num_steps; ++k) {
+        const int state_source{std::min(k + shift, m_num_steps)};
+        std::copy_n(
+            previous.prim_vars.cbegin() + xIndex(state_source), kNumStates,
+            m_prim_vars_0.begin() + xIndex(k)
+        );
+        if (k == m_num_steps) {
+            break;
+        }
+        const int stage_source{std::min(k + shift, m_num_steps - 1)};
+        std::copy_n(
+            previous.prim_vars.cbegin() + steeringIndex(stage_source), kNumInputs,
+            m_prim_vars_0.begin() + steeringIndex(k)
+        );
+        std::copy_n(
+            previous.dual_vars.cbegin() + dynamicsRow(stage_source), kStageCons,
+            m_dual_vars_0.begin() + dynamicsRow(k)
+        );
+    }
+    std::copy_n(previous.dual_vars.cbegin(), kNumStates, m_dual_vars_0.begin());
+    return;
+}
+
+auto BicycleMpcModel::solve() const
+    -> std::pair<BicycleMpcSolution, ::boyle::cvxopm::Info<double, int>> {
+    BOYLE_TRACE_SCOPE("BicycleMpcModel::solve");
+    const ::boyle::cvxopm::OsqpSolver osqp_solver{m_settings};
+    auto [osqp_result, osqp_info] = osqp_solver.solve(m_qp_problem, m_prim_vars_0, m_dual_vars_0);
+    BicycleMpcSolution solution;
+    solution.ts.reserve(m_num_steps + 1);
+    solution.xs.reserve(m_num_steps + 1);
+    solution.ys.reserve(m_num_steps + 1);
+    solution.headings.reserve(m_num_steps + 1);
+    solution.velocities.reserve(m_num_steps + 1);
+    solution.steerings.reserve(m_num_steps);
+    solution.accels.reserve(m_num_steps);
+    for (int k{0}; k <= m_num_steps; ++k) {
+        solution.ts.push_back(m_ref_states[0].t + m_dt * k);
+        solution.xs.push_back(osqp_result.prim_vars[xIndex(k)]);
+        solution.ys.push_back(osqp_result.prim_vars[yIndex(k)]);
+        solution.headings.push_back(osqp_result.prim_vars[headingIndex(k)]);
+        solution.velocities.push_back(osqp_result.prim_vars[velocityIndex(k)]);
+        if (k < m_num_steps) {
+            solution.steerings.push_back(osqp_result.prim_vars[steeringIndex(k)]);
+            solution.accels.push_back(osqp_result.prim_vars[accelIndex(k)]);
+        }
+    }
+    solution.prim_vars = std::move(osqp_result.prim_vars);
+    solution.dual_vars = std::move(osqp_result.dual_vars);
+    return std::make_pair(std::move(solution), osqp_info);
+}
+
+auto BicycleMpcModel::clear() noexcept -> void {
+    m_num_steps = 0;
+    m_dt = 0.0;
+    m_wheelbase = 0.0;
+    m_qp_problem.clear();
+    m_ref_states.clear();
+    m_ref_headings.clear();
+    m_ref_steerings.clear();
+    m_prim_vars_0.clear();
+    m_dual_vars_0.clear();
+    return;
+}
+
+auto BicycleMpcModel::updateInitialState() noexcept -> void {
+    const double heading{
+        m_ref_headings[0] + wrapAngle(m_initial_state[2] - m_ref_headings[0])
+    };
+    const std::array<double, 4> state{
+        m_initial_state[0], m_initial_state[1], heading, m_initial_state[3]
+    };
+    for (int i{0}; i < kNumStates; ++i) {
+        m_qp_problem.updateConstrainTerm(
+            i, {{xIndex(0) + i, 1.0}}, state[i] - ::boyle::math::kEpsilon,
+            state[i] + ::boyle::math::kEpsilon
+        );
+    }
+    return;
+}
+
+auto BicycleMpcModel::updateDynamics() noexcept -> void {
+    for (int k{0}; k < m_num_steps; ++k) {
+        const double heading{m_ref_headings[k]};
+        const double velocity{m_ref_states[k].velocity};
+        const double steering{m_ref_steerings[k]};
+        const double cos_heading{std::cos(heading)};
+        const double sin_heading{std::sin(heading)};
+        const double tan_steering{std::tan(steering)};
+        const double sec2_steering{1.0 + tan_steering * tan_steering};
+        const int row{dynamicsRow(k)};
+        double offset{-m_dt * velocity * sin_heading * heading};
+        m_qp_problem.updateConstrainTerm(
+            row,
+            {{xIndex(k), 1.0},
+             {headingIndex(k), -m_dt * velocity * sin_heading},
+             {velocityIndex(k), m_dt * cos_heading},
+             {xIndex(k + 1), -1.0}},
+            offset - ::boyle::math::kEpsilon, offset + ::boyle::math::kEpsilon
+        );
+        offset = m_dt * velocity * cos_heading * heading;
+        m_qp_problem.updateConstrainTerm(
+            row + 1,
+            {{yIndex(k), 1.0},
+             {headingIndex(k), m_dt * velocity * cos_heading},
+             {velocityIndex(k), m_dt * sin_heading},
+             {yIndex(k + 1), -1.0}},
+            offset - ::boyle::math::kEpsilon, offset + ::boyle::math::kEpsilon
+        );
+        offset = m_dt * velocity * sec2_steering * steering / m_wheelbase;
+        m_qp_problem.updateConstrainTerm(
+            row + 2,
+            {{headingIndex(k), 1.0},
+             {velocityIndex(k), m_dt * tan_steering / m_wheelbase},
+             {steeringIndex(k), m_dt * velocity * sec2_steering / m_wheelbase},
+             {headingIndex(k + 1), -1.0}},
+            offset - ::boyle::math::kEpsilon, offset + ::boyle::math::kEpsilon
+        );
+        m_qp_problem.updateConstrainTerm(
+            row + 3, {{velocityIndex(k), 1.0}, {accelIndex(k), m_dt}, {velocityIndex(k + 1), -1.0}},
+            -::boyle::math::kEpsilon, ::boyle::math::kEpsilon
+        );
+    }
+    return;
+}
+
+auto BicycleMpcModel::updateSteeringRateBounds() noexcept -> void {
+    const double lower_bound{scaleBound(m_steering_rate_range[0], m_dt)};
+    const double upper_bound{scaleBound(m_steering_rate_range[1], m_dt)};
+    if (std::isnan(m_initial_steering)) {
+        m_qp_problem.updateConstrainTerm(
+            steeringRateRow(0), {{steeringIndex(0), 1.0}}, std::numeric_limits<double>::lowest(),
+            std::numeric_limits<double>::max()
+        );
+    } else {
+        m_qp_problem.updateConstrainTerm(
+            steeringRateRow(0), {{steeringIndex(0), 1.0}},
+            lower_bound == std::numeric_limits<double>::lowest()
+                ? lower_bound
+                : m_initial_steering + lower_bound,
+            upper_bound == std::numeric_limits<double>::max() ? upper_bound
+                                                              : m_initial_steering + upper_bound
+        );
+    }
+    for (int k{1}; k < m_num_steps; ++k) {
+        m_qp_problem.updateConstrainTerm(
+            steeringRateRow(k), {{steeringIndex(k), 1.0}, {steeringIndex(k - 1), -1.0}},
+            lower_bound, upper_bound
+        );
+    }
+    return;
+}
+
+auto BicycleMpcModel::updateCosts() noexcept -> void {
+    const int num_vars{static_cast<int>(m_qp_problem.num_variables())};
+    std::vector<double> quad_coeffs(num_vars, 0.0);
+    std::vector<double> lin_coeffs(num_vars, 0.0);
+
+    for (int k{1}; k <= m_num_steps; ++k) {
+        const double factor{k == m_num_steps ? m_terminal_factor : 1.0};
+        const TrajectoryState2d& ref_state{m_ref_states[k]};
+        const double heading{m_ref_headings[k]};
+        const double cos_heading{std::cos(heading)};
+        const double sin_heading{std::sin(heading)};
+        const double xx{
+            (m_lateral_weight * sin_heading * sin_heading +
+             m_longitudinal_weight * cos_heading * cos_heading) *
+            factor
+        };
+        const double yy{
+            (m_lateral_weight * cos_heading * cos_heading +
+             m_longitudinal_weight * sin_heading * sin_heading) *
+            factor
+        };
+        const double xy{(m_longitudinal_weight - m_lateral_weight) * sin_heading * cos_heading *
+                        factor};
+        quad_coeffs[xIndex(k)] += xx;
+        quad_coeffs[yIndex(k)] += yy;
+        m_qp_problem.updateQuadCostTerm(xIndex(k), yIndex(k), xy * 2.0);
+        lin_coeffs[xIndex(k)] -= (xx * ref_state.x + xy * ref_state.y) * 2.0;
+        lin_coeffs[yIndex(k)] -= (xy * ref_state.x + yy * ref_state.y) * 2.0;
+        quad_coeffs[headingIndex(k)] += m_heading_weight * factor;
+        lin_coeffs[headingIndex(k)] -= m_heading_weight * factor * heading * 2.0;
+        quad_coeffs[velocityIndex(k)] += m_velocity_weight * factor;
+        lin_coeffs[velocityIndex(k)] -= m_velocity_weight * factor * ref_state.velocity * 2.0;
+    }
+
+    const double reciprocal_dt2{1.0 / (m_dt * m_dt)};
+    const double steering_rate_weight{m_steering_rate_weight * reciprocal_dt2};
+    const double jerk_weight{m_jerk_weight * reciprocal_dt2};
+    for (int k{0}; k < m_num_steps; ++k) {
+        quad_coeffs[steeringIndex(k)] += m_steering_weight;
+        lin_coeffs[steeringIndex(k)] -= m_steering_weight * m_ref_steerings[k] * 2.0;
+        quad_coeffs[accelIndex(k)] += m_accel_weight;
+        lin_coeffs[accelIndex(k)] -= m_accel_weight * m_ref_states[k].accel * 2.0;
+        if (k == 0) {
+            if (!std::isnan(m_initial_steering)) {
+                quad_coeffs[steeringIndex(0)] += steering_rate_weight;
+                lin_coeffs[steeringIndex(0)] -= steering_rate_weight * m_initial_steering * 2.0;
+            }
+            continue;
+        }
+        quad_coeffs[steeringIndex(k - 1)] += steering_rate_weight;
+        quad_coeffs[steeringIndex(k)] += steering_rate_weight;
+        m_qp_problem.updateQuadCostTerm(
+            steeringIndex(k - 1), steeringIndex(k), -steering_rate_weight * 2.0
+        );
+        quad_coeffs[accelIndex(k - 1)] += jerk_weight;
+        quad_coeffs[accelIndex(k)] += jerk_weight;
+        m_qp_problem.updateQuadCostTerm(accelIndex(k - 1), accelIndex(k), -jerk_weight * 2.0);
+    }
+
+    for (int i{0}; i < num_vars; ++i) {
+        m_qp_problem.updateQuadCostTerm(i, i, quad_coeffs[i]);
+        m_qp_problem.updateLinCostTerm(i, lin_coeffs[i]);
+    }
+    return;
+}
+
+auto BicycleMpcModel::xIndex(int k) const noexcept -> int { return k * kStageVars; }
+
+auto BicycleMpcModel::yIndex(int k) const noexcept -> int { return k * kStageVars + 1; }
+
+auto BicycleMpcModel::headingIndex(int k) const noexcept -> int { return k * kStageVars + 2; }
+
+auto BicycleMpcModel::velocityIndex(int k) const noexcept -> int { return k * kStageVars + 3; }
+
+auto BicycleMpcModel::steeringIndex(int k) const noexcept -> int { return k * kStageVars + 4; }
+
+auto BicycleMpcModel::accelIndex(int k) const noexcept -> int { return k * kStageVars + 5; }
+
+auto BicycleMpcModel::dynamicsRow(int k) const noexcept -> int {
+    return kNumStates + k * kStageCons;
+}
+
+auto BicycleMpcModel::steeringRow(int k) const noexcept -> int { return dynamicsRow(k) + 4; }
+
+auto BicycleMpcModel::accelRow(int k) const noexcept -> int { return dynamicsRow(k) + 5; }
+
+auto BicycleMpcModel::steeringRateRow(int k) const noexcept -> int { return dynamicsRow(k) + 6; }
+
+auto BicycleMpcModel::velocityRow(int k) const noexcept -> int { return dynamicsRow(k) + 7; }
+
+} // namespace boyle::kinetics
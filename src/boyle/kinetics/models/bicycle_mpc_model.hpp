@@ -0,0 +1,159 @@
+/**
+ * @file bicycle_mpc_model.hpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2024-06-19
+ *
+ * @copyright Copyright (c) 2024 Boyle Development Team
+ *            All rights reserved.
+ *
+ */
+
+#pragma once
+
+#include <array>
+#include <limits>
+#include <memory_resource>
+#include <vector>
+
+#include "boost/serialization/vector.hpp"
+
+#include "boyle/cvxopm/info.hpp"
+#include "boyle/cvxopm/problems/qp_problem.hpp"
+#include "boyle/cvxopm/settings.hpp"
+#include "boyle/cvxopm/solvers/osqp_solver.hpp"
+#include "boyle/kinetics/trajectory2.hpp"
+
+namespace boyle::kinetics {
+
+struct [[nodiscard]] BicycleMpcSolution final {
+    std::vector<double> ts;
+    std::vector<double> xs;
+    std::vector<double> ys;
+    std::vector<double> headings;
+    std::vector<double> velocities;
+    std::vector<double> steerings;
+    std::vector<double> accels;
+    std::vector<double> prim_vars;
+    std::vector<double> dual_vars;
+};
+
+/**
+ * @brief Linear time-varying MPC of a kinematic bicycle (rear axle reference point) tracking a
+ * Trajectory2d. The state [x, y, heading, velocity] and the input [steering, accel] of every stage
+ * are interleaved in the variable vector, and the dynamics are linearized around the reference
+ * sampled at the stage times. The sparsity pattern of the QP is fixed at construction so that every
+ * control cycle only updates coefficients and bounds in place.
+ */
+class [[nodiscard]] BicycleMpcModel final {
+  public:
+    BicycleMpcModel(const BicycleMpcModel& other) noexcept = delete;
+    auto operator=(const BicycleMpcModel& other) noexcept -> BicycleMpcModel& = delete;
+    BicycleMpcModel(BicycleMpcModel&& other) noexcept = delete;
+    auto operator=(BicycleMpcModel&& other) noexcept -> BicycleMpcModel& = delete;
+    ~BicycleMpcModel() noexcept = default;
+
+    explicit BicycleMpcModel(
+        std::size_t num_steps, double dt, double wheelbase,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) noexcept(!BOYLE_CHECK_PARAMS);
+    explicit BicycleMpcModel(
+        std::size_t num_steps, double dt, double wheelbase,
+        const ::boyle::cvxopm::Settings<double, int>& settings,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) noexcept(!BOYLE_CHECK_PARAMS);
+    auto num_steps() const noexcept -> std::size_t;
+    auto qp_problem() const noexcept -> const ::boyle::cvxopm::QpProblem<double, int>&;
+    auto settings() const noexcept -> const ::boyle::cvxopm::Settings<double, int>&;
+    auto setReference(const Trajectory2d& reference, double t0) noexcept -> void;
+    auto setInitialState(
+        double x, double y, double heading, double velocity,
+        double steering = std::numeric_limits<double>::quiet_NaN()
+    ) noexcept -> void;
+    auto setSteeringRange(double lower_bound, double upper_bound) noexcept -> void;
+    auto setSteeringRateRange(double lower_bound, double upper_bound) noexcept -> void;
+    auto setAccelRange(double lower_bound, double upper_bound) noexcept -> void;
+    auto setVelocityRange(double lower_bound, double upper_bound) noexcept -> void;
+    auto setTrackingCost(
+        double lateral_weight, double longitudinal_weight, double heading_weight,
+        double velocity_weight
+    ) noexcept -> void;
+    auto setInputCost(double steering_weight, double accel_weight) noexcept -> void;
+    auto setInputRateCost(double steering_rate_weight, double jerk_weight) noexcept -> void;
+    auto setTerminalCostFactor(double factor) noexcept -> void;
+    auto setWarmStart(const BicycleMpcSolution& previous, std::size_t shift_steps = 1) noexcept
+        -> void;
+    auto solve() const -> std::pair<BicycleMpcSolution, ::boyle::cvxopm::Info<double, int>>;
+    auto clear() noexcept -> void;
+
+  private:
+    static constexpr int kNumStates{4};
+    static constexpr int kNumInputs{2};
+    static constexpr int kStageVars{kNumStates + kNumInputs};
+    static constexpr int kStageCons{8};
+
+    auto setStructure() noexcept -> void;
+    auto updateInitialState() noexcept -> void;
+    auto updateDynamics() noexcept -> void;
+    auto updateCosts() noexcept -> void;
+    auto updateSteeringRateBounds() noexcept -> void;
+    auto xIndex(int k) const noexcept -> int;
+    auto yIndex(int k) const noexcept -> int;
+    auto headingIndex(int k) const noexcept -> int;
+    auto velocityIndex(int k) const noexcept -> int;
+    auto steeringIndex(int k) const noexcept -> int;
+    auto accelIndex(int k) const noexcept -> int;
+    auto dynamicsRow(int k) const noexcept -> int;
+    auto steeringRow(int k) const noexcept -> int;
+    auto accelRow(int k) const noexcept -> int;
+    auto steeringRateRow(int k) const noexcept -> int;
+    auto velocityRow(int k) const noexcept -> int;
+    int m_num_steps{0};
+    double m_dt{0.0};
+    double m_wheelbase{0.0};
+    ::boyle::cvxopm::QpProblem<double, int> m_qp_problem{};
+    ::boyle::cvxopm::Settings<double, int> m_settings{};
+    std::vector<TrajectoryState2d> m_ref_states{};
+    std::vector<double> m_ref_headings{};
+    std::vector<double> m_ref_steerings{};
+    std::array<double, 4> m_initial_state{};
+    double m_initial_steering{std::numeric_limits<double>::quiet_NaN()};
+    std::array<double, 2> m_steering_rate_range{
+        std::numeric_limits<double>::lowest(), std::numeric_limits<double>::max()
+    };
+    double m_lateral_weight{1.0};
+    double m_longitudinal_weight{1.0};
+    double m_heading_weight{1.0};
+    double m_velocity_weight{1.0};
+    double m_steering_weight{0.1};
+    double m_accel_weight{0.1};
+    double m_steering_rate_weight{1.0};
+    double m_jerk_weight{0.1};
+    double m_terminal_factor{1.0};
+    std::vector<double> m_prim_vars_0{};
+    std::vector<double> m_dual_vars_0{};
+};
+
+} // namespace boyle::kinetics
+
+namespace boost::serialization {
+
+[[using gnu: always_inline]]
+inline auto serialize(
+    auto& archive, ::boyle::kinetics::BicycleMpcSolution& obj,
+    [[maybe_unused]] const unsigned int version
+) noexcept -> void {
+    archive & obj.ts;
+    archive & obj.xs;
+    archive & obj.ys;
+    archive & obj.headings;
+    archive & obj.velocities;
+    archive & obj.steerings;
+    archive & obj.accels;
+    archive & obj.prim_vars;
+    archive & obj.dual_vars;
+    return;
+}
+
+} // namespace boost::serialization
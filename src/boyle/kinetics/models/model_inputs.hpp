@@ -0,0 +1,211 @@
+/**
+ * @file model_inputs.hpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2025-02-27
+ *
+ * @copyright Copyright (c) 2025 Boyle Development Team.
+ *            All rights reserved.
+ *
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "boost/serialization/array.hpp"
+#include "boost/serialization/vector.hpp"
+
+#include "boyle/cvxopm/settings.hpp"
+#include "boyle/kinetics/border2.hpp"
+#include "boyle/kinetics/fence1.hpp"
+#include "boyle/math/vec2.hpp"
+
+namespace boyle::kinetics {
+
+enum class ModelCallKind : std::uint8_t {
+    HARD_BORDERS = 0,
+    SOFT_BORDERS = 1,
+    HARD_FENCES = 2,
+    SOFT_FENCES = 3,
+    DDX_RANGE = 4,
+    DDY_RANGE = 5,
+    D4X_RANGE = 6,
+    D4Y_RANGE = 7,
+    VELOCITY_RANGE = 8,
+    ACCEL_RANGE = 9,
+    INITIAL_STATE = 10,
+    FINAL_STATE = 11,
+    OFFSET_COST = 12,
+    CURVATURE_COST = 13,
+    DCURVATURE_COST = 14,
+    VELOCITY_COST = 15,
+    ACCEL_COST = 16,
+    JERK_COST = 17,
+    SNAP_COST = 18,
+    SOLVE = 19,
+    CLEAR = 20
+};
+
+[[using gnu: const, always_inline]]
+constexpr auto modelCallName(ModelCallKind kind) noexcept -> std::string_view {
+    switch (kind) {
+    case ModelCallKind::HARD_BORDERS:
+        return "setHardBorders";
+    case ModelCallKind::SOFT_BORDERS:
+        return "setSoftBorders";
+    case ModelCallKind::HARD_FENCES:
+        return "setHardFences";
+    case ModelCallKind::SOFT_FENCES:
+        return "setSoftFences";
+    case ModelCallKind::DDX_RANGE:
+        return "setDdxRange";
+    case ModelCallKind::DDY_RANGE:
+        return "setDdyRange";
+    case ModelCallKind::D4X_RANGE:
+        return "setD4xRange";
+    case ModelCallKind::D4Y_RANGE:
+        return "setD4yRange";
+    case ModelCallKind::VELOCITY_RANGE:
+        return "setVelocityRange";
+    case ModelCallKind::ACCEL_RANGE:
+        return "setAccelRange";
+    case ModelCallKind::INITIAL_STATE:
+        return "setInitialState";
+    case ModelCallKind::FINAL_STATE:
+        return "setFinalState";
+    case ModelCallKind::OFFSET_COST:
+        return "setOffsetCost";
+    case ModelCallKind::CURVATURE_COST:
+        return "setCurvatureCost";
+    case ModelCallKind::DCURVATURE_COST:
+        return "setDCurvatureCost";
+    case ModelCallKind::VELOCITY_COST:
+        return "setVelocityCost";
+    case ModelCallKind::ACCEL_COST:
+        return "setAccelCost";
+    case ModelCallKind::JERK_COST:
+        return "setJerkCost";
+    case ModelCallKind::SNAP_COST:
+        return "setSnapCost";
+    case ModelCallKind::SOLVE:
+        return "solve";
+    case ModelCallKind::CLEAR:
+        return "clear";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief One setter call on a model. Scalar arguments are stored in order, Vec2 arguments as
+ * consecutive x and y; border and fence calls keep the index of their payload in args[0].
+ */
+struct [[nodiscard]] ModelCall final {
+    ModelCallKind kind{ModelCallKind::SOLVE};
+    std::array<double, 8> args{};
+};
+
+/**
+ * @brief Everything needed to rebuild a RouteLineQuinticOffsetModel and replay one cycle. The
+ * setters of the model accumulate terms, so the calls are kept in the order they were made.
+ */
+struct [[nodiscard]] RouteLineQuinticOffsetInputs final {
+    static constexpr std::string_view kModelName{"RouteLineQuinticOffsetModel"};
+    std::vector<::boyle::math::Vec2d> sketch_points{};
+    std::vector<double> sample_ss{};
+    ::boyle::cvxopm::Settings<double, int> settings{};
+    std::vector<ModelCall> calls{};
+    std::vector<std::vector<HardBorder2d>> hard_borders{};
+    std::vector<std::vector<SoftBorder2d>> soft_borders{};
+
+    [[using gnu: always_inline]]
+    auto clear() noexcept -> void {
+        sketch_points.clear();
+        sample_ss.clear();
+        settings = {};
+        calls.clear();
+        hard_borders.clear();
+        soft_borders.clear();
+        return;
+    }
+
+    [[using gnu: always_inline]]
+    auto record(ModelCallKind kind, const std::array<double, 8>& args = {}) -> void {
+        calls.push_back(ModelCall{.kind = kind, .args = args});
+        return;
+    }
+};
+
+/**
+ * @brief Everything needed to rebuild a RouteLineQuinticAccModel and replay one cycle.
+ */
+struct [[nodiscard]] RouteLineQuinticAccInputs final {
+    static constexpr std::string_view kModelName{"RouteLineQuinticAccModel"};
+    std::vector<double> sample_ts{};
+    ::boyle::cvxopm::Settings<double, int> settings{};
+    std::vector<ModelCall> calls{};
+    std::vector<std::vector<HardFence1d>> hard_fences{};
+    std::vector<std::vector<SoftFence1d>> soft_fences{};
+
+    [[using gnu: always_inline]]
+    auto clear() noexcept -> void {
+        sample_ts.clear();
+        settings = {};
+        calls.clear();
+        hard_fences.clear();
+        soft_fences.clear();
+        return;
+    }
+
+    [[using gnu: always_inline]]
+    auto record(ModelCallKind kind, const std::array<double, 8>& args = {}) -> void {
+        calls.push_back(ModelCall{.kind = kind, .args = args});
+        return;
+    }
+};
+
+} // namespace boyle::kinetics
+
+namespace boost::serialization {
+
+[[using gnu: always_inline]]
+inline auto serialize(
+    auto& archive, ::boyle::kinetics::ModelCall& obj, [[maybe_unused]] const unsigned int version
+) -> void {
+    archive & obj.kind;
+    archive & obj.args;
+    return;
+}
+
+[[using gnu: always_inline]]
+inline auto serialize(
+    auto& archive, ::boyle::kinetics::RouteLineQuinticOffsetInputs& obj,
+    [[maybe_unused]] const unsigned int version
+) -> void {
+    archive & obj.sketch_points;
+    archive & obj.sample_ss;
+    archive & obj.settings;
+    archive & obj.calls;
+    archive & obj.hard_borders;
+    archive & obj.soft_borders;
+    return;
+}
+
+[[using gnu: always_inline]]
+inline auto serialize(
+    auto& archive, ::boyle::kinetics::RouteLineQuinticAccInputs& obj,
+    [[maybe_unused]] const unsigned int version
+) -> void {
+    archive & obj.sample_ts;
+    archive & obj.settings;
+    archive & obj.calls;
+    archive & obj.hard_fences;
+    archive & obj.soft_fences;
+    return;
+}
+
+} // namespace boost::serialization
@@ -0,0 +1,210 @@
+/**
+ * @file model_recorder.hpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2025-02-27
+ *
+ * @copyright Copyright (c) 2025 Boyle Development Team.
+ *            All rights reserved.
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ios>
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "boost/archive/binary_iarchive.hpp"
+#include "boost/archive/binary_oarchive.hpp"
+#include "boost/serialization/string.hpp"
+#include "boost/serialization/vector.hpp"
+#include "fmt/format.h"
+
+#include "boyle/kinetics/models/model_inputs.hpp"
+
+namespace boyle::kinetics {
+
+template <typename Inputs>
+struct [[nodiscard]] RecordedCycle final {
+    std::uint64_t sequence{0};
+    std::int64_t timestamp_ns{0};
+    Inputs inputs{};
+};
+
+/**
+ * @brief Keeps the inputs of the last N planning cycles in preallocated slots so that a cycle
+ * which misses its deadline can be dumped together with the cycles leading up to it. Slots are
+ * reused, so the flat vectors of the inputs (sample points, call list) keep their capacity from
+ * cycle to cycle; every border or fence set a cycle records is still copied into a fresh vector.
+ * Not thread-safe: keep one recorder per planner thread and dump from that thread.
+ */
+template <typename Inputs>
+class [[nodiscard]] ModelRecorder final {
+  public:
+    using inputs_type = Inputs;
+    using cycle_type = RecordedCycle<Inputs>;
+
+    static constexpr std::size_t kDefaultCapacity{64};
+
+    [[using gnu: always_inline]]
+    ModelRecorder()
+        : ModelRecorder(kDefaultCapacity) {}
+
+    [[using gnu: always_inline]]
+    explicit ModelRecorder(std::size_t capacity) noexcept(!BOYLE_CHECK_PARAMS)
+        : m_slots(capacity) {
+#if BOYLE_CHECK_PARAMS == 1
+        if (capacity == 0) [[unlikely]] {
+            throw std::invalid_argument(fmt::format(
+                "Invalid argument detected! The recorder must hold at least one cycle: "
+                "capacity = {0:d}.",
+                capacity
+            ));
+        }
+#endif
+    }
+
+    /**
+     * @brief Hands out the slot for a new cycle, overwriting the oldest one once the buffer is
+     * full. Pass the result to the model's recordInputs() right after constructing it.
+     */
+    [[using gnu: always_inline]]
+    auto beginCycle() noexcept -> Inputs& {
+        cycle_type& slot{m_slots[m_next]};
+        slot.sequence = m_sequence++;
+        slot.timestamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                std::chrono::system_clock::now().time_since_epoch()
+        )
+                                .count();
+        slot.inputs.clear();
+        m_next = (m_next + 1) % m_slots.size();
+        m_size = std::min(m_size + 1, m_slots.size());
+        return slot.inputs;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto size() const noexcept -> std::size_t {
+        return m_size;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto capacity() const noexcept -> std::size_t {
+        return m_slots.size();
+    }
+
+    /**
+     * @brief Returns the i-th recorded cycle, oldest first.
+     */
+    [[using gnu: pure, always_inline]]
+    auto operator[](std::size_t i) const noexcept -> const cycle_type& {
+        return m_slots[(m_next + m_slots.size() - m_size + i) % m_slots.size()];
+    }
+
+    [[using gnu: always_inline]]
+    auto clear() noexcept -> void {
+        m_size = 0;
+        return;
+    }
+
+    /**
+     * @brief Writes the recorded cycles, oldest first, as a Boost binary archive tagged with the
+     * model name. Call it on the trigger, e.g. when a cycle overruns its budget.
+     */
+    auto dump(std::ostream& os) const -> void {
+        boost::archive::binary_oarchive oa{os};
+        std::string model_name{Inputs::kModelName};
+        std::uint64_t num_cycles{m_size};
+        oa << model_name;
+        oa << num_cycles;
+        for (std::size_t i{0}; i < m_size; ++i) {
+            const cycle_type& cycle{(*this)[i]};
+            oa << cycle.sequence;
+            oa << cycle.timestamp_ns;
+            oa << cycle.inputs;
+        }
+        return;
+    }
+
+    static auto load(std::istream& is) -> std::vector<cycle_type> {
+        boost::archive::binary_iarchive ia{is};
+        std::string model_name;
+        std::uint64_t num_cycles{0};
+        ia >> model_name;
+        if (model_name != Inputs::kModelName) {
+            throw std::runtime_error(fmt::format(
+                "Recording holds {0:s} inputs while {1:s} inputs are expected.", model_name,
+                Inputs::kModelName
+            ));
+        }
+        ia >> num_cycles;
+        std::vector<cycle_type> cycles;
+        if (const std::optional<std::uint64_t> remaining{remainingBytes(is)}) {
+            if (num_cycles > *remaining / kMinCycleBytes) [[unlikely]] {
+                throw std::runtime_error(fmt::format(
+                    "Corrupted recording detected! {0:d} cycles can not fit in the remaining "
+                    "{1:d} bytes.",
+                    num_cycles, *remaining
+                ));
+            }
+            cycles.reserve(num_cycles);
+        }
+        for (std::uint64_t i{0}; i < num_cycles; ++i) {
+            cycle_type& cycle{cycles.emplace_back()};
+            ia >> cycle.sequence;
+            ia >> cycle.timestamp_ns;
+            ia >> cycle.inputs;
+        }
+        return cycles;
+    }
+
+    /**
+     * @brief Reads only the model name a recording was made for.
+     */
+    static auto peekModelName(std::istream& is) -> std::string {
+        boost::archive::binary_iarchive ia{is};
+        std::string model_name;
+        ia >> model_name;
+        return model_name;
+    }
+
+  private:
+    // Sequence number and timestamp; the inputs add more, so this bounds the cycles a payload can
+    // hold from above.
+    static constexpr std::size_t kMinCycleBytes{sizeof(std::uint64_t) + sizeof(std::int64_t)};
+
+    /**
+     * @brief Bytes left in a seekable stream, std::nullopt when the stream can not tell.
+     */
+    static auto remainingBytes(std::istream& is) -> std::optional<std::uint64_t> {
+        const std::istream::pos_type current{is.tellg()};
+        if (current == std::istream::pos_type(-1)) {
+            return std::nullopt;
+        }
+        is.seekg(0, std::ios::end);
+        const std::istream::pos_type end{is.tellg()};
+        is.seekg(current);
+        if (end == std::istream::pos_type(-1) || end < current) {
+            is.clear();
+            is.seekg(current);
+            return std::nullopt;
+        }
+        return static_cast<std::uint64_t>(end - current);
+    }
+
+    std::vector<cycle_type> m_slots;
+    std::size_t m_next{0};
+    std::size_t m_size{0};
+    std::uint64_t m_sequence{0};
+};
+
+} // namespace boyle::kinetics
@@ -0,0 +1,217 @@
+/**
+ * @file model_replay.cpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2025-02-27
+ *
+ * @copyright Copyright (c) 2025 Boyle Development Team.
+ *            All rights reserved.
+ *
+ */
+
+#include "boyle/kinetics/models/model_replay.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include "fmt/format.h"
+
+#include "boyle/kinetics/models/route_line_quintic_acc_model.hpp"
+#include "boyle/kinetics/models/route_line_quintic_offset_model.hpp"
+
+namespace boyle::kinetics {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+[[using gnu: always_inline]]
+inline auto elapsedNs(Clock::time_point start) noexcept -> std::int64_t {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+}
+
+template <typename Payload>
+[[using gnu: always_inline]]
+inline auto payloadAt(const std::vector<Payload>& payloads, double index) -> const Payload& {
+    const auto i{static_cast<std::size_t>(index)};
+    if (index < 0.0 || i >= payloads.size()) [[unlikely]] {
+        throw std::runtime_error(fmt::format(
+            "Corrupted recording detected! payload index {0:.0f} is out of range [0, {1:d}).",
+            index, payloads.size()
+        ));
+    }
+    return payloads[i];
+}
+
+[[noreturn]]
+inline auto throwForeignCall(ModelCallKind kind, std::string_view model_name) -> void {
+    throw std::runtime_error(fmt::format(
+        "Corrupted recording detected! {0:s} is not a call of {1:s}.", modelCallName(kind),
+        model_name
+    ));
+}
+
+/**
+ * @brief A recording whose model was cleared last has nothing left to solve.
+ */
+[[using gnu: pure, always_inline]]
+inline auto endsWithClear(const std::vector<ModelCall>& calls) noexcept -> bool {
+    return !calls.empty() && calls.back().kind == ModelCallKind::CLEAR;
+}
+
+} // namespace
+
+auto replay(const RouteLineQuinticOffsetInputs& inputs) -> ReplayReport {
+    ReplayReport report;
+    report.stages.reserve(inputs.calls.size() + 1);
+    Clock::time_point start{Clock::now()};
+    RouteLineQuinticOffsetModel model{inputs.sketch_points, inputs.sample_ss, inputs.settings};
+    report.build_ns = elapsedNs(start);
+
+    const auto solve = [&model, &report]() -> void {
+        auto [path, info] = model.solve();
+        report.infos.push_back(info);
+        report.solution.clear();
+        report.solution.reserve(path.anchorPoints().size() * 2);
+        for (const ::boyle::math::Vec2d& point : path.anchorPoints()) {
+            report.solution.push_back(point.x);
+            report.solution.push_back(point.y);
+        }
+        return;
+    };
+
+    for (const ModelCall& call : inputs.calls) {
+        const std::array<double, 8>& a{call.args};
+        start = Clock::now();
+        switch (call.kind) {
+        case ModelCallKind::HARD_BORDERS:
+            model.setHardBorders(payloadAt(inputs.hard_borders, a[0]));
+            break;
+        case ModelCallKind::SOFT_BORDERS:
+            model.setSoftBorders(payloadAt(inputs.soft_borders, a[0]));
+            break;
+        case ModelCallKind::DDX_RANGE:
+            model.setDdxRange(a[0], a[1]);
+            break;
+        case ModelCallKind::DDY_RANGE:
+            model.setDdyRange(a[0], a[1]);
+            break;
+        case ModelCallKind::D4X_RANGE:
+            model.setD4xRange(a[0], a[1]);
+            break;
+        case ModelCallKind::D4Y_RANGE:
+            model.setD4yRange(a[0], a[1]);
+            break;
+        case ModelCallKind::INITIAL_STATE:
+            model.setInitialState({a[0], a[1]}, {a[2], a[3]}, {a[4], a[5]}, {a[6], a[7]});
+            break;
+        case ModelCallKind::FINAL_STATE:
+            model.setFinalState({a[0], a[1]}, {a[2], a[3]}, {a[4], a[5]}, {a[6], a[7]});
+            break;
+        case ModelCallKind::OFFSET_COST:
+            model.setOffsetCost(a[0]);
+            break;
+        case ModelCallKind::CURVATURE_COST:
+            model.setCurvatureCost(a[0]);
+            break;
+        case ModelCallKind::DCURVATURE_COST:
+            model.setDCurvatureCost(a[0]);
+            break;
+        case ModelCallKind::SOLVE:
+            solve();
+            break;
+        case ModelCallKind::CLEAR:
+            model.clear();
+            break;
+        default:
+            throwForeignCall(call.kind, RouteLineQuinticOffsetInputs::kModelName);
+        }
+        report.stages.push_back(ReplayStage{.kind = call.kind, .elapsed_ns = elapsedNs(start)});
+    }
+
+    if (report.infos.empty() && !endsWithClear(inputs.calls)) {
+        start = Clock::now();
+        solve();
+        report.stages.push_back(
+            ReplayStage{.kind = ModelCallKind::SOLVE, .elapsed_ns = elapsedNs(start)}
+        );
+    }
+    return report;
+}
+
+auto replay(const RouteLineQuinticAccInputs& inputs) -> ReplayReport {
+    ReplayReport report;
+    report.stages.reserve(inputs.calls.size() + 1);
+    Clock::time_point start{Clock::now()};
+    RouteLineQuinticAccModel model{inputs.sample_ts, inputs.settings};
+    report.build_ns = elapsedNs(start);
+
+    const auto solve = [&model, &report]() -> void {
+        auto [motion, info] = model.solve();
+        report.infos.push_back(info);
+        report.solution.assign(motion.ss().cbegin(), motion.ss().cend());
+        return;
+    };
+
+    for (const ModelCall& call : inputs.calls) {
+        const std::array<double, 8>& a{call.args};
+        start = Clock::now();
+        switch (call.kind) {
+        case ModelCallKind::HARD_FENCES:
+            model.setHardFences(payloadAt(inputs.hard_fences, a[0]));
+            break;
+        case ModelCallKind::SOFT_FENCES:
+            model.setSoftFences(payloadAt(inputs.soft_fences, a[0]));
+            break;
+        case ModelCallKind::VELOCITY_RANGE:
+            model.setVelocityRange(a[0], a[1]);
+            break;
+        case ModelCallKind::ACCEL_RANGE:
+            model.setAccelRange(a[0], a[1]);
+            break;
+        case ModelCallKind::INITIAL_STATE:
+            model.setInitialState(a[0], a[1], a[2], a[3]);
+            break;
+        case ModelCallKind::FINAL_STATE:
+            model.setFinalState(a[0], a[1], a[2], a[3]);
+            break;
+        case ModelCallKind::VELOCITY_COST:
+            model.setVelocityCost(a[0], a[1]);
+            break;
+        case ModelCallKind::ACCEL_COST:
+            model.setAccelCost(a[0]);
+            break;
+        case ModelCallKind::JERK_COST:
+            model.setJerkCost(a[0]);
+            break;
+        case ModelCallKind::SNAP_COST:
+            model.setSnapCost(a[0]);
+            break;
+        case ModelCallKind::SOLVE:
+            solve();
+            break;
+        case ModelCallKind::CLEAR:
+            model.clear();
+            break;
+        default:
+            throwForeignCall(call.kind, RouteLineQuinticAccInputs::kModelName);
+        }
+        report.stages.push_back(ReplayStage{.kind = call.kind, .elapsed_ns = elapsedNs(start)});
+    }
+
+    if (report.infos.empty() && !endsWithClear(inputs.calls)) {
+        start = Clock::now();
+        solve();
+        report.stages.push_back(
+            ReplayStage{.kind = ModelCallKind::SOLVE, .elapsed_ns = elapsedNs(start)}
+        );
+    }
+    return report;
+}
+
+} // namespace boyle::kinetics
@@ -0,0 +1,78 @@
+/**
+ * @file model_replay.hpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2025-02-27
+ *
+ * @copyright Copyright (c) 2025 Boyle Development Team.
+ *            All rights reserved.
+ *
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "boost/serialization/vector.hpp"
+
+#include "boyle/cvxopm/info.hpp"
+#include "boyle/kinetics/models/model_inputs.hpp"
+
+namespace boyle::kinetics {
+
+struct [[nodiscard]] ReplayStage final {
+    ModelCallKind kind{ModelCallKind::SOLVE};
+    std::int64_t elapsed_ns{0};
+};
+
+/**
+ * @brief Outcome of replaying one recorded cycle: wall time of the model construction and of
+ * every call in recorded order, solver info per solve, and the decision variables of the last
+ * solve flattened (x, y pairs for paths, s for motions) so two builds can be compared.
+ */
+struct [[nodiscard]] ReplayReport final {
+    std::int64_t build_ns{0};
+    std::vector<ReplayStage> stages{};
+    std::vector<::boyle::cvxopm::Info<double, int>> infos{};
+    std::vector<double> solution{};
+};
+
+/**
+ * @brief Rebuilds the model from the recorded inputs and issues the recorded calls in order,
+ * clear() included. If the recording holds no solve call and does not end with clear(), one is
+ * appended so that every cycle produces a result.
+ *
+ * @throws std::runtime_error if a call does not belong to the model or refers to a missing
+ * border or fence payload.
+ */
+auto replay(const RouteLineQuinticOffsetInputs& inputs) -> ReplayReport;
+auto replay(const RouteLineQuinticAccInputs& inputs) -> ReplayReport;
+
+} // namespace boyle::kinetics
+
+namespace boost::serialization {
+
+[[using gnu: always_inline]]
+inline auto serialize(
+    auto& archive, ::boyle::kinetics::ReplayStage& obj, [[maybe_unused]] const unsigned int version
+) noexcept -> void {
+    archive & obj.kind;
+    archive & obj.elapsed_ns;
+    return;
+}
+
+[[using gnu: always_inline]]
+inline auto serialize(
+    auto& archive, ::boyle::kinetics::ReplayReport& obj,
+    [[maybe_unused]] const unsigned int version
+) noexcept -> void {
+    archive & obj.build_ns;
+    archive & obj.stages;
+    archive & obj.infos;
+    archive & obj.solution;
+    return;
+}
+
+} // namespace boost::serialization
@@ -12,6 +12,7 @@
 
 #include "boyle/kinetics/models/route_line_cubic_acc_model.hpp"
 
+#include <chrono>
 #include <limits>
 #include <ranges>
 #include <stdexcept>
@@ -21,6 +22,7 @@
 #include "fmt/format.h"
 
 #include "boyle/common/utils/logging.hpp"
+#include "boyle/common/utils/tracing.hpp"
 #include "boyle/math/functions/piecewise_linear_function1.hpp"
 
 namespace {
@@ -39,8 +41,10 @@ constexpr auto prorationCoeffs(double ratio, double scale) noexcept -> std::arra
 
 namespace boyle::kinetics {
 
-RouteLineCubicAccModel::RouteLineCubicAccModel(std::vector<double> sample_ts
-) noexcept(!BOYLE_CHECK_PARAMS) {
+RouteLineCubicAccModel::RouteLineCubicAccModel(
+    std::vector<double> sample_ts, std::pmr::memory_resource* resource
+) noexcept(!BOYLE_CHECK_PARAMS)
+    : m_qp_problem{resource} {
 #if BOYLE_CHECK_PARAMS == 1
     if (sample_ts.size() < 2) [[unlikely]] {
         throw std::invalid_argument(fmt::format(
@@ -72,9 +76,10 @@ RouteLineCubicAccModel::RouteLineCubicAccModel(std::vector<double> sample_ts
 }
 
 RouteLineCubicAccModel::RouteLineCubicAccModel(
-    std::vector<double> sample_ts, const ::boyle::cvxopm::Settings<double, int>& settings
+    std::vector<double> sample_ts, const ::boyle::cvxopm::Settings<double, int>& settings,
+    std::pmr::memory_resource* resource
 ) noexcept(!BOYLE_CHECK_PARAMS)
-    : RouteLineCubicAccModel{std::move(sample_ts)} {
+    : RouteLineCubicAccModel{std::move(sample_ts), resource} {
     m_settings = settings;
 }
 
@@ -93,6 +98,7 @@ auto RouteLineCubicAccModel::settings() const noexcept
 }
 
 auto RouteLineCubicAccModel::setIntegrationRelation() noexcept -> void {
+    BOYLE_TRACE_SCOPE("RouteLineCubicAccModel::setIntegrationRelation");
     for (int i{1}; i < m_num_samples - 1; ++i) {
         const boost::unordered_flat_map<int, double> constrain_vec{
             {sIndex(i - 1), m_reciprocal_h2s[i - 1] * 3.0},
@@ -111,6 +117,7 @@ auto RouteLineCubicAccModel::setIntegrationRelation() noexcept -> void {
 
 auto RouteLineCubicAccModel::setHardFences(const std::vector<HardFence1d>& hard_fences
 ) noexcept -> void {
+    BOYLE_TRACE_SCOPE("RouteLineCubicAccModel::setHardFences");
     std::vector<double> lower_bound(m_num_samples, std::numeric_limits<double>::lowest());
     std::vector<double> upper_bound(m_num_samples, std::numeric_limits<double>::max());
     for (const HardFence1d& hard_fence : hard_fences) {
@@ -125,7 +132,8 @@ auto RouteLineCubicAccModel::setHardFences(const std::vector<HardFence1d>& hard_
                          ) -
                          m_sample_ts.cbegin();
         if (istart == m_num_samples) {
-            BOYLE_LOG_WARN(
+            BOYLE_LOG_WARN_THROTTLED(
+                std::chrono::seconds{1},
                 "Invalid argument issue detected! The front() of hard_fence.bound_ts should be "
                 "less than m_sample_ts.back(): hard_fence.bound_ts.front() = {0:f} while "
                 "m_sample_ts.back() = {1:f}.",
@@ -134,7 +142,8 @@ auto RouteLineCubicAccModel::setHardFences(const std::vector<HardFence1d>& hard_
             break;
         }
         if (iend == 0) {
-            BOYLE_LOG_WARN(
+            BOYLE_LOG_WARN_THROTTLED(
+                std::chrono::seconds{1},
                 "Invalid argument issue detected! The back() of hard_fence.bound_ts should be "
                 "larger than m_sample_ts.front(): hard_fence.bound_ts.back() = {0:f} while "
                 "m_sample_ts.front() = {1:f}.",
@@ -225,6 +234,7 @@ auto RouteLineCubicAccModel::setHardFences(const std::vector<HardFence1d>& hard_
 
 auto RouteLineCubicAccModel::setSoftFences(const std::vector<SoftFence1d>& soft_fences
 ) noexcept -> void {
+    BOYLE_TRACE_SCOPE("RouteLineCubicAccModel::setSoftFences");
     for (const SoftFence1d& soft_fence : soft_fences) {
         const int istart = ::boyle::math::nearestUpperElement(
                                std::ranges::subrange{m_sample_ts.cbegin(), m_sample_ts.cend()},
@@ -237,7 +247,8 @@ auto RouteLineCubicAccModel::setSoftFences(const std::vector<SoftFence1d>& soft_
                          ) -
                          m_sample_ts.cbegin();
         if (istart == m_num_samples) {
-            BOYLE_LOG_WARN(
+            BOYLE_LOG_WARN_THROTTLED(
+                std::chrono::seconds{1},
                 "Invalid argument issue detected! The front() of hard_fence.bound_ts should be "
                 "less than m_sample_ts.back(): hard_fence.bound_ts.front() = {0:f} while "
                 "m_sample_ts.back() = {1:f}.",
@@ -246,7 +257,8 @@ auto RouteLineCubicAccModel::setSoftFences(const std::vector<SoftFence1d>& soft_
             break;
         }
         if (iend == 0) {
-            BOYLE_LOG_WARN(
+            BOYLE_LOG_WARN_THROTTLED(
+                std::chrono::seconds{1},
                 "Invalid argument issue detected! The back() of hard_fence.bound_ts should be "
                 "larger than m_sample_ts.front(): hard_fence.bound_ts.back() = {0:f} while "
                 "m_sample_ts.front() = {1:f}.",
@@ -420,6 +432,7 @@ auto RouteLineCubicAccModel::setSoftFences(const std::vector<SoftFence1d>& soft_
 
 auto RouteLineCubicAccModel::setVelocityRange(double lower_bound, double upper_bound) noexcept
     -> void {
+    BOYLE_TRACE_SCOPE("RouteLineCubicAccModel::setVelocityRange");
     for (int i{1}; i < m_num_samples - 1; ++i) {
         m_qp_problem.updateConstrainTerm(vIndex(i), {{vIndex(i), 1.0}}, lower_bound, upper_bound);
     }
@@ -428,6 +441,7 @@ auto RouteLineCubicAccModel::setVelocityRange(double lower_bound, double upper_b
 
 auto RouteLineCubicAccModel::setAccelRange(double lower_bound, double upper_bound) noexcept
     -> void {
+    BOYLE_TRACE_SCOPE("RouteLineCubicAccModel::setAccelRange");
     m_qp_problem.updateConstrainTerm(
         m_num_samples * 2,
         {{sIndex(0), -m_reciprocal_h2s[0] * 6.0},
@@ -458,6 +472,7 @@ auto RouteLineCubicAccModel::setAccelRange(double lower_bound, double upper_boun
 }
 
 auto RouteLineCubicAccModel::setInitialState(double s0, double v0, double a0) noexcept -> void {
+    BOYLE_TRACE_SCOPE("RouteLineCubicAccModel::setInitialState");
     if (!std::isnan(s0)) {
         m_qp_problem.updateConstrainTerm(
             sIndex(0), {{sIndex(0), 1.0}}, s0 - ::boyle::math::kEpsilon,
@@ -484,6 +499,7 @@ auto RouteLineCubicAccModel::setInitialState(double s0, double v0, double a0) no
 }
 
 auto RouteLineCubicAccModel::setFinalState(double sf, double vf, double af) noexcept -> void {
+    BOYLE_TRACE_SCOPE("RouteLineCubicAccModel::setFinalState");
     if (!std::isnan(sf)) {
         m_qp_problem.updateConstrainTerm(
             sIndex(m_num_samples - 1), {{sIndex(m_num_samples - 1), 1.0}},
@@ -512,6 +528,7 @@ auto RouteLineCubicAccModel::setFinalState(double sf, double vf, double af) noex
 auto RouteLineCubicAccModel::setVelocityCost(
     double target_velocity, double velocity_weight
 ) noexcept -> void {
+    BOYLE_TRACE_SCOPE("RouteLineCubicAccModel::setVelocityCost");
     constexpr std::array<double, 5> kFactors{
         6.0 / 5.0, 12.0 / 5.0, 1.0 / 5.0, 2.0 / 15.0, 1.0 / 15.0
     };
@@ -534,6 +551,7 @@ auto RouteLineCubicAccModel::setVelocityCost(
 }
 
 auto RouteLineCubicAccModel::setAccelCost(double accel_weight) noexcept -> void {
+    BOYLE_TRACE_SCOPE("RouteLineCubicAccModel::setAccelCost");
     for (int i{0}; i < m_num_samples - 1; ++i) {
         const double factor =
             accel_weight * m_reciprocal_h2s[i] * m_reciprocal_hs[i] / m_time_scale;
@@ -552,6 +570,7 @@ auto RouteLineCubicAccModel::setAccelCost(double accel_weight) noexcept -> void
 }
 
 auto RouteLineCubicAccModel::setJerkCost(double jerk_weight) noexcept -> void {
+    BOYLE_TRACE_SCOPE("RouteLineCubicAccModel::setJerkCost");
     for (int i{0}; i < m_num_samples - 1; ++i) {
         const double factor = jerk_weight * m_reciprocal_h2s[i] * m_reciprocal_h2s[i] *
                               m_reciprocal_hs[i] / m_time_scale;
@@ -571,34 +590,34 @@ auto RouteLineCubicAccModel::setJerkCost(double jerk_weight) noexcept -> void {
 
 auto RouteLineCubicAccModel::solve() const
     -> std::pair<Motion1d, ::boyle::cvxopm::Info<double, int>> {
+    BOYLE_TRACE_SCOPE("RouteLineCubicAccModel::solve");
     const ::boyle::cvxopm::OsqpSolver osqp_solver{m_settings};
     const auto [osqp_result, osqp_info] = osqp_solver.solve(m_qp_problem);
-    const double v0{osqp_result.prim_vars[vIndex(0)]};
-    const double vf{osqp_result.prim_vars[vIndex(m_num_samples - 1)]};
-    const double a0{
-        -(osqp_result.prim_vars[sIndex(0)] - osqp_result.prim_vars[sIndex(1)]) *
-            m_reciprocal_h2s[0] * 6.0 -
-        (osqp_result.prim_vars[vIndex(0)] * 4.0 + osqp_result.prim_vars[vIndex(1)] * 2.0) *
-            m_reciprocal_hs[0]
-    };
-    const double af = -(osqp_result.prim_vars[sIndex(m_num_samples - 1)] -
-                        osqp_result.prim_vars[sIndex(m_num_samples - 2)]) *
-                          m_reciprocal_h2s[m_num_samples - 2] * 6.0 +
-                      (osqp_result.prim_vars[vIndex(m_num_samples - 1)] * 4.0 +
-                       osqp_result.prim_vars[vIndex(m_num_samples - 2)] * 2.0) *
-                          m_reciprocal_hs[m_num_samples - 2];
-    const std::array<Motion1d::BoundaryMode, 2> b0{
-        Motion1d::BoundaryMode{1, v0}, Motion1d::BoundaryMode{2, a0}
-    };
-    const std::array<Motion1d::BoundaryMode, 2> bf{
-        Motion1d::BoundaryMode{1, vf}, Motion1d::BoundaryMode{2, af}
-    };
+    const std::vector<double>& prim_vars{osqp_result.prim_vars};
+    // The integration relation keeps the acceleration continuous, so the solution is a cubic
+    // spline, i.e. a quintic one with zero snap; only the accelerations have to be recovered.
     std::vector<double> anchor_ss{
-        osqp_result.prim_vars.cbegin(),
-        osqp_result.prim_vars.cbegin() + sIndex(m_num_samples - 1) + 1
+        prim_vars.cbegin() + sIndex(0), prim_vars.cbegin() + sIndex(m_num_samples - 1) + 1
     };
-
-    return std::make_pair(Motion1d{m_sample_ts, std::move(anchor_ss), b0, bf}, osqp_info);
+    std::vector<double> anchor_dds(m_num_samples, 0.0);
+    for (int i{0}; i < m_num_samples - 1; ++i) {
+        const double ds{(prim_vars[sIndex(i + 1)] - prim_vars[sIndex(i)]) * m_reciprocal_h2s[i]};
+        const double a_start{
+            ds * 6.0 - (prim_vars[vIndex(i)] * 4.0 + prim_vars[vIndex(i + 1)] * 2.0) *
+                           m_reciprocal_hs[i]
+        };
+        const double a_end{
+            -ds * 6.0 + (prim_vars[vIndex(i)] * 2.0 + prim_vars[vIndex(i + 1)] * 4.0) *
+                            m_reciprocal_hs[i]
+        };
+        anchor_dds[i] += i == 0 ? a_start : a_start * 0.5;
+        anchor_dds[i + 1] += i == m_num_samples - 2 ? a_end : a_end * 0.5;
+    }
+    std::vector<double> anchor_d4s(m_num_samples, 0.0);
+    return std::make_pair(
+        Motion1d{m_sample_ts, std::move(anchor_ss), std::move(anchor_dds), std::move(anchor_d4s)},
+        osqp_info
+    );
 }
 
 auto RouteLineCubicAccModel::clear() noexcept -> void {
@@ -13,6 +13,7 @@
 #pragma once
 
 #include <limits>
+#include <memory_resource>
 #include <vector>
 
 #include "boyle/cvxopm/info.hpp"
@@ -33,9 +34,13 @@ class [[nodiscard]] RouteLineCubicAccModel final {
     auto operator=(RouteLineCubicAccModel&& other) noexcept -> RouteLineCubicAccModel& = delete;
     ~RouteLineCubicAccModel() noexcept = default;
 
-    explicit RouteLineCubicAccModel(std::vector<double> sample_ts) noexcept(!BOYLE_CHECK_PARAMS);
     explicit RouteLineCubicAccModel(
-        std::vector<double> sample_ts, const ::boyle::cvxopm::Settings<double, int>& settings
+        std::vector<double> sample_ts,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) noexcept(!BOYLE_CHECK_PARAMS);
+    explicit RouteLineCubicAccModel(
+        std::vector<double> sample_ts, const ::boyle::cvxopm::Settings<double, int>& settings,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
     ) noexcept(!BOYLE_CHECK_PARAMS);
     auto num_samples() const noexcept -> std::size_t;
     auto qp_problem() const noexcept -> const ::boyle::cvxopm::QpProblem<double, int>&;
@@ -13,6 +13,7 @@
 #include "boyle/kinetics/models/route_line_cubic_offset_model.hpp"
 
 #include <array>
+#include <chrono>
 #include <limits>
 #include <ranges>
 #include <stdexcept>
@@ -22,6 +23,7 @@
 #include "fmt/format.h"
 
 #include "boyle/common/utils/logging.hpp"
+#include "boyle/common/utils/tracing.hpp"
 #include "boyle/math/cubic_interpolation.hpp"
 #include "boyle/math/functions/piecewise_linear_function1.hpp"
 #include "boyle/math/utils.hpp"
@@ -29,8 +31,10 @@
 namespace boyle::kinetics {
 
 RouteLineCubicOffsetModel::RouteLineCubicOffsetModel(
-    const std::vector<::boyle::math::Vec2d>& sketch_points, std::vector<double> sample_ss
-) noexcept(!BOYLE_CHECK_PARAMS) {
+    const std::vector<::boyle::math::Vec2d>& sketch_points, std::vector<double> sample_ss,
+    std::pmr::memory_resource* resource
+) noexcept(!BOYLE_CHECK_PARAMS)
+    : m_qp_problem{resource} {
 #if BOYLE_CHECK_PARAMS == 1
     if (sketch_points.size() < 2) [[unlikely]] {
         throw std::invalid_argument(fmt::format(
@@ -75,9 +79,9 @@ RouteLineCubicOffsetModel::RouteLineCubicOffsetModel(
 
 RouteLineCubicOffsetModel::RouteLineCubicOffsetModel(
     const std::vector<::boyle::math::Vec2d>& raw_sketch_points, std::vector<double> sample_ss,
-    const ::boyle::cvxopm::Settings<double, int>& settings
+    const ::boyle::cvxopm::Settings<double, int>& settings, std::pmr::memory_resource* resource
 ) noexcept(!BOYLE_CHECK_PARAMS)
-    : RouteLineCubicOffsetModel{raw_sketch_points, std::move(sample_ss)} {
+    : RouteLineCubicOffsetModel{raw_sketch_points, std::move(sample_ss), resource} {
     m_settings = settings;
 }
 
@@ -96,6 +100,7 @@ auto RouteLineCubicOffsetModel::settings() const noexcept
 }
 
 auto RouteLineCubicOffsetModel::setIntegrationRelation() noexcept -> void {
+    BOYLE_TRACE_SCOPE("RouteLineCubicOffsetModel::setIntegrationRelation");
     for (int i{1}; i < m_num_samples - 1; ++i) {
         boost::unordered_flat_map<int, double> constrain_vec{
             {xIndex(i - 1), -m_reciprocal_hs[i - 1] * 6.0},
@@ -125,6 +130,7 @@ auto RouteLineCubicOffsetModel::setIntegrationRelation() noexcept -> void {
 
 auto RouteLineCubicOffsetModel::setHardBorders(const std::vector<HardBorder2d>& hard_borders
 ) noexcept -> void {
+    BOYLE_TRACE_SCOPE("RouteLineCubicOffsetModel::setHardBorders");
     std::vector<double> x_lower_bound(m_num_samples, std::numeric_limits<double>::lowest());
     std::vector<double> x_upper_bound(m_num_samples, std::numeric_limits<double>::max());
     std::vector<double> y_lower_bound(m_num_samples, std::numeric_limits<double>::lowest());
@@ -143,14 +149,16 @@ auto RouteLineCubicOffsetModel::setHardBorders(const std::vector<HardBorder2d>&
             ) -
             m_sample_points.cbegin();
         if (istart == m_num_samples) {
-            BOYLE_LOG_WARN(
+            BOYLE_LOG_WARN_THROTTLED(
+                std::chrono::seconds{1},
                 "Invalid argument issue detected! This soft border is not in the same region as "
                 "the sketch points."
             );
             break;
         }
         if (iend == 0) {
-            BOYLE_LOG_WARN(
+            BOYLE_LOG_WARN_THROTTLED(
+                std::chrono::seconds{1},
                 "Invalid argument issue detected! This soft border is not in the same region as "
                 "the sketch points."
             );
@@ -292,6 +300,7 @@ auto RouteLineCubicOffsetModel::setHardBorders(const std::vector<HardBorder2d>&
 
 auto RouteLineCubicOffsetModel::setSoftBorders(const std::vector<SoftBorder2d>& soft_borders
 ) noexcept -> void {
+    BOYLE_TRACE_SCOPE("RouteLineCubicOffsetModel::setSoftBorders");
     for (const SoftBorder2d& soft_border : soft_borders) {
         const int istart =
             ::boyle::math::nearestUpperElement(
@@ -306,14 +315,16 @@ auto RouteLineCubicOffsetModel::setSoftBorders(const std::vector<SoftBorder2d>&
             ) -
             m_sample_points.cbegin();
         if (istart == m_num_samples) {
-            BOYLE_LOG_WARN(
+            BOYLE_LOG_WARN_THROTTLED(
+                std::chrono::seconds{1},
                 "Invalid argument issue detected! This soft border is not in the same region as "
                 "the sketch points."
             );
             break;
         }
         if (iend == 0) {
-            BOYLE_LOG_WARN(
+            BOYLE_LOG_WARN_THROTTLED(
+                std::chrono::seconds{1},
                 "Invalid argument issue detected! This soft border is not in the same region as "
                 "the sketch points."
             );
@@ -583,6 +594,7 @@ auto RouteLineCubicOffsetModel::setSoftBorders(const std::vector<SoftBorder2d>&
 }
 
 auto RouteLineCubicOffsetModel::setDdxRange(double ddx_min, double ddx_max) noexcept -> void {
+    BOYLE_TRACE_SCOPE("RouteLineCubicOffsetModel::setDdxRange");
     for (int i{1}; i < m_num_samples - 1; i++) {
         m_qp_problem.updateConstrainTerm(ddxIndex(i), {{ddxIndex(i), 1.0}}, ddx_min, ddx_max);
     }
@@ -590,6 +602,7 @@ auto RouteLineCubicOffsetModel::setDdxRange(double ddx_min, double ddx_max) noex
 }
 
 auto RouteLineCubicOffsetModel::setDdyRange(double ddy_min, double ddy_max) noexcept -> void {
+    BOYLE_TRACE_SCOPE("RouteLineCubicOffsetModel::setDdyRange");
     for (int i{1}; i < m_num_samples - 1; i++) {
         m_qp_problem.updateConstrainTerm(ddyIndex(i), {{ddyIndex(i), 1.0}}, ddy_min, ddy_max);
     }
@@ -599,6 +612,7 @@ auto RouteLineCubicOffsetModel::setDdyRange(double ddy_min, double ddy_max) noex
 auto RouteLineCubicOffsetModel::setInitialState(
     ::boyle::math::Vec2d r0, ::boyle::math::Vec2d t0, ::boyle::math::Vec2d n0
 ) noexcept -> void {
+    BOYLE_TRACE_SCOPE("RouteLineCubicOffsetModel::setInitialState");
     m_qp_problem.updateConstrainTerm(
         xIndex(0), {{xIndex(0), 1.0}}, r0.x - ::boyle::math::kEpsilon,
         r0.x + ::boyle::math::kEpsilon
@@ -646,6 +660,7 @@ auto RouteLineCubicOffsetModel::setInitialState(
 auto RouteLineCubicOffsetModel::setFinalState(
     ::boyle::math::Vec2d rf, ::boyle::math::Vec2d tf, ::boyle::math::Vec2d nf
 ) noexcept -> void {
+    BOYLE_TRACE_SCOPE("RouteLineCubicOffsetModel::setFinalState");
     m_qp_problem.updateConstrainTerm(
         xIndex(m_num_samples - 1), {{xIndex(m_num_samples - 1), 1.0}},
         rf.x - ::boyle::math::kEpsilon, rf.x + ::boyle::math::kEpsilon
@@ -691,6 +706,7 @@ auto RouteLineCubicOffsetModel::setFinalState(
 }
 
 auto RouteLineCubicOffsetModel::setOffsetCost(double offset_weight) noexcept -> void {
+    BOYLE_TRACE_SCOPE("RouteLineCubicOffsetModel::setOffsetCost");
     constexpr std::array<double, 5> kFactors{
         1.0 / 3.0, 2.0 / 45.0, 7.0 / 180.0, 2.0 / 945.0, 31.0 / 7560.0
     };
@@ -767,6 +783,7 @@ auto RouteLineCubicOffsetModel::setOffsetCost(double offset_weight) noexcept ->
 }
 
 auto RouteLineCubicOffsetModel::setCurvatureCost(double curvature_weight) noexcept -> void {
+    BOYLE_TRACE_SCOPE("RouteLineCubicOffsetModel::setCurvatureCost");
     for (int i{0}; i < m_num_samples - 1; ++i) {
         const double factor = curvature_weight * m_reciprocal_hs[i] * m_reciprocal_hs[i] *
                               m_reciprocal_hs[i] / m_length_scale;
@@ -782,6 +799,7 @@ auto RouteLineCubicOffsetModel::setCurvatureCost(double curvature_weight) noexce
 }
 
 auto RouteLineCubicOffsetModel::setDCurvatureCost(double dcurvature_weight) noexcept -> void {
+    BOYLE_TRACE_SCOPE("RouteLineCubicOffsetModel::setDCurvatureCost");
     for (int i{0}; i < m_num_samples - 1; ++i) {
         const double factor = dcurvature_weight * m_reciprocal_hs[i] * m_reciprocal_hs[i] *
                               m_reciprocal_hs[i] * m_reciprocal_hs[i] * m_reciprocal_hs[i] /
@@ -799,58 +817,32 @@ auto RouteLineCubicOffsetModel::setDCurvatureCost(double dcurvature_weight) noex
 
 auto RouteLineCubicOffsetModel::solve() const
     -> std::pair<Path2d, ::boyle::cvxopm::Info<double, int>> {
-    constexpr std::array<double, 2> kFactor{1.0 / 3.0, 1.0 / 6.0};
+    BOYLE_TRACE_SCOPE("RouteLineCubicOffsetModel::solve");
     const ::boyle::cvxopm::OsqpSolver osqp_solver{m_settings};
     const auto [osqp_result, osqp_info] = osqp_solver.solve(m_qp_problem);
-    const double dx0{
-        (osqp_result.prim_vars[xIndex(1)] - osqp_result.prim_vars[xIndex(0)]) * m_reciprocal_hs[0] -
-        (osqp_result.prim_vars[ddxIndex(0)] * kFactor[0] +
-         osqp_result.prim_vars[ddxIndex(1)] * kFactor[1]) *
-            m_hs[0]
-    };
-    const double dxf{
-        (osqp_result.prim_vars[xIndex(m_num_samples - 1)] -
-         osqp_result.prim_vars[xIndex(m_num_samples - 2)]) *
-            m_reciprocal_hs[m_num_samples - 2] -
-        (osqp_result.prim_vars[ddxIndex(m_num_samples - 1)] * kFactor[0] +
-         osqp_result.prim_vars[ddxIndex(m_num_samples - 2)] * kFactor[1]) *
-            m_hs[m_num_samples - 2]
-    };
-    const double dy0{
-        (osqp_result.prim_vars[yIndex(1)] - osqp_result.prim_vars[yIndex(0)]) * m_reciprocal_hs[0] -
-        (osqp_result.prim_vars[ddyIndex(0)] * kFactor[0] +
-         osqp_result.prim_vars[ddyIndex(1)] * kFactor[1]) *
-            m_hs[0]
-    };
-    const double dyf{
-        (osqp_result.prim_vars[yIndex(m_num_samples - 1)] -
-         osqp_result.prim_vars[yIndex(m_num_samples - 2)]) *
-            m_reciprocal_hs[m_num_samples - 2] +
-        (osqp_result.prim_vars[ddyIndex(m_num_samples - 1)] * kFactor[0] +
-         osqp_result.prim_vars[ddyIndex(m_num_samples - 2)] * kFactor[1]) *
-            m_hs[m_num_samples - 2]
-    };
-    const double ddx0{osqp_result.prim_vars[ddxIndex(0)]};
-    const double ddxf{osqp_result.prim_vars[ddxIndex(m_num_samples - 1)]};
-    const double ddy0{osqp_result.prim_vars[ddyIndex(0)]};
-    const double ddyf{osqp_result.prim_vars[ddyIndex(m_num_samples - 1)]};
-    const std::array<Path2d::BoundaryMode, 2> b0{
-        Path2d::BoundaryMode{1, {dx0, dy0}}, Path2d::BoundaryMode{2, {ddx0, ddy0}}
-    };
-    const std::array<Path2d::BoundaryMode, 2> bf{
-        Path2d::BoundaryMode{1, {dxf, dyf}}, Path2d::BoundaryMode{2, {ddxf, ddyf}}
+    const std::vector<double>& prim_vars{osqp_result.prim_vars};
+    // The solution is a cubic spline over the sample stations, i.e. a quintic one with zero
+    // fourth derivatives; Path2 only re-parameterizes it by arc length.
+    const auto vec2s = [this, &prim_vars](int x_start, int y_start
+                       ) -> std::vector<::boyle::math::Vec2d> {
+        return ::boyle::math::squeeze<::boyle::math::Vec2d>(
+            std::ranges::subrange{
+                prim_vars.cbegin() + x_start, prim_vars.cbegin() + x_start + m_num_samples
+            },
+            std::ranges::subrange{
+                prim_vars.cbegin() + y_start, prim_vars.cbegin() + y_start + m_num_samples
+            }
+        );
     };
-    std::vector<::boyle::math::Vec2d> anchor_points = ::boyle::math::squeeze<::boyle::math::Vec2d>(
-        std::ranges::subrange{
-            osqp_result.prim_vars.cbegin() + xIndex(0),
-            osqp_result.prim_vars.cbegin() + xIndex(m_num_samples - 1) + 1
-        },
-        std::ranges::subrange{
-            osqp_result.prim_vars.cbegin() + yIndex(0),
-            osqp_result.prim_vars.cbegin() + yIndex(m_num_samples - 1) + 1
-        }
+    std::vector<::boyle::math::Vec2d> anchor_points{vec2s(xIndex(0), yIndex(0))};
+    const std::vector<::boyle::math::Vec2d> dd_anchor_points{vec2s(ddxIndex(0), ddyIndex(0))};
+    const std::vector<::boyle::math::Vec2d> d4_anchor_points(
+        m_num_samples, ::boyle::math::Vec2d{0.0, 0.0}
+    );
+    return std::make_pair(
+        Path2d{m_sample_ss, std::move(anchor_points), dd_anchor_points, d4_anchor_points},
+        osqp_info
     );
-    return std::make_pair(Path2d{std::move(anchor_points), b0, bf}, osqp_info);
 }
 
 auto RouteLineCubicOffsetModel::clear() noexcept -> void {
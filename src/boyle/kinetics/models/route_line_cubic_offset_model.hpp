@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <memory_resource>
 #include <vector>
 
 #include "boyle/cvxopm/info.hpp"
@@ -35,11 +36,13 @@ class [[nodiscard]] RouteLineCubicOffsetModel final {
     ~RouteLineCubicOffsetModel() noexcept = default;
 
     explicit RouteLineCubicOffsetModel(
-        const std::vector<::boyle::math::Vec2d>& sketch_points, std::vector<double> sample_ss
+        const std::vector<::boyle::math::Vec2d>& sketch_points, std::vector<double> sample_ss,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
     ) noexcept(!BOYLE_CHECK_PARAMS);
     explicit RouteLineCubicOffsetModel(
         const std::vector<::boyle::math::Vec2d>& sketch_points, std::vector<double> sample_ss,
-        const ::boyle::cvxopm::Settings<double, int>& settings
+        const ::boyle::cvxopm::Settings<double, int>& settings,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
     ) noexcept(!BOYLE_CHECK_PARAMS);
     auto num_samples() const noexcept -> std::size_t;
     auto qp_problem() const noexcept -> const ::boyle::cvxopm::QpProblem<double, int>&;
@@ -12,6 +12,7 @@
 
 #include "boyle/kinetics/models/route_line_quintic_acc_model.hpp"
 
+#include <chrono>
 #include <limits>
 #include <ranges>
 #include <stdexcept>
@@ -21,7 +22,9 @@
 #include "fmt/format.h"
 
 #include "boyle/common/utils/logging.hpp"
+#include "boyle/common/utils/tracing.hpp"
 #include "boyle/math/functions/piecewise_linear_function1.hpp"
+#include "boyle/math/quintic_interpolation.hpp"
 
 namespace {
 
@@ -46,8 +49,10 @@ constexpr auto prorationCoeffs(double ratio, double scale) noexcept -> std::arra
 
 namespace boyle::kinetics {
 
-RouteLineQuinticAccModel::RouteLineQuinticAccModel(std::vector<double> sample_ts
-) noexcept(!BOYLE_CHECK_PARAMS) {
+RouteLineQuinticAccModel::RouteLineQuinticAccModel(
+    std::vector<double> sample_ts, std::pmr::memory_resource* resource
+) noexcept(!BOYLE_CHECK_PARAMS)
+    : m_qp_problem{resource} {
 #if BOYLE_CHECK_PARAMS == 1
     if (sample_ts.size() < 2) [[unlikely]] {
         throw std::invalid_argument(fmt::format(
@@ -87,9 +92,10 @@ RouteLineQuinticAccModel::RouteLineQuinticAccModel(std::vector<double> sample_ts
 }
 
 RouteLineQuinticAccModel::RouteLineQuinticAccModel(
-    std::vector<double> sample_ts, const ::boyle::cvxopm::Settings<double, int>& settings
+    std::vector<double> sample_ts, const ::boyle::cvxopm::Settings<double, int>& settings,
+    std::pmr::memory_resource* resource
 ) noexcept(!BOYLE_CHECK_PARAMS)
-    : RouteLineQuinticAccModel{std::move(sample_ts)} {
+    : RouteLineQuinticAccModel{std::move(sample_ts), resource} {
     m_settings = settings;
 }
 
@@ -108,6 +114,7 @@ auto RouteLineQuinticAccModel::settings() const noexcept
 }
 
 auto RouteLineQuinticAccModel::setIntegrationRelation() noexcept -> void {
+    BOYLE_TRACE_SCOPE("RouteLineQuinticAccModel::setIntegrationRelation");
     for (int i{1}; i < m_num_samples - 1; ++i) {
         boost::unordered_flat_map<int, double> constrain_vec{
             {sIndex(i - 1), m_reciprocal_h3s[i - 1] * 20.0},
@@ -143,6 +150,13 @@ auto RouteLineQuinticAccModel::setIntegrationRelation() noexcept -> void {
 
 auto RouteLineQuinticAccModel::setHardFences(const std::vector<HardFence1d>& hard_fences
 ) noexcept -> void {
+    BOYLE_TRACE_SCOPE("RouteLineQuinticAccModel::setHardFences");
+    if (m_inputs != nullptr) [[unlikely]] {
+        m_inputs->record(
+            ModelCallKind::HARD_FENCES, {static_cast<double>(m_inputs->hard_fences.size())}
+        );
+        m_inputs->hard_fences.push_back(hard_fences);
+    }
     std::vector<double> lower_bound(m_num_samples, std::numeric_limits<double>::lowest());
     std::vector<double> upper_bound(m_num_samples, std::numeric_limits<double>::max());
     for (const HardFence1d& hard_fence : hard_fences) {
@@ -157,7 +171,8 @@ auto RouteLineQuinticAccModel::setHardFences(const std::vector<HardFence1d>& har
                          ) -
                          m_sample_ts.cbegin();
         if (istart == m_num_samples) {
-            BOYLE_LOG_WARN(
+            BOYLE_LOG_WARN_THROTTLED(
+                std::chrono::seconds{1},
                 "Invalid argument issue detected! The front() of hard_fence.bound_ts should be "
                 "less than m_sample_ts.back(): hard_fence.bound_ts.front() = {0:f} while "
                 "m_sample_ts.back() = {1:f}.",
@@ -166,7 +181,8 @@ auto RouteLineQuinticAccModel::setHardFences(const std::vector<HardFence1d>& har
             break;
         }
         if (iend == 0) {
-            BOYLE_LOG_WARN(
+            BOYLE_LOG_WARN_THROTTLED(
+                std::chrono::seconds{1},
                 "Invalid argument issue detected! The back() of hard_fence.bound_ts should be "
                 "larger than m_sample_ts.front(): hard_fence.bound_ts.back() = {0:f} while "
                 "m_sample_ts.front() = {1:f}.",
@@ -259,6 +275,13 @@ auto RouteLineQuinticAccModel::setHardFences(const std::vector<HardFence1d>& har
 
 auto RouteLineQuinticAccModel::setSoftFences(const std::vector<SoftFence1d>& soft_fences
 ) noexcept -> void {
+    BOYLE_TRACE_SCOPE("RouteLineQuinticAccModel::setSoftFences");
+    if (m_inputs != nullptr) [[unlikely]] {
+        m_inputs->record(
+            ModelCallKind::SOFT_FENCES, {static_cast<double>(m_inputs->soft_fences.size())}
+        );
+        m_inputs->soft_fences.push_back(soft_fences);
+    }
     for (const SoftFence1d& soft_fence : soft_fences) {
         const int istart = ::boyle::math::nearestUpperElement(
                                std::ranges::subrange{m_sample_ts.cbegin(), m_sample_ts.cend()},
@@ -271,7 +294,8 @@ auto RouteLineQuinticAccModel::setSoftFences(const std::vector<SoftFence1d>& sof
                          ) -
                          m_sample_ts.cbegin();
         if (istart == m_num_samples) {
-            BOYLE_LOG_WARN(
+            BOYLE_LOG_WARN_THROTTLED(
+                std::chrono::seconds{1},
                 "Invalid argument issue detected! The front() of hard_fence.bound_ts should be "
                 "less than m_sample_ts.back(): hard_fence.bound_ts.front() = {0:f} while "
                 "m_sample_ts.back() = {1:f}.",
@@ -280,7 +304,8 @@ auto RouteLineQuinticAccModel::setSoftFences(const std::vector<SoftFence1d>& sof
             break;
         }
         if (iend == 0) {
-            BOYLE_LOG_WARN(
+            BOYLE_LOG_WARN_THROTTLED(
+                std::chrono::seconds{1},
                 "Invalid argument issue detected! The back() of hard_fence.bound_ts should be "
                 "larger than m_sample_ts.front(): hard_fence.bound_ts.back() = {0:f} while "
                 "m_sample_ts.front() = {1:f}.",
@@ -458,6 +483,10 @@ auto RouteLineQuinticAccModel::setSoftFences(const std::vector<SoftFence1d>& sof
 
 auto RouteLineQuinticAccModel::setVelocityRange(double lower_bound, double upper_bound) noexcept
     -> void {
+    BOYLE_TRACE_SCOPE("RouteLineQuinticAccModel::setVelocityRange");
+    if (m_inputs != nullptr) [[unlikely]] {
+        m_inputs->record(ModelCallKind::VELOCITY_RANGE, {lower_bound, upper_bound});
+    }
     for (int i{1}; i < m_num_samples - 1; ++i) {
         m_qp_problem.updateConstrainTerm(vIndex(i), {{vIndex(i), 1.0}}, lower_bound, upper_bound);
     }
@@ -466,6 +495,10 @@ auto RouteLineQuinticAccModel::setVelocityRange(double lower_bound, double upper
 
 auto RouteLineQuinticAccModel::setAccelRange(double lower_bound, double upper_bound) noexcept
     -> void {
+    BOYLE_TRACE_SCOPE("RouteLineQuinticAccModel::setAccelRange");
+    if (m_inputs != nullptr) [[unlikely]] {
+        m_inputs->record(ModelCallKind::ACCEL_RANGE, {lower_bound, upper_bound});
+    }
     for (int i{1}; i < m_num_samples - 1; ++i) {
         m_qp_problem.updateConstrainTerm(aIndex(i), {{aIndex(i), 1.0}}, lower_bound, upper_bound);
     }
@@ -474,6 +507,10 @@ auto RouteLineQuinticAccModel::setAccelRange(double lower_bound, double upper_bo
 
 auto RouteLineQuinticAccModel::setInitialState(double s0, double v0, double a0, double j0) noexcept
     -> void {
+    BOYLE_TRACE_SCOPE("RouteLineQuinticAccModel::setInitialState");
+    if (m_inputs != nullptr) [[unlikely]] {
+        m_inputs->record(ModelCallKind::INITIAL_STATE, {s0, v0, a0, j0});
+    }
     if (!std::isnan(s0)) {
         m_qp_problem.updateConstrainTerm(
             sIndex(0), {{sIndex(0), 1.0}}, s0 - ::boyle::math::kEpsilon,
@@ -519,6 +556,10 @@ auto RouteLineQuinticAccModel::setInitialState(double s0, double v0, double a0,
 
 auto RouteLineQuinticAccModel::setFinalState(double sf, double vf, double af, double jf) noexcept
     -> void {
+    BOYLE_TRACE_SCOPE("RouteLineQuinticAccModel::setFinalState");
+    if (m_inputs != nullptr) [[unlikely]] {
+        m_inputs->record(ModelCallKind::FINAL_STATE, {sf, vf, af, jf});
+    }
     if (!std::isnan(sf)) {
         m_qp_problem.updateConstrainTerm(
             sIndex(m_num_samples - 1), {{sIndex(m_num_samples - 1), 1.0}},
@@ -565,6 +606,10 @@ auto RouteLineQuinticAccModel::setFinalState(double sf, double vf, double af, do
 auto RouteLineQuinticAccModel::setVelocityCost(
     double target_velocity, double velocity_weight
 ) noexcept -> void {
+    BOYLE_TRACE_SCOPE("RouteLineQuinticAccModel::setVelocityCost");
+    if (m_inputs != nullptr) [[unlikely]] {
+        m_inputs->record(ModelCallKind::VELOCITY_COST, {target_velocity, velocity_weight});
+    }
     constexpr std::array<double, 9> kFactors{10.0 / 7.0, 20.0 / 7.0,  3.0 / 7.0,
                                              1.0 / 42.0, 8.0 / 35.0,  1.0 / 35.0,
                                              1.0 / 30.0, 1.0 / 105.0, 1.0 / 630.0};
@@ -600,6 +645,10 @@ auto RouteLineQuinticAccModel::setVelocityCost(
 }
 
 auto RouteLineQuinticAccModel::setAccelCost(double accel_weight) noexcept -> void {
+    BOYLE_TRACE_SCOPE("RouteLineQuinticAccModel::setAccelCost");
+    if (m_inputs != nullptr) [[unlikely]] {
+        m_inputs->record(ModelCallKind::ACCEL_COST, {accel_weight});
+    }
     constexpr std::array<double, 9> kFactors{120.0 / 7.0,  240.0 / 7.0,  6.0 / 7.0,
                                              192.0 / 35.0, 216.0 / 35.0, 22.0 / 35.0,
                                              8.0 / 35.0,   3.0 / 35.0,   1.0 / 35.0};
@@ -633,6 +682,10 @@ auto RouteLineQuinticAccModel::setAccelCost(double accel_weight) noexcept -> voi
 }
 
 auto RouteLineQuinticAccModel::setJerkCost(double jerk_weight) noexcept -> void {
+    BOYLE_TRACE_SCOPE("RouteLineQuinticAccModel::setJerkCost");
+    if (m_inputs != nullptr) [[unlikely]] {
+        m_inputs->record(ModelCallKind::JERK_COST, {jerk_weight});
+    }
     for (int i{0}; i < m_num_samples - 1; ++i) {
         const double factor =
             jerk_weight * m_reciprocal_h3s[i] * m_reciprocal_h2s[i] / m_time_scale;
@@ -662,6 +715,10 @@ auto RouteLineQuinticAccModel::setJerkCost(double jerk_weight) noexcept -> void
 }
 
 auto RouteLineQuinticAccModel::setSnapCost(double snap_weight) noexcept -> void {
+    BOYLE_TRACE_SCOPE("RouteLineQuinticAccModel::setSnapCost");
+    if (m_inputs != nullptr) [[unlikely]] {
+        m_inputs->record(ModelCallKind::SNAP_COST, {snap_weight});
+    }
     for (int i{0}; i < m_num_samples - 1; ++i) {
         const double factor =
             snap_weight * m_reciprocal_h4s[i] * m_reciprocal_h3s[i] / m_time_scale;
@@ -692,26 +749,40 @@ auto RouteLineQuinticAccModel::setSnapCost(double snap_weight) noexcept -> void
 
 auto RouteLineQuinticAccModel::solve() const
     -> std::pair<Motion1d, ::boyle::cvxopm::Info<double, int>> {
+    BOYLE_TRACE_SCOPE("RouteLineQuinticAccModel::solve");
+    if (m_inputs != nullptr) [[unlikely]] {
+        m_inputs->record(ModelCallKind::SOLVE);
+    }
     const ::boyle::cvxopm::OsqpSolver osqp_solver{m_settings};
     const auto [osqp_result, osqp_info] = osqp_solver.solve(m_qp_problem);
-    const double v0{osqp_result.prim_vars[vIndex(0)]};
-    const double vf{osqp_result.prim_vars[vIndex(m_num_samples - 1)]};
-    const double a0{osqp_result.prim_vars[aIndex(0)]};
-    const double af{osqp_result.prim_vars[aIndex(m_num_samples - 1)]};
-    const std::array<Motion1d::BoundaryMode, 2> b0{
-        Motion1d::BoundaryMode{1, v0}, Motion1d::BoundaryMode{2, a0}
-    };
-    const std::array<Motion1d::BoundaryMode, 2> bf{
-        Motion1d::BoundaryMode{1, vf}, Motion1d::BoundaryMode{2, af}
-    };
+    const std::vector<double>& prim_vars{osqp_result.prim_vars};
+    // The integration relation keeps jerk and snap continuous, so the solution already is the
+    // quintic spline that Motion1 stores; only the snaps have to be recovered per segment.
     std::vector<double> anchor_ss{
-        osqp_result.prim_vars.cbegin(),
-        osqp_result.prim_vars.cbegin() + sIndex(m_num_samples - 1) + 1
+        prim_vars.cbegin() + sIndex(0), prim_vars.cbegin() + sIndex(m_num_samples - 1) + 1
     };
-    return std::make_pair(Motion1d{m_sample_ts, std::move(anchor_ss), b0, bf}, osqp_info);
+    std::vector<double> anchor_dds{
+        prim_vars.cbegin() + aIndex(0), prim_vars.cbegin() + aIndex(m_num_samples - 1) + 1
+    };
+    std::vector<double> anchor_d4s(m_num_samples, 0.0);
+    for (int i{0}; i < m_num_samples - 1; ++i) {
+        const auto [d4_start, d4_end] = ::boyle::math::calcQuinticD4s(
+            prim_vars[sIndex(i)], prim_vars[sIndex(i + 1)], prim_vars[vIndex(i)],
+            prim_vars[vIndex(i + 1)], prim_vars[aIndex(i)], prim_vars[aIndex(i + 1)], m_hs[i]
+        );
+        anchor_d4s[i] += i == 0 ? d4_start : d4_start * 0.5;
+        anchor_d4s[i + 1] += i == m_num_samples - 2 ? d4_end : d4_end * 0.5;
+    }
+    return std::make_pair(
+        Motion1d{m_sample_ts, std::move(anchor_ss), std::move(anchor_dds), std::move(anchor_d4s)},
+        osqp_info
+    );
 }
 
 auto RouteLineQuinticAccModel::clear() noexcept -> void {
+    if (m_inputs != nullptr) [[unlikely]] {
+        m_inputs->record(ModelCallKind::CLEAR);
+    }
     m_num_samples = 0;
     m_time_scale = 0.0;
     m_qp_problem.clear();
@@ -727,6 +798,16 @@ auto RouteLineQuinticAccModel::clear() noexcept -> void {
     return;
 }
 
+auto RouteLineQuinticAccModel::recordInputs(RouteLineQuinticAccInputs* inputs) noexcept -> void {
+    m_inputs = inputs;
+    if (m_inputs != nullptr) {
+        m_inputs->clear();
+        m_inputs->sample_ts = m_sample_ts;
+        m_inputs->settings = m_settings;
+    }
+    return;
+}
+
 // NOLINTNEXTLINE(readability-convert-member-functions-to-static)
 auto RouteLineQuinticAccModel::sIndex(int t_index) const noexcept -> int { return t_index; }
 
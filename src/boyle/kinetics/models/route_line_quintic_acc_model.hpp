@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <memory_resource>
 #include <vector>
 
 #include "boyle/cvxopm/info.hpp"
@@ -19,6 +20,7 @@
 #include "boyle/cvxopm/settings.hpp"
 #include "boyle/cvxopm/solvers/osqp_solver.hpp"
 #include "boyle/kinetics/fence1.hpp"
+#include "boyle/kinetics/models/model_inputs.hpp"
 #include "boyle/kinetics/motion1.hpp"
 
 namespace boyle::kinetics {
@@ -32,9 +34,13 @@ class [[nodiscard]] RouteLineQuinticAccModel final {
     auto operator=(RouteLineQuinticAccModel&& other) noexcept -> RouteLineQuinticAccModel& = delete;
     ~RouteLineQuinticAccModel() noexcept = default;
 
-    explicit RouteLineQuinticAccModel(std::vector<double> sample_ts) noexcept(!BOYLE_CHECK_PARAMS);
     explicit RouteLineQuinticAccModel(
-        std::vector<double> sample_ts, const ::boyle::cvxopm::Settings<double, int>& settings
+        std::vector<double> sample_ts,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) noexcept(!BOYLE_CHECK_PARAMS);
+    explicit RouteLineQuinticAccModel(
+        std::vector<double> sample_ts, const ::boyle::cvxopm::Settings<double, int>& settings,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
     ) noexcept(!BOYLE_CHECK_PARAMS);
     auto num_samples() const noexcept -> std::size_t;
     auto qp_problem() const noexcept -> const ::boyle::cvxopm::QpProblem<double, int>&;
@@ -62,6 +68,12 @@ class [[nodiscard]] RouteLineQuinticAccModel final {
     auto solve() const -> std::pair<Motion1d, ::boyle::cvxopm::Info<double, int>>;
     auto clear() noexcept -> void;
 
+    /**
+     * @brief Mirrors the construction data and every following setter and solve call into
+     * inputs, so that the cycle can be replayed offline. Pass nullptr to stop recording.
+     */
+    auto recordInputs(RouteLineQuinticAccInputs* inputs) noexcept -> void;
+
   private:
     auto setIntegrationRelation() noexcept -> void;
     auto sIndex(int t_index) const noexcept -> int;
@@ -80,6 +92,7 @@ class [[nodiscard]] RouteLineQuinticAccModel final {
     std::vector<double> m_reciprocal_h2s{};
     std::vector<double> m_reciprocal_h3s{};
     std::vector<double> m_reciprocal_h4s{};
+    RouteLineQuinticAccInputs* m_inputs{nullptr};
 };
 
 } // namespace boyle::kinetics
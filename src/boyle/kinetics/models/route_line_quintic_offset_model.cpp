@@ -13,6 +13,7 @@
 #include "boyle/kinetics/models/route_line_quintic_offset_model.hpp"
 
 #include <array>
+#include <chrono>
 #include <limits>
 #include <stdexcept>
 #include <utility>
@@ -21,6 +22,7 @@
 #include "fmt/format.h"
 
 #include "boyle/common/utils/logging.hpp"
+#include "boyle/common/utils/tracing.hpp"
 #include "boyle/math/functions/piecewise_linear_function1.hpp"
 #include "boyle/math/quintic_interpolation.hpp"
 #include "boyle/math/utils.hpp"
@@ -28,8 +30,10 @@
 namespace boyle::kinetics {
 
 RouteLineQuinticOffsetModel::RouteLineQuinticOffsetModel(
-    const std::vector<::boyle::math::Vec2d>& sketch_points, std::vector<double> sample_ss
-) noexcept(!BOYLE_CHECK_PARAMS) {
+    const std::vector<::boyle::math::Vec2d>& sketch_points, std::vector<double> sample_ss,
+    std::pmr::memory_resource* resource
+) noexcept(!BOYLE_CHECK_PARAMS)
+    : m_qp_problem{resource} {
 #if BOYLE_CHECK_PARAMS == 1
     if (sketch_points.size() < 2) [[unlikely]] {
         throw std::invalid_argument(fmt::format(
@@ -80,9 +84,9 @@ RouteLineQuinticOffsetModel::RouteLineQuinticOffsetModel(
 
 RouteLineQuinticOffsetModel::RouteLineQuinticOffsetModel(
     const std::vector<::boyle::math::Vec2d>& raw_sketch_points, std::vector<double> sample_ss,
-    const ::boyle::cvxopm::Settings<double, int>& settings
+    const ::boyle::cvxopm::Settings<double, int>& settings, std::pmr::memory_resource* resource
 ) noexcept(!BOYLE_CHECK_PARAMS)
-    : RouteLineQuinticOffsetModel{raw_sketch_points, std::move(sample_ss)} {
+    : RouteLineQuinticOffsetModel{raw_sketch_points, std::move(sample_ss), resource} {
     m_settings = settings;
 }
 
@@ -101,6 +105,7 @@ auto RouteLineQuinticOffsetModel::settings() const noexcept
 }
 
 auto RouteLineQuinticOffsetModel::setIntegrationRelation() noexcept -> void {
+    BOYLE_TRACE_SCOPE("RouteLineQuinticOffsetModel::setIntegrationRelation");
     for (int i{1}; i < m_num_samples - 1; ++i) {
         boost::unordered_flat_map<int, double> constrain_vec{
             {xIndex(i - 1), -m_reciprocal_hs[i - 1] * 6.0},
@@ -158,6 +163,13 @@ auto RouteLineQuinticOffsetModel::setIntegrationRelation() noexcept -> void {
 
 auto RouteLineQuinticOffsetModel::setHardBorders(const std::vector<HardBorder2d>& hard_borders
 ) noexcept -> void {
+    BOYLE_TRACE_SCOPE("RouteLineQuinticOffsetModel::setHardBorders");
+    if (m_inputs != nullptr) [[unlikely]] {
+        m_inputs->record(
+            ModelCallKind::HARD_BORDERS, {static_cast<double>(m_inputs->hard_borders.size())}
+        );
+        m_inputs->hard_borders.push_back(hard_borders);
+    }
     std::vector<double> x_lower_bound(m_num_samples, std::numeric_limits<double>::lowest());
     std::vector<double> x_upper_bound(m_num_samples, std::numeric_limits<double>::max());
     std::vector<double> y_lower_bound(m_num_samples, std::numeric_limits<double>::lowest());
@@ -176,14 +188,16 @@ auto RouteLineQuinticOffsetModel::setHardBorders(const std::vector<HardBorder2d>
             ) -
             m_sample_points.cbegin();
         if (istart == m_num_samples) {
-            BOYLE_LOG_WARN(
+            BOYLE_LOG_WARN_THROTTLED(
+                std::chrono::seconds{1},
                 "Invalid argument issue detected! This soft border is not in the same region as "
                 "the sketch points."
             );
             break;
         }
         if (iend == 0) {
-            BOYLE_LOG_WARN(
+            BOYLE_LOG_WARN_THROTTLED(
+                std::chrono::seconds{1},
                 "Invalid argument issue detected! This soft border is not in the same region as "
                 "the sketch points."
             );
@@ -333,6 +347,13 @@ auto RouteLineQuinticOffsetModel::setHardBorders(const std::vector<HardBorder2d>
 
 auto RouteLineQuinticOffsetModel::setSoftBorders(const std::vector<SoftBorder2d>& soft_borders
 ) noexcept -> void {
+    BOYLE_TRACE_SCOPE("RouteLineQuinticOffsetModel::setSoftBorders");
+    if (m_inputs != nullptr) [[unlikely]] {
+        m_inputs->record(
+            ModelCallKind::SOFT_BORDERS, {static_cast<double>(m_inputs->soft_borders.size())}
+        );
+        m_inputs->soft_borders.push_back(soft_borders);
+    }
     for (const SoftBorder2d& soft_border : soft_borders) {
         const int istart =
             ::boyle::math::nearestUpperElement(
@@ -347,14 +368,16 @@ auto RouteLineQuinticOffsetModel::setSoftBorders(const std::vector<SoftBorder2d>
             ) -
             m_sample_points.cbegin();
         if (istart == m_num_samples) {
-            BOYLE_LOG_WARN(
+            BOYLE_LOG_WARN_THROTTLED(
+                std::chrono::seconds{1},
                 "Invalid argument issue detected! This soft border is not in the same region as "
                 "the sketch points."
             );
             break;
         }
         if (iend == 0) {
-            BOYLE_LOG_WARN(
+            BOYLE_LOG_WARN_THROTTLED(
+                std::chrono::seconds{1},
                 "Invalid argument issue detected! This soft border is not in the same region as "
                 "the sketch points."
             );
@@ -636,6 +659,10 @@ auto RouteLineQuinticOffsetModel::setSoftBorders(const std::vector<SoftBorder2d>
 }
 
 auto RouteLineQuinticOffsetModel::setDdxRange(double ddx_min, double ddx_max) noexcept -> void {
+    BOYLE_TRACE_SCOPE("RouteLineQuinticOffsetModel::setDdxRange");
+    if (m_inputs != nullptr) [[unlikely]] {
+        m_inputs->record(ModelCallKind::DDX_RANGE, {ddx_min, ddx_max});
+    }
     for (int i{0}; i < m_num_samples; i++) {
         m_qp_problem.updateConstrainTerm(ddxIndex(i), {{ddxIndex(i), 1.0}}, ddx_min, ddx_max);
     }
@@ -643,6 +670,10 @@ auto RouteLineQuinticOffsetModel::setDdxRange(double ddx_min, double ddx_max) no
 }
 
 auto RouteLineQuinticOffsetModel::setDdyRange(double ddy_min, double ddy_max) noexcept -> void {
+    BOYLE_TRACE_SCOPE("RouteLineQuinticOffsetModel::setDdyRange");
+    if (m_inputs != nullptr) [[unlikely]] {
+        m_inputs->record(ModelCallKind::DDY_RANGE, {ddy_min, ddy_max});
+    }
     for (int i{0}; i < m_num_samples; i++) {
         m_qp_problem.updateConstrainTerm(ddyIndex(i), {{ddyIndex(i), 1.0}}, ddy_min, ddy_max);
     }
@@ -650,6 +681,10 @@ auto RouteLineQuinticOffsetModel::setDdyRange(double ddy_min, double ddy_max) no
 }
 
 auto RouteLineQuinticOffsetModel::setD4xRange(double ddx_min, double ddx_max) noexcept -> void {
+    BOYLE_TRACE_SCOPE("RouteLineQuinticOffsetModel::setD4xRange");
+    if (m_inputs != nullptr) [[unlikely]] {
+        m_inputs->record(ModelCallKind::D4X_RANGE, {ddx_min, ddx_max});
+    }
     for (int i{0}; i < m_num_samples; i++) {
         m_qp_problem.updateConstrainTerm(d4xIndex(i), {{d4xIndex(i), 1.0}}, ddx_min, ddx_max);
     }
@@ -657,6 +692,10 @@ auto RouteLineQuinticOffsetModel::setD4xRange(double ddx_min, double ddx_max) no
 }
 
 auto RouteLineQuinticOffsetModel::setD4yRange(double ddy_min, double ddy_max) noexcept -> void {
+    BOYLE_TRACE_SCOPE("RouteLineQuinticOffsetModel::setD4yRange");
+    if (m_inputs != nullptr) [[unlikely]] {
+        m_inputs->record(ModelCallKind::D4Y_RANGE, {ddy_min, ddy_max});
+    }
     for (int i{0}; i < m_num_samples; i++) {
         m_qp_problem.updateConstrainTerm(d4yIndex(i), {{d4yIndex(i), 1.0}}, ddy_min, ddy_max);
     }
@@ -667,6 +706,12 @@ auto RouteLineQuinticOffsetModel::setInitialState(
     ::boyle::math::Vec2d r0, ::boyle::math::Vec2d t0, ::boyle::math::Vec2d n0,
     ::boyle::math::Vec2d j0
 ) noexcept -> void {
+    BOYLE_TRACE_SCOPE("RouteLineQuinticOffsetModel::setInitialState");
+    if (m_inputs != nullptr) [[unlikely]] {
+        m_inputs->record(
+            ModelCallKind::INITIAL_STATE, {r0.x, r0.y, t0.x, t0.y, n0.x, n0.y, j0.x, j0.y}
+        );
+    }
     m_qp_problem.updateConstrainTerm(
         xIndex(0), {{xIndex(0), 1.0}}, r0.x - ::boyle::math::kEpsilon,
         r0.x + ::boyle::math::kEpsilon
@@ -747,6 +792,12 @@ auto RouteLineQuinticOffsetModel::setFinalState(
     ::boyle::math::Vec2d rf, ::boyle::math::Vec2d tf, ::boyle::math::Vec2d nf,
     ::boyle::math::Vec2d jf
 ) noexcept -> void {
+    BOYLE_TRACE_SCOPE("RouteLineQuinticOffsetModel::setFinalState");
+    if (m_inputs != nullptr) [[unlikely]] {
+        m_inputs->record(
+            ModelCallKind::FINAL_STATE, {rf.x, rf.y, tf.x, tf.y, nf.x, nf.y, jf.x, jf.y}
+        );
+    }
     m_qp_problem.updateConstrainTerm(
         xIndex(m_num_samples - 1), {{xIndex(m_num_samples - 1), 1.0}},
         rf.x - ::boyle::math::kEpsilon, rf.x + ::boyle::math::kEpsilon
@@ -824,6 +875,10 @@ auto RouteLineQuinticOffsetModel::setFinalState(
 }
 
 auto RouteLineQuinticOffsetModel::setOffsetCost(double offset_weight) noexcept -> void {
+    BOYLE_TRACE_SCOPE("RouteLineQuinticOffsetModel::setOffsetCost");
+    if (m_inputs != nullptr) [[unlikely]] {
+        m_inputs->record(ModelCallKind::OFFSET_COST, {offset_weight});
+    }
     constexpr std::array<double, 10> kFactors{1.0 / 3.0,       2.0 / 45.0,       7.0 / 180.0,
                                               2.0 / 945.0,     4.0 / 945.0,      31.0 / 7560.0,
                                               2.0 / 4725.0,    127.0 / 302400.0, 2.0 / 93555.0,
@@ -963,6 +1018,10 @@ auto RouteLineQuinticOffsetModel::setOffsetCost(double offset_weight) noexcept -
 }
 
 auto RouteLineQuinticOffsetModel::setCurvatureCost(double curvature_weight) noexcept -> void {
+    BOYLE_TRACE_SCOPE("RouteLineQuinticOffsetModel::setCurvatureCost");
+    if (m_inputs != nullptr) [[unlikely]] {
+        m_inputs->record(ModelCallKind::CURVATURE_COST, {curvature_weight});
+    }
     constexpr std::array<double, 5> kFactors{
         1.0 / 3.0, 2.0 / 45.0, 7.0 / 180.0, 2.0 / 945.0, 31.0 / 7560.0
     };
@@ -1016,6 +1075,10 @@ auto RouteLineQuinticOffsetModel::setCurvatureCost(double curvature_weight) noex
 }
 
 auto RouteLineQuinticOffsetModel::setDCurvatureCost(double dcurvature_weight) noexcept -> void {
+    BOYLE_TRACE_SCOPE("RouteLineQuinticOffsetModel::setDCurvatureCost");
+    if (m_inputs != nullptr) [[unlikely]] {
+        m_inputs->record(ModelCallKind::DCURVATURE_COST, {dcurvature_weight});
+    }
     for (int i{0}; i < m_num_samples - 1; ++i) {
         const double factor = dcurvature_weight * m_reciprocal_hs[i] * m_reciprocal_hs[i] *
                               m_reciprocal_hs[i] * m_reciprocal_hs[i] * m_reciprocal_hs[i] /
@@ -1039,36 +1102,39 @@ auto RouteLineQuinticOffsetModel::setDCurvatureCost(double dcurvature_weight) no
 
 auto RouteLineQuinticOffsetModel::solve() const
     -> std::pair<Path2d, ::boyle::cvxopm::Info<double, int>> {
+    BOYLE_TRACE_SCOPE("RouteLineQuinticOffsetModel::solve");
+    if (m_inputs != nullptr) [[unlikely]] {
+        m_inputs->record(ModelCallKind::SOLVE);
+    }
     const ::boyle::cvxopm::OsqpSolver osqp_solver{m_settings};
     const auto [osqp_result, osqp_info] = osqp_solver.solve(m_qp_problem);
-    const double ddx0{osqp_result.prim_vars[ddxIndex(0)]};
-    const double ddxf{osqp_result.prim_vars[ddxIndex(m_num_samples - 1)]};
-    const double ddy0{osqp_result.prim_vars[ddyIndex(0)]};
-    const double ddyf{osqp_result.prim_vars[ddyIndex(m_num_samples - 1)]};
-    const double d4x0{osqp_result.prim_vars[d4xIndex(0)]};
-    const double d4xf{osqp_result.prim_vars[d4xIndex(m_num_samples - 1)]};
-    const double d4y0{osqp_result.prim_vars[d4yIndex(0)]};
-    const double d4yf{osqp_result.prim_vars[d4yIndex(m_num_samples - 1)]};
-    const std::array<Path2d::BoundaryMode, 2> b0{
-        Path2d::BoundaryMode{2, {ddx0, ddy0}}, Path2d::BoundaryMode{4, {d4x0, d4y0}}
-    };
-    const std::array<Path2d::BoundaryMode, 2> bf{
-        Path2d::BoundaryMode{2, {ddxf, ddyf}}, Path2d::BoundaryMode{4, {d4xf, d4yf}}
+    const std::vector<double>& prim_vars{osqp_result.prim_vars};
+    // The solution is a quintic spline over the sample stations; Path2 only re-parameterizes it
+    // by arc length.
+    const auto vec2s = [this, &prim_vars](int x_start, int y_start
+                       ) -> std::vector<::boyle::math::Vec2d> {
+        return ::boyle::math::squeeze<::boyle::math::Vec2d>(
+            std::ranges::subrange{
+                prim_vars.cbegin() + x_start, prim_vars.cbegin() + x_start + m_num_samples
+            },
+            std::ranges::subrange{
+                prim_vars.cbegin() + y_start, prim_vars.cbegin() + y_start + m_num_samples
+            }
+        );
     };
-    std::vector<::boyle::math::Vec2d> anchor_points = ::boyle::math::squeeze<::boyle::math::Vec2d>(
-        std::ranges::subrange{
-            osqp_result.prim_vars.cbegin() + xIndex(0),
-            osqp_result.prim_vars.cbegin() + xIndex(m_num_samples - 1) + 1
-        },
-        std::ranges::subrange{
-            osqp_result.prim_vars.cbegin() + yIndex(0),
-            osqp_result.prim_vars.cbegin() + yIndex(m_num_samples - 1) + 1
-        }
+    std::vector<::boyle::math::Vec2d> anchor_points{vec2s(xIndex(0), yIndex(0))};
+    const std::vector<::boyle::math::Vec2d> dd_anchor_points{vec2s(ddxIndex(0), ddyIndex(0))};
+    const std::vector<::boyle::math::Vec2d> d4_anchor_points{vec2s(d4xIndex(0), d4yIndex(0))};
+    return std::make_pair(
+        Path2d{m_sample_ss, std::move(anchor_points), dd_anchor_points, d4_anchor_points},
+        osqp_info
     );
-    return std::make_pair(Path2d{std::move(anchor_points), b0, bf}, osqp_info);
 }
 
 auto RouteLineQuinticOffsetModel::clear() noexcept -> void {
+    if (m_inputs != nullptr) [[unlikely]] {
+        m_inputs->record(ModelCallKind::CLEAR);
+    }
     m_sketch_curve = ::boyle::math::PiecewiseQuinticCurve2d{};
     m_num_samples = 0;
     m_sample_points.clear();
@@ -1085,6 +1151,20 @@ auto RouteLineQuinticOffsetModel::clear() noexcept -> void {
     return;
 }
 
+auto RouteLineQuinticOffsetModel::recordInputs(RouteLineQuinticOffsetInputs* inputs) noexcept
+    -> void {
+    m_inputs = inputs;
+    if (m_inputs != nullptr) {
+        m_inputs->clear();
+        m_inputs->sketch_points.assign(
+            m_sketch_curve.anchorPoints().cbegin(), m_sketch_curve.anchorPoints().cend()
+        );
+        m_inputs->sample_ss = m_sample_ss;
+        m_inputs->settings = m_settings;
+    }
+    return;
+}
+
 // NOLINTNEXTLINE(readability-convert-member-functions-to-static)
 auto RouteLineQuinticOffsetModel::xIndex(int s_index) const noexcept -> int { return s_index; }
 
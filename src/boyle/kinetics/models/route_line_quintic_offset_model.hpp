@@ -13,6 +13,7 @@
 #pragma once
 
 #include <limits>
+#include <memory_resource>
 #include <vector>
 
 #include "boyle/cvxopm/info.hpp"
@@ -20,6 +21,7 @@
 #include "boyle/cvxopm/settings.hpp"
 #include "boyle/cvxopm/solvers/osqp_solver.hpp"
 #include "boyle/kinetics/border2.hpp"
+#include "boyle/kinetics/models/model_inputs.hpp"
 #include "boyle/kinetics/path2.hpp"
 #include "boyle/math/curves/piecewise_quintic_curve.hpp"
 
@@ -36,11 +38,13 @@ class [[nodiscard]] RouteLineQuinticOffsetModel final {
     ~RouteLineQuinticOffsetModel() noexcept = default;
 
     explicit RouteLineQuinticOffsetModel(
-        const std::vector<::boyle::math::Vec2d>& sketch_points, std::vector<double> sample_ss
+        const std::vector<::boyle::math::Vec2d>& sketch_points, std::vector<double> sample_ss,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
     ) noexcept(!BOYLE_CHECK_PARAMS);
     explicit RouteLineQuinticOffsetModel(
         const std::vector<::boyle::math::Vec2d>& sketch_points, std::vector<double> sample_ss,
-        const ::boyle::cvxopm::Settings<double, int>& settings
+        const ::boyle::cvxopm::Settings<double, int>& settings,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
     ) noexcept(!BOYLE_CHECK_PARAMS);
     auto num_samples() const noexcept -> std::size_t;
     auto qp_problem() const noexcept -> const ::boyle::cvxopm::QpProblem<double, int>&;
@@ -75,6 +79,12 @@ class [[nodiscard]] RouteLineQuinticOffsetModel final {
     auto solve() const -> std::pair<Path2d, ::boyle::cvxopm::Info<double, int>>;
     auto clear() noexcept -> void;
 
+    /**
+     * @brief Mirrors the construction data and every following setter and solve call into
+     * inputs, so that the cycle can be replayed offline. Pass nullptr to stop recording.
+     */
+    auto recordInputs(RouteLineQuinticOffsetInputs* inputs) noexcept -> void;
+
   private:
     auto setIntegrationRelation() noexcept -> void;
     auto xIndex(int s_index) const noexcept -> int;
@@ -97,6 +107,7 @@ class [[nodiscard]] RouteLineQuinticOffsetModel final {
     std::vector<double> m_h6s{};
     std::vector<double> m_h8s{};
     std::vector<double> m_reciprocal_hs{};
+    RouteLineQuinticOffsetInputs* m_inputs{nullptr};
 };
 
 } // namespace boyle::kinetics
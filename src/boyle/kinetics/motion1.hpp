@@ -13,21 +13,30 @@
 #pragma once
 
 #include <concepts>
+#include <memory>
+#include <span>
 #include <utility>
 #include <vector>
 
 #include "boost/serialization/access.hpp"
 
+#include "boyle/math/flat_file.hpp"
 #include "boyle/math/functions/piecewise_quintic_function1.hpp"
 
 namespace boyle::kinetics {
 
-template <std::floating_point T>
+template <std::floating_point T, typename Alloc = std::allocator<T>>
 class [[nodiscard]] Motion1 final {
     friend class boost::serialization::access;
 
   public:
-    using BoundaryMode = typename ::boyle::math::PiecewiseQuinticFunction1<T>::BoundaryMode;
+    using allocator_type = Alloc;
+    using function_type = ::boyle::math::PiecewiseQuinticFunction1<T, T, Alloc>;
+    using vector_type = typename function_type::value_vector_type;
+    using BoundaryMode = typename function_type::BoundaryMode;
+
+    static constexpr ::boyle::math::FlatKind kFlatKind{::boyle::math::FlatKind::MOTION1};
+
     ~Motion1() noexcept = default;
 
     Motion1() noexcept = default;
@@ -37,7 +46,7 @@ class [[nodiscard]] Motion1 final {
     auto operator=(Motion1&& other) noexcept -> Motion1& = default;
 
     [[using gnu: always_inline]]
-    explicit Motion1(std::vector<T> ts, std::vector<T> ss)
+    explicit Motion1(vector_type ts, vector_type ss)
         : Motion1{
               std::move(ts), std::move(ss),
               std::array<BoundaryMode, 2>{BoundaryMode{2, T{0.0}}, BoundaryMode{4, T{0.0}}},
@@ -46,16 +55,44 @@ class [[nodiscard]] Motion1 final {
 
     [[using gnu: always_inline]]
     explicit Motion1(
-        std::vector<T> ts, std::vector<T> ss, std::array<BoundaryMode, 2> b0,
+        vector_type ts, vector_type ss, std::array<BoundaryMode, 2> b0,
         std::array<BoundaryMode, 2> bf
     )
         : m_s_of_t{std::move(ts), std::move(ss), b0, bf} {}
 
+    /**
+     * @brief Adopts the knots, stations, accelerations and snaps as they are, e.g. straight from
+     * an optimizer whose variables already form a C4 spline, without fitting again.
+     */
+    [[using gnu: always_inline]]
+    explicit Motion1(vector_type ts, vector_type ss, vector_type ddss, vector_type d4ss)
+        : m_s_of_t{std::move(ts), std::move(ss), std::move(ddss), std::move(d4ss)} {}
+
     [[using gnu: pure, always_inline]]
     auto s(T t) const noexcept -> T {
         return m_s_of_t.eval(t);
     }
 
+    /**
+     * @brief Time at which the motion passes the station s, for forward (monotone) motion. If the
+     * motion stops at s, this is the time it departs from s again, not the time it arrives: a
+     * plateau of s(t) maps to its last preimage.
+     */
+    [[using gnu: pure, always_inline]]
+    auto t(T s) const noexcept -> T {
+        return m_s_of_t.inverse(s);
+    }
+
+    /**
+     * @brief Times at which the stations ss, sorted ascending, are passed, with the same departure
+     * semantics on a stop as t(s).
+     */
+    [[using gnu: always_inline]]
+    auto t(std::span<const T> ss, std::span<T> ts) const noexcept(!BOYLE_CHECK_PARAMS) -> void {
+        m_s_of_t.inverse(ss, ts);
+        return;
+    }
+
     [[using gnu: pure, always_inline]]
     auto velocity(T t) const noexcept -> T {
         return m_s_of_t.derivative(t);
@@ -87,26 +124,61 @@ class [[nodiscard]] Motion1 final {
     }
 
     [[using gnu: pure, always_inline]]
-    auto ts() const noexcept -> const std::vector<T>& {
+    auto ts() const noexcept -> const vector_type& {
         return m_s_of_t.ts();
     }
 
     [[using gnu: pure, always_inline]]
-    auto ss() const noexcept -> const std::vector<T>& {
+    auto ss() const noexcept -> const vector_type& {
         return m_s_of_t.ys();
     }
 
+    [[using gnu: pure, always_inline]]
+    auto ddss() const noexcept -> const vector_type& {
+        return m_s_of_t.ddys();
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto d4ss() const noexcept -> const vector_type& {
+        return m_s_of_t.d4ys();
+    }
+
+    [[using gnu: always_inline]]
+    auto writeFlat(::boyle::math::FlatWriter& writer) const -> void {
+        m_s_of_t.writeFlat(writer, kFlatKind);
+        return;
+    }
+
+    [[using gnu: always_inline]]
+    static auto fromFlat(const ::boyle::math::FlatRecord& record) -> Motion1 {
+        return Motion1{function_type::fromFlat(record, kFlatKind)};
+    }
+
   private:
+    [[using gnu: always_inline]]
+    explicit Motion1(function_type s_of_t) noexcept
+        : m_s_of_t{std::move(s_of_t)} {}
+
     [[using gnu: always_inline]]
     auto serialize(auto& archive, [[maybe_unused]] const unsigned int version) noexcept -> void {
         archive & m_s_of_t;
         return;
     }
 
-    ::boyle::math::PiecewiseQuinticFunction1<T> m_s_of_t{};
+    function_type m_s_of_t{};
 };
 
 using Motion1f = Motion1<float>;
 using Motion1d = Motion1<double>;
 
+namespace view {
+
+template <std::floating_point T>
+using Motion1 = ::boyle::kinetics::Motion1<T, ::boyle::math::ExternalStorage>;
+
+using Motion1f = Motion1<float>;
+using Motion1d = Motion1<double>;
+
+} // namespace view
+
 } // namespace boyle::kinetics
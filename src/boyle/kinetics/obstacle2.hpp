@@ -0,0 +1,86 @@
+/**
+ * @file obstacle2.hpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2024-06-14
+ *
+ * @copyright Copyright (c) 2024 Boyle Development Team
+ *            All rights reserved.
+ *
+ */
+
+#pragma once
+
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "boost/serialization/vector.hpp"
+
+#include "boyle/math/concepts.hpp"
+#include "boyle/math/vec2.hpp"
+
+namespace boyle::kinetics {
+
+/**
+ * @brief A static obstacle given as a convex polygon with counter-clockwise vertices.
+ */
+template <std::floating_point T>
+struct [[nodiscard]] StaticObstacle2 final {
+    using value_type = T;
+    std::uint64_t id{std::numeric_limits<std::uint64_t>::quiet_NaN()};
+    std::vector<::boyle::math::Vec2<value_type>> vertices{};
+};
+
+/**
+ * @brief A moving obstacle given as an oriented box whose predicted poses are sampled at
+ * increasing times. Poses are interpolated between samples and held outside the prediction.
+ */
+template <std::floating_point T>
+struct [[nodiscard]] DynamicObstacle2 final {
+    using value_type = T;
+    std::uint64_t id{std::numeric_limits<std::uint64_t>::quiet_NaN()};
+    value_type half_length{0.0};
+    value_type half_width{0.0};
+    std::vector<value_type> ts{};
+    std::vector<::boyle::math::Vec2<value_type>> centers{};
+    std::vector<value_type> headings{};
+};
+
+using StaticObstacle2f = StaticObstacle2<float>;
+using StaticObstacle2d = StaticObstacle2<double>;
+
+using DynamicObstacle2f = DynamicObstacle2<float>;
+using DynamicObstacle2d = DynamicObstacle2<double>;
+
+} // namespace boyle::kinetics
+
+namespace boost::serialization {
+
+[[using gnu: always_inline]]
+inline auto serialize(
+    auto& archive, boyle::math::InstanceOfTemplate<boyle::kinetics::StaticObstacle2> auto& obj,
+    [[maybe_unused]] const unsigned int version
+) noexcept -> void {
+    archive & obj.id;
+    archive & obj.vertices;
+    return;
+}
+
+[[using gnu: always_inline]]
+inline auto serialize(
+    auto& archive, boyle::math::InstanceOfTemplate<boyle::kinetics::DynamicObstacle2> auto& obj,
+    [[maybe_unused]] const unsigned int version
+) noexcept -> void {
+    archive & obj.id;
+    archive & obj.half_length;
+    archive & obj.half_width;
+    archive & obj.ts;
+    archive & obj.centers;
+    archive & obj.headings;
+    return;
+}
+
+} // namespace boost::serialization
@@ -14,23 +14,30 @@
 
 #include <array>
 #include <concepts>
+#include <memory>
 #include <utility>
 #include <vector>
 
 #include "boost/serialization/access.hpp"
 
 #include "boyle/math/curves/piecewise_quintic_curve.hpp"
+#include "boyle/math/flat_file.hpp"
 #include "boyle/math/vec2.hpp"
 
 namespace boyle::kinetics {
 
-template <std::floating_point T>
+template <std::floating_point T, typename Alloc = std::allocator<::boyle::math::Vec2<T>>>
 class [[nodiscard]] Path2 final {
     friend class boost::serialization::access;
 
   public:
-    using BoundaryMode =
-        typename ::boyle::math::PiecewiseQuinticCurve<::boyle::math::Vec2<T>>::BoundaryMode;
+    using allocator_type = Alloc;
+    using curve_type = ::boyle::math::PiecewiseQuinticCurve<::boyle::math::Vec2<T>, T, Alloc>;
+    using param_vector_type = typename curve_type::param_vector_type;
+    using value_vector_type = typename curve_type::value_vector_type;
+    using BoundaryMode = typename curve_type::BoundaryMode;
+
+    static constexpr ::boyle::math::FlatKind kFlatKind{::boyle::math::FlatKind::PATH2};
 
     Path2() noexcept = default;
     Path2(const Path2& other) noexcept = default;
@@ -40,7 +47,7 @@ class [[nodiscard]] Path2 final {
     ~Path2() noexcept = default;
 
     [[using gnu: always_inline]]
-    explicit Path2(std::vector<::boyle::math::Vec2<T>> anchor_points, T s0 = 0.0)
+    explicit Path2(value_vector_type anchor_points, T s0 = 0.0)
         : Path2{
               std::move(anchor_points),
               std::array<BoundaryMode, 2>{
@@ -56,11 +63,23 @@ class [[nodiscard]] Path2 final {
 
     [[using gnu: always_inline]]
     explicit Path2(
-        std::vector<::boyle::math::Vec2<T>> anchor_points, std::array<BoundaryMode, 2> b0,
+        value_vector_type anchor_points, std::array<BoundaryMode, 2> b0,
         std::array<BoundaryMode, 2> bf, T s0 = 0.0
     )
         : m_curve{anchor_points, b0, bf, s0} {}
 
+    /**
+     * @brief Builds the path from a spline over any parameter, e.g. the station samples of an
+     * offset model together with the optimized second and fourth derivatives.
+     */
+    [[using gnu: always_inline]]
+    explicit Path2(
+        const param_vector_type& ts, value_vector_type anchor_points,
+        const value_vector_type& dd_anchor_points, const value_vector_type& d4_anchor_points,
+        T s0 = 0.0
+    )
+        : m_curve{ts, std::move(anchor_points), dd_anchor_points, d4_anchor_points, s0} {}
+
     [[using gnu: pure, always_inline]]
     auto operator()(T s) const noexcept -> ::boyle::math::Vec2<T> {
         return m_curve(s);
@@ -102,6 +121,16 @@ class [[nodiscard]] Path2 final {
         return m_curve.curvature(s);
     }
 
+    [[using gnu: always_inline]]
+    auto minCurvature(T start_s, T end_s) const -> T {
+        return m_curve.minCurvature(start_s, end_s);
+    }
+
+    [[using gnu: always_inline]]
+    auto maxCurvature(T start_s, T end_s) const -> T {
+        return m_curve.maxCurvature(start_s, end_s);
+    }
+
     [[using gnu: pure, always_inline]]
     auto minS() const noexcept -> T {
         return m_curve.minS();
@@ -113,26 +142,61 @@ class [[nodiscard]] Path2 final {
     }
 
     [[using gnu: pure, always_inline]]
-    auto arcLengths() const noexcept -> const std::vector<T>& {
+    auto arcLengths() const noexcept -> const param_vector_type& {
         return m_curve.arcLengths();
     }
 
     [[using gnu: pure, always_inline]]
-    auto anchorPoints() const noexcept -> const std::vector<::boyle::math::Vec2<T>>& {
+    auto anchorPoints() const noexcept -> const value_vector_type& {
         return m_curve.anchorPoints();
     }
 
+    [[using gnu: pure, always_inline]]
+    auto ddAnchorPoints() const noexcept -> const value_vector_type& {
+        return m_curve.ddys();
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto d4AnchorPoints() const noexcept -> const value_vector_type& {
+        return m_curve.d4ys();
+    }
+
+    [[using gnu: always_inline]]
+    auto writeFlat(::boyle::math::FlatWriter& writer) const -> void {
+        m_curve.writeFlat(writer, kFlatKind);
+        return;
+    }
+
+    [[using gnu: always_inline]]
+    static auto fromFlat(const ::boyle::math::FlatRecord& record) -> Path2 {
+        return Path2{curve_type::fromFlat(record, kFlatKind)};
+    }
+
   private:
     [[using gnu: always_inline]]
-    auto serialize(auto& archive) noexcept -> void {
+    explicit Path2(curve_type curve) noexcept
+        : m_curve{std::move(curve)} {}
+
+    [[using gnu: always_inline]]
+    auto serialize(auto& archive, [[maybe_unused]] const unsigned int version) noexcept -> void {
         archive & m_curve;
         return;
     }
 
-    ::boyle::math::PiecewiseQuinticCurve<::boyle::math::Vec2<T>> m_curve{};
+    curve_type m_curve{};
 };
 
 using Path2f = Path2<float>;
 using Path2d = Path2<double>;
 
+namespace view {
+
+template <std::floating_point T>
+using Path2 = ::boyle::kinetics::Path2<T, ::boyle::math::ExternalStorage>;
+
+using Path2f = Path2<float>;
+using Path2d = Path2<double>;
+
+} // namespace view
+
 } // namespace boyle::kinetics
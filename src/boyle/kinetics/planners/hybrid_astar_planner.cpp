@@ -0,0 +1,569 @@
+/**
+ * @file hybrid_astar_planner.cpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2024-06-21
+ *
+ * @copyright Copyright (c) 2024 Boyle Development Team
+ *            All rights reserved.
+ *
+ */
+
+#include "boyle/kinetics/planners/hybrid_astar_planner.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include "fmt/format.h"
+
+#include "boyle/common/utils/logging.hpp"
+#include "boyle/common/utils/task_scheduler.hpp"
+
+namespace {
+
+[[using gnu: const, always_inline]] [[nodiscard]]
+inline auto wrapTwoPi(double angle) noexcept -> double {
+    const double wrapped{std::fmod(angle, 2.0 * std::numbers::pi)};
+    return wrapped < 0.0 ? wrapped + 2.0 * std::numbers::pi : wrapped;
+}
+
+constexpr std::size_t kShotChunkSize{64};
+
+constexpr auto kOpenGreater = [](const auto& lhs, const auto& rhs) noexcept -> bool {
+    return lhs.f > rhs.f;
+};
+
+} // namespace
+
+namespace boyle::kinetics {
+
+HybridAStarPlanner::HybridAStarPlanner(
+    const VehicleFootprint2d& footprint, double min_turning_radius
+) noexcept(!BOYLE_CHECK_PARAMS)
+    : HybridAStarPlanner{footprint, min_turning_radius, HybridAStarSettings{}} {}
+
+HybridAStarPlanner::HybridAStarPlanner(
+    const VehicleFootprint2d& footprint, double min_turning_radius,
+    const HybridAStarSettings& settings
+) noexcept(!BOYLE_CHECK_PARAMS)
+    : m_footprint{footprint}, m_min_turning_radius{min_turning_radius}, m_settings{settings} {
+#if BOYLE_CHECK_PARAMS == 1
+    if (min_turning_radius <= 0.0 || settings.xy_resolution <= 0.0 ||
+        settings.heading_resolution <= 0.0 || settings.step_length <= 0.0 ||
+        settings.collision_ds <= 0.0 || settings.num_steerings == 0 ||
+        settings.analytic_expansion_interval == 0 || settings.max_nodes == 0 ||
+        settings.heuristic_resolution <= 0.0) [[unlikely]] {
+        throw std::invalid_argument(fmt::format(
+            "Invalid arguments detected! The turning radius, resolutions, step lengths, intervals "
+            "and capacities must be positive: min_turning_radius = {0:.6f}, xy_resolution = "
+            "{1:.6f}, heading_resolution = {2:.6f}, step_length = {3:.6f}, collision_ds = {4:.6f}, "
+            "num_steerings = {5:d}, analytic_expansion_interval = {6:d}, max_nodes = {7:d}, "
+            "heuristic_resolution = {8:.6f}.",
+            min_turning_radius, settings.xy_resolution, settings.heading_resolution,
+            settings.step_length, settings.collision_ds, settings.num_steerings,
+            settings.analytic_expansion_interval, settings.max_nodes, settings.heuristic_resolution
+        ));
+    }
+#endif
+    m_num_headings = std::max<std::int64_t>(
+        1, std::lround(2.0 * std::numbers::pi / m_settings.heading_resolution)
+    );
+    m_nodes.reserve(m_settings.max_nodes);
+    m_open.reserve(m_settings.max_nodes);
+    m_best_nodes.reserve(m_settings.max_nodes);
+    m_pose_buffer.reserve(std::max(
+        static_cast<std::size_t>(std::ceil(m_settings.step_length / m_settings.collision_ds)) + 1,
+        kShotChunkSize
+    ));
+    buildReedsSheppTable();
+}
+
+auto HybridAStarPlanner::settings() const noexcept -> const HybridAStarSettings& {
+    return m_settings;
+}
+
+auto HybridAStarPlanner::setEnvironment(
+    const ::boyle::math::Aabb2d& bounds, std::vector<StaticObstacle2d> obstacles
+) noexcept(!BOYLE_CHECK_PARAMS) -> void {
+#if BOYLE_CHECK_PARAMS == 1
+    if (bounds.upper.x - bounds.lower.x < m_settings.xy_resolution ||
+        bounds.upper.y - bounds.lower.y < m_settings.xy_resolution) [[unlikely]] {
+        throw std::invalid_argument(fmt::format(
+            "Invalid arguments detected! The bounds must span at least one cell: lower = {0}, "
+            "upper = {1}.",
+            bounds.lower, bounds.upper
+        ));
+    }
+#endif
+    m_bounds = bounds;
+    m_num_x = static_cast<std::int64_t>(
+        std::ceil((bounds.upper.x - bounds.lower.x) / m_settings.xy_resolution)
+    );
+    m_num_y = static_cast<std::int64_t>(
+        std::ceil((bounds.upper.y - bounds.lower.y) / m_settings.xy_resolution)
+    );
+    m_occupancy.assign(m_num_x * m_num_y, 0);
+    m_holonomic_costs.resize(m_num_x * m_num_y);
+    m_holonomic_open.reserve(m_num_x * m_num_y);
+
+    // The reference point of a collision-free footprint keeps at least the shortest of its
+    // distances to the box edges from every obstacle; shrink that by the cell radius so the
+    // distances on the grid never overestimate.
+    const double resolution{m_settings.xy_resolution};
+    const double inflation{std::max(
+        std::min({m_footprint.half_width, m_footprint.front_length, m_footprint.rear_length}) -
+            resolution * std::numbers::sqrt2 * 0.5,
+        0.0
+    )};
+    for (const StaticObstacle2d& obstacle : obstacles) {
+        const ::boyle::math::Aabb2d box{
+            ::boyle::math::Aabb2d::of(obstacle.vertices).inflated(inflation)
+        };
+        const std::int64_t ix_begin{std::max<std::int64_t>(
+            0, static_cast<std::int64_t>(std::floor((box.lower.x - bounds.lower.x) / resolution))
+        )};
+        const std::int64_t ix_end{std::min<std::int64_t>(
+            m_num_x,
+            static_cast<std::int64_t>(std::ceil((box.upper.x - bounds.lower.x) / resolution))
+        )};
+        const std::int64_t iy_begin{std::max<std::int64_t>(
+            0, static_cast<std::int64_t>(std::floor((box.lower.y - bounds.lower.y) / resolution))
+        )};
+        const std::int64_t iy_end{std::min<std::int64_t>(
+            m_num_y,
+            static_cast<std::int64_t>(std::ceil((box.upper.y - bounds.lower.y) / resolution))
+        )};
+        for (std::int64_t iy{iy_begin}; iy < iy_end; ++iy) {
+            for (std::int64_t ix{ix_begin}; ix < ix_end; ++ix) {
+                const ::boyle::math::Vec2d center{
+                    bounds.lower.x + (ix + 0.5) * resolution,
+                    bounds.lower.y + (iy + 0.5) * resolution
+                };
+                if (::boyle::math::pointPolygonDistance<double>(center, obstacle.vertices) <
+                    inflation) {
+                    m_occupancy[iy * m_num_x + ix] = 1;
+                }
+            }
+        }
+    }
+    m_collision_checker = CollisionChecker2d{m_footprint, std::move(obstacles)};
+    return;
+}
+
+auto HybridAStarPlanner::plan(
+    ::boyle::math::Vec2d start, double start_heading, ::boyle::math::Vec2d goal,
+    double goal_heading
+) -> HybridAStarResult {
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point start_time{Clock::now()};
+    const std::chrono::duration<double> time_budget{m_settings.time_budget};
+    HybridAStarResult result;
+
+    if (m_num_x == 0 || !m_bounds.contains(start) || !m_bounds.contains(goal)) [[unlikely]] {
+        BOYLE_LOG_WARN(
+            "Invalid argument issue detected! The environment must be set and contain both "
+            "endpoints: start = {0}, goal = {1}.",
+            start, goal
+        );
+        return result;
+    }
+
+    const std::array<CollisionChecker2d::PoseSample, 2> endpoints{
+        CollisionChecker2d::PoseSample{
+            .s = 0.0,
+            .t = std::numeric_limits<double>::quiet_NaN(),
+            .position = start,
+            .heading = start_heading
+        },
+        CollisionChecker2d::PoseSample{
+            .s = 0.0,
+            .t = std::numeric_limits<double>::quiet_NaN(),
+            .position = goal,
+            .heading = goal_heading
+        }
+    };
+    if (!collisionFree(endpoints)) {
+        BOYLE_LOG_WARN("Hybrid A* start or goal pose is in collision.");
+        return result;
+    }
+
+    buildHolonomicTable(goal);
+    m_nodes.clear();
+    m_open.clear();
+    m_best_nodes.clear();
+
+    const Pose goal_pose{.position = goal, .heading = goal_heading};
+    const std::int64_t start_cell{cellOf(start.x, start.y, start_heading)};
+    m_nodes.push_back(Node{
+        .x = start.x,
+        .y = start.y,
+        .heading = start_heading,
+        .g = 0.0,
+        .parent = -1,
+        .steering = static_cast<int>(m_settings.num_steerings / 2),
+        .forward = true,
+        .closed = false,
+        .cell = start_cell
+    });
+    m_best_nodes.emplace(start_cell, 0);
+    pushOpen(heuristic(m_nodes.front(), goal_pose), 0);
+
+    const int num_steerings{static_cast<int>(m_settings.num_steerings)};
+    const int num_substeps{
+        static_cast<int>(std::ceil(m_settings.step_length / m_settings.collision_ds))
+    };
+    const double substep{m_settings.step_length / num_substeps};
+    const double max_curvature{1.0 / m_min_turning_radius};
+
+    while (!m_open.empty()) {
+        if ((result.num_expanded & 63) == 0 && Clock::now() - start_time > time_budget) {
+            BOYLE_LOG_WARN(
+                "Hybrid A* search ran out of its time budget after {0:d} expansions.",
+                result.num_expanded
+            );
+            return result;
+        }
+        const OpenEntry entry{popOpen()};
+        Node& current{m_nodes[entry.node]};
+        if (current.closed || m_best_nodes.at(current.cell) != entry.node) {
+            continue;
+        }
+        current.closed = true;
+        const Node node{current};
+        if (result.num_expanded++ % m_settings.analytic_expansion_interval == 0 &&
+            tryAnalyticExpansion(node, goal_pose)) {
+            result.found = true;
+            result.cost = node.g + m_shot.length();
+            reconstruct(entry.node, goal_pose, result);
+            return result;
+        }
+
+        for (const bool forward : {true, false}) {
+            const double direction{forward ? 1.0 : -1.0};
+            for (int steering{0}; steering < num_steerings; ++steering) {
+                const double ratio{
+                    num_steerings == 1 ? 0.0 : steering * 2.0 / (num_steerings - 1) - 1.0
+                };
+                const double curvature{ratio * max_curvature};
+                double x{node.x};
+                double y{node.y};
+                double heading{node.heading};
+                m_pose_buffer.clear();
+                bool inside{true};
+                for (int i{1}; i <= num_substeps; ++i) {
+                    const double length{substep * direction};
+                    if (std::abs(curvature) < ::boyle::math::kEpsilon) {
+                        x += length * std::cos(heading);
+                        y += length * std::sin(heading);
+                    } else {
+                        const double next_heading{heading + curvature * length};
+                        x += (std::sin(next_heading) - std::sin(heading)) / curvature;
+                        y += (std::cos(heading) - std::cos(next_heading)) / curvature;
+                        heading = next_heading;
+                    }
+                    if (!m_bounds.contains(::boyle::math::Vec2d{x, y})) {
+                        inside = false;
+                        break;
+                    }
+                    m_pose_buffer.push_back(CollisionChecker2d::PoseSample{
+                        .s = substep * i,
+                        .t = std::numeric_limits<double>::quiet_NaN(),
+                        .position = {x, y},
+                        .heading = heading
+                    });
+                }
+                if (!inside) {
+                    continue;
+                }
+                const std::int64_t cell{cellOf(x, y, heading)};
+                if (cell == node.cell) {
+                    continue;
+                }
+                double g{
+                    node.g + m_settings.step_length * (forward ? 1.0 : m_settings.reverse_penalty) +
+                    m_settings.step_length * m_settings.steering_penalty * std::abs(ratio)
+                };
+                if (node.parent >= 0) {
+                    if (forward != node.forward) {
+                        g += m_settings.gear_switch_penalty;
+                    }
+                    g += m_settings.steering_change_penalty * std::abs(steering - node.steering) *
+                         2.0 / std::max(num_steerings - 1, 1);
+                }
+                const auto it = m_best_nodes.find(cell);
+                if (it != m_best_nodes.end() &&
+                    (m_nodes[it->second].closed || m_nodes[it->second].g <= g)) {
+                    continue;
+                }
+                if (m_nodes.size() == m_settings.max_nodes) {
+                    continue;
+                }
+                if (!collisionFree(m_pose_buffer)) {
+                    continue;
+                }
+                const Node successor{
+                    .x = x,
+                    .y = y,
+                    .heading = heading,
+                    .g = g,
+                    .parent = entry.node,
+                    .steering = steering,
+                    .forward = forward,
+                    .closed = false,
+                    .cell = cell
+                };
+                const double h{heuristic(successor, goal_pose)};
+                if (!std::isfinite(h)) {
+                    continue;
+                }
+                const int index{static_cast<int>(m_nodes.size())};
+                m_nodes.push_back(successor);
+                m_best_nodes.insert_or_assign(cell, index);
+                pushOpen(g + h, index);
+            }
+        }
+    }
+    return result;
+}
+
+auto HybridAStarPlanner::buildReedsSheppTable() noexcept -> void {
+    const double range{m_settings.heuristic_range};
+    const double resolution{m_settings.heuristic_resolution};
+    m_rs_num_xy = 2 * static_cast<std::int64_t>(std::ceil(range / resolution)) + 1;
+    m_rs_num_headings = m_num_headings;
+    m_rs_table.resize(m_rs_num_xy * m_rs_num_xy * m_rs_num_headings);
+    const double offset{static_cast<double>(m_rs_num_xy / 2) * resolution};
+    const double heading_resolution{2.0 * std::numbers::pi / m_rs_num_headings};
+    ::boyle::common::TaskScheduler::getInstance()->parallelFor(
+        std::int64_t{0}, m_rs_num_headings,
+        [&](std::int64_t ih) -> void {
+            for (std::int64_t iy{0}; iy < m_rs_num_xy; ++iy) {
+                for (std::int64_t ix{0}; ix < m_rs_num_xy; ++ix) {
+                    const ::boyle::math::ReedsSheppPathd path{::boyle::math::reedsSheppPath(
+                        ::boyle::math::Vec2d{0.0, 0.0}, 0.0,
+                        ::boyle::math::Vec2d{ix * resolution - offset, iy * resolution - offset},
+                        ih * heading_resolution, m_min_turning_radius
+                    )};
+                    m_rs_table[(ih * m_rs_num_xy + iy) * m_rs_num_xy + ix] =
+                        static_cast<float>(path.length());
+                }
+            }
+        }
+    );
+    return;
+}
+
+auto HybridAStarPlanner::buildHolonomicTable(::boyle::math::Vec2d goal) noexcept -> void {
+    std::fill(
+        m_holonomic_costs.begin(), m_holonomic_costs.end(), std::numeric_limits<double>::infinity()
+    );
+    m_holonomic_open.clear();
+    const int goal_index{static_cast<int>(gridIndex(goal.x, goal.y))};
+    m_holonomic_costs[goal_index] = 0.0;
+    m_holonomic_open.push_back(OpenEntry{.f = 0.0, .node = goal_index});
+    const double straight{m_settings.xy_resolution};
+    const double diagonal{m_settings.xy_resolution * std::numbers::sqrt2};
+    while (!m_holonomic_open.empty()) {
+        std::ranges::pop_heap(m_holonomic_open, kOpenGreater);
+        const OpenEntry entry{m_holonomic_open.back()};
+        m_holonomic_open.pop_back();
+        if (entry.f > m_holonomic_costs[entry.node]) {
+            continue;
+        }
+        const std::int64_t ix{entry.node % m_num_x};
+        const std::int64_t iy{entry.node / m_num_x};
+        for (std::int64_t dy{-1}; dy <= 1; ++dy) {
+            for (std::int64_t dx{-1}; dx <= 1; ++dx) {
+                const std::int64_t nx{ix + dx};
+                const std::int64_t ny{iy + dy};
+                if ((dx == 0 && dy == 0) || nx < 0 || nx >= m_num_x || ny < 0 || ny >= m_num_y) {
+                    continue;
+                }
+                const int index{static_cast<int>(ny * m_num_x + nx)};
+                if (m_occupancy[index] != 0) {
+                    continue;
+                }
+                const double cost{entry.f + (dx != 0 && dy != 0 ? diagonal : straight)};
+                if (cost < m_holonomic_costs[index]) {
+                    m_holonomic_costs[index] = cost;
+                    m_holonomic_open.push_back(OpenEntry{.f = cost, .node = index});
+                    std::ranges::push_heap(m_holonomic_open, kOpenGreater);
+                }
+            }
+        }
+    }
+    return;
+}
+
+auto HybridAStarPlanner::heuristic(const Node& node, const Pose& goal) const noexcept -> double {
+    const double holonomic{m_holonomic_costs[gridIndex(node.x, node.y)]};
+    return std::max(holonomic, reedsSheppHeuristic(node, goal));
+}
+
+auto HybridAStarPlanner::reedsSheppHeuristic(const Node& node, const Pose& goal) const noexcept
+    -> double {
+    const ::boyle::math::Vec2d offset{
+        (goal.position - ::boyle::math::Vec2d{node.x, node.y}).rotate(-node.heading)
+    };
+    const double resolution{m_settings.heuristic_resolution};
+    const std::int64_t half{m_rs_num_xy / 2};
+    const std::int64_t ix{std::lround(offset.x / resolution) + half};
+    const std::int64_t iy{std::lround(offset.y / resolution) + half};
+    if (ix < 0 || ix >= m_rs_num_xy || iy < 0 || iy >= m_rs_num_xy) {
+        return offset.euclidean();
+    }
+    const std::int64_t ih{
+        std::lround(
+            wrapTwoPi(goal.heading - node.heading) / (2.0 * std::numbers::pi) * m_rs_num_headings
+        ) %
+        m_rs_num_headings
+    };
+    return m_rs_table[(ih * m_rs_num_xy + iy) * m_rs_num_xy + ix];
+}
+
+auto HybridAStarPlanner::cellOf(double x, double y, double heading) const noexcept
+    -> std::int64_t {
+    const std::int64_t ih{
+        static_cast<std::int64_t>(wrapTwoPi(heading) / m_settings.heading_resolution) %
+        m_num_headings
+    };
+    return ih * m_num_x * m_num_y + gridIndex(x, y);
+}
+
+auto HybridAStarPlanner::gridIndex(double x, double y) const noexcept -> std::int64_t {
+    const std::int64_t ix{std::clamp<std::int64_t>(
+        static_cast<std::int64_t>((x - m_bounds.lower.x) / m_settings.xy_resolution), 0,
+        m_num_x - 1
+    )};
+    const std::int64_t iy{std::clamp<std::int64_t>(
+        static_cast<std::int64_t>((y - m_bounds.lower.y) / m_settings.xy_resolution), 0,
+        m_num_y - 1
+    )};
+    return iy * m_num_x + ix;
+}
+
+auto HybridAStarPlanner::collisionFree(std::span<const CollisionChecker2d::PoseSample> poses
+) const noexcept -> bool {
+    return !m_collision_checker.check(poses, true).collided;
+}
+
+auto HybridAStarPlanner::tryAnalyticExpansion(const Node& node, const Pose& goal) noexcept
+    -> bool {
+    const ::boyle::math::Vec2d position{node.x, node.y};
+    m_shot = ::boyle::math::reedsSheppPath(
+        position, node.heading, goal.position, goal.heading, m_min_turning_radius
+    );
+    if (!m_shot.valid()) {
+        return false;
+    }
+    const double length{m_shot.length()};
+    const std::size_t num_samples{
+        static_cast<std::size_t>(std::ceil(length / m_settings.collision_ds)) + 1
+    };
+    std::size_t first{0};
+    while (first < num_samples) {
+        const std::size_t last{std::min(first + kShotChunkSize, num_samples)};
+        m_pose_buffer.clear();
+        for (std::size_t i{first}; i < last; ++i) {
+            const double s{std::min(m_settings.collision_ds * i, length)};
+            const ::boyle::math::ReedsSheppStated state{
+                ::boyle::math::reedsSheppState(m_shot, position, node.heading, s)
+            };
+            if (!m_bounds.contains(state.position)) {
+                return false;
+            }
+            m_pose_buffer.push_back(CollisionChecker2d::PoseSample{
+                .s = s,
+                .t = std::numeric_limits<double>::quiet_NaN(),
+                .position = state.position,
+                .heading = state.heading
+            });
+        }
+        if (!collisionFree(m_pose_buffer)) {
+            return false;
+        }
+        first = last;
+    }
+    return true;
+}
+
+auto HybridAStarPlanner::pushOpen(double f, int node) noexcept -> void {
+    m_open.push_back(OpenEntry{.f = f, .node = node});
+    std::ranges::push_heap(m_open, kOpenGreater);
+    return;
+}
+
+auto HybridAStarPlanner::popOpen() noexcept -> OpenEntry {
+    std::ranges::pop_heap(m_open, kOpenGreater);
+    const OpenEntry entry{m_open.back()};
+    m_open.pop_back();
+    return entry;
+}
+
+auto HybridAStarPlanner::reconstruct(
+    int last_node, const Pose& goal, HybridAStarResult& result
+) const noexcept -> void {
+    std::vector<int> chain;
+    for (int index{last_node}; index >= 0; index = m_nodes[index].parent) {
+        chain.push_back(index);
+    }
+    std::ranges::reverse(chain);
+
+    const auto append = [&result](::boyle::math::Vec2d point, double heading, bool forward) {
+        if (result.segments.empty()) {
+            result.segments.push_back(HybridAStarSegment{
+                .forward = forward, .sketch_points = {point}, .headings = {heading}
+            });
+            return;
+        }
+        HybridAStarSegment& segment{result.segments.back()};
+        if (segment.sketch_points.size() > 1 && segment.forward != forward) {
+            const ::boyle::math::Vec2d cusp{segment.sketch_points.back()};
+            const double cusp_heading{segment.headings.back()};
+            result.segments.push_back(HybridAStarSegment{
+                .forward = forward, .sketch_points = {cusp}, .headings = {cusp_heading}
+            });
+        }
+        HybridAStarSegment& current{result.segments.back()};
+        current.forward = forward;
+        if (current.sketch_points.back().euclideanTo(point) < ::boyle::math::kEpsilon) {
+            return;
+        }
+        current.sketch_points.push_back(point);
+        current.headings.push_back(heading);
+        return;
+    };
+
+    const Node& first{m_nodes[chain.front()]};
+    append(::boyle::math::Vec2d{first.x, first.y}, first.heading, true);
+    for (std::size_t i{1}; i < chain.size(); ++i) {
+        const Node& node{m_nodes[chain[i]]};
+        append(::boyle::math::Vec2d{node.x, node.y}, node.heading, node.forward);
+    }
+
+    const Node& last{m_nodes[last_node]};
+    const ::boyle::math::Vec2d position{last.x, last.y};
+    const double length{m_shot.length()};
+    const std::size_t num_samples{
+        static_cast<std::size_t>(std::ceil(length / m_settings.step_length))
+    };
+    for (std::size_t i{1}; i <= num_samples; ++i) {
+        const ::boyle::math::ReedsSheppStated state{::boyle::math::reedsSheppState(
+            m_shot, position, last.heading, std::min(m_settings.step_length * i, length)
+        )};
+        append(state.position, state.heading, state.forward);
+    }
+    if (!result.segments.empty()) {
+        HybridAStarSegment& segment{result.segments.back()};
+        segment.sketch_points.back() = goal.position;
+        segment.headings.back() = goal.heading;
+    }
+    return;
+}
+
+} // namespace boyle::kinetics
@@ -0,0 +1,156 @@
+/**
+ * @file hybrid_astar_planner.hpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2024-06-21
+ *
+ * @copyright Copyright (c) 2024 Boyle Development Team
+ *            All rights reserved.
+ *
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <numbers>
+#include <span>
+#include <vector>
+
+#include "boost/unordered/unordered_flat_map.hpp"
+
+#include "boyle/kinetics/collision_checker2.hpp"
+#include "boyle/kinetics/obstacle2.hpp"
+#include "boyle/math/geometry2.hpp"
+#include "boyle/math/reeds_shepp.hpp"
+#include "boyle/math/vec2.hpp"
+
+namespace boyle::kinetics {
+
+struct [[nodiscard]] HybridAStarSettings final {
+    double xy_resolution{0.3};
+    double heading_resolution{std::numbers::pi / 36.0};
+    double step_length{0.5};
+    double collision_ds{0.25};
+    std::size_t num_steerings{5};
+    double reverse_penalty{2.0};
+    double gear_switch_penalty{5.0};
+    double steering_penalty{0.2};
+    double steering_change_penalty{0.5};
+    // Goals are only reached by Reeds-Shepp shots, so the interval must be positive.
+    std::size_t analytic_expansion_interval{5};
+    std::size_t max_nodes{200000};
+    double time_budget{0.05};
+    double heuristic_range{10.0};
+    double heuristic_resolution{0.5};
+};
+
+/**
+ * @brief A piece of the planned path driven in one gear. Consecutive segments share the cusp
+ * point, and the sketch points are ordered along the motion so that each segment can be smoothed
+ * by RouteLineQuinticOffsetModel on its own.
+ */
+struct [[nodiscard]] HybridAStarSegment final {
+    bool forward{true};
+    std::vector<::boyle::math::Vec2d> sketch_points{};
+    std::vector<double> headings{};
+};
+
+struct [[nodiscard]] HybridAStarResult final {
+    bool found{false};
+    double cost{0.0};
+    std::size_t num_expanded{0};
+    std::vector<HybridAStarSegment> segments{};
+};
+
+/**
+ * @brief Hybrid A* search over (x, y, heading) cells with arc motion primitives in both gears.
+ * Nodes come from a pool and the open list is a binary heap on storage reserved up front, so a
+ * query does not allocate once the planner has warmed up. The heuristic is the maximum of an
+ * obstacle-aware 2D distance, computed per environment, and the obstacle-free Reeds-Shepp distance
+ * read from a table precomputed per vehicle. Every few expansions a Reeds-Shepp shot to the goal is
+ * tried and accepted when collision free.
+ */
+class [[nodiscard]] HybridAStarPlanner final {
+  public:
+    HybridAStarPlanner(const HybridAStarPlanner& other) noexcept = delete;
+    auto operator=(const HybridAStarPlanner& other) noexcept -> HybridAStarPlanner& = delete;
+    HybridAStarPlanner(HybridAStarPlanner&& other) noexcept = delete;
+    auto operator=(HybridAStarPlanner&& other) noexcept -> HybridAStarPlanner& = delete;
+    ~HybridAStarPlanner() noexcept = default;
+
+    explicit HybridAStarPlanner(
+        const VehicleFootprint2d& footprint, double min_turning_radius
+    ) noexcept(!BOYLE_CHECK_PARAMS);
+    explicit HybridAStarPlanner(
+        const VehicleFootprint2d& footprint, double min_turning_radius,
+        const HybridAStarSettings& settings
+    ) noexcept(!BOYLE_CHECK_PARAMS);
+    auto settings() const noexcept -> const HybridAStarSettings&;
+    auto setEnvironment(
+        const ::boyle::math::Aabb2d& bounds, std::vector<StaticObstacle2d> obstacles
+    ) noexcept(!BOYLE_CHECK_PARAMS) -> void;
+    auto plan(
+        ::boyle::math::Vec2d start, double start_heading, ::boyle::math::Vec2d goal,
+        double goal_heading
+    ) -> HybridAStarResult;
+
+  private:
+    struct Node final {
+        double x;
+        double y;
+        double heading;
+        double g;
+        int parent;
+        int steering;
+        bool forward;
+        bool closed;
+        std::int64_t cell;
+    };
+
+    struct OpenEntry final {
+        double f;
+        int node;
+    };
+
+    struct Pose final {
+        ::boyle::math::Vec2d position;
+        double heading;
+    };
+
+    auto buildReedsSheppTable() noexcept -> void;
+    auto buildHolonomicTable(::boyle::math::Vec2d goal) noexcept -> void;
+    auto heuristic(const Node& node, const Pose& goal) const noexcept -> double;
+    auto reedsSheppHeuristic(const Node& node, const Pose& goal) const noexcept -> double;
+    auto cellOf(double x, double y, double heading) const noexcept -> std::int64_t;
+    auto gridIndex(double x, double y) const noexcept -> std::int64_t;
+    auto collisionFree(std::span<const CollisionChecker2d::PoseSample> poses) const noexcept
+        -> bool;
+    auto tryAnalyticExpansion(const Node& node, const Pose& goal) noexcept -> bool;
+    auto pushOpen(double f, int node) noexcept -> void;
+    auto popOpen() noexcept -> OpenEntry;
+    auto reconstruct(int last_node, const Pose& goal, HybridAStarResult& result) const noexcept
+        -> void;
+
+    VehicleFootprint2d m_footprint{};
+    double m_min_turning_radius{1.0};
+    HybridAStarSettings m_settings{};
+    ::boyle::math::Aabb2d m_bounds{::boyle::math::Aabb2d::empty()};
+    CollisionChecker2d m_collision_checker{};
+    std::int64_t m_num_x{0};
+    std::int64_t m_num_y{0};
+    std::int64_t m_num_headings{0};
+    std::vector<std::uint8_t> m_occupancy{};
+    std::vector<double> m_holonomic_costs{};
+    std::vector<OpenEntry> m_holonomic_open{};
+    std::int64_t m_rs_num_xy{0};
+    std::int64_t m_rs_num_headings{0};
+    std::vector<float> m_rs_table{};
+    std::vector<Node> m_nodes{};
+    std::vector<OpenEntry> m_open{};
+    boost::unordered_flat_map<std::int64_t, int> m_best_nodes{};
+    std::vector<CollisionChecker2d::PoseSample> m_pose_buffer{};
+    ::boyle::math::ReedsSheppPathd m_shot{};
+};
+
+} // namespace boyle::kinetics
@@ -0,0 +1,273 @@
+/**
+ * @file route_distance_field2.hpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2024-06-17
+ *
+ * @copyright Copyright (c) 2024 Boyle Development Team
+ *            All rights reserved.
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "fmt/format.h"
+
+#include "boyle/common/utils/task_scheduler.hpp"
+#include "boyle/kinetics/border2.hpp"
+#include "boyle/kinetics/dualism.hpp"
+#include "boyle/kinetics/obstacle2.hpp"
+#include "boyle/kinetics/route_line2.hpp"
+#include "boyle/math/aabb_tree2.hpp"
+#include "boyle/math/duplet.hpp"
+#include "boyle/math/geometry2.hpp"
+#include "boyle/math/vec2.hpp"
+
+namespace boyle::kinetics {
+
+/**
+ * @brief Signed distance to the nearest hard border or static obstacle, sampled on a regular
+ * (s, l) grid in the frame of a route line. Distances are positive in free space and truncated at
+ * a fixed horizon. The l axis points to the left of the route, as in RouteLine2::toFrenet(). Border
+ * points are expected in the direction of the route; a left border keeps free space on its right
+ * and a right border on its left. Past the horizon the field saturates at -truncation on the
+ * blocked side of the nearest border, however far away that border is.
+ */
+template <std::floating_point T>
+class [[nodiscard]] RouteDistanceField2 final {
+  public:
+    RouteDistanceField2() noexcept = default;
+    RouteDistanceField2(const RouteDistanceField2& other) = default;
+    auto operator=(const RouteDistanceField2& other) -> RouteDistanceField2& = default;
+    RouteDistanceField2(RouteDistanceField2&& other) noexcept = default;
+    auto operator=(RouteDistanceField2&& other) noexcept -> RouteDistanceField2& = default;
+    ~RouteDistanceField2() noexcept = default;
+
+    [[using gnu: flatten]]
+    explicit RouteDistanceField2(
+        const RouteLine2<T>& route_line, T min_s, T max_s, T ds, T min_l, T max_l, T dl,
+        const std::vector<HardBorder2<T>>& hard_borders,
+        const std::vector<StaticObstacle2<T>>& obstacles = {}, T truncation = 5.0
+    ) noexcept(!BOYLE_CHECK_PARAMS)
+        : m_min_s{min_s}, m_min_l{min_l}, m_ds{ds}, m_dl{dl}, m_truncation{truncation} {
+#if BOYLE_CHECK_PARAMS == 1
+        if (ds <= 0.0 || dl <= 0.0 || max_s - min_s < ds || max_l - min_l < dl) [[unlikely]] {
+            throw std::invalid_argument(fmt::format(
+                "Invalid arguments detected! The grid must hold at least two samples along each "
+                "axis: min_s = {0:.6f}, max_s = {1:.6f}, ds = {2:.6f}, min_l = {3:.6f}, "
+                "max_l = {4:.6f}, dl = {5:.6f}.",
+                min_s, max_s, ds, min_l, max_l, dl
+            ));
+        }
+#endif
+        m_num_s = static_cast<std::size_t>(std::floor((max_s - min_s) / ds + 1E-8)) + 1;
+        m_num_l = static_cast<std::size_t>(std::floor((max_l - min_l) / dl + 1E-8)) + 1;
+        m_values.resize(m_num_s * m_num_l);
+
+        std::vector<Primitive> primitives;
+        std::vector<::boyle::math::Aabb2<T>> boxes;
+        for (std::size_t i{0}; i < hard_borders.size(); ++i) {
+            const std::vector<::boyle::math::Vec2<T>>& bound_points{hard_borders[i].bound_points};
+            for (std::size_t j{1}; j < bound_points.size(); ++j) {
+                primitives.push_back(
+                    Primitive{.kind = PrimitiveKind::BORDER, .index = i, .pos = j}
+                );
+                boxes.push_back(::boyle::math::Aabb2<T>::of(
+                    std::span<const ::boyle::math::Vec2<T>>{bound_points.data() + j - 1, 2}
+                ));
+            }
+        }
+        const std::size_t num_border_primitives{primitives.size()};
+        for (std::size_t i{0}; i < obstacles.size(); ++i) {
+            primitives.push_back(Primitive{.kind = PrimitiveKind::OBSTACLE, .index = i, .pos = 0});
+            boxes.push_back(::boyle::math::Aabb2<T>::of(obstacles[i].vertices));
+        }
+        const ::boyle::math::AabbTree2<T> tree{std::move(boxes)};
+
+        const std::int64_t num_s{static_cast<std::int64_t>(m_num_s)};
+        ::boyle::common::TaskScheduler::getInstance()->parallelFor(
+            std::int64_t{0}, num_s,
+            [&](std::int64_t i) -> void {
+                const T s{m_min_s + m_ds * static_cast<T>(i)};
+                const ::boyle::math::Vec2<T> origin{route_line(s)};
+                const ::boyle::math::Vec2<T> normal{route_line.tangent(s).rotateHalfPi()};
+                std::span<T> row{m_values.data() + i * m_num_l, m_num_l};
+                for (std::size_t j{0}; j < m_num_l; ++j) {
+                    const ::boyle::math::Vec2<T> point{
+                        origin + normal * (m_min_l + m_dl * static_cast<T>(j))
+                    };
+                    T distance{m_truncation};
+                    T border_distance{m_truncation};
+                    T unsigned_distance{std::numeric_limits<T>::max()};
+                    const auto visit = [&](std::size_t index) noexcept -> void {
+                        const Primitive& primitive{primitives[index]};
+                        if (primitive.kind == PrimitiveKind::OBSTACLE) {
+                            distance = std::min(
+                                distance, ::boyle::math::pointPolygonDistance<T>(
+                                              point, obstacles[primitive.index].vertices
+                                          )
+                            );
+                            return;
+                        }
+                        const HardBorder2<T>& border{hard_borders[primitive.index]};
+                        const ::boyle::math::Vec2<T> start{border.bound_points[primitive.pos - 1]};
+                        const ::boyle::math::Vec2<T> end{border.bound_points[primitive.pos]};
+                        const T segment_distance{
+                            ::boyle::math::pointSegmentDistance(point, start, end)
+                        };
+                        if (segment_distance < unsigned_distance) {
+                            unsigned_distance = segment_distance;
+                            const T side{(end - start).crossProj(point - start)};
+                            const bool free{
+                                border.chirality == Chirality::LEFT ? side <= 0.0 : side >= 0.0
+                            };
+                            border_distance = free ? segment_distance : -segment_distance;
+                        }
+                    };
+                    const ::boyle::math::Aabb2<T> probe{.lower = point, .upper = point};
+                    tree.query(probe.inflated(m_truncation), visit);
+                    if (num_border_primitives > 0 && unsigned_distance > m_truncation) {
+                        // No border lies within the horizon, but the side of the nearest one
+                        // still decides whether the point is free. Widen the query until a
+                        // border shows up, then once more to the ball it spans so that the
+                        // nearest segment is exact.
+                        T radius{std::max(m_truncation, T{1.0})};
+                        while (unsigned_distance == std::numeric_limits<T>::max()) {
+                            radius *= 2.0;
+                            tree.query(probe.inflated(radius), visit);
+                        }
+                        tree.query(probe.inflated(unsigned_distance), visit);
+                        border_distance = std::clamp(border_distance, -m_truncation, m_truncation);
+                    }
+                    row[j] = std::min(distance, border_distance);
+                }
+            }
+        );
+    }
+
+    [[using gnu: pure, flatten, hot]]
+    auto distance(T s, T l) const noexcept -> T {
+        const auto [i, j, u, v] = locate(s, l);
+        const T* const row{m_values.data() + i * m_num_l};
+        const T* const next_row{row + m_num_l};
+        return (1.0 - u) * ((1.0 - v) * row[j] + v * row[j + 1]) +
+               u * ((1.0 - v) * next_row[j] + v * next_row[j + 1]);
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto distance(::boyle::math::SlDuplet<T> sl) const noexcept -> T {
+        return distance(sl.s, sl.l);
+    }
+
+    [[using gnu: pure, flatten, hot]]
+    auto gradient(T s, T l) const noexcept -> ::boyle::math::SlDuplet<T> {
+        const auto [i, j, u, v] = locate(s, l);
+        const T* const row{m_values.data() + i * m_num_l};
+        const T* const next_row{row + m_num_l};
+        return ::boyle::math::SlDuplet<T>{
+            .s = ((1.0 - v) * (next_row[j] - row[j]) + v * (next_row[j + 1] - row[j + 1])) / m_ds,
+            .l = ((1.0 - u) * (row[j + 1] - row[j]) + u * (next_row[j + 1] - next_row[j])) / m_dl
+        };
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto gradient(::boyle::math::SlDuplet<T> sl) const noexcept -> ::boyle::math::SlDuplet<T> {
+        return gradient(sl.s, sl.l);
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto operator()(T s, T l) const noexcept -> T {
+        return distance(s, l);
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto minS() const noexcept -> T {
+        return m_min_s;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto maxS() const noexcept -> T {
+        return m_min_s + m_ds * static_cast<T>(m_num_s - 1);
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto minL() const noexcept -> T {
+        return m_min_l;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto maxL() const noexcept -> T {
+        return m_min_l + m_dl * static_cast<T>(m_num_l - 1);
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto numS() const noexcept -> std::size_t {
+        return m_num_s;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto numL() const noexcept -> std::size_t {
+        return m_num_l;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto truncation() const noexcept -> T {
+        return m_truncation;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto values() const noexcept -> const std::vector<T>& {
+        return m_values;
+    }
+
+  private:
+    enum class PrimitiveKind : std::uint8_t {
+        BORDER,
+        OBSTACLE
+    };
+
+    struct Primitive final {
+        PrimitiveKind kind;
+        std::size_t index;
+        std::size_t pos;
+    };
+
+    struct Location final {
+        std::size_t i;
+        std::size_t j;
+        T u;
+        T v;
+    };
+
+    [[using gnu: pure, always_inline, leaf]]
+    auto locate(T s, T l) const noexcept -> Location {
+        const T x{std::clamp((s - m_min_s) / m_ds, T{0.0}, static_cast<T>(m_num_s - 1))};
+        const T y{std::clamp((l - m_min_l) / m_dl, T{0.0}, static_cast<T>(m_num_l - 1))};
+        const std::size_t i{std::min(static_cast<std::size_t>(x), m_num_s - 2)};
+        const std::size_t j{std::min(static_cast<std::size_t>(y), m_num_l - 2)};
+        return Location{.i = i, .j = j, .u = x - static_cast<T>(i), .v = y - static_cast<T>(j)};
+    }
+
+    std::size_t m_num_s{0};
+    std::size_t m_num_l{0};
+    T m_min_s{0.0};
+    T m_min_l{0.0};
+    T m_ds{1.0};
+    T m_dl{1.0};
+    T m_truncation{5.0};
+    std::vector<T> m_values{};
+};
+
+using RouteDistanceField2f = RouteDistanceField2<float>;
+using RouteDistanceField2d = RouteDistanceField2<double>;
+
+} // namespace boyle::kinetics
@@ -12,25 +12,76 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <cmath>
 #include <concepts>
+#include <cstdint>
+#include <memory>
+#include <numbers>
+#include <span>
 #include <utility>
 #include <vector>
 
 #include "boost/serialization/access.hpp"
+#include "fmt/format.h"
 
+#include "boyle/common/utils/task_scheduler.hpp"
 #include "boyle/math/curves/piecewise_quintic_curve.hpp"
+#include "boyle/math/flat_file.hpp"
+#include "boyle/math/quintic_interpolation.hpp"
+#include "boyle/math/utils.hpp"
 #include "boyle/math/vec2.hpp"
 
 namespace boyle::kinetics {
 
+/**
+ * @brief Object states in Cartesian coordinates, one array per quantity.
+ */
 template <std::floating_point T>
+struct [[nodiscard]] CartesianStates2 final {
+    using value_type = T;
+    std::vector<value_type> xs{};
+    std::vector<value_type> ys{};
+    std::vector<value_type> headings{};
+    std::vector<value_type> curvatures{};
+    std::vector<value_type> velocities{};
+    std::vector<value_type> accels{};
+};
+
+/**
+ * @brief Object states in Frenet coordinates, one array per quantity: s, ds/dt, d2s/dt2, l,
+ * dl/ds and d2l/ds2.
+ */
+template <std::floating_point T>
+struct [[nodiscard]] FrenetStates2 final {
+    using value_type = T;
+    std::vector<value_type> ss{};
+    std::vector<value_type> dss{};
+    std::vector<value_type> ddss{};
+    std::vector<value_type> ls{};
+    std::vector<value_type> dls{};
+    std::vector<value_type> ddls{};
+};
+
+using CartesianStates2f = CartesianStates2<float>;
+using CartesianStates2d = CartesianStates2<double>;
+
+using FrenetStates2f = FrenetStates2<float>;
+using FrenetStates2d = FrenetStates2<double>;
+
+template <std::floating_point T, typename Alloc = std::allocator<::boyle::math::Vec2<T>>>
 class [[nodiscard]] RouteLine2 final {
     friend class boost::serialization::access;
 
   public:
-    using BoundaryMode =
-        typename ::boyle::math::PiecewiseQuinticCurve<::boyle::math::Vec2<T>>::BoundaryMode;
+    using allocator_type = Alloc;
+    using curve_type = ::boyle::math::PiecewiseQuinticCurve<::boyle::math::Vec2<T>, T, Alloc>;
+    using param_vector_type = typename curve_type::param_vector_type;
+    using value_vector_type = typename curve_type::value_vector_type;
+    using BoundaryMode = typename curve_type::BoundaryMode;
+
+    static constexpr ::boyle::math::FlatKind kFlatKind{::boyle::math::FlatKind::ROUTE_LINE2};
 
     RouteLine2() noexcept = default;
     RouteLine2(const RouteLine2& other) noexcept = default;
@@ -40,7 +91,7 @@ class [[nodiscard]] RouteLine2 final {
     ~RouteLine2() noexcept = default;
 
     [[using gnu: always_inline]]
-    explicit RouteLine2(std::vector<::boyle::math::Vec2<T>> anchor_points, T s0 = 0.0)
+    explicit RouteLine2(value_vector_type anchor_points, T s0 = 0.0)
         : RouteLine2{
               std::move(anchor_points),
               std::array<BoundaryMode, 2>{
@@ -56,7 +107,7 @@ class [[nodiscard]] RouteLine2 final {
 
     [[using gnu: always_inline]]
     explicit RouteLine2(
-        std::vector<::boyle::math::Vec2<T>> anchor_points, std::array<BoundaryMode, 2> b0,
+        value_vector_type anchor_points, std::array<BoundaryMode, 2> b0,
         std::array<BoundaryMode, 2> bf, T s0 = 0.0
     )
         : m_curve{anchor_points, b0, bf, s0} {}
@@ -98,7 +149,7 @@ class [[nodiscard]] RouteLine2 final {
     }
 
     [[using gnu: pure, always_inline]]
-    auto curvature(T s) -> T {
+    auto curvature(T s) const noexcept -> T {
         return m_curve.curvature(s);
     }
 
@@ -113,26 +164,240 @@ class [[nodiscard]] RouteLine2 final {
     }
 
     [[using gnu: pure, always_inline]]
-    auto arcLengths() const noexcept -> const std::vector<T>& {
+    auto arcLengths() const noexcept -> const param_vector_type& {
         return m_curve.arcLengths();
     }
 
     [[using gnu: pure, always_inline]]
-    auto anchorPoints() const noexcept -> const std::vector<::boyle::math::Vec2<T>>& {
+    auto anchorPoints() const noexcept -> const value_vector_type& {
         return m_curve.anchorPoints();
     }
 
+    /**
+     * @brief Converts full object states to Frenet coordinates, in parallel over objects. Each
+     * object is projected by Newton iterations started from hint_ss[i] when hints are given
+     * (typically last cycle's s), otherwise from a global inverse. The reference frame at the
+     * projection is evaluated once. Unlike inverse(), l is measured along the left-hand normal
+     * and the route curvature is signed, so l > 0 always lies on the left of the route.
+     */
+    [[using gnu: flatten, hot]]
+    auto toFrenet(
+        const CartesianStates2<T>& cartesian, FrenetStates2<T>& frenet,
+        std::span<const T> hint_ss = {}
+    ) const noexcept(!BOYLE_CHECK_PARAMS) -> void {
+        const std::size_t size{cartesian.xs.size()};
+#if BOYLE_CHECK_PARAMS == 1
+        if (cartesian.ys.size() != size || cartesian.headings.size() != size ||
+            cartesian.curvatures.size() != size || cartesian.velocities.size() != size ||
+            cartesian.accels.size() != size || (!hint_ss.empty() && hint_ss.size() != size))
+            [[unlikely]] {
+            throw std::invalid_argument(fmt::format(
+                "Invalid arguments detected! Cartesian state arrays and hints must have the same "
+                "size: xs.size() = {0:d}, hint_ss.size() = {1:d}.",
+                size, hint_ss.size()
+            ));
+        }
+#endif
+        frenet.ss.resize(size);
+        frenet.dss.resize(size);
+        frenet.ddss.resize(size);
+        frenet.ls.resize(size);
+        frenet.dls.resize(size);
+        frenet.ddls.resize(size);
+        const std::int64_t num_objects{static_cast<std::int64_t>(size)};
+        ::boyle::common::TaskScheduler::getInstance()->parallelFor(
+            std::int64_t{0}, num_objects,
+            [&](std::int64_t i) -> void {
+                const ::boyle::math::Vec2<T> point{cartesian.xs[i], cartesian.ys[i]};
+                const T s{project(point, hint_ss.empty() ? m_curve.inverse(point).s : hint_ss[i])};
+                const FrenetFrame frame{evalFrame(s)};
+                const ::boyle::math::Vec2<T> tangent{
+                    std::cos(frame.heading), std::sin(frame.heading)
+                };
+                const T l{tangent.crossProj(point - frame.point)};
+                const T one_minus_kl{1.0 - frame.curvature * l};
+                const T delta_theta{std::remainder(
+                    cartesian.headings[i] - frame.heading, 2.0 * std::numbers::pi_v<T>
+                )};
+                const T tan_delta_theta{std::tan(delta_theta)};
+                const T cos_delta_theta{std::cos(delta_theta)};
+                const T dl{one_minus_kl * tan_delta_theta};
+                const T kappa_dl{frame.dcurvature * l + frame.curvature * dl};
+                const T ds{cartesian.velocities[i] * cos_delta_theta / one_minus_kl};
+                const T delta_theta_prime{
+                    one_minus_kl / cos_delta_theta * cartesian.curvatures[i] - frame.curvature
+                };
+                frenet.ss[i] = s;
+                frenet.dss[i] = ds;
+                frenet.ddss[i] = (cartesian.accels[i] * cos_delta_theta -
+                                  ds * ds * (dl * delta_theta_prime - kappa_dl)) /
+                                 one_minus_kl;
+                frenet.ls[i] = l;
+                frenet.dls[i] = dl;
+                frenet.ddls[i] = -kappa_dl * tan_delta_theta +
+                                 one_minus_kl / (cos_delta_theta * cos_delta_theta) *
+                                     (cartesian.curvatures[i] * one_minus_kl / cos_delta_theta -
+                                      frame.curvature);
+            }
+        );
+        return;
+    }
+
+    /**
+     * @brief Converts Frenet object states back to Cartesian coordinates, in parallel over
+     * objects. This is the inverse of toFrenet() and uses the same left-hand frame.
+     */
+    [[using gnu: flatten, hot]]
+    auto toCartesian(const FrenetStates2<T>& frenet, CartesianStates2<T>& cartesian) const
+        noexcept(!BOYLE_CHECK_PARAMS) -> void {
+        const std::size_t size{frenet.ss.size()};
+#if BOYLE_CHECK_PARAMS == 1
+        if (frenet.dss.size() != size || frenet.ddss.size() != size || frenet.ls.size() != size ||
+            frenet.dls.size() != size || frenet.ddls.size() != size) [[unlikely]] {
+            throw std::invalid_argument(fmt::format(
+                "Invalid arguments detected! Frenet state arrays must have the same size: "
+                "ss.size() = {0:d}.",
+                size
+            ));
+        }
+#endif
+        cartesian.xs.resize(size);
+        cartesian.ys.resize(size);
+        cartesian.headings.resize(size);
+        cartesian.curvatures.resize(size);
+        cartesian.velocities.resize(size);
+        cartesian.accels.resize(size);
+        const std::int64_t num_objects{static_cast<std::int64_t>(size)};
+        ::boyle::common::TaskScheduler::getInstance()->parallelFor(
+            std::int64_t{0}, num_objects,
+            [&](std::int64_t i) -> void {
+                const FrenetFrame frame{evalFrame(frenet.ss[i])};
+                const T l{frenet.ls[i]};
+                const T dl{frenet.dls[i]};
+                const T ds{frenet.dss[i]};
+                const ::boyle::math::Vec2<T> tangent{
+                    std::cos(frame.heading), std::sin(frame.heading)
+                };
+                const ::boyle::math::Vec2<T> point{frame.point + tangent.rotateHalfPi() * l};
+                const T one_minus_kl{1.0 - frame.curvature * l};
+                const T delta_theta{std::atan2(dl, one_minus_kl)};
+                const T tan_delta_theta{dl / one_minus_kl};
+                const T cos_delta_theta{std::cos(delta_theta)};
+                const T kappa_dl{frame.dcurvature * l + frame.curvature * dl};
+                const T curvature{
+                    ((frenet.ddls[i] + kappa_dl * tan_delta_theta) * cos_delta_theta *
+                         cos_delta_theta / one_minus_kl +
+                     frame.curvature) *
+                    cos_delta_theta / one_minus_kl
+                };
+                const T delta_theta_prime{
+                    one_minus_kl / cos_delta_theta * curvature - frame.curvature
+                };
+                cartesian.xs[i] = point.x;
+                cartesian.ys[i] = point.y;
+                cartesian.headings[i] =
+                    std::remainder(frame.heading + delta_theta, 2.0 * std::numbers::pi_v<T>);
+                cartesian.curvatures[i] = curvature;
+                cartesian.velocities[i] = std::hypot(one_minus_kl * ds, dl * ds);
+                cartesian.accels[i] =
+                    frenet.ddss[i] * one_minus_kl / cos_delta_theta +
+                    ds * ds / cos_delta_theta * (dl * delta_theta_prime - kappa_dl);
+            }
+        );
+        return;
+    }
+
+    [[using gnu: always_inline]]
+    auto writeFlat(::boyle::math::FlatWriter& writer) const -> void {
+        m_curve.writeFlat(writer, kFlatKind);
+        return;
+    }
+
+    [[using gnu: always_inline]]
+    static auto fromFlat(const ::boyle::math::FlatRecord& record) -> RouteLine2 {
+        return RouteLine2{curve_type::fromFlat(record, kFlatKind)};
+    }
+
   private:
     [[using gnu: always_inline]]
-    auto serialize(auto& archive) noexcept -> void {
+    explicit RouteLine2(curve_type curve) noexcept
+        : m_curve{std::move(curve)} {}
+
+    struct FrenetFrame final {
+        ::boyle::math::Vec2<T> point;
+        T heading;
+        T curvature;
+        T dcurvature;
+    };
+
+    static constexpr std::size_t kNumProjectionIters{8};
+
+    [[using gnu: pure, flatten, hot]]
+    auto evalDerivatives(T s) const noexcept -> std::array<::boyle::math::Vec2<T>, 4> {
+        const param_vector_type& arc_lengths{m_curve.arcLengths()};
+        const std::size_t pos =
+            ::boyle::math::nearestUpperElement(
+                std::ranges::subrange{arc_lengths.cbegin(), arc_lengths.cend()}, s
+            ) -
+            arc_lengths.cbegin();
+        return ::boyle::math::quinerpSegment(
+            arc_lengths, m_curve.anchorPoints(), m_curve.ddys(), m_curve.d4ys(), pos, s
+        );
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto evalFrame(T s) const noexcept -> FrenetFrame {
+        const auto [val, derivative, derivative2, derivative3] = evalDerivatives(s);
+        const T norm_sqr{derivative.euclideanSqr()};
+        const T norm{std::sqrt(norm_sqr)};
+        const T cross{derivative.crossProj(derivative2)};
+        return FrenetFrame{
+            .point = val,
+            .heading = derivative.angle(),
+            .curvature = cross / (norm_sqr * norm),
+            .dcurvature = (derivative.crossProj(derivative3) * norm_sqr -
+                           3.0 * cross * derivative.dot(derivative2)) /
+                          (norm_sqr * norm_sqr * norm)
+        };
+    }
+
+    [[using gnu: pure, flatten]]
+    auto project(::boyle::math::Vec2<T> point, T s) const noexcept -> T {
+        for (std::size_t num_iter{kNumProjectionIters}; num_iter != 0U; --num_iter) {
+            const auto [val, derivative, derivative2, derivative3] = evalDerivatives(s);
+            const ::boyle::math::Vec2<T> r{val - point};
+            const T norm_sqr{derivative.euclideanSqr()};
+            const T step{
+                r.dot(derivative) / std::max(norm_sqr + r.dot(derivative2), norm_sqr * 0.5)
+            };
+            s -= step;
+            if (std::abs(step) < ::boyle::math::kEpsilon) {
+                break;
+            }
+        }
+        return s;
+    }
+
+    [[using gnu: always_inline]]
+    auto serialize(auto& archive, [[maybe_unused]] const unsigned int version) noexcept -> void {
         archive & m_curve;
         return;
     }
 
-    ::boyle::math::PiecewiseQuinticCurve<::boyle::math::Vec2<T>> m_curve{};
+    curve_type m_curve{};
 };
 
 using RouteLine2f = RouteLine2<float>;
 using RouteLine2d = RouteLine2<double>;
 
+namespace view {
+
+template <std::floating_point T>
+using RouteLine2 = ::boyle::kinetics::RouteLine2<T, ::boyle::math::ExternalStorage>;
+
+using RouteLine2f = RouteLine2<float>;
+using RouteLine2d = RouteLine2<double>;
+
+} // namespace view
+
 } // namespace boyle::kinetics
@@ -0,0 +1,248 @@
+/**
+ * @file trajectory2.hpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2024-06-12
+ *
+ * @copyright Copyright (c) 2024 Boyle Development Team
+ *            All rights reserved.
+ *
+ */
+
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "boost/serialization/access.hpp"
+#include "fmt/format.h"
+
+#include "boyle/kinetics/motion1.hpp"
+#include "boyle/kinetics/path2.hpp"
+#include "boyle/math/concepts.hpp"
+#include "boyle/math/quintic_interpolation.hpp"
+#include "boyle/math/utils.hpp"
+#include "boyle/math/vec2.hpp"
+
+namespace boyle::kinetics {
+
+template <std::floating_point T>
+struct [[nodiscard]] TrajectoryState2 final {
+    T t;
+    T s;
+    T x;
+    T y;
+    T heading;
+    T curvature;
+    T velocity;
+    T accel;
+};
+
+using TrajectoryState2f = TrajectoryState2<float>;
+using TrajectoryState2d = TrajectoryState2<double>;
+
+template <std::floating_point T>
+class [[nodiscard]] Trajectory2 final {
+    friend class boost::serialization::access;
+
+  public:
+    using State = TrajectoryState2<T>;
+
+    Trajectory2() noexcept = default;
+    Trajectory2(const Trajectory2& other) noexcept = default;
+    auto operator=(const Trajectory2& other) noexcept -> Trajectory2& = default;
+    Trajectory2(Trajectory2&& other) noexcept = default;
+    auto operator=(Trajectory2&& other) noexcept -> Trajectory2& = default;
+    ~Trajectory2() noexcept = default;
+
+    [[using gnu: always_inline]]
+    explicit Trajectory2(Path2<T> path, Motion1<T> motion) noexcept
+        : m_path{std::move(path)}, m_motion{std::move(motion)} {}
+
+    /**
+     * @brief Evaluates the full state at time t with one knot search on each of s(t) and r(s).
+     * The curvature is signed, positive when the path turns counter-clockwise.
+     */
+    [[using gnu: pure, flatten, hot]]
+    auto stateAt(T t) const noexcept -> State {
+        const std::size_t t_pos =
+            ::boyle::math::nearestUpperElement(
+                std::ranges::subrange{m_motion.ts().cbegin(), m_motion.ts().cend()}, t
+            ) -
+            m_motion.ts().cbegin();
+        const std::array<T, 3> motion_state{processMotion(t_pos, t)};
+        const std::vector<T>& arc_lengths{m_path.arcLengths()};
+        const std::size_t s_pos =
+            ::boyle::math::nearestUpperElement(
+                std::ranges::subrange{arc_lengths.cbegin(), arc_lengths.cend()}, motion_state[0]
+            ) -
+            arc_lengths.cbegin();
+        return makeState(t, motion_state, processPath(s_pos, motion_state[0]));
+    }
+
+    /**
+     * @brief Samples n states at t0, t0 + dt, ... into states. The knot cursors on t and s are
+     * carried from one sample to the next, so a sweep costs O(n + knots) instead of O(n log knots).
+     */
+    [[using gnu: flatten, hot]]
+    auto sample(T t0, T dt, std::size_t n, std::span<State> states) const
+        noexcept(!BOYLE_CHECK_PARAMS) -> void {
+#if BOYLE_CHECK_PARAMS == 1
+        if (states.size() < n) [[unlikely]] {
+            throw std::invalid_argument(fmt::format(
+                "Invalid arguments detected! The output span is too small for the requested "
+                "samples: states.size() = {0:d}, n = {1:d}.",
+                states.size(), n
+            ));
+        }
+#endif
+        const std::vector<T>& ts{m_motion.ts()};
+        const std::vector<T>& arc_lengths{m_path.arcLengths()};
+        std::size_t t_pos{0};
+        std::size_t s_pos{0};
+        for (std::size_t i{0}; i < n; ++i) {
+            const T t{t0 + dt * static_cast<T>(i)};
+            t_pos = advanceCursor(ts, t, t_pos);
+            const std::array<T, 3> motion_state{processMotion(t_pos, t)};
+            s_pos = advanceCursor(arc_lengths, motion_state[0], s_pos);
+            states[i] = makeState(t, motion_state, processPath(s_pos, motion_state[0]));
+        }
+        return;
+    }
+
+    [[using gnu: always_inline]]
+    auto sample(T t0, T dt, std::size_t n) const noexcept -> std::vector<State> {
+        std::vector<State> states(n);
+        sample(t0, dt, n, std::span<State>{states});
+        return states;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto minT() const noexcept -> T {
+        return m_motion.minT();
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto maxT() const noexcept -> T {
+        return m_motion.maxT();
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto path() const noexcept -> const Path2<T>& {
+        return m_path;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto motion() const noexcept -> const Motion1<T>& {
+        return m_motion;
+    }
+
+  private:
+    struct PathState final {
+        ::boyle::math::Vec2<T> val;
+        ::boyle::math::Vec2<T> derivative;
+        ::boyle::math::Vec2<T> derivative2;
+    };
+
+    [[using gnu: pure, always_inline, leaf]]
+    static auto advanceCursor(const std::vector<T>& knots, T x, std::size_t pos) noexcept
+        -> std::size_t {
+        const std::size_t size{knots.size()};
+        while (pos > 0 && knots[pos - 1] - x > ::boyle::math::kEpsilon) {
+            --pos;
+        }
+        while (pos < size && knots[pos] - x <= ::boyle::math::kEpsilon) {
+            ++pos;
+        }
+        if (pos == size && x - knots[size - 1] < ::boyle::math::kEpsilon) {
+            pos = size - 1;
+        }
+        return pos;
+    }
+
+    template <::boyle::math::GeneralArithmetic U>
+    [[using gnu: pure, always_inline, hot]]
+    static auto processSegment(
+        const std::vector<T>& knots, const std::vector<U>& ys, const std::vector<U>& ddys,
+        const std::vector<U>& d4ys, std::size_t pos, T x
+    ) noexcept -> std::array<U, 3> {
+        const std::array<U, 4> derivatives{
+            ::boyle::math::quinerpSegment(knots, ys, ddys, d4ys, pos, x)
+        };
+        return {derivatives[0], derivatives[1], derivatives[2]};
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto processMotion(std::size_t pos, T t) const noexcept -> std::array<T, 3> {
+        return processSegment(
+            m_motion.ts(), m_motion.ss(), m_motion.ddss(), m_motion.d4ss(), pos, t
+        );
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto processPath(std::size_t pos, T s) const noexcept -> PathState {
+        const auto [val, derivative, derivative2] = processSegment(
+            m_path.arcLengths(), m_path.anchorPoints(), m_path.ddAnchorPoints(),
+            m_path.d4AnchorPoints(), pos, s
+        );
+        return PathState{.val = val, .derivative = derivative, .derivative2 = derivative2};
+    }
+
+    [[using gnu: pure, always_inline]]
+    static auto makeState(
+        T t, const std::array<T, 3>& motion_state, const PathState& path_state
+    ) noexcept -> State {
+        const T derivative_norm{path_state.derivative.euclidean()};
+        return State{
+            .t = t,
+            .s = motion_state[0],
+            .x = path_state.val.x,
+            .y = path_state.val.y,
+            .heading = path_state.derivative.angle(),
+            .curvature = path_state.derivative.crossProj(path_state.derivative2) /
+                         (derivative_norm * derivative_norm * derivative_norm),
+            .velocity = motion_state[1],
+            .accel = motion_state[2]
+        };
+    }
+
+    [[using gnu: always_inline]]
+    auto serialize(auto& archive, [[maybe_unused]] const unsigned int version) noexcept -> void {
+        archive & m_path;
+        archive & m_motion;
+        return;
+    }
+
+    Path2<T> m_path{};
+    Motion1<T> m_motion{};
+};
+
+using Trajectory2f = Trajectory2<float>;
+using Trajectory2d = Trajectory2<double>;
+
+} // namespace boyle::kinetics
+
+namespace boost::serialization {
+
+[[using gnu: always_inline]]
+inline auto serialize(
+    auto& archive, boyle::math::InstanceOfTemplate<boyle::kinetics::TrajectoryState2> auto& obj,
+    [[maybe_unused]] const unsigned int version
+) noexcept -> void {
+    archive & obj.t;
+    archive & obj.s;
+    archive & obj.x;
+    archive & obj.y;
+    archive & obj.heading;
+    archive & obj.curvature;
+    archive & obj.velocity;
+    archive & obj.accel;
+    return;
+}
+
+} // namespace boost::serialization
@@ -0,0 +1,145 @@
+/**
+ * @file aabb_tree2.hpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2024-06-14
+ *
+ * @copyright Copyright (c) 2024 Boyle Development Team
+ *            All rights reserved.
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "boyle/math/geometry2.hpp"
+
+namespace boyle::math {
+
+/**
+ * @brief Static bounding volume hierarchy over axis aligned boxes. Nodes are stored flat in
+ * depth-first order so that the left child of a node immediately follows it.
+ */
+template <std::floating_point T>
+class [[nodiscard]] AabbTree2 final {
+  public:
+    AabbTree2() noexcept = default;
+    AabbTree2(const AabbTree2& other) = default;
+    auto operator=(const AabbTree2& other) -> AabbTree2& = default;
+    AabbTree2(AabbTree2&& other) noexcept = default;
+    auto operator=(AabbTree2&& other) noexcept -> AabbTree2& = default;
+    ~AabbTree2() noexcept = default;
+
+    [[using gnu: always_inline]]
+    explicit AabbTree2(std::vector<Aabb2<T>> boxes)
+        : m_boxes{std::move(boxes)} {
+        if (m_boxes.empty()) {
+            return;
+        }
+        m_indices.resize(m_boxes.size());
+        std::iota(m_indices.begin(), m_indices.end(), 0);
+        m_nodes.reserve(m_boxes.size() * 2 / kLeafSize + 1);
+        build(0, static_cast<std::uint32_t>(m_boxes.size()));
+    }
+
+    /**
+     * @brief Calls visitor(index) for every stored box that overlaps the query box.
+     */
+    template <typename Visitor>
+    [[using gnu: flatten, hot]]
+    auto query(const Aabb2<T>& box, Visitor&& visitor) const noexcept -> void {
+        if (m_nodes.empty()) {
+            return;
+        }
+        std::array<std::uint32_t, kMaxDepth> stack;
+        std::size_t top{0};
+        stack[top++] = 0;
+        while (top > 0) {
+            const Node& node{m_nodes[stack[--top]]};
+            if (!node.box.overlaps(box)) {
+                continue;
+            }
+            if (node.count > 0) {
+                for (std::uint32_t i{node.first}; i < node.first + node.count; ++i) {
+                    if (m_boxes[m_indices[i]].overlaps(box)) {
+                        visitor(m_indices[i]);
+                    }
+                }
+                continue;
+            }
+            stack[top++] = node.right;
+            stack[top++] = static_cast<std::uint32_t>(&node - m_nodes.data()) + 1;
+        }
+        return;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto size() const noexcept -> std::size_t {
+        return m_boxes.size();
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto boxes() const noexcept -> const std::vector<Aabb2<T>>& {
+        return m_boxes;
+    }
+
+  private:
+    static constexpr std::uint32_t kLeafSize{4};
+    static constexpr std::size_t kMaxDepth{64};
+
+    struct Node final {
+        Aabb2<T> box;
+        std::uint32_t first;
+        std::uint32_t count;
+        std::uint32_t right;
+    };
+
+    auto build(std::uint32_t first, std::uint32_t last) -> std::uint32_t {
+        const std::uint32_t index{static_cast<std::uint32_t>(m_nodes.size())};
+        Aabb2<T> box{Aabb2<T>::empty()};
+        Aabb2<T> centroids{Aabb2<T>::empty()};
+        for (std::uint32_t i{first}; i < last; ++i) {
+            const Aabb2<T>& item{m_boxes[m_indices[i]]};
+            const Vec2<T> center{item.center()};
+            box = box.merged(item);
+            centroids = centroids.merged(Aabb2<T>{.lower = center, .upper = center});
+        }
+        m_nodes.push_back(Node{.box = box, .first = first, .count = last - first, .right = 0});
+        if (last - first <= kLeafSize) {
+            return index;
+        }
+        const bool split_x{
+            centroids.upper.x - centroids.lower.x >= centroids.upper.y - centroids.lower.y
+        };
+        const std::uint32_t mid{first + (last - first) / 2};
+        std::nth_element(
+            m_indices.begin() + first, m_indices.begin() + mid, m_indices.begin() + last,
+            [this, split_x](std::size_t lhs, std::size_t rhs) noexcept -> bool {
+                const Vec2<T> lhs_center{m_boxes[lhs].center()};
+                const Vec2<T> rhs_center{m_boxes[rhs].center()};
+                return split_x ? lhs_center.x < rhs_center.x : lhs_center.y < rhs_center.y;
+            }
+        );
+        m_nodes[index].count = 0;
+        build(first, mid);
+        m_nodes[index].right = build(mid, last);
+        return index;
+    }
+
+    std::vector<Node> m_nodes{};
+    std::vector<std::size_t> m_indices{};
+    std::vector<Aabb2<T>> m_boxes{};
+};
+
+using AabbTree2f = AabbTree2<float>;
+using AabbTree2d = AabbTree2<double>;
+
+} // namespace boyle::math
@@ -16,6 +16,7 @@
 #include <concepts>
 
 #include "boyle/math/concepts.hpp"
+#include "boyle/math/polynomial.hpp"
 #include "boyle/math/utils.hpp"
 
 namespace boyle::math {
@@ -75,6 +76,24 @@ inline constexpr auto cuberpdCoeffs(T ratio, T scale = 1.0) noexcept -> std::arr
     };
 }
 
+/**
+ * @brief Monomial coefficients in ratio of the segment cuberp interpolates, in ascending order.
+ */
+template <GeneralArithmetic T, std::floating_point U = double>
+[[using gnu: const, always_inline]] [[nodiscard]]
+inline constexpr auto cuberpPoly(T start, T end, T ddstart, T ddend, U scale = 1.0) noexcept
+    -> std::array<T, 4> {
+    constexpr std::array<U, 4> kEndFactors{0.0, -(1.0 / 6.0), 0.0, 1.0 / 6.0};
+    constexpr std::array<U, 4> kStartFactors{polyreflect(kEndFactors)};
+    const U scale2{scale * scale};
+    std::array<T, 4> result;
+    result[0] = start;
+    result[1] = end - start + (ddstart * kStartFactors[1] + ddend * kEndFactors[1]) * scale2;
+    result[2] = ddstart * kStartFactors[2] * scale2;
+    result[3] = (ddstart * kStartFactors[3] + ddend * kEndFactors[3]) * scale2;
+    return result;
+}
+
 template <VecArithmetic T>
 [[using gnu: const, flatten, leaf, hot]]
 inline constexpr auto calcArcLength(
@@ -0,0 +1,667 @@
+/**
+ * @file bspline_curve.hpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2024-06-24
+ *
+ * @copyright Copyright (c) 2024 Boyle Development Team
+ *            All rights reserved.
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "boost/serialization/access.hpp"
+#include "boost/serialization/vector.hpp"
+#include "fmt/format.h"
+
+#include "boyle/math/concepts.hpp"
+#include "boyle/math/curves/piecewise_cubic_curve.hpp"
+#include "boyle/math/curves/piecewise_quintic_curve.hpp"
+#include "boyle/math/duplet.hpp"
+#include "boyle/math/utils.hpp"
+#include "boyle/math/vec2.hpp"
+#include "boyle/math/vec3.hpp"
+
+namespace boyle::math {
+
+/**
+ * @brief Polynomial B-spline curve of the given degree over a clamped knot vector. Unlike the
+ * interpolating piecewise curves, every control point only has support on Degree + 1 knot spans,
+ * so moving one of them re-evaluates a bounded part of the curve instead of solving a global
+ * system. The curve is parametrized by its spline parameter internally; an arc-length table
+ * sampled at kNumSamplesPerSpan points per span maps the arc length s used by the public
+ * interface onto that parameter.
+ */
+template <VecArithmetic T, std::size_t Degree = 3, std::floating_point U = typename T::value_type>
+class [[nodiscard]] BSplineCurve final {
+    friend class boost::serialization::access;
+
+  public:
+    using value_type = T;
+    using param_type = U;
+
+    static constexpr std::size_t kDegree{Degree};
+    static constexpr std::size_t kOrder{Degree + 1};
+    static constexpr std::size_t kNumSamplesPerSpan{4};
+
+    static_assert(Degree >= 1, "The degree of a B-spline curve must be at least one.");
+
+    BSplineCurve() noexcept = default;
+    BSplineCurve(const BSplineCurve& other) noexcept = default;
+    auto operator=(const BSplineCurve& other) noexcept -> BSplineCurve& = default;
+    BSplineCurve(BSplineCurve&& other) noexcept = default;
+    auto operator=(BSplineCurve&& other) noexcept -> BSplineCurve& = default;
+    ~BSplineCurve() noexcept = default;
+
+    /**
+     * @brief Uniform B-spline with clamped ends, so that the curve starts at the first control
+     * point and stops at the last one.
+     */
+    [[using gnu: ]]
+    explicit BSplineCurve(std::vector<value_type> control_points, param_type s0 = 0.0) noexcept(
+        !BOYLE_CHECK_PARAMS
+    ) {
+#if BOYLE_CHECK_PARAMS == 1
+        if (control_points.size() < kOrder) [[unlikely]] {
+            throw std::invalid_argument(fmt::format(
+                "Invalid arguments detected! sizes of control_points must be at least Degree + 1: "
+                "control_points.size() = {0:d}, Degree = {1:d}",
+                control_points.size(), Degree
+            ));
+        }
+#endif
+        const std::size_t size{control_points.size()};
+        m_knots.reserve(size + kOrder);
+        for (std::size_t i{0}; i < size + kOrder; ++i) {
+            m_knots.push_back(static_cast<param_type>(
+                std::clamp<std::size_t>(i, Degree, size) - Degree
+            ));
+        }
+        m_control_points = std::move(control_points);
+        buildArcLengthTable(s0);
+    }
+
+    [[using gnu: ]]
+    explicit BSplineCurve(
+        std::vector<value_type> control_points, std::vector<param_type> knots, param_type s0 = 0.0
+    ) noexcept(!BOYLE_CHECK_PARAMS) {
+#if BOYLE_CHECK_PARAMS == 1
+        if (control_points.size() < kOrder || knots.size() != control_points.size() + kOrder)
+            [[unlikely]] {
+            throw std::invalid_argument(fmt::format(
+                "Invalid arguments detected! knots.size() must equal control_points.size() + "
+                "Degree + 1: control_points.size() = {0:d}, knots.size() = {1:d}, Degree = {2:d}",
+                control_points.size(), knots.size(), Degree
+            ));
+        }
+        if (!std::ranges::is_sorted(knots)) [[unlikely]] {
+            throw std::invalid_argument("Invalid arguments detected! knots must be non-decreasing."
+            );
+        }
+        if (knots[Degree] >= knots[control_points.size()]) [[unlikely]] {
+            throw std::invalid_argument(
+                "Invalid arguments detected! The parameter domain of knots must not be empty."
+            );
+        }
+#endif
+        m_knots = std::move(knots);
+        m_control_points = std::move(control_points);
+        buildArcLengthTable(s0);
+    }
+
+    /**
+     * @brief Exact conversion of a cubic spline, whose knots become the interior knots.
+     */
+    [[using gnu: ]]
+    explicit BSplineCurve(const PiecewiseCubicCurve<value_type, param_type>& curve) noexcept
+        requires(Degree == 3)
+    {
+        fromPiecewisePolynomial(curve);
+    }
+
+    /**
+     * @brief Exact conversion of a quintic spline, whose knots become the interior knots.
+     */
+    [[using gnu: ]]
+    explicit BSplineCurve(const PiecewiseQuinticCurve<value_type, param_type>& curve) noexcept
+        requires(Degree == 5)
+    {
+        fromPiecewisePolynomial(curve);
+    }
+
+    [[using gnu: pure, always_inline, hot]]
+    auto eval(param_type s) const noexcept -> value_type {
+        if (s < minS()) {
+            return front() + tangent(minS()) * (s - minS());
+        }
+        if (s > maxS()) {
+            return back() + tangent(maxS()) * (s - maxS());
+        }
+        return evalParam(paramOf(s));
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto eval(param_type s, param_type l) const noexcept -> value_type
+        requires InstanceOfTemplate<value_type, Vec2>
+    {
+        return eval(s) + normal(s) * l;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto eval(SlDuplet<param_type> sl) const noexcept -> value_type
+        requires InstanceOfTemplate<value_type, Vec2>
+    {
+        return eval(sl.s, sl.l);
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto tangent(param_type s) const noexcept -> value_type {
+        const param_type u{paramOf(std::clamp(s, minS(), maxS()))};
+        return derivatives<1>(u)[1].normalized();
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto normal(param_type s) const noexcept -> value_type
+        requires InstanceOfTemplate<value_type, Vec2>
+    {
+        return tangent(s).rotateHalfPi();
+    }
+
+    /**
+     * @brief Signed curvature for planar curves, its magnitude otherwise.
+     */
+    [[using gnu: pure, always_inline]]
+    auto curvature(param_type s) const noexcept -> param_type {
+        const param_type u{paramOf(std::clamp(s, minS(), maxS()))};
+        const std::array<value_type, 3> ders{derivatives<2>(u)};
+        const param_type speed{ders[1].euclidean()};
+        return ders[1].crossProj(ders[2]) / (speed * speed * speed);
+    }
+
+    [[using gnu: pure, flatten, hot]]
+    auto inverse(value_type point) const noexcept -> SlDuplet<param_type>
+        requires InstanceOfTemplate<value_type, Vec2>
+    {
+        constexpr param_type kTolerance{1E-12};
+        constexpr int kMaxIterations{16};
+        std::size_t nearest{0};
+        param_type min_distance{std::numeric_limits<param_type>::infinity()};
+        for (std::size_t i{0}; i < m_anchor_points.size(); ++i) {
+            const param_type distance{m_anchor_points[i].euclideanSqrTo(point)};
+            if (distance < min_distance) {
+                min_distance = distance;
+                nearest = i;
+            }
+        }
+        const param_type lower{m_params.front()};
+        const param_type upper{m_params.back()};
+        param_type u{m_params[nearest]};
+        std::array<value_type, 3> ders{derivatives<2>(u)};
+        for (int i{0}; i < kMaxIterations; ++i) {
+            const value_type r{ders[0] - point};
+            const param_type g{r.dot(ders[1])};
+            const param_type dg{ders[1].dot(ders[1]) + r.dot(ders[2])};
+            const param_type next{std::clamp(
+                u - g / (dg > 0.0 ? dg : ders[1].dot(ders[1])), lower, upper
+            )};
+            const bool converged{std::abs(next - u) < kTolerance * (upper - lower)};
+            u = next;
+            ders = derivatives<2>(u);
+            if (converged) {
+                break;
+            }
+        }
+        const value_type r{point - ders[0]};
+        const value_type tangent{ders[1].normalized()};
+        param_type s{arcLengthOf(u)};
+        const param_type ds{r.dot(tangent)};
+        if ((u == lower && ds < 0.0) || (u == upper && ds > 0.0)) {
+            s += ds;
+        }
+        return SlDuplet<param_type>{.s{s}, .l{r.dot(tangent.rotateHalfPi())}};
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto operator()(param_type s) const noexcept -> value_type {
+        return eval(s);
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto operator()(param_type s, param_type l) const noexcept -> value_type
+        requires InstanceOfTemplate<value_type, Vec2>
+    {
+        return eval(s, l);
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto operator()(SlDuplet<param_type> sl) const noexcept -> value_type
+        requires InstanceOfTemplate<value_type, Vec2>
+    {
+        return eval(sl);
+    }
+
+    /**
+     * @brief Evaluates the curve at the spline parameter u by de Boor's algorithm over the
+     * Degree + 1 control points of its knot span. All loops have compile-time trip counts.
+     */
+    [[using gnu: pure, flatten, hot]]
+    auto evalParam(param_type u) const noexcept -> value_type {
+        const std::size_t span{findSpan(u)};
+        std::array<value_type, kOrder> points;
+        for (std::size_t j{0}; j < kOrder; ++j) {
+            points[j] = m_control_points[span - Degree + j];
+        }
+        for (std::size_t r{1}; r < kOrder; ++r) {
+            for (std::size_t j{Degree}; j >= r; --j) {
+                const std::size_t i{span - Degree + j};
+                const param_type alpha{
+                    (u - m_knots[i]) / (m_knots[i + kOrder - r] - m_knots[i])
+                };
+                points[j] = points[j - 1] * (1.0 - alpha) + points[j] * alpha;
+            }
+        }
+        return points[Degree];
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto minS() const noexcept -> param_type {
+        return m_arc_lengths.front();
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto maxS() const noexcept -> param_type {
+        return m_arc_lengths.back();
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto front() const noexcept -> value_type {
+        return m_anchor_points.front();
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto back() const noexcept -> value_type {
+        return m_anchor_points.back();
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto arcLengths() const noexcept -> const std::vector<param_type>& {
+        return m_arc_lengths;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto anchorPoints() const noexcept -> const std::vector<value_type>& {
+        return m_anchor_points;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto params() const noexcept -> const std::vector<param_type>& {
+        return m_params;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto knots() const noexcept -> const std::vector<param_type>& {
+        return m_knots;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto controlPoints() const noexcept -> const std::vector<value_type>& {
+        return m_control_points;
+    }
+
+    /**
+     * @brief Moves one control point. Only the Degree + 1 spans supporting it are re-sampled and
+     * re-integrated; the arc lengths further down the curve are shifted by the change in length.
+     */
+    [[using gnu: ]]
+    auto setControlPoint(std::size_t pos, value_type point) noexcept(!BOYLE_CHECK_PARAMS)
+        -> void {
+#if BOYLE_CHECK_PARAMS == 1
+        if (pos >= m_control_points.size()) [[unlikely]] {
+            throw std::invalid_argument(fmt::format(
+                "Invalid arguments detected! pos is out of range: pos = {0:d}, "
+                "control_points.size() = {1:d}",
+                pos, m_control_points.size()
+            ));
+        }
+#endif
+        m_control_points[pos] = point;
+        const std::size_t lower =
+            std::ranges::lower_bound(m_params, m_knots[pos]) - m_params.cbegin();
+        const std::size_t upper =
+            std::ranges::upper_bound(m_params, m_knots[pos + kOrder]) - m_params.cbegin() - 1;
+        for (std::size_t i{lower}; i <= upper; ++i) {
+            m_anchor_points[i] = evalParam(m_params[i]);
+        }
+        const param_type old_end{m_arc_lengths[upper]};
+        for (std::size_t i{lower + 1}; i <= upper; ++i) {
+            m_arc_lengths[i] = m_arc_lengths[i - 1] + arcLength(m_params[i - 1], m_params[i]);
+        }
+        const param_type delta{m_arc_lengths[upper] - old_end};
+        for (std::size_t i{upper + 1}; i < m_arc_lengths.size(); ++i) {
+            m_arc_lengths[i] += delta;
+        }
+        return;
+    }
+
+    /**
+     * @brief Inserts the knot u once by Boehm's algorithm. The geometry is unchanged while Degree
+     * control points around u are replaced by Degree + 1 new ones.
+     */
+    [[using gnu: ]]
+    auto insertKnot(param_type u) noexcept(!BOYLE_CHECK_PARAMS) -> void {
+#if BOYLE_CHECK_PARAMS == 1
+        if (u < m_params.front() || u > m_params.back()) [[unlikely]] {
+            throw std::invalid_argument(fmt::format(
+                "Invalid arguments detected! u must lie in the parameter domain: u = {0:.6f}, "
+                "domain = [{1:.6f}, {2:.6f}]",
+                u, m_params.front(), m_params.back()
+            ));
+        }
+        if (std::ranges::count(m_knots, u) >= static_cast<std::ptrdiff_t>(Degree)) [[unlikely]] {
+            throw std::invalid_argument(fmt::format(
+                "Invalid arguments detected! Multiplicity of knot u would exceed the degree: "
+                "u = {0:.6f}",
+                u
+            ));
+        }
+#endif
+        const std::size_t span{findSpan(u)};
+        std::array<value_type, Degree> points;
+        for (std::size_t i{span - Degree + 1}; i <= span; ++i) {
+            const param_type alpha{(u - m_knots[i]) / (m_knots[i + Degree] - m_knots[i])};
+            points[i + Degree - 1 - span] =
+                m_control_points[i - 1] * (1.0 - alpha) + m_control_points[i] * alpha;
+        }
+        m_control_points.insert(m_control_points.cbegin() + span, value_type{});
+        std::ranges::copy(points, m_control_points.begin() + (span - Degree + 1));
+        m_knots.insert(m_knots.cbegin() + span + 1, u);
+        buildArcLengthTable(minS());
+        return;
+    }
+
+    [[using gnu: ]]
+    auto toPiecewiseCubicCurve() const noexcept -> PiecewiseCubicCurve<value_type, param_type> {
+        return PiecewiseCubicCurve<value_type, param_type>{m_anchor_points, minS()};
+    }
+
+    [[using gnu: ]]
+    auto toPiecewiseQuinticCurve() const noexcept
+        -> PiecewiseQuinticCurve<value_type, param_type> {
+        return PiecewiseQuinticCurve<value_type, param_type>{m_anchor_points, minS()};
+    }
+
+  private:
+    [[using gnu: pure, always_inline, hot]]
+    auto findSpan(param_type u) const noexcept -> std::size_t {
+        const std::size_t size{m_control_points.size()};
+        const auto it = std::upper_bound(
+            m_knots.cbegin() + Degree, m_knots.cbegin() + size, u
+        );
+        return std::clamp<std::size_t>(it - m_knots.cbegin(), kOrder, size) - 1;
+    }
+
+    /**
+     * @brief Curve derivatives up to order N at the spline parameter u, from the basis function
+     * derivatives of Piegl and Tiller, "The NURBS Book", algorithm A2.3.
+     */
+    template <std::size_t N>
+    [[using gnu: pure, flatten, hot]]
+    auto derivatives(param_type u) const noexcept -> std::array<value_type, N + 1> {
+        constexpr int p{static_cast<int>(Degree)};
+        constexpr int n{static_cast<int>(std::min(N, Degree))};
+        const std::size_t span{findSpan(u)};
+        std::array<std::array<param_type, kOrder>, kOrder> ndu;
+        std::array<param_type, kOrder> left;
+        std::array<param_type, kOrder> right;
+        ndu[0][0] = 1.0;
+        for (int j{1}; j <= p; ++j) {
+            left[j] = u - m_knots[span + 1 - j];
+            right[j] = m_knots[span + j] - u;
+            param_type saved{0.0};
+            for (int r{0}; r < j; ++r) {
+                ndu[j][r] = right[r + 1] + left[j - r];
+                const param_type temp{ndu[r][j - 1] / ndu[j][r]};
+                ndu[r][j] = saved + right[r + 1] * temp;
+                saved = left[j - r] * temp;
+            }
+            ndu[j][j] = saved;
+        }
+        std::array<std::array<param_type, kOrder>, N + 1> basis{};
+        for (int j{0}; j <= p; ++j) {
+            basis[0][j] = ndu[j][p];
+        }
+        std::array<std::array<param_type, kOrder>, 2> a;
+        for (int r{0}; r <= p; ++r) {
+            int s1{0};
+            int s2{1};
+            a[0][0] = 1.0;
+            for (int k{1}; k <= n; ++k) {
+                param_type d{0.0};
+                const int rk{r - k};
+                const int pk{p - k};
+                if (r >= k) {
+                    a[s2][0] = a[s1][0] / ndu[pk + 1][rk];
+                    d = a[s2][0] * ndu[rk][pk];
+                }
+                const int j1{rk >= -1 ? 1 : -rk};
+                const int j2{r - 1 <= pk ? k - 1 : p - r};
+                for (int j{j1}; j <= j2; ++j) {
+                    a[s2][j] = (a[s1][j] - a[s1][j - 1]) / ndu[pk + 1][rk + j];
+                    d += a[s2][j] * ndu[rk + j][pk];
+                }
+                if (r <= pk) {
+                    a[s2][k] = -a[s1][k - 1] / ndu[pk + 1][r];
+                    d += a[s2][k] * ndu[r][pk];
+                }
+                basis[k][r] = d;
+                std::swap(s1, s2);
+            }
+        }
+        param_type factor{static_cast<param_type>(p)};
+        for (int k{1}; k <= n; ++k) {
+            for (int j{0}; j <= p; ++j) {
+                basis[k][j] *= factor;
+            }
+            factor *= static_cast<param_type>(p - k);
+        }
+        std::array<value_type, N + 1> ders;
+        for (std::size_t k{0}; k <= N; ++k) {
+            ders[k] = value_type{0.0};
+            for (std::size_t j{0}; j < kOrder; ++j) {
+                ders[k] += m_control_points[span - Degree + j] * basis[k][j];
+            }
+        }
+        return ders;
+    }
+
+    [[using gnu: pure, flatten, hot]]
+    auto arcLength(param_type u0, param_type u1) const noexcept -> param_type {
+        constexpr std::array<param_type, 5> kGaussLegendreKnots{
+            0.04691007703066800360, 0.23076534494715845448, 0.5, 0.76923465505284154551,
+            0.95308992296933199639
+        };
+        constexpr std::array<param_type, 5> kGaussLegendreWeights{
+            0.11846344252809454375, 0.23931433524968323402, 128.0 / 450.0, 0.23931433524968323402,
+            0.11846344252809454375
+        };
+        param_type result{0.0};
+        for (std::size_t i{0}; i < kGaussLegendreKnots.size(); ++i) {
+            result += derivatives<1>(lerp(u0, u1, kGaussLegendreKnots[i]))[1].euclidean() *
+                      kGaussLegendreWeights[i];
+        }
+        return result * (u1 - u0);
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto arcLengthOf(param_type u) const noexcept -> param_type {
+        const std::size_t pos = std::clamp<std::size_t>(
+            std::ranges::upper_bound(m_params, u) - m_params.cbegin(), 1, m_params.size() - 1
+        );
+        return m_arc_lengths[pos - 1] + arcLength(m_params[pos - 1], u);
+    }
+
+    /**
+     * @brief Spline parameter at arc length s: a cubic Hermite guess inside the table interval,
+     * refined by Newton's method on the quadrature of the speed.
+     */
+    [[using gnu: pure, flatten, hot]]
+    auto paramOf(param_type s) const noexcept -> param_type {
+        constexpr param_type kTolerance{1E-12};
+        constexpr int kMaxIterations{4};
+        const std::size_t pos = std::clamp<std::size_t>(
+            std::ranges::upper_bound(m_arc_lengths, s) - m_arc_lengths.cbegin(), 1,
+            m_arc_lengths.size() - 1
+        );
+        const param_type u0{m_params[pos - 1]};
+        const param_type u1{m_params[pos]};
+        const param_type s0{m_arc_lengths[pos - 1]};
+        const param_type h{m_arc_lengths[pos] - s0};
+        if (h <= 0.0) {
+            return u0;
+        }
+        const param_type ratio{(s - s0) / h};
+        const param_type du0{h / derivatives<1>(u0)[1].euclidean()};
+        const param_type du1{h / derivatives<1>(u1)[1].euclidean()};
+        const param_type ratio2{ratio * ratio};
+        const param_type ratio3{ratio2 * ratio};
+        param_type u{
+            (2.0 * ratio3 - 3.0 * ratio2 + 1.0) * u0 + (ratio3 - 2.0 * ratio2 + ratio) * du0 +
+            (-2.0 * ratio3 + 3.0 * ratio2) * u1 + (ratio3 - ratio2) * du1
+        };
+        u = std::clamp(u, u0, u1);
+        for (int i{0}; i < kMaxIterations; ++i) {
+            const param_type residual{s0 + arcLength(u0, u) - s};
+            const param_type step{residual / derivatives<1>(u)[1].euclidean()};
+            u = std::clamp(u - step, u0, u1);
+            if (std::abs(step) < kTolerance * (u1 - u0)) {
+                break;
+            }
+        }
+        return u;
+    }
+
+    auto buildArcLengthTable(param_type s0) noexcept -> void {
+        const std::size_t size{m_control_points.size()};
+        m_params.clear();
+        for (std::size_t span{Degree}; span < size; ++span) {
+            if (m_knots[span] == m_knots[span + 1]) {
+                continue;
+            }
+            for (std::size_t i{0}; i < kNumSamplesPerSpan; ++i) {
+                m_params.push_back(lerp(
+                    m_knots[span], m_knots[span + 1],
+                    static_cast<param_type>(i) / static_cast<param_type>(kNumSamplesPerSpan)
+                ));
+            }
+        }
+        m_params.push_back(m_knots[size]);
+        m_anchor_points.resize(m_params.size());
+        m_arc_lengths.resize(m_params.size());
+        m_arc_lengths[0] = s0;
+        m_anchor_points[0] = evalParam(m_params[0]);
+        for (std::size_t i{1}; i < m_params.size(); ++i) {
+            m_anchor_points[i] = evalParam(m_params[i]);
+            m_arc_lengths[i] = m_arc_lengths[i - 1] + arcLength(m_params[i - 1], m_params[i]);
+        }
+        return;
+    }
+
+    /**
+     * @brief Control points of a C^(Degree - 1) piecewise polynomial from its blossoms. Each piece
+     * is recovered in monomial form from Degree + 1 samples, and the control point attached to the
+     * knots t_(j+1), ..., t_(j+Degree) is the blossom of any piece those knots enclose.
+     */
+    auto fromPiecewisePolynomial(const auto& curve) noexcept -> void {
+        const std::vector<param_type>& breaks{curve.arcLengths()};
+        const std::size_t num_pieces{breaks.size() - 1};
+        const std::size_t size{num_pieces + Degree};
+        m_knots.clear();
+        m_knots.reserve(size + kOrder);
+        m_knots.insert(m_knots.cend(), Degree, breaks.front());
+        m_knots.insert(m_knots.cend(), breaks.cbegin(), breaks.cend());
+        m_knots.insert(m_knots.cend(), Degree, breaks.back());
+
+        std::vector<std::array<value_type, kOrder>> coeffs(num_pieces);
+        for (std::size_t piece{0}; piece < num_pieces; ++piece) {
+            const param_type a{breaks[piece]};
+            const param_type h{breaks[piece + 1] - a};
+            std::array<param_type, kOrder> xs;
+            std::array<value_type, kOrder> c;
+            for (std::size_t i{0}; i < kOrder; ++i) {
+                xs[i] = (static_cast<param_type>(i) + 0.5) / static_cast<param_type>(kOrder);
+                c[i] = curve.eval(a + xs[i] * h);
+            }
+            for (std::size_t k{1}; k < kOrder; ++k) {
+                for (std::size_t i{Degree}; i >= k; --i) {
+                    c[i] = (c[i] - c[i - 1]) / (xs[i] - xs[i - k]);
+                }
+            }
+            for (std::size_t k{Degree}; k-- > 0;) {
+                for (std::size_t i{k}; i < Degree; ++i) {
+                    c[i] -= c[i + 1] * xs[k];
+                }
+            }
+            coeffs[piece] = c;
+        }
+
+        m_control_points.resize(size);
+        for (std::size_t j{0}; j < size; ++j) {
+            const std::size_t piece{std::clamp<std::size_t>(j, Degree, size - 1) - Degree};
+            const param_type a{breaks[piece]};
+            const param_type h{breaks[piece + 1] - a};
+            std::array<param_type, kOrder> elementary{};
+            elementary[0] = 1.0;
+            for (std::size_t i{1}; i <= Degree; ++i) {
+                const param_type x{(m_knots[j + i] - a) / h};
+                for (std::size_t m{i}; m > 0; --m) {
+                    elementary[m] += elementary[m - 1] * x;
+                }
+            }
+            value_type point{0.0};
+            param_type binomial{1.0};
+            for (std::size_t m{0}; m <= Degree; ++m) {
+                point += coeffs[piece][m] * (elementary[m] / binomial);
+                binomial = binomial * static_cast<param_type>(Degree - m) /
+                           static_cast<param_type>(m + 1);
+            }
+            m_control_points[j] = point;
+        }
+        buildArcLengthTable(curve.minS());
+        return;
+    }
+
+    [[using gnu: always_inline]]
+    auto serialize(auto& archive, [[maybe_unused]] const unsigned int version) noexcept -> void {
+        archive & m_knots;
+        archive & m_control_points;
+        archive & m_params;
+        archive & m_arc_lengths;
+        archive & m_anchor_points;
+        return;
+    }
+
+    std::vector<param_type> m_knots{};
+    std::vector<value_type> m_control_points{};
+    std::vector<param_type> m_params{};
+    std::vector<param_type> m_arc_lengths{};
+    std::vector<value_type> m_anchor_points{};
+};
+
+using BSplineCurve2f = BSplineCurve<Vec2f>;
+using BSplineCurve2d = BSplineCurve<Vec2d>;
+using BSplineCurve3f = BSplineCurve<Vec3f>;
+using BSplineCurve3d = BSplineCurve<Vec3d>;
+
+} // namespace boyle::math
@@ -0,0 +1,360 @@
+/**
+ * @file piecewise_arc_curve.hpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2024-06-22
+ *
+ * @copyright Copyright (c) 2024 Boyle Development Team
+ *            All rights reserved.
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <limits>
+#include <numbers>
+#include <ranges>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "boost/serialization/access.hpp"
+#include "boost/serialization/vector.hpp"
+#include "fmt/format.h"
+
+#include "boyle/math/concepts.hpp"
+#include "boyle/math/dubins.hpp"
+#include "boyle/math/duplet.hpp"
+#include "boyle/math/reeds_shepp.hpp"
+#include "boyle/math/utils.hpp"
+#include "boyle/math/vec2.hpp"
+
+namespace boyle::math {
+
+/**
+ * @brief Planar curve made of straight lines and circular arcs, as driven by a car: each segment
+ * has a constant steering curvature and a signed length, negative when the segment is driven in
+ * reverse. The curve is parameterized by the travelled distance, so tangent() and curvature() are
+ * those of the traced geometry and flip sign on reverse segments, while heading() stays the heading
+ * of the vehicle. Dubins and Reeds-Shepp paths convert to this curve without any sampling.
+ */
+template <InstanceOfTemplate<Vec2> T, std::floating_point U = typename T::value_type>
+class [[nodiscard]] PiecewiseArcCurve final {
+    friend class boost::serialization::access;
+
+  public:
+    using value_type = T;
+    using param_type = U;
+
+    PiecewiseArcCurve() noexcept = default;
+    PiecewiseArcCurve(const PiecewiseArcCurve& other) noexcept = default;
+    auto operator=(const PiecewiseArcCurve& other) noexcept -> PiecewiseArcCurve& = default;
+    PiecewiseArcCurve(PiecewiseArcCurve&& other) noexcept = default;
+    auto operator=(PiecewiseArcCurve&& other) noexcept -> PiecewiseArcCurve& = default;
+    ~PiecewiseArcCurve() noexcept = default;
+
+    [[using gnu: ]]
+    explicit PiecewiseArcCurve(
+        value_type start, param_type start_heading, const std::vector<param_type>& curvatures,
+        const std::vector<param_type>& lengths, param_type s0 = 0.0
+    ) noexcept(!BOYLE_CHECK_PARAMS) {
+#if BOYLE_CHECK_PARAMS == 1
+        if (curvatures.size() != lengths.size() || lengths.empty()) [[unlikely]] {
+            throw std::invalid_argument(fmt::format(
+                "Invalid arguments detected! curvatures and lengths must share the same non-zero "
+                "size: curvatures.size() = {0:d}, lengths.size() = {1:d}",
+                curvatures.size(), lengths.size()
+            ));
+        }
+#endif
+        const std::size_t size{lengths.size()};
+        m_arc_lengths.reserve(size + 1);
+        m_anchor_points.reserve(size + 1);
+        m_headings.reserve(size + 1);
+        m_curvatures.reserve(size);
+        m_directions.reserve(size);
+        m_arc_lengths.push_back(s0);
+        m_anchor_points.push_back(start);
+        m_headings.push_back(start_heading);
+        for (std::size_t i{0}; i < size; ++i) {
+            if (std::abs(lengths[i]) < kEpsilon && !(i + 1 == size && m_curvatures.empty())) {
+                continue;
+            }
+            const param_type direction{lengths[i] < 0.0 ? -1.0 : 1.0};
+            const param_type length{std::abs(lengths[i])};
+            m_curvatures.push_back(curvatures[i]);
+            m_directions.push_back(direction);
+            const auto [point, heading] = advance(
+                m_anchor_points.back(), m_headings.back(), curvatures[i], direction, length
+            );
+            m_arc_lengths.push_back(m_arc_lengths.back() + length);
+            m_anchor_points.push_back(point);
+            m_headings.push_back(heading);
+        }
+    }
+
+    [[using gnu: ]]
+    explicit PiecewiseArcCurve(
+        const DubinsPath<param_type>& path, value_type start, param_type start_heading,
+        param_type s0 = 0.0
+    ) noexcept(!BOYLE_CHECK_PARAMS)
+        : PiecewiseArcCurve{
+              start, start_heading,
+              std::vector<param_type>{
+                  curvatureOf(path.types[0], path.radius), curvatureOf(path.types[1], path.radius),
+                  curvatureOf(path.types[2], path.radius)
+              },
+              std::vector<param_type>{
+                  path.lengths[0] * path.radius, path.lengths[1] * path.radius,
+                  path.lengths[2] * path.radius
+              },
+              s0
+          } {}
+
+    [[using gnu: ]]
+    explicit PiecewiseArcCurve(
+        const ReedsSheppPath<param_type>& path, value_type start, param_type start_heading,
+        param_type s0 = 0.0
+    ) noexcept(!BOYLE_CHECK_PARAMS) {
+        std::vector<param_type> curvatures;
+        std::vector<param_type> lengths;
+        for (std::size_t i{0}; i < 5 && path.types[i] != ReedsSheppSegment::NOP; ++i) {
+            curvatures.push_back(
+                path.types[i] == ReedsSheppSegment::LEFT    ? 1.0 / path.radius
+                : path.types[i] == ReedsSheppSegment::RIGHT ? -1.0 / path.radius
+                                                            : 0.0
+            );
+            lengths.push_back(path.lengths[i] * path.radius);
+        }
+        *this = PiecewiseArcCurve{start, start_heading, curvatures, lengths, s0};
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto eval(param_type s) const noexcept -> value_type {
+        const std::size_t pos{segmentOf(s)};
+        return advance(
+                   m_anchor_points[pos], m_headings[pos], m_curvatures[pos], m_directions[pos],
+                   s - m_arc_lengths[pos]
+        )
+            .first;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto eval(param_type s, param_type l) const noexcept -> value_type {
+        const std::size_t pos{segmentOf(s)};
+        const auto [point, heading] = advance(
+            m_anchor_points[pos], m_headings[pos], m_curvatures[pos], m_directions[pos],
+            s - m_arc_lengths[pos]
+        );
+        return point + value_type{-std::sin(heading), std::cos(heading)} * (m_directions[pos] * l);
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto eval(SlDuplet<param_type> sl) const noexcept -> value_type {
+        return eval(sl.s, sl.l);
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto tangent(param_type s) const noexcept -> value_type {
+        const std::size_t pos{segmentOf(s)};
+        const param_type heading{headingAt(pos, s)};
+        return value_type{std::cos(heading), std::sin(heading)} * m_directions[pos];
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto normal(param_type s) const noexcept -> value_type {
+        return tangent(s).rotateHalfPi();
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto curvature(param_type s) const noexcept -> param_type {
+        const std::size_t pos{segmentOf(s)};
+        return m_curvatures[pos] * m_directions[pos];
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto heading(param_type s) const noexcept -> param_type {
+        return headingAt(segmentOf(s), s);
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto forward(param_type s) const noexcept -> bool {
+        return m_directions[segmentOf(s)] > 0.0;
+    }
+
+    [[using gnu: pure, flatten, hot]]
+    auto inverse(value_type point) const noexcept -> SlDuplet<param_type> {
+        const std::size_t size{m_curvatures.size()};
+        param_type best_s{m_arc_lengths.front()};
+        param_type best_distance{std::numeric_limits<param_type>::infinity()};
+        for (std::size_t i{0}; i < size; ++i) {
+            const param_type s{m_arc_lengths[i] + project(i, point, i == 0, i + 1 == size)};
+            const param_type distance{eval(s).euclideanSqrTo(point)};
+            if (distance < best_distance) {
+                best_distance = distance;
+                best_s = s;
+            }
+        }
+        return SlDuplet<param_type>{
+            .s{best_s}, .l{(point - eval(best_s)).dot(normal(best_s))}
+        };
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto operator()(param_type s) const noexcept -> value_type {
+        return eval(s);
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto operator()(param_type s, param_type l) const noexcept -> value_type {
+        return eval(s, l);
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto operator()(SlDuplet<param_type> sl) const noexcept -> value_type {
+        return eval(sl);
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto minS() const noexcept -> param_type {
+        return m_arc_lengths.front();
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto maxS() const noexcept -> param_type {
+        return m_arc_lengths.back();
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto front() const noexcept -> value_type {
+        return m_anchor_points.front();
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto back() const noexcept -> value_type {
+        return m_anchor_points.back();
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto arcLengths() const noexcept -> const std::vector<param_type>& {
+        return m_arc_lengths;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto anchorPoints() const noexcept -> const std::vector<value_type>& {
+        return m_anchor_points;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto curvatures() const noexcept -> const std::vector<param_type>& {
+        return m_curvatures;
+    }
+
+  private:
+    [[using gnu: const, always_inline]]
+    static auto curvatureOf(DubinsSegment type, param_type radius) noexcept -> param_type {
+        return type == DubinsSegment::LEFT    ? 1.0 / radius
+               : type == DubinsSegment::RIGHT ? -1.0 / radius
+                                              : 0.0;
+    }
+
+    [[using gnu: const, always_inline, hot]]
+    static auto advance(
+        value_type point, param_type heading, param_type curvature, param_type direction,
+        param_type ds
+    ) noexcept -> std::pair<value_type, param_type> {
+        if (std::abs(curvature) < kEpsilon) {
+            return {
+                point + value_type{std::cos(heading), std::sin(heading)} * (direction * ds),
+                heading
+            };
+        }
+        const param_type next_heading{heading + direction * curvature * ds};
+        return {
+            point + value_type{
+                        std::sin(next_heading) - std::sin(heading),
+                        std::cos(heading) - std::cos(next_heading)
+                    } / curvature,
+            next_heading
+        };
+    }
+
+    [[using gnu: pure, always_inline, hot]]
+    auto segmentOf(param_type s) const noexcept -> std::size_t {
+        const auto it = std::ranges::upper_bound(m_arc_lengths, s);
+        const std::size_t pos = it - m_arc_lengths.cbegin();
+        return std::clamp<std::size_t>(pos, 1, m_curvatures.size()) - 1;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto headingAt(std::size_t pos, param_type s) const noexcept -> param_type {
+        return m_headings[pos] + m_directions[pos] * m_curvatures[pos] * (s - m_arc_lengths[pos]);
+    }
+
+    /**
+     * @brief Distance along segment pos to the foot of the point, clamped to the segment except
+     * beyond the two ends of the curve, where it extrapolates like eval() does.
+     */
+    [[using gnu: pure, hot]]
+    auto project(std::size_t pos, value_type point, bool open_front, bool open_back) const noexcept
+        -> param_type {
+        const param_type length{m_arc_lengths[pos + 1] - m_arc_lengths[pos]};
+        const param_type curvature{m_curvatures[pos] * m_directions[pos]};
+        const value_type tangent{
+            value_type{std::cos(m_headings[pos]), std::sin(m_headings[pos])} * m_directions[pos]
+        };
+        param_type ds;
+        if (std::abs(curvature) < kEpsilon) {
+            ds = (point - m_anchor_points[pos]).dot(tangent);
+        } else {
+            constexpr param_type kTwoPi{2.0 * std::numbers::pi};
+            const value_type center{m_anchor_points[pos] + tangent.rotateHalfPi() / curvature};
+            const value_type from{m_anchor_points[pos] - center};
+            const value_type to{point - center};
+            param_type angle{std::atan2(from.crossProj(to), from.dot(to))};
+            if (curvature < 0.0) {
+                angle = -angle;
+            }
+            if (angle < 0.0) {
+                angle += kTwoPi;
+            }
+            const param_type circumference{kTwoPi / std::abs(curvature)};
+            ds = angle / std::abs(curvature);
+            if (ds > length && ds - length > circumference - ds) {
+                ds -= circumference;
+            }
+        }
+        if (!open_front) {
+            ds = std::max(ds, param_type{0.0});
+        }
+        if (!open_back) {
+            ds = std::min(ds, length);
+        }
+        return ds;
+    }
+
+    [[using gnu: always_inline]]
+    auto serialize(auto& archive, [[maybe_unused]] const unsigned int version) noexcept -> void {
+        archive & m_arc_lengths;
+        archive & m_anchor_points;
+        archive & m_headings;
+        archive & m_curvatures;
+        archive & m_directions;
+        return;
+    }
+
+    std::vector<param_type> m_arc_lengths{};
+    std::vector<value_type> m_anchor_points{};
+    std::vector<param_type> m_headings{};
+    std::vector<param_type> m_curvatures{};
+    std::vector<param_type> m_directions{};
+};
+
+using PiecewiseArcCurve2f = PiecewiseArcCurve<Vec2f>;
+using PiecewiseArcCurve2d = PiecewiseArcCurve<Vec2d>;
+
+} // namespace boyle::math
@@ -0,0 +1,596 @@
+/**
+ * @file piecewise_clothoid_curve.hpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2024-06-23
+ *
+ * @copyright Copyright (c) 2024 Boyle Development Team
+ *            All rights reserved.
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <limits>
+#include <numbers>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "boost/serialization/access.hpp"
+#include "boost/serialization/vector.hpp"
+#include "fmt/format.h"
+
+#include "boyle/math/concepts.hpp"
+#include "boyle/math/duplet.hpp"
+#include "boyle/math/fresnel.hpp"
+#include "boyle/math/utils.hpp"
+#include "boyle/math/vec2.hpp"
+
+namespace boyle::math {
+
+template <std::floating_point T>
+struct [[nodiscard]] ClothoidSegment final {
+    T curvature;
+    T sharpness;
+    T length;
+};
+
+/**
+ * @brief Clothoid between two poses (G1 Hermite interpolation), after Bertolazzi and Frego, "G1
+ * fitting with clothoids", 2015. In the frame of the chord the problem reduces to one equation in
+ * the half sharpness A, solved by Newton's method.
+ */
+template <std::floating_point T>
+[[using gnu: pure]] [[nodiscard]]
+inline auto clothoidHermite(
+    Vec2<T> start, T start_heading, Vec2<T> end, T end_heading
+) noexcept(!BOYLE_CHECK_PARAMS) -> ClothoidSegment<T> {
+    constexpr T kTolerance{1E-13};
+    constexpr int kMaxIterations{50};
+    const Vec2<T> chord{end - start};
+    const T r{chord.euclidean()};
+#if BOYLE_CHECK_PARAMS == 1
+    if (r < kEpsilon) [[unlikely]] {
+        throw std::invalid_argument(fmt::format(
+            "Invalid arguments detected! The two poses must not coincide: start = {0}, end = {1}",
+            start, end
+        ));
+    }
+#endif
+    const T phi{chord.angle()};
+    const T phi0{std::remainder(start_heading - phi, T{2.0 * std::numbers::pi})};
+    const T phi1{std::remainder(end_heading - phi, T{2.0 * std::numbers::pi})};
+    const T delta{phi1 - phi0};
+    const auto residual = [&](T a) noexcept -> T {
+        return generalizedFresnel(2.0 * a, delta - a, phi0).second;
+    };
+    T a{3.0 * (phi0 + phi1)};
+    for (int i{0}; i < kMaxIterations; ++i) {
+        const T g{residual(a)};
+        const T h{1E-6 * std::max(T{1.0}, std::abs(a))};
+        const T dg{(residual(a + h) - residual(a - h)) / (2.0 * h)};
+        const T step{g / dg};
+        a -= step;
+        if (std::abs(step) < kTolerance * std::max(T{1.0}, std::abs(a))) {
+            break;
+        }
+    }
+    const T length{r / generalizedFresnel(2.0 * a, delta - a, phi0).first};
+    return ClothoidSegment<T>{
+        .curvature = (delta - a) / length,
+        .sharpness = 2.0 * a / (length * length),
+        .length = length
+    };
+}
+
+/**
+ * @brief Planar curve made of clothoids, i.e. segments whose curvature is linear in arc length.
+ * Positions come from generalized Fresnel integrals while heading and curvature are closed form, so
+ * a road described by lines, arcs and spirals needs one segment per geometry record instead of a
+ * dense set of anchor points. Curvature is continuous when built from a G2 fit and may jump at the
+ * anchors otherwise.
+ */
+template <InstanceOfTemplate<Vec2> T, std::floating_point U = typename T::value_type>
+class [[nodiscard]] PiecewiseClothoidCurve final {
+    friend class boost::serialization::access;
+
+  public:
+    using value_type = T;
+    using param_type = U;
+
+    static constexpr param_type kDuplicateCriterion{1E-8};
+
+    PiecewiseClothoidCurve() noexcept = default;
+    PiecewiseClothoidCurve(const PiecewiseClothoidCurve& other) noexcept = default;
+    auto operator=(const PiecewiseClothoidCurve& other) noexcept
+        -> PiecewiseClothoidCurve& = default;
+    PiecewiseClothoidCurve(PiecewiseClothoidCurve&& other) noexcept = default;
+    auto operator=(PiecewiseClothoidCurve&& other) noexcept -> PiecewiseClothoidCurve& = default;
+    ~PiecewiseClothoidCurve() noexcept = default;
+
+    /**
+     * @brief Chains explicit segments, e.g. the line, arc and spiral records of an HD map, starting
+     * from the given pose.
+     */
+    [[using gnu: ]]
+    explicit PiecewiseClothoidCurve(
+        value_type start, param_type start_heading, std::span<const param_type> start_curvatures,
+        std::span<const param_type> end_curvatures, std::span<const param_type> lengths,
+        param_type s0 = 0.0
+    ) noexcept(!BOYLE_CHECK_PARAMS) {
+        const std::size_t size{lengths.size()};
+#if BOYLE_CHECK_PARAMS == 1
+        if (size == 0 || start_curvatures.size() != size || end_curvatures.size() != size)
+            [[unlikely]] {
+            throw std::invalid_argument(fmt::format(
+                "Invalid arguments detected! start_curvatures, end_curvatures and lengths must "
+                "share the same non-zero size: start_curvatures.size() = {0:d}, "
+                "end_curvatures.size() = {1:d}, lengths.size() = {2:d}",
+                start_curvatures.size(), end_curvatures.size(), size
+            ));
+        }
+        if (std::ranges::any_of(lengths, [](param_type length) { return length <= 0.0; }))
+            [[unlikely]] {
+            throw std::invalid_argument(
+                "Invalid arguments detected! All segment lengths must be positive."
+            );
+        }
+#endif
+        reserve(size);
+        m_arc_lengths.push_back(s0);
+        m_anchor_points.push_back(start);
+        m_headings.push_back(start_heading);
+        for (std::size_t i{0}; i < size; ++i) {
+            append(ClothoidSegment<param_type>{
+                .curvature = start_curvatures[i],
+                .sharpness = (end_curvatures[i] - start_curvatures[i]) / lengths[i],
+                .length = lengths[i]
+            });
+        }
+    }
+
+    /**
+     * @brief G1 Hermite fit: one clothoid between each pair of consecutive poses. Curvature is
+     * generally discontinuous at the anchors.
+     */
+    [[using gnu: ]]
+    explicit PiecewiseClothoidCurve(
+        std::vector<value_type> anchor_points, std::span<const param_type> headings,
+        param_type s0 = 0.0
+    ) noexcept(!BOYLE_CHECK_PARAMS) {
+#if BOYLE_CHECK_PARAMS == 1
+        checkAnchorPoints(anchor_points);
+        if (headings.size() != anchor_points.size()) [[unlikely]] {
+            throw std::invalid_argument(fmt::format(
+                "Invalid arguments detected! headings must match anchor_points in size: "
+                "anchor_points.size() = {0:d}, headings.size() = {1:d}",
+                anchor_points.size(), headings.size()
+            ));
+        }
+#endif
+        build(std::move(anchor_points), headings, s0);
+    }
+
+    /**
+     * @brief G2 fit through the anchor points: the interior headings are solved for so that
+     * curvature is continuous everywhere. An end heading given as NaN is left free and the
+     * curvature there is set to zero instead.
+     */
+    [[using gnu: ]]
+    explicit PiecewiseClothoidCurve(
+        std::vector<value_type> anchor_points, param_type start_heading, param_type end_heading,
+        param_type s0 = 0.0
+    ) noexcept(!BOYLE_CHECK_PARAMS) {
+#if BOYLE_CHECK_PARAMS == 1
+        checkAnchorPoints(anchor_points);
+#endif
+        const std::vector<param_type> headings{
+            solveG2Headings(anchor_points, start_heading, end_heading)
+        };
+        build(std::move(anchor_points), headings, s0);
+    }
+
+    [[using gnu: pure, always_inline, hot]]
+    auto eval(param_type s) const noexcept -> value_type {
+        const std::size_t pos{segmentOf(s)};
+        return evalSegment(pos, s - m_arc_lengths[pos]);
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto eval(param_type s, param_type l) const noexcept -> value_type {
+        return eval(s) + normal(s) * l;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto eval(SlDuplet<param_type> sl) const noexcept -> value_type {
+        return eval(sl.s, sl.l);
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto heading(param_type s) const noexcept -> param_type {
+        const std::size_t pos{segmentOf(s)};
+        const param_type ds{s - m_arc_lengths[pos]};
+        return m_headings[pos] + (m_curvatures[pos] + 0.5 * m_sharpnesses[pos] * ds) * ds;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto tangent(param_type s) const noexcept -> value_type {
+        const param_type theta{heading(s)};
+        return value_type{std::cos(theta), std::sin(theta)};
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto normal(param_type s) const noexcept -> value_type {
+        const param_type theta{heading(s)};
+        return value_type{-std::sin(theta), std::cos(theta)};
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto curvature(param_type s) const noexcept -> param_type {
+        const std::size_t pos{segmentOf(s)};
+        return m_curvatures[pos] + m_sharpnesses[pos] * (s - m_arc_lengths[pos]);
+    }
+
+    /**
+     * @brief Projection onto the curve by Newton's method on the two segments around the nearest
+     * anchor point.
+     */
+    [[using gnu: pure, flatten, hot]]
+    auto inverse(value_type point) const noexcept -> SlDuplet<param_type> {
+        const std::size_t num_segments{m_curvatures.size()};
+        std::size_t nearest{0};
+        param_type min_distance{std::numeric_limits<param_type>::infinity()};
+        for (std::size_t i{0}; i < m_anchor_points.size(); ++i) {
+            const param_type distance{m_anchor_points[i].euclideanSqrTo(point)};
+            if (distance < min_distance) {
+                min_distance = distance;
+                nearest = i;
+            }
+        }
+        param_type best_s{m_arc_lengths[nearest]};
+        param_type best_distance{min_distance};
+        for (std::size_t pos : {nearest - 1, nearest}) {
+            if (pos >= num_segments) {
+                continue;
+            }
+            const param_type s{m_arc_lengths[pos] + project(pos, point)};
+            const param_type distance{eval(s).euclideanSqrTo(point)};
+            if (distance < best_distance) {
+                best_distance = distance;
+                best_s = s;
+            }
+        }
+        return SlDuplet<param_type>{
+            .s{best_s}, .l{(point - eval(best_s)).dot(normal(best_s))}
+        };
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto operator()(param_type s) const noexcept -> value_type {
+        return eval(s);
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto operator()(param_type s, param_type l) const noexcept -> value_type {
+        return eval(s, l);
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto operator()(SlDuplet<param_type> sl) const noexcept -> value_type {
+        return eval(sl);
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto minS() const noexcept -> param_type {
+        return m_arc_lengths.front();
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto maxS() const noexcept -> param_type {
+        return m_arc_lengths.back();
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto front() const noexcept -> value_type {
+        return m_anchor_points.front();
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto back() const noexcept -> value_type {
+        return m_anchor_points.back();
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto arcLengths() const noexcept -> const std::vector<param_type>& {
+        return m_arc_lengths;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto anchorPoints() const noexcept -> const std::vector<value_type>& {
+        return m_anchor_points;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto segment(std::size_t pos) const noexcept -> ClothoidSegment<param_type> {
+        return ClothoidSegment<param_type>{
+            .curvature = m_curvatures[pos],
+            .sharpness = m_sharpnesses[pos],
+            .length = m_arc_lengths[pos + 1] - m_arc_lengths[pos]
+        };
+    }
+
+  private:
+    struct [[nodiscard]] TridiagonalMatrix final {
+        [[using gnu: pure, flatten, leaf, hot]] [[nodiscard]]
+        auto luDcmp(std::span<const param_type> b) const noexcept -> std::vector<param_type> {
+            const std::size_t mat_size{a_diag.size()};
+            std::vector<param_type> x(mat_size);
+            std::vector<param_type> u0(mat_size);
+            std::vector<param_type> l1(mat_size - 1);
+            const std::vector<param_type>& u1{a_up};
+
+            u0[0] = a_diag[0];
+            for (std::size_t i{1}; i < mat_size; ++i) {
+                l1[i - 1] = a_low[i - 1] / u0[i - 1];
+                u0[i] = a_diag[i] - l1[i - 1] * u1[i - 1];
+            }
+
+            x[0] = b[0];
+            for (std::size_t i{1}; i < mat_size; ++i) {
+                x[i] = b[i] - l1[i - 1] * x[i - 1];
+            }
+
+            x[mat_size - 1] = x[mat_size - 1] / u0[mat_size - 1];
+            for (int i = mat_size - 2; i > -1; --i) {
+                x[i] = (x[i] - u1[i] * x[i + 1]) / u0[i];
+            }
+            return x;
+        }
+
+        std::vector<param_type> a_low;
+        std::vector<param_type> a_diag;
+        std::vector<param_type> a_up;
+    };
+
+    static auto checkAnchorPoints(const std::vector<value_type>& anchor_points) -> void {
+        if (anchor_points.size() < 2) [[unlikely]] {
+            throw std::invalid_argument(fmt::format(
+                "Invalid arguments detected! sizes of anchor_points must be greater than 2: "
+                "anchor_points.size() = {0:d}",
+                anchor_points.size()
+            ));
+        }
+        for (std::size_t i{1}; i < anchor_points.size(); ++i) {
+            if (anchor_points[i].euclideanTo(anchor_points[i - 1]) < kDuplicateCriterion)
+                [[unlikely]] {
+                throw std::invalid_argument(fmt::format(
+                    "Invalid arguments detected! anchor_points must not contain consecutive "
+                    "duplicates: anchor_points[{0:d}] = {1}",
+                    i, anchor_points[i]
+                ));
+            }
+        }
+        return;
+    }
+
+    /**
+     * @brief Newton's method on the headings, which only couple neighbouring segments, so every
+     * iteration solves a tridiagonal system whose entries come from central differences of the
+     * G1 fits.
+     */
+    [[using gnu: ]] [[nodiscard]]
+    static auto solveG2Headings(
+        const std::vector<value_type>& anchor_points, param_type start_heading,
+        param_type end_heading
+    ) noexcept(!BOYLE_CHECK_PARAMS) -> std::vector<param_type> {
+        constexpr param_type kTolerance{1E-10};
+        constexpr param_type kDelta{1E-7};
+        constexpr param_type kMaxStep{0.5};
+        constexpr int kMaxIterations{50};
+        const std::size_t size{anchor_points.size()};
+        const std::size_t num_segments{size - 1};
+        const bool free_start{std::isnan(start_heading)};
+        const bool free_end{std::isnan(end_heading)};
+
+        std::vector<param_type> headings(size);
+        for (std::size_t i{1}; i + 1 < size; ++i) {
+            headings[i] = (anchor_points[i + 1] - anchor_points[i - 1]).angle();
+        }
+        headings.front() =
+            free_start ? (anchor_points[1] - anchor_points[0]).angle() : start_heading;
+        headings.back() =
+            free_end ? (anchor_points[size - 1] - anchor_points[size - 2]).angle() : end_heading;
+        if (size == 2 && !free_start && !free_end) {
+            return headings;
+        }
+
+        std::vector<std::pair<param_type, param_type>> curvatures(num_segments);
+        std::vector<std::array<param_type, 4>> jacobians(num_segments);
+        std::vector<param_type> a_low(size - 1);
+        std::vector<param_type> a_diag(size);
+        std::vector<param_type> a_up(size - 1);
+        std::vector<param_type> b(size);
+        const auto endCurvatures = [&](std::size_t i, param_type theta0, param_type theta1) {
+            const ClothoidSegment<param_type> segment{
+                clothoidHermite(anchor_points[i], theta0, anchor_points[i + 1], theta1)
+            };
+            return std::pair<param_type, param_type>{
+                segment.curvature, segment.curvature + segment.sharpness * segment.length
+            };
+        };
+        for (int iteration{0}; iteration < kMaxIterations; ++iteration) {
+            for (std::size_t i{0}; i < num_segments; ++i) {
+                curvatures[i] = endCurvatures(i, headings[i], headings[i + 1]);
+                const auto [ks0p, ke0p] = endCurvatures(i, headings[i] + kDelta, headings[i + 1]);
+                const auto [ks0m, ke0m] = endCurvatures(i, headings[i] - kDelta, headings[i + 1]);
+                const auto [ks1p, ke1p] = endCurvatures(i, headings[i], headings[i + 1] + kDelta);
+                const auto [ks1m, ke1m] = endCurvatures(i, headings[i], headings[i + 1] - kDelta);
+                jacobians[i] = {
+                    (ks0p - ks0m) / (2.0 * kDelta), (ks1p - ks1m) / (2.0 * kDelta),
+                    (ke0p - ke0m) / (2.0 * kDelta), (ke1p - ke1m) / (2.0 * kDelta)
+                };
+            }
+            param_type max_residual{0.0};
+            if (free_start) {
+                a_diag[0] = jacobians[0][0];
+                a_up[0] = jacobians[0][1];
+                b[0] = -curvatures[0].first;
+                max_residual = std::abs(curvatures[0].first);
+            } else {
+                a_diag[0] = 1.0;
+                a_up[0] = 0.0;
+                b[0] = 0.0;
+            }
+            for (std::size_t i{1}; i < num_segments; ++i) {
+                a_low[i - 1] = jacobians[i - 1][2];
+                a_diag[i] = jacobians[i - 1][3] - jacobians[i][0];
+                a_up[i] = -jacobians[i][1];
+                b[i] = curvatures[i].first - curvatures[i - 1].second;
+                max_residual = std::max(max_residual, std::abs(b[i]));
+            }
+            if (free_end) {
+                a_low[size - 2] = jacobians[num_segments - 1][2];
+                a_diag[size - 1] = jacobians[num_segments - 1][3];
+                b[size - 1] = -curvatures[num_segments - 1].second;
+                max_residual = std::max(max_residual, std::abs(b[size - 1]));
+            } else {
+                a_low[size - 2] = 0.0;
+                a_diag[size - 1] = 1.0;
+                b[size - 1] = 0.0;
+            }
+            if (max_residual < kTolerance) {
+                break;
+            }
+            const TridiagonalMatrix A{a_low, a_diag, a_up};
+            const std::vector<param_type> steps{A.luDcmp(b)};
+            for (std::size_t i{0}; i < size; ++i) {
+                headings[i] += std::clamp(steps[i], -kMaxStep, kMaxStep);
+            }
+        }
+        return headings;
+    }
+
+    [[using gnu: always_inline]]
+    auto reserve(std::size_t num_segments) -> void {
+        m_arc_lengths.reserve(num_segments + 1);
+        m_anchor_points.reserve(num_segments + 1);
+        m_headings.reserve(num_segments + 1);
+        m_curvatures.reserve(num_segments);
+        m_sharpnesses.reserve(num_segments);
+        return;
+    }
+
+    auto build(
+        std::vector<value_type> anchor_points, std::span<const param_type> headings, param_type s0
+    ) noexcept(!BOYLE_CHECK_PARAMS) -> void {
+        const std::size_t num_segments{anchor_points.size() - 1};
+        reserve(num_segments);
+        m_arc_lengths.push_back(s0);
+        m_headings.push_back(headings[0]);
+        for (std::size_t i{0}; i < num_segments; ++i) {
+            const ClothoidSegment<param_type> segment{clothoidHermite(
+                anchor_points[i], headings[i], anchor_points[i + 1], headings[i + 1]
+            )};
+            m_curvatures.push_back(segment.curvature);
+            m_sharpnesses.push_back(segment.sharpness);
+            m_arc_lengths.push_back(m_arc_lengths.back() + segment.length);
+            m_headings.push_back(
+                m_headings.back() +
+                (segment.curvature + 0.5 * segment.sharpness * segment.length) * segment.length
+            );
+        }
+        m_anchor_points = std::move(anchor_points);
+        return;
+    }
+
+    [[using gnu: always_inline]]
+    auto append(const ClothoidSegment<param_type>& segment) -> void {
+        m_curvatures.push_back(segment.curvature);
+        m_sharpnesses.push_back(segment.sharpness);
+        const std::size_t pos{m_curvatures.size() - 1};
+        m_anchor_points.push_back(evalSegment(pos, segment.length));
+        m_arc_lengths.push_back(m_arc_lengths.back() + segment.length);
+        m_headings.push_back(
+            m_headings.back() +
+            (segment.curvature + 0.5 * segment.sharpness * segment.length) * segment.length
+        );
+        return;
+    }
+
+    [[using gnu: pure, always_inline, hot]]
+    auto segmentOf(param_type s) const noexcept -> std::size_t {
+        const auto it = std::ranges::upper_bound(m_arc_lengths, s);
+        const std::size_t pos = it - m_arc_lengths.cbegin();
+        return std::clamp<std::size_t>(pos, 1, m_curvatures.size()) - 1;
+    }
+
+    [[using gnu: pure, always_inline, hot]]
+    auto evalSegment(std::size_t pos, param_type ds) const noexcept -> value_type {
+        const auto [x, y] = generalizedFresnel(
+            m_sharpnesses[pos] * ds * ds, m_curvatures[pos] * ds, m_headings[pos]
+        );
+        return m_anchor_points[pos] + value_type{x, y} * ds;
+    }
+
+    [[using gnu: pure, hot]]
+    auto project(std::size_t pos, value_type point) const noexcept -> param_type {
+        constexpr param_type kTolerance{1E-10};
+        constexpr int kMaxIterations{20};
+        const param_type length{m_arc_lengths[pos + 1] - m_arc_lengths[pos]};
+        const param_type lower{pos == 0 ? -std::numeric_limits<param_type>::infinity() : 0.0};
+        const param_type upper{
+            pos + 1 == m_curvatures.size() ? std::numeric_limits<param_type>::infinity() : length
+        };
+        const param_type theta0{m_headings[pos]};
+        param_type ds{std::clamp(
+            (point - m_anchor_points[pos]).dot(value_type{std::cos(theta0), std::sin(theta0)}),
+            lower, upper
+        )};
+        for (int i{0}; i < kMaxIterations; ++i) {
+            const value_type r{evalSegment(pos, ds) - point};
+            const param_type kappa{m_curvatures[pos] + m_sharpnesses[pos] * ds};
+            const param_type theta{
+                theta0 + (m_curvatures[pos] + 0.5 * m_sharpnesses[pos] * ds) * ds
+            };
+            const value_type tangent{std::cos(theta), std::sin(theta)};
+            const param_type f{r.dot(tangent)};
+            const param_type df{1.0 + kappa * r.dot(tangent.rotateHalfPi())};
+            const param_type next{
+                std::clamp(ds - f / (df > 0.1 ? df : param_type{1.0}), lower, upper)
+            };
+            if (std::abs(next - ds) < kTolerance) {
+                return next;
+            }
+            ds = next;
+        }
+        return ds;
+    }
+
+    [[using gnu: always_inline]]
+    auto serialize(auto& archive, [[maybe_unused]] const unsigned int version) noexcept -> void {
+        archive & m_arc_lengths;
+        archive & m_anchor_points;
+        archive & m_headings;
+        archive & m_curvatures;
+        archive & m_sharpnesses;
+        return;
+    }
+
+    std::vector<param_type> m_arc_lengths{};
+    std::vector<value_type> m_anchor_points{};
+    std::vector<param_type> m_headings{};
+    std::vector<param_type> m_curvatures{};
+    std::vector<param_type> m_sharpnesses{};
+};
+
+using PiecewiseClothoidCurve2f = PiecewiseClothoidCurve<Vec2f>;
+using PiecewiseClothoidCurve2d = PiecewiseClothoidCurve<Vec2d>;
+
+} // namespace boyle::math
@@ -13,7 +13,10 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <concepts>
+#include <memory>
+#include <memory_resource>
 #include <ranges>
 #include <stdexcept>
 #include <utility>
@@ -25,7 +28,10 @@
 #include "boyle/math/concepts.hpp"
 #include "boyle/math/cubic_interpolation.hpp"
 #include "boyle/math/duplet.hpp"
+#include "boyle/math/extrema_tree.hpp"
+#include "boyle/math/flat_file.hpp"
 #include "boyle/math/functions/piecewise_cubic_function1.hpp"
+#include "boyle/math/polynomial.hpp"
 #include "boyle/math/triplet.hpp"
 #include "boyle/math/utils.hpp"
 #include "boyle/math/vec2.hpp"
@@ -33,16 +39,22 @@
 
 namespace boyle::math {
 
-template <VecArithmetic T, std::floating_point U = typename T::value_type>
+template <VecArithmetic T, std::floating_point U = typename T::value_type,
+          typename Alloc = std::allocator<T>>
 class [[nodiscard]] PiecewiseCubicCurve final {
     friend class boost::serialization::access;
 
   public:
     using value_type = T;
     using param_type = U;
-    using BoundaryMode = typename PiecewiseCubicFunction1<value_type, param_type>::BoundaryMode;
+    using allocator_type = Alloc;
+    using param_vector_type = StorageVector<param_type, Alloc>;
+    using value_vector_type = StorageVector<value_type, Alloc>;
+    using BoundaryMode =
+        typename PiecewiseCubicFunction1<value_type, param_type, Alloc>::BoundaryMode;
 
     static constexpr param_type kDuplicateCriterion{1E-8};
+    static constexpr FlatKind kFlatKind{FlatKind::PIECEWISE_CUBIC_CURVE};
 
     PiecewiseCubicCurve() noexcept = default;
     PiecewiseCubicCurve(const PiecewiseCubicCurve& other) noexcept = default;
@@ -52,7 +64,7 @@ class [[nodiscard]] PiecewiseCubicCurve final {
     ~PiecewiseCubicCurve() noexcept = default;
 
     [[using gnu: always_inline]]
-    explicit PiecewiseCubicCurve(std::vector<value_type> anchor_points, param_type s0 = 0.0)
+    explicit PiecewiseCubicCurve(value_vector_type anchor_points, param_type s0 = 0.0)
         : PiecewiseCubicCurve(
               std::move(anchor_points), BoundaryMode{2, value_type{0.0, 0.0}},
               BoundaryMode{2, value_type{0.0, 0.0}}, s0
@@ -60,8 +72,9 @@ class [[nodiscard]] PiecewiseCubicCurve final {
 
     [[using gnu: ]]
     explicit PiecewiseCubicCurve(
-        std::vector<value_type> anchor_points, BoundaryMode b0, BoundaryMode bf, param_type s0 = 0.0
-    ) noexcept(!BOYLE_CHECK_PARAMS) {
+        value_vector_type anchor_points, BoundaryMode b0, BoundaryMode bf, param_type s0 = 0.0
+    ) noexcept(!BOYLE_CHECK_PARAMS)
+        : m_vec_of_s{anchor_points.get_allocator()} {
 #if BOYLE_CHECK_PARAMS == 1
         if (anchor_points.size() < 2) [[unlikely]] {
             throw std::invalid_argument(fmt::format(
@@ -72,18 +85,19 @@ class [[nodiscard]] PiecewiseCubicCurve final {
         }
 #endif
         const std::size_t size{anchor_points.size()};
-        std::vector<param_type> temp_arc_lengths(size);
+        param_vector_type temp_arc_lengths(size, anchor_points.get_allocator());
         temp_arc_lengths[0] = s0;
         for (std::size_t i{1}; i < size; ++i) {
             temp_arc_lengths[i] =
                 temp_arc_lengths[i - 1] + anchor_points[i].euclideanTo(anchor_points[i - 1]);
         }
-        const PiecewiseCubicFunction1<value_type, param_type> temp_vec_of_s{
-            temp_arc_lengths, anchor_points, b0, bf
+        const PiecewiseCubicFunction1<value_type, param_type, Alloc> temp_vec_of_s{
+            param_vector_type(temp_arc_lengths, anchor_points.get_allocator()),
+            value_vector_type(anchor_points, anchor_points.get_allocator()), b0, bf
         };
 
-        const std::vector<value_type>& ddys{temp_vec_of_s.ddys()};
-        std::vector<param_type> arc_lengths(size);
+        const value_vector_type& ddys{temp_vec_of_s.ddys()};
+        param_vector_type arc_lengths(size, anchor_points.get_allocator());
         arc_lengths[0] = s0;
         for (std::size_t i{1}; i < size; ++i) {
             arc_lengths[i] =
@@ -92,16 +106,16 @@ class [[nodiscard]] PiecewiseCubicCurve final {
                                          ddys[i], temp_arc_lengths[i] - temp_arc_lengths[i - 1]
                                      );
         }
-        m_vec_of_s = PiecewiseCubicFunction1<value_type, param_type>{
+        m_vec_of_s = PiecewiseCubicFunction1<value_type, param_type, Alloc>{
             std::move(arc_lengths), std::move(anchor_points), b0, bf
         };
     }
 
     [[using gnu: ]]
     explicit PiecewiseCubicCurve(
-        [[maybe_unused]] periodic_tag tag, std::vector<value_type> anchor_points,
-        param_type s0 = 0.0
-    ) noexcept(!BOYLE_CHECK_PARAMS) {
+        [[maybe_unused]] periodic_tag tag, value_vector_type anchor_points, param_type s0 = 0.0
+    ) noexcept(!BOYLE_CHECK_PARAMS)
+        : m_vec_of_s{anchor_points.get_allocator()} {
 #if BOYLE_CHECK_PARAMS == 1
         if (anchor_points.size() < 2) [[unlikely]] {
             throw std::invalid_argument(fmt::format(
@@ -112,18 +126,19 @@ class [[nodiscard]] PiecewiseCubicCurve final {
         }
 #endif
         const std::size_t size{anchor_points.size()};
-        std::vector<param_type> temp_arc_lengths(size);
+        param_vector_type temp_arc_lengths(size, anchor_points.get_allocator());
         temp_arc_lengths[0] = s0;
         for (std::size_t i{1}; i < size; ++i) {
             temp_arc_lengths[i] =
                 temp_arc_lengths[i - 1] + anchor_points[i].euclideanTo(anchor_points[i - 1]);
         }
-        const PiecewiseCubicFunction1<value_type, param_type> temp_vec_of_s{
-            tag, temp_arc_lengths, anchor_points
+        const PiecewiseCubicFunction1<value_type, param_type, Alloc> temp_vec_of_s{
+            tag, param_vector_type(temp_arc_lengths, anchor_points.get_allocator()),
+            value_vector_type(anchor_points, anchor_points.get_allocator())
         };
 
-        const std::vector<value_type>& ddys{temp_vec_of_s.ddys()};
-        std::vector<param_type> arc_lengths(size);
+        const value_vector_type& ddys{temp_vec_of_s.ddys()};
+        param_vector_type arc_lengths(size, anchor_points.get_allocator());
         arc_lengths[0] = s0;
         for (std::size_t i{1}; i < size; ++i) {
             arc_lengths[i] =
@@ -132,7 +147,7 @@ class [[nodiscard]] PiecewiseCubicCurve final {
                                          ddys[i], temp_arc_lengths[i] - temp_arc_lengths[i - 1]
                                      );
         }
-        m_vec_of_s = PiecewiseCubicFunction1<value_type, param_type>{
+        m_vec_of_s = PiecewiseCubicFunction1<value_type, param_type, Alloc>{
             tag, std::move(arc_lengths), std::move(anchor_points)
         };
     }
@@ -147,9 +162,9 @@ class [[nodiscard]] PiecewiseCubicCurve final {
         requires InstanceOfTemplate<value_type, Vec2>
     {
         constexpr std::array<param_type, 2> kFactors{-(1.0 / 3.0), -(1.0 / 6.0)};
-        const std::vector<param_type>& arc_lengths{arcLengths()};
-        const std::vector<value_type>& anchor_points{anchorPoints()};
-        const std::vector<value_type>& ddys{m_vec_of_s.ddys()};
+        const param_vector_type& arc_lengths{arcLengths()};
+        const value_vector_type& anchor_points{anchorPoints()};
+        const value_vector_type& ddys{m_vec_of_s.ddys()};
         const std::size_t size{arc_lengths.size()};
         const std::size_t pos =
             nearestUpperElement(
@@ -211,9 +226,9 @@ class [[nodiscard]] PiecewiseCubicCurve final {
         requires InstanceOfTemplate<value_type, Vec3>
     {
         constexpr std::array<param_type, 2> kFactors{-(1.0 / 3.0), -(1.0 / 6.0)};
-        const std::vector<param_type>& arc_lengths{arcLengths()};
-        const std::vector<value_type>& anchor_points{anchorPoints()};
-        const std::vector<value_type>& ddys{m_vec_of_s.ddys()};
+        const param_vector_type& arc_lengths{arcLengths()};
+        const value_vector_type& anchor_points{anchorPoints()};
+        const value_vector_type& ddys{m_vec_of_s.ddys()};
         const std::size_t size{arc_lengths.size()};
         const std::size_t pos =
             nearestUpperElement(
@@ -288,9 +303,9 @@ class [[nodiscard]] PiecewiseCubicCurve final {
         requires InstanceOfTemplate<value_type, Vec2>
     {
         constexpr std::array<param_type, 2> kFactors{-(1.0 / 3.0), -(1.0 / 6.0)};
-        const std::vector<param_type>& arc_lengths{arcLengths()};
-        const std::vector<value_type>& anchor_points{anchorPoints()};
-        const std::vector<value_type>& ddys{m_vec_of_s.ddys()};
+        const param_vector_type& arc_lengths{arcLengths()};
+        const value_vector_type& anchor_points{anchorPoints()};
+        const value_vector_type& ddys{m_vec_of_s.ddys()};
         const std::size_t size{arc_lengths.size()};
         const std::size_t pos =
             nearestUpperElement(
@@ -330,9 +345,9 @@ class [[nodiscard]] PiecewiseCubicCurve final {
         requires InstanceOfTemplate<value_type, Vec3>
     {
         constexpr std::array<param_type, 2> kFactors{-(1.0 / 3.0), -(1.0 / 6.0)};
-        const std::vector<param_type>& arc_lengths{arcLengths()};
-        const std::vector<value_type>& anchor_points{anchorPoints()};
-        const std::vector<value_type>& ddys{m_vec_of_s.ddys()};
+        const param_vector_type& arc_lengths{arcLengths()};
+        const value_vector_type& anchor_points{anchorPoints()};
+        const value_vector_type& ddys{m_vec_of_s.ddys()};
         const std::size_t size{arc_lengths.size()};
         const std::size_t pos =
             nearestUpperElement(
@@ -369,9 +384,9 @@ class [[nodiscard]] PiecewiseCubicCurve final {
         requires InstanceOfTemplate<value_type, Vec3>
     {
         constexpr std::array<param_type, 2> kFactors{-(1.0 / 3.0), -(1.0 / 6.0)};
-        const std::vector<param_type>& arc_lengths{arcLengths()};
-        const std::vector<value_type>& anchor_points{anchorPoints()};
-        const std::vector<value_type>& ddys{m_vec_of_s.ddys()};
+        const param_vector_type& arc_lengths{arcLengths()};
+        const value_vector_type& anchor_points{anchorPoints()};
+        const value_vector_type& ddys{m_vec_of_s.ddys()};
         const std::size_t size{arc_lengths.size()};
         const std::size_t pos =
             nearestUpperElement(
@@ -405,7 +420,7 @@ class [[nodiscard]] PiecewiseCubicCurve final {
 
     [[using gnu: pure, flatten, leaf, hot]]
     auto curvature(param_type s) const noexcept -> param_type {
-        const std::vector<param_type>& arc_lengths{arcLengths()};
+        const param_vector_type& arc_lengths{arcLengths()};
         const std::size_t size{arc_lengths.size()};
         const std::size_t pos =
             nearestUpperElement(
@@ -427,12 +442,43 @@ class [[nodiscard]] PiecewiseCubicCurve final {
                (derivative_norm * derivative_norm * derivative_norm);
     }
 
+    /**
+     * @brief Minimum and maximum curvature over [s0, s1], clipped to the arc length range. The
+     * first call builds a segment tree over the curvature extrema of every segment; later calls
+     * take O(log n).
+     */
+    [[using gnu: always_inline]]
+    auto curvatureExtrema(param_type s0, param_type s1) const -> std::pair<param_type, param_type>
+        requires InstanceOfTemplate<value_type, Vec2>
+    {
+        return windowExtrema(
+            m_curvature_tree, arcLengths(), s0, s1,
+            [this](std::size_t i, param_type r0, param_type r1) {
+                return segmentCurvatureExtrema(i, r0, r1);
+            }
+        );
+    }
+
+    [[using gnu: always_inline]]
+    auto minCurvature(param_type s0, param_type s1) const -> param_type
+        requires InstanceOfTemplate<value_type, Vec2>
+    {
+        return curvatureExtrema(s0, s1).first;
+    }
+
+    [[using gnu: always_inline]]
+    auto maxCurvature(param_type s0, param_type s1) const -> param_type
+        requires InstanceOfTemplate<value_type, Vec2>
+    {
+        return curvatureExtrema(s0, s1).second;
+    }
+
     [[using gnu: pure, always_inline]]
     auto torsion(param_type s) const noexcept -> param_type
         requires InstanceOfTemplate<value_type, Vec3>
     {
-        const std::vector<param_type>& arc_lengths{arcLengths()};
-        const std::vector<value_type>& ddys{m_vec_of_s.ddys()};
+        const param_vector_type& arc_lengths{arcLengths()};
+        const value_vector_type& ddys{m_vec_of_s.ddys()};
         const std::size_t size{arc_lengths.size()};
         const std::size_t pos =
             nearestUpperElement(
@@ -461,9 +507,9 @@ class [[nodiscard]] PiecewiseCubicCurve final {
         requires InstanceOfTemplate<value_type, Vec2>
     {
         constexpr std::array<param_type, 2> kFactors{-(1.0 / 3.0), -(1.0 / 6.0)};
-        const std::vector<param_type>& arc_lengths{arcLengths()};
-        const std::vector<value_type>& anchor_points{anchorPoints()};
-        const std::vector<value_type>& ddys{m_vec_of_s.ddys()};
+        const param_vector_type& arc_lengths{arcLengths()};
+        const value_vector_type& anchor_points{anchorPoints()};
+        const value_vector_type& ddys{m_vec_of_s.ddys()};
         const std::size_t size{arc_lengths.size()};
         const std::size_t pos =
             nearestUpperElement(
@@ -531,9 +577,9 @@ class [[nodiscard]] PiecewiseCubicCurve final {
         if (start_s > end_s) {
             std::swap(start_s, end_s);
         }
-        const std::vector<param_type>& arc_lengths{arcLengths()};
-        const std::vector<value_type>& anchor_points{anchorPoints()};
-        const std::vector<value_type>& ddys{m_vec_of_s.ddys()};
+        const param_vector_type& arc_lengths{arcLengths()};
+        const value_vector_type& anchor_points{anchorPoints()};
+        const value_vector_type& ddys{m_vec_of_s.ddys()};
         const std::size_t istart =
             nearestUpperElement(
                 std::ranges::subrange{arc_lengths.cbegin(), arc_lengths.cend()}, start_s
@@ -611,9 +657,9 @@ class [[nodiscard]] PiecewiseCubicCurve final {
         requires InstanceOfTemplate<value_type, Vec3>
     {
         constexpr std::array<param_type, 2> kFactors{-(1.0 / 3.0), -(1.0 / 6.0)};
-        const std::vector<param_type>& arc_lengths{arcLengths()};
-        const std::vector<value_type>& anchor_points{anchorPoints()};
-        const std::vector<value_type>& ddys{m_vec_of_s.ddys()};
+        const param_vector_type& arc_lengths{arcLengths()};
+        const value_vector_type& anchor_points{anchorPoints()};
+        const value_vector_type& ddys{m_vec_of_s.ddys()};
         const std::size_t size{arc_lengths.size()};
         const std::size_t pos =
             nearestUpperElement(
@@ -679,9 +725,9 @@ class [[nodiscard]] PiecewiseCubicCurve final {
         if (start_s > end_s) {
             std::swap(start_s, end_s);
         }
-        const std::vector<param_type>& arc_lengths{arcLengths()};
-        const std::vector<value_type>& anchor_points{anchorPoints()};
-        const std::vector<value_type>& ddys{m_vec_of_s.ddys()};
+        const param_vector_type& arc_lengths{arcLengths()};
+        const value_vector_type& anchor_points{anchorPoints()};
+        const value_vector_type& ddys{m_vec_of_s.ddys()};
         const std::size_t istart =
             nearestUpperElement(
                 std::ranges::subrange{arc_lengths.cbegin(), arc_lengths.cend()}, start_s
@@ -804,22 +850,46 @@ class [[nodiscard]] PiecewiseCubicCurve final {
     }
 
     [[using gnu: pure, always_inline]]
-    auto arcLengths() const noexcept -> const std::vector<param_type>& {
+    auto arcLengths() const noexcept -> const param_vector_type& {
         return m_vec_of_s.ts();
     }
 
     [[using gnu: pure, always_inline]]
-    auto anchorPoints() const noexcept -> const std::vector<value_type>& {
+    auto anchorPoints() const noexcept -> const value_vector_type& {
         return m_vec_of_s.ys();
     }
 
+    [[using gnu: always_inline]]
+    auto writeFlat(FlatWriter& writer, FlatKind kind = kFlatKind) const -> void {
+        m_vec_of_s.writeFlat(writer, kind);
+        return;
+    }
+
+    /**
+     * @brief Rebuilds the curve from a flat record, validated as in the fromFlat of its function
+     * of arc length.
+     */
+    [[using gnu: always_inline]]
+    static auto fromFlat(const FlatRecord& record, FlatKind kind = kFlatKind)
+        -> PiecewiseCubicCurve {
+        return PiecewiseCubicCurve{
+            PiecewiseCubicFunction1<value_type, param_type, Alloc>::fromFlat(record, kind)
+        };
+    }
+
   private:
+    [[using gnu: always_inline]]
+    explicit PiecewiseCubicCurve(
+        PiecewiseCubicFunction1<value_type, param_type, Alloc> vec_of_s
+    ) noexcept
+        : m_vec_of_s{std::move(vec_of_s)} {}
+
     [[using gnu: pure, flatten, leaf, hot]]
     auto process(std::size_t pos, param_type ratio) const noexcept
         -> std::tuple<value_type, value_type, value_type> {
-        const std::vector<param_type>& arc_lengths{arcLengths()};
-        const std::vector<value_type>& anchor_points{anchorPoints()};
-        const std::vector<value_type>& ddys{m_vec_of_s.ddys()};
+        const param_vector_type& arc_lengths{arcLengths()};
+        const value_vector_type& anchor_points{anchorPoints()};
+        const value_vector_type& ddys{m_vec_of_s.ddys()};
         const double h{arc_lengths[pos] - arc_lengths[pos - 1]};
         const value_type val{
             cuberp(anchor_points[pos - 1], anchor_points[pos], ddys[pos - 1], ddys[pos], ratio, h)
@@ -831,13 +901,36 @@ class [[nodiscard]] PiecewiseCubicCurve final {
         return {val, derivative, derivative2};
     }
 
+    [[using gnu: pure]]
+    auto segmentCurvatureExtrema(std::size_t i, param_type r0, param_type r1) const noexcept
+        -> std::pair<param_type, param_type>
+        requires InstanceOfTemplate<value_type, Vec2>
+    {
+        const param_vector_type& arc_lengths{arcLengths()};
+        const value_vector_type& anchor_points{anchorPoints()};
+        const value_vector_type& ddys{m_vec_of_s.ddys()};
+        const std::array<value_type, 4> coeffs{cuberpPoly(
+            anchor_points[i], anchor_points[i + 1], ddys[i], ddys[i + 1],
+            arc_lengths[i + 1] - arc_lengths[i]
+        )};
+        std::array<param_type, 4> xs;
+        std::array<param_type, 4> ys;
+        for (std::size_t k{0}; k < 4; ++k) {
+            xs[k] = coeffs[k].x;
+            ys[k] = coeffs[k].y;
+        }
+        return polycurvatureExtrema(xs, ys, r0, r1);
+    }
+
     [[using gnu: always_inline]]
     auto serialize(auto& archive, [[maybe_unused]] const unsigned int version) noexcept -> void {
         archive & m_vec_of_s;
+        m_curvature_tree.reset();
         return;
     }
 
-    PiecewiseCubicFunction1<value_type, param_type> m_vec_of_s{};
+    PiecewiseCubicFunction1<value_type, param_type, Alloc> m_vec_of_s{};
+    LazyExtremaTree<param_type> m_curvature_tree{};
 };
 
 using PiecewiseCubicCurve2f = PiecewiseCubicCurve<Vec2f>;
@@ -846,4 +939,31 @@ using PiecewiseCubicCurve2d = PiecewiseCubicCurve<Vec2d>;
 using PiecewiseCubicCurve3f = PiecewiseCubicCurve<Vec3f>;
 using PiecewiseCubicCurve3d = PiecewiseCubicCurve<Vec3d>;
 
+namespace pmr {
+
+template <VecArithmetic T, std::floating_point U = typename T::value_type>
+using PiecewiseCubicCurve =
+    ::boyle::math::PiecewiseCubicCurve<T, U, std::pmr::polymorphic_allocator<T>>;
+
+using PiecewiseCubicCurve2f = PiecewiseCubicCurve<Vec2f>;
+using PiecewiseCubicCurve2d = PiecewiseCubicCurve<Vec2d>;
+
+using PiecewiseCubicCurve3f = PiecewiseCubicCurve<Vec3f>;
+using PiecewiseCubicCurve3d = PiecewiseCubicCurve<Vec3d>;
+
+} // namespace pmr
+
+namespace view {
+
+template <VecArithmetic T, std::floating_point U = typename T::value_type>
+using PiecewiseCubicCurve = ::boyle::math::PiecewiseCubicCurve<T, U, ExternalStorage>;
+
+using PiecewiseCubicCurve2f = PiecewiseCubicCurve<Vec2f>;
+using PiecewiseCubicCurve2d = PiecewiseCubicCurve<Vec2d>;
+
+using PiecewiseCubicCurve3f = PiecewiseCubicCurve<Vec3f>;
+using PiecewiseCubicCurve3d = PiecewiseCubicCurve<Vec3d>;
+
+} // namespace view
+
 } // namespace boyle::math
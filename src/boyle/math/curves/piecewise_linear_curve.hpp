@@ -14,6 +14,8 @@
 
 #include <concepts>
 #include <limits>
+#include <memory>
+#include <memory_resource>
 #include <ranges>
 #include <stdexcept>
 #include <utility>
@@ -24,6 +26,7 @@
 
 #include "boyle/math/concepts.hpp"
 #include "boyle/math/duplet.hpp"
+#include "boyle/math/flat_file.hpp"
 #include "boyle/math/functions/piecewise_linear_function1.hpp"
 #include "boyle/math/triplet.hpp"
 #include "boyle/math/utils.hpp"
@@ -32,15 +35,20 @@
 
 namespace boyle::math {
 
-template <VecArithmetic T, std::floating_point U = typename T::value_type>
+template <VecArithmetic T, std::floating_point U = typename T::value_type,
+          typename Alloc = std::allocator<T>>
 class [[nodiscard]] PiecewiseLinearCurve final {
     friend class boost::serialization::access;
 
   public:
     using value_type = T;
     using param_type = U;
+    using allocator_type = Alloc;
+    using param_vector_type = StorageVector<param_type, Alloc>;
+    using value_vector_type = StorageVector<value_type, Alloc>;
 
     static constexpr value_type kDuplicateCriterion{1E-8};
+    static constexpr FlatKind kFlatKind{FlatKind::PIECEWISE_LINEAR_CURVE};
 
     PiecewiseLinearCurve() noexcept = default;
     PiecewiseLinearCurve(const PiecewiseLinearCurve& other) noexcept = default;
@@ -51,8 +59,9 @@ class [[nodiscard]] PiecewiseLinearCurve final {
 
     [[using gnu: ]]
     explicit PiecewiseLinearCurve(
-        std::vector<value_type> anchor_points, param_type s0 = 0.0
-    ) noexcept(!BOYLE_CHECK_PARAMS) {
+        value_vector_type anchor_points, param_type s0 = 0.0
+    ) noexcept(!BOYLE_CHECK_PARAMS)
+        : m_vec_of_s{anchor_points.get_allocator()} {
 #if BOYLE_CHECK_PARAMS == 1
         if (anchor_points.size() < 2) [[unlikely]] {
             throw std::invalid_argument(fmt::format(
@@ -63,13 +72,13 @@ class [[nodiscard]] PiecewiseLinearCurve final {
         }
 #endif
         const std::size_t size{anchor_points.size()};
-        std::vector<param_type> arc_lengths(size);
+        param_vector_type arc_lengths(size, anchor_points.get_allocator());
         arc_lengths[0] = s0;
         for (std::size_t i{1}; i < size; ++i) {
             arc_lengths[i] =
                 arc_lengths[i - 1] + anchor_points[i].euclideanTo(anchor_points[i - 1]);
         }
-        m_vec_of_s = PiecewiseLinearFunction1<value_type, param_type>{
+        m_vec_of_s = PiecewiseLinearFunction1<value_type, param_type, Alloc>{
             std::move(arc_lengths), std::move(anchor_points)
         };
     }
@@ -83,8 +92,8 @@ class [[nodiscard]] PiecewiseLinearCurve final {
     auto eval(param_type s, param_type l) const noexcept -> value_type
         requires InstanceOfTemplate<value_type, Vec2>
     {
-        const std::vector<param_type>& arc_lengths{arcLengths()};
-        const std::vector<value_type>& anchor_points{anchorPoints()};
+        const param_vector_type& arc_lengths{arcLengths()};
+        const value_vector_type& anchor_points{anchorPoints()};
         const std::size_t size{arc_lengths.size()};
         const std::size_t pos =
             nearestUpperElement(
@@ -135,8 +144,8 @@ class [[nodiscard]] PiecewiseLinearCurve final {
     auto eval(param_type s, param_type l, param_type v) const noexcept -> value_type
         requires InstanceOfTemplate<value_type, Vec3>
     {
-        const std::vector<param_type>& arc_lengths{arcLengths()};
-        const std::vector<value_type>& anchor_points{anchorPoints()};
+        const param_vector_type& arc_lengths{arcLengths()};
+        const value_vector_type& anchor_points{anchorPoints()};
         const std::size_t size{arc_lengths.size()};
         const std::size_t pos =
             nearestUpperElement(
@@ -203,8 +212,8 @@ class [[nodiscard]] PiecewiseLinearCurve final {
     auto normal(param_type s) const noexcept -> value_type
         requires InstanceOfTemplate<value_type, Vec2>
     {
-        const std::vector<param_type>& arc_lengths{arcLengths()};
-        const std::vector<value_type>& anchor_points{anchorPoints()};
+        const param_vector_type& arc_lengths{arcLengths()};
+        const value_vector_type& anchor_points{anchorPoints()};
         const std::size_t size{arc_lengths.size()};
         const std::size_t pos =
             nearestUpperElement(
@@ -240,8 +249,8 @@ class [[nodiscard]] PiecewiseLinearCurve final {
     auto normal(param_type s) const noexcept -> value_type
         requires InstanceOfTemplate<value_type, Vec3>
     {
-        const std::vector<param_type>& arc_lengths{arcLengths()};
-        const std::vector<value_type>& anchor_points{anchorPoints()};
+        const param_vector_type& arc_lengths{arcLengths()};
+        const value_vector_type& anchor_points{anchorPoints()};
         const std::size_t size{arc_lengths.size()};
         const std::size_t pos =
             nearestUpperElement(
@@ -274,8 +283,8 @@ class [[nodiscard]] PiecewiseLinearCurve final {
     auto binormal(param_type s) const noexcept -> value_type
         requires InstanceOfTemplate<value_type, Vec3>
     {
-        const std::vector<param_type>& arc_lengths{arcLengths()};
-        const std::vector<value_type>& anchor_points{anchorPoints()};
+        const param_vector_type& arc_lengths{arcLengths()};
+        const value_vector_type& anchor_points{anchorPoints()};
         const std::size_t size{arc_lengths.size()};
         const std::size_t pos =
             nearestUpperElement(
@@ -320,8 +329,8 @@ class [[nodiscard]] PiecewiseLinearCurve final {
     auto inverse(value_type point) const noexcept -> SlDuplet<param_type>
         requires InstanceOfTemplate<value_type, Vec2>
     {
-        const std::vector<param_type>& arc_lengths{arcLengths()};
-        const std::vector<value_type>& anchor_points{anchorPoints()};
+        const param_vector_type& arc_lengths{arcLengths()};
+        const value_vector_type& anchor_points{anchorPoints()};
         const std::size_t size{anchorPoints().size()};
         const std::size_t pos =
             nearestUpperElement(
@@ -375,8 +384,8 @@ class [[nodiscard]] PiecewiseLinearCurve final {
         if (start_s > end_s) {
             std::swap(start_s, end_s);
         }
-        const std::vector<param_type>& arc_lengths{arcLengths()};
-        const std::vector<value_type>& anchor_points{anchorPoints()};
+        const param_vector_type& arc_lengths{arcLengths()};
+        const value_vector_type& anchor_points{anchorPoints()};
         const std::size_t size{anchorPoints().size()};
         const std::size_t istart =
             nearestUpperElement(
@@ -443,8 +452,8 @@ class [[nodiscard]] PiecewiseLinearCurve final {
     auto inverse([[maybe_unused]] value_type point) const noexcept -> SlvTriplet<param_type>
         requires InstanceOfTemplate<value_type, Vec3>
     {
-        const std::vector<param_type>& arc_lengths{arcLengths()};
-        const std::vector<value_type>& anchor_points{anchorPoints()};
+        const param_vector_type& arc_lengths{arcLengths()};
+        const value_vector_type& anchor_points{anchorPoints()};
         const std::size_t size{anchorPoints().size()};
         const std::size_t pos =
             nearestUpperElement(
@@ -499,8 +508,8 @@ class [[nodiscard]] PiecewiseLinearCurve final {
         if (start_s > end_s) {
             std::swap(start_s, end_s);
         }
-        const std::vector<param_type>& arc_lengths{arcLengths()};
-        const std::vector<value_type>& anchor_points{anchorPoints()};
+        const param_vector_type& arc_lengths{arcLengths()};
+        const value_vector_type& anchor_points{anchorPoints()};
         const std::size_t size{anchorPoints().size()};
         const std::size_t istart =
             nearestUpperElement(
@@ -616,21 +625,45 @@ class [[nodiscard]] PiecewiseLinearCurve final {
     }
 
     [[using gnu: pure, always_inline]]
-    auto arcLengths() const noexcept -> const std::vector<param_type>& {
+    auto arcLengths() const noexcept -> const param_vector_type& {
         return m_vec_of_s.ts();
     }
 
     [[using gnu: pure, always_inline]]
-    auto anchorPoints() const noexcept -> const std::vector<value_type>& {
+    auto anchorPoints() const noexcept -> const value_vector_type& {
         return m_vec_of_s.ys();
     }
 
+    [[using gnu: always_inline]]
+    auto writeFlat(FlatWriter& writer, FlatKind kind = kFlatKind) const -> void {
+        m_vec_of_s.writeFlat(writer, kind);
+        return;
+    }
+
+    /**
+     * @brief Rebuilds the curve from a flat record, validated as in the fromFlat of its function
+     * of arc length.
+     */
+    [[using gnu: always_inline]]
+    static auto fromFlat(const FlatRecord& record, FlatKind kind = kFlatKind)
+        -> PiecewiseLinearCurve {
+        return PiecewiseLinearCurve{
+            PiecewiseLinearFunction1<value_type, param_type, Alloc>::fromFlat(record, kind)
+        };
+    }
+
   private:
+    [[using gnu: always_inline]]
+    explicit PiecewiseLinearCurve(
+        PiecewiseLinearFunction1<value_type, param_type, Alloc> vec_of_s
+    ) noexcept
+        : m_vec_of_s{std::move(vec_of_s)} {}
+
     [[using gnu: pure, flatten, leaf, hot]]
     auto process(std::size_t pos, param_type ratio) const noexcept
         -> std::tuple<value_type, value_type, value_type> {
-        const std::vector<param_type>& arc_lengths{arcLengths()};
-        const std::vector<value_type>& anchor_points{anchorPoints()};
+        const param_vector_type& arc_lengths{arcLengths()};
+        const value_vector_type& anchor_points{anchorPoints()};
         const value_type val{lerp(anchor_points[pos - 1], anchor_points[pos], ratio)};
         const value_type diff{anchor_points[pos] - anchor_points[pos - 1]};
         const value_type diff2{
@@ -648,7 +681,7 @@ class [[nodiscard]] PiecewiseLinearCurve final {
         return;
     }
 
-    PiecewiseLinearFunction1<value_type, param_type> m_vec_of_s{};
+    PiecewiseLinearFunction1<value_type, param_type, Alloc> m_vec_of_s{};
 };
 
 using PiecewiseLinearCurve2f = PiecewiseLinearCurve<Vec2f>;
@@ -657,4 +690,31 @@ using PiecewiseLinearCurve2d = PiecewiseLinearCurve<Vec2d>;
 using PiecewiseLinearCurve3f = PiecewiseLinearCurve<Vec3f>;
 using PiecewiseLinearCurve3d = PiecewiseLinearCurve<Vec3d>;
 
+namespace pmr {
+
+template <VecArithmetic T, std::floating_point U = typename T::value_type>
+using PiecewiseLinearCurve =
+    ::boyle::math::PiecewiseLinearCurve<T, U, std::pmr::polymorphic_allocator<T>>;
+
+using PiecewiseLinearCurve2f = PiecewiseLinearCurve<Vec2f>;
+using PiecewiseLinearCurve2d = PiecewiseLinearCurve<Vec2d>;
+
+using PiecewiseLinearCurve3f = PiecewiseLinearCurve<Vec3f>;
+using PiecewiseLinearCurve3d = PiecewiseLinearCurve<Vec3d>;
+
+} // namespace pmr
+
+namespace view {
+
+template <VecArithmetic T, std::floating_point U = typename T::value_type>
+using PiecewiseLinearCurve = ::boyle::math::PiecewiseLinearCurve<T, U, ExternalStorage>;
+
+using PiecewiseLinearCurve2f = PiecewiseLinearCurve<Vec2f>;
+using PiecewiseLinearCurve2d = PiecewiseLinearCurve<Vec2d>;
+
+using PiecewiseLinearCurve3f = PiecewiseLinearCurve<Vec3f>;
+using PiecewiseLinearCurve3d = PiecewiseLinearCurve<Vec3d>;
+
+} // namespace view
+
 } // namespace boyle::math
@@ -15,6 +15,8 @@
 #include <algorithm>
 #include <array>
 #include <concepts>
+#include <memory>
+#include <memory_resource>
 #include <ranges>
 #include <stdexcept>
 #include <utility>
@@ -26,7 +28,10 @@
 #include "boyle/math/concepts.hpp"
 #include "boyle/math/cubic_interpolation.hpp"
 #include "boyle/math/duplet.hpp"
+#include "boyle/math/extrema_tree.hpp"
+#include "boyle/math/flat_file.hpp"
 #include "boyle/math/functions/piecewise_quintic_function1.hpp"
+#include "boyle/math/polynomial.hpp"
 #include "boyle/math/quintic_interpolation.hpp"
 #include "boyle/math/triplet.hpp"
 #include "boyle/math/utils.hpp"
@@ -35,16 +40,22 @@
 
 namespace boyle::math {
 
-template <VecArithmetic T, std::floating_point U = typename T::value_type>
+template <VecArithmetic T, std::floating_point U = typename T::value_type,
+          typename Alloc = std::allocator<T>>
 class [[nodiscard]] PiecewiseQuinticCurve final {
     friend class boost::serialization::access;
 
   public:
     using value_type = T;
     using param_type = U;
-    using BoundaryMode = typename PiecewiseQuinticFunction1<value_type, param_type>::BoundaryMode;
+    using allocator_type = Alloc;
+    using param_vector_type = StorageVector<param_type, Alloc>;
+    using value_vector_type = StorageVector<value_type, Alloc>;
+    using BoundaryMode =
+        typename PiecewiseQuinticFunction1<value_type, param_type, Alloc>::BoundaryMode;
 
     static constexpr param_type kDuplicateCriterion{1E-8};
+    static constexpr FlatKind kFlatKind{FlatKind::PIECEWISE_QUINTIC_CURVE};
 
     PiecewiseQuinticCurve() noexcept = default;
     PiecewiseQuinticCurve(const PiecewiseQuinticCurve& other) noexcept = default;
@@ -54,7 +65,7 @@ class [[nodiscard]] PiecewiseQuinticCurve final {
     ~PiecewiseQuinticCurve() noexcept = default;
 
     [[using gnu: always_inline]]
-    explicit PiecewiseQuinticCurve(std::vector<value_type> anchor_points, param_type s0 = 0.0)
+    explicit PiecewiseQuinticCurve(value_vector_type anchor_points, param_type s0 = 0.0)
         : PiecewiseQuinticCurve(
               std::move(anchor_points),
               std::array<BoundaryMode, 2>{
@@ -68,9 +79,10 @@ class [[nodiscard]] PiecewiseQuinticCurve final {
 
     [[using gnu: ]]
     explicit PiecewiseQuinticCurve(
-        std::vector<value_type> anchor_points, std::array<BoundaryMode, 2> b0,
+        value_vector_type anchor_points, std::array<BoundaryMode, 2> b0,
         std::array<BoundaryMode, 2> bf, param_type s0 = 0.0
-    ) noexcept(!BOYLE_CHECK_PARAMS) {
+    ) noexcept(!BOYLE_CHECK_PARAMS)
+        : m_vec_of_s{anchor_points.get_allocator()} {
 #if BOYLE_CHECK_PARAMS == 1
         if (anchor_points.size() < 2) [[unlikely]] {
             throw std::invalid_argument(fmt::format(
@@ -81,19 +93,20 @@ class [[nodiscard]] PiecewiseQuinticCurve final {
         }
 #endif
         const std::size_t size{anchor_points.size()};
-        std::vector<param_type> temp_arc_lengths(size);
+        param_vector_type temp_arc_lengths(size, anchor_points.get_allocator());
         temp_arc_lengths[0] = s0;
         for (std::size_t i{1}; i < size; ++i) {
             temp_arc_lengths[i] =
                 temp_arc_lengths[i - 1] + anchor_points[i].euclideanTo(anchor_points[i - 1]);
         }
-        const PiecewiseQuinticFunction1<value_type, param_type> temp_vec_of_s{
-            temp_arc_lengths, anchor_points, b0, bf
+        const PiecewiseQuinticFunction1<value_type, param_type, Alloc> temp_vec_of_s{
+            param_vector_type(temp_arc_lengths, anchor_points.get_allocator()),
+            value_vector_type(anchor_points, anchor_points.get_allocator()), b0, bf
         };
 
-        const std::vector<value_type>& ddys{temp_vec_of_s.ddys()};
-        const std::vector<value_type>& d4ys{temp_vec_of_s.d4ys()};
-        std::vector<param_type> arc_lengths(size);
+        const value_vector_type& ddys{temp_vec_of_s.ddys()};
+        const value_vector_type& d4ys{temp_vec_of_s.d4ys()};
+        param_vector_type arc_lengths(size, anchor_points.get_allocator());
         arc_lengths[0] = s0;
         for (std::size_t i{1}; i < size; ++i) {
             arc_lengths[i] = arc_lengths[i - 1] + ::boyle::math::calcArcLength(
@@ -102,16 +115,16 @@ class [[nodiscard]] PiecewiseQuinticCurve final {
                                                       temp_arc_lengths[i] - temp_arc_lengths[i - 1]
                                                   );
         }
-        m_vec_of_s = PiecewiseQuinticFunction1<value_type, param_type>{
+        m_vec_of_s = PiecewiseQuinticFunction1<value_type, param_type, Alloc>{
             std::move(arc_lengths), std::move(anchor_points), b0, bf
         };
     }
 
     [[using gnu: ]]
     explicit PiecewiseQuinticCurve(
-        [[maybe_unused]] periodic_tag tag, std::vector<value_type> anchor_points,
-        param_type s0 = 0.0
-    ) noexcept(!BOYLE_CHECK_PARAMS) {
+        [[maybe_unused]] periodic_tag tag, value_vector_type anchor_points, param_type s0 = 0.0
+    ) noexcept(!BOYLE_CHECK_PARAMS)
+        : m_vec_of_s{anchor_points.get_allocator()} {
 #if BOYLE_CHECK_PARAMS == 1
         if (anchor_points.size() < 2) [[unlikely]] {
             throw std::invalid_argument(fmt::format(
@@ -122,19 +135,20 @@ class [[nodiscard]] PiecewiseQuinticCurve final {
         }
 #endif
         const std::size_t size{anchor_points.size()};
-        std::vector<param_type> temp_arc_lengths(size);
+        param_vector_type temp_arc_lengths(size, anchor_points.get_allocator());
         temp_arc_lengths[0] = s0;
         for (std::size_t i{1}; i < size; ++i) {
             temp_arc_lengths[i] =
                 temp_arc_lengths[i - 1] + anchor_points[i].euclideanTo(anchor_points[i - 1]);
         }
-        const PiecewiseQuinticFunction1<value_type, param_type> temp_vec_of_s{
-            tag, temp_arc_lengths, anchor_points
+        const PiecewiseQuinticFunction1<value_type, param_type, Alloc> temp_vec_of_s{
+            tag, param_vector_type(temp_arc_lengths, anchor_points.get_allocator()),
+            value_vector_type(anchor_points, anchor_points.get_allocator())
         };
 
-        const std::vector<value_type>& ddys{temp_vec_of_s.ddys()};
-        const std::vector<value_type>& d4ys{temp_vec_of_s.d4ys()};
-        std::vector<param_type> arc_lengths(size);
+        const value_vector_type& ddys{temp_vec_of_s.ddys()};
+        const value_vector_type& d4ys{temp_vec_of_s.d4ys()};
+        param_vector_type arc_lengths(size, anchor_points.get_allocator());
         arc_lengths[0] = s0;
         for (std::size_t i{1}; i < size; ++i) {
             arc_lengths[i] = arc_lengths[i - 1] + ::boyle::math::calcArcLength(
@@ -143,11 +157,74 @@ class [[nodiscard]] PiecewiseQuinticCurve final {
                                                       temp_arc_lengths[i] - temp_arc_lengths[i - 1]
                                                   );
         }
-        m_vec_of_s = PiecewiseQuinticFunction1<value_type, param_type>{
+        m_vec_of_s = PiecewiseQuinticFunction1<value_type, param_type, Alloc>{
             tag, std::move(arc_lengths), std::move(anchor_points)
         };
     }
 
+    /**
+     * @brief Re-parameterizes by arc length a quintic spline given over any parameter ts, e.g. the
+     * knots, second and fourth derivatives coming straight out of an optimizer. Arc lengths are
+     * integrated on that spline itself, so only the final fit over arc length is solved, with the
+     * unit tangent and curvature vector at both ends as boundary conditions.
+     */
+    [[using gnu: ]]
+    explicit PiecewiseQuinticCurve(
+        const param_vector_type& ts, value_vector_type anchor_points, const value_vector_type& ddys,
+        const value_vector_type& d4ys, param_type s0 = 0.0
+    ) noexcept(!BOYLE_CHECK_PARAMS)
+        : m_vec_of_s{anchor_points.get_allocator()} {
+#if BOYLE_CHECK_PARAMS == 1
+        if (ts.size() < 2 || anchor_points.size() != ts.size() || ddys.size() != ts.size() ||
+            d4ys.size() != ts.size()) [[unlikely]] {
+            throw std::invalid_argument(fmt::format(
+                "Invalid arguments detected! ts, anchor_points, ddys, d4ys must share the same "
+                "size no less than 2: ts.size() = {0:d}, anchor_points.size() = {1:d}, "
+                "ddys.size() = {2:d}, d4ys.size() = {3:d}.",
+                ts.size(), anchor_points.size(), ddys.size(), d4ys.size()
+            ));
+        }
+#endif
+        const std::size_t size{ts.size()};
+        param_vector_type arc_lengths(size, anchor_points.get_allocator());
+        arc_lengths[0] = s0;
+        for (std::size_t i{1}; i < size; ++i) {
+            arc_lengths[i] = arc_lengths[i - 1] + ::boyle::math::calcArcLength(
+                                                      anchor_points[i - 1], anchor_points[i],
+                                                      ddys[i - 1], ddys[i], d4ys[i - 1], d4ys[i],
+                                                      ts[i] - ts[i - 1]
+                                                  );
+        }
+        const auto boundary = [](value_type derivative, value_type derivative2
+                              ) noexcept -> std::array<BoundaryMode, 2> {
+            const param_type speed{derivative.euclidean()};
+            const value_type tangent{derivative / speed};
+            return std::array<BoundaryMode, 2>{
+                BoundaryMode{1, tangent},
+                BoundaryMode{
+                    2, (derivative2 - tangent * tangent.dot(derivative2)) / (speed * speed)
+                }
+            };
+        };
+        const std::array<BoundaryMode, 2> b0{boundary(
+            quinerpd(
+                anchor_points[0], anchor_points[1], ddys[0], ddys[1], d4ys[0], d4ys[1],
+                param_type{0.0}, ts[1] - ts[0]
+            ),
+            ddys[0]
+        )};
+        const std::array<BoundaryMode, 2> bf{boundary(
+            quinerpd(
+                anchor_points[size - 2], anchor_points[size - 1], ddys[size - 2], ddys[size - 1],
+                d4ys[size - 2], d4ys[size - 1], param_type{1.0}, ts[size - 1] - ts[size - 2]
+            ),
+            ddys[size - 1]
+        )};
+        m_vec_of_s = PiecewiseQuinticFunction1<value_type, param_type, Alloc>{
+            std::move(arc_lengths), std::move(anchor_points), b0, bf
+        };
+    }
+
     [[using gnu: pure, always_inline]]
     auto eval(param_type s) const noexcept -> value_type {
         return m_vec_of_s.eval(s);
@@ -160,10 +237,10 @@ class [[nodiscard]] PiecewiseQuinticCurve final {
         constexpr std::array<param_type, 4> kFactors{
             -(1.0 / 3.0), -(1.0 / 6.0), 1.0 / 45.0, 7.0 / 360.0
         };
-        const std::vector<param_type>& arc_lengths{arcLengths()};
-        const std::vector<value_type>& anchor_points{anchorPoints()};
-        const std::vector<value_type>& ddys{m_vec_of_s.ddys()};
-        const std::vector<value_type>& d4ys{m_vec_of_s.d4ys()};
+        const param_vector_type& arc_lengths{arcLengths()};
+        const value_vector_type& anchor_points{anchorPoints()};
+        const value_vector_type& ddys{m_vec_of_s.ddys()};
+        const value_vector_type& d4ys{m_vec_of_s.d4ys()};
         const std::size_t size{arc_lengths.size()};
         const std::size_t pos =
             nearestUpperElement(
@@ -232,10 +309,10 @@ class [[nodiscard]] PiecewiseQuinticCurve final {
         constexpr std::array<param_type, 4> kFactors{
             -(1.0 / 3.0), -(1.0 / 6.0), 1.0 / 45.0, 7.0 / 360.0
         };
-        const std::vector<param_type>& arc_lengths{arcLengths()};
-        const std::vector<value_type>& anchor_points{anchorPoints()};
-        const std::vector<value_type>& ddys{m_vec_of_s.ddys()};
-        const std::vector<value_type>& d4ys{m_vec_of_s.d4ys()};
+        const param_vector_type& arc_lengths{arcLengths()};
+        const value_vector_type& anchor_points{anchorPoints()};
+        const value_vector_type& ddys{m_vec_of_s.ddys()};
+        const value_vector_type& d4ys{m_vec_of_s.d4ys()};
         const std::size_t size{arc_lengths.size()};
         const std::size_t pos =
             nearestUpperElement(
@@ -317,10 +394,10 @@ class [[nodiscard]] PiecewiseQuinticCurve final {
         constexpr std::array<param_type, 4> kFactors{
             -(1.0 / 3.0), -(1.0 / 6.0), 1.0 / 45.0, 7.0 / 360.0
         };
-        const std::vector<param_type>& arc_lengths{arcLengths()};
-        const std::vector<value_type>& anchor_points{anchorPoints()};
-        const std::vector<value_type>& ddys{m_vec_of_s.ddys()};
-        const std::vector<value_type>& d4ys{m_vec_of_s.d4ys()};
+        const param_vector_type& arc_lengths{arcLengths()};
+        const value_vector_type& anchor_points{anchorPoints()};
+        const value_vector_type& ddys{m_vec_of_s.ddys()};
+        const value_vector_type& d4ys{m_vec_of_s.d4ys()};
         const std::size_t size{arc_lengths.size()};
         const std::size_t pos =
             nearestUpperElement(
@@ -364,10 +441,10 @@ class [[nodiscard]] PiecewiseQuinticCurve final {
         constexpr std::array<param_type, 4> kFactors{
             -(1.0 / 3.0), -(1.0 / 6.0), 1.0 / 45.0, 7.0 / 360.0
         };
-        const std::vector<param_type>& arc_lengths{arcLengths()};
-        const std::vector<value_type>& anchor_points{anchorPoints()};
-        const std::vector<value_type>& ddys{m_vec_of_s.ddys()};
-        const std::vector<value_type>& d4ys{m_vec_of_s.d4ys()};
+        const param_vector_type& arc_lengths{arcLengths()};
+        const value_vector_type& anchor_points{anchorPoints()};
+        const value_vector_type& ddys{m_vec_of_s.ddys()};
+        const value_vector_type& d4ys{m_vec_of_s.d4ys()};
         const std::size_t size{arc_lengths.size()};
         const std::size_t pos =
             nearestUpperElement(
@@ -408,10 +485,10 @@ class [[nodiscard]] PiecewiseQuinticCurve final {
         constexpr std::array<param_type, 4> kFactors{
             -(1.0 / 3.0), -(1.0 / 6.0), 1.0 / 45.0, 7.0 / 360.0
         };
-        const std::vector<param_type>& arc_lengths{arcLengths()};
-        const std::vector<value_type>& anchor_points{anchorPoints()};
-        const std::vector<value_type>& ddys{m_vec_of_s.ddys()};
-        const std::vector<value_type>& d4ys{m_vec_of_s.d4ys()};
+        const param_vector_type& arc_lengths{arcLengths()};
+        const value_vector_type& anchor_points{anchorPoints()};
+        const value_vector_type& ddys{m_vec_of_s.ddys()};
+        const value_vector_type& d4ys{m_vec_of_s.d4ys()};
         const std::size_t size{arc_lengths.size()};
         const std::size_t pos =
             nearestUpperElement(
@@ -447,7 +524,7 @@ class [[nodiscard]] PiecewiseQuinticCurve final {
 
     [[using gnu: pure, flatten, leaf, hot]]
     auto curvature(param_type s) const noexcept -> param_type {
-        const std::vector<param_type>& arc_lengths{arcLengths()};
+        const param_vector_type& arc_lengths{arcLengths()};
         const std::size_t size{arc_lengths.size()};
         const std::size_t pos =
             nearestUpperElement(
@@ -469,13 +546,44 @@ class [[nodiscard]] PiecewiseQuinticCurve final {
                (derivative_norm * derivative_norm * derivative_norm);
     }
 
+    /**
+     * @brief Minimum and maximum curvature over [s0, s1], clipped to the arc length range. The
+     * first call builds a segment tree over the curvature extrema of every segment; later calls
+     * take O(log n).
+     */
+    [[using gnu: always_inline]]
+    auto curvatureExtrema(param_type s0, param_type s1) const -> std::pair<param_type, param_type>
+        requires InstanceOfTemplate<value_type, Vec2>
+    {
+        return windowExtrema(
+            m_curvature_tree, arcLengths(), s0, s1,
+            [this](std::size_t i, param_type r0, param_type r1) {
+                return segmentCurvatureExtrema(i, r0, r1);
+            }
+        );
+    }
+
+    [[using gnu: always_inline]]
+    auto minCurvature(param_type s0, param_type s1) const -> param_type
+        requires InstanceOfTemplate<value_type, Vec2>
+    {
+        return curvatureExtrema(s0, s1).first;
+    }
+
+    [[using gnu: always_inline]]
+    auto maxCurvature(param_type s0, param_type s1) const -> param_type
+        requires InstanceOfTemplate<value_type, Vec2>
+    {
+        return curvatureExtrema(s0, s1).second;
+    }
+
     [[using gnu: pure, always_inline]]
     auto torsion(param_type s) const noexcept -> param_type
         requires InstanceOfTemplate<value_type, Vec3>
     {
-        const std::vector<param_type>& arc_lengths{arcLengths()};
-        const std::vector<value_type>& ddys{m_vec_of_s.ddys()};
-        const std::vector<value_type>& d4ys{m_vec_of_s.d4ys()};
+        const param_vector_type& arc_lengths{arcLengths()};
+        const value_vector_type& ddys{m_vec_of_s.ddys()};
+        const value_vector_type& d4ys{m_vec_of_s.d4ys()};
         const std::size_t size{arc_lengths.size()};
         const std::size_t pos =
             nearestUpperElement(
@@ -507,10 +615,10 @@ class [[nodiscard]] PiecewiseQuinticCurve final {
         constexpr std::array<param_type, 4> kFactors{
             -(1.0 / 3.0), -(1.0 / 6.0), 1.0 / 45.0, 7.0 / 360.0
         };
-        const std::vector<param_type>& arc_lengths{arcLengths()};
-        const std::vector<value_type>& anchor_points{anchorPoints()};
-        const std::vector<value_type>& ddys{m_vec_of_s.ddys()};
-        const std::vector<value_type>& d4ys{m_vec_of_s.d4ys()};
+        const param_vector_type& arc_lengths{arcLengths()};
+        const value_vector_type& anchor_points{anchorPoints()};
+        const value_vector_type& ddys{m_vec_of_s.ddys()};
+        const value_vector_type& d4ys{m_vec_of_s.d4ys()};
         const std::size_t size{arc_lengths.size()};
         const std::size_t pos =
             nearestUpperElement(
@@ -582,10 +690,10 @@ class [[nodiscard]] PiecewiseQuinticCurve final {
         if (start_s > end_s) {
             std::swap(start_s, end_s);
         }
-        const std::vector<param_type>& arc_lengths{arcLengths()};
-        const std::vector<value_type>& anchor_points{anchorPoints()};
-        const std::vector<value_type>& ddys{m_vec_of_s.ddys()};
-        const std::vector<value_type>& d4ys{m_vec_of_s.d4ys()};
+        const param_vector_type& arc_lengths{arcLengths()};
+        const value_vector_type& anchor_points{anchorPoints()};
+        const value_vector_type& ddys{m_vec_of_s.ddys()};
+        const value_vector_type& d4ys{m_vec_of_s.d4ys()};
         const std::size_t istart =
             nearestUpperElement(
                 std::ranges::subrange{arc_lengths.cbegin(), arc_lengths.cend()}, start_s
@@ -667,10 +775,10 @@ class [[nodiscard]] PiecewiseQuinticCurve final {
         constexpr std::array<param_type, 4> kFactors{
             -(1.0 / 3.0), -(1.0 / 6.0), 1.0 / 45.0, 7.0 / 360.0
         };
-        const std::vector<param_type>& arc_lengths{arcLengths()};
-        const std::vector<value_type>& anchor_points{anchorPoints()};
-        const std::vector<value_type>& ddys{m_vec_of_s.ddys()};
-        const std::vector<value_type>& d4ys{m_vec_of_s.d4ys()};
+        const param_vector_type& arc_lengths{arcLengths()};
+        const value_vector_type& anchor_points{anchorPoints()};
+        const value_vector_type& ddys{m_vec_of_s.ddys()};
+        const value_vector_type& d4ys{m_vec_of_s.d4ys()};
         const std::size_t size{arc_lengths.size()};
         const std::size_t pos =
             nearestUpperElement(
@@ -740,10 +848,10 @@ class [[nodiscard]] PiecewiseQuinticCurve final {
         if (start_s > end_s) {
             std::swap(start_s, end_s);
         }
-        const std::vector<param_type>& arc_lengths{arcLengths()};
-        const std::vector<value_type>& anchor_points{anchorPoints()};
-        const std::vector<value_type>& ddys{m_vec_of_s.ddys()};
-        const std::vector<value_type>& d4ys{m_vec_of_s.d4ys()};
+        const param_vector_type& arc_lengths{arcLengths()};
+        const value_vector_type& anchor_points{anchorPoints()};
+        const value_vector_type& ddys{m_vec_of_s.ddys()};
+        const value_vector_type& d4ys{m_vec_of_s.d4ys()};
         const std::size_t istart =
             nearestUpperElement(
                 std::ranges::subrange{arc_lengths.cbegin(), arc_lengths.cend()}, start_s
@@ -868,23 +976,57 @@ class [[nodiscard]] PiecewiseQuinticCurve final {
     }
 
     [[using gnu: pure, always_inline]]
-    auto arcLengths() const noexcept -> const std::vector<param_type>& {
+    auto arcLengths() const noexcept -> const param_vector_type& {
         return m_vec_of_s.ts();
     }
 
     [[using gnu: pure, always_inline]]
-    auto anchorPoints() const noexcept -> const std::vector<value_type>& {
+    auto anchorPoints() const noexcept -> const value_vector_type& {
         return m_vec_of_s.ys();
     }
 
+    [[using gnu: pure, always_inline]]
+    auto ddys() const noexcept -> const value_vector_type& {
+        return m_vec_of_s.ddys();
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto d4ys() const noexcept -> const value_vector_type& {
+        return m_vec_of_s.d4ys();
+    }
+
+    [[using gnu: always_inline]]
+    auto writeFlat(FlatWriter& writer, FlatKind kind = kFlatKind) const -> void {
+        m_vec_of_s.writeFlat(writer, kind);
+        return;
+    }
+
+    /**
+     * @brief Rebuilds the curve from a flat record, validated as in the fromFlat of its function
+     * of arc length.
+     */
+    [[using gnu: always_inline]]
+    static auto fromFlat(const FlatRecord& record, FlatKind kind = kFlatKind)
+        -> PiecewiseQuinticCurve {
+        return PiecewiseQuinticCurve{
+            PiecewiseQuinticFunction1<value_type, param_type, Alloc>::fromFlat(record, kind)
+        };
+    }
+
   private:
+    [[using gnu: always_inline]]
+    explicit PiecewiseQuinticCurve(
+        PiecewiseQuinticFunction1<value_type, param_type, Alloc> vec_of_s
+    ) noexcept
+        : m_vec_of_s{std::move(vec_of_s)} {}
+
     [[using gnu: pure, flatten, leaf, hot]]
     auto process(std::size_t pos, param_type ratio) const noexcept
         -> std::tuple<value_type, value_type, value_type> {
-        const std::vector<param_type>& arc_lengths{arcLengths()};
-        const std::vector<value_type>& anchor_points{anchorPoints()};
-        const std::vector<value_type>& ddys{m_vec_of_s.ddys()};
-        const std::vector<value_type>& d4ys{m_vec_of_s.d4ys()};
+        const param_vector_type& arc_lengths{arcLengths()};
+        const value_vector_type& anchor_points{anchorPoints()};
+        const value_vector_type& ddys{m_vec_of_s.ddys()};
+        const value_vector_type& d4ys{m_vec_of_s.d4ys()};
         const double h{arc_lengths[pos] - arc_lengths[pos - 1]};
         const value_type val{quinerp(
             anchor_points[pos - 1], anchor_points[pos], ddys[pos - 1], ddys[pos], d4ys[pos - 1],
@@ -900,13 +1042,37 @@ class [[nodiscard]] PiecewiseQuinticCurve final {
         return {val, derivative, derivative2};
     }
 
+    [[using gnu: pure]]
+    auto segmentCurvatureExtrema(std::size_t i, param_type r0, param_type r1) const noexcept
+        -> std::pair<param_type, param_type>
+        requires InstanceOfTemplate<value_type, Vec2>
+    {
+        const param_vector_type& arc_lengths{arcLengths()};
+        const value_vector_type& anchor_points{anchorPoints()};
+        const value_vector_type& ddys{m_vec_of_s.ddys()};
+        const value_vector_type& d4ys{m_vec_of_s.d4ys()};
+        const std::array<value_type, 6> coeffs{quinerpPoly(
+            anchor_points[i], anchor_points[i + 1], ddys[i], ddys[i + 1], d4ys[i], d4ys[i + 1],
+            arc_lengths[i + 1] - arc_lengths[i]
+        )};
+        std::array<param_type, 6> xs;
+        std::array<param_type, 6> ys;
+        for (std::size_t k{0}; k < 6; ++k) {
+            xs[k] = coeffs[k].x;
+            ys[k] = coeffs[k].y;
+        }
+        return polycurvatureExtrema(xs, ys, r0, r1);
+    }
+
     [[using gnu: always_inline]]
     auto serialize(auto& archive, [[maybe_unused]] const unsigned int version) noexcept -> void {
         archive & m_vec_of_s;
+        m_curvature_tree.reset();
         return;
     }
 
-    PiecewiseQuinticFunction1<value_type, param_type> m_vec_of_s{};
+    PiecewiseQuinticFunction1<value_type, param_type, Alloc> m_vec_of_s{};
+    LazyExtremaTree<param_type> m_curvature_tree{};
 };
 
 using PiecewiseQuinticCurve2f = PiecewiseQuinticCurve<Vec2f>;
@@ -915,4 +1081,31 @@ using PiecewiseQuinticCurve2d = PiecewiseQuinticCurve<Vec2d>;
 using PiecewiseQuinticCurve3f = PiecewiseQuinticCurve<Vec3f>;
 using PiecewiseQuinticCurve3d = PiecewiseQuinticCurve<Vec3d>;
 
+namespace pmr {
+
+template <VecArithmetic T, std::floating_point U = typename T::value_type>
+using PiecewiseQuinticCurve =
+    ::boyle::math::PiecewiseQuinticCurve<T, U, std::pmr::polymorphic_allocator<T>>;
+
+using PiecewiseQuinticCurve2f = PiecewiseQuinticCurve<Vec2f>;
+using PiecewiseQuinticCurve2d = PiecewiseQuinticCurve<Vec2d>;
+
+using PiecewiseQuinticCurve3f = PiecewiseQuinticCurve<Vec3f>;
+using PiecewiseQuinticCurve3d = PiecewiseQuinticCurve<Vec3d>;
+
+} // namespace pmr
+
+namespace view {
+
+template <VecArithmetic T, std::floating_point U = typename T::value_type>
+using PiecewiseQuinticCurve = ::boyle::math::PiecewiseQuinticCurve<T, U, ExternalStorage>;
+
+using PiecewiseQuinticCurve2f = PiecewiseQuinticCurve<Vec2f>;
+using PiecewiseQuinticCurve2d = PiecewiseQuinticCurve<Vec2d>;
+
+using PiecewiseQuinticCurve3f = PiecewiseQuinticCurve<Vec3f>;
+using PiecewiseQuinticCurve3d = PiecewiseQuinticCurve<Vec3d>;
+
+} // namespace view
+
 } // namespace boyle::math
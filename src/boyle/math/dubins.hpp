@@ -0,0 +1,302 @@
+/**
+ * @file dubins.hpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2024-06-22
+ *
+ * @copyright Copyright (c) 2024 Boyle Development Team
+ *            All rights reserved.
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include <span>
+#include <stdexcept>
+#include <utility>
+
+#include "fmt/format.h"
+
+#include "boyle/math/vec2.hpp"
+
+namespace boyle::math {
+
+enum class DubinsSegment : std::uint8_t {
+    LEFT,
+    STRAIGHT,
+    RIGHT
+};
+
+/**
+ * @brief Shortest forward-only path between two poses. Segment lengths are normalized by the
+ * turning radius; an invalid path has infinite lengths.
+ */
+template <std::floating_point T>
+struct [[nodiscard]] DubinsPath final {
+    using value_type = T;
+    std::array<DubinsSegment, 3> types{
+        DubinsSegment::LEFT, DubinsSegment::STRAIGHT, DubinsSegment::LEFT
+    };
+    std::array<value_type, 3> lengths{
+        std::numeric_limits<value_type>::infinity(), 0.0, 0.0
+    };
+    value_type radius{1.0};
+
+    [[using gnu: pure, always_inline]]
+    auto valid() const noexcept -> bool {
+        return std::isfinite(lengths[0]);
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto length() const noexcept -> value_type {
+        return (lengths[0] + lengths[1] + lengths[2]) * radius;
+    }
+};
+
+using DubinsPathf = DubinsPath<float>;
+using DubinsPathd = DubinsPath<double>;
+
+namespace detail {
+
+template <std::floating_point T>
+[[using gnu: const, always_inline]] [[nodiscard]]
+inline auto mod2PiPositive(T x) noexcept -> T {
+    constexpr T kTwoPi{2.0 * std::numbers::pi};
+    return x - kTwoPi * std::floor(x / kTwoPi);
+}
+
+/**
+ * @brief Dubins problem in the normalized frame of Shkel and Lumelsky: the goal sits at distance d
+ * on the x axis, alpha and beta are the start and goal headings relative to that axis. Trigonometry
+ * is shared by all six words, and a word is skipped as soon as a cheap lower bound on its length
+ * exceeds the best one found so far: a CSC word is never shorter than its straight part, and a CCC
+ * word is never shorter than pi.
+ */
+template <std::floating_point T>
+class [[nodiscard]] DubinsSolver final {
+  public:
+    [[using gnu: always_inline]]
+    explicit DubinsSolver(T d, T alpha, T beta) noexcept
+        : m_d{d}, m_alpha{mod2PiPositive(alpha)}, m_beta{mod2PiPositive(beta)},
+          m_sa{std::sin(m_alpha)}, m_sb{std::sin(m_beta)}, m_ca{std::cos(m_alpha)},
+          m_cb{std::cos(m_beta)}, m_cab{std::cos(m_alpha - m_beta)} {}
+
+    [[using gnu: flatten]]
+    auto solve() noexcept -> DubinsPath<T> {
+        lsl();
+        rsr();
+        lsr();
+        rsl();
+        if (m_d < 4.0 && m_length > std::numbers::pi) {
+            rlr();
+            lrl();
+        }
+        return m_path;
+    }
+
+  private:
+    static constexpr T kTwoPi{2.0 * std::numbers::pi};
+
+    auto lsl() noexcept -> void {
+        const T p_sqr{2.0 + m_d * m_d - 2.0 * m_cab + 2.0 * m_d * (m_sa - m_sb)};
+        if (p_sqr < 0.0 || std::sqrt(p_sqr) >= m_length) {
+            return;
+        }
+        const T theta{std::atan2(m_cb - m_ca, m_d + m_sa - m_sb)};
+        m_last = {
+            mod2PiPositive(theta - m_alpha), std::sqrt(p_sqr), mod2PiPositive(m_beta - theta)
+        };
+        accept(DubinsSegment::LEFT, DubinsSegment::STRAIGHT, DubinsSegment::LEFT);
+        return;
+    }
+
+    auto rsr() noexcept -> void {
+        const T p_sqr{2.0 + m_d * m_d - 2.0 * m_cab + 2.0 * m_d * (m_sb - m_sa)};
+        if (p_sqr < 0.0 || std::sqrt(p_sqr) >= m_length) {
+            return;
+        }
+        const T theta{std::atan2(m_ca - m_cb, m_d - m_sa + m_sb)};
+        m_last = {
+            mod2PiPositive(m_alpha - theta), std::sqrt(p_sqr), mod2PiPositive(theta - m_beta)
+        };
+        accept(DubinsSegment::RIGHT, DubinsSegment::STRAIGHT, DubinsSegment::RIGHT);
+        return;
+    }
+
+    auto lsr() noexcept -> void {
+        const T p_sqr{-2.0 + m_d * m_d + 2.0 * m_cab + 2.0 * m_d * (m_sa + m_sb)};
+        if (p_sqr < 0.0) {
+            return;
+        }
+        const T p{std::sqrt(p_sqr)};
+        if (p >= m_length) {
+            return;
+        }
+        const T theta{std::atan2(-m_ca - m_cb, m_d + m_sa + m_sb) - std::atan2(T{-2.0}, p)};
+        m_last = {mod2PiPositive(theta - m_alpha), p, mod2PiPositive(theta - m_beta)};
+        accept(DubinsSegment::LEFT, DubinsSegment::STRAIGHT, DubinsSegment::RIGHT);
+        return;
+    }
+
+    auto rsl() noexcept -> void {
+        const T p_sqr{-2.0 + m_d * m_d + 2.0 * m_cab - 2.0 * m_d * (m_sa + m_sb)};
+        if (p_sqr < 0.0) {
+            return;
+        }
+        const T p{std::sqrt(p_sqr)};
+        if (p >= m_length) {
+            return;
+        }
+        const T theta{std::atan2(m_ca + m_cb, m_d - m_sa - m_sb) - std::atan2(T{2.0}, p)};
+        m_last = {mod2PiPositive(m_alpha - theta), p, mod2PiPositive(m_beta - theta)};
+        accept(DubinsSegment::RIGHT, DubinsSegment::STRAIGHT, DubinsSegment::LEFT);
+        return;
+    }
+
+    auto rlr() noexcept -> void {
+        const T c{(6.0 - m_d * m_d + 2.0 * m_cab + 2.0 * m_d * (m_sa - m_sb)) / 8.0};
+        if (std::abs(c) > 1.0) {
+            return;
+        }
+        const T theta{std::atan2(m_ca - m_cb, m_d - m_sa + m_sb)};
+        const T p{mod2PiPositive(kTwoPi - std::acos(c))};
+        const T t{mod2PiPositive(m_alpha - theta + p * 0.5)};
+        m_last = {t, p, mod2PiPositive(m_alpha - m_beta - t + p)};
+        accept(DubinsSegment::RIGHT, DubinsSegment::LEFT, DubinsSegment::RIGHT);
+        return;
+    }
+
+    auto lrl() noexcept -> void {
+        const T c{(6.0 - m_d * m_d + 2.0 * m_cab + 2.0 * m_d * (m_sb - m_sa)) / 8.0};
+        if (std::abs(c) > 1.0) {
+            return;
+        }
+        const T theta{std::atan2(m_ca - m_cb, m_d + m_sa - m_sb)};
+        const T p{mod2PiPositive(kTwoPi - std::acos(c))};
+        const T t{mod2PiPositive(-m_alpha - theta + p * 0.5)};
+        m_last = {t, p, mod2PiPositive(m_beta - m_alpha - t + p)};
+        accept(DubinsSegment::LEFT, DubinsSegment::RIGHT, DubinsSegment::LEFT);
+        return;
+    }
+
+    [[using gnu: always_inline]]
+    auto accept(DubinsSegment first, DubinsSegment second, DubinsSegment third) noexcept
+        -> void {
+        const T length{m_last[0] + m_last[1] + m_last[2]};
+        if (length < m_length) {
+            m_length = length;
+            m_path.types = {first, second, third};
+            m_path.lengths = m_last;
+        }
+        return;
+    }
+
+    T m_d;
+    T m_alpha;
+    T m_beta;
+    T m_sa;
+    T m_sb;
+    T m_ca;
+    T m_cb;
+    T m_cab;
+    T m_length{std::numeric_limits<T>::infinity()};
+    std::array<T, 3> m_last{};
+    DubinsPath<T> m_path{};
+};
+
+} // namespace detail
+
+/**
+ * @brief Closed-form shortest Dubins path over the six word families (Dubins, 1957), for a car
+ * with the given minimum turning radius that only drives forward.
+ */
+template <std::floating_point T>
+[[using gnu: flatten]] [[nodiscard]]
+inline auto dubinsPath(
+    Vec2<T> start, T start_heading, Vec2<T> goal, T goal_heading, T radius
+) noexcept -> DubinsPath<T> {
+    const Vec2<T> offset{(goal - start) / radius};
+    const T theta{offset.euclidean() < std::numeric_limits<T>::epsilon() ? T{0.0} : offset.angle()};
+    DubinsPath<T> path{detail::DubinsSolver<T>{
+        offset.euclidean(), start_heading - theta, goal_heading - theta
+    }.solve()};
+    path.radius = radius;
+    return path;
+}
+
+/**
+ * @brief Dubins path lengths for many start-goal pairs at once. Meant for heuristic tables and
+ * analytic expansions where the same call is made millions of times: inputs are plain contiguous
+ * arrays and the loop body carries no allocation.
+ */
+template <std::floating_point T>
+inline auto dubinsLengths(
+    std::span<const Vec2<T>> starts, std::span<const T> start_headings,
+    std::span<const Vec2<T>> goals, std::span<const T> goal_headings, T radius,
+    std::span<T> lengths
+) noexcept(!BOYLE_CHECK_PARAMS) -> void {
+    const std::size_t size{starts.size()};
+#if BOYLE_CHECK_PARAMS == 1
+    if (start_headings.size() != size || goals.size() != size || goal_headings.size() != size ||
+        lengths.size() != size) [[unlikely]] {
+        throw std::invalid_argument(fmt::format(
+            "Invalid arguments detected! All spans must share the same size: starts.size() = "
+            "{0:d}, start_headings.size() = {1:d}, goals.size() = {2:d}, goal_headings.size() = "
+            "{3:d}, lengths.size() = {4:d}",
+            size, start_headings.size(), goals.size(), goal_headings.size(), lengths.size()
+        ));
+    }
+#endif
+    for (std::size_t i{0}; i < size; ++i) {
+        lengths[i] = dubinsPath(starts[i], start_headings[i], goals[i], goal_headings[i], radius)
+                         .length();
+    }
+    return;
+}
+
+/**
+ * @brief Pose reached after driving the path for arc length s from the given start pose.
+ */
+template <std::floating_point T>
+[[using gnu: pure]] [[nodiscard]]
+inline auto dubinsState(const DubinsPath<T>& path, Vec2<T> start, T start_heading, T s) noexcept
+    -> std::pair<Vec2<T>, T> {
+    T x{0.0};
+    T y{0.0};
+    T phi{0.0};
+    T remain{std::max(s, T{0.0}) / path.radius};
+    for (std::size_t i{0}; i < 3; ++i) {
+        const T v{std::min(path.lengths[i], remain)};
+        remain -= v;
+        switch (path.types[i]) {
+        case DubinsSegment::LEFT:
+            x += std::sin(phi + v) - std::sin(phi);
+            y += -std::cos(phi + v) + std::cos(phi);
+            phi += v;
+            break;
+        case DubinsSegment::RIGHT:
+            x += -std::sin(phi - v) + std::sin(phi);
+            y += std::cos(phi - v) - std::cos(phi);
+            phi -= v;
+            break;
+        default:
+            x += v * std::cos(phi);
+            y += v * std::sin(phi);
+            break;
+        }
+        if (remain <= 0.0) {
+            break;
+        }
+    }
+    return {start + Vec2<T>{x, y}.rotate(start_heading) * path.radius, start_heading + phi};
+}
+
+} // namespace boyle::math
@@ -0,0 +1,225 @@
+/**
+ * @file extrema_tree.hpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2025-03-09
+ *
+ * @copyright Copyright (c) 2025 Boyle Development Team.
+ *            All rights reserved.
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <ranges>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace boyle::math {
+
+/**
+ * @brief Bottom-up segment tree over per-leaf (min, max) pairs, answering the extrema over any
+ * run of consecutive leaves in O(log n).
+ */
+template <std::floating_point T>
+class [[nodiscard]] ExtremaTree final {
+  public:
+    ExtremaTree() noexcept = default;
+    ExtremaTree(const ExtremaTree& other) = default;
+    auto operator=(const ExtremaTree& other) -> ExtremaTree& = default;
+    ExtremaTree(ExtremaTree&& other) noexcept = default;
+    auto operator=(ExtremaTree&& other) noexcept -> ExtremaTree& = default;
+    ~ExtremaTree() noexcept = default;
+
+    /**
+     * @brief leaf(i) returns the (min, max) pair of leaf i.
+     */
+    template <std::invocable<std::size_t> Leaf>
+    [[using gnu: ]]
+    explicit ExtremaTree(std::size_t num_leaves, Leaf&& leaf)
+        : m_num_leaves{num_leaves}, m_mins(num_leaves * 2), m_maxs(num_leaves * 2) {
+        if (num_leaves == 0) [[unlikely]] {
+            return;
+        }
+        for (std::size_t i{0}; i < num_leaves; ++i) {
+            std::tie(m_mins[num_leaves + i], m_maxs[num_leaves + i]) = std::invoke(leaf, i);
+        }
+        for (std::size_t i{num_leaves - 1}; i != 0; --i) {
+            m_mins[i] = std::min(m_mins[i * 2], m_mins[i * 2 + 1]);
+            m_maxs[i] = std::max(m_maxs[i * 2], m_maxs[i * 2 + 1]);
+        }
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto numLeaves() const noexcept -> std::size_t {
+        return m_num_leaves;
+    }
+
+    /**
+     * @brief Extrema over the leaves [first, last); an empty run yields (+inf, -inf).
+     */
+    [[using gnu: pure, hot]]
+    auto extrema(std::size_t first, std::size_t last) const noexcept -> std::pair<T, T> {
+        std::pair<T, T> result{
+            std::numeric_limits<T>::infinity(), -std::numeric_limits<T>::infinity()
+        };
+        for (std::size_t left{first + m_num_leaves}, right{last + m_num_leaves}; left < right;
+             left /= 2, right /= 2) {
+            if (left % 2 == 1) {
+                result.first = std::min(result.first, m_mins[left]);
+                result.second = std::max(result.second, m_maxs[left]);
+                ++left;
+            }
+            if (right % 2 == 1) {
+                --right;
+                result.first = std::min(result.first, m_mins[right]);
+                result.second = std::max(result.second, m_maxs[right]);
+            }
+        }
+        return result;
+    }
+
+  private:
+    std::size_t m_num_leaves{0};
+    std::vector<T> m_mins{};
+    std::vector<T> m_maxs{};
+};
+
+/**
+ * @brief ExtremaTree built on first use, from const member functions of an owner that does not
+ * change after construction. Concurrent first uses may both build the tree; either result is
+ * kept. Copies share the built tree.
+ */
+template <std::floating_point T>
+class [[nodiscard]] LazyExtremaTree final {
+  public:
+    LazyExtremaTree() noexcept = default;
+    ~LazyExtremaTree() noexcept = default;
+
+    [[using gnu: always_inline]]
+    LazyExtremaTree(const LazyExtremaTree& other) noexcept
+        : m_tree{other.m_tree.load(std::memory_order_acquire)} {}
+
+    [[using gnu: always_inline]]
+    auto operator=(const LazyExtremaTree& other) noexcept -> LazyExtremaTree& {
+        m_tree.store(other.m_tree.load(std::memory_order_acquire), std::memory_order_release);
+        return *this;
+    }
+
+    [[using gnu: always_inline]]
+    LazyExtremaTree(LazyExtremaTree&& other) noexcept
+        : m_tree{other.m_tree.exchange(nullptr, std::memory_order_acq_rel)} {}
+
+    [[using gnu: always_inline]]
+    auto operator=(LazyExtremaTree&& other) noexcept -> LazyExtremaTree& {
+        m_tree.store(
+            other.m_tree.exchange(nullptr, std::memory_order_acq_rel), std::memory_order_release
+        );
+        return *this;
+    }
+
+    template <std::invocable<std::size_t> Leaf>
+    [[using gnu: always_inline]]
+    auto get(std::size_t num_leaves, Leaf&& leaf) const -> std::shared_ptr<const ExtremaTree<T>> {
+        std::shared_ptr<const ExtremaTree<T>> tree{m_tree.load(std::memory_order_acquire)};
+        if (tree == nullptr) [[unlikely]] {
+            tree = std::make_shared<const ExtremaTree<T>>(num_leaves, std::forward<Leaf>(leaf));
+            m_tree.store(tree, std::memory_order_release);
+        }
+        return tree;
+    }
+
+    [[using gnu: always_inline]]
+    auto reset() noexcept -> void {
+        m_tree.store(nullptr, std::memory_order_release);
+        return;
+    }
+
+  private:
+    mutable std::atomic<std::shared_ptr<const ExtremaTree<T>>> m_tree{};
+};
+
+namespace detail {
+
+template <typename T>
+struct OptionalLazyExtremaTree {
+    using type = std::monostate;
+};
+
+template <std::floating_point T>
+struct OptionalLazyExtremaTree<T> {
+    using type = LazyExtremaTree<T>;
+};
+
+} // namespace detail
+
+/**
+ * @brief LazyExtremaTree<T> for a floating point T and an empty placeholder otherwise, so that
+ * owners generic over their value type can always hold one.
+ */
+template <typename T>
+using OptionalLazyExtremaTree = typename detail::OptionalLazyExtremaTree<T>::type;
+
+/**
+ * @brief Extrema of a piecewise function over [t0, t1], clipped to the knot range ts.
+ * segment(i, r0, r1) returns the (min, max) pair of segment i over the ratio interval [r0, r1];
+ * the whole segments inside the window are answered by the lazily built tree.
+ */
+template <std::floating_point T, std::ranges::random_access_range Ts, typename Segment>
+[[using gnu: pure]]
+inline auto windowExtrema(
+    const LazyExtremaTree<T>& lazy_tree, const Ts& ts, std::ranges::range_value_t<Ts> t0,
+    std::ranges::range_value_t<Ts> t1, Segment&& segment
+) -> std::pair<T, T> {
+    using param_type = std::ranges::range_value_t<Ts>;
+    const std::size_t num_segments{static_cast<std::size_t>(std::ranges::size(ts)) - 1};
+    if (t0 > t1) {
+        std::swap(t0, t1);
+    }
+    t0 = std::clamp(t0, ts[0], ts[num_segments]);
+    t1 = std::clamp(t1, ts[0], ts[num_segments]);
+    const std::size_t istart{std::clamp<std::size_t>(
+        std::ranges::upper_bound(ts, t0) - std::ranges::begin(ts), 1, num_segments
+    ) - 1};
+    const std::size_t iend{std::clamp<std::size_t>(
+        std::ranges::lower_bound(ts, t1) - std::ranges::begin(ts), 1, num_segments
+    ) - 1};
+    const auto ratio = [&ts](std::size_t i, param_type t) -> param_type {
+        return (t - ts[i]) / (ts[i + 1] - ts[i]);
+    };
+    if (istart >= iend) {
+        return std::invoke(segment, iend, ratio(iend, t0), ratio(iend, t1));
+    }
+    std::pair<T, T> result{std::invoke(segment, istart, ratio(istart, t0), param_type{1.0})};
+    const std::pair<T, T> last{std::invoke(segment, iend, param_type{0.0}, ratio(iend, t1))};
+    result.first = std::min(result.first, last.first);
+    result.second = std::max(result.second, last.second);
+    if (iend > istart + 1) {
+        const std::pair<T, T> middle{
+            lazy_tree
+                .get(
+                    num_segments,
+                    [&segment](std::size_t i) -> std::pair<T, T> {
+                        return std::invoke(segment, i, param_type{0.0}, param_type{1.0});
+                    }
+                )
+                ->extrema(istart + 1, iend)
+        };
+        result.first = std::min(result.first, middle.first);
+        result.second = std::max(result.second, middle.second);
+    }
+    return result;
+}
+
+} // namespace boyle::math
@@ -0,0 +1,567 @@
+/**
+ * @file flat_file.hpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2025-02-24
+ *
+ * @copyright Copyright (c) 2025 Boyle Development Team.
+ *            All rights reserved.
+ *
+ */
+
+#pragma once
+
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "fmt/format.h"
+
+namespace boyle::math {
+
+/**
+ * @brief Placeholder passed as the Alloc argument of a piecewise function, curve or motion to turn
+ * its arrays into read-only views of memory owned elsewhere, typically a MappedFile. Such a view
+ * runs exactly the same evaluation code as the owning type but cannot be fitted or modified, and
+ * must not outlive the memory it looks at.
+ */
+struct ExternalStorage final {};
+
+/**
+ * @brief Read-only array over external memory with the const interface of std::vector.
+ */
+template <typename T>
+class [[nodiscard]] ConstArrayView final {
+  public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = const T&;
+    using const_reference = const T&;
+    using pointer = const T*;
+    using const_pointer = const T*;
+    using iterator = const T*;
+    using const_iterator = const T*;
+
+    ConstArrayView() noexcept = default;
+    ConstArrayView(const ConstArrayView& other) noexcept = default;
+    auto operator=(const ConstArrayView& other) noexcept -> ConstArrayView& = default;
+    ConstArrayView(ConstArrayView&& other) noexcept = default;
+    auto operator=(ConstArrayView&& other) noexcept -> ConstArrayView& = default;
+    ~ConstArrayView() noexcept = default;
+
+    [[using gnu: always_inline]]
+    ConstArrayView(const T* data, std::size_t size) noexcept
+        : m_data{data}, m_size{size} {}
+
+    [[using gnu: always_inline]]
+    ConstArrayView(const T* first, const T* last) noexcept
+        : m_data{first}, m_size{static_cast<std::size_t>(last - first)} {}
+
+    [[using gnu: always_inline]]
+    explicit ConstArrayView(std::span<const T> span) noexcept
+        : m_data{span.data()}, m_size{span.size()} {}
+
+    [[using gnu: pure, always_inline]]
+    auto operator[](std::size_t pos) const noexcept -> const T& {
+        return m_data[pos];
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto data() const noexcept -> const T* {
+        return m_data;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto size() const noexcept -> std::size_t {
+        return m_size;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto empty() const noexcept -> bool {
+        return m_size == 0;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto front() const noexcept -> const T& {
+        return m_data[0];
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto back() const noexcept -> const T& {
+        return m_data[m_size - 1];
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto begin() const noexcept -> const T* {
+        return m_data;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto end() const noexcept -> const T* {
+        return m_data + m_size;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto cbegin() const noexcept -> const T* {
+        return m_data;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto cend() const noexcept -> const T* {
+        return m_data + m_size;
+    }
+
+    [[using gnu: pure, always_inline]]
+    operator std::span<const T>() const noexcept {
+        return std::span<const T>{m_data, m_size};
+    }
+
+  private:
+    const T* m_data{nullptr};
+    std::size_t m_size{0};
+};
+
+template <typename Alloc>
+struct StorageTraits final {
+    template <typename T>
+    using vector_type =
+        std::vector<T, typename std::allocator_traits<Alloc>::template rebind_alloc<T>>;
+};
+
+template <>
+struct StorageTraits<ExternalStorage> final {
+    template <typename T>
+    using vector_type = ConstArrayView<T>;
+};
+
+/**
+ * @brief Array type backing a piecewise function or curve: a std::vector with the rebound
+ * allocator, or a ConstArrayView for ExternalStorage.
+ */
+template <typename T, typename Alloc>
+using StorageVector = typename StorageTraits<Alloc>::template vector_type<T>;
+
+/**
+ * @brief Copy of a storage vector on the allocator of the original. The plain copy constructor of
+ * std::vector goes through select_on_container_copy_construction(), which moves a std::pmr copy
+ * to the default resource; the piecewise classes copy through this instead so that a copy of an
+ * arena-backed function stays on the arena.
+ */
+template <typename Storage>
+[[using gnu: always_inline]]
+inline auto copyStorage(const Storage& storage) -> Storage {
+    if constexpr (requires { storage.get_allocator(); }) {
+        return Storage(storage, storage.get_allocator());
+    } else {
+        return storage;
+    }
+}
+
+enum class FlatKind : std::uint16_t {
+    PIECEWISE_LINEAR_FUNCTION1 = 1,
+    PIECEWISE_CUBIC_FUNCTION1 = 2,
+    PIECEWISE_QUINTIC_FUNCTION1 = 3,
+    PIECEWISE_LINEAR_CURVE = 4,
+    PIECEWISE_CUBIC_CURVE = 5,
+    PIECEWISE_QUINTIC_CURVE = 6,
+    MOTION1 = 7,
+    PATH2 = 8,
+    ROUTE_LINE2 = 9
+};
+
+inline constexpr std::uint16_t kFlatVersion{1};
+inline constexpr std::size_t kFlatAlignment{64};
+
+/**
+ * @brief Layout of a flat file: a sequence of records, each starting on a kFlatAlignment boundary
+ * with this header, followed by num_arrays descriptors and the arrays themselves, every array
+ * again aligned to kFlatAlignment. Offsets are relative to the start of the record and values are
+ * stored in native byte order.
+ */
+struct FlatRecordHeader final {
+    std::array<char, 4> magic{'B', 'F', 'L', 'T'};
+    std::uint16_t version{kFlatVersion};
+    FlatKind kind{};
+    std::uint32_t num_arrays{0};
+    std::uint32_t reserved{0};
+    std::uint64_t record_size{0};
+};
+
+struct FlatArrayDescriptor final {
+    std::uint64_t offset{0};
+    std::uint64_t count{0};
+    std::uint32_t element_size{0};
+    std::uint32_t reserved{0};
+};
+
+static_assert(std::is_trivially_copyable_v<FlatRecordHeader>);
+static_assert(std::is_trivially_copyable_v<FlatArrayDescriptor>);
+
+[[using gnu: const, always_inline]]
+constexpr auto flatAlignUp(std::uint64_t size) noexcept -> std::uint64_t {
+    return (size + kFlatAlignment - 1) / kFlatAlignment * kFlatAlignment;
+}
+
+/**
+ * @brief Appends records to a stream. The stream position at construction counts as offset 0, so
+ * it should be the start of a file for the arrays to be aligned once mapped.
+ */
+class [[nodiscard]] FlatWriter final {
+  public:
+    FlatWriter() noexcept = delete;
+    FlatWriter(const FlatWriter& other) noexcept = delete;
+    auto operator=(const FlatWriter& other) noexcept -> FlatWriter& = delete;
+    FlatWriter(FlatWriter&& other) noexcept = delete;
+    auto operator=(FlatWriter&& other) noexcept -> FlatWriter& = delete;
+    ~FlatWriter() noexcept = default;
+
+    [[using gnu: always_inline]]
+    explicit FlatWriter(std::ostream& os) noexcept
+        : m_os{os} {}
+
+    template <typename... Arrays>
+    auto write(FlatKind kind, const Arrays&... arrays) -> void {
+        std::array<FlatArrayDescriptor, sizeof...(Arrays)> descriptors{};
+        std::uint64_t offset{
+            flatAlignUp(sizeof(FlatRecordHeader) + sizeof(FlatArrayDescriptor) * sizeof...(Arrays))
+        };
+        std::size_t index{0};
+        (
+            [&]() noexcept -> void {
+                using Element = std::remove_cvref_t<decltype(*arrays.data())>;
+                static_assert(std::is_trivially_copyable_v<Element>);
+                descriptors[index++] = FlatArrayDescriptor{
+                    .offset = offset,
+                    .count = arrays.size(),
+                    .element_size = static_cast<std::uint32_t>(sizeof(Element))
+                };
+                offset = flatAlignUp(offset + arrays.size() * sizeof(Element));
+            }(),
+            ...
+        );
+        const FlatRecordHeader header{
+            .kind = kind, .num_arrays = sizeof...(Arrays), .record_size = offset
+        };
+        std::uint64_t written{0};
+        writeBytes(&header, sizeof(header), written);
+        writeBytes(descriptors.data(), sizeof(descriptors), written);
+        index = 0;
+        (
+            [&]() -> void {
+                pad(descriptors[index].offset - written, written);
+                writeBytes(
+                    arrays.data(), arrays.size() * descriptors[index].element_size, written
+                );
+                ++index;
+            }(),
+            ...
+        );
+        pad(offset - written, written);
+        m_bytes_written += offset;
+        return;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto bytesWritten() const noexcept -> std::uint64_t {
+        return m_bytes_written;
+    }
+
+  private:
+    auto writeBytes(const void* data, std::uint64_t size, std::uint64_t& written) -> void {
+        m_os.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+        written += size;
+        return;
+    }
+
+    auto pad(std::uint64_t size, std::uint64_t& written) -> void {
+        constexpr std::array<char, kFlatAlignment> kZeros{};
+        writeBytes(kZeros.data(), size, written);
+        return;
+    }
+
+    std::ostream& m_os;
+    std::uint64_t m_bytes_written{0};
+};
+
+/**
+ * @brief One validated record of a flat file. The arrays it hands out point into the underlying
+ * bytes.
+ */
+class [[nodiscard]] FlatRecord final {
+  public:
+    FlatRecord() noexcept = delete;
+    FlatRecord(const FlatRecord& other) noexcept = default;
+    auto operator=(const FlatRecord& other) noexcept -> FlatRecord& = default;
+    FlatRecord(FlatRecord&& other) noexcept = default;
+    auto operator=(FlatRecord&& other) noexcept -> FlatRecord& = default;
+    ~FlatRecord() noexcept = default;
+
+    [[using gnu: always_inline]]
+    explicit FlatRecord(std::span<const std::byte> bytes) noexcept
+        : m_bytes{bytes} {}
+
+    [[using gnu: pure, always_inline]]
+    auto header() const noexcept -> FlatRecordHeader {
+        FlatRecordHeader header;
+        std::memcpy(&header, m_bytes.data(), sizeof(header));
+        return header;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto kind() const noexcept -> FlatKind {
+        return header().kind;
+    }
+
+    /**
+     * @brief Throws std::runtime_error unless the record is of the given kind with the given
+     * number of arrays.
+     */
+    auto expect(FlatKind kind, std::size_t num_arrays) const -> void {
+        const FlatRecordHeader record_header{header()};
+        if (record_header.kind != kind || record_header.num_arrays != num_arrays) [[unlikely]] {
+            throw std::runtime_error(fmt::format(
+                "Invalid flat record detected! Expected kind {0:d} with {1:d} arrays while the "
+                "record has kind {2:d} with {3:d} arrays.",
+                static_cast<std::uint16_t>(kind), num_arrays,
+                static_cast<std::uint16_t>(record_header.kind), record_header.num_arrays
+            ));
+        }
+        return;
+    }
+
+    /**
+     * @brief Throws std::runtime_error unless array 0 holds at least two strictly increasing knots
+     * and every other array of the record holds one element per knot. Unlike the constructor
+     * checks, this runs in every build since the bytes come from outside the program.
+     */
+    template <typename T>
+    auto expectKnots() const -> void {
+        const ConstArrayView<T> ts{array<T>(0)};
+        if (ts.size() < 2) [[unlikely]] {
+            throw std::runtime_error(fmt::format(
+                "Invalid flat record detected! At least 2 knots are required while the record "
+                "has {0:d}.",
+                ts.size()
+            ));
+        }
+        for (std::size_t i{1}; i < header().num_arrays; ++i) {
+            if (descriptor(i).count != ts.size()) [[unlikely]] {
+                throw std::runtime_error(fmt::format(
+                    "Invalid flat record detected! Array {0:d} holds {1:d} elements while the "
+                    "record has {2:d} knots.",
+                    i, descriptor(i).count, ts.size()
+                ));
+            }
+        }
+        for (std::size_t i{1}; i < ts.size(); ++i) {
+            if (!(ts[i - 1] < ts[i])) [[unlikely]] {
+                throw std::runtime_error(fmt::format(
+                    "Invalid flat record detected! Knots have to be strictly increasing: "
+                    "ts[{0:d}] = {1:.6f}, ts[{2:d}] = {3:.6f}.",
+                    i - 1, ts[i - 1], i, ts[i]
+                ));
+            }
+        }
+        return;
+    }
+
+    template <typename T>
+    auto array(std::size_t index) const -> ConstArrayView<T> {
+        static_assert(std::is_trivially_copyable_v<T>);
+        const FlatArrayDescriptor descriptor{this->descriptor(index)};
+        const std::byte* const data{m_bytes.data() + descriptor.offset};
+        if (descriptor.element_size != sizeof(T) ||
+            reinterpret_cast<std::uintptr_t>(data) % alignof(T) != 0) [[unlikely]] {
+            throw std::runtime_error(fmt::format(
+                "Invalid flat record detected! Array {0:d} holds {1:d}-byte elements while "
+                "{2:d}-byte elements aligned to {3:d} are expected.",
+                index, descriptor.element_size, sizeof(T), alignof(T)
+            ));
+        }
+        return ConstArrayView<T>{reinterpret_cast<const T*>(data), descriptor.count};
+    }
+
+    /**
+     * @brief The array as the given container: a view for ConstArrayView, a copy otherwise.
+     */
+    template <typename Container>
+    auto get(std::size_t index) const -> Container {
+        const ConstArrayView<typename Container::value_type> view{
+            array<typename Container::value_type>(index)
+        };
+        return Container(view.begin(), view.end());
+    }
+
+  private:
+    [[using gnu: pure]]
+    auto descriptor(std::size_t index) const -> FlatArrayDescriptor {
+        if (index >= header().num_arrays) [[unlikely]] {
+            throw std::runtime_error(fmt::format(
+                "Invalid flat record detected! Array index {0:d} is out of range.", index
+            ));
+        }
+        FlatArrayDescriptor descriptor;
+        std::memcpy(
+            &descriptor,
+            m_bytes.data() + sizeof(FlatRecordHeader) + sizeof(FlatArrayDescriptor) * index,
+            sizeof(descriptor)
+        );
+        return descriptor;
+    }
+
+    std::span<const std::byte> m_bytes;
+};
+
+/**
+ * @brief Walks the records of a flat file, validating the header and array bounds of each.
+ */
+class [[nodiscard]] FlatReader final {
+  public:
+    FlatReader() noexcept = delete;
+    FlatReader(const FlatReader& other) noexcept = default;
+    auto operator=(const FlatReader& other) noexcept -> FlatReader& = default;
+    FlatReader(FlatReader&& other) noexcept = default;
+    auto operator=(FlatReader&& other) noexcept -> FlatReader& = default;
+    ~FlatReader() noexcept = default;
+
+    [[using gnu: always_inline]]
+    explicit FlatReader(std::span<const std::byte> bytes) noexcept
+        : m_bytes{bytes} {}
+
+    [[using gnu: pure, always_inline]]
+    auto done() const noexcept -> bool {
+        return m_offset >= m_bytes.size();
+    }
+
+    auto next() -> FlatRecord {
+        const std::span<const std::byte> remaining{m_bytes.subspan(m_offset)};
+        if (remaining.size() < sizeof(FlatRecordHeader)) [[unlikely]] {
+            throw std::runtime_error(fmt::format(
+                "Invalid flat file detected! Truncated record header at offset {0:d}.", m_offset
+            ));
+        }
+        FlatRecordHeader header;
+        std::memcpy(&header, remaining.data(), sizeof(header));
+        if (header.magic != FlatRecordHeader{}.magic || header.version != kFlatVersion)
+            [[unlikely]] {
+            throw std::runtime_error(fmt::format(
+                "Invalid flat file detected! Bad magic or unsupported version {0:d} at offset "
+                "{1:d}.",
+                header.version, m_offset
+            ));
+        }
+        const std::uint64_t table_size{
+            sizeof(FlatRecordHeader) + sizeof(FlatArrayDescriptor) * header.num_arrays
+        };
+        if (header.record_size > remaining.size() || header.record_size < table_size ||
+            header.record_size % kFlatAlignment != 0) [[unlikely]] {
+            throw std::runtime_error(fmt::format(
+                "Invalid flat file detected! Record at offset {0:d} claims {1:d} bytes while {2:d} "
+                "bytes are left.",
+                m_offset, header.record_size, remaining.size()
+            ));
+        }
+        for (std::uint32_t i{0}; i < header.num_arrays; ++i) {
+            FlatArrayDescriptor descriptor;
+            std::memcpy(
+                &descriptor,
+                remaining.data() + sizeof(FlatRecordHeader) + sizeof(FlatArrayDescriptor) * i,
+                sizeof(descriptor)
+            );
+            if (descriptor.offset < table_size || descriptor.offset > header.record_size ||
+                descriptor.element_size == 0 ||
+                descriptor.count > (header.record_size - descriptor.offset) /
+                                       descriptor.element_size) [[unlikely]] {
+                throw std::runtime_error(fmt::format(
+                    "Invalid flat file detected! Array {0:d} of the record at offset {1:d} is out "
+                    "of bounds.",
+                    i, m_offset
+                ));
+            }
+        }
+        m_offset += header.record_size;
+        return FlatRecord{remaining.first(header.record_size)};
+    }
+
+  private:
+    std::span<const std::byte> m_bytes;
+    std::size_t m_offset{0};
+};
+
+/**
+ * @brief Read-only memory mapping of a whole file. Pages are loaded lazily and shared through the
+ * page cache between every process mapping the same file.
+ */
+class [[nodiscard]] MappedFile final {
+  public:
+    MappedFile() noexcept = delete;
+    MappedFile(const MappedFile& other) noexcept = delete;
+    auto operator=(const MappedFile& other) noexcept -> MappedFile& = delete;
+    MappedFile(MappedFile&& other) noexcept = delete;
+    auto operator=(MappedFile&& other) noexcept -> MappedFile& = delete;
+    ~MappedFile() noexcept {
+        if (m_data != nullptr) {
+            ::munmap(m_data, m_size);
+        }
+    }
+
+    explicit MappedFile(std::string_view file_path) {
+        const std::string path{file_path};
+        const int fd{::open(path.c_str(), O_RDONLY | O_CLOEXEC)};
+        if (fd < 0) [[unlikely]] {
+            throw std::runtime_error(fmt::format(
+                "Failed to open {0:s} for mapping: {1:s}.", path, std::strerror(errno)
+            ));
+        }
+        struct ::stat status{};
+        if (::fstat(fd, &status) != 0) [[unlikely]] {
+            const int error{errno};
+            ::close(fd);
+            throw std::runtime_error(
+                fmt::format("Failed to stat {0:s}: {1:s}.", path, std::strerror(error))
+            );
+        }
+        m_size = static_cast<std::size_t>(status.st_size);
+        if (m_size != 0) {
+            void* const data{::mmap(nullptr, m_size, PROT_READ, MAP_SHARED, fd, 0)};
+            if (data == MAP_FAILED) [[unlikely]] {
+                const int error{errno};
+                ::close(fd);
+                throw std::runtime_error(
+                    fmt::format("Failed to map {0:s}: {1:s}.", path, std::strerror(error))
+                );
+            }
+            m_data = data;
+        }
+        ::close(fd);
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto bytes() const noexcept -> std::span<const std::byte> {
+        return std::span<const std::byte>{static_cast<const std::byte*>(m_data), m_size};
+    }
+
+  private:
+    void* m_data{nullptr};
+    std::size_t m_size{0};
+};
+
+} // namespace boyle::math
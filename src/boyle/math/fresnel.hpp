@@ -0,0 +1,266 @@
+/**
+ * @file fresnel.hpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2024-06-23
+ *
+ * @copyright Copyright (c) 2024 Boyle Development Team
+ *            All rights reserved.
+ *
+ */
+
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <numbers>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+#include "fmt/format.h"
+
+namespace boyle::math {
+
+namespace detail {
+
+inline constexpr double kFresnelSeriesBound{2.0};
+inline constexpr int kFresnelSeriesTerms{18};
+inline constexpr int kFresnelFractionDepth{24};
+
+template <std::floating_point T>
+inline constexpr std::array<T, kFresnelSeriesTerms> kFresnelCosCoeffs{[]() {
+    std::array<T, kFresnelSeriesTerms> coeffs{};
+    T term{1.0};
+    for (int n{0}; n < kFresnelSeriesTerms; ++n) {
+        coeffs[n] = term / (4 * n + 1);
+        term *= -std::numbers::pi_v<T> * std::numbers::pi_v<T> * 0.25 /
+                ((2 * n + 1) * (2 * n + 2));
+    }
+    return coeffs;
+}()};
+
+template <std::floating_point T>
+inline constexpr std::array<T, kFresnelSeriesTerms> kFresnelSinCoeffs{[]() {
+    std::array<T, kFresnelSeriesTerms> coeffs{};
+    T term{std::numbers::pi_v<T> * 0.5};
+    for (int n{0}; n < kFresnelSeriesTerms; ++n) {
+        coeffs[n] = term / (4 * n + 3);
+        term *= -std::numbers::pi_v<T> * std::numbers::pi_v<T> * 0.25 /
+                ((2 * n + 2) * (2 * n + 3));
+    }
+    return coeffs;
+}()};
+
+/**
+ * @brief Fresnel integrals C(x) + iS(x) by their Maclaurin series, which are polynomials in x^4
+ * evaluated with Horner's rule. Used for 0 <= x < 2 where 18 terms reach double precision.
+ */
+template <std::floating_point T>
+[[using gnu: const, always_inline, hot]] [[nodiscard]]
+inline auto fresnelSeries(T x) noexcept -> std::pair<T, T> {
+    const T x2{x * x};
+    const T x4{x2 * x2};
+    T c{kFresnelCosCoeffs<T>[kFresnelSeriesTerms - 1]};
+    T s{kFresnelSinCoeffs<T>[kFresnelSeriesTerms - 1]};
+    for (int n{kFresnelSeriesTerms - 2}; n >= 0; --n) {
+        c = c * x4 + kFresnelCosCoeffs<T>[n];
+        s = s * x4 + kFresnelSinCoeffs<T>[n];
+    }
+    return {c * x, s * x * x2};
+}
+
+/**
+ * @brief Auxiliary function G(x) = x * h(x) for x >= 2, where h is the continued fraction of
+ * Numerical Recipes (section 6.9) truncated to a fixed depth, hence a rational function of pi x^2
+ * evaluated bottom-up with real arithmetic only. The integrals follow from
+ * C(x) + iS(x) = (1 + i) / 2 - exp(i pi x^2 / 2) G(x).
+ */
+template <std::floating_point T>
+[[using gnu: const, always_inline, hot]] [[nodiscard]]
+inline auto fresnelFraction(T x) noexcept -> std::pair<T, T> {
+    const T pix2{std::numbers::pi_v<T> * x * x};
+    T tail_re{1.0 + 4.0 * (kFresnelFractionDepth - 1)};
+    T tail_im{-pix2};
+    for (int k{kFresnelFractionDepth}; k >= 2; --k) {
+        const T a{-static_cast<T>((2 * k - 3) * (2 * k - 2))};
+        const T den{tail_re * tail_re + tail_im * tail_im};
+        tail_re = 1.0 + 4.0 * (k - 2) + a * tail_re / den;
+        tail_im = -pix2 - a * tail_im / den;
+    }
+    const T den{tail_re * tail_re + tail_im * tail_im};
+    return {x * tail_re / den, -x * tail_im / den};
+}
+
+/**
+ * @brief Auxiliary function G(x) for any x >= 0, free of the large phase pi x^2 / 2.
+ */
+template <std::floating_point T>
+[[using gnu: const, always_inline, hot]] [[nodiscard]]
+inline auto fresnelAuxiliary(T x) noexcept -> std::pair<T, T> {
+    if (x >= kFresnelSeriesBound) {
+        return fresnelFraction(x);
+    }
+    const auto [c, s] = fresnelSeries(x);
+    const T phase{std::numbers::pi_v<T> * 0.5 * x * x};
+    const T cos_phase{std::cos(phase)};
+    const T sin_phase{std::sin(phase)};
+    const T re{0.5 - c};
+    const T im{0.5 - s};
+    return {re * cos_phase + im * sin_phase, im * cos_phase - re * sin_phase};
+}
+
+/**
+ * @brief Moments I_m(b) = int_0^1 t^m exp(ibt) dt for m = 0, ..., M - 1: the power series when
+ * |b| is small, the upward recurrence otherwise.
+ */
+template <std::floating_point T, std::size_t M>
+[[using gnu: const, always_inline]] [[nodiscard]]
+inline auto oscillatoryMoments(T b) noexcept -> std::pair<std::array<T, M>, std::array<T, M>> {
+    std::array<T, M> re;
+    std::array<T, M> im;
+    if (std::abs(b) < 1.0) {
+        for (std::size_t m{0}; m < M; ++m) {
+            T term_re{1.0};
+            T term_im{0.0};
+            T sum_re{0.0};
+            T sum_im{0.0};
+            for (int j{0}; j < 24; ++j) {
+                sum_re += term_re / (m + j + 1);
+                sum_im += term_im / (m + j + 1);
+                const T next_re{-term_im * b / (j + 1)};
+                term_im = term_re * b / (j + 1);
+                term_re = next_re;
+            }
+            re[m] = sum_re;
+            im[m] = sum_im;
+        }
+        return {re, im};
+    }
+    const T cos_b{std::cos(b)};
+    const T sin_b{std::sin(b)};
+    re[0] = sin_b / b;
+    im[0] = (1.0 - cos_b) / b;
+    for (std::size_t m{1}; m < M; ++m) {
+        const T num_re{cos_b - m * re[m - 1]};
+        const T num_im{sin_b - m * im[m - 1]};
+        re[m] = num_im / b;
+        im[m] = -num_re / b;
+    }
+    return {re, im};
+}
+
+} // namespace detail
+
+/**
+ * @brief Fresnel integrals C(x) = int_0^x cos(pi t^2 / 2) dt and S(x) = int_0^x sin(pi t^2 / 2) dt,
+ * accurate to a few ulps. Both branches have fixed trip counts and no table lookups.
+ */
+template <std::floating_point T>
+[[using gnu: const, hot]] [[nodiscard]]
+inline auto fresnel(T x) noexcept -> std::pair<T, T> {
+    const T ax{std::abs(x)};
+    T c;
+    T s;
+    if (ax < detail::kFresnelSeriesBound) {
+        std::tie(c, s) = detail::fresnelSeries(ax);
+    } else {
+        const auto [g_re, g_im] = detail::fresnelFraction(ax);
+        const T phase{std::numbers::pi_v<T> * 0.5 * ax * ax};
+        const T cos_phase{std::cos(phase)};
+        const T sin_phase{std::sin(phase)};
+        c = 0.5 - (g_re * cos_phase - g_im * sin_phase);
+        s = 0.5 - (g_re * sin_phase + g_im * cos_phase);
+    }
+    return x < 0.0 ? std::pair<T, T>{-c, -s} : std::pair<T, T>{c, s};
+}
+
+template <std::floating_point T>
+inline auto fresnel(std::span<const T> xs, std::span<T> cs, std::span<T> ss) noexcept(
+    !BOYLE_CHECK_PARAMS
+) -> void {
+    const std::size_t size{xs.size()};
+#if BOYLE_CHECK_PARAMS == 1
+    if (cs.size() != size || ss.size() != size) [[unlikely]] {
+        throw std::invalid_argument(fmt::format(
+            "Invalid arguments detected! All spans must share the same size: xs.size() = {0:d}, "
+            "cs.size() = {1:d}, ss.size() = {2:d}",
+            size, cs.size(), ss.size()
+        ));
+    }
+#endif
+    for (std::size_t i{0}; i < size; ++i) {
+        std::tie(cs[i], ss[i]) = fresnel(xs[i]);
+    }
+    return;
+}
+
+/**
+ * @brief Generalized Fresnel integrals int_0^1 cos(a t^2 / 2 + b t + c) dt and the matching sine
+ * integral, i.e. the displacement of a unit-length clothoid with sharpness a, initial curvature b
+ * and initial heading c. Completing the square would produce phases of order b^2 / a, so the
+ * integrals are written through the auxiliary function G instead, whose phases stay bounded by
+ * |a| + |b| + |c|. For |a| below 1e-4 a short expansion in a around the circular arc is used.
+ */
+template <std::floating_point T>
+[[using gnu: const, hot]] [[nodiscard]]
+inline auto generalizedFresnel(T a, T b, T c) noexcept -> std::pair<T, T> {
+    constexpr T kSmallSharpness{1E-4};
+    if (std::abs(a) < kSmallSharpness) {
+        constexpr int kNumTerms{4};
+        const auto [re, im] = detail::oscillatoryMoments<T, 2 * kNumTerms - 1>(b);
+        T sum_re{0.0};
+        T sum_im{0.0};
+        T factor_re{1.0};
+        T factor_im{0.0};
+        for (int n{0}; n < kNumTerms; ++n) {
+            sum_re += factor_re * re[2 * n] - factor_im * im[2 * n];
+            sum_im += factor_re * im[2 * n] + factor_im * re[2 * n];
+            const T next_re{-factor_im * a * 0.5 / (n + 1)};
+            factor_im = factor_re * a * 0.5 / (n + 1);
+            factor_re = next_re;
+        }
+        const T cos_c{std::cos(c)};
+        const T sin_c{std::sin(c)};
+        return {sum_re * cos_c - sum_im * sin_c, sum_re * sin_c + sum_im * cos_c};
+    }
+    if (a < 0.0) {
+        const auto [x, y] = generalizedFresnel(-a, -b, -c);
+        return {x, -y};
+    }
+    const T scale{std::sqrt(a / std::numbers::pi_v<T>)};
+    const T z0{b / (std::numbers::pi_v<T> * scale)};
+    const T z1{z0 + scale};
+    const T end_phase{a * 0.5 + b};
+    const T cos_end{std::cos(end_phase)};
+    const T sin_end{std::sin(end_phase)};
+    T re;
+    T im;
+    if (z0 >= 0.0) {
+        const auto [g0_re, g0_im] = detail::fresnelAuxiliary(z0);
+        const auto [g1_re, g1_im] = detail::fresnelAuxiliary(z1);
+        re = g0_re - (g1_re * cos_end - g1_im * sin_end);
+        im = g0_im - (g1_re * sin_end + g1_im * cos_end);
+    } else if (z1 <= 0.0) {
+        const auto [g0_re, g0_im] = detail::fresnelAuxiliary(-z0);
+        const auto [g1_re, g1_im] = detail::fresnelAuxiliary(-z1);
+        re = (g1_re * cos_end - g1_im * sin_end) - g0_re;
+        im = (g1_re * sin_end + g1_im * cos_end) - g0_im;
+    } else {
+        const auto [g0_re, g0_im] = detail::fresnelAuxiliary(-z0);
+        const auto [g1_re, g1_im] = detail::fresnelAuxiliary(z1);
+        const T vertex_phase{-std::numbers::pi_v<T> * 0.5 * z0 * z0};
+        const T cos_vertex{std::cos(vertex_phase)};
+        const T sin_vertex{std::sin(vertex_phase)};
+        re = (cos_vertex - sin_vertex) - (g1_re * cos_end - g1_im * sin_end) - g0_re;
+        im = (cos_vertex + sin_vertex) - (g1_re * sin_end + g1_im * cos_end) - g0_im;
+    }
+    const T cos_c{std::cos(c)};
+    const T sin_c{std::sin(c)};
+    return {(re * cos_c - im * sin_c) / scale, (re * sin_c + im * cos_c) / scale};
+}
+
+} // namespace boyle::math
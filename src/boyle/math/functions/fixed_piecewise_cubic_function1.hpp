@@ -0,0 +1,253 @@
+/**
+ * @file fixed_piecewise_cubic_function1.hpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2025-03-12
+ *
+ * @copyright Copyright (c) 2025 Boyle Development Team.
+ *            All rights reserved.
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+
+#include "fmt/format.h"
+
+#include "boyle/math/concepts.hpp"
+#include "boyle/math/piecewise_interpolation.hpp"
+
+namespace boyle::math {
+
+/**
+ * @brief PiecewiseCubicFunction1 over N knots held in std::arrays, for small static tables such
+ * as calibration maps. The spline system is solved in place by the Thomas algorithm, so the
+ * function never allocates and can be built and evaluated in constant expressions.
+ */
+template <GeneralArithmetic T, std::size_t N, std::floating_point U = T>
+    requires(N >= 2)
+class [[nodiscard]] FixedPiecewiseCubicFunction1 final {
+  public:
+    using value_type = T;
+    using param_type = U;
+    using param_array_type = std::array<param_type, N>;
+    using value_array_type = std::array<value_type, N>;
+
+    static constexpr param_type kDuplicateCriterion{1E-8};
+
+    struct BoundaryMode final {
+        unsigned int order;
+        value_type derivative;
+    };
+
+    constexpr FixedPiecewiseCubicFunction1() noexcept = default;
+    constexpr FixedPiecewiseCubicFunction1(const FixedPiecewiseCubicFunction1& other
+    ) noexcept = default;
+    constexpr auto operator=(const FixedPiecewiseCubicFunction1& other
+    ) noexcept -> FixedPiecewiseCubicFunction1& = default;
+    constexpr FixedPiecewiseCubicFunction1(FixedPiecewiseCubicFunction1&& other) noexcept = default;
+    constexpr auto operator=(FixedPiecewiseCubicFunction1&& other
+    ) noexcept -> FixedPiecewiseCubicFunction1& = default;
+    constexpr ~FixedPiecewiseCubicFunction1() noexcept = default;
+
+    [[using gnu: always_inline]]
+    constexpr explicit FixedPiecewiseCubicFunction1(
+        const param_array_type& ts, const value_array_type& ys
+    ) noexcept(!BOYLE_CHECK_PARAMS)
+        : FixedPiecewiseCubicFunction1(ts, ys, BoundaryMode{2, 0.0}, BoundaryMode{2, 0.0}) {}
+
+    [[using gnu: ]]
+    constexpr explicit FixedPiecewiseCubicFunction1(
+        const param_array_type& ts, const value_array_type& ys, BoundaryMode b0, BoundaryMode bf
+    ) noexcept(!BOYLE_CHECK_PARAMS)
+        : m_ts{ts}, m_ys{ys} {
+        checkKnots();
+#if BOYLE_CHECK_PARAMS == 1
+        if (b0.order == 0 || b0.order > 2) [[unlikely]] {
+            throw std::invalid_argument(fmt::format(
+                "Invalid argument detected! The derivative order of b0 can only be 1, 2: "
+                "b0.order = {0:d}.",
+                b0.order
+            ));
+        }
+        if (bf.order == 0 || bf.order > 2) [[unlikely]] {
+            throw std::invalid_argument(fmt::format(
+                "Invalid argument detected! The derivative order of bf can only be 1, 2: "
+                "bf.order = {0:d}.",
+                bf.order
+            ));
+        }
+#endif
+        param_array_type hs{}, a_low{}, a_diag{}, a_up{};
+        value_array_type ds{}, b{};
+
+        for (std::size_t i{0}; i < N - 1; ++i) {
+            hs[i] = m_ts[i + 1] - m_ts[i];
+            ds[i] = (m_ys[i + 1] - m_ys[i]) / hs[i];
+            a_low[i] = hs[i];
+            a_up[i] = hs[i];
+        }
+        for (std::size_t i{1}; i < N - 1; ++i) {
+            a_diag[i] = (hs[i] + hs[i - 1]) * 2.0;
+            b[i] = (ds[i] - ds[i - 1]) * 6.0;
+        }
+
+        a_diag[0] = 1.0;
+        if (b0.order == 2) {
+            a_up[0] = 0.0;
+            b[0] = b0.derivative;
+        } else {
+            a_up[0] = 0.5;
+            b[0] = (ds[0] - b0.derivative) * 3.0 / hs[0];
+        }
+        a_diag[N - 1] = 1.0;
+        if (bf.order == 2) {
+            a_low[N - 2] = 0.0;
+            b[N - 1] = bf.derivative;
+        } else {
+            a_low[N - 2] = 0.5;
+            b[N - 1] = (bf.derivative - ds[N - 2]) * 3.0 / hs[N - 2];
+        }
+
+        // Forward elimination overwrites a_up and b with the reduced system, back substitution
+        // then leaves the solution in m_ddys.
+        a_up[0] /= a_diag[0];
+        b[0] /= a_diag[0];
+        for (std::size_t i{1}; i < N; ++i) {
+            const param_type pivot{a_diag[i] - a_low[i - 1] * a_up[i - 1]};
+            if (i < N - 1) {
+                a_up[i] /= pivot;
+            }
+            b[i] = (b[i] - b[i - 1] * a_low[i - 1]) / pivot;
+        }
+        m_ddys[N - 1] = b[N - 1];
+        for (std::size_t i{N - 1}; i > 0; --i) {
+            m_ddys[i - 1] = b[i - 1] - m_ddys[i] * a_up[i - 1];
+        }
+    }
+
+    /**
+     * @brief Adopts precomputed knots, values and second-order derivatives as they are, without
+     * solving for the spline again.
+     */
+    [[using gnu: ]]
+    constexpr explicit FixedPiecewiseCubicFunction1(
+        const param_array_type& ts, const value_array_type& ys, const value_array_type& ddys
+    ) noexcept(!BOYLE_CHECK_PARAMS)
+        : m_ts{ts}, m_ys{ys}, m_ddys{ddys} {
+        checkKnots();
+    }
+
+    [[using gnu: pure, flatten, leaf, hot]]
+    constexpr auto eval(param_type t) const noexcept -> value_type {
+        return piecewiseCubicEval(m_ts, m_ys, m_ddys, t);
+    }
+
+    [[using gnu: pure, flatten, leaf, hot]]
+    constexpr auto derivative(param_type t) const noexcept -> value_type {
+        return piecewiseCubicDerivative(m_ts, m_ys, m_ddys, t);
+    }
+
+    [[using gnu: pure, always_inline]]
+    constexpr auto derivative(param_type t, unsigned int order) const
+        noexcept(!BOYLE_CHECK_PARAMS) -> value_type {
+#if BOYLE_CHECK_PARAMS == 1
+        if (order < 1 || order > 3) [[unlikely]] {
+            throw std::invalid_argument(fmt::format(
+                "Invalid argument error! The FixedPiecewiseCubicFunction only has 1, 2, 3 order "
+                "derivatives: order = {0:d}.",
+                order
+            ));
+        }
+#endif
+        value_type result;
+        switch (order) {
+        case 1:
+            result = derivative(t);
+            break;
+        case 2:
+            result = piecewiseCubicDerivative2(m_ts, m_ddys, t);
+            break;
+        case 3:
+            result = piecewiseCubicDerivative3(m_ts, m_ddys, t);
+            break;
+        default:
+            std::unreachable();
+        }
+        return result;
+    }
+
+    [[using gnu: pure]]
+    constexpr auto integral(param_type lower_bound, param_type upper_bound) const noexcept
+        -> value_type {
+        return piecewiseCubicIntegral(m_ts, m_ys, m_ddys, lower_bound, upper_bound);
+    }
+
+    [[using gnu: pure, always_inline]]
+    constexpr auto minT() const noexcept -> param_type {
+        return m_ts.front();
+    }
+
+    [[using gnu: pure, always_inline]]
+    constexpr auto maxT() const noexcept -> param_type {
+        return m_ts.back();
+    }
+
+    [[using gnu: pure, always_inline, hot]]
+    constexpr auto operator()(param_type t) const noexcept -> value_type {
+        return eval(t);
+    }
+
+    [[using gnu: pure, always_inline]]
+    constexpr auto ts() const noexcept -> const param_array_type& {
+        return m_ts;
+    }
+
+    [[using gnu: pure, always_inline]]
+    constexpr auto ys() const noexcept -> const value_array_type& {
+        return m_ys;
+    }
+
+    [[using gnu: pure, always_inline]]
+    constexpr auto ddys() const noexcept -> const value_array_type& {
+        return m_ddys;
+    }
+
+  private:
+    [[using gnu: always_inline]]
+    constexpr auto checkKnots() const noexcept(!BOYLE_CHECK_PARAMS) -> void {
+#if BOYLE_CHECK_PARAMS == 1
+        if (!std::ranges::is_sorted(m_ts)) [[unlikely]] {
+            throw std::invalid_argument(
+                fmt::format("Invalid arguments detected! ts has to be a sorted array!")
+            );
+        }
+        if (std::ranges::adjacent_find(m_ts, [](param_type lhs, param_type rhs) constexpr noexcept {
+                return rhs - lhs < kDuplicateCriterion;
+            }) != m_ts.cend()) [[unlikely]] {
+            throw std::invalid_argument(
+                fmt::format("Invalid arguments detected! ts can not have duplicated elements!")
+            );
+        }
+#endif
+        return;
+    }
+
+    param_array_type m_ts{};
+    value_array_type m_ys{};
+    value_array_type m_ddys{};
+};
+
+template <std::size_t N>
+using FixedPiecewiseCubicFunction1f = FixedPiecewiseCubicFunction1<float, N>;
+template <std::size_t N>
+using FixedPiecewiseCubicFunction1d = FixedPiecewiseCubicFunction1<double, N>;
+
+} // namespace boyle::math
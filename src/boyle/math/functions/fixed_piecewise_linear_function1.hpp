@@ -0,0 +1,126 @@
+/**
+ * @file fixed_piecewise_linear_function1.hpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2025-03-12
+ *
+ * @copyright Copyright (c) 2025 Boyle Development Team.
+ *            All rights reserved.
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <stdexcept>
+
+#include "fmt/format.h"
+
+#include "boyle/math/concepts.hpp"
+#include "boyle/math/piecewise_interpolation.hpp"
+
+namespace boyle::math {
+
+/**
+ * @brief PiecewiseLinearFunction1 over N knots held in std::arrays, for small static tables such
+ * as calibration maps. It never allocates and can be built and evaluated in constant expressions.
+ */
+template <GeneralArithmetic T, std::size_t N, std::floating_point U = T>
+    requires(N >= 2)
+class [[nodiscard]] FixedPiecewiseLinearFunction1 final {
+  public:
+    using value_type = T;
+    using param_type = U;
+    using param_array_type = std::array<param_type, N>;
+    using value_array_type = std::array<value_type, N>;
+
+    static constexpr param_type kDuplicateCriterion{1E-8};
+
+    constexpr FixedPiecewiseLinearFunction1() noexcept = default;
+    constexpr FixedPiecewiseLinearFunction1(const FixedPiecewiseLinearFunction1& other
+    ) noexcept = default;
+    constexpr auto operator=(const FixedPiecewiseLinearFunction1& other
+    ) noexcept -> FixedPiecewiseLinearFunction1& = default;
+    constexpr FixedPiecewiseLinearFunction1(FixedPiecewiseLinearFunction1&& other
+    ) noexcept = default;
+    constexpr auto operator=(FixedPiecewiseLinearFunction1&& other
+    ) noexcept -> FixedPiecewiseLinearFunction1& = default;
+    constexpr ~FixedPiecewiseLinearFunction1() noexcept = default;
+
+    [[using gnu: ]]
+    constexpr explicit FixedPiecewiseLinearFunction1(
+        const param_array_type& ts, const value_array_type& ys
+    ) noexcept(!BOYLE_CHECK_PARAMS)
+        : m_ts{ts}, m_ys{ys} {
+#if BOYLE_CHECK_PARAMS == 1
+        if (!std::ranges::is_sorted(m_ts)) [[unlikely]] {
+            throw std::invalid_argument(
+                fmt::format("Invalid arguments detected! ts has to be a sorted array!")
+            );
+        }
+        if (std::ranges::adjacent_find(m_ts, [](param_type lhs, param_type rhs) constexpr noexcept {
+                return rhs - lhs < kDuplicateCriterion;
+            }) != m_ts.cend()) [[unlikely]] {
+            throw std::invalid_argument(
+                fmt::format("Invalid arguments detected! ts can not have duplicated elements!")
+            );
+        }
+#endif
+    }
+
+    [[using gnu: pure, flatten, leaf, hot]]
+    constexpr auto eval(param_type t) const noexcept -> value_type {
+        return piecewiseLinearEval(m_ts, m_ys, t);
+    }
+
+    [[using gnu: pure, flatten, leaf, hot]]
+    constexpr auto derivative(param_type t) const noexcept -> value_type {
+        return piecewiseLinearDerivative(m_ts, m_ys, t);
+    }
+
+    [[using gnu: pure]]
+    constexpr auto integral(param_type lower_bound, param_type upper_bound) const noexcept
+        -> value_type {
+        return piecewiseLinearIntegral(m_ts, m_ys, lower_bound, upper_bound);
+    }
+
+    [[using gnu: pure, always_inline]]
+    constexpr auto minT() const noexcept -> param_type {
+        return m_ts.front();
+    }
+
+    [[using gnu: pure, always_inline]]
+    constexpr auto maxT() const noexcept -> param_type {
+        return m_ts.back();
+    }
+
+    [[using gnu: pure, always_inline, hot]]
+    constexpr auto operator()(param_type t) const noexcept -> value_type {
+        return eval(t);
+    }
+
+    [[using gnu: pure, always_inline]]
+    constexpr auto ts() const noexcept -> const param_array_type& {
+        return m_ts;
+    }
+
+    [[using gnu: pure, always_inline]]
+    constexpr auto ys() const noexcept -> const value_array_type& {
+        return m_ys;
+    }
+
+  private:
+    param_array_type m_ts{};
+    value_array_type m_ys{};
+};
+
+template <std::size_t N>
+using FixedPiecewiseLinearFunction1f = FixedPiecewiseLinearFunction1<float, N>;
+template <std::size_t N>
+using FixedPiecewiseLinearFunction1d = FixedPiecewiseLinearFunction1<double, N>;
+
+} // namespace boyle::math
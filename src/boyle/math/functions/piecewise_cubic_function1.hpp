@@ -16,6 +16,8 @@
 #include <array>
 #include <concepts>
 #include <cstdint>
+#include <memory>
+#include <memory_resource>
 #include <ranges>
 #include <span>
 #include <utility>
@@ -26,22 +28,31 @@
 #include "fmt/format.h"
 
 #include "boyle/math/concepts.hpp"
+#include "boyle/math/extrema_tree.hpp"
 #include "boyle/math/cubic_interpolation.hpp"
+#include "boyle/math/flat_file.hpp"
+#include "boyle/math/monotone_inverse.hpp"
+#include "boyle/math/piecewise_interpolation.hpp"
+#include "boyle/math/polynomial.hpp"
 #include "boyle/math/utils.hpp"
 #include "boyle/math/vec2.hpp"
 #include "boyle/math/vec3.hpp"
 
 namespace boyle::math {
 
-template <GeneralArithmetic T, std::floating_point U = T>
+template <GeneralArithmetic T, std::floating_point U = T, typename Alloc = std::allocator<T>>
 class [[nodiscard]] PiecewiseCubicFunction1 final {
     friend class boost::serialization::access;
 
   public:
     using value_type = T;
     using param_type = U;
+    using allocator_type = Alloc;
+    using param_vector_type = StorageVector<param_type, Alloc>;
+    using value_vector_type = StorageVector<value_type, Alloc>;
 
     static constexpr param_type kDuplicateCriterion{1E-8};
+    static constexpr FlatKind kFlatKind{FlatKind::PIECEWISE_CUBIC_FUNCTION1};
 
     struct BoundaryMode final {
         unsigned int order;
@@ -49,7 +60,10 @@ class [[nodiscard]] PiecewiseCubicFunction1 final {
     };
 
     PiecewiseCubicFunction1() noexcept = default;
-    PiecewiseCubicFunction1(const PiecewiseCubicFunction1& other) noexcept = default;
+    [[using gnu: always_inline]]
+    PiecewiseCubicFunction1(const PiecewiseCubicFunction1& other) noexcept
+        : m_ts{copyStorage(other.m_ts)}, m_ys{copyStorage(other.m_ys)},
+          m_ddys{copyStorage(other.m_ddys)}, m_extrema_tree{other.m_extrema_tree} {}
     auto operator=(const PiecewiseCubicFunction1& other
     ) noexcept -> PiecewiseCubicFunction1& = default;
     PiecewiseCubicFunction1(PiecewiseCubicFunction1&& other) noexcept = default;
@@ -57,16 +71,20 @@ class [[nodiscard]] PiecewiseCubicFunction1 final {
     ~PiecewiseCubicFunction1() noexcept = default;
 
     [[using gnu: always_inline]]
-    explicit PiecewiseCubicFunction1(std::vector<param_type> ts, std::vector<value_type> ys)
+    explicit PiecewiseCubicFunction1(const allocator_type& alloc) noexcept
+        : m_ts(alloc), m_ys(alloc), m_ddys(alloc) {}
+
+    [[using gnu: always_inline]]
+    explicit PiecewiseCubicFunction1(param_vector_type ts, value_vector_type ys)
         : PiecewiseCubicFunction1(
               std::move(ts), std::move(ys), BoundaryMode{2, 0.0}, BoundaryMode{2, 0.0}
           ) {}
 
     [[using gnu: ]]
     explicit PiecewiseCubicFunction1(
-        std::vector<param_type> ts, std::vector<value_type> ys, BoundaryMode b0, BoundaryMode bf
+        param_vector_type ts, value_vector_type ys, BoundaryMode b0, BoundaryMode bf
     ) noexcept(!BOYLE_CHECK_PARAMS)
-        : m_ts{std::move(ts)}, m_ys{std::move(ys)} {
+        : m_ts{std::move(ts)}, m_ys{std::move(ys)}, m_ddys(m_ts.get_allocator()) {
 #if BOYLE_CHECK_PARAMS == 1
         if (m_ts.size() < 2 || m_ys.size() < 2) [[unlikely]] {
             throw std::invalid_argument(fmt::format(
@@ -110,10 +128,10 @@ class [[nodiscard]] PiecewiseCubicFunction1 final {
         }
 #endif
         const std::size_t size{m_ts.size()};
-        std::vector<param_type> hs(size - 1);
-        std::vector<value_type> ds(size - 1);
-        std::vector<param_type> a_diag(size);
-        std::vector<value_type> b(size);
+        param_vector_type hs(size - 1, m_ts.get_allocator());
+        value_vector_type ds(size - 1, m_ts.get_allocator());
+        param_vector_type a_diag(size, m_ts.get_allocator());
+        value_vector_type b(size, m_ts.get_allocator());
 
         hs[0] = m_ts[1] - m_ts[0];
         ds[0] = (m_ys[1] - m_ys[0]) / hs[0];
@@ -124,8 +142,8 @@ class [[nodiscard]] PiecewiseCubicFunction1 final {
             b[i] = (ds[i] - ds[i - 1]) * 6.0;
         }
 
-        std::vector<param_type> a_low{hs};
-        std::vector<param_type> a_up{hs};
+        param_vector_type a_low(hs, m_ts.get_allocator());
+        param_vector_type a_up(hs, m_ts.get_allocator());
 
         if (b0.order == 2) {
             a_diag[0] = 1.0;
@@ -153,9 +171,9 @@ class [[nodiscard]] PiecewiseCubicFunction1 final {
 
     [[using gnu: ]]
     explicit PiecewiseCubicFunction1(
-        [[maybe_unused]] periodic_tag tag, std::vector<param_type> ts, std::vector<value_type> ys
+        [[maybe_unused]] periodic_tag tag, param_vector_type ts, value_vector_type ys
     ) noexcept(!BOYLE_CHECK_PARAMS)
-        : m_ts{std::move(ts)}, m_ys{std::move(ys)} {
+        : m_ts{std::move(ts)}, m_ys{std::move(ys)}, m_ddys(m_ts.get_allocator()) {
 #if BOYLE_CHECK_PARAMS == 1
         if (m_ts.size() < 2 || m_ys.size() < 2) [[unlikely]] {
             throw std::invalid_argument(fmt::format(
@@ -192,10 +210,10 @@ class [[nodiscard]] PiecewiseCubicFunction1 final {
         }
 #endif
         const std::size_t size{m_ts.size() - 1};
-        std::vector<param_type> hs(size);
-        std::vector<value_type> ds(size);
-        std::vector<param_type> a_diag(size);
-        std::vector<value_type> b(size);
+        param_vector_type hs(size, m_ts.get_allocator());
+        value_vector_type ds(size, m_ts.get_allocator());
+        param_vector_type a_diag(size, m_ts.get_allocator());
+        value_vector_type b(size, m_ts.get_allocator());
 
         hs[0] = m_ts[1] - m_ts[0];
         ds[0] = (m_ys[1] - m_ys[0]) / hs[0];
@@ -208,8 +226,8 @@ class [[nodiscard]] PiecewiseCubicFunction1 final {
         a_diag[0] = (hs[0] + hs[size - 1]) * 2.0;
         b[0] = (ds[0] - ds[size - 1]) * 6.0;
 
-        std::vector<param_type> a_low{hs.cbegin(), hs.cend() - 1};
-        std::vector<param_type> a_up{hs.cbegin(), hs.cend() - 1};
+        param_vector_type a_low(hs.cbegin(), hs.cend() - 1, m_ts.get_allocator());
+        param_vector_type a_up(hs.cbegin(), hs.cend() - 1, m_ts.get_allocator());
         const param_type a_bottom{hs[size - 1]};
         const param_type a_top{hs[size - 1]};
 
@@ -221,49 +239,40 @@ class [[nodiscard]] PiecewiseCubicFunction1 final {
         m_ddys.push_back(m_ddys[0]);
     }
 
-    [[using gnu: pure, flatten, leaf, hot]]
-    auto eval(param_type t) const noexcept -> value_type {
-        constexpr std::array<param_type, 2> kFactors{-(1.0 / 3.0), -(1.0 / 6.0)};
-        const std::size_t pos =
-            nearestUpperElement(std::ranges::subrange{m_ts.cbegin(), m_ts.cend()}, t) -
-            m_ts.cbegin();
-        if (pos == 0) {
-            const param_type h{m_ts[1] - m_ts[0]};
-            const param_type ratio{(t - m_ts[0]) / h};
-            return lerp(m_ys[0], m_ys[1], ratio) +
-                   (m_ddys[0] * kFactors[0] + m_ddys[1] * kFactors[1]) * (t - m_ts[0]) * h;
+    /**
+     * @brief Adopts precomputed knots, values and even-order derivatives as they are, without
+     * solving for the spline again.
+     */
+    [[using gnu: ]]
+    explicit PiecewiseCubicFunction1(
+        param_vector_type ts, value_vector_type ys, value_vector_type ddys
+    ) noexcept(!BOYLE_CHECK_PARAMS)
+        : m_ts{std::move(ts)}, m_ys{std::move(ys)}, m_ddys{std::move(ddys)} {
+#if BOYLE_CHECK_PARAMS == 1
+        if (m_ts.size() < 2 || m_ys.size() != m_ts.size() ||
+            m_ddys.size() != m_ts.size()) [[unlikely]] {
+            throw std::invalid_argument(fmt::format(
+                "Invalid arguments detected! ts, ys, ddys must share the same size no less than 2: "
+                "ts.size() = {0:d}, ys.size() = {1:d}, ddys.size() = {2:d}.",
+                m_ts.size(), m_ys.size(), m_ddys.size()
+            ));
         }
-        if (pos == m_ts.size()) {
-            const param_type h{m_ts[pos - 2] - m_ts[pos - 1]};
-            const param_type ratio{(t - m_ts[pos - 1]) / h};
-            return lerp(m_ys[pos - 1], m_ys[pos - 2], ratio) +
-                   (m_ddys[pos - 1] * kFactors[0] + m_ddys[pos - 2] * kFactors[1]) *
-                       (t - m_ts[pos - 1]) * h;
+        if (!std::is_sorted(m_ts.cbegin(), m_ts.cend())) [[unlikely]] {
+            throw std::invalid_argument(
+                fmt::format("Invalid arguments detected! ts has to be a sorted array!")
+            );
         }
-        const param_type h{m_ts[pos] - m_ts[pos - 1]};
-        const param_type ratio{(t - m_ts[pos - 1]) / (m_ts[pos] - m_ts[pos - 1])};
-        return cuberp(m_ys[pos - 1], m_ys[pos], m_ddys[pos - 1], m_ddys[pos], ratio, h);
+#endif
+    }
+
+    [[using gnu: pure, flatten, leaf, hot]]
+    auto eval(param_type t) const noexcept -> value_type {
+        return piecewiseCubicEval(m_ts, m_ys, m_ddys, t);
     }
 
     [[using gnu: pure, flatten, leaf, hot]]
     auto derivative(param_type t) const noexcept -> value_type {
-        constexpr std::array<param_type, 2> kFactors{-(1.0 / 3.0), -(1.0 / 6.0)};
-        const std::size_t pos =
-            nearestUpperElement(std::ranges::subrange{m_ts.cbegin(), m_ts.cend()}, t) -
-            m_ts.cbegin();
-        if (pos == 0) {
-            const param_type h{m_ts[1] - m_ts[0]};
-            return (m_ys[1] - m_ys[0]) / h +
-                   (m_ddys[0] * kFactors[0] + m_ddys[1] * kFactors[1]) * h;
-        }
-        if (pos == m_ts.size()) {
-            const param_type h{m_ts[pos - 2] - m_ts[pos - 1]};
-            return (m_ys[pos - 2] - m_ys[pos - 1]) / h +
-                   (m_ddys[pos - 1] * kFactors[0] + m_ddys[pos - 2] * kFactors[1]) * h;
-        }
-        const param_type h{m_ts[pos] - m_ts[pos - 1]};
-        const param_type ratio{(t - m_ts[pos - 1]) / h};
-        return cuberpd(m_ys[pos - 1], m_ys[pos], m_ddys[pos - 1], m_ddys[pos], ratio, h);
+        return piecewiseCubicDerivative(m_ts, m_ys, m_ddys, t);
     }
 
     [[using gnu: pure, always_inline]]
@@ -297,36 +306,7 @@ class [[nodiscard]] PiecewiseCubicFunction1 final {
 
     [[using gnu: pure]]
     auto integral(param_type lower_bound, param_type upper_bound) const noexcept -> value_type {
-        constexpr param_type kFactor{-(1.0 / 24.0)};
-        int sign = 1;
-        if (lower_bound > upper_bound) {
-            std::swap(lower_bound, upper_bound);
-            sign = -1;
-        }
-        const std::size_t size{m_ts.size()};
-        const std::size_t istart =
-            std::lower_bound(m_ts.cbegin(), m_ts.cend(), lower_bound) - m_ts.cbegin();
-        const std::size_t iend =
-            std::lower_bound(m_ts.cbegin(), m_ts.cend(), upper_bound) - m_ts.cbegin();
-        param_type h;
-        if (istart == size || iend == 0 || istart == iend) {
-            h = upper_bound - lower_bound;
-            return (eval(lower_bound) + eval(upper_bound)) * h * 0.5 * sign;
-        }
-        value_type result{0.0};
-        h = m_ts[istart] - lower_bound;
-        result += (eval(lower_bound) + m_ys[istart]) * h * 0.5 +
-                  (derivative2(lower_bound) + m_ddys[istart]) * h * h * h * kFactor;
-        for (std::size_t i{istart}; i < iend - 1; ++i) {
-            h = m_ts[i + 1] - m_ts[i];
-            result += (m_ys[i] + m_ys[i + 1]) * h * 0.5 +
-                      (m_ddys[i] + m_ddys[i + 1]) * h * h * h * kFactor;
-        }
-        h = upper_bound - m_ts[iend - 1];
-        result += (m_ys[iend - 1] + eval(upper_bound)) * h * 0.5 +
-                  (m_ddys[iend - 1] + derivative2(upper_bound)) * h * h * h * kFactor;
-        result *= sign;
-        return result;
+        return piecewiseCubicIntegral(m_ts, m_ys, m_ddys, lower_bound, upper_bound);
     }
 
     [[using gnu: pure, always_inline]]
@@ -415,35 +395,131 @@ class [[nodiscard]] PiecewiseCubicFunction1 final {
         return cuberp(m_ys[pos - 1], m_ys[pos], m_ddys[pos - 1], m_ddys[pos], ratio, h);
     }
 
+    /**
+     * @brief Minimum and maximum over [t0, t1], clipped to [minT(), maxT()]. The first call builds
+     * a segment tree over the exact extrema of every segment; later calls take O(log n).
+     */
+    [[using gnu: always_inline]]
+    auto extremaY(param_type t0, param_type t1) const -> std::pair<value_type, value_type>
+        requires std::floating_point<value_type>
+    {
+        return windowExtrema(
+            m_extrema_tree, m_ts, t0, t1,
+            [this](std::size_t i, param_type r0, param_type r1) {
+                return segmentExtrema(i, r0, r1);
+            }
+        );
+    }
+
+    [[using gnu: always_inline]]
+    auto minY(param_type t0, param_type t1) const -> value_type
+        requires std::floating_point<value_type>
+    {
+        return extremaY(t0, t1).first;
+    }
+
+    [[using gnu: always_inline]]
+    auto maxY(param_type t0, param_type t1) const -> value_type
+        requires std::floating_point<value_type>
+    {
+        return extremaY(t0, t1).second;
+    }
+
+    /**
+     * @brief Preimage of y, assuming the function is monotone. Beyond the knots it follows the
+     * linear extrapolation of eval().
+     */
+    [[using gnu: pure]]
+    auto inverse(value_type y) const noexcept -> param_type
+        requires std::floating_point<value_type>
+    {
+        return monotoneInverse(
+            m_ts, m_ys, y, derivative(m_ts.front()), derivative(m_ts.back()),
+            [this](std::size_t i, value_type value) -> param_type {
+                return segmentInverse(i, value);
+            }
+        );
+    }
+
+    /**
+     * @brief Batched inverse for ys sorted in the direction of the function, walking the knots
+     * once.
+     */
+    [[using gnu: always_inline]]
+    auto inverse(std::span<const value_type> ys, std::span<param_type> ts) const
+        noexcept(!BOYLE_CHECK_PARAMS) -> void
+        requires std::floating_point<value_type>
+    {
+        monotoneInverse(
+            m_ts, m_ys, ys, ts, derivative(m_ts.front()), derivative(m_ts.back()),
+            [this](std::size_t i, value_type value) -> param_type {
+                return segmentInverse(i, value);
+            }
+        );
+        return;
+    }
+
     [[using gnu: pure, always_inline, hot]]
     auto operator()(param_type t) const noexcept -> value_type {
         return eval(t);
     }
 
     [[using gnu: pure, always_inline]]
-    auto ts() const noexcept -> const std::vector<param_type>& {
+    auto ts() const noexcept -> const param_vector_type& {
         return m_ts;
     }
 
     [[using gnu: pure, always_inline]]
-    auto ys() const noexcept -> const std::vector<value_type>& {
+    auto ys() const noexcept -> const value_vector_type& {
         return m_ys;
     }
 
     [[using gnu: pure, always_inline]]
-    auto ddys() const noexcept -> const std::vector<value_type>& {
+    auto ddys() const noexcept -> const value_vector_type& {
         return m_ddys;
     }
 
+    [[using gnu: pure, always_inline]]
+    auto get_allocator() const noexcept -> allocator_type {
+        return allocator_type{m_ys.get_allocator()};
+    }
+
+    /**
+     * @brief Appends the function to a flat file; kind lets an enclosing type tag the record as
+     * its own.
+     */
+    [[using gnu: always_inline]]
+    auto writeFlat(FlatWriter& writer, FlatKind kind = kFlatKind) const -> void {
+        writer.write(kind, m_ts, m_ys, m_ddys);
+        return;
+    }
+
+    /**
+     * @brief Rebuilds the function from a flat record. The view instantiation points into the
+     * record's memory, every other one copies. Throws std::runtime_error, whatever
+     * BOYLE_CHECK_PARAMS is, if the record has fewer than 2 knots, unsorted knots or arrays of
+     * different lengths.
+     */
+    [[using gnu: always_inline]]
+    static auto fromFlat(const FlatRecord& record, FlatKind kind = kFlatKind)
+        -> PiecewiseCubicFunction1 {
+        record.expect(kind, 3);
+        record.expectKnots<param_type>();
+        return PiecewiseCubicFunction1{
+            record.get<param_vector_type>(0), record.get<value_vector_type>(1),
+            record.get<value_vector_type>(2)
+        };
+    }
+
   private:
     struct [[nodiscard]] TridiagonalMatrix final {
         [[using gnu: pure, flatten, leaf, hot]] [[nodiscard]]
-        auto luDcmp(std::span<const value_type> b) const noexcept -> std::vector<value_type> {
+        auto luDcmp(std::span<const value_type> b) const noexcept -> value_vector_type {
             const std::size_t mat_size{a_diag.size()};
-            std::vector<value_type> x(mat_size);
-            std::vector<param_type> u0(mat_size);
-            std::vector<param_type> l1(mat_size - 1);
-            const std::vector<param_type>& u1{a_up};
+            value_vector_type x(mat_size, a_diag.get_allocator());
+            param_vector_type u0(mat_size, a_diag.get_allocator());
+            param_vector_type l1(mat_size - 1, a_diag.get_allocator());
+            const param_vector_type& u1{a_up};
 
             u0[0] = a_diag[0];
             l1[0] = a_low[0] / u0[0];
@@ -465,21 +541,21 @@ class [[nodiscard]] PiecewiseCubicFunction1 final {
             return x;
         }
 
-        std::vector<param_type> a_low;
-        std::vector<param_type> a_diag;
-        std::vector<param_type> a_up;
+        param_vector_type a_low;
+        param_vector_type a_diag;
+        param_vector_type a_up;
     };
 
     struct [[nodiscard]] PeriodicTridiagonalMatrix final {
         [[using gnu: pure, flatten, leaf, hot]] [[nodiscard]]
-        auto luDcmp(std::span<const value_type> b) const noexcept -> std::vector<value_type> {
+        auto luDcmp(std::span<const value_type> b) const noexcept -> value_vector_type {
             const std::size_t mat_size{a_diag.size()};
-            std::vector<value_type> x(mat_size);
-            std::vector<param_type> u0(mat_size);
-            std::vector<param_type> l1(mat_size - 1);
-            const std::vector<param_type>& u1{a_up};
-            std::vector<param_type> l_bottom(mat_size - 2);
-            std::vector<param_type> u_top(mat_size - 2);
+            value_vector_type x(mat_size, a_diag.get_allocator());
+            param_vector_type u0(mat_size, a_diag.get_allocator());
+            param_vector_type l1(mat_size - 1, a_diag.get_allocator());
+            const param_vector_type& u1{a_up};
+            param_vector_type l_bottom(mat_size - 2, a_diag.get_allocator());
+            param_vector_type u_top(mat_size - 2, a_diag.get_allocator());
 
             u0[0] = a_diag[0];
             l1[0] = a_low[0] / u0[0];
@@ -516,39 +592,42 @@ class [[nodiscard]] PiecewiseCubicFunction1 final {
         }
 
         param_type a_bottom;
-        std::vector<param_type> a_low;
-        std::vector<param_type> a_diag;
-        std::vector<param_type> a_up;
+        param_vector_type a_low;
+        param_vector_type a_diag;
+        param_vector_type a_up;
         param_type a_top;
     };
 
     [[using gnu: pure, flatten, leaf, hot]]
     auto derivative2(param_type t) const noexcept -> value_type {
-        const std::size_t pos =
-            nearestUpperElement(std::ranges::subrange{m_ts.cbegin(), m_ts.cend()}, t) -
-            m_ts.cbegin();
-        if (pos == 0) {
-            return static_cast<value_type>(0.0);
-        }
-        if (pos == m_ts.size()) {
-            return static_cast<value_type>(0.0);
-        }
-        const param_type ratio = (t - m_ts[pos - 1]) / (m_ts[pos] - m_ts[pos - 1]);
-        return lerp(m_ddys[pos - 1], m_ddys[pos], ratio);
+        return piecewiseCubicDerivative2(m_ts, m_ddys, t);
     }
 
     [[using gnu: pure, flatten, leaf, hot]]
     auto derivative3(param_type t) const noexcept -> value_type {
-        const std::size_t pos =
-            nearestUpperElement(std::ranges::subrange{m_ts.cbegin(), m_ts.cend()}, t) -
-            m_ts.cbegin();
-        if (pos == 0) {
-            return static_cast<value_type>(0.0);
-        }
-        if (pos == m_ts.size()) {
-            return static_cast<value_type>(0.0);
-        }
-        return (m_ddys[pos] - m_ddys[pos - 1]) / (m_ts[pos] - m_ts[pos - 1]);
+        return piecewiseCubicDerivative3(m_ts, m_ddys, t);
+    }
+
+    [[using gnu: pure]]
+    auto segmentExtrema(std::size_t i, param_type r0, param_type r1) const noexcept
+        -> std::pair<value_type, value_type>
+        requires std::floating_point<value_type>
+    {
+        return polyextrema(
+            cuberpPoly(m_ys[i], m_ys[i + 1], m_ddys[i], m_ddys[i + 1], m_ts[i + 1] - m_ts[i]),
+            static_cast<value_type>(r0), static_cast<value_type>(r1)
+        );
+    }
+
+    [[using gnu: pure]]
+    auto segmentInverse(std::size_t i, value_type y) const noexcept -> param_type
+        requires std::floating_point<value_type>
+    {
+        std::array<value_type, 4> coeffs{
+            cuberpPoly(m_ys[i], m_ys[i + 1], m_ddys[i], m_ddys[i + 1], m_ts[i + 1] - m_ts[i])
+        };
+        coeffs[0] -= y;
+        return polyroot(coeffs, value_type{0.0}, value_type{1.0});
     }
 
     [[using gnu: always_inline]]
@@ -556,15 +635,40 @@ class [[nodiscard]] PiecewiseCubicFunction1 final {
         archive & m_ts;
         archive & m_ys;
         archive & m_ddys;
+        if constexpr (std::floating_point<value_type>) {
+            m_extrema_tree.reset();
+        }
         return;
     }
 
-    std::vector<param_type> m_ts{};
-    std::vector<value_type> m_ys{};
-    std::vector<value_type> m_ddys{};
+    param_vector_type m_ts{};
+    value_vector_type m_ys{};
+    value_vector_type m_ddys{};
+    [[no_unique_address]] OptionalLazyExtremaTree<value_type> m_extrema_tree{};
 };
 
 using PiecewiseCubicFunction1f = PiecewiseCubicFunction1<float>;
 using PiecewiseCubicFunction1d = PiecewiseCubicFunction1<double>;
 
+namespace pmr {
+
+template <GeneralArithmetic T, std::floating_point U = T>
+using PiecewiseCubicFunction1 =
+    ::boyle::math::PiecewiseCubicFunction1<T, U, std::pmr::polymorphic_allocator<T>>;
+
+using PiecewiseCubicFunction1f = PiecewiseCubicFunction1<float>;
+using PiecewiseCubicFunction1d = PiecewiseCubicFunction1<double>;
+
+} // namespace pmr
+
+namespace view {
+
+template <GeneralArithmetic T, std::floating_point U = T>
+using PiecewiseCubicFunction1 = ::boyle::math::PiecewiseCubicFunction1<T, U, ExternalStorage>;
+
+using PiecewiseCubicFunction1f = PiecewiseCubicFunction1<float>;
+using PiecewiseCubicFunction1d = PiecewiseCubicFunction1<double>;
+
+} // namespace view
+
 } // namespace boyle::math
@@ -13,8 +13,13 @@
 #pragma once
 
 #include <algorithm>
+#include <cmath>
 #include <concepts>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
 #include <ranges>
+#include <span>
 #include <utility>
 #include <vector>
 
@@ -23,24 +28,35 @@
 #include "fmt/format.h"
 
 #include "boyle/math/concepts.hpp"
+#include "boyle/math/extrema_tree.hpp"
+#include "boyle/math/flat_file.hpp"
+#include "boyle/math/monotone_inverse.hpp"
+#include "boyle/math/piecewise_interpolation.hpp"
 #include "boyle/math/utils.hpp"
 #include "boyle/math/vec2.hpp"
 #include "boyle/math/vec3.hpp"
 
 namespace boyle::math {
 
-template <GeneralArithmetic T, std::floating_point U = T>
+template <GeneralArithmetic T, std::floating_point U = T, typename Alloc = std::allocator<T>>
 class [[nodiscard]] PiecewiseLinearFunction1 final {
     friend class boost::serialization::access;
 
   public:
     using value_type = T;
     using param_type = U;
+    using allocator_type = Alloc;
+    using param_vector_type = StorageVector<param_type, Alloc>;
+    using value_vector_type = StorageVector<value_type, Alloc>;
 
     static constexpr param_type kDuplicateCriterion{1E-8};
+    static constexpr FlatKind kFlatKind{FlatKind::PIECEWISE_LINEAR_FUNCTION1};
 
     PiecewiseLinearFunction1() noexcept = default;
-    PiecewiseLinearFunction1(const PiecewiseLinearFunction1& other) noexcept = default;
+    [[using gnu: always_inline]]
+    PiecewiseLinearFunction1(const PiecewiseLinearFunction1& other) noexcept
+        : m_ts{copyStorage(other.m_ts)}, m_ys{copyStorage(other.m_ys)},
+          m_extrema_tree{other.m_extrema_tree} {}
     auto operator=(const PiecewiseLinearFunction1& other
     ) noexcept -> PiecewiseLinearFunction1& = default;
     PiecewiseLinearFunction1(PiecewiseLinearFunction1&& other) noexcept = default;
@@ -48,9 +64,13 @@ class [[nodiscard]] PiecewiseLinearFunction1 final {
     ) noexcept -> PiecewiseLinearFunction1& = default;
     ~PiecewiseLinearFunction1() noexcept = default;
 
+    [[using gnu: always_inline]]
+    explicit PiecewiseLinearFunction1(const allocator_type& alloc) noexcept
+        : m_ts(alloc), m_ys(alloc) {}
+
     [[using gnu: ]]
     explicit PiecewiseLinearFunction1(
-        std::vector<param_type> ts, std::vector<value_type> ys
+        param_vector_type ts, value_vector_type ys
     ) noexcept(!BOYLE_CHECK_PARAMS)
         : m_ts{std::move(ts)}, m_ys{std::move(ys)} {
 #if BOYLE_CHECK_PARAMS == 1
@@ -84,32 +104,12 @@ class [[nodiscard]] PiecewiseLinearFunction1 final {
 
     [[using gnu: pure, flatten, leaf, hot]]
     auto eval(param_type t) const noexcept -> value_type {
-        const std::size_t pos =
-            nearestUpperElement(std::ranges::subrange{m_ts.cbegin(), m_ts.cend()}, t) -
-            m_ts.cbegin();
-        if (pos == 0) {
-            return lerp(m_ys[0], m_ys[1], (t - m_ts[0]) / (m_ts[1] - m_ts[0]));
-        }
-        if (pos == m_ts.size()) {
-            return lerp(
-                m_ys[pos - 1], m_ys[pos - 2], (t - m_ts[pos - 1]) / (m_ts[pos - 2] - m_ts[pos - 1])
-            );
-        }
-        return lerp(m_ys[pos - 1], m_ys[pos], (t - m_ts[pos - 1]) / (m_ts[pos] - m_ts[pos - 1]));
+        return piecewiseLinearEval(m_ts, m_ys, t);
     }
 
     [[using gnu: pure, flatten, leaf, hot]]
     auto derivative(param_type t) const noexcept -> value_type {
-        const std::size_t pos =
-            nearestUpperElement(std::ranges::subrange{m_ts.cbegin(), m_ts.cend()}, t) -
-            m_ts.cbegin();
-        if (pos == 0) {
-            return (m_ys[1] - m_ys[0]) / (m_ts[1] - m_ts[0]);
-        }
-        if (pos == m_ts.size()) {
-            return (m_ys[pos - 1] - m_ys[pos - 2]) / (m_ts[pos - 1] - m_ts[pos - 2]);
-        }
-        return (m_ys[pos] - m_ys[pos - 1]) / (m_ts[pos] - m_ts[pos - 1]);
+        return piecewiseLinearDerivative(m_ts, m_ys, t);
     }
 
     [[using gnu: pure, always_inline]]
@@ -129,28 +129,7 @@ class [[nodiscard]] PiecewiseLinearFunction1 final {
 
     [[using gnu: pure]]
     auto integral(param_type lower_bound, param_type upper_bound) const noexcept -> value_type {
-        int sign{1};
-        if (lower_bound > upper_bound) {
-            std::swap(lower_bound, upper_bound);
-            sign = -1;
-        }
-        const std::size_t size{m_ts.size()};
-        const std::size_t istart =
-            std::lower_bound(m_ts.cbegin(), m_ts.cend(), lower_bound) - m_ts.cbegin();
-        const std::size_t iend =
-            std::lower_bound(m_ts.cbegin(), m_ts.cend(), upper_bound) - m_ts.cbegin();
-        if (istart == size || iend == 0 || istart == iend) {
-            return (eval(lower_bound) + eval(upper_bound)) * (upper_bound - lower_bound) * 0.5 *
-                   sign;
-        }
-        value_type result{0.0};
-        result += (eval(lower_bound) + m_ys[istart]) * (m_ts[istart] - lower_bound) * 0.5;
-        for (std::size_t i{istart}; i < iend - 1; ++i) {
-            result += (m_ys[i] + m_ys[i + 1]) * (m_ts[i + 1] - m_ts[i]) * 0.5;
-        }
-        result += (m_ys[iend - 1] + eval(upper_bound)) * (upper_bound - m_ts[iend - 1]) * 0.5;
-        result *= sign;
-        return result;
+        return piecewiseLinearIntegral(m_ts, m_ys, lower_bound, upper_bound);
     }
 
     [[using gnu: pure, always_inline]]
@@ -177,34 +156,346 @@ class [[nodiscard]] PiecewiseLinearFunction1 final {
         return *std::max_element(m_ys.cbegin(), m_ys.cend());
     }
 
+    /**
+     * @brief Minimum and maximum over [t0, t1], clipped to [minT(), maxT()]. The first call builds
+     * a segment tree over the exact extrema of every segment; later calls take O(log n).
+     */
+    [[using gnu: always_inline]]
+    auto extremaY(param_type t0, param_type t1) const -> std::pair<value_type, value_type>
+        requires std::floating_point<value_type>
+    {
+        return windowExtrema(
+            m_extrema_tree, m_ts, t0, t1,
+            [this](std::size_t i, param_type r0, param_type r1) {
+                return segmentExtrema(i, r0, r1);
+            }
+        );
+    }
+
+    [[using gnu: always_inline]]
+    auto minY(param_type t0, param_type t1) const -> value_type
+        requires std::floating_point<value_type>
+    {
+        return extremaY(t0, t1).first;
+    }
+
+    [[using gnu: always_inline]]
+    auto maxY(param_type t0, param_type t1) const -> value_type
+        requires std::floating_point<value_type>
+    {
+        return extremaY(t0, t1).second;
+    }
+
+    /**
+     * @brief Preimage of y, assuming the function is monotone. Beyond the knots it follows the
+     * linear extrapolation of eval().
+     */
+    [[using gnu: pure]]
+    auto inverse(value_type y) const noexcept -> param_type
+        requires std::floating_point<value_type>
+    {
+        return monotoneInverse(
+            m_ts, m_ys, y, derivative(m_ts.front()), derivative(m_ts.back()),
+            [this](std::size_t i, value_type value) -> param_type {
+                return segmentInverse(i, value);
+            }
+        );
+    }
+
+    /**
+     * @brief Batched inverse for ys sorted in the direction of the function, walking the knots
+     * once.
+     */
+    [[using gnu: always_inline]]
+    auto inverse(std::span<const value_type> ys, std::span<param_type> ts) const
+        noexcept(!BOYLE_CHECK_PARAMS) -> void
+        requires std::floating_point<value_type>
+    {
+        monotoneInverse(
+            m_ts, m_ys, ys, ts, derivative(m_ts.front()), derivative(m_ts.back()),
+            [this](std::size_t i, value_type value) -> param_type {
+                return segmentInverse(i, value);
+            }
+        );
+        return;
+    }
+
     [[using gnu: pure, always_inline, hot]]
     auto operator()(param_type t) const noexcept -> value_type {
         return eval(t);
     }
 
     [[using gnu: pure, always_inline]]
-    auto ts() const noexcept -> const std::vector<param_type>& {
+    auto ts() const noexcept -> const param_vector_type& {
         return m_ts;
     }
 
     [[using gnu: pure, always_inline]]
-    auto ys() const noexcept -> const std::vector<value_type>& {
+    auto ys() const noexcept -> const value_vector_type& {
         return m_ys;
     }
 
+    [[using gnu: pure, always_inline]]
+    auto get_allocator() const noexcept -> allocator_type {
+        return allocator_type{m_ys.get_allocator()};
+    }
+
+    /**
+     * @brief Appends the function to a flat file; kind lets an enclosing type tag the record as
+     * its own.
+     */
+    [[using gnu: always_inline]]
+    auto writeFlat(FlatWriter& writer, FlatKind kind = kFlatKind) const -> void {
+        writer.write(kind, m_ts, m_ys);
+        return;
+    }
+
+    /**
+     * @brief Rebuilds the function from a flat record. The view instantiation points into the
+     * record's memory, every other one copies. Throws std::runtime_error, whatever
+     * BOYLE_CHECK_PARAMS is, if the record has fewer than 2 knots, unsorted knots or arrays of
+     * different lengths.
+     */
+    [[using gnu: always_inline]]
+    static auto fromFlat(const FlatRecord& record, FlatKind kind = kFlatKind)
+        -> PiecewiseLinearFunction1 {
+        record.expect(kind, 2);
+        record.expectKnots<param_type>();
+        return PiecewiseLinearFunction1{
+            record.get<param_vector_type>(0), record.get<value_vector_type>(1)
+        };
+    }
+
   private:
-    std::vector<param_type> m_ts{};
-    std::vector<value_type> m_ys{};
+    param_vector_type m_ts{};
+    value_vector_type m_ys{};
+    [[no_unique_address]] OptionalLazyExtremaTree<value_type> m_extrema_tree{};
+
+    [[using gnu: pure]]
+    auto segmentExtrema(std::size_t i, param_type r0, param_type r1) const noexcept
+        -> std::pair<value_type, value_type>
+        requires std::floating_point<value_type>
+    {
+        const value_type y0{lerp(m_ys[i], m_ys[i + 1], r0)};
+        const value_type y1{lerp(m_ys[i], m_ys[i + 1], r1)};
+        return std::pair<value_type, value_type>{std::min(y0, y1), std::max(y0, y1)};
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto segmentInverse(std::size_t i, value_type y) const noexcept -> param_type
+        requires std::floating_point<value_type>
+    {
+        return (y - m_ys[i]) / (m_ys[i + 1] - m_ys[i]);
+    }
 
     [[using gnu: always_inline]]
     auto serialize(auto& archive, [[maybe_unused]] const unsigned int version) noexcept -> void {
         archive & m_ts;
         archive & m_ys;
+        if constexpr (std::floating_point<value_type>) {
+            m_extrema_tree.reset();
+        }
         return;
     }
 };
 
+namespace detail {
+
+/**
+ * @brief Walks the segments of a piecewise linear function along ascending query points, so that
+ * a whole sweep costs O(n) instead of O(n log n). Outside the knots it extrapolates like eval().
+ */
+template <typename Function>
+class [[nodiscard]] PiecewiseLinearCursor final {
+  public:
+    using value_type = typename Function::value_type;
+    using param_type = typename Function::param_type;
+
+    [[using gnu: always_inline]]
+    explicit PiecewiseLinearCursor(const Function& function) noexcept
+        : m_ts{function.ts()}, m_ys{function.ys()} {}
+
+    [[using gnu: flatten, hot]]
+    auto operator()(param_type t) noexcept -> value_type {
+        while (m_pos + 2 < m_ts.size() && m_ts[m_pos + 1] <= t) {
+            ++m_pos;
+        }
+        return lerp(
+            m_ys[m_pos], m_ys[m_pos + 1], (t - m_ts[m_pos]) / (m_ts[m_pos + 1] - m_ts[m_pos])
+        );
+    }
+
+  private:
+    const typename Function::param_vector_type& m_ts;
+    const typename Function::value_vector_type& m_ys;
+    std::size_t m_pos{0};
+};
+
+/**
+ * @brief Samples combine(lhs(t), rhs(t)) at the union of both knot sets in one sweep and, when
+ * split_crossings is set, also where lhs and rhs cross, so that a pointwise min or max stays
+ * exact. Knots collinear with their neighbours are dropped from the result.
+ */
+template <std::floating_point T, std::floating_point U, typename Alloc, typename Combine>
+[[using gnu: ]]
+inline auto mergePiecewiseLinear(
+    const PiecewiseLinearFunction1<T, U, Alloc>& lhs,
+    const PiecewiseLinearFunction1<T, U, Alloc>& rhs, Combine&& combine, bool split_crossings
+) -> PiecewiseLinearFunction1<T, U, Alloc> {
+    using Function = PiecewiseLinearFunction1<T, U, Alloc>;
+    constexpr U kDuplicateCriterion{Function::kDuplicateCriterion};
+    const typename Function::param_vector_type& lhs_ts{lhs.ts()};
+    const typename Function::param_vector_type& rhs_ts{rhs.ts()};
+    typename Function::param_vector_type ts(lhs.get_allocator());
+    typename Function::value_vector_type ys(lhs.get_allocator());
+    ts.reserve((lhs_ts.size() + rhs_ts.size()) * (split_crossings ? 2 : 1));
+    ys.reserve(ts.capacity());
+
+    const auto push = [&ts, &ys](U t, T y) -> void {
+        while (ts.size() >= 2) {
+            const std::size_t size{ts.size()};
+            const T expected{lerp(
+                ys[size - 2], y, (ts[size - 1] - ts[size - 2]) / (t - ts[size - 2])
+            )};
+            if (std::abs(ys[size - 1] - expected) >
+                kDuplicateCriterion * std::max(T{1.0}, std::abs(ys[size - 1]))) {
+                break;
+            }
+            ts.pop_back();
+            ys.pop_back();
+        }
+        ts.push_back(t);
+        ys.push_back(y);
+        return;
+    };
+
+    PiecewiseLinearCursor<Function> lhs_cursor{lhs};
+    PiecewiseLinearCursor<Function> rhs_cursor{rhs};
+    U prev_t{0.0};
+    T prev_lhs_y{0.0};
+    T prev_rhs_y{0.0};
+    for (std::size_t i{0}, j{0}; i < lhs_ts.size() || j < rhs_ts.size();) {
+        U t;
+        if (j == rhs_ts.size() || (i < lhs_ts.size() && lhs_ts[i] < rhs_ts[j])) {
+            t = lhs_ts[i++];
+        } else {
+            t = rhs_ts[j++];
+        }
+        while (i < lhs_ts.size() && lhs_ts[i] - t < kDuplicateCriterion) {
+            ++i;
+        }
+        while (j < rhs_ts.size() && rhs_ts[j] - t < kDuplicateCriterion) {
+            ++j;
+        }
+        const T lhs_y{lhs_cursor(t)};
+        const T rhs_y{rhs_cursor(t)};
+        if (split_crossings && !ts.empty()) {
+            const T prev_diff{prev_lhs_y - prev_rhs_y};
+            const T diff{lhs_y - rhs_y};
+            if ((prev_diff < 0.0 && diff > 0.0) || (prev_diff > 0.0 && diff < 0.0)) {
+                const U ratio{prev_diff / (prev_diff - diff)};
+                const U cross_t{lerp(prev_t, t, ratio)};
+                if (cross_t - prev_t > kDuplicateCriterion && t - cross_t > kDuplicateCriterion) {
+                    push(cross_t, lerp(prev_lhs_y, lhs_y, ratio));
+                }
+            }
+        }
+        push(t, combine(lhs_y, rhs_y));
+        prev_t = t;
+        prev_lhs_y = lhs_y;
+        prev_rhs_y = rhs_y;
+    }
+    ts.shrink_to_fit();
+    ys.shrink_to_fit();
+    return Function{std::move(ts), std::move(ys)};
+}
+
+} // namespace detail
+
+/**
+ * @brief Exact pointwise minimum over the union of both domains, in O(n + m).
+ */
+template <std::floating_point T, std::floating_point U, typename Alloc>
+    requires(!std::same_as<Alloc, ExternalStorage>)
+[[using gnu: always_inline]] [[nodiscard]]
+inline auto min(
+    const PiecewiseLinearFunction1<T, U, Alloc>& lhs,
+    const PiecewiseLinearFunction1<T, U, Alloc>& rhs
+) -> PiecewiseLinearFunction1<T, U, Alloc> {
+    return detail::mergePiecewiseLinear(
+        lhs, rhs, [](T lhs_y, T rhs_y) -> T { return std::min(lhs_y, rhs_y); }, true
+    );
+}
+
+/**
+ * @brief Exact pointwise maximum over the union of both domains, in O(n + m).
+ */
+template <std::floating_point T, std::floating_point U, typename Alloc>
+    requires(!std::same_as<Alloc, ExternalStorage>)
+[[using gnu: always_inline]] [[nodiscard]]
+inline auto max(
+    const PiecewiseLinearFunction1<T, U, Alloc>& lhs,
+    const PiecewiseLinearFunction1<T, U, Alloc>& rhs
+) -> PiecewiseLinearFunction1<T, U, Alloc> {
+    return detail::mergePiecewiseLinear(
+        lhs, rhs, [](T lhs_y, T rhs_y) -> T { return std::max(lhs_y, rhs_y); }, true
+    );
+}
+
+template <std::floating_point T, std::floating_point U, typename Alloc>
+    requires(!std::same_as<Alloc, ExternalStorage>)
+[[using gnu: always_inline]] [[nodiscard]]
+inline auto operator+(
+    const PiecewiseLinearFunction1<T, U, Alloc>& lhs,
+    const PiecewiseLinearFunction1<T, U, Alloc>& rhs
+) -> PiecewiseLinearFunction1<T, U, Alloc> {
+    return detail::mergePiecewiseLinear(
+        lhs, rhs, [](T lhs_y, T rhs_y) -> T { return lhs_y + rhs_y; }, false
+    );
+}
+
+template <std::floating_point T, std::floating_point U, typename Alloc>
+    requires(!std::same_as<Alloc, ExternalStorage>)
+[[using gnu: always_inline]] [[nodiscard]]
+inline auto operator*(const PiecewiseLinearFunction1<T, U, Alloc>& obj, T factor)
+    -> PiecewiseLinearFunction1<T, U, Alloc> {
+    typename PiecewiseLinearFunction1<T, U, Alloc>::value_vector_type ys{copyStorage(obj.ys())};
+    for (T& y : ys) {
+        y *= factor;
+    }
+    return PiecewiseLinearFunction1<T, U, Alloc>{copyStorage(obj.ts()), std::move(ys)};
+}
+
+template <std::floating_point T, std::floating_point U, typename Alloc>
+    requires(!std::same_as<Alloc, ExternalStorage>)
+[[using gnu: always_inline]] [[nodiscard]]
+inline auto operator*(T factor, const PiecewiseLinearFunction1<T, U, Alloc>& obj)
+    -> PiecewiseLinearFunction1<T, U, Alloc> {
+    return obj * factor;
+}
+
 using PiecewiseLinearFunction1f = PiecewiseLinearFunction1<float>;
 using PiecewiseLinearFunction1d = PiecewiseLinearFunction1<double>;
 
+namespace pmr {
+
+template <GeneralArithmetic T, std::floating_point U = T>
+using PiecewiseLinearFunction1 =
+    ::boyle::math::PiecewiseLinearFunction1<T, U, std::pmr::polymorphic_allocator<T>>;
+
+using PiecewiseLinearFunction1f = PiecewiseLinearFunction1<float>;
+using PiecewiseLinearFunction1d = PiecewiseLinearFunction1<double>;
+
+} // namespace pmr
+
+namespace view {
+
+template <GeneralArithmetic T, std::floating_point U = T>
+using PiecewiseLinearFunction1 = ::boyle::math::PiecewiseLinearFunction1<T, U, ExternalStorage>;
+
+using PiecewiseLinearFunction1f = PiecewiseLinearFunction1<float>;
+using PiecewiseLinearFunction1d = PiecewiseLinearFunction1<double>;
+
+} // namespace view
+
 } // namespace boyle::math
@@ -15,6 +15,8 @@
 #include <algorithm>
 #include <array>
 #include <concepts>
+#include <memory>
+#include <memory_resource>
 #include <ranges>
 #include <span>
 #include <utility>
@@ -25,6 +27,10 @@
 #include "fmt/format.h"
 
 #include "boyle/math/concepts.hpp"
+#include "boyle/math/extrema_tree.hpp"
+#include "boyle/math/flat_file.hpp"
+#include "boyle/math/monotone_inverse.hpp"
+#include "boyle/math/polynomial.hpp"
 #include "boyle/math/quintic_interpolation.hpp"
 #include "boyle/math/utils.hpp"
 #include "boyle/math/vec2.hpp"
@@ -32,15 +38,19 @@
 
 namespace boyle::math {
 
-template <GeneralArithmetic T, std::floating_point U = T>
+template <GeneralArithmetic T, std::floating_point U = T, typename Alloc = std::allocator<T>>
 class PiecewiseQuinticFunction1 final {
     friend class boost::serialization::access;
 
   public:
     using value_type = T;
     using param_type = U;
+    using allocator_type = Alloc;
+    using param_vector_type = StorageVector<param_type, Alloc>;
+    using value_vector_type = StorageVector<value_type, Alloc>;
 
     static constexpr param_type kDuplicateCriterion{1E-8};
+    static constexpr FlatKind kFlatKind{FlatKind::PIECEWISE_QUINTIC_FUNCTION1};
 
     struct [[nodiscard]] BoundaryMode final {
         unsigned int order;
@@ -48,7 +58,11 @@ class PiecewiseQuinticFunction1 final {
     };
 
     PiecewiseQuinticFunction1() noexcept = default;
-    PiecewiseQuinticFunction1(const PiecewiseQuinticFunction1& other) noexcept = default;
+    [[using gnu: always_inline]]
+    PiecewiseQuinticFunction1(const PiecewiseQuinticFunction1& other) noexcept
+        : m_ts{copyStorage(other.m_ts)}, m_ys{copyStorage(other.m_ys)},
+          m_ddys{copyStorage(other.m_ddys)}, m_d4ys{copyStorage(other.m_d4ys)},
+          m_extrema_tree{other.m_extrema_tree} {}
     auto operator=(const PiecewiseQuinticFunction1& other
     ) noexcept -> PiecewiseQuinticFunction1& = default;
     PiecewiseQuinticFunction1(PiecewiseQuinticFunction1&& other) noexcept = default;
@@ -57,7 +71,11 @@ class PiecewiseQuinticFunction1 final {
     ~PiecewiseQuinticFunction1() noexcept = default;
 
     [[using gnu: always_inline]]
-    explicit PiecewiseQuinticFunction1(std::vector<param_type> ts, std::vector<value_type> ys)
+    explicit PiecewiseQuinticFunction1(const allocator_type& alloc) noexcept
+        : m_ts(alloc), m_ys(alloc), m_ddys(alloc), m_d4ys(alloc) {}
+
+    [[using gnu: always_inline]]
+    explicit PiecewiseQuinticFunction1(param_vector_type ts, value_vector_type ys)
         : PiecewiseQuinticFunction1(
               std::move(ts), std::move(ys),
               std::array<BoundaryMode, 2>{BoundaryMode{2, T{0.0}}, BoundaryMode{4, T{0.0}}},
@@ -66,10 +84,11 @@ class PiecewiseQuinticFunction1 final {
 
     [[using gnu: ]]
     explicit PiecewiseQuinticFunction1(
-        std::vector<param_type> ts, std::vector<value_type> ys, std::array<BoundaryMode, 2> b0,
+        param_vector_type ts, value_vector_type ys, std::array<BoundaryMode, 2> b0,
         std::array<BoundaryMode, 2> bf
     ) noexcept(!BOYLE_CHECK_PARAMS)
-        : m_ts{std::move(ts)}, m_ys{std::move(ys)} {
+        : m_ts{std::move(ts)}, m_ys{std::move(ys)}, m_ddys(m_ts.get_allocator()),
+          m_d4ys(m_ts.get_allocator()) {
 #if BOYLE_CHECK_PARAMS == 1
         if (m_ts.size() < 2 || m_ys.size() < 2) [[unlikely]] {
             throw std::invalid_argument(fmt::format(
@@ -150,18 +169,18 @@ class PiecewiseQuinticFunction1 final {
         }
 
         const std::size_t size{m_ts.size()};
-        std::vector<param_type> hs(size - 1);
-        std::vector<value_type> ds(size - 1);
-        std::vector<param_type> a_diag(size * 2);
-        std::vector<param_type> a_low_1(size * 2 - 1);
-        std::vector<param_type> a_low_2(size + 1);
-        std::vector<param_type> a_low_3(size);
-        std::vector<param_type> a_low_4(size - 1);
-        std::vector<param_type> a_up_1(size * 2 - 1);
-        std::vector<param_type> a_up_2(size + 1);
-        std::vector<param_type> a_up_3(size);
-        std::vector<param_type> a_up_4(size - 1);
-        std::vector<value_type> b(size * 2, value_type{0.0});
+        param_vector_type hs(size - 1, m_ts.get_allocator());
+        value_vector_type ds(size - 1, m_ts.get_allocator());
+        param_vector_type a_diag(size * 2, m_ts.get_allocator());
+        param_vector_type a_low_1(size * 2 - 1, m_ts.get_allocator());
+        param_vector_type a_low_2(size + 1, m_ts.get_allocator());
+        param_vector_type a_low_3(size, m_ts.get_allocator());
+        param_vector_type a_low_4(size - 1, m_ts.get_allocator());
+        param_vector_type a_up_1(size * 2 - 1, m_ts.get_allocator());
+        param_vector_type a_up_2(size + 1, m_ts.get_allocator());
+        param_vector_type a_up_3(size, m_ts.get_allocator());
+        param_vector_type a_up_4(size - 1, m_ts.get_allocator());
+        value_vector_type b(size * 2, value_type{0.0}, m_ts.get_allocator());
 
         hs[0] = m_ts[1] - m_ts[0];
         ds[0] = (m_ys[1] - m_ys[0]) / hs[0];
@@ -339,7 +358,7 @@ class PiecewiseQuinticFunction1 final {
                                 std::move(a_low_1), std::move(a_diag),  std::move(a_up_1),
                                 std::move(a_up_2),  std::move(a_up_3),  std::move(a_up_4)};
 
-        const std::vector<value_type> x = A.gaussSeidel(b);
+        const value_vector_type x = A.gaussSeidel(b);
 
         m_ddys.resize(size);
         m_d4ys.resize(size);
@@ -348,9 +367,10 @@ class PiecewiseQuinticFunction1 final {
     }
 
     explicit PiecewiseQuinticFunction1(
-        [[maybe_unused]] periodic_tag tag, std::vector<param_type> ts, std::vector<value_type> ys
+        [[maybe_unused]] periodic_tag tag, param_vector_type ts, value_vector_type ys
     )
-        : m_ts{std::move(ts)}, m_ys{std::move(ys)} {
+        : m_ts{std::move(ts)}, m_ys{std::move(ys)}, m_ddys(m_ts.get_allocator()),
+          m_d4ys(m_ts.get_allocator()) {
 #if BOYLE_CHECK_PARAMS == 1
         if (m_ts.size() < 2 || m_ys.size() < 2) [[unlikely]] {
             throw std::invalid_argument(fmt::format(
@@ -389,20 +409,20 @@ class PiecewiseQuinticFunction1 final {
         constexpr std::array<param_type, 3> kFactors{-(7.0 / 60.0), -(2.0 / 15.0), -(7.0 / 60.0)};
 
         const std::size_t size{m_ts.size() - 1};
-        std::vector<param_type> hs(size);
-        std::vector<value_type> ds(size);
-        std::vector<param_type> a_diag(size * 2);
-        std::vector<param_type> a_low_1(size * 2 - 1);
-        std::vector<param_type> a_low_2(size + 1);
-        std::vector<param_type> a_low_3(size);
-        std::vector<param_type> a_low_4(size - 1);
+        param_vector_type hs(size, m_ts.get_allocator());
+        value_vector_type ds(size, m_ts.get_allocator());
+        param_vector_type a_diag(size * 2, m_ts.get_allocator());
+        param_vector_type a_low_1(size * 2 - 1, m_ts.get_allocator());
+        param_vector_type a_low_2(size + 1, m_ts.get_allocator());
+        param_vector_type a_low_3(size, m_ts.get_allocator());
+        param_vector_type a_low_4(size - 1, m_ts.get_allocator());
         param_type a_bottom;
-        std::vector<param_type> a_up_1(size * 2 - 1);
-        std::vector<param_type> a_up_2(size + 1);
-        std::vector<param_type> a_up_3(size);
-        std::vector<param_type> a_up_4(size - 1);
+        param_vector_type a_up_1(size * 2 - 1, m_ts.get_allocator());
+        param_vector_type a_up_2(size + 1, m_ts.get_allocator());
+        param_vector_type a_up_3(size, m_ts.get_allocator());
+        param_vector_type a_up_4(size - 1, m_ts.get_allocator());
         param_type a_top;
-        std::vector<value_type> b(size * 2, value_type{0.0});
+        value_vector_type b(size * 2, value_type{0.0}, m_ts.get_allocator());
 
         hs[0] = m_ts[1] - m_ts[0];
         ds[0] = (m_ys[1] - m_ys[0]) / hs[0];
@@ -467,7 +487,7 @@ class PiecewiseQuinticFunction1 final {
             a_top
         };
 
-        const std::vector<value_type> x = A.gaussSeidel(b);
+        const value_vector_type x = A.gaussSeidel(b);
 
         m_ddys.resize(size + 1);
         m_d4ys.resize(size + 1);
@@ -477,6 +497,34 @@ class PiecewiseQuinticFunction1 final {
         m_d4ys[size] = m_d4ys[0];
     }
 
+    /**
+     * @brief Adopts precomputed knots, values and even-order derivatives as they are, without
+     * solving for the spline again.
+     */
+    [[using gnu: ]]
+    explicit PiecewiseQuinticFunction1(
+        param_vector_type ts, value_vector_type ys, value_vector_type ddys, value_vector_type d4ys
+    ) noexcept(!BOYLE_CHECK_PARAMS)
+        : m_ts{std::move(ts)}, m_ys{std::move(ys)}, m_ddys{std::move(ddys)},
+          m_d4ys{std::move(d4ys)} {
+#if BOYLE_CHECK_PARAMS == 1
+        if (m_ts.size() < 2 || m_ys.size() != m_ts.size() || m_ddys.size() != m_ts.size() ||
+            m_d4ys.size() != m_ts.size()) [[unlikely]] {
+            throw std::invalid_argument(fmt::format(
+                "Invalid arguments detected! ts, ys, ddys, d4ys must share the same size no less "
+                "than 2: ts.size() = {0:d}, ys.size() = {1:d}, ddys.size() = {2:d}, d4ys.size() = "
+                "{3:d}.",
+                m_ts.size(), m_ys.size(), m_ddys.size(), m_d4ys.size()
+            ));
+        }
+        if (!std::is_sorted(m_ts.cbegin(), m_ts.cend())) [[unlikely]] {
+            throw std::invalid_argument(
+                fmt::format("Invalid arguments detected! ts has to be a sorted array!")
+            );
+        }
+#endif
+    }
+
     [[using gnu: pure, flatten, leaf, hot]]
     auto eval(param_type t) const noexcept -> value_type {
         constexpr std::array<param_type, 4> kFactors{
@@ -726,38 +774,134 @@ class PiecewiseQuinticFunction1 final {
         );
     }
 
+    /**
+     * @brief Minimum and maximum over [t0, t1], clipped to [minT(), maxT()]. The first call builds
+     * a segment tree over the exact extrema of every segment; later calls take O(log n).
+     */
+    [[using gnu: always_inline]]
+    auto extremaY(param_type t0, param_type t1) const -> std::pair<value_type, value_type>
+        requires std::floating_point<value_type>
+    {
+        return windowExtrema(
+            m_extrema_tree, m_ts, t0, t1,
+            [this](std::size_t i, param_type r0, param_type r1) {
+                return segmentExtrema(i, r0, r1);
+            }
+        );
+    }
+
+    [[using gnu: always_inline]]
+    auto minY(param_type t0, param_type t1) const -> value_type
+        requires std::floating_point<value_type>
+    {
+        return extremaY(t0, t1).first;
+    }
+
+    [[using gnu: always_inline]]
+    auto maxY(param_type t0, param_type t1) const -> value_type
+        requires std::floating_point<value_type>
+    {
+        return extremaY(t0, t1).second;
+    }
+
+    /**
+     * @brief Preimage of y, assuming the function is monotone. Beyond the knots it follows the
+     * linear extrapolation of eval().
+     */
+    [[using gnu: pure]]
+    auto inverse(value_type y) const noexcept -> param_type
+        requires std::floating_point<value_type>
+    {
+        return monotoneInverse(
+            m_ts, m_ys, y, derivative(m_ts.front()), derivative(m_ts.back()),
+            [this](std::size_t i, value_type value) -> param_type {
+                return segmentInverse(i, value);
+            }
+        );
+    }
+
+    /**
+     * @brief Batched inverse for ys sorted in the direction of the function, walking the knots
+     * once.
+     */
+    [[using gnu: always_inline]]
+    auto inverse(std::span<const value_type> ys, std::span<param_type> ts) const
+        noexcept(!BOYLE_CHECK_PARAMS) -> void
+        requires std::floating_point<value_type>
+    {
+        monotoneInverse(
+            m_ts, m_ys, ys, ts, derivative(m_ts.front()), derivative(m_ts.back()),
+            [this](std::size_t i, value_type value) -> param_type {
+                return segmentInverse(i, value);
+            }
+        );
+        return;
+    }
+
     [[using gnu: pure, always_inline, hot]]
     auto operator()(param_type t) const noexcept -> value_type {
         return eval(t);
     }
 
     [[using gnu: pure, always_inline]]
-    auto ts() const noexcept -> const std::vector<param_type>& {
+    auto ts() const noexcept -> const param_vector_type& {
         return m_ts;
     }
 
     [[using gnu: pure, always_inline]]
-    auto ys() const noexcept -> const std::vector<value_type>& {
+    auto ys() const noexcept -> const value_vector_type& {
         return m_ys;
     }
 
     [[using gnu: pure, always_inline]]
-    auto ddys() const noexcept -> const std::vector<value_type>& {
+    auto ddys() const noexcept -> const value_vector_type& {
         return m_ddys;
     }
 
     [[using gnu: pure, always_inline]]
-    auto d4ys() const noexcept -> const std::vector<value_type>& {
+    auto d4ys() const noexcept -> const value_vector_type& {
         return m_d4ys;
     }
 
+    [[using gnu: pure, always_inline]]
+    auto get_allocator() const noexcept -> allocator_type {
+        return allocator_type{m_ys.get_allocator()};
+    }
+
+    /**
+     * @brief Appends the function to a flat file; kind lets an enclosing type tag the record as
+     * its own.
+     */
+    [[using gnu: always_inline]]
+    auto writeFlat(FlatWriter& writer, FlatKind kind = kFlatKind) const -> void {
+        writer.write(kind, m_ts, m_ys, m_ddys, m_d4ys);
+        return;
+    }
+
+    /**
+     * @brief Rebuilds the function from a flat record. The view instantiation points into the
+     * record's memory, every other one copies. Throws std::runtime_error, whatever
+     * BOYLE_CHECK_PARAMS is, if the record has fewer than 2 knots, unsorted knots or arrays of
+     * different lengths.
+     */
+    [[using gnu: always_inline]]
+    static auto fromFlat(const FlatRecord& record, FlatKind kind = kFlatKind)
+        -> PiecewiseQuinticFunction1 {
+        record.expect(kind, 4);
+        record.expectKnots<param_type>();
+        return PiecewiseQuinticFunction1{
+            record.get<param_vector_type>(0), record.get<value_vector_type>(1),
+            record.get<value_vector_type>(2), record.get<value_vector_type>(3)
+        };
+    }
+
   private:
     struct [[nodiscard]] OutriggerMatrix final {
         [[using gnu: pure, flatten, leaf, hot]] [[nodiscard]]
-        auto gaussSeidel(std::span<const T> b) const noexcept -> std::vector<value_type> {
+        auto gaussSeidel(std::span<const T> b) const noexcept -> value_vector_type {
             const std::size_t mat_size{a_diag.size()};
             const std::size_t half_mat_size{mat_size / 2};
-            std::vector<value_type> x(mat_size, 0.0);
+            value_vector_type x(mat_size, 0.0, a_diag.get_allocator());
             for (std::size_t num_iter{40}; num_iter != 0U; --num_iter) {
                 x[0] = (b[0] - a_up_1[0] * x[1] - a_up_2[0] * x[half_mat_size - 1] -
                         a_up_3[0] * x[half_mat_size] - a_up_4[0] * x[half_mat_size + 1]) /
@@ -797,23 +941,23 @@ class PiecewiseQuinticFunction1 final {
             return x;
         }
 
-        std::vector<param_type> a_low_4;
-        std::vector<param_type> a_low_3;
-        std::vector<param_type> a_low_2;
-        std::vector<param_type> a_low_1;
-        std::vector<param_type> a_diag;
-        std::vector<param_type> a_up_1;
-        std::vector<param_type> a_up_2;
-        std::vector<param_type> a_up_3;
-        std::vector<param_type> a_up_4;
+        param_vector_type a_low_4;
+        param_vector_type a_low_3;
+        param_vector_type a_low_2;
+        param_vector_type a_low_1;
+        param_vector_type a_diag;
+        param_vector_type a_up_1;
+        param_vector_type a_up_2;
+        param_vector_type a_up_3;
+        param_vector_type a_up_4;
     };
 
     struct [[nodiscard]] PeriodicOutriggerMatrix final {
         [[using gnu: pure, flatten, leaf, hot]] [[nodiscard]]
-        auto gaussSeidel(std::span<const T> b) const noexcept -> std::vector<value_type> {
+        auto gaussSeidel(std::span<const T> b) const noexcept -> value_vector_type {
             const std::size_t mat_size{a_diag.size()};
             const std::size_t half_mat_size{mat_size / 2};
-            std::vector<value_type> x(mat_size, 0.0);
+            value_vector_type x(mat_size, 0.0, a_diag.get_allocator());
             for (std::size_t num_iter{40}; num_iter != 0U; --num_iter) {
                 x[0] = (b[0] - a_up_1[0] * x[1] - a_up_2[0] * x[half_mat_size - 1] -
                         a_up_3[0] * x[half_mat_size] - a_up_4[0] * x[half_mat_size + 1] -
@@ -855,15 +999,15 @@ class PiecewiseQuinticFunction1 final {
         }
 
         param_type a_bottom;
-        std::vector<param_type> a_low_4;
-        std::vector<param_type> a_low_3;
-        std::vector<param_type> a_low_2;
-        std::vector<param_type> a_low_1;
-        std::vector<param_type> a_diag;
-        std::vector<param_type> a_up_1;
-        std::vector<param_type> a_up_2;
-        std::vector<param_type> a_up_3;
-        std::vector<param_type> a_up_4;
+        param_vector_type a_low_4;
+        param_vector_type a_low_3;
+        param_vector_type a_low_2;
+        param_vector_type a_low_1;
+        param_vector_type a_diag;
+        param_vector_type a_up_1;
+        param_vector_type a_up_2;
+        param_vector_type a_up_3;
+        param_vector_type a_up_4;
         param_type a_top;
     };
 
@@ -928,22 +1072,73 @@ class PiecewiseQuinticFunction1 final {
         return (m_d4ys[pos] - m_d4ys[pos - 1]) / (m_ts[pos] - m_ts[pos - 1]);
     }
 
+    [[using gnu: pure]]
+    auto segmentExtrema(std::size_t i, param_type r0, param_type r1) const noexcept
+        -> std::pair<value_type, value_type>
+        requires std::floating_point<value_type>
+    {
+        return polyextrema(
+            quinerpPoly(
+                m_ys[i], m_ys[i + 1], m_ddys[i], m_ddys[i + 1], m_d4ys[i], m_d4ys[i + 1],
+                m_ts[i + 1] - m_ts[i]
+            ),
+            static_cast<value_type>(r0), static_cast<value_type>(r1)
+        );
+    }
+
+    [[using gnu: pure]]
+    auto segmentInverse(std::size_t i, value_type y) const noexcept -> param_type
+        requires std::floating_point<value_type>
+    {
+        std::array<value_type, 6> coeffs{quinerpPoly(
+            m_ys[i], m_ys[i + 1], m_ddys[i], m_ddys[i + 1], m_d4ys[i], m_d4ys[i + 1],
+            m_ts[i + 1] - m_ts[i]
+        )};
+        coeffs[0] -= y;
+        return polyroot(coeffs, value_type{0.0}, value_type{1.0});
+    }
+
     [[using gnu: always_inline]]
     auto serialize(auto& archive, [[maybe_unused]] const unsigned int version) noexcept -> void {
         archive & m_ts;
         archive & m_ys;
         archive & m_ddys;
         archive & m_d4ys;
+        if constexpr (std::floating_point<value_type>) {
+            m_extrema_tree.reset();
+        }
         return;
     }
 
-    std::vector<param_type> m_ts{};
-    std::vector<value_type> m_ys{};
-    std::vector<value_type> m_ddys{};
-    std::vector<value_type> m_d4ys{};
+    param_vector_type m_ts{};
+    value_vector_type m_ys{};
+    value_vector_type m_ddys{};
+    value_vector_type m_d4ys{};
+    [[no_unique_address]] OptionalLazyExtremaTree<value_type> m_extrema_tree{};
 };
 
 using PiecewiseQuinticFunction1f = PiecewiseQuinticFunction1<float>;
 using PiecewiseQuinticFunction1d = PiecewiseQuinticFunction1<double>;
 
+namespace pmr {
+
+template <GeneralArithmetic T, std::floating_point U = T>
+using PiecewiseQuinticFunction1 =
+    ::boyle::math::PiecewiseQuinticFunction1<T, U, std::pmr::polymorphic_allocator<T>>;
+
+using PiecewiseQuinticFunction1f = PiecewiseQuinticFunction1<float>;
+using PiecewiseQuinticFunction1d = PiecewiseQuinticFunction1<double>;
+
+} // namespace pmr
+
+namespace view {
+
+template <GeneralArithmetic T, std::floating_point U = T>
+using PiecewiseQuinticFunction1 = ::boyle::math::PiecewiseQuinticFunction1<T, U, ExternalStorage>;
+
+using PiecewiseQuinticFunction1f = PiecewiseQuinticFunction1<float>;
+using PiecewiseQuinticFunction1d = PiecewiseQuinticFunction1<double>;
+
+} // namespace view
+
 } // namespace boyle::math
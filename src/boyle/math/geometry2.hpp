@@ -0,0 +1,218 @@
+/**
+ * @file geometry2.hpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2024-06-14
+ *
+ * @copyright Copyright (c) 2024 Boyle Development Team
+ *            All rights reserved.
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <limits>
+#include <span>
+
+#include "boyle/math/concepts.hpp"
+#include "boyle/math/utils.hpp"
+#include "boyle/math/vec2.hpp"
+
+namespace boyle::math {
+
+template <std::floating_point T>
+struct [[nodiscard]] Aabb2 final {
+    using value_type = T;
+
+    [[using gnu: const, always_inline]]
+    static constexpr auto empty() noexcept -> Aabb2 {
+        return Aabb2{
+            .lower = {std::numeric_limits<T>::max(), std::numeric_limits<T>::max()},
+            .upper = {std::numeric_limits<T>::lowest(), std::numeric_limits<T>::lowest()}
+        };
+    }
+
+    [[using gnu: pure, always_inline]]
+    static constexpr auto of(std::span<const Vec2<T>> points) noexcept -> Aabb2 {
+        Aabb2 result{empty()};
+        for (const Vec2<T>& point : points) {
+            result.lower.x = std::min(result.lower.x, point.x);
+            result.lower.y = std::min(result.lower.y, point.y);
+            result.upper.x = std::max(result.upper.x, point.x);
+            result.upper.y = std::max(result.upper.y, point.y);
+        }
+        return result;
+    }
+
+    [[using gnu: pure, always_inline, leaf]]
+    constexpr auto overlaps(const Aabb2& other) const noexcept -> bool {
+        return lower.x <= other.upper.x && other.lower.x <= upper.x && lower.y <= other.upper.y &&
+               other.lower.y <= upper.y;
+    }
+
+    [[using gnu: pure, always_inline, leaf]]
+    constexpr auto contains(Vec2<T> point) const noexcept -> bool {
+        return lower.x <= point.x && point.x <= upper.x && lower.y <= point.y && point.y <= upper.y;
+    }
+
+    [[using gnu: pure, always_inline]]
+    constexpr auto merged(const Aabb2& other) const noexcept -> Aabb2 {
+        return Aabb2{
+            .lower = {std::min(lower.x, other.lower.x), std::min(lower.y, other.lower.y)},
+            .upper = {std::max(upper.x, other.upper.x), std::max(upper.y, other.upper.y)}
+        };
+    }
+
+    [[using gnu: pure, always_inline]]
+    constexpr auto inflated(T margin) const noexcept -> Aabb2 {
+        return Aabb2{.lower = lower - Vec2<T>{margin}, .upper = upper + Vec2<T>{margin}};
+    }
+
+    [[using gnu: pure, always_inline]]
+    constexpr auto center() const noexcept -> Vec2<T> {
+        return (lower + upper) * 0.5;
+    }
+
+    Vec2<value_type> lower;
+    Vec2<value_type> upper;
+};
+
+using Aabb2f = Aabb2<float>;
+using Aabb2d = Aabb2<double>;
+
+/**
+ * @brief Vertices of an oriented box in counter-clockwise order, starting at front right.
+ */
+template <std::floating_point T>
+[[using gnu: pure, always_inline]]
+inline constexpr auto orientedBoxVertices(
+    Vec2<T> center, T heading, T half_length, T half_width
+) noexcept -> std::array<Vec2<T>, 4> {
+    const Vec2<T> direction{std::cos(heading), std::sin(heading)};
+    const Vec2<T> longitudinal{direction * half_length};
+    const Vec2<T> lateral{direction.rotateHalfPi() * half_width};
+    return {
+        center + longitudinal - lateral, center + longitudinal + lateral,
+        center - longitudinal + lateral, center - longitudinal - lateral
+    };
+}
+
+template <std::floating_point T>
+[[using gnu: pure, always_inline, leaf]]
+inline constexpr auto pointSegmentDistance(Vec2<T> point, Vec2<T> start, Vec2<T> end) noexcept
+    -> T {
+    const Vec2<T> edge{end - start};
+    const T length_sqr{edge.euclideanSqr()};
+    if (length_sqr < static_cast<T>(kEpsilon)) [[unlikely]] {
+        return point.euclideanTo(start);
+    }
+    const T ratio{std::clamp((point - start).dot(edge) / length_sqr, T{0.0}, T{1.0})};
+    return point.euclideanTo(start + edge * ratio);
+}
+
+/**
+ * @brief Largest gap between the projections of two convex counter-clockwise polygons over the
+ * edge normals of both. A positive value means separated; a non-positive value is the negated
+ * minimum translation distance.
+ */
+template <std::floating_point T>
+[[using gnu: pure, flatten, hot]]
+inline auto polygonSeparation(std::span<const Vec2<T>> lhs, std::span<const Vec2<T>> rhs) noexcept
+    -> T {
+    T result{std::numeric_limits<T>::lowest()};
+    const auto sweep = [&result](
+                           std::span<const Vec2<T>> polygon, std::span<const Vec2<T>> other
+                       ) noexcept -> void {
+        const std::size_t size{polygon.size()};
+        for (std::size_t i{0}; i < size; ++i) {
+            const Vec2<T> start{polygon[i]};
+            const Vec2<T> edge{polygon[i + 1 == size ? 0 : i + 1] - start};
+            const Vec2<T> normal{Vec2<T>{edge.y, -edge.x}.normalized()};
+            const T offset{normal.dot(start)};
+            T min_proj{std::numeric_limits<T>::max()};
+            for (const Vec2<T>& point : other) {
+                min_proj = std::min(min_proj, normal.x * point.x + normal.y * point.y);
+            }
+            result = std::max(result, min_proj - offset);
+        }
+    };
+    sweep(lhs, rhs);
+    sweep(rhs, lhs);
+    return result;
+}
+
+/**
+ * @brief Signed distance between two convex counter-clockwise polygons: the exact Euclidean
+ * distance when they are apart, the negated penetration depth when they overlap.
+ */
+template <std::floating_point T>
+[[using gnu: pure, flatten, hot]]
+inline auto polygonDistance(std::span<const Vec2<T>> lhs, std::span<const Vec2<T>> rhs) noexcept
+    -> T {
+    const T separation{polygonSeparation(lhs, rhs)};
+    if (separation <= 0.0) {
+        return separation;
+    }
+    T result{std::numeric_limits<T>::max()};
+    const auto sweep = [&result](
+                           std::span<const Vec2<T>> polygon, std::span<const Vec2<T>> other
+                       ) noexcept -> void {
+        const std::size_t size{polygon.size()};
+        for (std::size_t i{0}; i < size; ++i) {
+            const Vec2<T> start{polygon[i]};
+            const Vec2<T> end{polygon[i + 1 == size ? 0 : i + 1]};
+            for (const Vec2<T>& point : other) {
+                result = std::min(result, pointSegmentDistance(point, start, end));
+            }
+        }
+    };
+    sweep(lhs, rhs);
+    sweep(rhs, lhs);
+    return result;
+}
+
+/**
+ * @brief Signed distance from a point to a convex counter-clockwise polygon, negative inside.
+ */
+template <std::floating_point T>
+[[using gnu: pure, flatten, hot]]
+inline auto pointPolygonDistance(Vec2<T> point, std::span<const Vec2<T>> polygon) noexcept -> T {
+    const std::size_t size{polygon.size()};
+    T separation{std::numeric_limits<T>::lowest()};
+    for (std::size_t i{0}; i < size; ++i) {
+        const Vec2<T> edge{polygon[i + 1 == size ? 0 : i + 1] - polygon[i]};
+        separation =
+            std::max(separation, Vec2<T>{edge.y, -edge.x}.normalized().dot(point - polygon[i]));
+    }
+    if (separation <= 0.0) {
+        return separation;
+    }
+    T result{std::numeric_limits<T>::max()};
+    for (std::size_t i{0}; i < size; ++i) {
+        result = std::min(
+            result, pointSegmentDistance(point, polygon[i], polygon[i + 1 == size ? 0 : i + 1])
+        );
+    }
+    return result;
+}
+
+} // namespace boyle::math
+
+namespace boost::serialization {
+
+[[using gnu: always_inline]]
+inline auto serialize(
+    auto& archive, boyle::math::InstanceOfTemplate<boyle::math::Aabb2> auto& obj,
+    [[maybe_unused]] const unsigned int version
+) noexcept -> void {
+    archive & obj.lower;
+    archive & obj.upper;
+    return;
+}
+
+} // namespace boost::serialization
@@ -0,0 +1,130 @@
+/**
+ * @file monotone_inverse.hpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2025-03-11
+ *
+ * @copyright Copyright (c) 2025 Boyle Development Team.
+ *            All rights reserved.
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+
+#include "fmt/format.h"
+
+#include "boyle/math/utils.hpp"
+
+namespace boyle::math {
+
+namespace detail {
+
+/**
+ * @brief Preimage of y once pos, the first knot lying past y in the direction of the function,
+ * is known. Outside the knots the function continues along its end slopes; an end slope that is
+ * flat or runs against the direction of the knots never reaches y, so the end knot is returned.
+ */
+template <std::ranges::random_access_range Ts, std::ranges::random_access_range Ys,
+          typename Segment>
+[[using gnu: always_inline, hot]]
+inline auto monotoneInverseAt(
+    const Ts& ts, const Ys& ys, std::size_t pos, std::ranges::range_value_t<Ys> y,
+    std::ranges::range_value_t<Ts> front_slope, std::ranges::range_value_t<Ts> back_slope,
+    Segment& segment
+) noexcept -> std::ranges::range_value_t<Ts> {
+    const std::size_t size{static_cast<std::size_t>(std::ranges::size(ts))};
+    const bool increasing{ys[0] <= ys[size - 1]};
+    if (pos == 0) {
+        if (increasing ? !(front_slope > 0.0) : !(front_slope < 0.0)) {
+            return ts[0];
+        }
+        return ts[0] + (y - ys[0]) / front_slope;
+    }
+    if (y == ys[pos - 1]) {
+        return ts[pos - 1];
+    }
+    if (pos == size) {
+        if (increasing ? !(back_slope > 0.0) : !(back_slope < 0.0)) {
+            return ts[size - 1];
+        }
+        return ts[size - 1] + (y - ys[size - 1]) / back_slope;
+    }
+    return lerp(ts[pos - 1], ts[pos], std::invoke(segment, pos - 1, y));
+}
+
+} // namespace detail
+
+/**
+ * @brief Preimage of y under a monotone piecewise function with knots (ts, ys), by a binary search
+ * over the knot values. segment(i, y) returns the ratio at which segment i, whose knot values
+ * bracket y, reaches y. On a plateau the last preimage is returned, and beyond the knots the end
+ * knot is returned whenever the end slope cannot reach y.
+ */
+template <std::ranges::random_access_range Ts, std::ranges::random_access_range Ys,
+          typename Segment>
+[[using gnu: pure, hot]]
+inline auto monotoneInverse(
+    const Ts& ts, const Ys& ys, std::ranges::range_value_t<Ys> y,
+    std::ranges::range_value_t<Ts> front_slope, std::ranges::range_value_t<Ts> back_slope,
+    Segment&& segment
+) noexcept -> std::ranges::range_value_t<Ts> {
+    using value_type = std::ranges::range_value_t<Ys>;
+    const bool increasing{ys[0] <= ys[std::ranges::size(ys) - 1]};
+    const std::size_t pos =
+        (increasing ? std::ranges::upper_bound(ys, y)
+                    : std::ranges::upper_bound(ys, y, std::greater<value_type>{})) -
+        std::ranges::begin(ys);
+    return detail::monotoneInverseAt(ts, ys, pos, y, front_slope, back_slope, segment);
+}
+
+/**
+ * @brief Batched monotoneInverse for queries sorted in the direction of the function, i.e.
+ * ascending for an increasing one. A cursor walks the knots once, so the whole batch costs
+ * O(n + m) instead of O(m log n).
+ */
+template <std::ranges::random_access_range Ts, std::ranges::random_access_range Ys,
+          typename Segment>
+[[using gnu: hot]]
+inline auto monotoneInverse(
+    const Ts& ts, const Ys& ys, std::span<const std::ranges::range_value_t<Ys>> queries,
+    std::span<std::ranges::range_value_t<Ts>> results, std::ranges::range_value_t<Ts> front_slope,
+    std::ranges::range_value_t<Ts> back_slope, Segment&& segment
+) noexcept(!BOYLE_CHECK_PARAMS) -> void {
+    const std::size_t size{static_cast<std::size_t>(std::ranges::size(ys))};
+    const bool increasing{ys[0] <= ys[size - 1]};
+#if BOYLE_CHECK_PARAMS == 1
+    if (queries.size() != results.size()) [[unlikely]] {
+        throw std::invalid_argument(fmt::format(
+            "Invalid arguments detected! queries and results must share the same size: "
+            "queries.size() = {0:d} while results.size() = {1:d}.",
+            queries.size(), results.size()
+        ));
+    }
+    if (increasing ? !std::ranges::is_sorted(queries)
+                   : !std::ranges::is_sorted(queries, std::ranges::greater{})) [[unlikely]] {
+        throw std::invalid_argument(fmt::format(
+            "Invalid arguments detected! queries must be sorted in the direction of the function."
+        ));
+    }
+#endif
+    std::size_t pos{0};
+    for (std::size_t i{0}; i < queries.size(); ++i) {
+        const auto y{queries[i]};
+        while (pos < size && (increasing ? ys[pos] <= y : ys[pos] >= y)) {
+            ++pos;
+        }
+        results[i] = detail::monotoneInverseAt(ts, ys, pos, y, front_slope, back_slope, segment);
+    }
+    return;
+}
+
+} // namespace boyle::math
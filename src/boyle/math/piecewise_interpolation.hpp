@@ -0,0 +1,224 @@
+/**
+ * @file piecewise_interpolation.hpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2025-03-12
+ *
+ * @copyright Copyright (c) 2025 Boyle Development Team.
+ *            All rights reserved.
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <ranges>
+#include <utility>
+
+#include "boyle/math/cubic_interpolation.hpp"
+#include "boyle/math/utils.hpp"
+
+namespace boyle::math {
+
+namespace detail {
+
+template <std::ranges::random_access_range Ts>
+[[using gnu: pure, always_inline, hot]]
+inline constexpr auto nearestUpperPosition(const Ts& ts, std::ranges::range_value_t<Ts> t) noexcept
+    -> std::size_t {
+    const auto first{std::ranges::cbegin(ts)};
+    return static_cast<std::size_t>(
+        nearestUpperElement(std::ranges::subrange{first, std::ranges::cend(ts)}, t) - first
+    );
+}
+
+} // namespace detail
+
+// Evaluation kernels over the knots of a piecewise function, shared by the classes whatever their
+// storage is. Outside the knots they extrapolate along the end segments.
+
+template <std::ranges::random_access_range Ts, std::ranges::random_access_range Ys>
+[[using gnu: pure, flatten, leaf, hot]]
+inline constexpr auto piecewiseLinearEval(
+    const Ts& ts, const Ys& ys, std::ranges::range_value_t<Ts> t
+) noexcept -> std::ranges::range_value_t<Ys> {
+    const std::size_t size{static_cast<std::size_t>(std::ranges::size(ts))};
+    const std::size_t pos{detail::nearestUpperPosition(ts, t)};
+    if (pos == 0) {
+        return lerp(ys[0], ys[1], (t - ts[0]) / (ts[1] - ts[0]));
+    }
+    if (pos == size) {
+        return lerp(ys[pos - 1], ys[pos - 2], (t - ts[pos - 1]) / (ts[pos - 2] - ts[pos - 1]));
+    }
+    return lerp(ys[pos - 1], ys[pos], (t - ts[pos - 1]) / (ts[pos] - ts[pos - 1]));
+}
+
+template <std::ranges::random_access_range Ts, std::ranges::random_access_range Ys>
+[[using gnu: pure, flatten, leaf, hot]]
+inline constexpr auto piecewiseLinearDerivative(
+    const Ts& ts, const Ys& ys, std::ranges::range_value_t<Ts> t
+) noexcept -> std::ranges::range_value_t<Ys> {
+    const std::size_t size{static_cast<std::size_t>(std::ranges::size(ts))};
+    const std::size_t pos{detail::nearestUpperPosition(ts, t)};
+    if (pos == 0) {
+        return (ys[1] - ys[0]) / (ts[1] - ts[0]);
+    }
+    if (pos == size) {
+        return (ys[pos - 1] - ys[pos - 2]) / (ts[pos - 1] - ts[pos - 2]);
+    }
+    return (ys[pos] - ys[pos - 1]) / (ts[pos] - ts[pos - 1]);
+}
+
+template <std::ranges::random_access_range Ts, std::ranges::random_access_range Ys>
+[[using gnu: pure]]
+inline constexpr auto piecewiseLinearIntegral(
+    const Ts& ts, const Ys& ys, std::ranges::range_value_t<Ts> lower_bound,
+    std::ranges::range_value_t<Ts> upper_bound
+) noexcept -> std::ranges::range_value_t<Ys> {
+    using value_type = std::ranges::range_value_t<Ys>;
+    int sign{1};
+    if (lower_bound > upper_bound) {
+        std::swap(lower_bound, upper_bound);
+        sign = -1;
+    }
+    const std::size_t size{static_cast<std::size_t>(std::ranges::size(ts))};
+    const std::size_t istart = std::ranges::lower_bound(ts, lower_bound) - std::ranges::cbegin(ts);
+    const std::size_t iend = std::ranges::lower_bound(ts, upper_bound) - std::ranges::cbegin(ts);
+    if (istart == size || iend == 0 || istart == iend) {
+        return (piecewiseLinearEval(ts, ys, lower_bound) +
+                piecewiseLinearEval(ts, ys, upper_bound)) *
+               (upper_bound - lower_bound) * 0.5 * sign;
+    }
+    value_type result{0.0};
+    result += (piecewiseLinearEval(ts, ys, lower_bound) + ys[istart]) * (ts[istart] - lower_bound) *
+              0.5;
+    for (std::size_t i{istart}; i < iend - 1; ++i) {
+        result += (ys[i] + ys[i + 1]) * (ts[i + 1] - ts[i]) * 0.5;
+    }
+    result += (ys[iend - 1] + piecewiseLinearEval(ts, ys, upper_bound)) *
+              (upper_bound - ts[iend - 1]) * 0.5;
+    result *= sign;
+    return result;
+}
+
+template <std::ranges::random_access_range Ts, std::ranges::random_access_range Ys>
+[[using gnu: pure, flatten, leaf, hot]]
+inline constexpr auto piecewiseCubicEval(
+    const Ts& ts, const Ys& ys, const Ys& ddys, std::ranges::range_value_t<Ts> t
+) noexcept -> std::ranges::range_value_t<Ys> {
+    using param_type = std::ranges::range_value_t<Ts>;
+    constexpr std::array<param_type, 2> kFactors{-(1.0 / 3.0), -(1.0 / 6.0)};
+    const std::size_t size{static_cast<std::size_t>(std::ranges::size(ts))};
+    const std::size_t pos{detail::nearestUpperPosition(ts, t)};
+    if (pos == 0) {
+        const param_type h{ts[1] - ts[0]};
+        const param_type ratio{(t - ts[0]) / h};
+        return lerp(ys[0], ys[1], ratio) +
+               (ddys[0] * kFactors[0] + ddys[1] * kFactors[1]) * (t - ts[0]) * h;
+    }
+    if (pos == size) {
+        const param_type h{ts[pos - 2] - ts[pos - 1]};
+        const param_type ratio{(t - ts[pos - 1]) / h};
+        return lerp(ys[pos - 1], ys[pos - 2], ratio) +
+               (ddys[pos - 1] * kFactors[0] + ddys[pos - 2] * kFactors[1]) * (t - ts[pos - 1]) * h;
+    }
+    const param_type h{ts[pos] - ts[pos - 1]};
+    const param_type ratio{(t - ts[pos - 1]) / h};
+    return cuberp(ys[pos - 1], ys[pos], ddys[pos - 1], ddys[pos], ratio, h);
+}
+
+template <std::ranges::random_access_range Ts, std::ranges::random_access_range Ys>
+[[using gnu: pure, flatten, leaf, hot]]
+inline constexpr auto piecewiseCubicDerivative(
+    const Ts& ts, const Ys& ys, const Ys& ddys, std::ranges::range_value_t<Ts> t
+) noexcept -> std::ranges::range_value_t<Ys> {
+    using param_type = std::ranges::range_value_t<Ts>;
+    constexpr std::array<param_type, 2> kFactors{-(1.0 / 3.0), -(1.0 / 6.0)};
+    const std::size_t size{static_cast<std::size_t>(std::ranges::size(ts))};
+    const std::size_t pos{detail::nearestUpperPosition(ts, t)};
+    if (pos == 0) {
+        const param_type h{ts[1] - ts[0]};
+        return (ys[1] - ys[0]) / h + (ddys[0] * kFactors[0] + ddys[1] * kFactors[1]) * h;
+    }
+    if (pos == size) {
+        const param_type h{ts[pos - 2] - ts[pos - 1]};
+        return (ys[pos - 2] - ys[pos - 1]) / h +
+               (ddys[pos - 1] * kFactors[0] + ddys[pos - 2] * kFactors[1]) * h;
+    }
+    const param_type h{ts[pos] - ts[pos - 1]};
+    const param_type ratio{(t - ts[pos - 1]) / h};
+    return cuberpd(ys[pos - 1], ys[pos], ddys[pos - 1], ddys[pos], ratio, h);
+}
+
+template <std::ranges::random_access_range Ts, std::ranges::random_access_range Ys>
+[[using gnu: pure, flatten, leaf, hot]]
+inline constexpr auto piecewiseCubicDerivative2(
+    const Ts& ts, const Ys& ddys, std::ranges::range_value_t<Ts> t
+) noexcept -> std::ranges::range_value_t<Ys> {
+    using value_type = std::ranges::range_value_t<Ys>;
+    const std::size_t size{static_cast<std::size_t>(std::ranges::size(ts))};
+    const std::size_t pos{detail::nearestUpperPosition(ts, t)};
+    if (pos == 0 || pos == size) {
+        return static_cast<value_type>(0.0);
+    }
+    return lerp(ddys[pos - 1], ddys[pos], (t - ts[pos - 1]) / (ts[pos] - ts[pos - 1]));
+}
+
+template <std::ranges::random_access_range Ts, std::ranges::random_access_range Ys>
+[[using gnu: pure, flatten, leaf, hot]]
+inline constexpr auto piecewiseCubicDerivative3(
+    const Ts& ts, const Ys& ddys, std::ranges::range_value_t<Ts> t
+) noexcept -> std::ranges::range_value_t<Ys> {
+    using value_type = std::ranges::range_value_t<Ys>;
+    const std::size_t size{static_cast<std::size_t>(std::ranges::size(ts))};
+    const std::size_t pos{detail::nearestUpperPosition(ts, t)};
+    if (pos == 0 || pos == size) {
+        return static_cast<value_type>(0.0);
+    }
+    return (ddys[pos] - ddys[pos - 1]) / (ts[pos] - ts[pos - 1]);
+}
+
+template <std::ranges::random_access_range Ts, std::ranges::random_access_range Ys>
+[[using gnu: pure]]
+inline constexpr auto piecewiseCubicIntegral(
+    const Ts& ts, const Ys& ys, const Ys& ddys, std::ranges::range_value_t<Ts> lower_bound,
+    std::ranges::range_value_t<Ts> upper_bound
+) noexcept -> std::ranges::range_value_t<Ys> {
+    using param_type = std::ranges::range_value_t<Ts>;
+    using value_type = std::ranges::range_value_t<Ys>;
+    constexpr param_type kFactor{-(1.0 / 24.0)};
+    int sign{1};
+    if (lower_bound > upper_bound) {
+        std::swap(lower_bound, upper_bound);
+        sign = -1;
+    }
+    const std::size_t size{static_cast<std::size_t>(std::ranges::size(ts))};
+    const std::size_t istart = std::ranges::lower_bound(ts, lower_bound) - std::ranges::cbegin(ts);
+    const std::size_t iend = std::ranges::lower_bound(ts, upper_bound) - std::ranges::cbegin(ts);
+    param_type h{upper_bound - lower_bound};
+    if (istart == size || iend == 0 || istart == iend) {
+        return (piecewiseCubicEval(ts, ys, ddys, lower_bound) +
+                piecewiseCubicEval(ts, ys, ddys, upper_bound)) *
+               h * 0.5 * sign;
+    }
+    value_type result{0.0};
+    h = ts[istart] - lower_bound;
+    result += (piecewiseCubicEval(ts, ys, ddys, lower_bound) + ys[istart]) * h * 0.5 +
+              (piecewiseCubicDerivative2(ts, ddys, lower_bound) + ddys[istart]) * h * h * h *
+                  kFactor;
+    for (std::size_t i{istart}; i < iend - 1; ++i) {
+        h = ts[i + 1] - ts[i];
+        result += (ys[i] + ys[i + 1]) * h * 0.5 + (ddys[i] + ddys[i + 1]) * h * h * h * kFactor;
+    }
+    h = upper_bound - ts[iend - 1];
+    result += (ys[iend - 1] + piecewiseCubicEval(ts, ys, ddys, upper_bound)) * h * 0.5 +
+              (ddys[iend - 1] + piecewiseCubicDerivative2(ts, ddys, upper_bound)) * h * h * h *
+                  kFactor;
+    result *= sign;
+    return result;
+}
+
+} // namespace boyle::math
@@ -0,0 +1,248 @@
+/**
+ * @file polynomial.hpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief Dense polynomials of fixed degree with coefficients in ascending order, i.e.
+ *        p(x) = c[0] + c[1] * x + ... + c[N - 1] * x^(N - 1).
+ * @version 0.1
+ * @date 2025-03-09
+ *
+ * @copyright Copyright (c) 2025 Boyle Development Team.
+ *            All rights reserved.
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <utility>
+
+namespace boyle::math {
+
+template <std::floating_point T, std::size_t N>
+[[using gnu: pure, always_inline, hot]] [[nodiscard]]
+inline constexpr auto polyval(const std::array<T, N>& coeffs, T x) noexcept -> T {
+    T result{0.0};
+    for (std::size_t i{N}; i != 0; --i) {
+        result = result * x + coeffs[i - 1];
+    }
+    return result;
+}
+
+template <std::floating_point T, std::size_t N>
+    requires(N >= 2)
+[[using gnu: pure, always_inline]] [[nodiscard]]
+inline constexpr auto polyder(const std::array<T, N>& coeffs) noexcept -> std::array<T, N - 1> {
+    std::array<T, N - 1> result;
+    for (std::size_t i{1}; i < N; ++i) {
+        result[i - 1] = coeffs[i] * static_cast<T>(i);
+    }
+    return result;
+}
+
+template <std::floating_point T, std::size_t M, std::size_t N>
+[[using gnu: pure, always_inline]] [[nodiscard]]
+inline constexpr auto polymul(const std::array<T, M>& lhs, const std::array<T, N>& rhs) noexcept
+    -> std::array<T, M + N - 1> {
+    std::array<T, M + N - 1> result{};
+    for (std::size_t i{0}; i < M; ++i) {
+        for (std::size_t j{0}; j < N; ++j) {
+            result[i + j] += lhs[i] * rhs[j];
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Coefficients of p(1 - x).
+ */
+template <std::floating_point T, std::size_t N>
+[[using gnu: pure, always_inline]] [[nodiscard]]
+inline constexpr auto polyreflect(const std::array<T, N>& coeffs) noexcept -> std::array<T, N> {
+    std::array<T, N> result{};
+    for (std::size_t k{0}; k < N; ++k) {
+        // (1 - x)^k = sum_j C(k, j) (-x)^j
+        T binomial{1.0};
+        for (std::size_t j{0}; j <= k; ++j) {
+            result[j] += coeffs[k] * (j % 2 == 0 ? binomial : -binomial);
+            binomial = binomial * static_cast<T>(k - j) / static_cast<T>(j + 1);
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief At most Capacity real roots, ascending.
+ */
+template <std::floating_point T, std::size_t Capacity>
+struct [[nodiscard]] PolyRoots final {
+    std::array<T, Capacity> values{};
+    std::size_t size{0};
+
+    [[using gnu: pure, always_inline]]
+    constexpr auto begin() const noexcept -> const T* {
+        return values.data();
+    }
+
+    [[using gnu: pure, always_inline]]
+    constexpr auto end() const noexcept -> const T* {
+        return values.data() + size;
+    }
+};
+
+/**
+ * @brief The root of p in [lo, hi], where p(lo) and p(hi) differ in sign, found by Newton steps
+ * safeguarded with bisection.
+ */
+template <std::floating_point T, std::size_t N>
+    requires(N >= 2)
+[[using gnu: pure]] [[nodiscard]]
+inline constexpr auto polyroot(const std::array<T, N>& coeffs, T lo, T hi) noexcept -> T {
+    constexpr T kTolerance{std::numeric_limits<T>::epsilon() * T{4.0}};
+    constexpr std::size_t kMaxIter{100};
+    const std::array<T, N - 1> dcoeffs{polyder(coeffs)};
+    const T f_lo{polyval(coeffs, lo)};
+    if (f_lo == 0.0) {
+        return lo;
+    }
+    if (polyval(coeffs, hi) == 0.0) {
+        return hi;
+    }
+    const bool rising{f_lo < 0.0};
+    T left{lo};
+    T right{hi};
+    T x{(left + right) * T{0.5}};
+    for (std::size_t num_iter{0}; num_iter < kMaxIter; ++num_iter) {
+        const T fx{polyval(coeffs, x)};
+        if (fx == 0.0) {
+            break;
+        }
+        if ((fx < 0.0) == rising) {
+            left = x;
+        } else {
+            right = x;
+        }
+        const T dfx{polyval(dcoeffs, x)};
+        T next{dfx != 0.0 ? x - fx / dfx : left};
+        if (!(next > left && next < right)) {
+            next = (left + right) * 0.5;
+        }
+        const bool converged{std::abs(next - x) <= kTolerance * std::max(T{1.0}, std::abs(x))};
+        x = next;
+        if (converged) {
+            break;
+        }
+    }
+    return x;
+}
+
+/**
+ * @brief Real roots of p in the open interval (lo, hi). The roots of p' split the interval into
+ * monotone pieces, and every piece with a sign change holds exactly one root. Roots of even
+ * multiplicity are only found where p vanishes exactly.
+ */
+template <std::floating_point T, std::size_t N>
+[[using gnu: pure]] [[nodiscard]]
+inline constexpr auto polyroots(const std::array<T, N>& coeffs, T lo, T hi) noexcept
+    -> PolyRoots<T, (N > 1 ? N - 1 : 1)> {
+    PolyRoots<T, (N > 1 ? N - 1 : 1)> roots;
+    if constexpr (N == 2) {
+        if (coeffs[1] != 0.0) {
+            const T root{-coeffs[0] / coeffs[1]};
+            if (root > lo && root < hi) {
+                roots.values[roots.size++] = root;
+            }
+        }
+    } else if constexpr (N > 2) {
+        const auto critical_points{polyroots(polyder(coeffs), lo, hi)};
+        T a{lo};
+        T fa{polyval(coeffs, a)};
+        for (std::size_t k{0}; k <= critical_points.size; ++k) {
+            const T b{k < critical_points.size ? critical_points.values[k] : hi};
+            const T fb{polyval(coeffs, b)};
+            if (fb == 0.0 && b < hi) {
+                roots.values[roots.size++] = b;
+            } else if ((fa < 0.0 && fb > 0.0) || (fa > 0.0 && fb < 0.0)) {
+                roots.values[roots.size++] = polyroot(coeffs, a, b);
+            }
+            a = b;
+            fa = fb;
+        }
+    }
+    return roots;
+}
+
+/**
+ * @brief Minimum and maximum of p over the closed interval [lo, hi].
+ */
+template <std::floating_point T, std::size_t N>
+[[using gnu: pure]] [[nodiscard]]
+inline constexpr auto polyextrema(const std::array<T, N>& coeffs, T lo, T hi) noexcept
+    -> std::pair<T, T> {
+    const T f_lo{polyval(coeffs, lo)};
+    const T f_hi{polyval(coeffs, hi)};
+    std::pair<T, T> result{std::min(f_lo, f_hi), std::max(f_lo, f_hi)};
+    if constexpr (N > 2) {
+        for (const T x : polyroots(polyder(coeffs), lo, hi)) {
+            const T fx{polyval(coeffs, x)};
+            result.first = std::min(result.first, fx);
+            result.second = std::max(result.second, fx);
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Minimum and maximum curvature of the planar curve (x(r), y(r)) over [lo, hi]. With the
+ * numerator n = x'y'' - y'x'' and the squared speed v = x'^2 + y'^2, the signed curvature n / v^1.5
+ * is stationary where 2n'v - 3nv' vanishes, so its extrema and the zeros of n are all the
+ * candidates besides the ends.
+ */
+template <std::floating_point T, std::size_t N>
+    requires(N >= 3)
+[[using gnu: pure]] [[nodiscard]]
+inline auto polycurvatureExtrema(
+    const std::array<T, N>& xs, const std::array<T, N>& ys, T lo, T hi
+) noexcept -> std::pair<T, T> {
+    const std::array<T, N - 1> dxs{polyder(xs)};
+    const std::array<T, N - 1> dys{polyder(ys)};
+    std::array<T, N * 2 - 4> numerator{polymul(dxs, polyder(dys))};
+    const std::array<T, N * 2 - 4> rhs{polymul(dys, polyder(dxs))};
+    for (std::size_t i{0}; i < numerator.size(); ++i) {
+        numerator[i] -= rhs[i];
+    }
+    std::array<T, N * 2 - 3> speed2{polymul(dxs, dxs)};
+    const std::array<T, N * 2 - 3> dys2{polymul(dys, dys)};
+    for (std::size_t i{0}; i < speed2.size(); ++i) {
+        speed2[i] += dys2[i];
+    }
+    std::array<T, N * 4 - 9> stationary{polymul(polyder(numerator), speed2)};
+    const std::array<T, N * 4 - 9> stationary_rhs{polymul(numerator, polyder(speed2))};
+    for (std::size_t i{0}; i < stationary.size(); ++i) {
+        stationary[i] = stationary[i] * 2.0 - stationary_rhs[i] * 3.0;
+    }
+    const auto curvature = [&](T r) -> T {
+        const T dx{polyval(dxs, r)};
+        const T dy{polyval(dys, r)};
+        const T speed{std::sqrt(dx * dx + dy * dy)};
+        return std::abs(polyval(numerator, r)) / (speed * speed * speed);
+    };
+    const T kappa_lo{curvature(lo)};
+    const T kappa_hi{curvature(hi)};
+    std::pair<T, T> result{std::min(kappa_lo, kappa_hi), std::max(kappa_lo, kappa_hi)};
+    for (const T r : polyroots(numerator, lo, hi)) {
+        result.first = std::min(result.first, curvature(r));
+    }
+    for (const T r : polyroots(stationary, lo, hi)) {
+        const T kappa{curvature(r)};
+        result.first = std::min(result.first, kappa);
+        result.second = std::max(result.second, kappa);
+    }
+    return result;
+}
+
+} // namespace boyle::math
@@ -14,9 +14,12 @@
 
 #include <array>
 #include <concepts>
+#include <cstddef>
+#include <ranges>
 
 #include "boyle/math/concepts.hpp"
 #include "boyle/math/cubic_interpolation.hpp"
+#include "boyle/math/polynomial.hpp"
 
 namespace boyle::math {
 
@@ -55,6 +58,48 @@ inline constexpr auto quinerpd(
                scale * scale * scale;
 }
 
+/**
+ * @brief Value and first three derivatives of a piecewise quintic spline over the knots ts, where
+ * pos is the index of the first knot past t. Outside the knots the spline continues along the
+ * tangent of its end segment, so the higher derivatives vanish there.
+ */
+template <std::ranges::random_access_range Ts, std::ranges::random_access_range Ys>
+[[using gnu: pure, always_inline, hot]] [[nodiscard]]
+inline constexpr auto quinerpSegment(
+    const Ts& ts, const Ys& ys, const Ys& ddys, const Ys& d4ys, std::size_t pos,
+    std::ranges::range_value_t<Ts> t
+) noexcept -> std::array<std::ranges::range_value_t<Ys>, 4> {
+    using param_type = std::ranges::range_value_t<Ts>;
+    using value_type = std::ranges::range_value_t<Ys>;
+    constexpr std::array<param_type, 4> kFactors{
+        -(1.0 / 3.0), -(1.0 / 6.0), 1.0 / 45.0, 7.0 / 360.0
+    };
+    const std::size_t size{static_cast<std::size_t>(std::ranges::size(ts))};
+    if (pos == 0 || pos == size) {
+        const std::size_t i0{pos == 0 ? 0 : size - 1};
+        const std::size_t i1{pos == 0 ? 1 : size - 2};
+        const param_type h{ts[i1] - ts[i0]};
+        const value_type derivative{
+            (ys[i1] - ys[i0]) / h + (ddys[i0] * kFactors[0] + ddys[i1] * kFactors[1]) * h +
+            (d4ys[i0] * kFactors[2] + d4ys[i1] * kFactors[3]) * h * h * h
+        };
+        return {
+            ys[i0] + derivative * (t - ts[i0]), derivative, static_cast<value_type>(0.0),
+            static_cast<value_type>(0.0)
+        };
+    }
+    const param_type h{ts[pos] - ts[pos - 1]};
+    const param_type ratio{(t - ts[pos - 1]) / h};
+    return {
+        quinerp(ys[pos - 1], ys[pos], ddys[pos - 1], ddys[pos], d4ys[pos - 1], d4ys[pos], ratio, h),
+        quinerpd(
+            ys[pos - 1], ys[pos], ddys[pos - 1], ddys[pos], d4ys[pos - 1], d4ys[pos], ratio, h
+        ),
+        cuberp(ddys[pos - 1], ddys[pos], d4ys[pos - 1], d4ys[pos], ratio, h),
+        cuberpd(ddys[pos - 1], ddys[pos], d4ys[pos - 1], d4ys[pos], ratio, h)
+    };
+}
+
 template <std::floating_point T = double>
 [[using gnu: const, always_inline]] [[nodiscard]]
 inline constexpr auto quinerpCoeffs(T ratio, T scale = 1.0) noexcept -> std::array<T, 6> {
@@ -99,6 +144,46 @@ inline constexpr auto quinerpdCoeffs(T ratio, T scale = 1.0) noexcept -> std::ar
     };
 }
 
+/**
+ * @brief Monomial coefficients in ratio of the segment quinerp interpolates, in ascending order.
+ */
+template <GeneralArithmetic T, std::floating_point U = double>
+[[using gnu: const, always_inline]] [[nodiscard]]
+inline constexpr auto quinerpPoly(
+    T start, T end, T ddstart, T ddend, T d4start, T d4end, U scale = 1.0
+) noexcept -> std::array<T, 6> {
+    constexpr std::array<U, 6> kEndFactors{0.0, 7.0 / 360.0, 0.0, -(1.0 / 36.0), 0.0, 1.0 / 120.0};
+    constexpr std::array<U, 6> kStartFactors{polyreflect(kEndFactors)};
+    const std::array<T, 4> cubic{cuberpPoly(start, end, ddstart, ddend, scale)};
+    const U scale4{scale * scale * scale * scale};
+    std::array<T, 6> result;
+    for (std::size_t i{0}; i < 4; ++i) {
+        result[i] = cubic[i] + (d4start * kStartFactors[i] + d4end * kEndFactors[i]) * scale4;
+    }
+    for (std::size_t i{4}; i < 6; ++i) {
+        result[i] = (d4start * kStartFactors[i] + d4end * kEndFactors[i]) * scale4;
+    }
+    return result;
+}
+
+/**
+ * @brief Fourth derivatives at both ends of the quintic segment with the given values, first and
+ * second derivatives, i.e. the inverse of quinerpd at ratio 0 and 1 with respect to d4start and
+ * d4end.
+ */
+template <GeneralArithmetic T, std::floating_point U = double>
+[[using gnu: const, always_inline]] [[nodiscard]]
+inline constexpr auto calcQuinticD4s(
+    T start, T end, T dstart, T dend, T ddstart, T ddend, U scale = 1.0
+) noexcept -> std::array<T, 2> {
+    const U reci_scale3{1.0 / (scale * scale * scale)};
+    const T residual0{(dstart - cuberpd(start, end, ddstart, ddend, U{0.0}, scale)) * reci_scale3};
+    const T residual1{(dend - cuberpd(start, end, ddstart, ddend, U{1.0}, scale)) * reci_scale3};
+    return std::array<T, 2>{
+        residual0 * 192.0 + residual1 * 168.0, -(residual0 * 168.0 + residual1 * 192.0)
+    };
+}
+
 template <VecArithmetic T>
 [[using gnu: const, flatten, leaf, hot]]
 inline constexpr auto calcArcLength(
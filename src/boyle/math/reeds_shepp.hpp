@@ -0,0 +1,613 @@
+/**
+ * @file reeds_shepp.hpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2024-06-21
+ *
+ * @copyright Copyright (c) 2024 Boyle Development Team
+ *            All rights reserved.
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "fmt/format.h"
+
+#include "boyle/math/vec2.hpp"
+
+namespace boyle::math {
+
+enum class ReedsSheppSegment : std::uint8_t {
+    NOP,
+    LEFT,
+    STRAIGHT,
+    RIGHT
+};
+
+/**
+ * @brief Shortest Reeds-Shepp path between two poses. Segment lengths are normalized by the turning
+ * radius and signed by the driving direction; unused trailing segments are NOP with zero length.
+ */
+template <std::floating_point T>
+struct [[nodiscard]] ReedsSheppPath final {
+    using value_type = T;
+    std::array<ReedsSheppSegment, 5> types{
+        ReedsSheppSegment::NOP, ReedsSheppSegment::NOP, ReedsSheppSegment::NOP,
+        ReedsSheppSegment::NOP, ReedsSheppSegment::NOP
+    };
+    std::array<value_type, 5> lengths{0.0, 0.0, 0.0, 0.0, 0.0};
+    value_type radius{1.0};
+
+    [[using gnu: pure, always_inline]]
+    auto valid() const noexcept -> bool {
+        return types[0] != ReedsSheppSegment::NOP;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto length() const noexcept -> value_type {
+        if (!valid()) {
+            return std::numeric_limits<value_type>::infinity();
+        }
+        return (std::abs(lengths[0]) + std::abs(lengths[1]) + std::abs(lengths[2]) +
+                std::abs(lengths[3]) + std::abs(lengths[4])) *
+               radius;
+    }
+};
+
+template <std::floating_point T>
+struct [[nodiscard]] ReedsSheppState final {
+    using value_type = T;
+    Vec2<value_type> position;
+    value_type heading;
+    value_type curvature;
+    bool forward;
+};
+
+using ReedsSheppPathf = ReedsSheppPath<float>;
+using ReedsSheppPathd = ReedsSheppPath<double>;
+
+using ReedsSheppStatef = ReedsSheppState<float>;
+using ReedsSheppStated = ReedsSheppState<double>;
+
+namespace detail {
+
+inline constexpr double kReedsSheppZero{1E-9};
+
+inline constexpr std::array<std::array<ReedsSheppSegment, 5>, 18> kReedsSheppTypes{{
+    {ReedsSheppSegment::LEFT, ReedsSheppSegment::RIGHT, ReedsSheppSegment::LEFT,
+     ReedsSheppSegment::NOP, ReedsSheppSegment::NOP},
+    {ReedsSheppSegment::RIGHT, ReedsSheppSegment::LEFT, ReedsSheppSegment::RIGHT,
+     ReedsSheppSegment::NOP, ReedsSheppSegment::NOP},
+    {ReedsSheppSegment::LEFT, ReedsSheppSegment::RIGHT, ReedsSheppSegment::LEFT,
+     ReedsSheppSegment::RIGHT, ReedsSheppSegment::NOP},
+    {ReedsSheppSegment::RIGHT, ReedsSheppSegment::LEFT, ReedsSheppSegment::RIGHT,
+     ReedsSheppSegment::LEFT, ReedsSheppSegment::NOP},
+    {ReedsSheppSegment::LEFT, ReedsSheppSegment::RIGHT, ReedsSheppSegment::STRAIGHT,
+     ReedsSheppSegment::LEFT, ReedsSheppSegment::NOP},
+    {ReedsSheppSegment::RIGHT, ReedsSheppSegment::LEFT, ReedsSheppSegment::STRAIGHT,
+     ReedsSheppSegment::RIGHT, ReedsSheppSegment::NOP},
+    {ReedsSheppSegment::LEFT, ReedsSheppSegment::STRAIGHT, ReedsSheppSegment::RIGHT,
+     ReedsSheppSegment::LEFT, ReedsSheppSegment::NOP},
+    {ReedsSheppSegment::RIGHT, ReedsSheppSegment::STRAIGHT, ReedsSheppSegment::LEFT,
+     ReedsSheppSegment::RIGHT, ReedsSheppSegment::NOP},
+    {ReedsSheppSegment::LEFT, ReedsSheppSegment::RIGHT, ReedsSheppSegment::STRAIGHT,
+     ReedsSheppSegment::RIGHT, ReedsSheppSegment::NOP},
+    {ReedsSheppSegment::RIGHT, ReedsSheppSegment::LEFT, ReedsSheppSegment::STRAIGHT,
+     ReedsSheppSegment::LEFT, ReedsSheppSegment::NOP},
+    {ReedsSheppSegment::RIGHT, ReedsSheppSegment::STRAIGHT, ReedsSheppSegment::RIGHT,
+     ReedsSheppSegment::LEFT, ReedsSheppSegment::NOP},
+    {ReedsSheppSegment::LEFT, ReedsSheppSegment::STRAIGHT, ReedsSheppSegment::LEFT,
+     ReedsSheppSegment::RIGHT, ReedsSheppSegment::NOP},
+    {ReedsSheppSegment::LEFT, ReedsSheppSegment::STRAIGHT, ReedsSheppSegment::RIGHT,
+     ReedsSheppSegment::NOP, ReedsSheppSegment::NOP},
+    {ReedsSheppSegment::RIGHT, ReedsSheppSegment::STRAIGHT, ReedsSheppSegment::LEFT,
+     ReedsSheppSegment::NOP, ReedsSheppSegment::NOP},
+    {ReedsSheppSegment::LEFT, ReedsSheppSegment::STRAIGHT, ReedsSheppSegment::LEFT,
+     ReedsSheppSegment::NOP, ReedsSheppSegment::NOP},
+    {ReedsSheppSegment::RIGHT, ReedsSheppSegment::STRAIGHT, ReedsSheppSegment::RIGHT,
+     ReedsSheppSegment::NOP, ReedsSheppSegment::NOP},
+    {ReedsSheppSegment::LEFT, ReedsSheppSegment::RIGHT, ReedsSheppSegment::STRAIGHT,
+     ReedsSheppSegment::LEFT, ReedsSheppSegment::RIGHT},
+    {ReedsSheppSegment::RIGHT, ReedsSheppSegment::LEFT, ReedsSheppSegment::STRAIGHT,
+     ReedsSheppSegment::RIGHT, ReedsSheppSegment::LEFT}
+}};
+
+template <std::floating_point T>
+[[using gnu: const, always_inline]] [[nodiscard]]
+inline auto mod2Pi(T x) noexcept -> T {
+    T v{std::fmod(x, T{2.0 * std::numbers::pi})};
+    if (v < -std::numbers::pi) {
+        v += 2.0 * std::numbers::pi;
+    } else if (v > std::numbers::pi) {
+        v -= 2.0 * std::numbers::pi;
+    }
+    return v;
+}
+
+template <std::floating_point T>
+[[using gnu: always_inline]]
+inline auto tauOmega(T u, T v, T xi, T eta, T phi, T& tau, T& omega) noexcept -> void {
+    const T delta{mod2Pi(u - v)};
+    const T a{std::sin(u) - std::sin(delta)};
+    const T b{std::cos(u) - std::cos(delta) - 1.0};
+    const T t1{std::atan2(eta * a - xi * b, xi * a + eta * b)};
+    const T t2{(std::cos(delta) - std::cos(v) - std::cos(u)) * 2.0 + 3.0};
+    tau = t2 < 0.0 ? mod2Pi(t1 + T{std::numbers::pi}) : mod2Pi(t1);
+    omega = mod2Pi(tau - u + v - phi);
+    return;
+}
+
+template <std::floating_point T>
+[[using gnu: always_inline]]
+inline auto lpSpLp(T x, T y, T phi, T& t, T& u, T& v) noexcept -> bool {
+    const T xi{x - std::sin(phi)};
+    const T eta{y - 1.0 + std::cos(phi)};
+    u = std::hypot(xi, eta);
+    t = std::atan2(eta, xi);
+    if (t >= -kReedsSheppZero) {
+        v = mod2Pi(phi - t);
+        return v >= -kReedsSheppZero;
+    }
+    return false;
+}
+
+template <std::floating_point T>
+[[using gnu: always_inline]]
+inline auto lpSpRp(T x, T y, T phi, T& t, T& u, T& v) noexcept -> bool {
+    const T xi{x + std::sin(phi)};
+    const T eta{y - 1.0 - std::cos(phi)};
+    const T u1{xi * xi + eta * eta};
+    if (u1 < 4.0) {
+        return false;
+    }
+    const T t1{std::atan2(eta, xi)};
+    u = std::sqrt(u1 - 4.0);
+    t = mod2Pi(t1 + std::atan2(T{2.0}, u));
+    v = mod2Pi(t - phi);
+    return t >= -kReedsSheppZero && v >= -kReedsSheppZero;
+}
+
+template <std::floating_point T>
+[[using gnu: always_inline]]
+inline auto lpRmL(T x, T y, T phi, T& t, T& u, T& v) noexcept -> bool {
+    const T xi{x - std::sin(phi)};
+    const T eta{y - 1.0 + std::cos(phi)};
+    const T u1{std::hypot(xi, eta)};
+    if (u1 > 4.0) {
+        return false;
+    }
+    const T theta{std::atan2(eta, xi)};
+    u = -2.0 * std::asin(u1 * 0.25);
+    t = mod2Pi(theta + u * 0.5 + T{std::numbers::pi});
+    v = mod2Pi(phi - t + u);
+    return t >= -kReedsSheppZero && u <= kReedsSheppZero;
+}
+
+template <std::floating_point T>
+[[using gnu: always_inline]]
+inline auto lpRupLumRm(T x, T y, T phi, T& t, T& u, T& v) noexcept -> bool {
+    const T xi{x + std::sin(phi)};
+    const T eta{y - 1.0 - std::cos(phi)};
+    const T rho{(std::hypot(xi, eta) + 2.0) * 0.25};
+    if (rho > 1.0) {
+        return false;
+    }
+    u = std::acos(rho);
+    tauOmega(u, -u, xi, eta, phi, t, v);
+    return t >= -kReedsSheppZero && v <= kReedsSheppZero;
+}
+
+template <std::floating_point T>
+[[using gnu: always_inline]]
+inline auto lpRumLumRp(T x, T y, T phi, T& t, T& u, T& v) noexcept -> bool {
+    const T xi{x + std::sin(phi)};
+    const T eta{y - 1.0 - std::cos(phi)};
+    const T rho{(20.0 - xi * xi - eta * eta) / 16.0};
+    if (rho < 0.0 || rho > 1.0) {
+        return false;
+    }
+    u = -std::acos(rho);
+    if (u < -std::numbers::pi * 0.5) {
+        return false;
+    }
+    tauOmega(u, u, xi, eta, phi, t, v);
+    return t >= -kReedsSheppZero && v >= -kReedsSheppZero;
+}
+
+template <std::floating_point T>
+[[using gnu: always_inline]]
+inline auto lpRmSmLm(T x, T y, T phi, T& t, T& u, T& v) noexcept -> bool {
+    const T xi{x - std::sin(phi)};
+    const T eta{y - 1.0 + std::cos(phi)};
+    const T rho{std::hypot(xi, eta)};
+    if (rho < 2.0) {
+        return false;
+    }
+    const T theta{std::atan2(eta, xi)};
+    const T r{std::sqrt(rho * rho - 4.0)};
+    u = 2.0 - r;
+    t = mod2Pi(theta + std::atan2(r, T{-2.0}));
+    v = mod2Pi(phi - std::numbers::pi * 0.5 - t);
+    return t >= -kReedsSheppZero && u <= kReedsSheppZero && v <= kReedsSheppZero;
+}
+
+template <std::floating_point T>
+[[using gnu: always_inline]]
+inline auto lpRmSmRm(T x, T y, T phi, T& t, T& u, T& v) noexcept -> bool {
+    const T xi{x + std::sin(phi)};
+    const T eta{y - 1.0 - std::cos(phi)};
+    const T rho{std::hypot(eta, xi)};
+    if (rho < 2.0) {
+        return false;
+    }
+    t = std::atan2(xi, -eta);
+    u = 2.0 - rho;
+    v = mod2Pi(t + std::numbers::pi * 0.5 - phi);
+    return t >= -kReedsSheppZero && u <= kReedsSheppZero && v <= kReedsSheppZero;
+}
+
+template <std::floating_point T>
+[[using gnu: always_inline]]
+inline auto lpRmSLmRp(T x, T y, T phi, T& t, T& u, T& v) noexcept -> bool {
+    const T xi{x + std::sin(phi)};
+    const T eta{y - 1.0 - std::cos(phi)};
+    const T rho{std::hypot(xi, eta)};
+    if (rho < 2.0) {
+        return false;
+    }
+    u = 4.0 - std::sqrt(rho * rho - 4.0);
+    if (u > kReedsSheppZero) {
+        return false;
+    }
+    t = mod2Pi(std::atan2((4.0 - u) * xi - 2.0 * eta, -2.0 * xi + (u - 4.0) * eta));
+    v = mod2Pi(t - phi);
+    return t >= -kReedsSheppZero && v >= -kReedsSheppZero;
+}
+
+/**
+ * @brief Every CCSC word carries a quarter turn and every CCSCC word two of them, so those
+ * families are skipped once a path no longer than that is known.
+ */
+template <std::floating_point T>
+class [[nodiscard]] ReedsSheppSolver final {
+  public:
+    [[using gnu: always_inline]]
+    explicit ReedsSheppSolver(T x, T y, T phi) noexcept
+        : m_x{x}, m_y{y}, m_phi{phi}, m_xb{x * std::cos(phi) + y * std::sin(phi)},
+          m_yb{x * std::sin(phi) - y * std::cos(phi)} {}
+
+    [[using gnu: flatten]]
+    auto solve() noexcept -> ReedsSheppPath<T> {
+        csc();
+        ccc();
+        cccc();
+        if (m_length > kHalfPi) {
+            ccsc();
+        }
+        if (m_length > std::numbers::pi) {
+            ccscc();
+        }
+        return m_path;
+    }
+
+  private:
+    static constexpr T kHalfPi{std::numbers::pi * 0.5};
+
+    [[using gnu: always_inline]]
+    auto accept(std::size_t type, std::array<T, 5> lengths) noexcept -> void {
+        const T length{
+            std::abs(lengths[0]) + std::abs(lengths[1]) + std::abs(lengths[2]) +
+            std::abs(lengths[3]) + std::abs(lengths[4])
+        };
+        if (length < m_length) {
+            m_length = length;
+            m_path.types = kReedsSheppTypes[type];
+            m_path.lengths = lengths;
+        }
+        return;
+    }
+
+    auto csc() noexcept -> void {
+        T t, u, v;
+        if (lpSpLp(m_x, m_y, m_phi, t, u, v)) {
+            accept(14, {t, u, v, 0.0, 0.0});
+        }
+        if (lpSpLp(-m_x, m_y, -m_phi, t, u, v)) {
+            accept(14, {-t, -u, -v, 0.0, 0.0});
+        }
+        if (lpSpLp(m_x, -m_y, -m_phi, t, u, v)) {
+            accept(15, {t, u, v, 0.0, 0.0});
+        }
+        if (lpSpLp(-m_x, -m_y, m_phi, t, u, v)) {
+            accept(15, {-t, -u, -v, 0.0, 0.0});
+        }
+        if (lpSpRp(m_x, m_y, m_phi, t, u, v)) {
+            accept(12, {t, u, v, 0.0, 0.0});
+        }
+        if (lpSpRp(-m_x, m_y, -m_phi, t, u, v)) {
+            accept(12, {-t, -u, -v, 0.0, 0.0});
+        }
+        if (lpSpRp(m_x, -m_y, -m_phi, t, u, v)) {
+            accept(13, {t, u, v, 0.0, 0.0});
+        }
+        if (lpSpRp(-m_x, -m_y, m_phi, t, u, v)) {
+            accept(13, {-t, -u, -v, 0.0, 0.0});
+        }
+        return;
+    }
+
+    auto ccc() noexcept -> void {
+        T t, u, v;
+        if (lpRmL(m_x, m_y, m_phi, t, u, v)) {
+            accept(0, {t, u, v, 0.0, 0.0});
+        }
+        if (lpRmL(-m_x, m_y, -m_phi, t, u, v)) {
+            accept(0, {-t, -u, -v, 0.0, 0.0});
+        }
+        if (lpRmL(m_x, -m_y, -m_phi, t, u, v)) {
+            accept(1, {t, u, v, 0.0, 0.0});
+        }
+        if (lpRmL(-m_x, -m_y, m_phi, t, u, v)) {
+            accept(1, {-t, -u, -v, 0.0, 0.0});
+        }
+        if (lpRmL(m_xb, m_yb, m_phi, t, u, v)) {
+            accept(0, {v, u, t, 0.0, 0.0});
+        }
+        if (lpRmL(-m_xb, m_yb, -m_phi, t, u, v)) {
+            accept(0, {-v, -u, -t, 0.0, 0.0});
+        }
+        if (lpRmL(m_xb, -m_yb, -m_phi, t, u, v)) {
+            accept(1, {v, u, t, 0.0, 0.0});
+        }
+        if (lpRmL(-m_xb, -m_yb, m_phi, t, u, v)) {
+            accept(1, {-v, -u, -t, 0.0, 0.0});
+        }
+        return;
+    }
+
+    auto cccc() noexcept -> void {
+        T t, u, v;
+        if (lpRupLumRm(m_x, m_y, m_phi, t, u, v)) {
+            accept(2, {t, u, -u, v, 0.0});
+        }
+        if (lpRupLumRm(-m_x, m_y, -m_phi, t, u, v)) {
+            accept(2, {-t, -u, u, -v, 0.0});
+        }
+        if (lpRupLumRm(m_x, -m_y, -m_phi, t, u, v)) {
+            accept(3, {t, u, -u, v, 0.0});
+        }
+        if (lpRupLumRm(-m_x, -m_y, m_phi, t, u, v)) {
+            accept(3, {-t, -u, u, -v, 0.0});
+        }
+        if (lpRumLumRp(m_x, m_y, m_phi, t, u, v)) {
+            accept(2, {t, u, u, v, 0.0});
+        }
+        if (lpRumLumRp(-m_x, m_y, -m_phi, t, u, v)) {
+            accept(2, {-t, -u, -u, -v, 0.0});
+        }
+        if (lpRumLumRp(m_x, -m_y, -m_phi, t, u, v)) {
+            accept(3, {t, u, u, v, 0.0});
+        }
+        if (lpRumLumRp(-m_x, -m_y, m_phi, t, u, v)) {
+            accept(3, {-t, -u, -u, -v, 0.0});
+        }
+        return;
+    }
+
+    auto ccsc() noexcept -> void {
+        T t, u, v;
+        if (lpRmSmLm(m_x, m_y, m_phi, t, u, v)) {
+            accept(4, {t, -kHalfPi, u, v, 0.0});
+        }
+        if (lpRmSmLm(-m_x, m_y, -m_phi, t, u, v)) {
+            accept(4, {-t, kHalfPi, -u, -v, 0.0});
+        }
+        if (lpRmSmLm(m_x, -m_y, -m_phi, t, u, v)) {
+            accept(5, {t, -kHalfPi, u, v, 0.0});
+        }
+        if (lpRmSmLm(-m_x, -m_y, m_phi, t, u, v)) {
+            accept(5, {-t, kHalfPi, -u, -v, 0.0});
+        }
+        if (lpRmSmRm(m_x, m_y, m_phi, t, u, v)) {
+            accept(8, {t, -kHalfPi, u, v, 0.0});
+        }
+        if (lpRmSmRm(-m_x, m_y, -m_phi, t, u, v)) {
+            accept(8, {-t, kHalfPi, -u, -v, 0.0});
+        }
+        if (lpRmSmRm(m_x, -m_y, -m_phi, t, u, v)) {
+            accept(9, {t, -kHalfPi, u, v, 0.0});
+        }
+        if (lpRmSmRm(-m_x, -m_y, m_phi, t, u, v)) {
+            accept(9, {-t, kHalfPi, -u, -v, 0.0});
+        }
+        if (lpRmSmLm(m_xb, m_yb, m_phi, t, u, v)) {
+            accept(6, {v, u, -kHalfPi, t, 0.0});
+        }
+        if (lpRmSmLm(-m_xb, m_yb, -m_phi, t, u, v)) {
+            accept(6, {-v, -u, kHalfPi, -t, 0.0});
+        }
+        if (lpRmSmLm(m_xb, -m_yb, -m_phi, t, u, v)) {
+            accept(7, {v, u, -kHalfPi, t, 0.0});
+        }
+        if (lpRmSmLm(-m_xb, -m_yb, m_phi, t, u, v)) {
+            accept(7, {-v, -u, kHalfPi, -t, 0.0});
+        }
+        if (lpRmSmRm(m_xb, m_yb, m_phi, t, u, v)) {
+            accept(10, {v, u, -kHalfPi, t, 0.0});
+        }
+        if (lpRmSmRm(-m_xb, m_yb, -m_phi, t, u, v)) {
+            accept(10, {-v, -u, kHalfPi, -t, 0.0});
+        }
+        if (lpRmSmRm(m_xb, -m_yb, -m_phi, t, u, v)) {
+            accept(11, {v, u, -kHalfPi, t, 0.0});
+        }
+        if (lpRmSmRm(-m_xb, -m_yb, m_phi, t, u, v)) {
+            accept(11, {-v, -u, kHalfPi, -t, 0.0});
+        }
+        return;
+    }
+
+    auto ccscc() noexcept -> void {
+        T t, u, v;
+        if (lpRmSLmRp(m_x, m_y, m_phi, t, u, v)) {
+            accept(16, {t, -kHalfPi, u, -kHalfPi, v});
+        }
+        if (lpRmSLmRp(-m_x, m_y, -m_phi, t, u, v)) {
+            accept(16, {-t, kHalfPi, -u, kHalfPi, -v});
+        }
+        if (lpRmSLmRp(m_x, -m_y, -m_phi, t, u, v)) {
+            accept(17, {t, -kHalfPi, u, -kHalfPi, v});
+        }
+        if (lpRmSLmRp(-m_x, -m_y, m_phi, t, u, v)) {
+            accept(17, {-t, kHalfPi, -u, kHalfPi, -v});
+        }
+        return;
+    }
+
+    T m_x;
+    T m_y;
+    T m_phi;
+    T m_xb;
+    T m_yb;
+    T m_length{std::numeric_limits<T>::infinity()};
+    ReedsSheppPath<T> m_path{};
+};
+
+} // namespace detail
+
+/**
+ * @brief Closed-form shortest Reeds-Shepp path over all 48 word families (Reeds and Shepp, 1990),
+ * for a car with the given minimum turning radius.
+ */
+template <std::floating_point T>
+[[using gnu: flatten]] [[nodiscard]]
+inline auto reedsSheppPath(
+    Vec2<T> start, T start_heading, Vec2<T> goal, T goal_heading, T radius
+) noexcept -> ReedsSheppPath<T> {
+    const Vec2<T> offset{(goal - start).rotate(-start_heading) / radius};
+    ReedsSheppPath<T> path{
+        detail::ReedsSheppSolver<T>{offset.x, offset.y, goal_heading - start_heading}.solve()
+    };
+    path.radius = radius;
+    return path;
+}
+
+/**
+ * @brief Reeds-Shepp path lengths for many start-goal pairs at once, see dubinsLengths().
+ */
+template <std::floating_point T>
+inline auto reedsSheppLengths(
+    std::span<const Vec2<T>> starts, std::span<const T> start_headings,
+    std::span<const Vec2<T>> goals, std::span<const T> goal_headings, T radius,
+    std::span<T> lengths
+) noexcept(!BOYLE_CHECK_PARAMS) -> void {
+    const std::size_t size{starts.size()};
+#if BOYLE_CHECK_PARAMS == 1
+    if (start_headings.size() != size || goals.size() != size || goal_headings.size() != size ||
+        lengths.size() != size) [[unlikely]] {
+        throw std::invalid_argument(fmt::format(
+            "Invalid arguments detected! All spans must share the same size: starts.size() = "
+            "{0:d}, start_headings.size() = {1:d}, goals.size() = {2:d}, goal_headings.size() = "
+            "{3:d}, lengths.size() = {4:d}",
+            size, start_headings.size(), goals.size(), goal_headings.size(), lengths.size()
+        ));
+    }
+#endif
+    for (std::size_t i{0}; i < size; ++i) {
+        lengths[i] =
+            reedsSheppPath(starts[i], start_headings[i], goals[i], goal_headings[i], radius)
+                .length();
+    }
+    return;
+}
+
+/**
+ * @brief Pose reached after driving the path for arc length s from the given start pose. Negative
+ * segment lengths are driven in reverse.
+ */
+template <std::floating_point T>
+[[using gnu: pure]] [[nodiscard]]
+inline auto reedsSheppState(
+    const ReedsSheppPath<T>& path, Vec2<T> start, T start_heading, T s
+) noexcept -> ReedsSheppState<T> {
+    T x{0.0};
+    T y{0.0};
+    T phi{0.0};
+    T remain{std::max(s, T{0.0}) / path.radius};
+    ReedsSheppSegment type{ReedsSheppSegment::STRAIGHT};
+    bool forward{true};
+    for (std::size_t i{0}; i < 5 && path.types[i] != ReedsSheppSegment::NOP; ++i) {
+        const T length{path.lengths[i]};
+        T v{length < 0.0 ? std::max(length, -remain) : std::min(length, remain)};
+        type = path.types[i];
+        forward = length >= 0.0;
+        remain -= std::abs(v);
+        switch (type) {
+        case ReedsSheppSegment::LEFT:
+            x += std::sin(phi + v) - std::sin(phi);
+            y += -std::cos(phi + v) + std::cos(phi);
+            phi += v;
+            break;
+        case ReedsSheppSegment::RIGHT:
+            x += -std::sin(phi - v) + std::sin(phi);
+            y += std::cos(phi - v) - std::cos(phi);
+            phi -= v;
+            break;
+        default:
+            x += v * std::cos(phi);
+            y += v * std::sin(phi);
+            break;
+        }
+        if (remain <= 0.0) {
+            break;
+        }
+    }
+    const T curvature{
+        type == ReedsSheppSegment::LEFT    ? T{1.0} / path.radius
+        : type == ReedsSheppSegment::RIGHT ? T{-1.0} / path.radius
+                                           : T{0.0}
+    };
+    return ReedsSheppState<T>{
+        .position = start + Vec2<T>{x, y}.rotate(start_heading) * path.radius,
+        .heading = start_heading + phi,
+        .curvature = curvature,
+        .forward = forward
+    };
+}
+
+/**
+ * @brief Samples the path every ds of arc length, always including both ends.
+ */
+template <std::floating_point T>
+[[nodiscard]]
+inline auto reedsSheppSample(
+    const ReedsSheppPath<T>& path, Vec2<T> start, T start_heading, T ds
+) noexcept -> std::vector<ReedsSheppState<T>> {
+    std::vector<ReedsSheppState<T>> states;
+    if (!path.valid()) {
+        return states;
+    }
+    const T length{path.length()};
+    const std::size_t num_samples{static_cast<std::size_t>(std::ceil(length / ds)) + 1};
+    states.reserve(num_samples);
+    for (std::size_t i{0}; i < num_samples; ++i) {
+        states.push_back(reedsSheppState(
+            path, start, start_heading, std::min(ds * static_cast<T>(i), length)
+        ));
+    }
+    return states;
+}
+
+} // namespace boyle::math
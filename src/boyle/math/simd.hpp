@@ -0,0 +1,84 @@
+/**
+ * @file simd.hpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2024-06-25
+ *
+ * @copyright Copyright (c) 2024 Boyle Development Team
+ *            All rights reserved.
+ *
+ */
+
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <stdexcept>
+
+#include "fmt/format.h"
+
+#if BOYLE_USE_SIMD == 1 && __has_include(<experimental/simd>)
+// GCC 12 flags the AVX-512 intrinsics behind std::experimental::sqrt as maybe-uninitialized.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+#include <experimental/simd>
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#define BOYLE_HAS_SIMD 1
+#else
+#define BOYLE_HAS_SIMD 0
+#endif
+
+namespace boyle::math::detail {
+
+#if BOYLE_HAS_SIMD == 1
+
+/**
+ * @brief Widest SIMD register for T on the target, e.g. 4 doubles with AVX2 and 8 with AVX-512.
+ */
+template <std::floating_point T>
+using Simd = std::experimental::native_simd<T>;
+
+template <std::floating_point T>
+inline constexpr std::size_t kSimdWidth{Simd<T>::size()};
+
+template <std::floating_point T>
+[[using gnu: pure, always_inline]] [[nodiscard]]
+inline auto simdLoad(const T* ptr) noexcept -> Simd<T> {
+    return Simd<T>{ptr, std::experimental::element_aligned};
+}
+
+template <std::floating_point T>
+[[using gnu: always_inline]]
+inline auto simdStore(const Simd<T>& value, T* ptr) noexcept -> void {
+    value.copy_to(ptr, std::experimental::element_aligned);
+    return;
+}
+
+#else
+
+template <std::floating_point T>
+inline constexpr std::size_t kSimdWidth{1};
+
+#endif
+
+[[using gnu: always_inline]]
+inline auto checkBatchSizes(
+    [[maybe_unused]] std::size_t lhs, [[maybe_unused]] std::size_t rhs
+) noexcept(!BOYLE_CHECK_PARAMS) -> void {
+#if BOYLE_CHECK_PARAMS == 1
+    if (lhs != rhs) [[unlikely]] {
+        throw std::invalid_argument(fmt::format(
+            "Invalid arguments detected! Batch operands must share the same size: {0:d} != {1:d}",
+            lhs, rhs
+        ));
+    }
+#endif
+    return;
+}
+
+} // namespace boyle::math::detail
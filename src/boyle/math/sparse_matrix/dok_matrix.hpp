@@ -13,6 +13,8 @@
 #pragma once
 
 #include <concepts>
+#include <memory_resource>
+#include <utility>
 
 #include "boost/serialization/access.hpp"
 #include "boost/unordered/unordered_flat_map.hpp"
@@ -29,6 +31,10 @@ class DokMatrix final {
   public:
     using value_type = Scalar;
     using index_type = Index;
+    using allocator_type =
+        std::pmr::polymorphic_allocator<std::pair<const IndexPair<Index>, Scalar>>;
+    using dictionary_type = boost::unordered_flat_map<
+        IndexPair<Index>, Scalar, IndexPairHash<Index>, IndexPairEqual<Index>, allocator_type>;
 
     DokMatrix() noexcept = default;
     DokMatrix(const DokMatrix& other) noexcept = default;
@@ -37,9 +43,20 @@ class DokMatrix final {
     auto operator=(DokMatrix&& other) noexcept -> DokMatrix& = default;
     ~DokMatrix() noexcept = default;
 
+    /**
+     * @brief Empty matrix whose dictionaries live on the given resource, which has to outlive the
+     * matrix. Resetting an arena the matrix is built on invalidates the matrix.
+     */
     [[using gnu: always_inline]]
-    explicit DokMatrix(std::size_t nrows, std::size_t ncols) noexcept
-        : m_nrows{nrows}, m_ncols{ncols} {}
+    explicit DokMatrix(std::pmr::memory_resource* resource) noexcept
+        : m_dictionary{allocator_type{resource}} {}
+
+    [[using gnu: always_inline]]
+    explicit DokMatrix(
+        std::size_t nrows, std::size_t ncols,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) noexcept
+        : m_nrows{nrows}, m_ncols{ncols}, m_dictionary{allocator_type{resource}} {}
 
     [[using gnu: pure, always_inline]] [[nodiscard]]
     auto nrows() const noexcept -> std::size_t {
@@ -119,12 +136,15 @@ class DokMatrix final {
     }
 
     [[using gnu: pure, always_inline, leaf]]
-    auto dictionary() const noexcept
-        -> const boost::unordered_flat_map<
-            IndexPair<Index>, Scalar, IndexPairHash<Index>, IndexPairEqual<Index>>& {
+    auto dictionary() const noexcept -> const dictionary_type& {
         return m_dictionary;
     }
 
+    [[using gnu: pure, always_inline]]
+    auto resource() const noexcept -> std::pmr::memory_resource* {
+        return m_dictionary.get_allocator().resource();
+    }
+
   private:
     [[using gnu: always_inline]]
     auto serialize(auto& archive, [[maybe_unused]] const unsigned int version) noexcept -> void {
@@ -136,8 +156,7 @@ class DokMatrix final {
 
     std::size_t m_nrows{0};
     std::size_t m_ncols{0};
-    boost::unordered_flat_map<IndexPair<Index>, Scalar, IndexPairHash<Index>, IndexPairEqual<Index>>
-        m_dictionary{};
+    dictionary_type m_dictionary{};
 };
 
 } // namespace boyle::math
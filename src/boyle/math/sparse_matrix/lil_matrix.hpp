@@ -14,8 +14,11 @@
 
 #include <algorithm>
 #include <concepts>
+#include <functional>
+#include <memory_resource>
 #include <utility>
 
+#include "boost/container_hash/hash.hpp"
 #include "boost/serialization/access.hpp"
 #include "boost/unordered/unordered_flat_map.hpp"
 
@@ -31,6 +34,13 @@ class [[nodiscard]] LilMatrix final {
   public:
     using value_type = Scalar;
     using index_type = Index;
+    using row_dictionary_type = boost::unordered_flat_map<
+        Index, Scalar, boost::hash<Index>, std::equal_to<Index>,
+        std::pmr::polymorphic_allocator<std::pair<const Index, Scalar>>>;
+    using allocator_type =
+        std::pmr::polymorphic_allocator<std::pair<const Index, row_dictionary_type>>;
+    using row_dictionaries_type = boost::unordered_flat_map<
+        Index, row_dictionary_type, boost::hash<Index>, std::equal_to<Index>, allocator_type>;
 
     LilMatrix() noexcept = default;
     LilMatrix(const LilMatrix& other) noexcept = default;
@@ -39,20 +49,35 @@ class [[nodiscard]] LilMatrix final {
     auto operator=(LilMatrix&& other) noexcept -> LilMatrix& = default;
     ~LilMatrix() noexcept = default;
 
+    /**
+     * @brief Empty matrix whose dictionaries live on the given resource, which has to outlive the
+     * matrix. Resetting an arena the matrix is built on invalidates the matrix.
+     */
     [[using gnu: always_inline]]
-    explicit LilMatrix(std::size_t nrows, std::size_t ncols) noexcept
-        : m_nrows{nrows}, m_ncols{ncols} {}
+    explicit LilMatrix(std::pmr::memory_resource* resource) noexcept
+        : m_row_dictionaries{allocator_type{resource}} {}
 
     [[using gnu: always_inline]]
-    LilMatrix(const DokMatrix<Scalar, Index>& dok_matrix) noexcept
-        : m_nrows{dok_matrix.nrows()}, m_ncols{dok_matrix.ncols()}, m_nnzs{dok_matrix.nnzs()} {
+    explicit LilMatrix(
+        std::size_t nrows, std::size_t ncols,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) noexcept
+        : m_nrows{nrows}, m_ncols{ncols}, m_row_dictionaries{allocator_type{resource}} {}
+
+    [[using gnu: always_inline]]
+    LilMatrix(
+        const DokMatrix<Scalar, Index>& dok_matrix,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) noexcept
+        : m_nrows{dok_matrix.nrows()}, m_ncols{dok_matrix.ncols()}, m_nnzs{dok_matrix.nnzs()},
+          m_row_dictionaries{allocator_type{resource}} {
         for (const auto& [index_pair, value] : dok_matrix.dictionary()) {
-            m_row_dictionaries[index_pair.row].emplace(index_pair.col, value);
+            rowDictionary(index_pair.row).emplace(index_pair.col, value);
         }
     }
 
     [[using gnu: ]] operator DokMatrix<Scalar, Index>() const noexcept {
-        DokMatrix dok_matrix{m_nrows, m_ncols};
+        DokMatrix<Scalar, Index> dok_matrix{m_nrows, m_ncols, resource()};
         dok_matrix.reserve(m_nnzs);
         for (const auto& [row, row_dictionary] : m_row_dictionaries) {
             for (const auto& [col, value] : row_dictionary) {
@@ -165,9 +190,7 @@ class [[nodiscard]] LilMatrix final {
         } else {
             if (value != Scalar{0.0}) {
                 m_nnzs += 1;
-                m_row_dictionaries.emplace(
-                    row, boost::unordered_flat_map<int, double>{{col, value}}
-                );
+                rowDictionary(row).emplace(col, value);
             }
         }
         return;
@@ -178,9 +201,16 @@ class [[nodiscard]] LilMatrix final {
         return coeff(row, col);
     }
 
+    /**
+     * @brief Replaces a row by a dictionary built on the matrix's resource. The dictionary is moved
+     * in when its resource is the matrix's one and copied onto the matrix's resource otherwise.
+     */
     [[using gnu: flatten, leaf, hot]]
-    auto updateRow(Index row, boost::unordered_flat_map<Index, Scalar> row_dictionary) noexcept
-        -> void {
+    auto updateRow(Index row, row_dictionary_type&& row_dictionary) noexcept -> void {
+        if (row_dictionary.get_allocator() != m_row_dictionaries.get_allocator()) {
+            updateRow(row, std::as_const(row_dictionary));
+            return;
+        }
         if (row >= static_cast<Index>(m_nrows)) {
             return;
         }
@@ -199,13 +229,57 @@ class [[nodiscard]] LilMatrix final {
         return;
     }
 
+    template <typename Dictionary>
+        requires std::same_as<Dictionary, boost::unordered_flat_map<Index, Scalar>> ||
+                 std::same_as<Dictionary, row_dictionary_type>
+    [[using gnu: flatten, leaf, hot]]
+    auto updateRow(Index row, const Dictionary& row_dictionary) noexcept -> void {
+        if (row >= static_cast<Index>(m_nrows)) {
+            return;
+        }
+        if (auto search = m_row_dictionaries.find(row); search != m_row_dictionaries.end()) {
+            m_nnzs -= search->second.size();
+            m_row_dictionaries.erase(search);
+        }
+        row_dictionary_type filtered_dictionary{m_row_dictionaries.get_allocator()};
+        filtered_dictionary.reserve(row_dictionary.size());
+        for (const auto& [col, value] : row_dictionary) {
+            if (col < static_cast<Index>(m_ncols) && value != Scalar{0.0}) {
+                filtered_dictionary.emplace(col, value);
+            }
+        }
+        if (filtered_dictionary.empty()) {
+            return;
+        }
+        m_nnzs += filtered_dictionary.size();
+        m_row_dictionaries.emplace(row, std::move(filtered_dictionary));
+        return;
+    }
+
     [[using gnu: always_inline, leaf]]
-    auto row_dictionaries() const noexcept
-        -> const boost::unordered_flat_map<Index, boost::unordered_flat_map<Index, Scalar>>& {
+    auto row_dictionaries() const noexcept -> const row_dictionaries_type& {
         return m_row_dictionaries;
     }
 
+    [[using gnu: pure, always_inline]]
+    auto resource() const noexcept -> std::pmr::memory_resource* {
+        return m_row_dictionaries.get_allocator().resource();
+    }
+
   private:
+    /**
+     * @brief Row dictionary of the given row, inserted empty on the matrix's resource if absent.
+     */
+    [[using gnu: always_inline]]
+    auto rowDictionary(Index row) noexcept -> row_dictionary_type& {
+        if (auto search = m_row_dictionaries.find(row); search != m_row_dictionaries.end()) {
+            return search->second;
+        }
+        return m_row_dictionaries
+            .emplace(row, row_dictionary_type{m_row_dictionaries.get_allocator()})
+            .first->second;
+    }
+
     [[using gnu: always_inline]]
     auto serialize(auto& archive, [[maybe_unused]] const unsigned int version) noexcept -> void {
         archive & m_nrows;
@@ -218,7 +292,7 @@ class [[nodiscard]] LilMatrix final {
     std::size_t m_nrows{0};
     std::size_t m_ncols{0};
     std::size_t m_nnzs{0};
-    boost::unordered_flat_map<Index, boost::unordered_flat_map<Index, Scalar>> m_row_dictionaries{};
+    row_dictionaries_type m_row_dictionaries{};
 };
 
 } // namespace boyle::math
@@ -106,7 +106,7 @@ inline auto hasDuplicates(std::ranges::forward_range auto&& range, double tol =
 }
 
 [[using gnu: pure, flatten, leaf, hot]]
-inline auto nearestUpperElement(
+inline constexpr auto nearestUpperElement(
     std::ranges::forward_range auto&& range, std::ranges::range_value_t<decltype(range)> element,
     double tol = 1E-8
 ) noexcept -> std::ranges::iterator_t<decltype(range)>
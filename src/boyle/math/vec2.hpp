@@ -366,7 +366,7 @@ namespace boost::serialization {
 inline constexpr auto serialize(
     auto& archive, boyle::math::InstanceOfTemplate<boyle::math::Vec2> auto& obj,
     [[maybe_unused]] const unsigned int version
-) noexcept -> void {
+) -> void {
     archive & obj.x;
     archive & obj.y;
     return;
@@ -0,0 +1,505 @@
+/**
+ * @file vec2_array.hpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2024-06-25
+ *
+ * @copyright Copyright (c) 2024 Boyle Development Team
+ *            All rights reserved.
+ *
+ */
+
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "boost/serialization/access.hpp"
+#include "boost/serialization/vector.hpp"
+#include "fmt/format.h"
+
+#include "boyle/math/simd.hpp"
+#include "boyle/math/vec2.hpp"
+
+namespace boyle::math {
+
+/**
+ * @brief Read-only view over planar points stored as two coordinate streams. The streams are
+ * either contiguous (a Vec2Array, which the kernels below vectorize) or interleaved with stride 2,
+ * which is how a std::span<const Vec2<T>> looks in memory, so both layouts are viewed without
+ * copying.
+ */
+template <std::floating_point T>
+class [[nodiscard]] Vec2ArrayView final {
+  public:
+    using value_type = Vec2<T>;
+
+    static_assert(
+        std::is_standard_layout_v<Vec2<T>> && sizeof(Vec2<T>) == 2 * sizeof(T),
+        "Vec2 must be two tightly packed coordinates to be viewed as interleaved streams."
+    );
+
+    Vec2ArrayView() noexcept = default;
+    Vec2ArrayView(const Vec2ArrayView& other) noexcept = default;
+    auto operator=(const Vec2ArrayView& other) noexcept -> Vec2ArrayView& = default;
+    Vec2ArrayView(Vec2ArrayView&& other) noexcept = default;
+    auto operator=(Vec2ArrayView&& other) noexcept -> Vec2ArrayView& = default;
+    ~Vec2ArrayView() noexcept = default;
+
+    [[using gnu: always_inline]]
+    Vec2ArrayView(std::span<const T> xs, std::span<const T> ys) noexcept(!BOYLE_CHECK_PARAMS)
+        : m_xs{xs.data()}, m_ys{ys.data()}, m_size{xs.size()}, m_stride{1} {
+#if BOYLE_CHECK_PARAMS == 1
+        if (xs.size() != ys.size()) [[unlikely]] {
+            throw std::invalid_argument(fmt::format(
+                "Invalid arguments detected! xs and ys must share the same size: xs.size() = "
+                "{0:d}, ys.size() = {1:d}",
+                xs.size(), ys.size()
+            ));
+        }
+#endif
+    }
+
+    [[using gnu: always_inline]]
+    Vec2ArrayView(std::span<const value_type> points) noexcept
+        : m_xs{reinterpret_cast<const T*>(points.data())},
+          m_ys{points.empty() ? nullptr : reinterpret_cast<const T*>(points.data()) + 1},
+          m_size{points.size()}, m_stride{2} {}
+
+    [[using gnu: always_inline]]
+    Vec2ArrayView(const std::vector<value_type>& points) noexcept
+        : Vec2ArrayView(std::span<const value_type>{points}) {}
+
+    [[using gnu: pure, always_inline]]
+    auto operator[](std::size_t pos) const noexcept -> value_type {
+        return value_type{m_xs[pos * m_stride], m_ys[pos * m_stride]};
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto size() const noexcept -> std::size_t {
+        return m_size;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto empty() const noexcept -> bool {
+        return m_size == 0;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto stride() const noexcept -> std::size_t {
+        return m_stride;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto contiguous() const noexcept -> bool {
+        return m_stride == 1;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto interleaved() const noexcept -> bool {
+        return m_stride == 2 && m_ys == m_xs + 1;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto xs() const noexcept -> const T* {
+        return m_xs;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto ys() const noexcept -> const T* {
+        return m_ys;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto subview(std::size_t offset, std::size_t count) const noexcept -> Vec2ArrayView {
+        Vec2ArrayView result{*this};
+        result.m_xs += offset * m_stride;
+        result.m_ys += offset * m_stride;
+        result.m_size = count;
+        return result;
+    }
+
+    /**
+     * @brief The viewed points as AoS, without copying. Only views created from AoS storage can be
+     * converted back.
+     */
+    [[using gnu: pure, always_inline]]
+    auto toSpan() const noexcept(!BOYLE_CHECK_PARAMS) -> std::span<const value_type> {
+#if BOYLE_CHECK_PARAMS == 1
+        if (!interleaved() && !empty()) [[unlikely]] {
+            throw std::invalid_argument(
+                "Invalid arguments detected! Only interleaved views can be converted to a span of "
+                "Vec2."
+            );
+        }
+#endif
+        return std::span<const value_type>{reinterpret_cast<const value_type*>(m_xs), m_size};
+    }
+
+  private:
+    const T* m_xs{nullptr};
+    const T* m_ys{nullptr};
+    std::size_t m_size{0};
+    std::size_t m_stride{1};
+};
+
+/**
+ * @brief Planar points in SoA layout: all x coordinates, then all y coordinates.
+ */
+template <std::floating_point T>
+class [[nodiscard]] Vec2Array final {
+    friend class boost::serialization::access;
+
+  public:
+    using value_type = Vec2<T>;
+
+    Vec2Array() noexcept = default;
+    Vec2Array(const Vec2Array& other) = default;
+    auto operator=(const Vec2Array& other) -> Vec2Array& = default;
+    Vec2Array(Vec2Array&& other) noexcept = default;
+    auto operator=(Vec2Array&& other) noexcept -> Vec2Array& = default;
+    ~Vec2Array() noexcept = default;
+
+    [[using gnu: always_inline]]
+    explicit Vec2Array(std::size_t size, value_type value = value_type{0.0})
+        : m_xs(size, value.x), m_ys(size, value.y) {}
+
+    [[using gnu: always_inline]]
+    explicit Vec2Array(std::vector<T> xs, std::vector<T> ys) noexcept(!BOYLE_CHECK_PARAMS)
+        : m_xs{std::move(xs)}, m_ys{std::move(ys)} {
+#if BOYLE_CHECK_PARAMS == 1
+        if (m_xs.size() != m_ys.size()) [[unlikely]] {
+            throw std::invalid_argument(fmt::format(
+                "Invalid arguments detected! xs and ys must share the same size: xs.size() = "
+                "{0:d}, ys.size() = {1:d}",
+                m_xs.size(), m_ys.size()
+            ));
+        }
+#endif
+    }
+
+    [[using gnu: ]]
+    explicit Vec2Array(Vec2ArrayView<T> points) : m_xs(points.size()), m_ys(points.size()) {
+        for (std::size_t i{0}; i < points.size(); ++i) {
+            const value_type point{points[i]};
+            m_xs[i] = point.x;
+            m_ys[i] = point.y;
+        }
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto operator[](std::size_t pos) const noexcept -> value_type {
+        return value_type{m_xs[pos], m_ys[pos]};
+    }
+
+    [[using gnu: always_inline]]
+    auto set(std::size_t pos, value_type point) noexcept -> void {
+        m_xs[pos] = point.x;
+        m_ys[pos] = point.y;
+        return;
+    }
+
+    [[using gnu: always_inline]]
+    auto push_back(value_type point) -> void {
+        m_xs.push_back(point.x);
+        m_ys.push_back(point.y);
+        return;
+    }
+
+    [[using gnu: always_inline]]
+    auto reserve(std::size_t capacity) -> void {
+        m_xs.reserve(capacity);
+        m_ys.reserve(capacity);
+        return;
+    }
+
+    [[using gnu: always_inline]]
+    auto resize(std::size_t size) -> void {
+        m_xs.resize(size);
+        m_ys.resize(size);
+        return;
+    }
+
+    [[using gnu: always_inline]]
+    auto clear() noexcept -> void {
+        m_xs.clear();
+        m_ys.clear();
+        return;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto size() const noexcept -> std::size_t {
+        return m_xs.size();
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto empty() const noexcept -> bool {
+        return m_xs.empty();
+    }
+
+    [[using gnu: always_inline]]
+    auto xs() noexcept -> std::span<T> {
+        return m_xs;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto xs() const noexcept -> std::span<const T> {
+        return m_xs;
+    }
+
+    [[using gnu: always_inline]]
+    auto ys() noexcept -> std::span<T> {
+        return m_ys;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto ys() const noexcept -> std::span<const T> {
+        return m_ys;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto view() const noexcept -> Vec2ArrayView<T> {
+        return Vec2ArrayView<T>{std::span<const T>{m_xs}, std::span<const T>{m_ys}};
+    }
+
+    [[using gnu: pure, always_inline]]
+    operator Vec2ArrayView<T>() const noexcept {
+        return view();
+    }
+
+    [[using gnu: pure]]
+    auto toVector() const -> std::vector<value_type> {
+        std::vector<value_type> points;
+        points.reserve(size());
+        for (std::size_t i{0}; i < size(); ++i) {
+            points.emplace_back(m_xs[i], m_ys[i]);
+        }
+        return points;
+    }
+
+  private:
+    [[using gnu: always_inline]]
+    auto serialize(auto& archive, [[maybe_unused]] const unsigned int version) noexcept -> void {
+        archive & m_xs;
+        archive & m_ys;
+        return;
+    }
+
+    std::vector<T> m_xs{};
+    std::vector<T> m_ys{};
+};
+
+using Vec2fArray = Vec2Array<float>;
+using Vec2dArray = Vec2Array<double>;
+using Vec2fArrayView = Vec2ArrayView<float>;
+using Vec2dArrayView = Vec2ArrayView<double>;
+
+/**
+ * @brief Element-wise kernels. The SIMD path runs when every operand is contiguous; interleaved
+ * views and the remainder of each batch take the scalar path. Outputs may alias the inputs.
+ */
+template <std::floating_point T>
+[[using gnu: hot]]
+inline auto dot(Vec2ArrayView<T> lhs, Vec2ArrayView<T> rhs, std::span<T> out) noexcept(
+    !BOYLE_CHECK_PARAMS
+) -> void {
+    const std::size_t size{lhs.size()};
+    detail::checkBatchSizes(size, rhs.size());
+    detail::checkBatchSizes(size, out.size());
+    std::size_t i{0};
+#if BOYLE_HAS_SIMD == 1
+    if (lhs.contiguous() && rhs.contiguous()) {
+        constexpr std::size_t kWidth{detail::kSimdWidth<T>};
+        for (; i + kWidth <= size; i += kWidth) {
+            detail::simdStore<T>(
+                detail::simdLoad(lhs.xs() + i) * detail::simdLoad(rhs.xs() + i) +
+                    detail::simdLoad(lhs.ys() + i) * detail::simdLoad(rhs.ys() + i),
+                out.data() + i
+            );
+        }
+    }
+#endif
+    for (; i < size; ++i) {
+        out[i] = lhs[i].dot(rhs[i]);
+    }
+    return;
+}
+
+template <std::floating_point T>
+[[using gnu: hot]]
+inline auto crossProj(Vec2ArrayView<T> lhs, Vec2ArrayView<T> rhs, std::span<T> out) noexcept(
+    !BOYLE_CHECK_PARAMS
+) -> void {
+    const std::size_t size{lhs.size()};
+    detail::checkBatchSizes(size, rhs.size());
+    detail::checkBatchSizes(size, out.size());
+    std::size_t i{0};
+#if BOYLE_HAS_SIMD == 1
+    if (lhs.contiguous() && rhs.contiguous()) {
+        constexpr std::size_t kWidth{detail::kSimdWidth<T>};
+        for (; i + kWidth <= size; i += kWidth) {
+            detail::simdStore<T>(
+                detail::simdLoad(lhs.xs() + i) * detail::simdLoad(rhs.ys() + i) -
+                    detail::simdLoad(lhs.ys() + i) * detail::simdLoad(rhs.xs() + i),
+                out.data() + i
+            );
+        }
+    }
+#endif
+    for (; i < size; ++i) {
+        out[i] = lhs[i].crossProj(rhs[i]);
+    }
+    return;
+}
+
+template <std::floating_point T>
+[[using gnu: hot]]
+inline auto euclidean(Vec2ArrayView<T> points, std::span<T> out) noexcept(!BOYLE_CHECK_PARAMS)
+    -> void {
+    const std::size_t size{points.size()};
+    detail::checkBatchSizes(size, out.size());
+    std::size_t i{0};
+#if BOYLE_HAS_SIMD == 1
+    if (points.contiguous()) {
+        constexpr std::size_t kWidth{detail::kSimdWidth<T>};
+        for (; i + kWidth <= size; i += kWidth) {
+            const detail::Simd<T> x{detail::simdLoad(points.xs() + i)};
+            const detail::Simd<T> y{detail::simdLoad(points.ys() + i)};
+            detail::simdStore<T>(std::experimental::sqrt(x * x + y * y), out.data() + i);
+        }
+    }
+#endif
+    for (; i < size; ++i) {
+        out[i] = points[i].euclidean();
+    }
+    return;
+}
+
+template <std::floating_point T>
+[[using gnu: hot]]
+inline auto normalize(Vec2ArrayView<T> points, Vec2Array<T>& out) -> void {
+    const std::size_t size{points.size()};
+    out.resize(size);
+    const std::span<T> xs{out.xs()};
+    const std::span<T> ys{out.ys()};
+    std::size_t i{0};
+#if BOYLE_HAS_SIMD == 1
+    if (points.contiguous()) {
+        constexpr std::size_t kWidth{detail::kSimdWidth<T>};
+        for (; i + kWidth <= size; i += kWidth) {
+            const detail::Simd<T> x{detail::simdLoad(points.xs() + i)};
+            const detail::Simd<T> y{detail::simdLoad(points.ys() + i)};
+            const detail::Simd<T> inv_norm{T{1.0} / std::experimental::sqrt(x * x + y * y)};
+            detail::simdStore<T>(x * inv_norm, xs.data() + i);
+            detail::simdStore<T>(y * inv_norm, ys.data() + i);
+        }
+    }
+#endif
+    for (; i < size; ++i) {
+        const Vec2<T> point{points[i].normalized()};
+        xs[i] = point.x;
+        ys[i] = point.y;
+    }
+    return;
+}
+
+/**
+ * @brief Affine map p -> A p + b with A given row-major as {a00, a01, a10, a11}.
+ */
+template <std::floating_point T>
+[[using gnu: hot]]
+inline auto transform(
+    Vec2ArrayView<T> points, const std::array<T, 4>& linear, Vec2<T> translation, Vec2Array<T>& out
+) -> void {
+    const std::size_t size{points.size()};
+    out.resize(size);
+    const std::span<T> xs{out.xs()};
+    const std::span<T> ys{out.ys()};
+    std::size_t i{0};
+#if BOYLE_HAS_SIMD == 1
+    if (points.contiguous()) {
+        constexpr std::size_t kWidth{detail::kSimdWidth<T>};
+        for (; i + kWidth <= size; i += kWidth) {
+            const detail::Simd<T> x{detail::simdLoad(points.xs() + i)};
+            const detail::Simd<T> y{detail::simdLoad(points.ys() + i)};
+            detail::simdStore<T>(x * linear[0] + y * linear[1] + translation.x, xs.data() + i);
+            detail::simdStore<T>(x * linear[2] + y * linear[3] + translation.y, ys.data() + i);
+        }
+    }
+#endif
+    for (; i < size; ++i) {
+        const Vec2<T> point{points[i]};
+        xs[i] = point.x * linear[0] + point.y * linear[1] + translation.x;
+        ys[i] = point.x * linear[2] + point.y * linear[3] + translation.y;
+    }
+    return;
+}
+
+template <std::floating_point T>
+[[using gnu: always_inline]]
+inline auto rotate(Vec2ArrayView<T> points, T radian, Vec2Array<T>& out) -> void {
+    const T cos_radian{std::cos(radian)};
+    const T sin_radian{std::sin(radian)};
+    transform<T>(
+        points, std::array<T, 4>{cos_radian, -sin_radian, sin_radian, cos_radian}, Vec2<T>{0.0},
+        out
+    );
+    return;
+}
+
+/**
+ * @brief Index of the point closest to the given one; the first such index on ties. Squared
+ * distances are computed a SIMD chunk at a time against a single scalar best; a chunk is scanned
+ * lane by lane only when any of its lanes beats that best, so most chunks cost one comparison.
+ */
+template <std::floating_point T>
+[[using gnu: pure, hot]]
+inline auto nearestIndex(Vec2ArrayView<T> points, Vec2<T> point) noexcept(!BOYLE_CHECK_PARAMS)
+    -> std::size_t {
+    const std::size_t size{points.size()};
+#if BOYLE_CHECK_PARAMS == 1
+    if (size == 0) [[unlikely]] {
+        throw std::invalid_argument("Invalid arguments detected! points must not be empty.");
+    }
+#endif
+    std::size_t best_index{0};
+    T best_distance{std::numeric_limits<T>::infinity()};
+    std::size_t i{0};
+#if BOYLE_HAS_SIMD == 1
+    if (points.contiguous()) {
+        constexpr std::size_t kWidth{detail::kSimdWidth<T>};
+        for (; i + kWidth <= size; i += kWidth) {
+            const detail::Simd<T> dx{detail::simdLoad(points.xs() + i) - point.x};
+            const detail::Simd<T> dy{detail::simdLoad(points.ys() + i) - point.y};
+            const detail::Simd<T> distance{dx * dx + dy * dy};
+            if (std::experimental::any_of(distance < best_distance)) {
+                for (std::size_t j{0}; j < kWidth; ++j) {
+                    if (distance[j] < best_distance) {
+                        best_distance = distance[j];
+                        best_index = i + j;
+                    }
+                }
+            }
+        }
+    }
+#endif
+    for (; i < size; ++i) {
+        const T distance{points[i].euclideanSqrTo(point)};
+        if (distance < best_distance) {
+            best_distance = distance;
+            best_index = i;
+        }
+    }
+    return best_index;
+}
+
+} // namespace boyle::math
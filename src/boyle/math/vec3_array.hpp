@@ -0,0 +1,558 @@
+/**
+ * @file vec3_array.hpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2024-06-25
+ *
+ * @copyright Copyright (c) 2024 Boyle Development Team
+ *            All rights reserved.
+ *
+ */
+
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "boost/serialization/access.hpp"
+#include "boost/serialization/vector.hpp"
+#include "fmt/format.h"
+
+#include "boyle/math/simd.hpp"
+#include "boyle/math/vec3.hpp"
+
+namespace boyle::math {
+
+/**
+ * @brief Read-only view over spatial points stored as three coordinate streams, either contiguous
+ * (a Vec3Array) or interleaved with stride 3 (a std::span<const Vec3<T>>).
+ */
+template <std::floating_point T>
+class [[nodiscard]] Vec3ArrayView final {
+  public:
+    using value_type = Vec3<T>;
+
+    static_assert(
+        std::is_standard_layout_v<Vec3<T>> && sizeof(Vec3<T>) == 3 * sizeof(T),
+        "Vec3 must be three tightly packed coordinates to be viewed as interleaved streams."
+    );
+
+    Vec3ArrayView() noexcept = default;
+    Vec3ArrayView(const Vec3ArrayView& other) noexcept = default;
+    auto operator=(const Vec3ArrayView& other) noexcept -> Vec3ArrayView& = default;
+    Vec3ArrayView(Vec3ArrayView&& other) noexcept = default;
+    auto operator=(Vec3ArrayView&& other) noexcept -> Vec3ArrayView& = default;
+    ~Vec3ArrayView() noexcept = default;
+
+    [[using gnu: always_inline]]
+    Vec3ArrayView(std::span<const T> xs, std::span<const T> ys, std::span<const T> zs) noexcept(
+        !BOYLE_CHECK_PARAMS
+    )
+        : m_xs{xs.data()}, m_ys{ys.data()}, m_zs{zs.data()}, m_size{xs.size()}, m_stride{1} {
+#if BOYLE_CHECK_PARAMS == 1
+        if (xs.size() != ys.size() || xs.size() != zs.size()) [[unlikely]] {
+            throw std::invalid_argument(fmt::format(
+                "Invalid arguments detected! xs, ys and zs must share the same size: xs.size() = "
+                "{0:d}, ys.size() = {1:d}, zs.size() = {2:d}",
+                xs.size(), ys.size(), zs.size()
+            ));
+        }
+#endif
+    }
+
+    [[using gnu: always_inline]]
+    Vec3ArrayView(std::span<const value_type> points) noexcept
+        : m_xs{reinterpret_cast<const T*>(points.data())},
+          m_ys{points.empty() ? nullptr : reinterpret_cast<const T*>(points.data()) + 1},
+          m_zs{points.empty() ? nullptr : reinterpret_cast<const T*>(points.data()) + 2},
+          m_size{points.size()}, m_stride{3} {}
+
+    [[using gnu: always_inline]]
+    Vec3ArrayView(const std::vector<value_type>& points) noexcept
+        : Vec3ArrayView(std::span<const value_type>{points}) {}
+
+    [[using gnu: pure, always_inline]]
+    auto operator[](std::size_t pos) const noexcept -> value_type {
+        return value_type{m_xs[pos * m_stride], m_ys[pos * m_stride], m_zs[pos * m_stride]};
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto size() const noexcept -> std::size_t {
+        return m_size;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto empty() const noexcept -> bool {
+        return m_size == 0;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto stride() const noexcept -> std::size_t {
+        return m_stride;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto contiguous() const noexcept -> bool {
+        return m_stride == 1;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto interleaved() const noexcept -> bool {
+        return m_stride == 3 && m_ys == m_xs + 1 && m_zs == m_xs + 2;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto xs() const noexcept -> const T* {
+        return m_xs;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto ys() const noexcept -> const T* {
+        return m_ys;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto zs() const noexcept -> const T* {
+        return m_zs;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto subview(std::size_t offset, std::size_t count) const noexcept -> Vec3ArrayView {
+        Vec3ArrayView result{*this};
+        result.m_xs += offset * m_stride;
+        result.m_ys += offset * m_stride;
+        result.m_zs += offset * m_stride;
+        result.m_size = count;
+        return result;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto toSpan() const noexcept(!BOYLE_CHECK_PARAMS) -> std::span<const value_type> {
+#if BOYLE_CHECK_PARAMS == 1
+        if (!interleaved() && !empty()) [[unlikely]] {
+            throw std::invalid_argument(
+                "Invalid arguments detected! Only interleaved views can be converted to a span of "
+                "Vec3."
+            );
+        }
+#endif
+        return std::span<const value_type>{reinterpret_cast<const value_type*>(m_xs), m_size};
+    }
+
+  private:
+    const T* m_xs{nullptr};
+    const T* m_ys{nullptr};
+    const T* m_zs{nullptr};
+    std::size_t m_size{0};
+    std::size_t m_stride{1};
+};
+
+/**
+ * @brief Spatial points in SoA layout: all x coordinates, then all y, then all z.
+ */
+template <std::floating_point T>
+class [[nodiscard]] Vec3Array final {
+    friend class boost::serialization::access;
+
+  public:
+    using value_type = Vec3<T>;
+
+    Vec3Array() noexcept = default;
+    Vec3Array(const Vec3Array& other) = default;
+    auto operator=(const Vec3Array& other) -> Vec3Array& = default;
+    Vec3Array(Vec3Array&& other) noexcept = default;
+    auto operator=(Vec3Array&& other) noexcept -> Vec3Array& = default;
+    ~Vec3Array() noexcept = default;
+
+    [[using gnu: always_inline]]
+    explicit Vec3Array(std::size_t size, value_type value = value_type{0.0})
+        : m_xs(size, value.x), m_ys(size, value.y), m_zs(size, value.z) {}
+
+    [[using gnu: always_inline]]
+    explicit Vec3Array(std::vector<T> xs, std::vector<T> ys, std::vector<T> zs) noexcept(
+        !BOYLE_CHECK_PARAMS
+    )
+        : m_xs{std::move(xs)}, m_ys{std::move(ys)}, m_zs{std::move(zs)} {
+#if BOYLE_CHECK_PARAMS == 1
+        if (m_xs.size() != m_ys.size() || m_xs.size() != m_zs.size()) [[unlikely]] {
+            throw std::invalid_argument(fmt::format(
+                "Invalid arguments detected! xs, ys and zs must share the same size: xs.size() = "
+                "{0:d}, ys.size() = {1:d}, zs.size() = {2:d}",
+                m_xs.size(), m_ys.size(), m_zs.size()
+            ));
+        }
+#endif
+    }
+
+    [[using gnu: ]]
+    explicit Vec3Array(Vec3ArrayView<T> points)
+        : m_xs(points.size()), m_ys(points.size()), m_zs(points.size()) {
+        for (std::size_t i{0}; i < points.size(); ++i) {
+            set(i, points[i]);
+        }
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto operator[](std::size_t pos) const noexcept -> value_type {
+        return value_type{m_xs[pos], m_ys[pos], m_zs[pos]};
+    }
+
+    [[using gnu: always_inline]]
+    auto set(std::size_t pos, value_type point) noexcept -> void {
+        m_xs[pos] = point.x;
+        m_ys[pos] = point.y;
+        m_zs[pos] = point.z;
+        return;
+    }
+
+    [[using gnu: always_inline]]
+    auto push_back(value_type point) -> void {
+        m_xs.push_back(point.x);
+        m_ys.push_back(point.y);
+        m_zs.push_back(point.z);
+        return;
+    }
+
+    [[using gnu: always_inline]]
+    auto reserve(std::size_t capacity) -> void {
+        m_xs.reserve(capacity);
+        m_ys.reserve(capacity);
+        m_zs.reserve(capacity);
+        return;
+    }
+
+    [[using gnu: always_inline]]
+    auto resize(std::size_t size) -> void {
+        m_xs.resize(size);
+        m_ys.resize(size);
+        m_zs.resize(size);
+        return;
+    }
+
+    [[using gnu: always_inline]]
+    auto clear() noexcept -> void {
+        m_xs.clear();
+        m_ys.clear();
+        m_zs.clear();
+        return;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto size() const noexcept -> std::size_t {
+        return m_xs.size();
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto empty() const noexcept -> bool {
+        return m_xs.empty();
+    }
+
+    [[using gnu: always_inline]]
+    auto xs() noexcept -> std::span<T> {
+        return m_xs;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto xs() const noexcept -> std::span<const T> {
+        return m_xs;
+    }
+
+    [[using gnu: always_inline]]
+    auto ys() noexcept -> std::span<T> {
+        return m_ys;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto ys() const noexcept -> std::span<const T> {
+        return m_ys;
+    }
+
+    [[using gnu: always_inline]]
+    auto zs() noexcept -> std::span<T> {
+        return m_zs;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto zs() const noexcept -> std::span<const T> {
+        return m_zs;
+    }
+
+    [[using gnu: pure, always_inline]]
+    auto view() const noexcept -> Vec3ArrayView<T> {
+        return Vec3ArrayView<T>{
+            std::span<const T>{m_xs}, std::span<const T>{m_ys}, std::span<const T>{m_zs}
+        };
+    }
+
+    [[using gnu: pure, always_inline]]
+    operator Vec3ArrayView<T>() const noexcept {
+        return view();
+    }
+
+    [[using gnu: pure]]
+    auto toVector() const -> std::vector<value_type> {
+        std::vector<value_type> points;
+        points.reserve(size());
+        for (std::size_t i{0}; i < size(); ++i) {
+            points.emplace_back(m_xs[i], m_ys[i], m_zs[i]);
+        }
+        return points;
+    }
+
+  private:
+    [[using gnu: always_inline]]
+    auto serialize(auto& archive, [[maybe_unused]] const unsigned int version) noexcept -> void {
+        archive & m_xs;
+        archive & m_ys;
+        archive & m_zs;
+        return;
+    }
+
+    std::vector<T> m_xs{};
+    std::vector<T> m_ys{};
+    std::vector<T> m_zs{};
+};
+
+using Vec3fArray = Vec3Array<float>;
+using Vec3dArray = Vec3Array<double>;
+using Vec3fArrayView = Vec3ArrayView<float>;
+using Vec3dArrayView = Vec3ArrayView<double>;
+
+/**
+ * @brief Element-wise kernels, vectorized when every operand is contiguous. Outputs may alias the
+ * inputs.
+ */
+template <std::floating_point T>
+[[using gnu: hot]]
+inline auto dot(Vec3ArrayView<T> lhs, Vec3ArrayView<T> rhs, std::span<T> out) noexcept(
+    !BOYLE_CHECK_PARAMS
+) -> void {
+    const std::size_t size{lhs.size()};
+    detail::checkBatchSizes(size, rhs.size());
+    detail::checkBatchSizes(size, out.size());
+    std::size_t i{0};
+#if BOYLE_HAS_SIMD == 1
+    if (lhs.contiguous() && rhs.contiguous()) {
+        constexpr std::size_t kWidth{detail::kSimdWidth<T>};
+        for (; i + kWidth <= size; i += kWidth) {
+            detail::simdStore<T>(
+                detail::simdLoad(lhs.xs() + i) * detail::simdLoad(rhs.xs() + i) +
+                    detail::simdLoad(lhs.ys() + i) * detail::simdLoad(rhs.ys() + i) +
+                    detail::simdLoad(lhs.zs() + i) * detail::simdLoad(rhs.zs() + i),
+                out.data() + i
+            );
+        }
+    }
+#endif
+    for (; i < size; ++i) {
+        out[i] = lhs[i].dot(rhs[i]);
+    }
+    return;
+}
+
+template <std::floating_point T>
+[[using gnu: hot]]
+inline auto cross(Vec3ArrayView<T> lhs, Vec3ArrayView<T> rhs, Vec3Array<T>& out) noexcept(
+    !BOYLE_CHECK_PARAMS
+) -> void {
+    const std::size_t size{lhs.size()};
+    detail::checkBatchSizes(size, rhs.size());
+    out.resize(size);
+    const std::span<T> xs{out.xs()};
+    const std::span<T> ys{out.ys()};
+    const std::span<T> zs{out.zs()};
+    std::size_t i{0};
+#if BOYLE_HAS_SIMD == 1
+    if (lhs.contiguous() && rhs.contiguous()) {
+        constexpr std::size_t kWidth{detail::kSimdWidth<T>};
+        for (; i + kWidth <= size; i += kWidth) {
+            const detail::Simd<T> lx{detail::simdLoad(lhs.xs() + i)};
+            const detail::Simd<T> ly{detail::simdLoad(lhs.ys() + i)};
+            const detail::Simd<T> lz{detail::simdLoad(lhs.zs() + i)};
+            const detail::Simd<T> rx{detail::simdLoad(rhs.xs() + i)};
+            const detail::Simd<T> ry{detail::simdLoad(rhs.ys() + i)};
+            const detail::Simd<T> rz{detail::simdLoad(rhs.zs() + i)};
+            detail::simdStore<T>(ly * rz - lz * ry, xs.data() + i);
+            detail::simdStore<T>(lz * rx - lx * rz, ys.data() + i);
+            detail::simdStore<T>(lx * ry - ly * rx, zs.data() + i);
+        }
+    }
+#endif
+    for (; i < size; ++i) {
+        out.set(i, lhs[i].cross(rhs[i]));
+    }
+    return;
+}
+
+template <std::floating_point T>
+[[using gnu: hot]]
+inline auto euclidean(Vec3ArrayView<T> points, std::span<T> out) noexcept(!BOYLE_CHECK_PARAMS)
+    -> void {
+    const std::size_t size{points.size()};
+    detail::checkBatchSizes(size, out.size());
+    std::size_t i{0};
+#if BOYLE_HAS_SIMD == 1
+    if (points.contiguous()) {
+        constexpr std::size_t kWidth{detail::kSimdWidth<T>};
+        for (; i + kWidth <= size; i += kWidth) {
+            const detail::Simd<T> x{detail::simdLoad(points.xs() + i)};
+            const detail::Simd<T> y{detail::simdLoad(points.ys() + i)};
+            const detail::Simd<T> z{detail::simdLoad(points.zs() + i)};
+            detail::simdStore<T>(std::experimental::sqrt(x * x + y * y + z * z), out.data() + i);
+        }
+    }
+#endif
+    for (; i < size; ++i) {
+        out[i] = points[i].euclidean();
+    }
+    return;
+}
+
+template <std::floating_point T>
+[[using gnu: hot]]
+inline auto normalize(Vec3ArrayView<T> points, Vec3Array<T>& out) -> void {
+    const std::size_t size{points.size()};
+    out.resize(size);
+    const std::span<T> xs{out.xs()};
+    const std::span<T> ys{out.ys()};
+    const std::span<T> zs{out.zs()};
+    std::size_t i{0};
+#if BOYLE_HAS_SIMD == 1
+    if (points.contiguous()) {
+        constexpr std::size_t kWidth{detail::kSimdWidth<T>};
+        for (; i + kWidth <= size; i += kWidth) {
+            const detail::Simd<T> x{detail::simdLoad(points.xs() + i)};
+            const detail::Simd<T> y{detail::simdLoad(points.ys() + i)};
+            const detail::Simd<T> z{detail::simdLoad(points.zs() + i)};
+            const detail::Simd<T> inv_norm{T{1.0} / std::experimental::sqrt(x * x + y * y + z * z)};
+            detail::simdStore<T>(x * inv_norm, xs.data() + i);
+            detail::simdStore<T>(y * inv_norm, ys.data() + i);
+            detail::simdStore<T>(z * inv_norm, zs.data() + i);
+        }
+    }
+#endif
+    for (; i < size; ++i) {
+        out.set(i, points[i].normalized());
+    }
+    return;
+}
+
+/**
+ * @brief Affine map p -> A p + b with A given row-major.
+ */
+template <std::floating_point T>
+[[using gnu: hot]]
+inline auto transform(
+    Vec3ArrayView<T> points, const std::array<T, 9>& linear, Vec3<T> translation, Vec3Array<T>& out
+) -> void {
+    const std::size_t size{points.size()};
+    out.resize(size);
+    const std::span<T> xs{out.xs()};
+    const std::span<T> ys{out.ys()};
+    const std::span<T> zs{out.zs()};
+    std::size_t i{0};
+#if BOYLE_HAS_SIMD == 1
+    if (points.contiguous()) {
+        constexpr std::size_t kWidth{detail::kSimdWidth<T>};
+        for (; i + kWidth <= size; i += kWidth) {
+            const detail::Simd<T> x{detail::simdLoad(points.xs() + i)};
+            const detail::Simd<T> y{detail::simdLoad(points.ys() + i)};
+            const detail::Simd<T> z{detail::simdLoad(points.zs() + i)};
+            detail::simdStore<T>(
+                x * linear[0] + y * linear[1] + z * linear[2] + translation.x, xs.data() + i
+            );
+            detail::simdStore<T>(
+                x * linear[3] + y * linear[4] + z * linear[5] + translation.y, ys.data() + i
+            );
+            detail::simdStore<T>(
+                x * linear[6] + y * linear[7] + z * linear[8] + translation.z, zs.data() + i
+            );
+        }
+    }
+#endif
+    for (; i < size; ++i) {
+        const Vec3<T> point{points[i]};
+        xs[i] = point.x * linear[0] + point.y * linear[1] + point.z * linear[2] + translation.x;
+        ys[i] = point.x * linear[3] + point.y * linear[4] + point.z * linear[5] + translation.y;
+        zs[i] = point.x * linear[6] + point.y * linear[7] + point.z * linear[8] + translation.z;
+    }
+    return;
+}
+
+/**
+ * @brief Rotation by the given angle about an axis through the origin (Rodrigues' formula).
+ */
+template <std::floating_point T>
+[[using gnu: always_inline]]
+inline auto rotate(Vec3ArrayView<T> points, Vec3<T> axis, T radian, Vec3Array<T>& out) -> void {
+    const Vec3<T> k{axis.normalized()};
+    const T c{std::cos(radian)};
+    const T s{std::sin(radian)};
+    const T t{1.0 - c};
+    transform<T>(
+        points,
+        std::array<T, 9>{
+            t * k.x * k.x + c, t * k.x * k.y - s * k.z, t * k.x * k.z + s * k.y,
+            t * k.x * k.y + s * k.z, t * k.y * k.y + c, t * k.y * k.z - s * k.x,
+            t * k.x * k.z - s * k.y, t * k.y * k.z + s * k.x, t * k.z * k.z + c
+        },
+        Vec3<T>{0.0}, out
+    );
+    return;
+}
+
+/**
+ * @brief Index of the point closest to the given one; the first such index on ties.
+ */
+template <std::floating_point T>
+[[using gnu: pure, hot]]
+inline auto nearestIndex(Vec3ArrayView<T> points, Vec3<T> point) noexcept(!BOYLE_CHECK_PARAMS)
+    -> std::size_t {
+    const std::size_t size{points.size()};
+#if BOYLE_CHECK_PARAMS == 1
+    if (size == 0) [[unlikely]] {
+        throw std::invalid_argument("Invalid arguments detected! points must not be empty.");
+    }
+#endif
+    std::size_t best_index{0};
+    T best_distance{std::numeric_limits<T>::infinity()};
+    std::size_t i{0};
+#if BOYLE_HAS_SIMD == 1
+    if (points.contiguous()) {
+        constexpr std::size_t kWidth{detail::kSimdWidth<T>};
+        for (; i + kWidth <= size; i += kWidth) {
+            const detail::Simd<T> dx{detail::simdLoad(points.xs() + i) - point.x};
+            const detail::Simd<T> dy{detail::simdLoad(points.ys() + i) - point.y};
+            const detail::Simd<T> dz{detail::simdLoad(points.zs() + i) - point.z};
+            const detail::Simd<T> distance{dx * dx + dy * dy + dz * dz};
+            if (std::experimental::any_of(distance < best_distance)) {
+                for (std::size_t j{0}; j < kWidth; ++j) {
+                    if (distance[j] < best_distance) {
+                        best_distance = distance[j];
+                        best_index = i + j;
+                    }
+                }
+            }
+        }
+    }
+#endif
+    for (; i < size; ++i) {
+        const T distance{points[i].euclideanSqrTo(point)};
+        if (distance < best_distance) {
+            best_distance = distance;
+            best_index = i;
+        }
+    }
+    return best_index;
+}
+
+} // namespace boyle::math
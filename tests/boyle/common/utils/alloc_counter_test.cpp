@@ -0,0 +1,69 @@
+/**
+ * @file alloc_counter_test.cpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2025-02-05
+ *
+ * @copyright Copyright (c) 2025 Boyle Development Team.
+ *            All rights reserved.
+ *
+ */
+
+#include "boyle/common/utils/alloc_counter.hpp"
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+namespace boyle::common {
+
+TEST_CASE("Counting") {
+    AllocCounter counter{};
+    std::vector<double> values(128);
+    CHECK_EQ(counter.allocations(), 1);
+    CHECK_GE(counter.bytes(), 128 * sizeof(double));
+
+    values.resize(64);
+    CHECK_EQ(counter.allocations(), 1);
+    values.shrink_to_fit();
+    CHECK_EQ(counter.allocations(), 2);
+    CHECK_EQ(counter.deallocations(), 1);
+
+    counter.reset();
+    {
+        struct alignas(64) Aligned {
+            std::array<double, 8> data;
+        };
+        const auto ptr{std::make_unique<Aligned>()};
+        CHECK_EQ(reinterpret_cast<std::uintptr_t>(ptr.get()) % 64, 0);
+    }
+    CHECK_EQ(counter.allocations(), 1);
+    CHECK_EQ(counter.deallocations(), 1);
+}
+
+TEST_CASE("PerThread") {
+    AllocCounter counter{};
+    std::thread thread{[]() -> void {
+        const std::vector<int> values(1024);
+        CHECK_EQ(values.size(), 1024);
+    }};
+    const std::size_t spawn_allocations{counter.allocations()};
+    thread.join();
+    CHECK_EQ(counter.allocations(), spawn_allocations);
+}
+
+TEST_CASE("Macros") {
+    std::vector<double> values(256, 1.0);
+    CHECK_NO_ALLOC(std::accumulate(values.cbegin(), values.cend(), 0.0));
+    REQUIRE_NO_ALLOC(values.assign(128, 2.0));
+    CHECK_EQ(countAllocations([&values]() -> void { values.resize(1024); }), 1);
+}
+
+} // namespace boyle::common
@@ -0,0 +1,111 @@
+/**
+ * @file latency_histogram_test.cpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2025-01-20
+ *
+ * @copyright Copyright (c) 2025 Boyle Development Team.
+ *            All rights reserved.
+ *
+ */
+
+#include "boyle/common/utils/latency_histogram.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "boyle/common/utils/chrono_inspector.hpp"
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+namespace boyle::common {
+
+TEST_CASE("Buckets") {
+    for (std::uint64_t value : {0UL, 1UL, 63UL, 64UL, 65UL, 1000UL, 123456789UL}) {
+        const std::size_t index{LatencyHistogram::bucketIndex(value)};
+        CHECK_LE(LatencyHistogram::bucketLowerBound(index), value);
+        CHECK_GE(LatencyHistogram::bucketUpperBound(index), value);
+    }
+    for (std::size_t index{1}; index < LatencyHistogram::kNumBuckets; ++index) {
+        CHECK_EQ(
+            LatencyHistogram::bucketLowerBound(index),
+            LatencyHistogram::bucketUpperBound(index - 1) + 1
+        );
+    }
+    CHECK_EQ(
+        LatencyHistogram::bucketIndex(LatencyHistogram::kMaxValue), LatencyHistogram::kNumBuckets - 1
+    );
+}
+
+TEST_CASE("Percentiles") {
+    LatencyHistogram histogram{};
+    for (std::int64_t i{1}; i <= 10000; ++i) {
+        histogram.record(i * 1000);
+    }
+    LatencySnapshot snapshot{};
+    snapshot.merge(histogram);
+    CHECK_EQ(snapshot.count(), 10000);
+    CHECK_EQ(snapshot.min().count(), 1000);
+    CHECK_EQ(snapshot.max().count(), 10000000);
+    CHECK_EQ(snapshot.mean().count(), 5000500);
+    CHECK_EQ(snapshot.percentile(0.5).count(), doctest::Approx(5000000).epsilon(0.02));
+    CHECK_EQ(snapshot.percentile(0.99).count(), doctest::Approx(9900000).epsilon(0.02));
+    CHECK_EQ(snapshot.percentile(0.999).count(), doctest::Approx(9990000).epsilon(0.02));
+    CHECK_EQ(snapshot.percentile(1.0).count(), 10000000);
+}
+
+TEST_CASE("Registry") {
+    LatencyRegistry* const registry{LatencyRegistry::getInstance()};
+    constexpr int kNumThreads{4};
+    constexpr int kNumScopes{500};
+    std::vector<std::thread> threads;
+    for (int i{0}; i < kNumThreads; ++i) {
+        threads.emplace_back([]() -> void {
+            for (int j{0}; j < kNumScopes; ++j) {
+                BOYLE_CHRONO_HISTOGRAM("registry_test");
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    CHECK_EQ(registry->snapshot("registry_test").count(), kNumThreads * kNumScopes);
+
+    bool found{false};
+    for (const LatencyStats& stats : registry->report()) {
+        if (stats.name == "registry_test") {
+            found = true;
+            CHECK_EQ(stats.count, kNumThreads * kNumScopes);
+            CHECK_LE(stats.min, stats.p50);
+            CHECK_LE(stats.p50, stats.p99);
+            CHECK_LE(stats.p99, stats.max);
+        }
+    }
+    CHECK(found);
+    registry->logReport(getDefaultLogger());
+
+    registry->reset();
+    CHECK_EQ(registry->snapshot("registry_test").count(), 0);
+}
+
+TEST_CASE("ShardReuse") {
+    LatencyRegistry* const registry{LatencyRegistry::getInstance()};
+    CHECK_EQ(&registry->histogram("shard_test"), &registry->histogram("shard_test"));
+    const std::size_t num_shards{registry->numShards("shard_test")};
+    for (int i{0}; i < 16; ++i) {
+        std::thread thread{[registry]() -> void {
+            LatencyHistogram& histogram{registry->histogram("shard_test")};
+            CHECK_EQ(&histogram, &registry->histogram("shard_test"));
+            histogram.record(1000);
+        }};
+        thread.join();
+    }
+    CHECK_EQ(registry->numShards("shard_test"), num_shards + 1);
+    CHECK_EQ(registry->snapshot("shard_test").count(), 16);
+}
+
+} // namespace boyle::common
@@ -0,0 +1,91 @@
+/**
+ * @file logging_test.cpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2025-02-14
+ *
+ * @copyright Copyright (c) 2025 Boyle Development Team.
+ *            All rights reserved.
+ *
+ */
+
+#include "boyle/common/utils/logging.hpp"
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "spdlog/sinks/base_sink.h"
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+namespace boyle::common {
+
+class SlowSink final : public spdlog::sinks::base_sink<std::mutex> {
+  protected:
+    auto sink_it_([[maybe_unused]] const spdlog::details::log_msg& msg) -> void override {
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+        return;
+    }
+
+    auto flush_() -> void override { return; }
+};
+
+TEST_CASE("EveryN") {
+    LogEveryN gate{3};
+    int passed{0};
+    for (int i{0}; i < 10; ++i) {
+        passed += gate() ? 1 : 0;
+    }
+    CHECK_EQ(passed, 4);
+
+    const std::shared_ptr<Logger> silent{std::make_shared<Logger>("silent")};
+    int logged{0};
+    for (int i{0}; i < 10; ++i) {
+        BOYLE_LOG_LOGGER_WARN_EVERY_N(silent, 5, "{0:d}", ++logged);
+    }
+    CHECK_EQ(logged, 2);
+}
+
+TEST_CASE("Throttled") {
+    LogThrottle gate{std::chrono::milliseconds{50}};
+    CHECK(gate());
+    CHECK_FALSE(gate());
+    std::this_thread::sleep_for(std::chrono::milliseconds{60});
+    CHECK(gate());
+    CHECK_FALSE(gate());
+
+    const std::shared_ptr<Logger> silent{std::make_shared<Logger>("silent")};
+    int logged{0};
+    for (int i{0}; i < 10; ++i) {
+        BOYLE_LOG_LOGGER_WARN_THROTTLED(silent, std::chrono::seconds{10}, "{0:d}", ++logged);
+    }
+    CHECK_EQ(logged, 1);
+}
+
+TEST_CASE("SharedThreadPool") {
+    CHECK(configureLogging(LoggingConfig{
+        .queue_size = 16, .num_threads = 1, .overflow_policy = LogOverflowPolicy::OVERRUN_OLDEST
+    }));
+    CHECK_FALSE(configureLogging(LoggingConfig{}));
+    CHECK_EQ(loggingConfig().queue_size, 16);
+
+    const std::shared_ptr<Logger> first{makeLogger("first")};
+    const std::shared_ptr<Logger> second{makeLogger("second")};
+    CHECK_EQ(spdlog::thread_pool(), detail::loggingState().thread_pool);
+
+    first->sinks().clear();
+    first->sinks().push_back(std::make_shared<SlowSink>());
+    const auto start{std::chrono::steady_clock::now()};
+    for (int i{0}; i < 1024; ++i) {
+        BOYLE_LOG_LOGGER_WARN(first, "storm message {0:d}", i);
+    }
+    const auto elapsed{std::chrono::steady_clock::now() - start};
+    CHECK_LT(elapsed, std::chrono::milliseconds{500});
+    CHECK_GT(droppedLogMessages(), 0);
+}
+
+} // namespace boyle::common
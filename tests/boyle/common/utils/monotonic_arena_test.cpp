@@ -0,0 +1,69 @@
+/**
+ * @file monotonic_arena_test.cpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2025-02-10
+ *
+ * @copyright Copyright (c) 2025 Boyle Development Team.
+ *            All rights reserved.
+ *
+ */
+
+#include "boyle/common/utils/monotonic_arena.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+#include "boyle/common/utils/alloc_counter.hpp"
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+namespace boyle::common {
+
+TEST_CASE("Allocation") {
+    MonotonicArena arena{std::size_t{1} << 12};
+    CHECK_EQ(arena.capacity(), std::size_t{1} << 12);
+
+    CHECK_NO_ALLOC({
+        std::pmr::vector<double> values{arena.allocator<double>()};
+        values.reserve(128);
+        for (std::size_t i{0}; i < 128; ++i) {
+            values.push_back(static_cast<double>(i));
+        }
+        CHECK_EQ(values.back(), 127.0);
+    });
+    CHECK_EQ(arena.overflow(), 0);
+
+    void* const ptr{arena.resource()->allocate(24, 32)};
+    CHECK_EQ(reinterpret_cast<std::uintptr_t>(ptr) % 32, 0);
+}
+
+TEST_CASE("Reset") {
+    MonotonicArena arena{std::size_t{1} << 12};
+    void* const first{arena.resource()->allocate(64, alignof(std::max_align_t))};
+    arena.reset();
+    void* const second{arena.resource()->allocate(64, alignof(std::max_align_t))};
+    CHECK_EQ(first, second);
+}
+
+TEST_CASE("Overflow") {
+    MonotonicArena arena{std::size_t{1} << 10};
+    {
+        std::pmr::vector<double> values(1024, 0.0, arena.resource());
+        CHECK_EQ(values.size(), 1024);
+    }
+    CHECK_GE(arena.overflow(), 1024 * sizeof(double));
+
+    arena.reset();
+    CHECK_EQ(arena.overflow(), 0);
+    CHECK_NO_ALLOC({
+        const std::pmr::vector<double> values(64, 1.0, arena.resource());
+        CHECK_EQ(values.size(), 64);
+    });
+}
+
+} // namespace boyle::common
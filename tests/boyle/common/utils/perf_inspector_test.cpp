@@ -0,0 +1,57 @@
+/**
+ * @file perf_inspector_test.cpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2025-01-27
+ *
+ * @copyright Copyright (c) 2025 Boyle Development Team.
+ *            All rights reserved.
+ *
+ */
+
+#include "boyle/common/utils/perf_inspector.hpp"
+
+#include <cmath>
+#include <vector>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+namespace boyle::common {
+
+TEST_CASE("Counters") {
+    const PerfCounters& counters{PerfCounters::forThisThread()};
+    CHECK_EQ(&counters, &PerfCounters::forThisThread());
+
+    const PerfCounterValues start{counters.read()};
+    std::vector<double> values(1 << 16);
+    double sum{0.0};
+    for (std::size_t i{0}; i < values.size(); ++i) {
+        values[i] = std::sqrt(static_cast<double>(i));
+        sum += values[i];
+    }
+    CHECK_GT(sum, 0.0);
+    const PerfCounterValues delta{counters.read() - start};
+
+    if (!counters.available()) {
+        for (std::size_t i{0}; i < kNumPerfEvents; ++i) {
+            CHECK_FALSE(delta.valid[i]);
+            CHECK_EQ(delta.values[i], 0);
+        }
+    } else if (delta.available(PerfEvent::INSTRUCTIONS)) {
+        CHECK_GT(delta[PerfEvent::INSTRUCTIONS], values.size());
+    }
+}
+
+TEST_CASE("Inspector") {
+    const PerfInspector<> inspector{"perf_inspector_test"};
+    const PerfCounterValues delta{inspector.counters()};
+    CHECK_EQ(
+        delta.available(PerfEvent::CYCLES),
+        PerfCounters::forThisThread().read().available(PerfEvent::CYCLES)
+    );
+    CHECK_GE(inspector.elapsed().count(), 0);
+}
+
+} // namespace boyle::common
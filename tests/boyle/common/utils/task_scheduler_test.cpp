@@ -0,0 +1,113 @@
+/**
+ * @file task_scheduler_test.cpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2025-02-18
+ *
+ * @copyright Copyright (c) 2025 Boyle Development Team.
+ *            All rights reserved.
+ *
+ */
+
+#include "boyle/common/utils/task_scheduler.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <stop_token>
+#include <vector>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+namespace boyle::common {
+
+TEST_CASE("ParallelFor") {
+    TaskScheduler scheduler{SchedulerConfig{.num_threads = 3}};
+    CHECK_EQ(scheduler.num_workers(), 3);
+
+    std::vector<int> values(10007, 0);
+    scheduler.parallelFor(std::int64_t{0}, std::int64_t{10007}, [&](std::int64_t i) -> void {
+        values[i] += static_cast<int>(i);
+    });
+    for (std::size_t i{0}; i < values.size(); ++i) {
+        CHECK_EQ(values[i], static_cast<int>(i));
+    }
+
+    std::atomic<int> count{0};
+    scheduler.parallelFor(
+        -50, 50, [&](int) -> void { count.fetch_add(1, std::memory_order_relaxed); },
+        TaskPriority::BACKGROUND, {}, 7
+    );
+    CHECK_EQ(count.load(), 100);
+}
+
+TEST_CASE("ParallelReduce") {
+    TaskScheduler scheduler{SchedulerConfig{.num_threads = 2}};
+    const std::int64_t sum{scheduler.parallelReduce(
+        std::int64_t{1}, std::int64_t{100001}, std::int64_t{0},
+        [](std::int64_t i) -> std::int64_t { return i; },
+        [](std::int64_t lhs, std::int64_t rhs) -> std::int64_t { return lhs + rhs; }
+    )};
+    CHECK_EQ(sum, std::int64_t{5000050000});
+
+    const double empty{scheduler.parallelReduce(
+        0, 0, 1.5, [](int) -> double { return 0.0; },
+        [](double lhs, double rhs) -> double { return lhs + rhs; }
+    )};
+    CHECK_EQ(empty, 1.5);
+}
+
+TEST_CASE("NestedForkJoin") {
+    TaskScheduler scheduler{SchedulerConfig{.num_threads = 2}};
+    std::atomic<int> count{0};
+    scheduler.parallelFor(
+        0, 16,
+        [&](int) -> void {
+            scheduler.parallelFor(
+                0, 16, [&](int) -> void { count.fetch_add(1, std::memory_order_relaxed); },
+                TaskPriority::REAL_TIME, {}, 1
+            );
+        },
+        TaskPriority::REAL_TIME, {}, 1
+    );
+    CHECK_EQ(count.load(), 256);
+}
+
+TEST_CASE("Cancellation") {
+    TaskScheduler scheduler{SchedulerConfig{.num_threads = 2}};
+
+    std::stop_source stop_source{};
+    stop_source.request_stop();
+    std::atomic<int> count{0};
+    scheduler.parallelFor(
+        0, 1000, [&](int) -> void { count.fetch_add(1, std::memory_order_relaxed); },
+        TaskPriority::REAL_TIME, stop_source.get_token(), 10
+    );
+    CHECK_EQ(count.load(), 0);
+
+    TaskGroup group{scheduler};
+    group.run([]() -> void { throw std::runtime_error{"task failure"}; });
+    CHECK_THROWS_AS(group.wait(), std::runtime_error);
+    CHECK(group.cancelled());
+    group.run([&]() -> void { count.fetch_add(1, std::memory_order_relaxed); });
+    group.wait();
+    CHECK_EQ(count.load(), 0);
+}
+
+TEST_CASE("GlobalInstance") {
+    CHECK(TaskScheduler::configure(SchedulerConfig{.num_threads = 2, .cpu_affinity = {0}}));
+    TaskScheduler* const scheduler{TaskScheduler::getInstance()};
+    CHECK_EQ(scheduler->num_workers(), 2);
+    CHECK_FALSE(TaskScheduler::configure(SchedulerConfig{}));
+
+    std::vector<std::int64_t> values(100);
+    scheduler->parallelFor(std::size_t{0}, values.size(), [&](std::size_t i) -> void {
+        values[i] = static_cast<std::int64_t>(i);
+    });
+    CHECK_EQ(std::accumulate(values.cbegin(), values.cend(), std::int64_t{0}), 4950);
+}
+
+} // namespace boyle::common
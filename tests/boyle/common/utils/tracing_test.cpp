@@ -0,0 +1,113 @@
+/**
+ * @file tracing_test.cpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2025-01-14
+ *
+ * @copyright Copyright (c) 2025 Boyle Development Team.
+ *            All rights reserved.
+ *
+ */
+
+#include "boyle/common/utils/tracing.hpp"
+
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+namespace boyle::common {
+
+TEST_CASE("RuntimeSwitch") {
+    Tracer* const tracer{Tracer::getInstance()};
+    tracer->clear();
+    tracer->disable();
+    {
+        BOYLE_TRACE_SCOPE("disabled");
+    }
+    tracer->enable();
+    {
+        BOYLE_TRACE_SCOPE("enabled");
+    }
+    tracer->collect();
+    const std::vector<TraceEvent> events{tracer->events()};
+    REQUIRE_EQ(events.size(), 1);
+    CHECK_EQ(std::string_view{events.front().name}, "enabled");
+    CHECK_LE(events.front().start, events.front().end);
+    tracer->disable();
+}
+
+TEST_CASE("Collector") {
+    Tracer* const tracer{Tracer::getInstance()};
+    tracer->clear();
+    tracer->enable();
+    tracer->startCollector(std::chrono::milliseconds{1});
+    constexpr int kNumThreads{4};
+    constexpr int kNumScopes{1000};
+    std::vector<std::thread> threads;
+    for (int i{0}; i < kNumThreads; ++i) {
+        threads.emplace_back([]() -> void {
+            for (int j{0}; j < kNumScopes; ++j) {
+                BOYLE_TRACE_SCOPE("outer");
+                BOYLE_TRACE_SCOPE("inner");
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    tracer->stopCollector();
+    tracer->disable();
+    CHECK_EQ(tracer->events().size() + tracer->dropped(), kNumThreads * kNumScopes * 2);
+
+    std::ostringstream oss;
+    tracer->exportChromeTrace(oss);
+    const std::string json{oss.str()};
+    CHECK(json.starts_with(R"({"displayTimeUnit":"ns","traceEvents":[)"));
+    CHECK(json.ends_with("\n]}\n"));
+    CHECK_NE(json.find(R"("name":"inner","cat":"boyle","ph":"X")"), std::string::npos);
+}
+
+TEST_CASE("Capacity") {
+    Tracer* const tracer{Tracer::getInstance()};
+    tracer->clear();
+    tracer->enable();
+    const std::size_t evicted{tracer->evicted()};
+    tracer->setCapacity(100);
+    for (int i{0}; i < 250; ++i) {
+        BOYLE_TRACE_SCOPE("bounded");
+    }
+    tracer->collect();
+    tracer->disable();
+    CHECK_EQ(tracer->events().size(), 100);
+    CHECK_EQ(tracer->evicted() - evicted, 150);
+    tracer->setCapacity(Tracer::kDefaultCapacity);
+    tracer->clear();
+}
+
+TEST_CASE("BufferReuse") {
+    Tracer* const tracer{Tracer::getInstance()};
+    tracer->clear();
+    tracer->enable();
+    {
+        std::thread thread{[]() -> void { BOYLE_TRACE_SCOPE("warmup"); }};
+        thread.join();
+    }
+    const std::size_t num_buffers{tracer->numBuffers()};
+    for (int i{0}; i < 16; ++i) {
+        std::thread thread{[]() -> void { BOYLE_TRACE_SCOPE("short-lived"); }};
+        thread.join();
+    }
+    tracer->collect();
+    tracer->disable();
+    CHECK_EQ(tracer->numBuffers(), num_buffers);
+    CHECK_EQ(tracer->events().size(), 17);
+    tracer->clear();
+}
+
+} // namespace boyle::common
@@ -12,6 +12,9 @@
 
 #include "boyle/cvxopm/problems/qp_problem.hpp"
 
+#include <array>
+#include <cstddef>
+#include <memory_resource>
 #include <sstream>
 #include <vector>
 
@@ -112,4 +115,29 @@ TEST_CASE_FIXTURE(QpProblemTestFixture, "Serialization") {
     );
 }
 
+TEST_CASE("MemoryResource") {
+    std::array<std::byte, std::size_t{1} << 16> buffer;
+    std::pmr::monotonic_buffer_resource arena{
+        buffer.data(), buffer.size(), std::pmr::null_memory_resource()
+    };
+    QpProblem<double, int> qp_problem(2, 3, &arena);
+    qp_problem.addQuadCostTerm(0, 0, 2.0);
+    qp_problem.addQuadCostTerm(1, 1, 1.0);
+    qp_problem.addQuadCostTerm(0, 1, 1.0);
+    qp_problem.addLinCostTerm(0, 1.0);
+    qp_problem.addLinCostTerm(1, 1.0);
+    qp_problem.updateConstrainTerm(0, {{0, 1.0}, {1, 1.0}}, 1.0, 1.0);
+    qp_problem.updateConstrainTerm(1, {{0, 1.0}}, 0.0, 0.7);
+    qp_problem.updateConstrainTerm(2, {{1, 1.0}}, 0.0, 0.7);
+    CHECK_EQ(qp_problem.resource(), &arena);
+
+    const std::vector<double> state_vec{0.462, 0.538};
+    const double exact_cost = state_vec[0] * state_vec[0] * 2.0 + state_vec[1] * state_vec[1] +
+                              state_vec[0] * state_vec[1] + state_vec[0] + state_vec[1];
+    CHECK(qp_problem.validate(state_vec));
+    CHECK_EQ(
+        qp_problem.cost(state_vec), doctest::Approx(exact_cost).epsilon(::boyle::math::kEpsilon)
+    );
+}
+
 } // namespace boyle::cvxopm
@@ -0,0 +1,154 @@
+/**
+ * @file qp_capture_test.cpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2025-03-02
+ *
+ * @copyright Copyright (c) 2025 Boyle Development Team.
+ *            All rights reserved.
+ *
+ */
+
+#include "boyle/cvxopm/qp_capture.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <stdexcept>
+#include <vector>
+
+#include "boyle/cvxopm/problems/qp_problem.hpp"
+#include "boyle/cvxopm/settings.hpp"
+#include "boyle/cvxopm/solvers/osqp_solver.hpp"
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+namespace boyle::cvxopm {
+
+namespace {
+
+auto makeCapture() -> QpCapture<double, int> {
+    QpCapture<double, int> capture{
+        .qp_problem{2, 3}, .settings{.scaling = 0, .polishing = true, .rho = 0.25}
+    };
+    QpProblem<double, int>& qp_problem{capture.qp_problem};
+    qp_problem.updateQuadCostTerm(0, 0, 2.0);
+    qp_problem.updateQuadCostTerm(1, 1, 1.0);
+    qp_problem.updateQuadCostTerm(0, 1, 1.0 / 3.0);
+    qp_problem.updateLinCostTerm(0, 1.0);
+    qp_problem.updateLinCostTerm(1, 1.0);
+    qp_problem.updateConstrainTerm(0, {{0, 1.0}, {1, 1.0}}, 1.0, 1.0);
+    qp_problem.updateConstrainTerm(1, {{0, 1.0}}, 0.0, 0.7);
+    qp_problem.updateConstrainTerm(2, {{1, 1.0}}, 0.0, std::numeric_limits<double>::max());
+    capture.prim_vars_0 = {0.3, 0.7};
+    return capture;
+}
+
+auto checkEqual(const QpCapture<double, int>& lhs, const QpCapture<double, int>& rhs) -> void {
+    const QpProblem<double, int>& lp{lhs.qp_problem};
+    const QpProblem<double, int>& rp{rhs.qp_problem};
+    REQUIRE_EQ(lp.num_variables(), rp.num_variables());
+    REQUIRE_EQ(lp.num_constraints(), rp.num_constraints());
+    CHECK_EQ(lp.objectiveMatrix().nnzs(), rp.objectiveMatrix().nnzs());
+    for (const auto& [index_pair, value] : lp.objectiveMatrix().dictionary()) {
+        CHECK_EQ(rp.objectiveMatrix().coeff(index_pair.row, index_pair.col), value);
+    }
+    CHECK_EQ(lp.constrainMatrix().nnzs(), rp.constrainMatrix().nnzs());
+    for (int row{0}; row < static_cast<int>(lp.num_constraints()); ++row) {
+        for (int col{0}; col < static_cast<int>(lp.num_variables()); ++col) {
+            CHECK_EQ(lp.constrainMatrix().coeff(row, col), rp.constrainMatrix().coeff(row, col));
+        }
+    }
+    CHECK_EQ(lp.objectiveVector(), rp.objectiveVector());
+    CHECK_EQ(lp.lowerBounds(), rp.lowerBounds());
+    CHECK_EQ(lp.upperBounds(), rp.upperBounds());
+    CHECK_EQ(lhs.settings.rho, rhs.settings.rho);
+    CHECK_EQ(lhs.settings.scaling, rhs.settings.scaling);
+    CHECK_EQ(lhs.settings.polishing, rhs.settings.polishing);
+    CHECK_EQ(lhs.prim_vars_0, rhs.prim_vars_0);
+    CHECK_EQ(lhs.dual_vars_0, rhs.dual_vars_0);
+}
+
+} // namespace
+
+TEST_CASE("RoundTrip") {
+    const std::filesystem::path directory{
+        std::filesystem::temp_directory_path() / "boyle_qp_capture_test"
+    };
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    const QpCapture<double, int> capture{makeCapture()};
+
+    saveQpCapture(capture, directory / "a.qp");
+    checkEqual(loadQpCapture(directory / "a.qp"), capture);
+
+    saveQpCaptureBundle(capture, directory / "b");
+    checkEqual(loadQpCaptureBundle(directory / "b"), capture);
+
+    const auto captures{loadQpCaptures(directory)};
+    REQUIRE_EQ(captures.size(), 2);
+    CHECK_EQ(captures[0].first.filename(), "a.qp");
+    CHECK_EQ(captures[1].first.filename(), "b");
+    std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("MalformedBundle") {
+    const std::filesystem::path directory{
+        std::filesystem::temp_directory_path() / "boyle_qp_capture_malformed_test"
+    };
+    std::filesystem::remove_all(directory);
+    saveQpCaptureBundle(makeCapture(), directory);
+    const auto overwrite = [&directory](const char* name, const char* content) -> void {
+        std::ofstream ofs{directory / name, std::ios::trunc};
+        ofs << content;
+    };
+
+    overwrite("A.mtx", "%%MatrixMarket matrix coordinate real general\n3 2 1\n4 1 1.0\n");
+    CHECK_THROWS_AS(loadQpCaptureBundle(directory), std::runtime_error);
+    overwrite("A.mtx", "%%MatrixMarket matrix coordinate real general\n3 2 1\n1 3 1.0\n");
+    CHECK_THROWS_AS(loadQpCaptureBundle(directory), std::runtime_error);
+    overwrite("A.mtx", "%%MatrixMarket matrix coordinate real general\n3 2 1\n0 1 1.0\n");
+    CHECK_THROWS_AS(loadQpCaptureBundle(directory), std::runtime_error);
+    overwrite("A.mtx", "%%MatrixMarket matrix coordinate real general\n3 2 1\n3 2 1.0\n");
+    CHECK_NOTHROW(loadQpCaptureBundle(directory));
+
+    overwrite("P.mtx", "%%MatrixMarket matrix coordinate real symmetric\n2 2 1\n3 -1 1.0\n");
+    CHECK_THROWS_AS(loadQpCaptureBundle(directory), std::runtime_error);
+    overwrite("P.mtx", "%%MatrixMarket matrix coordinate real symmetric\n2 2 1\n2 1 1.0\n");
+    CHECK_NOTHROW(loadQpCaptureBundle(directory));
+
+    overwrite("x0.mtx", "%%MatrixMarket matrix array real general\n3 1\n0.0\n0.0\n0.0\n");
+    CHECK_THROWS_AS(loadQpCaptureBundle(directory), std::runtime_error);
+    std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("CaptureFromSolver") {
+    const std::filesystem::path directory{
+        std::filesystem::temp_directory_path() / "boyle_qp_capture_solver_test"
+    };
+    std::filesystem::remove_all(directory);
+    const QpCapture<double, int> capture{makeCapture()};
+    const OsqpSolver<double, int> solver{capture.settings};
+
+    enableQpCapture(QpCaptureOptions{.directory = directory, .max_captures = 1});
+    const auto [result, info] = solver.solve(capture.qp_problem, capture.prim_vars_0);
+    [[maybe_unused]] const auto second = solver.solve(capture.qp_problem);
+    disableQpCapture();
+    [[maybe_unused]] const auto third = solver.solve(capture.qp_problem);
+
+    const auto captures{loadQpCaptures(directory)};
+    REQUIRE_EQ(captures.size(), 1);
+    checkEqual(captures.front().second, capture);
+
+    const OsqpSolver<double, int> replay_solver{captures.front().second.settings};
+    const auto [replay_result, replay_info] = replay_solver.solve(
+        captures.front().second.qp_problem, captures.front().second.prim_vars_0
+    );
+    CHECK_EQ(replay_info.iter, info.iter);
+    CHECK_EQ(replay_result.prim_vars, result.prim_vars);
+    std::filesystem::remove_all(directory);
+}
+
+} // namespace boyle::cvxopm
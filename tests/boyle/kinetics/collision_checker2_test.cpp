@@ -0,0 +1,195 @@
+/**
+ * @file collision_checker2_test.cpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2024-06-14
+ *
+ * @copyright Copyright (c) 2024 Boyle Development Team
+ *            All rights reserved.
+ *
+ */
+
+#include "boyle/kinetics/collision_checker2.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "boyle/math/utils.hpp"
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+namespace boyle::kinetics {
+
+[[nodiscard]]
+static auto makeBoxObstacle(
+    std::uint64_t id, ::boyle::math::Vec2d center, double half_length, double half_width
+) noexcept -> StaticObstacle2d {
+    const std::array<::boyle::math::Vec2d, 4> vertices{
+        ::boyle::math::orientedBoxVertices(center, 0.0, half_length, half_width)
+    };
+    return StaticObstacle2d{.id = id, .vertices = {vertices.cbegin(), vertices.cend()}};
+}
+
+[[nodiscard]]
+static auto makeStraightPath() noexcept -> Path2d {
+    std::vector<::boyle::math::Vec2d> anchor_points;
+    for (double x : ::boyle::math::linspace(0.0, 50.0, 26)) {
+        anchor_points.emplace_back(x, 0.0);
+    }
+    return Path2d{std::move(anchor_points)};
+}
+
+constexpr VehicleFootprint2d kFootprint{
+    .front_length = 3.8, .rear_length = 1.0, .half_width = 1.0, .num_discs = 3
+};
+
+TEST_CASE("StaticObstacles") {
+    const Path2d path{makeStraightPath()};
+
+    SUBCASE("Free") {
+        const CollisionChecker2d checker{
+            kFootprint, {makeBoxObstacle(1, {25.0, 4.0}, 1.0, 1.0)}, {}, FootprintShape::BOX, 5.0
+        };
+        const CollisionResult2d result{checker.check(path, 0.5)};
+        CHECK_FALSE(result.collided);
+        CHECK_EQ(result.ss.size(), result.clearances.size());
+        double min_clearance{std::numeric_limits<double>::max()};
+        for (double clearance : result.clearances) {
+            min_clearance = std::min(min_clearance, clearance);
+            CHECK_LE(clearance, 5.0);
+        }
+        CHECK_EQ(min_clearance, doctest::Approx(2.0).epsilon(1E-6));
+        CHECK_FALSE(checker.check(path, 0.5, true).collided);
+    }
+
+    SUBCASE("Blocked") {
+        std::vector<StaticObstacle2d> obstacles;
+        for (int i{0}; i < 100; ++i) {
+            obstacles.push_back(makeBoxObstacle(i + 100, {i * 3.0, 30.0}, 1.0, 1.0));
+        }
+        obstacles.push_back(makeBoxObstacle(7, {30.0, 0.5}, 0.5, 0.5));
+        const CollisionChecker2d checker{kFootprint, std::move(obstacles)};
+        const CollisionResult2d result{checker.check(path, 0.1)};
+        CHECK(result.collided);
+        CHECK_EQ(result.obstacle_id, 7);
+        CHECK_EQ(result.s, doctest::Approx(30.0 - 0.5 - 3.8).epsilon(2E-3));
+        for (std::size_t i{0}; i < result.ss.size(); ++i) {
+            if (result.ss[i] > 26.0 && result.ss[i] < 30.5) {
+                CHECK_LT(result.clearances[i], 0.0);
+            }
+        }
+
+        const CollisionResult2d early_result{checker.check(path, 0.1, true)};
+        CHECK(early_result.collided);
+        CHECK_EQ(early_result.s, result.s);
+        CHECK_LT(early_result.ss.size(), result.ss.size());
+    }
+
+    SUBCASE("Discs") {
+        const CollisionChecker2d checker{
+            kFootprint, {makeBoxObstacle(1, {25.0, 4.0}, 1.0, 1.0)}, {}, FootprintShape::DISCS, 5.0
+        };
+        const CollisionResult2d result{checker.check(path, 0.5)};
+        CHECK_FALSE(result.collided);
+        double min_clearance{std::numeric_limits<double>::max()};
+        for (double clearance : result.clearances) {
+            min_clearance = std::min(min_clearance, clearance);
+        }
+        CHECK_LT(min_clearance, 2.0);
+        CHECK_GT(min_clearance, 1.0);
+    }
+
+    SUBCASE("DiscsOverhang") {
+        // The box footprint clears the obstacle by 0.2 while the discs bulge into it.
+        const CollisionChecker2d checker{
+            kFootprint, {makeBoxObstacle(1, {25.0, 2.2}, 1.0, 1.0)}, {}, FootprintShape::DISCS, 5.0
+        };
+        const CollisionResult2d result{checker.check(path, 0.1)};
+        CHECK(result.collided);
+        CHECK_EQ(result.obstacle_id, 1);
+        const CollisionResult2d early_result{checker.check(path, 0.1, true)};
+        CHECK(early_result.collided);
+        CHECK_EQ(early_result.s, result.s);
+        CHECK_EQ(early_result.obstacle_id, 1);
+
+        const CollisionChecker2d box_checker{
+            kFootprint, {makeBoxObstacle(1, {25.0, 2.2}, 1.0, 1.0)}, {}, FootprintShape::BOX, 5.0
+        };
+        const CollisionResult2d box_result{box_checker.check(path, 0.1, true)};
+        CHECK_FALSE(box_result.collided);
+        CHECK_EQ(box_result.obstacle_id, std::numeric_limits<std::uint64_t>::max());
+    }
+
+#if BOYLE_CHECK_PARAMS == 1
+    SUBCASE("InvalidSpacing") {
+        const CollisionChecker2d checker{kFootprint, {makeBoxObstacle(1, {25.0, 4.0}, 1.0, 1.0)}};
+        CHECK_THROWS_AS(checker.check(path, 0.0), std::invalid_argument);
+        CHECK_THROWS_AS(checker.check(path, -0.5), std::invalid_argument);
+    }
+#endif
+}
+
+TEST_CASE("DynamicObstacles") {
+    std::vector<double> ts{::boyle::math::linspace(0.0, 10.0, 21)};
+    std::vector<double> ss;
+    for (double t : ts) {
+        ss.push_back(4.0 * t);
+    }
+    const Trajectory2d trajectory{makeStraightPath(), Motion1d{ts, ss}};
+
+    SUBCASE("Crossing") {
+        DynamicObstacle2d obstacle{.id = 42, .half_length = 2.0, .half_width = 1.0};
+        for (double t : ts) {
+            obstacle.ts.push_back(t);
+            obstacle.centers.emplace_back(24.0, 20.0 - 4.0 * t);
+            obstacle.headings.push_back(-std::numbers::pi / 2.0);
+        }
+        const CollisionChecker2d checker{kFootprint, {}, {obstacle}};
+        const CollisionResult2d result{checker.check(trajectory, 0.05)};
+        CHECK(result.collided);
+        CHECK_EQ(result.obstacle_id, 42);
+        CHECK_GT(result.t, 4.0);
+        CHECK_LT(result.t, 5.5);
+    }
+
+    SUBCASE("Following") {
+        DynamicObstacle2d obstacle{.id = 42, .half_length = 2.0, .half_width = 1.0};
+        for (double t : ts) {
+            obstacle.ts.push_back(t);
+            obstacle.centers.emplace_back(15.0 + 4.0 * t, 0.0);
+            obstacle.headings.push_back(0.0);
+        }
+        const CollisionChecker2d checker{kFootprint, {}, {obstacle}};
+        const CollisionResult2d result{checker.check(trajectory, 0.05)};
+        CHECK_FALSE(result.collided);
+        for (double clearance : result.clearances) {
+            CHECK_EQ(clearance, doctest::Approx(5.0).epsilon(1E-6));
+        }
+    }
+
+    SUBCASE("Batch") {
+        DynamicObstacle2d obstacle{.id = 42, .half_length = 2.0, .half_width = 1.0};
+        obstacle.ts.push_back(0.0);
+        obstacle.centers.emplace_back(20.0, 0.0);
+        obstacle.headings.push_back(0.0);
+        const CollisionChecker2d checker{kFootprint, {}, {obstacle}};
+        const std::vector<Trajectory2d> candidates(16, trajectory);
+        const std::vector<CollisionResult2d> results{checker.check(candidates, 0.1)};
+        CHECK_EQ(results.size(), 16);
+        for (const CollisionResult2d& result : results) {
+            CHECK(result.collided);
+            CHECK_EQ(result.t, doctest::Approx(results.front().t));
+        }
+#if BOYLE_CHECK_PARAMS == 1
+        CHECK_THROWS_AS(checker.check(trajectory, 0.0), std::invalid_argument);
+#endif
+    }
+}
+
+} // namespace boyle::kinetics
@@ -0,0 +1,116 @@
+/**
+ * @file bicycle_mpc_model_test.cpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2024-06-19
+ *
+ * @copyright Copyright (c) 2024 Boyle Development Team
+ *            All rights reserved.
+ *
+ */
+
+#include "boyle/kinetics/models/bicycle_mpc_model.hpp"
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+#include "boyle/math/utils.hpp"
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+namespace boyle::kinetics {
+
+constexpr double kWheelbase{2.8};
+constexpr double kDt{0.1};
+
+[[nodiscard]]
+static auto makeReference() noexcept -> Trajectory2d {
+    std::vector<::boyle::math::Vec2d> anchor_points;
+    for (double x : ::boyle::math::linspace(0.0, 200.0, 101)) {
+        anchor_points.emplace_back(x, 0.0);
+    }
+    std::vector<double> ts{::boyle::math::linspace(0.0, 20.0, 41)};
+    std::vector<double> ss;
+    for (double t : ts) {
+        ss.push_back(8.0 * t);
+    }
+    return Trajectory2d{Path2d{std::move(anchor_points)}, Motion1d{std::move(ts), std::move(ss)}};
+}
+
+static auto configure(BicycleMpcModel& model) noexcept -> void {
+    model.setSteeringRange(-0.5, 0.5);
+    model.setSteeringRateRange(-0.4, 0.4);
+    model.setAccelRange(-4.0, 2.0);
+    model.setVelocityRange(0.0, 20.0);
+    model.setTrackingCost(10.0, 1.0, 5.0, 1.0);
+    model.setInputCost(1.0, 0.1);
+    model.setInputRateCost(10.0, 1.0);
+    model.setTerminalCostFactor(5.0);
+}
+
+TEST_CASE("Tracking") {
+    constexpr std::size_t kNumSteps{40};
+    const Trajectory2d reference{makeReference()};
+    BicycleMpcModel model{kNumSteps, kDt, kWheelbase};
+    configure(model);
+    model.setInitialState(0.0, 0.5, 0.0, 8.0, 0.0);
+    model.setReference(reference, 0.0);
+    const auto [solution, info] = model.solve();
+
+    CHECK_EQ(info.status_val, 1);
+    CHECK_EQ(solution.xs.size(), kNumSteps + 1);
+    CHECK_EQ(solution.steerings.size(), kNumSteps);
+    CHECK_EQ(solution.ys.front(), doctest::Approx(0.5).epsilon(1E-3));
+    CHECK_EQ(solution.velocities.front(), doctest::Approx(8.0).epsilon(1E-3));
+    CHECK_LT(std::abs(solution.ys.back()), 0.1);
+    CHECK_LT(solution.steerings.front(), 0.0);
+    for (std::size_t k{0}; k < kNumSteps; ++k) {
+        CHECK_LE(std::abs(solution.steerings[k]), 0.5 + 1E-3);
+        if (k > 0) {
+            CHECK_LE(std::abs(solution.steerings[k] - solution.steerings[k - 1]), 0.04 + 1E-3);
+        }
+        CHECK_EQ(
+            solution.velocities[k + 1],
+            doctest::Approx(solution.velocities[k] + solution.accels[k] * kDt).epsilon(1E-3)
+        );
+    }
+}
+
+TEST_CASE("Horizons") {
+    const Trajectory2d reference{makeReference()};
+    for (std::size_t num_steps : {20, 40, 60, 80, 100}) {
+        constexpr int kNumCycles{20};
+        BicycleMpcModel model{num_steps, kDt, kWheelbase};
+        configure(model);
+        std::array<double, 4> state{0.0, 0.5, 0.05, 7.0};
+        double steering{0.0};
+        std::chrono::nanoseconds total_time{0};
+        for (int cycle{0}; cycle < kNumCycles; ++cycle) {
+            const auto start = std::chrono::steady_clock::now();
+            model.setReference(reference, cycle * kDt);
+            model.setInitialState(state[0], state[1], state[2], state[3], steering);
+            const auto [solution, info] = model.solve();
+            model.setWarmStart(solution);
+            total_time += std::chrono::steady_clock::now() - start;
+            CHECK_EQ(info.status_val, 1);
+
+            steering = solution.steerings.front();
+            const double accel{solution.accels.front()};
+            state[0] += state[3] * std::cos(state[2]) * kDt;
+            state[1] += state[3] * std::sin(state[2]) * kDt;
+            state[2] += state[3] * std::tan(steering) / kWheelbase * kDt;
+            state[3] += accel * kDt;
+        }
+        CHECK_LT(std::abs(state[1]), 0.5);
+        MESSAGE(
+            "num_steps = ", num_steps, ", mean cycle time = ",
+            std::chrono::duration<double, std::milli>(total_time).count() / kNumCycles, " ms"
+        );
+    }
+}
+
+} // namespace boyle::kinetics
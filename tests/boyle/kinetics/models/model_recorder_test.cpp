@@ -0,0 +1,199 @@
+/**
+ * @file model_recorder_test.cpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2025-02-27
+ *
+ * @copyright Copyright (c) 2025 Boyle Development Team.
+ *            All rights reserved.
+ *
+ */
+
+#include "boyle/kinetics/models/model_recorder.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "boost/archive/binary_oarchive.hpp"
+
+#include "boyle/kinetics/models/model_inputs.hpp"
+#include "boyle/kinetics/models/model_replay.hpp"
+#include "boyle/kinetics/models/route_line_quintic_acc_model.hpp"
+#include "boyle/kinetics/models/route_line_quintic_offset_model.hpp"
+#include "boyle/math/utils.hpp"
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+namespace boyle::kinetics {
+
+TEST_CASE("RingBuffer") {
+    ModelRecorder<RouteLineQuinticAccInputs> recorder{3};
+    for (int i{0}; i < 5; ++i) {
+        RouteLineQuinticAccInputs& inputs{recorder.beginCycle()};
+        CHECK(inputs.calls.empty());
+        inputs.sample_ts = {0.0, static_cast<double>(i)};
+        inputs.record(ModelCallKind::SOLVE);
+    }
+    REQUIRE_EQ(recorder.size(), 3);
+    CHECK_EQ(recorder.capacity(), 3);
+    for (std::size_t i{0}; i < recorder.size(); ++i) {
+        CHECK_EQ(recorder[i].sequence, i + 2);
+        CHECK_EQ(recorder[i].inputs.sample_ts.back(), static_cast<double>(i + 2));
+    }
+}
+
+TEST_CASE("DumpAndLoad") {
+    ModelRecorder<RouteLineQuinticAccInputs> recorder{4};
+    RouteLineQuinticAccInputs& inputs{recorder.beginCycle()};
+    inputs.sample_ts = ::boyle::math::linspace(0.0, 8.0, 17);
+    inputs.settings.rho = 0.25;
+    inputs.record(ModelCallKind::INITIAL_STATE, {0.0, 5.0, 0.0});
+    const HardFence1d hard_fence{.id = 7, .bound_ts = {2.0, 4.0}, .bound_ss = {30.0, 40.0}};
+    inputs.hard_fences.push_back({hard_fence});
+    inputs.record(ModelCallKind::HARD_FENCES, {0.0});
+
+    std::stringstream ss;
+    recorder.dump(ss);
+    const std::vector<RecordedCycle<RouteLineQuinticAccInputs>> cycles{
+        ModelRecorder<RouteLineQuinticAccInputs>::load(ss)
+    };
+    REQUIRE_EQ(cycles.size(), 1);
+    const RouteLineQuinticAccInputs& loaded{cycles.front().inputs};
+    CHECK_EQ(loaded.sample_ts, inputs.sample_ts);
+    CHECK_EQ(loaded.settings.rho, 0.25);
+    REQUIRE_EQ(loaded.calls.size(), 2);
+    CHECK_EQ(loaded.calls[0].kind, ModelCallKind::INITIAL_STATE);
+    CHECK_EQ(loaded.calls[0].args[1], 5.0);
+    REQUIRE_EQ(loaded.hard_fences.size(), 1);
+    CHECK_EQ(loaded.hard_fences[0][0].id, 7);
+    CHECK_EQ(loaded.hard_fences[0][0].bound_ss, std::vector<double>{30.0, 40.0});
+
+    std::stringstream other;
+    recorder.dump(other);
+    CHECK_THROWS_AS(ModelRecorder<RouteLineQuinticOffsetInputs>::load(other), std::runtime_error);
+}
+
+TEST_CASE("ReplayAccModel") {
+    RouteLineQuinticAccInputs inputs;
+    RouteLineQuinticAccModel model{::boyle::math::linspace(0.0, 8.0, 41)};
+    model.recordInputs(&inputs);
+    model.setInitialState(0.0, 5.0, 0.0);
+    model.setVelocityCost(8.0, 1.0);
+    model.setAccelCost(1.0);
+    model.setJerkCost(10.0);
+    const HardFence1d hard_fence{.id = 1, .bound_ts = {0.0, 8.0}, .bound_ss = {60.0, 60.0}};
+    model.setHardFences({hard_fence});
+    const auto [motion, info] = model.solve();
+    REQUIRE_EQ(inputs.calls.size(), 6);
+
+    const ReplayReport report{replay(inputs)};
+    CHECK_EQ(report.stages.size(), inputs.calls.size());
+    REQUIRE_EQ(report.infos.size(), 1);
+    CHECK_EQ(report.infos.front().iter, info.iter);
+    REQUIRE_EQ(report.solution.size(), motion.ss().size());
+    for (std::size_t i{0}; i < report.solution.size(); ++i) {
+        CHECK_EQ(report.solution[i], motion.ss()[i]);
+    }
+}
+
+TEST_CASE("ReplayOffsetModel") {
+    const std::vector<::boyle::math::Vec2d> sketch_points{
+        {0.0, 0.0}, {8.0, 0.0}, {12.0, 2.0}, {20.0, 2.0}
+    };
+    RouteLineQuinticOffsetInputs inputs;
+    RouteLineQuinticOffsetModel model{sketch_points, ::boyle::math::linspace(0.0, 20.0, 21)};
+    model.recordInputs(&inputs);
+    model.setOffsetCost(1.0);
+    model.setCurvatureCost(10.0);
+    model.setDdxRange(-1.0, 1.0);
+    model.setInitialState({0.0, 0.0}, {1.0, 0.0});
+    model.setFinalState({20.0, 2.0}, {1.0, 0.0});
+    const auto [path, info] = model.solve();
+    CHECK_EQ(inputs.sketch_points, sketch_points);
+
+    std::stringstream ss;
+    ModelRecorder<RouteLineQuinticOffsetInputs> recorder{1};
+    recorder.beginCycle() = inputs;
+    recorder.dump(ss);
+    const ReplayReport report{
+        replay(ModelRecorder<RouteLineQuinticOffsetInputs>::load(ss).front().inputs)
+    };
+    REQUIRE_EQ(report.solution.size(), path.anchorPoints().size() * 2);
+    for (std::size_t i{0}; i < path.anchorPoints().size(); ++i) {
+        CHECK_EQ(report.solution[i * 2], path.anchorPoints()[i].x);
+        CHECK_EQ(report.solution[i * 2 + 1], path.anchorPoints()[i].y);
+    }
+}
+
+TEST_CASE("CorruptedCycleCount") {
+    std::stringstream ss;
+    {
+        boost::archive::binary_oarchive oa{ss};
+        std::string model_name{RouteLineQuinticAccInputs::kModelName};
+        const std::uint64_t num_cycles{std::uint64_t{1} << 60};
+        oa << model_name;
+        oa << num_cycles;
+    }
+    CHECK_THROWS_AS(ModelRecorder<RouteLineQuinticAccInputs>::load(ss), std::runtime_error);
+}
+
+TEST_CASE("TruncatedRecording") {
+    ModelRecorder<RouteLineQuinticOffsetInputs> offset_recorder{3};
+    ModelRecorder<RouteLineQuinticAccInputs> acc_recorder{3};
+    for (int i{0}; i < 3; ++i) {
+        RouteLineQuinticOffsetInputs& offset_inputs{offset_recorder.beginCycle()};
+        offset_inputs.sketch_points = {{0.0, 0.0}, {5.0, 1.0}, {10.0, 0.0}};
+        offset_inputs.sample_ss = ::boyle::math::linspace(0.0, 10.0, 11);
+        offset_inputs.hard_borders.push_back({HardBorder2d{
+            .id = 1, .chirality = Chirality::LEFT, .bound_points = {{0.0, 2.0}, {10.0, 2.0}}
+        }});
+        offset_inputs.record(ModelCallKind::HARD_BORDERS, {0.0});
+        RouteLineQuinticAccInputs& acc_inputs{acc_recorder.beginCycle()};
+        acc_inputs.sample_ts = ::boyle::math::linspace(0.0, 8.0, 17);
+        acc_inputs.hard_fences.push_back(
+            {HardFence1d{.id = 7, .bound_ts = {2.0, 4.0}, .bound_ss = {30.0, 40.0}}}
+        );
+        acc_inputs.record(ModelCallKind::HARD_FENCES, {0.0});
+    }
+
+    // A process that crashes or overruns may leave the dump cut anywhere.
+    std::stringstream offset_ss;
+    offset_recorder.dump(offset_ss);
+    const std::string offset_bytes{offset_ss.str()};
+    for (std::size_t size{0}; size < offset_bytes.size(); size += 7) {
+        std::stringstream truncated{offset_bytes.substr(0, size)};
+        CHECK_THROWS_AS(
+            ModelRecorder<RouteLineQuinticOffsetInputs>::load(truncated), std::exception
+        );
+    }
+    std::stringstream acc_ss;
+    acc_recorder.dump(acc_ss);
+    const std::string acc_bytes{acc_ss.str()};
+    for (std::size_t size{0}; size < acc_bytes.size(); size += 7) {
+        std::stringstream truncated{acc_bytes.substr(0, size)};
+        CHECK_THROWS_AS(ModelRecorder<RouteLineQuinticAccInputs>::load(truncated), std::exception);
+    }
+}
+
+TEST_CASE("RecordClear") {
+    RouteLineQuinticAccInputs inputs;
+    RouteLineQuinticAccModel model{::boyle::math::linspace(0.0, 8.0, 41)};
+    model.recordInputs(&inputs);
+    model.setInitialState(0.0, 5.0, 0.0);
+    model.clear();
+    REQUIRE_EQ(inputs.calls.size(), 2);
+    CHECK_EQ(inputs.calls.back().kind, ModelCallKind::CLEAR);
+
+    const ReplayReport report{replay(inputs)};
+    REQUIRE_EQ(report.stages.size(), 2);
+    CHECK_EQ(report.stages.back().kind, ModelCallKind::CLEAR);
+    CHECK(report.infos.empty());
+}
+
+} // namespace boyle::kinetics
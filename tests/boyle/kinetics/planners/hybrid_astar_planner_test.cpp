@@ -0,0 +1,166 @@
+/**
+ * @file hybrid_astar_planner_test.cpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2024-06-21
+ *
+ * @copyright Copyright (c) 2024 Boyle Development Team
+ *            All rights reserved.
+ *
+ */
+
+#include "boyle/kinetics/planners/hybrid_astar_planner.hpp"
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <stdexcept>
+#include <vector>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+namespace boyle::kinetics {
+
+[[nodiscard]]
+static auto makeBoxObstacle(
+    std::uint64_t id, ::boyle::math::Vec2d center, double heading, double half_length,
+    double half_width
+) noexcept -> StaticObstacle2d {
+    const std::array<::boyle::math::Vec2d, 4> vertices{
+        ::boyle::math::orientedBoxVertices(center, heading, half_length, half_width)
+    };
+    return StaticObstacle2d{.id = id, .vertices = {vertices.cbegin(), vertices.cend()}};
+}
+
+constexpr VehicleFootprint2d kFootprint{
+    .front_length = 3.8, .rear_length = 1.0, .half_width = 0.95, .num_discs = 3
+};
+constexpr double kMinTurningRadius{5.0};
+
+static auto checkResult(
+    const HybridAStarResult& result, const std::vector<StaticObstacle2d>& obstacles,
+    ::boyle::math::Vec2d start, ::boyle::math::Vec2d goal, double goal_heading
+) -> void {
+    REQUIRE(result.found);
+    REQUIRE_FALSE(result.segments.empty());
+    CHECK_EQ(result.segments.front().sketch_points.front().x, doctest::Approx(start.x));
+    CHECK_EQ(result.segments.front().sketch_points.front().y, doctest::Approx(start.y));
+    CHECK_EQ(result.segments.back().sketch_points.back().x, doctest::Approx(goal.x));
+    CHECK_EQ(result.segments.back().sketch_points.back().y, doctest::Approx(goal.y));
+    CHECK_EQ(result.segments.back().headings.back(), doctest::Approx(goal_heading));
+
+    const CollisionChecker2d checker{kFootprint, obstacles};
+    for (std::size_t i{0}; i < result.segments.size(); ++i) {
+        const HybridAStarSegment& segment{result.segments[i]};
+        CHECK_GE(segment.sketch_points.size(), 2);
+        CHECK_EQ(segment.sketch_points.size(), segment.headings.size());
+        if (i > 0) {
+            const HybridAStarSegment& previous{result.segments[i - 1]};
+            CHECK_NE(segment.forward, previous.forward);
+            CHECK_EQ(segment.sketch_points.front(), previous.sketch_points.back());
+        }
+        std::vector<CollisionChecker2d::PoseSample> poses;
+        for (std::size_t j{0}; j < segment.sketch_points.size(); ++j) {
+            poses.push_back(CollisionChecker2d::PoseSample{
+                .s = 0.0,
+                .t = std::numeric_limits<double>::quiet_NaN(),
+                .position = segment.sketch_points[j],
+                .heading = segment.headings[j]
+            });
+            if (j > 0) {
+                const double step{
+                    segment.sketch_points[j].euclideanTo(segment.sketch_points[j - 1])
+                };
+                CHECK_LT(step, 0.5 + 1E-6);
+            }
+        }
+        CHECK_FALSE(checker.check(poses, true).collided);
+    }
+}
+
+TEST_CASE("InvalidSettings") {
+    HybridAStarSettings settings{};
+    settings.analytic_expansion_interval = 0;
+    CHECK_THROWS_AS(
+        HybridAStarPlanner(kFootprint, kMinTurningRadius, settings), std::invalid_argument
+    );
+}
+
+TEST_CASE("OpenSpace") {
+    HybridAStarPlanner planner{kFootprint, kMinTurningRadius};
+    planner.setEnvironment(
+        ::boyle::math::Aabb2d{.lower = {-10.0, -10.0}, .upper = {40.0, 30.0}}, {}
+    );
+    const HybridAStarResult result{planner.plan({0.0, 0.0}, 0.0, {20.0, 10.0}, 0.0)};
+    checkResult(result, {}, {0.0, 0.0}, {20.0, 10.0}, 0.0);
+    CHECK_EQ(result.num_expanded, 1);
+}
+
+TEST_CASE("ParkingLot") {
+    std::vector<StaticObstacle2d> obstacles;
+    std::uint64_t id{0};
+    for (int i{0}; i < 12; ++i) {
+        const double x{2.0 + i * 3.0};
+        if (i == 6) {
+            continue;
+        }
+        obstacles.push_back(makeBoxObstacle(id++, {x, 2.5}, std::numbers::pi / 2.0, 2.4, 1.0));
+        obstacles.push_back(makeBoxObstacle(id++, {x, 17.5}, std::numbers::pi / 2.0, 2.4, 1.0));
+    }
+    obstacles.push_back(makeBoxObstacle(id++, {18.0, -0.5}, 0.0, 20.0, 0.5));
+    obstacles.push_back(makeBoxObstacle(id++, {18.0, 20.5}, 0.0, 20.0, 0.5));
+    obstacles.push_back(makeBoxObstacle(id++, {12.0, 10.0}, 0.0, 1.0, 1.0));
+
+    HybridAStarPlanner planner{kFootprint, kMinTurningRadius};
+    planner.setEnvironment(
+        ::boyle::math::Aabb2d{.lower = {-2.0, -1.0}, .upper = {38.0, 21.0}}, obstacles
+    );
+
+    SUBCASE("ReverseIntoSlot") {
+        const ::boyle::math::Vec2d start{2.0, 10.0};
+        const ::boyle::math::Vec2d goal{20.0, 1.5};
+        const double goal_heading{std::numbers::pi / 2.0};
+        const auto begin = std::chrono::steady_clock::now();
+        const HybridAStarResult result{planner.plan(start, 0.0, goal, goal_heading)};
+        const auto elapsed = std::chrono::steady_clock::now() - begin;
+        checkResult(result, obstacles, start, goal, goal_heading);
+        CHECK_FALSE(result.segments.back().forward);
+        MESSAGE(
+            "expanded = ", result.num_expanded, ", segments = ", result.segments.size(),
+            ", time = ", std::chrono::duration<double, std::milli>(elapsed).count(), " ms"
+        );
+    }
+
+    SUBCASE("GoalInCollision") {
+        const HybridAStarResult result{planner.plan({2.0, 10.0}, 0.0, {12.0, 10.0}, 0.0)};
+        CHECK_FALSE(result.found);
+        CHECK_EQ(result.num_expanded, 0);
+    }
+}
+
+TEST_CASE("Unreachable") {
+    const std::vector<StaticObstacle2d> obstacles{
+        makeBoxObstacle(0, {20.0, 4.0}, 0.0, 6.0, 0.5),
+        makeBoxObstacle(1, {20.0, 16.0}, 0.0, 6.0, 0.5),
+        makeBoxObstacle(2, {14.5, 10.0}, 0.0, 0.5, 6.5),
+        makeBoxObstacle(3, {25.5, 10.0}, 0.0, 0.5, 6.5)
+    };
+    HybridAStarSettings settings;
+    settings.time_budget = 0.02;
+    HybridAStarPlanner planner{kFootprint, kMinTurningRadius, settings};
+    planner.setEnvironment(
+        ::boyle::math::Aabb2d{.lower = {-10.0, -10.0}, .upper = {50.0, 30.0}}, obstacles
+    );
+    const auto begin = std::chrono::steady_clock::now();
+    const HybridAStarResult result{planner.plan({0.0, 0.0}, 0.0, {20.0, 10.0}, 0.0)};
+    const auto elapsed = std::chrono::steady_clock::now() - begin;
+    CHECK_FALSE(result.found);
+    CHECK_GT(result.num_expanded, 0);
+    CHECK_LT(std::chrono::duration<double>(elapsed).count(), 0.2);
+}
+
+} // namespace boyle::kinetics
@@ -0,0 +1,136 @@
+/**
+ * @file route_distance_field2_test.cpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2024-06-17
+ *
+ * @copyright Copyright (c) 2024 Boyle Development Team
+ *            All rights reserved.
+ *
+ */
+
+#include "boyle/kinetics/route_distance_field2.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+#include "boyle/math/utils.hpp"
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+namespace boyle::kinetics {
+
+TEST_CASE("StraightCorridor") {
+    std::vector<::boyle::math::Vec2d> anchor_points;
+    std::vector<::boyle::math::Vec2d> left_points;
+    std::vector<::boyle::math::Vec2d> right_points;
+    for (double x : ::boyle::math::linspace(0.0, 50.0, 26)) {
+        anchor_points.emplace_back(x, 0.0);
+        left_points.emplace_back(x, 3.0);
+        right_points.emplace_back(x, -3.0);
+    }
+    const RouteLine2d route_line{anchor_points};
+    const std::vector<HardBorder2d> hard_borders{
+        HardBorder2d{.id = 1, .chirality = Chirality::LEFT, .bound_points = left_points},
+        HardBorder2d{.id = 2, .chirality = Chirality::RIGHT, .bound_points = right_points}
+    };
+    const std::array<::boyle::math::Vec2d, 4> box{
+        ::boyle::math::orientedBoxVertices(::boyle::math::Vec2d{30.0, 0.0}, 0.0, 1.0, 1.0)
+    };
+    const std::vector<StaticObstacle2d> obstacles{
+        StaticObstacle2d{.id = 3, .vertices = {box.cbegin(), box.cend()}}
+    };
+
+    SUBCASE("Borders") {
+        const RouteDistanceField2d field{
+            route_line, 0.0, 20.0, 0.5, -4.0, 4.0, 0.1, hard_borders, {}, 5.0
+        };
+        CHECK_EQ(field.numS(), 41);
+        CHECK_EQ(field.numL(), 81);
+        CHECK_EQ(field.maxS(), doctest::Approx(20.0));
+        CHECK_EQ(field.maxL(), doctest::Approx(4.0));
+        for (double s : ::boyle::math::linspace(1.0, 19.0, 7)) {
+            for (double l : ::boyle::math::linspace(-3.9, 3.9, 27)) {
+                CHECK_EQ(field.distance(s, l), doctest::Approx(3.0 - std::abs(l)).epsilon(1E-6));
+                const ::boyle::math::SlDuplet<double> gradient{field.gradient(s, l)};
+                CHECK_EQ(gradient.s, doctest::Approx(0.0));
+                if (l > 0.1) {
+                    CHECK_EQ(gradient.l, doctest::Approx(-1.0).epsilon(1E-6));
+                } else if (l < -0.1) {
+                    CHECK_EQ(gradient.l, doctest::Approx(1.0).epsilon(1E-6));
+                }
+            }
+        }
+    }
+
+    SUBCASE("BeyondHorizon") {
+        const RouteDistanceField2d field{
+            route_line, 0.0, 20.0, 0.5, -10.0, 10.0, 0.25, hard_borders, {}, 2.0
+        };
+        for (double s : ::boyle::math::linspace(1.0, 19.0, 7)) {
+            for (double l : ::boyle::math::linspace(-10.0, 10.0, 41)) {
+                CHECK_EQ(
+                    field.distance(s, l),
+                    doctest::Approx(std::clamp(3.0 - std::abs(l), -2.0, 2.0)).epsilon(1E-6)
+                );
+            }
+        }
+    }
+
+    SUBCASE("Obstacles") {
+        const RouteDistanceField2d field{
+            route_line, 20.0, 40.0, 0.25, -2.5, 2.5, 0.25, hard_borders, obstacles, 2.0
+        };
+        CHECK_EQ(field(30.0, 0.0), doctest::Approx(-1.0));
+        CHECK_EQ(field(27.0, 0.0), doctest::Approx(2.0));
+        CHECK_EQ(field(28.5, 0.0), doctest::Approx(0.5));
+        CHECK_EQ(field(28.25, 0.0), doctest::Approx(0.75));
+        CHECK_LT(field.gradient(28.4, 0.0).s, 0.0);
+        CHECK_GT(field.gradient(31.6, 0.0).s, 0.0);
+        CHECK_EQ(field(21.0, 0.0), doctest::Approx(2.0));
+        CHECK_EQ(field(-100.0, 0.0), field(20.0, 0.0));
+    }
+}
+
+TEST_CASE("CurvedCorridor") {
+    constexpr double kLeftWidth{2.0};
+    constexpr double kRightWidth{4.0};
+
+    std::vector<::boyle::math::Vec2d> anchor_points;
+    for (double x : ::boyle::math::linspace(0.0, 60.0, 61)) {
+        anchor_points.emplace_back(x, 5.0 * std::sin(x / 10.0));
+    }
+    const RouteLine2d route_line{anchor_points};
+
+    std::vector<::boyle::math::Vec2d> left_points;
+    std::vector<::boyle::math::Vec2d> right_points;
+    for (double s : ::boyle::math::linspace(route_line.minS(), route_line.maxS(), 301)) {
+        const ::boyle::math::Vec2d left{route_line.tangent(s).rotateHalfPi()};
+        left_points.push_back(route_line(s) + left * kLeftWidth);
+        right_points.push_back(route_line(s) - left * kRightWidth);
+    }
+    const std::vector<HardBorder2d> hard_borders{
+        HardBorder2d{.id = 1, .chirality = Chirality::LEFT, .bound_points = left_points},
+        HardBorder2d{.id = 2, .chirality = Chirality::RIGHT, .bound_points = right_points}
+    };
+    const RouteDistanceField2d field{
+        route_line, 5.0, route_line.maxS() - 5.0, 0.5, -5.0, 3.0, 0.1, hard_borders, {}, 5.0
+    };
+
+    // The route crosses inflection points at x = 10 pi and 20 pi, the l axis must not flip there.
+    for (double s : ::boyle::math::linspace(field.minS(), field.maxS(), 37)) {
+        CHECK_EQ(field.distance(s, 1.5), doctest::Approx(0.5).epsilon(1E-2));
+        CHECK_EQ(field.distance(s, 0.0), doctest::Approx(2.0).epsilon(1E-2));
+        CHECK_EQ(field.distance(s, -3.5), doctest::Approx(0.5).epsilon(1E-2));
+        CHECK_EQ(field.distance(s, 2.5), doctest::Approx(-0.5).epsilon(1E-2));
+        CHECK_EQ(field.distance(s, -4.5), doctest::Approx(-0.5).epsilon(1E-2));
+        CHECK_EQ(field.gradient(s, 1.0).l, doctest::Approx(-1.0).epsilon(1E-2));
+        CHECK_EQ(field.gradient(s, -3.0).l, doctest::Approx(1.0).epsilon(1E-2));
+    }
+}
+
+} // namespace boyle::kinetics
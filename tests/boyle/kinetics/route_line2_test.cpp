@@ -0,0 +1,173 @@
+/**
+ * @file route_line2_test.cpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2024-06-19
+ *
+ * @copyright Copyright (c) 2024 Boyle Development Team
+ *            All rights reserved.
+ *
+ */
+
+#include "boyle/kinetics/route_line2.hpp"
+
+#include <cmath>
+#include <numbers>
+#include <span>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "boyle/math/flat_file.hpp"
+#include "boyle/math/utils.hpp"
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+namespace boyle::kinetics {
+
+TEST_CASE("StraightFrenetStates") {
+    std::vector<::boyle::math::Vec2d> anchor_points;
+    for (double x : ::boyle::math::linspace(0.0, 100.0, 51)) {
+        anchor_points.emplace_back(x, 0.0);
+    }
+    const RouteLine2d route_line{anchor_points};
+
+    const CartesianStates2d cartesian{
+        .xs = {10.0, 40.0, 70.0},
+        .ys = {2.0, -1.5, 0.0},
+        .headings = {0.0, std::numbers::pi / 4.0, -0.1},
+        .curvatures = {0.0, 0.0, 0.0},
+        .velocities = {5.0, 2.0, 10.0},
+        .accels = {1.0, 0.0, -2.0}
+    };
+    FrenetStates2d frenet;
+    route_line.toFrenet(cartesian, frenet);
+
+    CHECK_EQ(frenet.ss[0], doctest::Approx(10.0));
+    CHECK_EQ(frenet.ls[0], doctest::Approx(2.0));
+    CHECK_EQ(frenet.dss[0], doctest::Approx(5.0));
+    CHECK_EQ(frenet.ddss[0], doctest::Approx(1.0));
+    CHECK_EQ(frenet.dls[0], doctest::Approx(0.0));
+    CHECK_EQ(frenet.ss[1], doctest::Approx(40.0));
+    CHECK_EQ(frenet.ls[1], doctest::Approx(-1.5));
+    CHECK_EQ(frenet.dss[1], doctest::Approx(std::sqrt(2.0)));
+    CHECK_EQ(frenet.dls[1], doctest::Approx(1.0));
+    CHECK_EQ(frenet.dls[2], doctest::Approx(std::tan(-0.1)));
+}
+
+TEST_CASE("CircularFrenetStates") {
+    constexpr double kRadius{20.0};
+    std::vector<::boyle::math::Vec2d> anchor_points;
+    for (double theta : ::boyle::math::linspace(0.0, std::numbers::pi, 121)) {
+        anchor_points.emplace_back(kRadius * std::sin(theta), kRadius * (1.0 - std::cos(theta)));
+    }
+    const RouteLine2d route_line{anchor_points};
+    const ::boyle::math::Vec2d center{0.0, kRadius};
+
+    CartesianStates2d cartesian;
+    std::vector<double> expected_ss;
+    std::vector<double> expected_ls;
+    std::vector<double> radii;
+    for (double theta : ::boyle::math::linspace(0.5, 2.6, 22)) {
+        for (double l : {-2.0, -0.5, 0.0, 1.5, 3.0}) {
+            const double radius{kRadius - l};
+            cartesian.xs.push_back(center.x + radius * std::sin(theta));
+            cartesian.ys.push_back(center.y - radius * std::cos(theta));
+            cartesian.headings.push_back(theta);
+            cartesian.curvatures.push_back(1.0 / radius);
+            cartesian.velocities.push_back(8.0);
+            cartesian.accels.push_back(0.5);
+            expected_ss.push_back(kRadius * theta);
+            expected_ls.push_back(l);
+            radii.push_back(radius);
+        }
+    }
+
+    FrenetStates2d frenet;
+    route_line.toFrenet(cartesian, frenet);
+    for (std::size_t i{0}; i < expected_ss.size(); ++i) {
+        CHECK_EQ(frenet.ss[i], doctest::Approx(expected_ss[i]).epsilon(1E-4));
+        CHECK_EQ(frenet.ls[i], doctest::Approx(expected_ls[i]).epsilon(1E-4));
+        CHECK_EQ(frenet.dss[i], doctest::Approx(8.0 * kRadius / radii[i]).epsilon(1E-3));
+        CHECK_EQ(frenet.ddss[i], doctest::Approx(0.5 * kRadius / radii[i]).epsilon(1E-3));
+        CHECK_EQ(frenet.dls[i], doctest::Approx(0.0).epsilon(1E-3));
+        CHECK_EQ(frenet.ddls[i], doctest::Approx(0.0).epsilon(1E-3));
+    }
+
+    SUBCASE("Hinted") {
+        std::vector<double> hint_ss{expected_ss};
+        for (double& hint_s : hint_ss) {
+            hint_s += 0.8;
+        }
+        FrenetStates2d hinted_frenet;
+        route_line.toFrenet(cartesian, hinted_frenet, hint_ss);
+        for (std::size_t i{0}; i < expected_ss.size(); ++i) {
+            CHECK_EQ(hinted_frenet.ss[i], doctest::Approx(frenet.ss[i]).epsilon(1E-8));
+            CHECK_EQ(hinted_frenet.ls[i], doctest::Approx(frenet.ls[i]).epsilon(1E-8));
+        }
+    }
+
+    SUBCASE("RoundTrip") {
+        CartesianStates2d other_cartesian;
+        route_line.toCartesian(frenet, other_cartesian);
+        for (std::size_t i{0}; i < expected_ss.size(); ++i) {
+            CHECK_EQ(other_cartesian.xs[i], doctest::Approx(cartesian.xs[i]).epsilon(1E-8));
+            CHECK_EQ(other_cartesian.ys[i], doctest::Approx(cartesian.ys[i]).epsilon(1E-8));
+            CHECK_EQ(
+                other_cartesian.headings[i], doctest::Approx(cartesian.headings[i]).epsilon(1E-8)
+            );
+            CHECK_EQ(
+                other_cartesian.curvatures[i],
+                doctest::Approx(cartesian.curvatures[i]).epsilon(1E-8)
+            );
+            CHECK_EQ(
+                other_cartesian.velocities[i],
+                doctest::Approx(cartesian.velocities[i]).epsilon(1E-8)
+            );
+            CHECK_EQ(
+                other_cartesian.accels[i], doctest::Approx(cartesian.accels[i]).epsilon(1E-8)
+            );
+        }
+    }
+}
+
+TEST_CASE("FlatView") {
+    std::vector<::boyle::math::Vec2d> anchor_points;
+    for (double theta : ::boyle::math::linspace(0.0, std::numbers::pi, 61)) {
+        anchor_points.emplace_back(20.0 * std::sin(theta), 20.0 * (1.0 - std::cos(theta)));
+    }
+    const RouteLine2d route_line{anchor_points};
+
+    std::ostringstream oss;
+    ::boyle::math::FlatWriter writer{oss};
+    route_line.writeFlat(writer);
+    const std::string buffer{oss.str()};
+    ::boyle::math::FlatReader reader{std::span<const std::byte>{
+        reinterpret_cast<const std::byte*>(buffer.data()), buffer.size()
+    }};
+    const view::RouteLine2d route_line_view{view::RouteLine2d::fromFlat(reader.next())};
+    CHECK(reader.done());
+
+    const CartesianStates2d cartesian{
+        .xs = {5.0, 18.0, 12.0},
+        .ys = {1.0, 9.0, 30.0},
+        .headings = {0.3, 1.5, 2.8},
+        .curvatures = {0.0, 0.05, 0.02},
+        .velocities = {5.0, 2.0, 10.0},
+        .accels = {1.0, 0.0, -2.0}
+    };
+    FrenetStates2d expected;
+    FrenetStates2d frenet;
+    route_line.toFrenet(cartesian, expected);
+    route_line_view.toFrenet(cartesian, frenet);
+    for (std::size_t i{0}; i < cartesian.xs.size(); ++i) {
+        CHECK_EQ(frenet.ss[i], expected.ss[i]);
+        CHECK_EQ(frenet.ls[i], expected.ls[i]);
+        CHECK_EQ(frenet.dss[i], expected.dss[i]);
+        CHECK_EQ(frenet.ddls[i], expected.ddls[i]);
+    }
+}
+
+} // namespace boyle::kinetics
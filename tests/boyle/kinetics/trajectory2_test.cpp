@@ -0,0 +1,124 @@
+/**
+ * @file trajectory2_test.cpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2024-06-12
+ *
+ * @copyright Copyright (c) 2024 Boyle Development Team
+ *            All rights reserved.
+ *
+ */
+
+#include "boyle/kinetics/trajectory2.hpp"
+
+#include <cmath>
+#include <numbers>
+#include <sstream>
+#include <vector>
+
+#include "boost/archive/binary_iarchive.hpp"
+#include "boost/archive/binary_oarchive.hpp"
+
+#include "boyle/common/utils/alloc_counter.hpp"
+#include "boyle/math/utils.hpp"
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+namespace boyle::kinetics {
+
+[[nodiscard]]
+static auto makeTrajectory() noexcept -> Trajectory2d {
+    constexpr double kRadius{20.0};
+    std::vector<::boyle::math::Vec2d> anchor_points;
+    for (double theta : ::boyle::math::linspace(0.0, std::numbers::pi, 61)) {
+        anchor_points.emplace_back(kRadius * std::sin(theta), kRadius * (1.0 - std::cos(theta)));
+    }
+    std::vector<double> ts{::boyle::math::linspace(0.0, 8.0, 33)};
+    std::vector<double> ss;
+    ss.reserve(ts.size());
+    for (double t : ts) {
+        ss.emplace_back(2.0 * t + 0.25 * t * t);
+    }
+    return Trajectory2d{Path2d{std::move(anchor_points)}, Motion1d{std::move(ts), std::move(ss)}};
+}
+
+TEST_CASE("StateAt") {
+    const Trajectory2d trajectory{makeTrajectory()};
+    const Path2d& path{trajectory.path()};
+    const Motion1d& motion{trajectory.motion()};
+
+    for (double t : ::boyle::math::linspace(0.0, 8.0, 97)) {
+        const TrajectoryState2d state{trajectory.stateAt(t)};
+        const double s{motion.s(t)};
+        const ::boyle::math::Vec2d point{path(s)};
+        CHECK_EQ(state.t, t);
+        CHECK_EQ(state.s, doctest::Approx(s).epsilon(1E-9));
+        CHECK_EQ(state.x, doctest::Approx(point.x).epsilon(1E-9));
+        CHECK_EQ(state.y, doctest::Approx(point.y).epsilon(1E-9));
+        CHECK_EQ(state.heading, doctest::Approx(path.tangent(s).angle()).epsilon(1E-9));
+        CHECK_EQ(std::abs(state.curvature), doctest::Approx(path.curvature(s)).epsilon(1E-9));
+        CHECK_EQ(state.velocity, doctest::Approx(motion.velocity(t)).epsilon(1E-9));
+        CHECK_EQ(state.accel, doctest::Approx(motion.accel(t)).epsilon(1E-9));
+    }
+
+    const TrajectoryState2d state{trajectory.stateAt(4.0)};
+    CHECK_GT(state.curvature, 0.0);
+    CHECK_EQ(state.curvature, doctest::Approx(1.0 / 20.0).epsilon(1E-3));
+}
+
+TEST_CASE("Sample") {
+    const Trajectory2d trajectory{makeTrajectory()};
+
+    SUBCASE("Forward") {
+        constexpr std::size_t kNumSamples{200};
+        std::vector<TrajectoryState2d> states(kNumSamples);
+        trajectory.sample(-0.5, 0.05, kNumSamples, states);
+        CHECK_NO_ALLOC(trajectory.sample(-0.5, 0.05, kNumSamples, states));
+        for (const TrajectoryState2d& state : states) {
+            const TrajectoryState2d expected{trajectory.stateAt(state.t)};
+            CHECK_EQ(state.x, doctest::Approx(expected.x).epsilon(1E-12));
+            CHECK_EQ(state.y, doctest::Approx(expected.y).epsilon(1E-12));
+            CHECK_EQ(state.heading, doctest::Approx(expected.heading).epsilon(1E-12));
+            CHECK_EQ(state.curvature, doctest::Approx(expected.curvature).epsilon(1E-12));
+            CHECK_EQ(state.velocity, doctest::Approx(expected.velocity).epsilon(1E-12));
+            CHECK_EQ(state.accel, doctest::Approx(expected.accel).epsilon(1E-12));
+        }
+    }
+
+    SUBCASE("Backward") {
+        const std::vector<TrajectoryState2d> states{trajectory.sample(8.0, -0.1, 81)};
+        CHECK_EQ(states.size(), 81);
+        for (const TrajectoryState2d& state : states) {
+            const TrajectoryState2d expected{trajectory.stateAt(state.t)};
+            CHECK_EQ(state.x, doctest::Approx(expected.x).epsilon(1E-12));
+            CHECK_EQ(state.y, doctest::Approx(expected.y).epsilon(1E-12));
+            CHECK_EQ(state.velocity, doctest::Approx(expected.velocity).epsilon(1E-12));
+        }
+    }
+}
+
+TEST_CASE("Serialization") {
+    const Trajectory2d trajectory{makeTrajectory()};
+
+    std::ostringstream oss;
+    boost::archive::binary_oarchive oa(oss);
+    oa << trajectory;
+
+    Trajectory2d other_trajectory;
+
+    std::istringstream iss(oss.str());
+    boost::archive::binary_iarchive ia(iss);
+    ia >> other_trajectory;
+
+    for (double t : ::boyle::math::linspace(0.0, 8.0, 17)) {
+        const TrajectoryState2d state{trajectory.stateAt(t)};
+        const TrajectoryState2d other_state{other_trajectory.stateAt(t)};
+        CHECK_EQ(state.x, other_state.x);
+        CHECK_EQ(state.y, other_state.y);
+        CHECK_EQ(state.velocity, other_state.velocity);
+    }
+}
+
+} // namespace boyle::kinetics
@@ -0,0 +1,145 @@
+/**
+ * @file bspline_curve2_test.cpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2024-06-24
+ *
+ * @copyright Copyright (c) 2024 Boyle Development Team
+ *            All rights reserved.
+ *
+ */
+
+#include "boyle/math/curves/bspline_curve.hpp"
+
+#include <cmath>
+#include <numbers>
+#include <vector>
+
+#include "boyle/math/curves/curve2_proxy.hpp"
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+namespace boyle::math {
+
+TEST_CASE("Basic") {
+    const BSplineCurve2d line{std::vector<Vec2d>{
+        Vec2d{0.0, 0.0}, Vec2d{1.0, 1.0}, Vec2d{2.0, 2.0}, Vec2d{3.0, 3.0}, Vec2d{4.0, 4.0}
+    }};
+    CHECK_EQ(line.maxS(), doctest::Approx(4.0 * std::numbers::sqrt2));
+    CHECK_EQ(line.back().x, doctest::Approx(4.0));
+    CHECK_EQ(line.eval(std::numbers::sqrt2).x, doctest::Approx(1.0));
+    CHECK_EQ(line.eval(std::numbers::sqrt2).y, doctest::Approx(1.0));
+    CHECK_EQ(line.curvature(2.0), doctest::Approx(0.0));
+    CHECK_EQ(line.tangent(1.0).x, doctest::Approx(std::numbers::sqrt2 * 0.5));
+
+    std::vector<Vec2d> control_points;
+    for (int i{0}; i < 16; ++i) {
+        const double theta{i * 0.4};
+        control_points.emplace_back(4.0 * theta, 3.0 * std::sin(theta));
+    }
+    const BSplineCurve2d curve{control_points, 2.0};
+    CHECK_EQ(curve.minS(), doctest::Approx(2.0));
+    CHECK_EQ(curve.front().x, doctest::Approx(control_points.front().x));
+    CHECK_EQ(curve.back().y, doctest::Approx(control_points.back().y));
+    constexpr double kStep{1E-3};
+    for (double s{curve.minS()}; s + kStep < curve.maxS(); s += 0.37) {
+        CHECK_EQ(curve.eval(s).euclideanTo(curve.eval(s + kStep)), doctest::Approx(kStep));
+        const double curvature{curve.tangent(s).crossProj(curve.tangent(s + kStep)) / kStep};
+        CHECK_EQ(curve.curvature(s + kStep * 0.5), doctest::Approx(curvature).epsilon(1E-4));
+        const SlDupletd sl{curve.inverse(curve.eval(s, 0.25))};
+        CHECK_EQ(sl.s, doctest::Approx(s));
+        CHECK_EQ(sl.l, doctest::Approx(0.25));
+    }
+}
+
+TEST_CASE("LocalEdit") {
+    std::vector<Vec2d> control_points;
+    for (int i{0}; i < 40; ++i) {
+        control_points.emplace_back(i * 2.0, std::cos(i * 0.3));
+    }
+    BSplineCurve2d curve{control_points};
+    const std::vector<Vec2d> anchor_points{curve.anchorPoints()};
+
+    constexpr std::size_t kPos{20};
+    control_points[kPos] = Vec2d{kPos * 2.0, 3.0};
+    curve.setControlPoint(kPos, control_points[kPos]);
+    const BSplineCurve2d rebuilt{control_points};
+    REQUIRE_EQ(curve.arcLengths().size(), rebuilt.arcLengths().size());
+    for (std::size_t i{0}; i < curve.arcLengths().size(); ++i) {
+        CHECK_EQ(curve.arcLengths()[i], doctest::Approx(rebuilt.arcLengths()[i]));
+        CHECK_EQ(curve.anchorPoints()[i].x, doctest::Approx(rebuilt.anchorPoints()[i].x));
+        CHECK_EQ(curve.anchorPoints()[i].y, doctest::Approx(rebuilt.anchorPoints()[i].y));
+        const double u{curve.params()[i]};
+        if (u <= curve.knots()[kPos] || u >= curve.knots()[kPos + BSplineCurve2d::kOrder]) {
+            CHECK_EQ(curve.anchorPoints()[i].y, anchor_points[i].y);
+        }
+    }
+}
+
+TEST_CASE("KnotInsertion") {
+    BSplineCurve2d curve{std::vector<Vec2d>{
+        Vec2d{0.0, 0.0}, Vec2d{2.0, 3.0}, Vec2d{4.0, -1.0}, Vec2d{7.0, 2.0}, Vec2d{9.0, 0.0},
+        Vec2d{12.0, 4.0}
+    }};
+    const BSplineCurve2d original{curve};
+    curve.insertKnot(0.5);
+    curve.insertKnot(1.5);
+    curve.insertKnot(1.5);
+    CHECK_EQ(curve.controlPoints().size(), original.controlPoints().size() + 3);
+    CHECK_EQ(curve.maxS(), doctest::Approx(original.maxS()));
+    for (double u{0.0}; u <= 3.0; u += 0.05) {
+        CHECK_EQ(curve.evalParam(u).x, doctest::Approx(original.evalParam(u).x));
+        CHECK_EQ(curve.evalParam(u).y, doctest::Approx(original.evalParam(u).y));
+    }
+    for (double s{0.0}; s <= curve.maxS(); s += 0.5) {
+        CHECK_EQ(curve.eval(s).x, doctest::Approx(original.eval(s).x));
+        CHECK_EQ(curve.eval(s).y, doctest::Approx(original.eval(s).y));
+    }
+}
+
+TEST_CASE("Conversion") {
+    const std::vector<Vec2d> anchor_points{
+        Vec2d{0.0, 0.0}, Vec2d{3.0, 1.0}, Vec2d{5.0, 4.0}, Vec2d{8.0, 4.5}, Vec2d{11.0, 2.0},
+        Vec2d{13.0, 3.0}
+    };
+    const PiecewiseCubicCurve2d cubic_curve{anchor_points};
+    const BSplineCurve2d cubic_bspline{cubic_curve};
+    for (double t{cubic_curve.minS()}; t < cubic_curve.maxS(); t += 0.1) {
+        CHECK_EQ(cubic_bspline.evalParam(t).x, doctest::Approx(cubic_curve.eval(t).x));
+        CHECK_EQ(cubic_bspline.evalParam(t).y, doctest::Approx(cubic_curve.eval(t).y));
+    }
+    CHECK_EQ(cubic_bspline.back().x, doctest::Approx(cubic_curve.back().x));
+    CHECK_EQ(cubic_bspline.back().y, doctest::Approx(cubic_curve.back().y));
+
+    const PiecewiseQuinticCurve2d quintic_curve{anchor_points};
+    const BSplineCurve<Vec2d, 5> quintic_bspline{quintic_curve};
+    for (double t{quintic_curve.minS()}; t < quintic_curve.maxS(); t += 0.1) {
+        CHECK_EQ(quintic_bspline.evalParam(t).x, doctest::Approx(quintic_curve.eval(t).x));
+        CHECK_EQ(quintic_bspline.evalParam(t).y, doctest::Approx(quintic_curve.eval(t).y));
+    }
+
+    const PiecewiseCubicCurve2d resampled{cubic_bspline.toPiecewiseCubicCurve()};
+    CHECK_EQ(resampled.maxS(), doctest::Approx(cubic_bspline.maxS()).epsilon(1E-4));
+    for (double s{0.0}; s < resampled.maxS(); s += 0.5) {
+        CHECK_EQ(resampled.eval(s).x, doctest::Approx(cubic_bspline.eval(s).x).epsilon(1E-3));
+        CHECK_EQ(resampled.eval(s).y, doctest::Approx(cubic_bspline.eval(s).y).epsilon(1E-3));
+    }
+}
+
+TEST_CASE("Polymorphism") {
+    const Curve2Proxy<Vec2d> curve{makeCurve2Proxy(BSplineCurve2d{std::vector<Vec2d>{
+        Vec2d{0.0, 0.0}, Vec2d{2.0, 1.0}, Vec2d{4.0, 3.0}, Vec2d{5.0, 6.0}, Vec2d{7.0, 7.0}
+    }})};
+    const std::vector<double>& arc_lengths{curve->arcLengths()};
+    for (std::size_t i{1}; i < arc_lengths.size(); ++i) {
+        const double s{(arc_lengths[i - 1] + arc_lengths[i]) * 0.5};
+        const Vec2d point{curve->eval(s) + curve->normal(s) * 0.1};
+        const SlDupletd sl{curve->inverse(point)};
+        CHECK_EQ(sl.s, doctest::Approx(s));
+        CHECK_EQ(sl.l, doctest::Approx(0.1));
+    }
+}
+
+} // namespace boyle::math
@@ -0,0 +1,139 @@
+/**
+ * @file piecewise_arc_curve2_test.cpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2024-06-22
+ *
+ * @copyright Copyright (c) 2024 Boyle Development Team
+ *            All rights reserved.
+ *
+ */
+
+#include "boyle/math/curves/piecewise_arc_curve.hpp"
+
+#include <cmath>
+#include <numbers>
+#include <random>
+#include <vector>
+
+#include "boyle/math/curves/curve2_proxy.hpp"
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+namespace boyle::math {
+
+constexpr double kRadius{2.0};
+
+TEST_CASE("Basic") {
+    const PiecewiseArcCurve2d curve{
+        Vec2d{0.0, 0.0}, 0.0, {0.0, 0.5, 0.0}, {2.0, std::numbers::pi, 1.0}
+    };
+    CHECK_EQ(curve.minS(), 0.0);
+    CHECK_EQ(curve.maxS(), doctest::Approx(3.0 + std::numbers::pi));
+    CHECK_EQ(curve.back().x, doctest::Approx(4.0));
+    CHECK_EQ(curve.back().y, doctest::Approx(3.0));
+    CHECK_EQ(curve.eval(2.0 + std::numbers::pi).x, doctest::Approx(4.0));
+    CHECK_EQ(curve.eval(2.0 + std::numbers::pi).y, doctest::Approx(2.0));
+    CHECK_EQ(curve.tangent(2.0 + std::numbers::pi).y, doctest::Approx(1.0));
+    CHECK_EQ(curve.curvature(2.0 + std::numbers::pi * 0.5), doctest::Approx(0.5));
+    CHECK_EQ(curve.curvature(1.0), doctest::Approx(0.0));
+
+    const SlDupletd sl{curve.inverse(Vec2d{3.0, 2.0})};
+    CHECK_EQ(sl.s, doctest::Approx(2.0 + std::numbers::pi));
+    CHECK_EQ(sl.l, doctest::Approx(1.0));
+    const Vec2d point{curve.eval(sl)};
+    CHECK_EQ(point.x, doctest::Approx(3.0));
+    CHECK_EQ(point.y, doctest::Approx(2.0));
+
+    const PiecewiseArcCurve2d reverse{Vec2d{0.0, 0.0}, 0.0, {0.5}, {-1.0}};
+    CHECK_FALSE(reverse.forward(0.5));
+    CHECK_EQ(reverse.back().x, doctest::Approx(-2.0 * std::sin(0.5)));
+    CHECK_EQ(reverse.heading(1.0), doctest::Approx(-0.5));
+    CHECK_EQ(reverse.curvature(0.5), doctest::Approx(-0.5));
+    CHECK_EQ(reverse.tangent(0.0).x, doctest::Approx(-1.0));
+}
+
+TEST_CASE("DubinsAndReedsShepp") {
+    std::mt19937 engine{42};
+    std::uniform_real_distribution<double> position{-10.0, 10.0};
+    std::uniform_real_distribution<double> angle{-std::numbers::pi, std::numbers::pi};
+
+    constexpr std::size_t kNumPairs{1000};
+    std::vector<Vec2d> starts(kNumPairs);
+    std::vector<Vec2d> goals(kNumPairs);
+    std::vector<double> start_headings(kNumPairs);
+    std::vector<double> goal_headings(kNumPairs);
+    for (std::size_t i{0}; i < kNumPairs; ++i) {
+        starts[i] = Vec2d{position(engine), position(engine)};
+        goals[i] = Vec2d{position(engine), position(engine)};
+        start_headings[i] = angle(engine);
+        goal_headings[i] = angle(engine);
+    }
+    std::vector<double> dubins_lengths(kNumPairs);
+    std::vector<double> reeds_shepp_lengths(kNumPairs);
+    dubinsLengths<double>(
+        starts, start_headings, goals, goal_headings, kRadius, dubins_lengths
+    );
+    reedsSheppLengths<double>(
+        starts, start_headings, goals, goal_headings, kRadius, reeds_shepp_lengths
+    );
+
+    for (std::size_t i{0}; i < kNumPairs; ++i) {
+        const DubinsPathd dubins_path{
+            dubinsPath(starts[i], start_headings[i], goals[i], goal_headings[i], kRadius)
+        };
+        const ReedsSheppPathd reeds_shepp_path{
+            reedsSheppPath(starts[i], start_headings[i], goals[i], goal_headings[i], kRadius)
+        };
+        REQUIRE(dubins_path.valid());
+        REQUIRE(reeds_shepp_path.valid());
+        CHECK_EQ(dubins_lengths[i], doctest::Approx(dubins_path.length()));
+        CHECK_EQ(reeds_shepp_lengths[i], doctest::Approx(reeds_shepp_path.length()));
+        CHECK_LE(reeds_shepp_path.length(), dubins_path.length() + kEpsilon);
+        CHECK_GE(reeds_shepp_path.length(), starts[i].euclideanTo(goals[i]) - kEpsilon);
+
+        const PiecewiseArcCurve2d dubins_curve{dubins_path, starts[i], start_headings[i]};
+        const PiecewiseArcCurve2d reeds_shepp_curve{
+            reeds_shepp_path, starts[i], start_headings[i]
+        };
+        for (const PiecewiseArcCurve2d* curve : {&dubins_curve, &reeds_shepp_curve}) {
+            CHECK_EQ(curve->back().x, doctest::Approx(goals[i].x).epsilon(1E-6));
+            CHECK_EQ(curve->back().y, doctest::Approx(goals[i].y).epsilon(1E-6));
+            const double heading_error{std::remainder(
+                curve->heading(curve->maxS()) - goal_headings[i], 2.0 * std::numbers::pi
+            )};
+            CHECK_EQ(heading_error, doctest::Approx(0.0).epsilon(1E-6));
+            CHECK_LE(std::abs(curve->curvature(curve->maxS() * 0.5)), 1.0 / kRadius + kEpsilon);
+        }
+        CHECK_EQ(dubins_curve.maxS(), doctest::Approx(dubins_path.length()));
+        CHECK_EQ(reeds_shepp_curve.maxS(), doctest::Approx(reeds_shepp_path.length()));
+
+        const double s{reeds_shepp_curve.maxS() * 0.3};
+        const ReedsSheppStated state{
+            reedsSheppState(reeds_shepp_path, starts[i], start_headings[i], s)
+        };
+        CHECK_EQ(reeds_shepp_curve.eval(s).x, doctest::Approx(state.position.x));
+        CHECK_EQ(reeds_shepp_curve.eval(s).y, doctest::Approx(state.position.y));
+        CHECK_EQ(reeds_shepp_curve.forward(s), state.forward);
+    }
+}
+
+TEST_CASE("Polymorphism") {
+    const DubinsPathd path{dubinsPath(Vec2d{0.0, 0.0}, 0.0, Vec2d{6.0, 4.0}, 1.0, kRadius)};
+    const Curve2Proxy<Vec2d> curve{
+        makeCurve2Proxy(PiecewiseArcCurve2d{path, Vec2d{0.0, 0.0}, 0.0})
+    };
+    CHECK_EQ(curve->maxS(), doctest::Approx(path.length()));
+    const std::vector<double>& arc_lengths{curve->arcLengths()};
+    for (std::size_t i{1}; i < arc_lengths.size(); ++i) {
+        const double s{(arc_lengths[i - 1] + arc_lengths[i]) * 0.5};
+        const Vec2d point{curve->eval(s) + curve->normal(s) * 0.1};
+        const SlDupletd sl{curve->inverse(point)};
+        CHECK_EQ(sl.s, doctest::Approx(s));
+        CHECK_EQ(sl.l, doctest::Approx(0.1));
+    }
+}
+
+} // namespace boyle::math
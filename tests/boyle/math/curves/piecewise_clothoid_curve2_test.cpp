@@ -0,0 +1,170 @@
+/**
+ * @file piecewise_clothoid_curve2_test.cpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2024-06-23
+ *
+ * @copyright Copyright (c) 2024 Boyle Development Team
+ *            All rights reserved.
+ *
+ */
+
+#include "boyle/math/curves/piecewise_clothoid_curve.hpp"
+
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <random>
+#include <vector>
+
+#include "boyle/math/curves/curve2_proxy.hpp"
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+namespace boyle::math {
+
+TEST_CASE("Fresnel") {
+    const auto [c1, s1] = fresnel(1.0);
+    CHECK_EQ(c1, doctest::Approx(0.7798934003768228).epsilon(1E-14));
+    CHECK_EQ(s1, doctest::Approx(0.4382591473903548).epsilon(1E-14));
+    const auto [c3, s3] = fresnel(-3.0);
+    CHECK_EQ(c3, doctest::Approx(-0.6057207892976856).epsilon(1E-14));
+    CHECK_EQ(s3, doctest::Approx(-0.4963129989673750).epsilon(1E-14));
+    const auto [c_inf, s_inf] = fresnel(1E6);
+    CHECK_EQ(c_inf, doctest::Approx(0.5).epsilon(1E-6));
+    CHECK_EQ(s_inf, doctest::Approx(0.5).epsilon(1E-6));
+
+    std::mt19937 engine{42};
+    std::uniform_real_distribution<double> dist{-20.0, 20.0};
+    for (int i{0}; i < 1000; ++i) {
+        const double a{dist(engine)};
+        const double b{dist(engine)};
+        const double c{dist(engine)};
+        constexpr int kNumSteps{4000};
+        double x{0.0};
+        double y{0.0};
+        for (int k{0}; k < kNumSteps; ++k) {
+            const double t{(k + 0.5) / kNumSteps};
+            const double phase{a * t * t * 0.5 + b * t + c};
+            x += std::cos(phase) / kNumSteps;
+            y += std::sin(phase) / kNumSteps;
+        }
+        const auto [gx, gy] = generalizedFresnel(a, b, c);
+        CHECK_EQ(gx, doctest::Approx(x).epsilon(1E-4));
+        CHECK_EQ(gy, doctest::Approx(y).epsilon(1E-4));
+    }
+}
+
+TEST_CASE("Segments") {
+    const std::vector<double> start_curvatures{0.0, 0.0, 0.5};
+    const std::vector<double> end_curvatures{0.0, 0.5, 0.5};
+    const std::vector<double> lengths{2.0, 1.0, std::numbers::pi};
+    const PiecewiseClothoidCurve2d curve{
+        Vec2d{1.0, 1.0}, 0.0, start_curvatures, end_curvatures, lengths
+    };
+    CHECK_EQ(curve.maxS(), doctest::Approx(3.0 + std::numbers::pi));
+    CHECK_EQ(curve.eval(1.5).x, doctest::Approx(2.5));
+    CHECK_EQ(curve.eval(1.5).y, doctest::Approx(1.0));
+    CHECK_EQ(curve.curvature(2.5), doctest::Approx(0.25));
+    CHECK_EQ(curve.heading(3.0), doctest::Approx(0.25));
+    CHECK_EQ(curve.heading(curve.maxS()), doctest::Approx(0.25 + std::numbers::pi * 0.5));
+    CHECK_EQ(curve.curvature(4.0), doctest::Approx(0.5));
+
+    const Vec2d center{curve.eval(3.0) + curve.normal(3.0) * 2.0};
+    for (double s{3.0}; s < curve.maxS(); s += 0.1) {
+        CHECK_EQ(curve.eval(s).euclideanTo(center), doctest::Approx(2.0));
+    }
+
+    const double s{3.5};
+    const Vec2d point{curve.eval(s, -0.3)};
+    const SlDupletd sl{curve.inverse(point)};
+    CHECK_EQ(sl.s, doctest::Approx(s));
+    CHECK_EQ(sl.l, doctest::Approx(-0.3));
+}
+
+TEST_CASE("HermiteG1") {
+    std::mt19937 engine{7};
+    std::uniform_real_distribution<double> position{-10.0, 10.0};
+    std::uniform_real_distribution<double> angle{-std::numbers::pi * 0.45, std::numbers::pi * 0.45};
+    for (int i{0}; i < 200; ++i) {
+        const std::vector<Vec2d> anchor_points{
+            Vec2d{0.0, 0.0}, Vec2d{position(engine) + 15.0, position(engine)},
+            Vec2d{position(engine) + 35.0, position(engine)}
+        };
+        std::vector<double> headings(anchor_points.size());
+        for (std::size_t j{0}; j < anchor_points.size(); ++j) {
+            headings[j] = angle(engine);
+        }
+        const PiecewiseClothoidCurve2d curve{anchor_points, headings};
+        const std::vector<double>& arc_lengths{curve.arcLengths()};
+        for (std::size_t j{1}; j < anchor_points.size(); ++j) {
+            const double s{arc_lengths[j] - 1E-9};
+            CHECK_EQ(curve.eval(s).x, doctest::Approx(anchor_points[j].x).epsilon(1E-6));
+            CHECK_EQ(curve.eval(s).y, doctest::Approx(anchor_points[j].y).epsilon(1E-6));
+            const double heading_error{
+                std::remainder(curve.heading(s) - headings[j], 2.0 * std::numbers::pi)
+            };
+            CHECK_EQ(heading_error, doctest::Approx(0.0).epsilon(1E-6));
+        }
+    }
+
+    const PiecewiseClothoidCurve2d line{
+        std::vector<Vec2d>{Vec2d{0.0, 0.0}, Vec2d{3.0, 4.0}},
+        std::vector<double>{std::atan2(4.0, 3.0), std::atan2(4.0, 3.0)}
+    };
+    CHECK_EQ(line.maxS(), doctest::Approx(5.0));
+    CHECK_EQ(line.curvature(2.0), doctest::Approx(0.0));
+
+    const PiecewiseClothoidCurve2d arc{
+        std::vector<Vec2d>{Vec2d{1.0, 0.0}, Vec2d{0.0, 1.0}},
+        std::vector<double>{std::numbers::pi * 0.5, std::numbers::pi}
+    };
+    CHECK_EQ(arc.maxS(), doctest::Approx(std::numbers::pi * 0.5));
+    CHECK_EQ(arc.curvature(0.3), doctest::Approx(1.0));
+    CHECK_EQ(arc.eval(0.3).euclidean(), doctest::Approx(1.0));
+}
+
+TEST_CASE("SplineG2") {
+    std::vector<Vec2d> anchor_points;
+    for (int i{0}; i < 12; ++i) {
+        const double theta{i * 0.25};
+        anchor_points.emplace_back(10.0 * theta, 4.0 * std::sin(theta));
+    }
+    const PiecewiseClothoidCurve2d curve{
+        anchor_points, 0.3, std::numeric_limits<double>::quiet_NaN()
+    };
+    const std::vector<double>& arc_lengths{curve.arcLengths()};
+    CHECK_EQ(curve.heading(curve.minS()), doctest::Approx(0.3));
+    CHECK_EQ(curve.curvature(curve.maxS()), doctest::Approx(0.0).epsilon(1E-8));
+    for (std::size_t i{1}; i + 1 < arc_lengths.size(); ++i) {
+        const ClothoidSegment<double> prev{curve.segment(i - 1)};
+        const ClothoidSegment<double> next{curve.segment(i)};
+        CHECK_EQ(
+            prev.curvature + prev.sharpness * prev.length,
+            doctest::Approx(next.curvature).epsilon(1E-8)
+        );
+        CHECK_EQ(curve.eval(arc_lengths[i]).x, doctest::Approx(anchor_points[i].x));
+        CHECK_EQ(curve.eval(arc_lengths[i]).y, doctest::Approx(anchor_points[i].y));
+    }
+}
+
+TEST_CASE("Polymorphism") {
+    const std::vector<Vec2d> anchor_points{
+        Vec2d{0.0, 0.0}, Vec2d{5.0, 1.0}, Vec2d{9.0, 4.0}, Vec2d{12.0, 9.0}
+    };
+    const Curve2Proxy<Vec2d> curve{makeCurve2Proxy(PiecewiseClothoidCurve2d{
+        anchor_points, 0.0, std::numeric_limits<double>::quiet_NaN()
+    })};
+    const std::vector<double>& arc_lengths{curve->arcLengths()};
+    for (std::size_t i{1}; i < arc_lengths.size(); ++i) {
+        const double s{(arc_lengths[i - 1] + arc_lengths[i]) * 0.5};
+        const Vec2d point{curve->eval(s) + curve->normal(s) * 0.2};
+        const SlDupletd sl{curve->inverse(point)};
+        CHECK_EQ(sl.s, doctest::Approx(s));
+        CHECK_EQ(sl.l, doctest::Approx(0.2));
+    }
+}
+
+} // namespace boyle::math
@@ -12,7 +12,10 @@
 
 #include "boyle/math/curves/piecewise_cubic_curve.hpp"
 
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <limits>
 
 #include "boost/archive/binary_iarchive.hpp"
 #include "boost/archive/binary_oarchive.hpp"
@@ -500,6 +503,45 @@ TEST_CASE("LissajousCurveTest") {
     }
 }
 
+TEST_CASE("CurvatureWindowTest") {
+    constexpr std::size_t kNumAnchors{101};
+    constexpr double kStart{0.0};
+    constexpr double kEnd{2.0 * M_PI};
+    constexpr double kStep{(kEnd - kStart) / (kNumAnchors - 1)};
+
+    std::vector<Vec2d> anchor_points(kNumAnchors);
+    std::ranges::generate(
+        anchor_points,
+        [t = kStart - kStep, h = kStep]() mutable noexcept -> Vec2d {
+            t += h;
+            return Vec2d{2.0 * std::sin(2.0 * t), 2.0 * std::sin(3.0 * t)};
+        }
+    );
+
+    const PiecewiseCubicCurve2d lissajous_curve{periodic_tag{}, anchor_points};
+    const std::vector<double>& arc_lengths{lissajous_curve.arcLengths()};
+
+    const std::vector<std::array<double, 2>> windows{
+        {-1.0, 100.0}, {0.3, 0.3}, {4.1, 1.2}, {0.5, 0.62}, {arc_lengths[7], arc_lengths[31]}
+    };
+    for (const auto& [s0, s1] : windows) {
+        const double lo{std::clamp(std::min(s0, s1), arc_lengths.front(), arc_lengths.back())};
+        const double hi{std::clamp(std::max(s0, s1), arc_lengths.front(), arc_lengths.back())};
+        double min_kappa{std::numeric_limits<double>::infinity()};
+        double max_kappa{-std::numeric_limits<double>::infinity()};
+        const auto num_samples{static_cast<std::size_t>((hi - lo) * 2000.0) + 2};
+        for (double s : linspace(lo, hi, num_samples)) {
+            s = std::clamp(s, arc_lengths.front() + kEpsilon, arc_lengths.back() - kEpsilon);
+            min_kappa = std::min(min_kappa, lissajous_curve.curvature(s));
+            max_kappa = std::max(max_kappa, lissajous_curve.curvature(s));
+        }
+        CHECK_LE(lissajous_curve.minCurvature(s0, s1), min_kappa + 1E-6);
+        CHECK_GE(lissajous_curve.maxCurvature(s0, s1), max_kappa - 1E-6);
+        CHECK_EQ(lissajous_curve.minCurvature(s0, s1), doctest::Approx(min_kappa).epsilon(1E-3));
+        CHECK_EQ(lissajous_curve.maxCurvature(s0, s1), doctest::Approx(max_kappa).epsilon(1E-3));
+    }
+}
+
 TEST_CASE("Serialization") {
     [[maybe_unused]] const auto exact_lissajous_curve = [](double theta) noexcept -> Vec2d {
         return Vec2d{2.0 * std::sin(2.0 * theta), 2.0 * std::sin(3.0 * theta)};
@@ -12,13 +12,21 @@
 
 #include "boyle/math/curves/piecewise_quintic_curve.hpp"
 
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstddef>
+#include <limits>
+#include <memory_resource>
+#include <utility>
+#include <vector>
 
 #include "boost/archive/binary_iarchive.hpp"
 #include "boost/archive/binary_oarchive.hpp"
 #include "cxxopts.hpp"
 #include "matplot/matplot.h"
 
+#include "boyle/common/utils/monotonic_arena.hpp"
 #include "boyle/math/utils.hpp"
 #include "boyle/math/vec2.hpp"
 
@@ -524,6 +532,86 @@ TEST_CASE("LissajousCurveTest") {
     }
 }
 
+TEST_CASE("ParameterSplineTest") {
+    constexpr std::size_t kNumAnchors{21};
+    constexpr double kStart{0.0};
+    constexpr double kEnd{M_PI};
+    constexpr double kStep{(kEnd - kStart) / (kNumAnchors - 1)};
+
+    std::vector<double> thetas(kNumAnchors);
+    std::vector<Vec2d> anchor_points(kNumAnchors);
+    std::vector<Vec2d> dd_anchor_points(kNumAnchors);
+    std::vector<Vec2d> d4_anchor_points(kNumAnchors);
+    for (std::size_t i{0}; i < kNumAnchors; ++i) {
+        thetas[i] = kStart + kStep * i;
+        anchor_points[i] = Vec2d{2.0 * std::cos(thetas[i]), 2.0 * std::sin(thetas[i])};
+        dd_anchor_points[i] = -anchor_points[i];
+        d4_anchor_points[i] = anchor_points[i];
+    }
+
+    const PiecewiseQuinticCurve2d semi_circle{
+        thetas, anchor_points, dd_anchor_points, d4_anchor_points
+    };
+
+    CHECK_EQ(semi_circle.minS(), 0.0);
+    CHECK_EQ(semi_circle.maxS(), doctest::Approx(2.0 * M_PI).epsilon(1E-7));
+
+    for (std::size_t i{0}; i < kNumAnchors; ++i) {
+        CHECK_EQ(semi_circle.arcLengths()[i], doctest::Approx(thetas[i] * 2.0).epsilon(1E-7));
+        CHECK_EQ(semi_circle.anchorPoints()[i], anchor_points[i]);
+    }
+
+    for (std::size_t i{1}; i < kNumAnchors; ++i) {
+        const double theta{kStart + (i - 0.5) * kStep};
+        const double s{theta * 2.0};
+        const Vec2d tangent{-std::sin(theta), std::cos(theta)};
+        const Vec2d normal{-std::cos(theta), -std::sin(theta)};
+        CHECK(semi_circle(s).approachTo(Vec2d{2.0 * std::cos(theta), 2.0 * std::sin(theta)}, 1E-6));
+        CHECK(semi_circle.tangent(s).approachTo(tangent, 1E-6));
+        CHECK(semi_circle.normal(s).approachTo(normal, 1E-6));
+        CHECK_EQ(semi_circle.curvature(s), doctest::Approx(0.5).epsilon(1E-5));
+    }
+}
+
+TEST_CASE("CurvatureWindowTest") {
+    constexpr std::size_t kNumAnchors{101};
+    constexpr double kStart{0.0};
+    constexpr double kEnd{2.0 * M_PI};
+    constexpr double kStep{(kEnd - kStart) / (kNumAnchors - 1)};
+
+    std::vector<Vec2d> anchor_points(kNumAnchors);
+    std::ranges::generate(
+        anchor_points,
+        [t = kStart - kStep, h = kStep]() mutable noexcept -> Vec2d {
+            t += h;
+            return Vec2d{2.0 * std::sin(2.0 * t), 2.0 * std::sin(3.0 * t)};
+        }
+    );
+
+    const PiecewiseQuinticCurve2d lissajous_curve{periodic_tag{}, anchor_points};
+    const std::vector<double>& arc_lengths{lissajous_curve.arcLengths()};
+
+    const std::vector<std::array<double, 2>> windows{
+        {-1.0, 100.0}, {0.3, 0.3}, {4.1, 1.2}, {0.5, 0.62}, {arc_lengths[7], arc_lengths[31]}
+    };
+    for (const auto& [s0, s1] : windows) {
+        const double lo{std::clamp(std::min(s0, s1), arc_lengths.front(), arc_lengths.back())};
+        const double hi{std::clamp(std::max(s0, s1), arc_lengths.front(), arc_lengths.back())};
+        double min_kappa{std::numeric_limits<double>::infinity()};
+        double max_kappa{-std::numeric_limits<double>::infinity()};
+        const auto num_samples{static_cast<std::size_t>((hi - lo) * 2000.0) + 2};
+        for (double s : linspace(lo, hi, num_samples)) {
+            s = std::clamp(s, arc_lengths.front() + kEpsilon, arc_lengths.back() - kEpsilon);
+            min_kappa = std::min(min_kappa, lissajous_curve.curvature(s));
+            max_kappa = std::max(max_kappa, lissajous_curve.curvature(s));
+        }
+        CHECK_LE(lissajous_curve.minCurvature(s0, s1), min_kappa + 1E-6);
+        CHECK_GE(lissajous_curve.maxCurvature(s0, s1), max_kappa - 1E-6);
+        CHECK_EQ(lissajous_curve.minCurvature(s0, s1), doctest::Approx(min_kappa).epsilon(1E-3));
+        CHECK_EQ(lissajous_curve.maxCurvature(s0, s1), doctest::Approx(max_kappa).epsilon(1E-3));
+    }
+}
+
 TEST_CASE("Serialization") {
     [[maybe_unused]] const auto exact_lissajous_curve = [](double theta) noexcept -> Vec2d {
         return Vec2d{2.0 * std::sin(2.0 * theta), 2.0 * std::sin(3.0 * theta)};
@@ -566,6 +654,22 @@ TEST_CASE("Serialization") {
     }
 }
 
+TEST_CASE("MonotonicArena") {
+    common::MonotonicArena arena{std::size_t{1} << 16};
+    std::pmr::vector<Vec2d> anchor_points(arena.resource());
+    for (const double theta : linspace(0.0, 3.0, 31)) {
+        anchor_points.emplace_back(10.0 * std::cos(theta), 10.0 * std::sin(theta));
+    }
+
+    const pmr::PiecewiseQuinticCurve2d curve{std::move(anchor_points)};
+    const pmr::PiecewiseQuinticCurve2d copy{curve};
+    CHECK_EQ(curve.anchorPoints().get_allocator().resource(), arena.resource());
+    CHECK_EQ(copy.anchorPoints().get_allocator().resource(), arena.resource());
+    CHECK_EQ(copy.arcLengths().get_allocator().resource(), arena.resource());
+    CHECK_EQ(copy(5.0), curve(5.0));
+    CHECK_EQ(arena.overflow(), 0);
+}
+
 } // namespace boyle::math
 
 auto main(int argc, const char* argv[]) -> int {
@@ -0,0 +1,185 @@
+/**
+ * @file dubins_test.cpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2024-06-22
+ *
+ * @copyright Copyright (c) 2024 Boyle Development Team
+ *            All rights reserved.
+ *
+ */
+
+#include "boyle/math/dubins.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <numbers>
+#include <span>
+
+#include "boyle/math/utils.hpp"
+#include "boyle/math/vec2.hpp"
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+namespace boyle::math {
+
+namespace {
+
+constexpr double kTwoPi{2.0 * std::numbers::pi};
+constexpr double kRadius{2.0};
+constexpr double kTolerance{1E-6};
+
+// Turn direction of each segment of a three-segment word: 1 left, -1 right, 0 straight.
+using Word = std::array<int, 3>;
+
+constexpr std::array<Word, 6> kWords{{
+    {1, 0, 1}, {1, 0, -1}, {-1, 0, 1}, {-1, 0, -1}, {1, -1, 1}, {-1, 1, -1}
+}};
+
+/**
+ * @brief Length of the last arc that brings the heading to theta once the first two segments are
+ * driven.
+ */
+auto lastLength(const Word& word, double a, double b, double theta) noexcept -> double {
+    const double heading{word[0] * a + word[1] * b};
+    const double c{word[2] * (theta - heading)};
+    return c - kTwoPi * std::floor(c / kTwoPi);
+}
+
+/**
+ * @brief End point of a word on the unit circle starting at the origin along the x axis.
+ */
+auto endPoint(const Word& word, double a, double b, double theta) noexcept -> Vec2d {
+    const std::array<double, 3> lengths{a, b, lastLength(word, a, b, theta)};
+    Vec2d point{0.0, 0.0};
+    double phi{0.0};
+    for (std::size_t i{0}; i < 3; ++i) {
+        if (word[i] == 0) {
+            point += Vec2d{std::cos(phi), std::sin(phi)} * lengths[i];
+        } else {
+            const Vec2d center{point + Vec2d{-std::sin(phi), std::cos(phi)} * word[i]};
+            phi += word[i] * lengths[i];
+            point = center - Vec2d{-std::sin(phi), std::cos(phi)} * word[i];
+        }
+    }
+    return point;
+}
+
+/**
+ * @brief Shortest unit-radius path to (goal, theta) over the given words, found by Newton's
+ * method on the first two segment lengths from a grid of seeds. Independent of the closed-form
+ * solver it checks.
+ */
+auto bruteForceLength(std::span<const Word> words, Vec2d goal, double theta) noexcept -> double {
+    constexpr std::size_t kNumSeeds{12};
+    constexpr double kStep{1E-7};
+    double best{std::numeric_limits<double>::infinity()};
+    for (const Word& word : words) {
+        const double max_b{word[1] == 0 ? goal.euclidean() + 4.0 : kTwoPi};
+        for (std::size_t i{0}; i < kNumSeeds; ++i) {
+            for (std::size_t j{0}; j < kNumSeeds; ++j) {
+                double a{kTwoPi * (static_cast<double>(i) + 0.5) / kNumSeeds};
+                double b{max_b * (static_cast<double>(j) + 0.5) / kNumSeeds};
+                bool converged{false};
+                for (int iter{0}; iter < 50 && !converged; ++iter) {
+                    const Vec2d r{endPoint(word, a, b, theta) - goal};
+                    if (r.euclidean() < 1E-11) {
+                        converged = true;
+                        break;
+                    }
+                    const Vec2d ra{(endPoint(word, a + kStep, b, theta) -
+                                    endPoint(word, a - kStep, b, theta)) /
+                                   (2.0 * kStep)};
+                    const Vec2d rb{(endPoint(word, a, b + kStep, theta) -
+                                    endPoint(word, a, b - kStep, theta)) /
+                                   (2.0 * kStep)};
+                    const double det{ra.x * rb.y - rb.x * ra.y};
+                    if (std::abs(det) < 1E-12) {
+                        break;
+                    }
+                    a -= (rb.y * r.x - rb.x * r.y) / det;
+                    b -= (ra.x * r.y - ra.y * r.x) / det;
+                }
+                if (!converged || a < -1E-9 || b < -1E-9 || a > kTwoPi ||
+                    (word[1] != 0 && b > kTwoPi)) {
+                    continue;
+                }
+                best = std::min(best, a + b + lastLength(word, a, b, theta));
+            }
+        }
+    }
+    return best;
+}
+
+} // namespace
+
+TEST_CASE("ReachesGoal") {
+    const Vec2d start{1.0, -2.0};
+    const double start_heading{0.3};
+    for (const double x : linspace(-8.0, 8.0, 5)) {
+        for (const double y : linspace(-8.0, 8.0, 5)) {
+            for (const double theta : linspace(-3.0, 3.0, 7)) {
+                const Vec2d goal{start + Vec2d{x, y}};
+                const double goal_heading{start_heading + theta};
+                const DubinsPathd path{
+                    dubinsPath(start, start_heading, goal, goal_heading, kRadius)
+                };
+                REQUIRE(path.valid());
+                const auto [position, heading] =
+                    dubinsState(path, start, start_heading, path.length());
+                CHECK_EQ(position.x, doctest::Approx(goal.x).epsilon(kTolerance));
+                CHECK_EQ(position.y, doctest::Approx(goal.y).epsilon(kTolerance));
+                CHECK_EQ(
+                    std::remainder(heading - goal_heading, kTwoPi),
+                    doctest::Approx(0.0).epsilon(kTolerance)
+                );
+            }
+        }
+    }
+}
+
+TEST_CASE("OptimalAgainstBruteForce") {
+    const Vec2d start{1.0, -2.0};
+    const double start_heading{0.3};
+    for (const double x : linspace(-8.0, 8.0, 5)) {
+        for (const double y : linspace(-8.0, 8.0, 5)) {
+            for (const double theta : linspace(-3.0, 3.0, 7)) {
+                const Vec2d offset{x, y};
+                const DubinsPathd path{dubinsPath(
+                    start, start_heading, start + offset, start_heading + theta, kRadius
+                )};
+                const double brute_force{
+                    bruteForceLength(kWords, offset.rotate(-start_heading) / kRadius, theta) *
+                    kRadius
+                };
+                CHECK_LE(path.length(), brute_force + kTolerance);
+                CHECK_EQ(path.length(), doctest::Approx(brute_force).epsilon(kTolerance));
+            }
+        }
+    }
+}
+
+TEST_CASE("Symmetry") {
+    const Vec2d start{0.0, 0.0};
+    for (const double x : linspace(-8.0, 8.0, 5)) {
+        for (const double y : linspace(-8.0, 8.0, 5)) {
+            for (const double theta : linspace(-3.0, 3.0, 7)) {
+                const DubinsPathd path{dubinsPath(start, 0.0, Vec2d{x, y}, theta, kRadius)};
+                const DubinsPathd mirror{dubinsPath(start, 0.0, Vec2d{x, -y}, -theta, kRadius)};
+                CHECK_EQ(mirror.length(), doctest::Approx(path.length()).epsilon(kTolerance));
+
+                const DubinsPathd reverse{dubinsPath(
+                    Vec2d{x, y}, theta + std::numbers::pi, start, std::numbers::pi, kRadius
+                )};
+                CHECK_EQ(reverse.length(), doctest::Approx(path.length()).epsilon(kTolerance));
+            }
+        }
+    }
+}
+
+} // namespace boyle::math
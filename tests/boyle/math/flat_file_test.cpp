@@ -0,0 +1,187 @@
+/**
+ * @file flat_file_test.cpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2025-02-24
+ *
+ * @copyright Copyright (c) 2025 Boyle Development Team.
+ *            All rights reserved.
+ *
+ */
+
+#include "boyle/math/flat_file.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "boyle/math/curves/piecewise_quintic_curve.hpp"
+#include "boyle/math/functions/piecewise_cubic_function1.hpp"
+#include "boyle/math/functions/piecewise_linear_function1.hpp"
+#include "boyle/math/functions/piecewise_quintic_function1.hpp"
+#include "boyle/math/utils.hpp"
+#include "boyle/math/vec2.hpp"
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+namespace boyle::math {
+
+namespace {
+
+auto asBytes(const std::string& buffer) noexcept -> std::span<const std::byte> {
+    return std::span<const std::byte>{
+        reinterpret_cast<const std::byte*>(buffer.data()), buffer.size()
+    };
+}
+
+} // namespace
+
+TEST_CASE("MappedQuinticFunction") {
+    const std::vector<double> ts{linspace(0.0, 10.0, 41)};
+    std::vector<double> ys;
+    ys.reserve(ts.size());
+    for (const double t : ts) {
+        ys.push_back(std::sin(t) + 0.1 * t * t);
+    }
+    const PiecewiseQuinticFunction1d function{ts, ys};
+
+    const std::filesystem::path file_path{
+        std::filesystem::temp_directory_path() / "boyle_flat_file_test.bin"
+    };
+    {
+        std::ofstream ofs{file_path, std::ios::binary | std::ios::trunc};
+        FlatWriter writer{ofs};
+        function.writeFlat(writer);
+        CHECK_EQ(writer.bytesWritten() % kFlatAlignment, 0);
+    }
+
+    {
+        const MappedFile mapped_file{file_path.string()};
+        FlatReader reader{mapped_file.bytes()};
+        REQUIRE_FALSE(reader.done());
+        const FlatRecord record{reader.next()};
+        CHECK(reader.done());
+        CHECK_EQ(record.kind(), FlatKind::PIECEWISE_QUINTIC_FUNCTION1);
+
+        const view::PiecewiseQuinticFunction1d view{
+            view::PiecewiseQuinticFunction1d::fromFlat(record)
+        };
+        const std::byte* const first{mapped_file.bytes().data()};
+        const std::byte* const last{first + mapped_file.bytes().size()};
+        const auto* const data{reinterpret_cast<const std::byte*>(view.ts().data())};
+        CHECK((data >= first && data < last));
+        CHECK_EQ(reinterpret_cast<std::uintptr_t>(view.ddys().data()) % kFlatAlignment, 0);
+
+        const PiecewiseQuinticFunction1d copy{PiecewiseQuinticFunction1d::fromFlat(record)};
+        for (const double t : linspace(-1.0, 11.0, 97)) {
+            CHECK_EQ(view(t), function(t));
+            CHECK_EQ(view.derivative(t), function.derivative(t));
+            CHECK_EQ(view.derivative(t, 3), function.derivative(t, 3));
+            CHECK_EQ(copy(t), function(t));
+        }
+        CHECK_EQ(view.integral(0.5, 9.5), function.integral(0.5, 9.5));
+    }
+    std::filesystem::remove(file_path);
+}
+
+TEST_CASE("MultipleRecords") {
+    const PiecewiseLinearFunction1d linear{
+        std::vector<double>{0.0, 1.0, 2.0, 4.0}, std::vector<double>{1.0, 3.0, 2.0, 0.0}
+    };
+    std::vector<Vec2d> anchor_points;
+    for (const double theta : linspace(0.0, 3.0, 31)) {
+        anchor_points.emplace_back(10.0 * std::cos(theta), 10.0 * std::sin(theta));
+    }
+    const PiecewiseQuinticCurve2d curve{anchor_points};
+
+    std::ostringstream oss;
+    FlatWriter writer{oss};
+    linear.writeFlat(writer);
+    curve.writeFlat(writer);
+    const std::string buffer{oss.str()};
+    CHECK_EQ(buffer.size(), writer.bytesWritten());
+
+    FlatReader reader{asBytes(buffer)};
+    const FlatRecord first{reader.next()};
+    const FlatRecord second{reader.next()};
+    CHECK(reader.done());
+
+    CHECK_THROWS_AS(view::PiecewiseQuinticCurve2d::fromFlat(first), std::runtime_error);
+    const view::PiecewiseLinearFunction1d linear_view{
+        view::PiecewiseLinearFunction1d::fromFlat(first)
+    };
+    const view::PiecewiseQuinticCurve2d curve_view{view::PiecewiseQuinticCurve2d::fromFlat(second)};
+    for (const double t : linspace(0.0, 4.0, 17)) {
+        CHECK_EQ(linear_view(t), linear(t));
+    }
+    for (const double s : linspace(curve.minS(), curve.maxS(), 57)) {
+        CHECK_EQ(curve_view(s), curve(s));
+        CHECK_EQ(curve_view(s, 1.5), curve(s, 1.5));
+        CHECK_EQ(curve_view.curvature(s), curve.curvature(s));
+    }
+    const Vec2d point{3.0, 4.0};
+    CHECK_EQ(curve_view.inverse(point).s, curve.inverse(point).s);
+}
+
+TEST_CASE("CorruptedInput") {
+    const PiecewiseLinearFunction1d linear{
+        std::vector<double>{0.0, 1.0, 2.0}, std::vector<double>{1.0, 3.0, 2.0}
+    };
+    std::ostringstream oss;
+    FlatWriter writer{oss};
+    linear.writeFlat(writer);
+    std::string buffer{oss.str()};
+
+    FlatReader truncated{asBytes(buffer).first(buffer.size() - kFlatAlignment)};
+    CHECK_THROWS_AS(truncated.next(), std::runtime_error);
+
+    buffer[0] = 'X';
+    FlatReader bad_magic{asBytes(buffer)};
+    CHECK_THROWS_AS(bad_magic.next(), std::runtime_error);
+}
+
+TEST_CASE("MalformedKnots") {
+    const std::vector<double> ts{0.0, 1.0, 2.0, 3.0};
+    const std::vector<double> unsorted_ts{0.0, 2.0, 1.0, 3.0};
+    const std::vector<double> duplicated_ts{0.0, 1.0, 1.0, 3.0};
+    const std::vector<double> ys{1.0, 3.0, 2.0, 0.0};
+    const std::vector<double> short_ys{1.0, 3.0, 2.0};
+    const std::vector<Vec2d> points{{0.0, 0.0}, {1.0, 0.0}, {2.0, 0.0}};
+
+    std::ostringstream oss;
+    FlatWriter writer{oss};
+    writer.write(FlatKind::PIECEWISE_LINEAR_FUNCTION1, ts, short_ys);
+    writer.write(FlatKind::PIECEWISE_LINEAR_FUNCTION1, unsorted_ts, ys);
+    writer.write(FlatKind::PIECEWISE_LINEAR_FUNCTION1, duplicated_ts, ys);
+    writer.write(
+        FlatKind::PIECEWISE_LINEAR_FUNCTION1, std::span{ts}.first(1), std::span{ys}.first(1)
+    );
+    writer.write(FlatKind::PIECEWISE_CUBIC_FUNCTION1, ts, ys, short_ys);
+    writer.write(FlatKind::PIECEWISE_QUINTIC_FUNCTION1, ts, ys, ys, short_ys);
+    writer.write(FlatKind::PIECEWISE_QUINTIC_CURVE, unsorted_ts, ys, ys, ys);
+    writer.write(FlatKind::PIECEWISE_QUINTIC_CURVE, ts, points, points, points);
+    const std::string buffer{oss.str()};
+
+    FlatReader reader{asBytes(buffer)};
+    for (int i{0}; i < 4; ++i) {
+        const FlatRecord record{reader.next()};
+        CHECK_THROWS_AS(PiecewiseLinearFunction1d::fromFlat(record), std::runtime_error);
+        CHECK_THROWS_AS(view::PiecewiseLinearFunction1d::fromFlat(record), std::runtime_error);
+    }
+    CHECK_THROWS_AS(PiecewiseCubicFunction1d::fromFlat(reader.next()), std::runtime_error);
+    CHECK_THROWS_AS(PiecewiseQuinticFunction1d::fromFlat(reader.next()), std::runtime_error);
+    CHECK_THROWS_AS(PiecewiseQuinticCurve2d::fromFlat(reader.next()), std::runtime_error);
+    CHECK_THROWS_AS(view::PiecewiseQuinticCurve2d::fromFlat(reader.next()), std::runtime_error);
+    CHECK(reader.done());
+}
+
+} // namespace boyle::math
@@ -0,0 +1,105 @@
+/**
+ * @file fixed_piecewise_cubic_function1_test.cpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2025-03-12
+ *
+ * @copyright Copyright (c) 2025 Boyle Development Team.
+ *            All rights reserved.
+ *
+ */
+
+#include "boyle/math/functions/fixed_piecewise_cubic_function1.hpp"
+
+#include <array>
+#include <vector>
+
+#include "boyle/math/functions/piecewise_cubic_function1.hpp"
+#include "boyle/math/utils.hpp"
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+namespace boyle::math {
+
+namespace {
+
+constexpr std::array<double, 6> kTs{0.0, 0.5, 1.5, 2.0, 3.5, 4.0};
+constexpr std::array<double, 6> kYs{0.0, 0.4, 1.2, 1.5, 1.1, 0.7};
+
+constexpr FixedPiecewiseCubicFunction1d<6> kSteeringRatio{kTs, kYs};
+
+// Second derivatives of the natural spline through (0, 0), (1, 1), (2, 0), solved by hand.
+constexpr FixedPiecewiseCubicFunction1d<3> kArch{
+    std::array<double, 3>{0.0, 1.0, 2.0}, std::array<double, 3>{0.0, 1.0, 0.0}
+};
+
+} // namespace
+
+static_assert(kArch.ddys()[0] == 0.0 && kArch.ddys()[1] == -3.0 && kArch.ddys()[2] == 0.0);
+static_assert(kArch(1.0) == 1.0);
+static_assert(kArch(0.5) == 0.6875);
+static_assert(kArch.derivative(1.0) == 0.0);
+static_assert(kArch.derivative(1.5, 2) == -1.5);
+static_assert(kSteeringRatio(kTs[3]) == kYs[3]);
+
+TEST_CASE("ConsistentWithDynamic") {
+    const std::vector<double> ts{kTs.cbegin(), kTs.cend()};
+    const std::vector<double> ys{kYs.cbegin(), kYs.cend()};
+
+    SUBCASE("Natural") {
+        const PiecewiseCubicFunction1d dynamic_func{ts, ys};
+        for (std::size_t i{0}; i < kTs.size(); ++i) {
+            CHECK_EQ(
+                kSteeringRatio.ddys()[i], doctest::Approx(dynamic_func.ddys()[i]).epsilon(kEpsilon)
+            );
+        }
+        for (double t : linspace(-1.0, 5.0, 121)) {
+            CHECK_EQ(kSteeringRatio(t), doctest::Approx(dynamic_func(t)).epsilon(kEpsilon));
+            CHECK_EQ(
+                kSteeringRatio.derivative(t),
+                doctest::Approx(dynamic_func.derivative(t)).epsilon(kEpsilon)
+            );
+            CHECK_EQ(
+                kSteeringRatio.integral(-0.5, t),
+                doctest::Approx(dynamic_func.integral(-0.5, t)).epsilon(kEpsilon)
+            );
+        }
+    }
+
+    SUBCASE("Clamped") {
+        using DynamicBoundaryMode = PiecewiseCubicFunction1d::BoundaryMode;
+        using FixedBoundaryMode = FixedPiecewiseCubicFunction1d<6>::BoundaryMode;
+        const PiecewiseCubicFunction1d dynamic_func{
+            ts, ys, DynamicBoundaryMode{1, 0.8}, DynamicBoundaryMode{2, 0.3}
+        };
+        const FixedPiecewiseCubicFunction1d<6> fixed_func{
+            kTs, kYs, FixedBoundaryMode{1, 0.8}, FixedBoundaryMode{2, 0.3}
+        };
+        CHECK_EQ(fixed_func.derivative(0.0), doctest::Approx(0.8).epsilon(kEpsilon));
+        CHECK_EQ(fixed_func.derivative(4.0, 2), doctest::Approx(0.3).epsilon(kEpsilon));
+        for (double t : linspace(-1.0, 5.0, 121)) {
+            CHECK_EQ(fixed_func(t), doctest::Approx(dynamic_func(t)).epsilon(kEpsilon));
+            CHECK_EQ(
+                fixed_func.derivative(t, 2),
+                doctest::Approx(dynamic_func.derivative(t, 2)).epsilon(kEpsilon)
+            );
+            CHECK_EQ(
+                fixed_func.derivative(t, 3),
+                doctest::Approx(dynamic_func.derivative(t, 3)).epsilon(kEpsilon)
+            );
+        }
+    }
+}
+
+TEST_CASE("AdoptDerivatives") {
+    const FixedPiecewiseCubicFunction1d<6> adopted{
+        kSteeringRatio.ts(), kSteeringRatio.ys(), kSteeringRatio.ddys()
+    };
+    for (double t : linspace(-1.0, 5.0, 61)) {
+        CHECK_EQ(adopted(t), kSteeringRatio(t));
+    }
+}
+
+} // namespace boyle::math
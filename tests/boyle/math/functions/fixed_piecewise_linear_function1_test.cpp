@@ -0,0 +1,72 @@
+/**
+ * @file fixed_piecewise_linear_function1_test.cpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2025-03-12
+ *
+ * @copyright Copyright (c) 2025 Boyle Development Team.
+ *            All rights reserved.
+ *
+ */
+
+#include "boyle/math/functions/fixed_piecewise_linear_function1.hpp"
+
+#include <array>
+#include <vector>
+
+#include "boyle/math/functions/piecewise_linear_function1.hpp"
+#include "boyle/math/utils.hpp"
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+namespace boyle::math {
+
+namespace {
+
+constexpr FixedPiecewiseLinearFunction1d<4> kThrottleMap{
+    std::array<double, 4>{0.0, 10.0, 20.0, 40.0}, std::array<double, 4>{0.0, 0.2, 0.5, 1.0}
+};
+
+} // namespace
+
+static_assert(kThrottleMap(0.0) == 0.0);
+static_assert(kThrottleMap(15.0) == 0.35);
+static_assert(kThrottleMap(40.0) == 1.0);
+static_assert(kThrottleMap(50.0) == 1.25);
+static_assert(kThrottleMap.derivative(-5.0) == 0.02);
+static_assert(kThrottleMap.integral(0.0, 10.0) == 1.0);
+static_assert(kThrottleMap.minT() == 0.0 && kThrottleMap.maxT() == 40.0);
+
+TEST_CASE("ConsistentWithDynamic") {
+    const std::vector<double> ts{kThrottleMap.ts().cbegin(), kThrottleMap.ts().cend()};
+    const std::vector<double> ys{kThrottleMap.ys().cbegin(), kThrottleMap.ys().cend()};
+    const PiecewiseLinearFunction1d dynamic_func{ts, ys};
+
+    for (double t : linspace(-10.0, 50.0, 121)) {
+        CHECK_EQ(kThrottleMap.eval(t), dynamic_func.eval(t));
+        CHECK_EQ(kThrottleMap.derivative(t), dynamic_func.derivative(t));
+        CHECK_EQ(kThrottleMap.integral(-3.0, t), dynamic_func.integral(-3.0, t));
+    }
+}
+
+TEST_CASE("StackConstruction") {
+    std::array<double, 3> ts{1.0, 2.0, 4.0};
+    std::array<double, 3> ys{3.0, 1.0, 2.0};
+    const FixedPiecewiseLinearFunction1d<3> func{ts, ys};
+
+    CHECK_EQ(func(1.5), doctest::Approx(2.0).epsilon(kEpsilon));
+    CHECK_EQ(func(3.0), doctest::Approx(1.5).epsilon(kEpsilon));
+    CHECK_EQ(func.integral(1.0, 4.0), doctest::Approx(5.0).epsilon(kEpsilon));
+    CHECK_EQ(func.integral(4.0, 1.0), doctest::Approx(-5.0).epsilon(kEpsilon));
+
+#if BOYLE_CHECK_PARAMS == 1
+    ts = {1.0, 4.0, 2.0};
+    CHECK_THROWS_AS(FixedPiecewiseLinearFunction1d<3>(ts, ys), std::invalid_argument);
+    ts = {1.0, 2.0, 2.0};
+    CHECK_THROWS_AS(FixedPiecewiseLinearFunction1d<3>(ts, ys), std::invalid_argument);
+#endif
+}
+
+} // namespace boyle::math
@@ -12,8 +12,11 @@
 
 #include "boyle/math/functions/function1_proxy.hpp"
 
+#include <array>
 #include <vector>
 
+#include "boyle/math/functions/fixed_piecewise_cubic_function1.hpp"
+#include "boyle/math/functions/fixed_piecewise_linear_function1.hpp"
 #include "boyle/math/functions/piecewise_cubic_function1.hpp"
 #include "boyle/math/functions/piecewise_linear_function1.hpp"
 #include "boyle/math/functions/piecewise_quintic_function1.hpp"
@@ -84,4 +87,23 @@ TEST_CASE("Polymorphism") {
     }
 }
 
+TEST_CASE("FixedCapacity") {
+    constexpr std::array<double, 5> kTs{0.0, 10.0, 20.0, 30.0, 40.0};
+    constexpr std::array<double, 5> kYs{0.0, 0.15, 0.45, 0.8, 1.0};
+    constexpr FixedPiecewiseLinearFunction1d<5> kLinearFunc{kTs, kYs};
+    constexpr FixedPiecewiseCubicFunction1d<5> kCubicFunc{kTs, kYs};
+
+    const Function1Proxy<double, double> linear_proxy{makeFunction1Proxy(kLinearFunc)};
+    const Function1Proxy<double, double> cubic_proxy{makeFunction1Proxy(kCubicFunc)};
+
+    CHECK_EQ(linear_proxy->minT(), kLinearFunc.minT());
+    CHECK_EQ(cubic_proxy->maxT(), kCubicFunc.maxT());
+    for (double t : linspace(-5.0, 45.0, 51)) {
+        CHECK_EQ(linear_proxy->eval(t), kLinearFunc(t));
+        CHECK_EQ(linear_proxy->derivative(t), kLinearFunc.derivative(t));
+        CHECK_EQ(cubic_proxy->eval(t), kCubicFunc.eval(t));
+        CHECK_EQ(cubic_proxy->integral(0.0, t), kCubicFunc.integral(0.0, t));
+    }
+}
+
 } // namespace boyle::math
@@ -12,13 +12,22 @@
 
 #include "boyle/math/functions/piecewise_linear_function1.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <memory_resource>
 #include <sstream>
+#include <utility>
+#include <vector>
 
 #include "boost/archive/binary_iarchive.hpp"
 #include "boost/archive/binary_oarchive.hpp"
 #include "cxxopts.hpp"
 #include "matplot/matplot.h"
 
+#include "boyle/common/utils/monotonic_arena.hpp"
 #include "boyle/math/utils.hpp"
 #include "boyle/math/vec2.hpp"
 
@@ -192,6 +201,132 @@ TEST_CASE("SineTest") {
     }
 }
 
+TEST_CASE("WindowExtrema") {
+    const auto exact_func = [](double t) noexcept -> double {
+        return 16.43 * std::sin(5.7 * t) - 3.2;
+    };
+
+    const std::vector<double> ts = linspace(-0.12, 2.3, 37);
+    std::vector<double> ys;
+    ys.reserve(ts.size());
+    for (double t : ts) {
+        ys.emplace_back(exact_func(t));
+    }
+
+    const PiecewiseLinearFunction1d func{ts, ys};
+    const PiecewiseLinearFunction1d copied_func{func};
+
+    const std::vector<std::array<double, 2>> windows{
+        {-0.5, 3.0}, {0.31, 0.31}, {1.7, 0.05}, {0.4, 0.52}, {ts[3], ts[9]}, {ts[36], 2.5}
+    };
+    for (const auto& [t0, t1] : windows) {
+        const double lo{std::clamp(std::min(t0, t1), func.minT(), func.maxT())};
+        const double hi{std::clamp(std::max(t0, t1), func.minT(), func.maxT())};
+        std::vector<double> samples = linspace(lo, hi, 4001);
+        for (double t : ts) {
+            if (t >= lo && t <= hi) {
+                samples.push_back(t);
+            }
+        }
+        double min_y{std::numeric_limits<double>::infinity()};
+        double max_y{-std::numeric_limits<double>::infinity()};
+        for (double t : samples) {
+            min_y = std::min(min_y, func(t));
+            max_y = std::max(max_y, func(t));
+        }
+        CHECK_LE(func.minY(t0, t1), min_y + kEpsilon);
+        CHECK_GE(func.maxY(t0, t1), max_y - kEpsilon);
+        CHECK_EQ(func.minY(t0, t1), doctest::Approx(min_y).epsilon(1E-4));
+        CHECK_EQ(func.maxY(t0, t1), doctest::Approx(max_y).epsilon(1E-4));
+        CHECK_EQ(copied_func.minY(t0, t1), func.minY(t0, t1));
+        CHECK_EQ(copied_func.maxY(t0, t1), func.maxY(t0, t1));
+    }
+}
+
+TEST_CASE("PointwiseOperations") {
+    const PiecewiseLinearFunction1d map_limit{
+        std::vector<double>{0.0, 20.0, 50.0, 80.0, 120.0},
+        std::vector<double>{16.7, 16.7, 11.1, 11.1, 22.2}
+    };
+    const PiecewiseLinearFunction1d curvature_limit{
+        std::vector<double>{-10.0, 15.0, 35.0, 42.5, 60.0, 100.0},
+        std::vector<double>{25.0, 25.0, 8.0, 9.5, 20.0, 20.0}
+    };
+
+    const PiecewiseLinearFunction1d lower{min(map_limit, curvature_limit)};
+    const PiecewiseLinearFunction1d upper{max(map_limit, curvature_limit)};
+    const PiecewiseLinearFunction1d sum{map_limit + curvature_limit};
+    const PiecewiseLinearFunction1d scaled{0.9 * map_limit};
+
+    CHECK_EQ(lower.minT(), doctest::Approx(-10.0).epsilon(kEpsilon));
+    CHECK_EQ(lower.maxT(), doctest::Approx(120.0).epsilon(kEpsilon));
+    for (double t : linspace(-20.0, 130.0, 1501)) {
+        CHECK_EQ(
+            lower(t),
+            doctest::Approx(std::min(map_limit(t), curvature_limit(t))).epsilon(kEpsilon)
+        );
+        CHECK_EQ(
+            upper(t),
+            doctest::Approx(std::max(map_limit(t), curvature_limit(t))).epsilon(kEpsilon)
+        );
+        CHECK_EQ(sum(t), doctest::Approx(map_limit(t) + curvature_limit(t)).epsilon(kEpsilon));
+        CHECK_EQ(scaled(t), doctest::Approx(map_limit(t) * 0.9).epsilon(kEpsilon));
+    }
+
+    const PiecewiseLinearFunction1d floor{
+        std::vector<double>{0.0, 120.0}, std::vector<double>{-5.0, -5.0}
+    };
+    const PiecewiseLinearFunction1d envelope{max(map_limit, floor)};
+    CHECK_EQ(envelope.ts().size(), map_limit.ts().size());
+    const PiecewiseLinearFunction1d shifted{map_limit + floor};
+    CHECK_EQ(shifted.ts().size(), map_limit.ts().size());
+}
+
+TEST_CASE("InverseTest") {
+    const auto exact_func = [](double t) noexcept -> double {
+        return 2.5 * t + 0.8 * std::sin(1.9 * t);
+    };
+
+    const std::vector<double> ts = linspace(-1.0, 6.0, 36);
+    std::vector<double> ys;
+    ys.reserve(ts.size());
+    for (double t : ts) {
+        ys.emplace_back(exact_func(t));
+    }
+
+    const PiecewiseLinearFunction1d func{ts, ys};
+    std::vector<double> reversed_ys;
+    for (double y : ys) {
+        reversed_ys.emplace_back(-y);
+    }
+    const PiecewiseLinearFunction1d reversed_func{ts, reversed_ys};
+
+    const std::vector<double> queries = linspace(exact_func(-2.0), exact_func(7.0), 301);
+    std::vector<double> results(queries.size());
+    func.inverse(queries, results);
+    for (std::size_t i{0}; i < queries.size(); ++i) {
+        const double t{func.inverse(queries[i])};
+        CHECK_EQ(func(t), doctest::Approx(queries[i]).epsilon(kEpsilon));
+        CHECK_EQ(results[i], doctest::Approx(t).epsilon(kEpsilon));
+        CHECK_EQ(
+            reversed_func(reversed_func.inverse(-queries[i])),
+            doctest::Approx(-queries[i]).epsilon(kEpsilon)
+        );
+    }
+    for (std::size_t i{0}; i < ts.size(); ++i) {
+        CHECK_EQ(func.inverse(ys[i]), doctest::Approx(ts[i]).epsilon(kEpsilon));
+    }
+}
+
+TEST_CASE("InversePlateau") {
+    const PiecewiseLinearFunction1d func{
+        std::vector<double>{0.0, 1.0, 2.0, 3.0}, std::vector<double>{0.0, 1.0, 1.0, 2.0}
+    };
+    CHECK_EQ(func.inverse(1.0), doctest::Approx(2.0));
+    CHECK_EQ(func.inverse(0.5), doctest::Approx(0.5));
+    CHECK_EQ(func.inverse(1.5), doctest::Approx(2.5));
+}
+
 TEST_CASE("Serialization") {
     constexpr auto exact_func = [](double t) noexcept -> double {
         return 0.45 + 5.3 * t - 1.3 * t * t + 0.65 * t * t * t;
@@ -220,6 +355,26 @@ TEST_CASE("Serialization") {
     }
 }
 
+TEST_CASE("MonotonicArena") {
+    common::MonotonicArena arena{std::size_t{1} << 16};
+    std::pmr::vector<double> ts(arena.resource());
+    std::pmr::vector<double> ys(arena.resource());
+    for (const double t : linspace(0.0, 10.0, 41)) {
+        ts.push_back(t);
+        ys.push_back(std::sin(t));
+    }
+
+    const pmr::PiecewiseLinearFunction1d function{std::move(ts), std::move(ys)};
+    const pmr::PiecewiseLinearFunction1d copy{function};
+    CHECK_EQ(function.get_allocator().resource(), arena.resource());
+    CHECK_EQ(copy.get_allocator().resource(), arena.resource());
+    CHECK_EQ(copy(2.5), function(2.5));
+    const pmr::PiecewiseLinearFunction1d scaled{2.0 * function};
+    CHECK_EQ(scaled.get_allocator().resource(), arena.resource());
+    CHECK_EQ(scaled(2.5), doctest::Approx(function(2.5) * 2.0));
+    CHECK_EQ(arena.overflow(), 0);
+}
+
 } // namespace boyle::math
 
 auto main(int argc, const char* argv[]) -> int {
@@ -12,11 +12,21 @@
 
 #include "boyle/math/functions/piecewise_quintic_function1.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+
 #include "boost/archive/binary_iarchive.hpp"
 #include "boost/archive/binary_oarchive.hpp"
 #include "cxxopts.hpp"
 #include "matplot/matplot.h"
 
+#include "boyle/common/utils/monotonic_arena.hpp"
 #include "boyle/math/utils.hpp"
 
 #define DOCTEST_CONFIG_IMPLEMENT
@@ -332,6 +342,84 @@ TEST_CASE("SineTest") {
     }
 }
 
+TEST_CASE("WindowExtrema") {
+    const auto exact_func = [](double t) noexcept -> double {
+        return 16.43 * std::sin(5.7 * t) - 3.2;
+    };
+
+    const std::vector<double> ts = linspace(-0.12, 2.3, 37);
+    std::vector<double> ys;
+    ys.reserve(ts.size());
+    for (double t : ts) {
+        ys.emplace_back(exact_func(t));
+    }
+
+    const PiecewiseQuinticFunction1d func{ts, ys};
+    const PiecewiseQuinticFunction1d copied_func{func};
+
+    const std::vector<std::array<double, 2>> windows{
+        {-0.5, 3.0}, {0.31, 0.31}, {1.7, 0.05}, {0.4, 0.52}, {ts[3], ts[9]}, {ts[36], 2.5}
+    };
+    for (const auto& [t0, t1] : windows) {
+        const double lo{std::clamp(std::min(t0, t1), func.minT(), func.maxT())};
+        const double hi{std::clamp(std::max(t0, t1), func.minT(), func.maxT())};
+        std::vector<double> samples = linspace(lo, hi, 4001);
+        for (double t : ts) {
+            if (t >= lo && t <= hi) {
+                samples.push_back(t);
+            }
+        }
+        double min_y{std::numeric_limits<double>::infinity()};
+        double max_y{-std::numeric_limits<double>::infinity()};
+        for (double t : samples) {
+            min_y = std::min(min_y, func(t));
+            max_y = std::max(max_y, func(t));
+        }
+        CHECK_LE(func.minY(t0, t1), min_y + kEpsilon);
+        CHECK_GE(func.maxY(t0, t1), max_y - kEpsilon);
+        CHECK_EQ(func.minY(t0, t1), doctest::Approx(min_y).epsilon(1E-4));
+        CHECK_EQ(func.maxY(t0, t1), doctest::Approx(max_y).epsilon(1E-4));
+        CHECK_EQ(copied_func.minY(t0, t1), func.minY(t0, t1));
+        CHECK_EQ(copied_func.maxY(t0, t1), func.maxY(t0, t1));
+    }
+}
+
+TEST_CASE("InverseTest") {
+    const auto exact_func = [](double t) noexcept -> double {
+        return 2.5 * t + 0.8 * std::sin(1.9 * t);
+    };
+
+    const std::vector<double> ts = linspace(-1.0, 6.0, 36);
+    std::vector<double> ys;
+    ys.reserve(ts.size());
+    for (double t : ts) {
+        ys.emplace_back(exact_func(t));
+    }
+
+    const PiecewiseQuinticFunction1d func{ts, ys};
+    std::vector<double> reversed_ys;
+    for (double y : ys) {
+        reversed_ys.emplace_back(-y);
+    }
+    const PiecewiseQuinticFunction1d reversed_func{ts, reversed_ys};
+
+    const std::vector<double> queries = linspace(exact_func(-2.0), exact_func(7.0), 301);
+    std::vector<double> results(queries.size());
+    func.inverse(queries, results);
+    for (std::size_t i{0}; i < queries.size(); ++i) {
+        const double t{func.inverse(queries[i])};
+        CHECK_EQ(func(t), doctest::Approx(queries[i]).epsilon(kEpsilon));
+        CHECK_EQ(results[i], doctest::Approx(t).epsilon(kEpsilon));
+        CHECK_EQ(
+            reversed_func(reversed_func.inverse(-queries[i])),
+            doctest::Approx(-queries[i]).epsilon(kEpsilon)
+        );
+    }
+    for (std::size_t i{0}; i < ts.size(); ++i) {
+        CHECK_EQ(func.inverse(ys[i]), doctest::Approx(ts[i]).epsilon(kEpsilon));
+    }
+}
+
 TEST_CASE("Serialization") {
     constexpr auto exact_func = [](double t) noexcept -> double {
         return 0.45 + 5.3 * t - 1.3 * t * t + 0.65 * t * t * t + 0.075 * t * t * t * t -
@@ -361,6 +449,23 @@ TEST_CASE("Serialization") {
     }
 }
 
+TEST_CASE("MonotonicArena") {
+    common::MonotonicArena arena{std::size_t{1} << 16};
+    std::pmr::vector<double> ts(arena.resource());
+    std::pmr::vector<double> ys(arena.resource());
+    for (const double t : linspace(0.0, 10.0, 41)) {
+        ts.push_back(t);
+        ys.push_back(std::sin(t));
+    }
+
+    const pmr::PiecewiseQuinticFunction1d function{std::move(ts), std::move(ys)};
+    const pmr::PiecewiseQuinticFunction1d copy{function};
+    CHECK_EQ(function.get_allocator().resource(), arena.resource());
+    CHECK_EQ(copy.get_allocator().resource(), arena.resource());
+    CHECK_EQ(copy(2.5), function(2.5));
+    CHECK_EQ(arena.overflow(), 0);
+}
+
 } // namespace boyle::math
 
 auto main(int argc, const char* argv[]) -> int {
@@ -0,0 +1,141 @@
+/**
+ * @file geometry2_test.cpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2024-06-14
+ *
+ * @copyright Copyright (c) 2024 Boyle Development Team
+ *            All rights reserved.
+ *
+ */
+
+#include "boyle/math/geometry2.hpp"
+
+#include <array>
+#include <cmath>
+#include <numbers>
+#include <random>
+#include <vector>
+
+#include "boyle/math/aabb_tree2.hpp"
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+namespace boyle::math {
+
+TEST_CASE("Aabb2") {
+    const std::array<Vec2d, 3> points{Vec2d{1.0, 2.0}, Vec2d{-1.0, 0.5}, Vec2d{3.0, -4.0}};
+    const Aabb2d box{Aabb2d::of(points)};
+    CHECK_EQ(box.lower.x, -1.0);
+    CHECK_EQ(box.lower.y, -4.0);
+    CHECK_EQ(box.upper.x, 3.0);
+    CHECK_EQ(box.upper.y, 2.0);
+    CHECK(box.contains(Vec2d{0.0, 0.0}));
+    CHECK_FALSE(box.contains(Vec2d{3.5, 0.0}));
+    CHECK(box.overlaps(Aabb2d{.lower = {2.5, 1.5}, .upper = {5.0, 5.0}}));
+    CHECK_FALSE(box.overlaps(Aabb2d{.lower = {3.5, 1.5}, .upper = {5.0, 5.0}}));
+    CHECK(box.inflated(1.0).contains(Vec2d{3.5, 0.0}));
+    CHECK_FALSE(Aabb2d::empty().overlaps(box));
+}
+
+TEST_CASE("OrientedBoxVertices") {
+    const std::array<Vec2d, 4> vertices{
+        orientedBoxVertices(Vec2d{1.0, 1.0}, std::numbers::pi / 2.0, 2.0, 1.0)
+    };
+    CHECK_EQ(vertices[0].x, doctest::Approx(2.0));
+    CHECK_EQ(vertices[0].y, doctest::Approx(3.0));
+    CHECK_EQ(vertices[1].x, doctest::Approx(0.0));
+    CHECK_EQ(vertices[1].y, doctest::Approx(3.0));
+    CHECK_EQ(vertices[2].x, doctest::Approx(0.0));
+    CHECK_EQ(vertices[2].y, doctest::Approx(-1.0));
+    for (std::size_t i{0}; i < 4; ++i) {
+        const Vec2d edge{vertices[(i + 1) % 4] - vertices[i]};
+        const Vec2d next_edge{vertices[(i + 2) % 4] - vertices[(i + 1) % 4]};
+        CHECK_GT(edge.crossProj(next_edge), 0.0);
+    }
+}
+
+TEST_CASE("PolygonDistance") {
+    const std::array<Vec2d, 4> square{
+        orientedBoxVertices(Vec2d{0.0, 0.0}, 0.0, 1.0, 1.0)
+    };
+
+    SUBCASE("Separated") {
+        const std::array<Vec2d, 4> other{
+            orientedBoxVertices(Vec2d{4.0, 0.5}, 0.0, 1.0, 1.0)
+        };
+        CHECK_EQ(polygonSeparation<double>(square, other), doctest::Approx(2.0));
+        CHECK_EQ(polygonDistance<double>(square, other), doctest::Approx(2.0));
+    }
+
+    SUBCASE("CornerToCorner") {
+        const std::array<Vec2d, 4> other{
+            orientedBoxVertices(Vec2d{3.0, 3.0}, 0.0, 1.0, 1.0)
+        };
+        CHECK_EQ(polygonSeparation<double>(square, other), doctest::Approx(1.0));
+        CHECK_EQ(polygonDistance<double>(square, other), doctest::Approx(std::sqrt(2.0)));
+    }
+
+    SUBCASE("Rotated") {
+        const std::array<Vec2d, 4> diamond{
+            orientedBoxVertices(Vec2d{3.0, 0.0}, std::numbers::pi / 4.0, 1.0, 1.0)
+        };
+        CHECK_EQ(polygonDistance<double>(square, diamond), doctest::Approx(2.0 - std::sqrt(2.0)));
+    }
+
+    SUBCASE("Overlapping") {
+        const std::array<Vec2d, 4> other{
+            orientedBoxVertices(Vec2d{1.5, 0.0}, 0.0, 1.0, 1.0)
+        };
+        CHECK_EQ(polygonSeparation<double>(square, other), doctest::Approx(-0.5));
+        CHECK_EQ(polygonDistance<double>(square, other), doctest::Approx(-0.5));
+    }
+}
+
+TEST_CASE("PointPolygonDistance") {
+    const std::array<Vec2d, 4> square{
+        orientedBoxVertices(Vec2d{0.0, 0.0}, 0.0, 1.0, 1.0)
+    };
+    CHECK_EQ(pointPolygonDistance<double>(Vec2d{3.0, 0.0}, square), doctest::Approx(2.0));
+    CHECK_EQ(pointPolygonDistance<double>(Vec2d{2.0, 2.0}, square), doctest::Approx(std::sqrt(2.0)));
+    CHECK_EQ(pointPolygonDistance<double>(Vec2d{0.5, 0.0}, square), doctest::Approx(-0.5));
+    CHECK_EQ(pointSegmentDistance(Vec2d{0.5, 1.0}, Vec2d{0.0, 0.0}, Vec2d{1.0, 0.0}), 1.0);
+}
+
+TEST_CASE("AabbTree2") {
+    std::mt19937 gen{42};
+    std::uniform_real_distribution<double> dist{-100.0, 100.0};
+    std::vector<Aabb2d> boxes;
+    for (int i{0}; i < 500; ++i) {
+        const Vec2d center{dist(gen), dist(gen)};
+        boxes.push_back(Aabb2d{.lower = center - Vec2d{1.0}, .upper = center + Vec2d{2.0}});
+    }
+    const AabbTree2d tree{boxes};
+    CHECK_EQ(tree.size(), 500);
+
+    for (int i{0}; i < 50; ++i) {
+        const Vec2d center{dist(gen), dist(gen)};
+        const Aabb2d query{.lower = center, .upper = center + Vec2d{15.0}};
+        std::vector<std::size_t> expected;
+        for (std::size_t j{0}; j < boxes.size(); ++j) {
+            if (boxes[j].overlaps(query)) {
+                expected.push_back(j);
+            }
+        }
+        std::vector<std::size_t> found;
+        tree.query(query, [&found](std::size_t index) noexcept -> void {
+            found.push_back(index);
+        });
+        std::ranges::sort(found);
+        CHECK_EQ(found, expected);
+    }
+
+    const AabbTree2d empty_tree{};
+    std::size_t count{0};
+    empty_tree.query(boxes.front(), [&count](std::size_t) noexcept -> void { ++count; });
+    CHECK_EQ(count, 0);
+}
+
+} // namespace boyle::math
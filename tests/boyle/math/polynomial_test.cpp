@@ -0,0 +1,127 @@
+/**
+ * @file polynomial_test.cpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2025-03-09
+ *
+ * @copyright Copyright (c) 2025 Boyle Development Team.
+ *            All rights reserved.
+ *
+ */
+
+#include "boyle/math/polynomial.hpp"
+
+#include <array>
+#include <cmath>
+
+#include "boyle/math/cubic_interpolation.hpp"
+#include "boyle/math/quintic_interpolation.hpp"
+#include "boyle/math/utils.hpp"
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+namespace boyle::math {
+
+TEST_CASE("Arithmetic") {
+    constexpr std::array<double, 3> lhs{1.0, -2.0, 3.0};
+    constexpr std::array<double, 2> rhs{0.5, 4.0};
+    constexpr std::array<double, 4> product{polymul(lhs, rhs)};
+    constexpr std::array<double, 2> derivative{polyder(lhs)};
+    constexpr std::array<double, 3> reflected{polyreflect(lhs)};
+
+    for (double x : linspace(-3.0, 3.0, 61)) {
+        CHECK_EQ(
+            polyval(product, x),
+            doctest::Approx(polyval(lhs, x) * polyval(rhs, x)).epsilon(kEpsilon)
+        );
+        CHECK_EQ(polyval(derivative, x), doctest::Approx(-2.0 + 6.0 * x).epsilon(kEpsilon));
+        CHECK_EQ(polyval(reflected, x), doctest::Approx(polyval(lhs, 1.0 - x)).epsilon(kEpsilon));
+    }
+}
+
+TEST_CASE("Roots") {
+    // (x + 1.5) (x - 0.25) (x - 0.5) (x - 2)
+    constexpr std::array<double, 5> coeffs{polymul(
+        polymul(std::array<double, 2>{1.5, 1.0}, std::array<double, 2>{-0.25, 1.0}),
+        polymul(std::array<double, 2>{-0.5, 1.0}, std::array<double, 2>{-2.0, 1.0})
+    )};
+
+    const auto roots = polyroots(coeffs, -5.0, 5.0);
+    REQUIRE_EQ(roots.size, 4);
+    CHECK_EQ(roots.values[0], doctest::Approx(-1.5).epsilon(kEpsilon));
+    CHECK_EQ(roots.values[1], doctest::Approx(0.25).epsilon(kEpsilon));
+    CHECK_EQ(roots.values[2], doctest::Approx(0.5).epsilon(kEpsilon));
+    CHECK_EQ(roots.values[3], doctest::Approx(2.0).epsilon(kEpsilon));
+
+    const auto inner_roots = polyroots(coeffs, 0.0, 1.0);
+    REQUIRE_EQ(inner_roots.size, 2);
+    CHECK_EQ(inner_roots.values[0], doctest::Approx(0.25).epsilon(kEpsilon));
+    CHECK_EQ(inner_roots.values[1], doctest::Approx(0.5).epsilon(kEpsilon));
+
+    CHECK_EQ(polyroots(std::array<double, 3>{1.0, 0.0, 1.0}, -5.0, 5.0).size, 0);
+}
+
+TEST_CASE("Extrema") {
+    // x^3 - x has its extrema at +-1/sqrt(3)
+    constexpr std::array<double, 4> coeffs{0.0, -1.0, 0.0, 1.0};
+    const double extremum{2.0 / (3.0 * std::sqrt(3.0))};
+
+    const auto [min_y, max_y] = polyextrema(coeffs, -1.0, 1.0);
+    CHECK_EQ(min_y, doctest::Approx(-extremum).epsilon(kEpsilon));
+    CHECK_EQ(max_y, doctest::Approx(extremum).epsilon(kEpsilon));
+
+    const auto [right_min_y, right_max_y] = polyextrema(coeffs, 0.0, 2.0);
+    CHECK_EQ(right_min_y, doctest::Approx(-extremum).epsilon(kEpsilon));
+    CHECK_EQ(right_max_y, doctest::Approx(6.0).epsilon(kEpsilon));
+}
+
+TEST_CASE("InterpolationPolynomials") {
+    constexpr double start{1.0};
+    constexpr double end{2.5};
+    constexpr double ddstart{-0.7};
+    constexpr double ddend{1.3};
+    constexpr double d4start{0.4};
+    constexpr double d4end{-2.2};
+    constexpr double scale{1.7};
+
+    const std::array<double, 4> cubic{cuberpPoly(start, end, ddstart, ddend, scale)};
+    const std::array<double, 6> quintic{
+        quinerpPoly(start, end, ddstart, ddend, d4start, d4end, scale)
+    };
+    for (double ratio : linspace(0.0, 1.0, 51)) {
+        CHECK_EQ(
+            polyval(cubic, ratio),
+            doctest::Approx(cuberp(start, end, ddstart, ddend, ratio, scale)).epsilon(kEpsilon)
+        );
+        CHECK_EQ(
+            polyval(quintic, ratio),
+            doctest::Approx(quinerp(start, end, ddstart, ddend, d4start, d4end, ratio, scale))
+                .epsilon(kEpsilon)
+        );
+    }
+}
+
+TEST_CASE("CurvatureExtrema") {
+    // The parabola (x, x^2) bends the most at its vertex, with curvature 2.
+    constexpr std::array<double, 3> xs{0.0, 1.0, 0.0};
+    constexpr std::array<double, 3> ys{0.0, 0.0, 1.0};
+
+    const auto [min_kappa, max_kappa] = polycurvatureExtrema(xs, ys, -1.0, 2.0);
+    CHECK_EQ(min_kappa, doctest::Approx(2.0 / std::pow(17.0, 1.5)).epsilon(kEpsilon));
+    CHECK_EQ(max_kappa, doctest::Approx(2.0).epsilon(kEpsilon));
+
+    // The cubic (x, x^3) is straight at its inflection point.
+    constexpr std::array<double, 4> cubic_xs{0.0, 1.0, 0.0, 0.0};
+    constexpr std::array<double, 4> cubic_ys{0.0, 0.0, 0.0, 1.0};
+    const auto [cubic_min_kappa, cubic_max_kappa] =
+        polycurvatureExtrema(cubic_xs, cubic_ys, -1.0, 1.0);
+    const double peak_x{std::pow(45.0, -0.25)};
+    const double peak_slope{3.0 * peak_x * peak_x};
+    const double peak_kappa{6.0 * peak_x / std::pow(1.0 + peak_slope * peak_slope, 1.5)};
+    CHECK_EQ(cubic_min_kappa, doctest::Approx(0.0).epsilon(kEpsilon));
+    CHECK_EQ(cubic_max_kappa, doctest::Approx(peak_kappa).epsilon(kEpsilon));
+}
+
+} // namespace boyle::math
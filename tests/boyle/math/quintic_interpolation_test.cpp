@@ -52,6 +52,11 @@ TEST_CASE("QuinticPolynomial") {
             doctest::Approx(dfunc(lo + scale * ratio)).epsilon(kEpsilon)
         );
     }
+
+    const auto [d4_lo, d4_up] =
+        calcQuinticD4s(start, end, dfunc(lo), dfunc(up), ddstart, ddend, scale);
+    CHECK_EQ(d4_lo, doctest::Approx(d4start).epsilon(kEpsilon));
+    CHECK_EQ(d4_up, doctest::Approx(d4end).epsilon(kEpsilon));
 }
 
 } // namespace boyle::math
@@ -0,0 +1,227 @@
+/**
+ * @file reeds_shepp_test.cpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2024-06-21
+ *
+ * @copyright Copyright (c) 2024 Boyle Development Team
+ *            All rights reserved.
+ *
+ */
+
+#include "boyle/math/reeds_shepp.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <numbers>
+#include <span>
+#include <vector>
+
+#include "boyle/math/dubins.hpp"
+#include "boyle/math/utils.hpp"
+#include "boyle/math/vec2.hpp"
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+namespace boyle::math {
+
+namespace {
+
+constexpr double kTwoPi{2.0 * std::numbers::pi};
+constexpr double kRadius{2.0};
+constexpr double kTolerance{1E-6};
+
+/**
+ * @brief Three-segment word. turns holds 1 for left, -1 for right and 0 for straight; gears holds 1
+ * for forward and -1 for reverse.
+ */
+struct Word final {
+    std::array<int, 3> turns;
+    std::array<int, 3> gears;
+};
+
+/**
+ * @brief CSC and CCC words with every combination of gears, a superset of the forward-only
+ * Dubins words.
+ */
+auto allWords() noexcept -> std::vector<Word> {
+    constexpr std::array<std::array<int, 3>, 6> kTurns{{
+        {1, 0, 1}, {1, 0, -1}, {-1, 0, 1}, {-1, 0, -1}, {1, -1, 1}, {-1, 1, -1}
+    }};
+    std::vector<Word> words;
+    for (const std::array<int, 3>& turns : kTurns) {
+        for (int mask{0}; mask < 8; ++mask) {
+            words.push_back(Word{
+                .turns = turns,
+                .gears = {mask & 1 ? -1 : 1, mask & 2 ? -1 : 1, mask & 4 ? -1 : 1}
+            });
+        }
+    }
+    return words;
+}
+
+/**
+ * @brief Length of the last arc that brings the heading to theta once the first two segments are
+ * driven.
+ */
+auto lastLength(const Word& word, double a, double b, double theta) noexcept -> double {
+    const double heading{word.turns[0] * word.gears[0] * a + word.turns[1] * word.gears[1] * b};
+    const double c{word.turns[2] * word.gears[2] * (theta - heading)};
+    return c - kTwoPi * std::floor(c / kTwoPi);
+}
+
+/**
+ * @brief End point of a word on the unit circle starting at the origin along the x axis.
+ */
+auto endPoint(const Word& word, double a, double b, double theta) noexcept -> Vec2d {
+    const std::array<double, 3> lengths{a, b, lastLength(word, a, b, theta)};
+    Vec2d point{0.0, 0.0};
+    double phi{0.0};
+    for (std::size_t i{0}; i < 3; ++i) {
+        const double v{word.gears[i] * lengths[i]};
+        if (word.turns[i] == 0) {
+            point += Vec2d{std::cos(phi), std::sin(phi)} * v;
+        } else {
+            const Vec2d center{point + Vec2d{-std::sin(phi), std::cos(phi)} * word.turns[i]};
+            phi += word.turns[i] * v;
+            point = center - Vec2d{-std::sin(phi), std::cos(phi)} * word.turns[i];
+        }
+    }
+    return point;
+}
+
+/**
+ * @brief Shortest unit-radius path to (goal, theta) over the given words, found by Newton's
+ * method on the first two segment lengths from a grid of seeds. Independent of the closed-form
+ * solver it checks.
+ */
+auto bruteForceLength(std::span<const Word> words, Vec2d goal, double theta) noexcept -> double {
+    constexpr std::size_t kNumSeeds{8};
+    constexpr double kStep{1E-7};
+    double best{std::numeric_limits<double>::infinity()};
+    for (const Word& word : words) {
+        const double max_b{word.turns[1] == 0 ? goal.euclidean() + 4.0 : kTwoPi};
+        for (std::size_t i{0}; i < kNumSeeds; ++i) {
+            for (std::size_t j{0}; j < kNumSeeds; ++j) {
+                double a{kTwoPi * (static_cast<double>(i) + 0.5) / kNumSeeds};
+                double b{max_b * (static_cast<double>(j) + 0.5) / kNumSeeds};
+                bool converged{false};
+                for (int iter{0}; iter < 50 && !converged; ++iter) {
+                    const Vec2d r{endPoint(word, a, b, theta) - goal};
+                    if (r.euclidean() < 1E-11) {
+                        converged = true;
+                        break;
+                    }
+                    const Vec2d ra{(endPoint(word, a + kStep, b, theta) -
+                                    endPoint(word, a - kStep, b, theta)) /
+                                   (2.0 * kStep)};
+                    const Vec2d rb{(endPoint(word, a, b + kStep, theta) -
+                                    endPoint(word, a, b - kStep, theta)) /
+                                   (2.0 * kStep)};
+                    const double det{ra.x * rb.y - rb.x * ra.y};
+                    if (std::abs(det) < 1E-12) {
+                        break;
+                    }
+                    a -= (rb.y * r.x - rb.x * r.y) / det;
+                    b -= (ra.x * r.y - ra.y * r.x) / det;
+                }
+                if (!converged || a < -1E-9 || b < -1E-9 || a > kTwoPi ||
+                    (word.turns[1] != 0 && b > kTwoPi)) {
+                    continue;
+                }
+                best = std::min(best, a + b + lastLength(word, a, b, theta));
+            }
+        }
+    }
+    return best;
+}
+
+} // namespace
+
+TEST_CASE("ReachesGoal") {
+    const Vec2d start{1.0, -2.0};
+    const double start_heading{0.3};
+    for (const double x : linspace(-8.0, 8.0, 5)) {
+        for (const double y : linspace(-8.0, 8.0, 5)) {
+            for (const double theta : linspace(-3.0, 3.0, 7)) {
+                const Vec2d goal{start + Vec2d{x, y}};
+                const double goal_heading{start_heading + theta};
+                const ReedsSheppPathd path{
+                    reedsSheppPath(start, start_heading, goal, goal_heading, kRadius)
+                };
+                REQUIRE(path.valid());
+                const ReedsSheppStated state{
+                    reedsSheppState(path, start, start_heading, path.length())
+                };
+                CHECK_EQ(state.position.x, doctest::Approx(goal.x).epsilon(kTolerance));
+                CHECK_EQ(state.position.y, doctest::Approx(goal.y).epsilon(kTolerance));
+                CHECK_EQ(
+                    std::remainder(state.heading - goal_heading, kTwoPi),
+                    doctest::Approx(0.0).epsilon(kTolerance)
+                );
+            }
+        }
+    }
+}
+
+TEST_CASE("OptimalAgainstBruteForce") {
+    const std::vector<Word> words{allWords()};
+    const Vec2d start{1.0, -2.0};
+    const double start_heading{0.3};
+    for (const double x : linspace(-8.0, 8.0, 5)) {
+        for (const double y : linspace(-8.0, 8.0, 5)) {
+            for (const double theta : linspace(-3.0, 3.0, 7)) {
+                const Vec2d offset{x, y};
+                const Vec2d goal{start + offset};
+                const double goal_heading{start_heading + theta};
+                const ReedsSheppPathd path{
+                    reedsSheppPath(start, start_heading, goal, goal_heading, kRadius)
+                };
+                const double brute_force{
+                    bruteForceLength(words, offset.rotate(-start_heading) / kRadius, theta) *
+                    kRadius
+                };
+                CHECK_LE(path.length(), brute_force + kTolerance);
+                CHECK_LE(
+                    path.length(),
+                    dubinsPath(start, start_heading, goal, goal_heading, kRadius).length() +
+                        kTolerance
+                );
+                CHECK_GE(path.length(), offset.euclidean() - kTolerance);
+            }
+        }
+    }
+}
+
+TEST_CASE("Symmetry") {
+    const Vec2d start{0.0, 0.0};
+    const auto length = [&start](double x, double y, double theta) -> double {
+        return reedsSheppPath(start, 0.0, Vec2d{x, y}, theta, kRadius).length();
+    };
+    for (const double x : linspace(-8.0, 8.0, 5)) {
+        for (const double y : linspace(-8.0, 8.0, 5)) {
+            for (const double theta : linspace(-3.0, 3.0, 7)) {
+                const double expected{length(x, y, theta)};
+                // Mirror about the x axis swaps left and right turns.
+                CHECK_EQ(length(x, -y, -theta), doctest::Approx(expected).epsilon(kTolerance));
+                // Time flip swaps forward and reverse gears.
+                CHECK_EQ(length(-x, y, -theta), doctest::Approx(expected).epsilon(kTolerance));
+                // Driving the path backwards from the goal to the start.
+                const double c{std::cos(theta)};
+                const double s{std::sin(theta)};
+                CHECK_EQ(
+                    length(x * c + y * s, x * s - y * c, theta),
+                    doctest::Approx(expected).epsilon(kTolerance)
+                );
+            }
+        }
+    }
+    CHECK_EQ(length(0.0, 0.0, 0.0), doctest::Approx(0.0));
+}
+
+} // namespace boyle::math
@@ -12,7 +12,9 @@
 
 #include "boyle/math/sparse_matrix/lil_matrix.hpp"
 
+#include <memory_resource>
 #include <sstream>
+#include <utility>
 
 #include "boost/archive/binary_iarchive.hpp"
 #include "boost/archive/binary_oarchive.hpp"
@@ -183,4 +185,35 @@ TEST_CASE("Serialization") {
     CHECK_EQ(other_lil_matrix.coeff(3, 3), 3775.0);
 }
 
+TEST_CASE("RowOnResource") {
+    std::pmr::monotonic_buffer_resource resource;
+    std::pmr::monotonic_buffer_resource other_resource;
+    LilMatrix lil_matrix(4, 8, &resource);
+
+    LilMatrix<>::row_dictionary_type same_row{&resource};
+    same_row.emplace(1, 2.5);
+    same_row.emplace(6, 0.0);
+    same_row.emplace(9, 1.0);
+    lil_matrix.updateRow(0, std::move(same_row));
+    CHECK(same_row.empty());
+
+    LilMatrix<>::row_dictionary_type other_row{&other_resource};
+    other_row.emplace(2, -1.5);
+    other_row.emplace(3, 4.0);
+    lil_matrix.updateRow(3, std::move(other_row));
+    CHECK_EQ(other_row.size(), 2);
+
+    const boost::unordered_flat_map<int, double> heap_row{{4, 7.0}};
+    lil_matrix.updateRow(2, heap_row);
+
+    CHECK_EQ(lil_matrix.nnzs(), 4);
+    CHECK_EQ(lil_matrix.coeff(0, 1), 2.5);
+    CHECK_EQ(lil_matrix.coeff(0, 6), 0.0);
+    CHECK_EQ(lil_matrix.coeff(3, 2), -1.5);
+    CHECK_EQ(lil_matrix.coeff(2, 4), 7.0);
+    for (const auto& [row, row_dictionary] : lil_matrix.row_dictionaries()) {
+        CHECK_EQ(row_dictionary.get_allocator().resource(), &resource);
+    }
+}
+
 } // namespace boyle::math
@@ -0,0 +1,140 @@
+/**
+ * @file vec2_array_test.cpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2024-06-25
+ *
+ * @copyright Copyright (c) 2024 Boyle Development Team
+ *            All rights reserved.
+ *
+ */
+
+#include "boyle/math/vec2_array.hpp"
+
+#include <array>
+#include <cmath>
+#include <numbers>
+#include <random>
+#include <span>
+#include <sstream>
+#include <vector>
+
+#include "boost/archive/binary_iarchive.hpp"
+#include "boost/archive/binary_oarchive.hpp"
+
+#include "boyle/common/utils/alloc_counter.hpp"
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+namespace boyle::math {
+
+namespace {
+
+auto randomPoints(std::size_t size, unsigned int seed) -> std::vector<Vec2d> {
+    std::mt19937 engine{seed};
+    std::uniform_real_distribution<double> dist{-100.0, 100.0};
+    std::vector<Vec2d> points;
+    points.reserve(size);
+    for (std::size_t i{0}; i < size; ++i) {
+        points.emplace_back(dist(engine), dist(engine));
+    }
+    return points;
+}
+
+} // namespace
+
+TEST_CASE("Container") {
+    const std::vector<Vec2d> points{randomPoints(37, 1)};
+    const Vec2dArray array{points};
+    REQUIRE_EQ(array.size(), points.size());
+    for (std::size_t i{0}; i < points.size(); ++i) {
+        CHECK_EQ(array[i], points[i]);
+    }
+    CHECK_EQ(array.toVector(), points);
+
+    const Vec2dArrayView view{points};
+    CHECK(view.interleaved());
+    CHECK_EQ(view.toSpan().data(), points.data());
+    CHECK_EQ(view.subview(5, 3)[1], points[6]);
+    CHECK(array.view().contiguous());
+    CHECK_EQ(array.view().subview(10, 4)[2], points[12]);
+
+    std::stringstream ss;
+    boost::archive::binary_oarchive oa{ss};
+    oa << array;
+    Vec2dArray other;
+    boost::archive::binary_iarchive ia{ss};
+    ia >> other;
+    CHECK_EQ(other.toVector(), points);
+}
+
+TEST_CASE("Kernels") {
+    constexpr std::size_t kSize{1003};
+    const std::vector<Vec2d> lhs_points{randomPoints(kSize, 2)};
+    const std::vector<Vec2d> rhs_points{randomPoints(kSize, 3)};
+    const Vec2dArray lhs{lhs_points};
+    const Vec2dArray rhs{rhs_points};
+
+    std::vector<double> soa_result(kSize);
+    std::vector<double> aos_result(kSize);
+    dot<double>(lhs, rhs, soa_result);
+    dot<double>(lhs_points, rhs_points, aos_result);
+    for (std::size_t i{0}; i < kSize; ++i) {
+        CHECK_EQ(soa_result[i], doctest::Approx(lhs_points[i].dot(rhs_points[i])));
+        CHECK_EQ(aos_result[i], doctest::Approx(soa_result[i]));
+    }
+
+    crossProj<double>(lhs, rhs, soa_result);
+    euclidean<double>(lhs_points, aos_result);
+    for (std::size_t i{0}; i < kSize; ++i) {
+        CHECK_EQ(soa_result[i], doctest::Approx(lhs_points[i].crossProj(rhs_points[i])));
+        CHECK_EQ(aos_result[i], doctest::Approx(lhs_points[i].euclidean()));
+    }
+
+    Vec2dArray normalized;
+    normalize<double>(lhs, normalized);
+    Vec2dArray rotated;
+    rotate<double>(lhs, std::numbers::pi / 3.0, rotated);
+    Vec2dArray transformed;
+    transform<double>(lhs, {2.0, 0.0, 0.0, 3.0}, Vec2d{1.0, -1.0}, transformed);
+    for (std::size_t i{0}; i < kSize; ++i) {
+        CHECK_EQ(normalized[i].x, doctest::Approx(lhs_points[i].normalized().x));
+        CHECK_EQ(normalized[i].y, doctest::Approx(lhs_points[i].normalized().y));
+        CHECK_EQ(rotated[i].x, doctest::Approx(lhs_points[i].rotate(std::numbers::pi / 3.0).x));
+        CHECK_EQ(rotated[i].y, doctest::Approx(lhs_points[i].rotate(std::numbers::pi / 3.0).y));
+        CHECK_EQ(transformed[i].x, doctest::Approx(lhs_points[i].x * 2.0 + 1.0));
+        CHECK_EQ(transformed[i].y, doctest::Approx(lhs_points[i].y * 3.0 - 1.0));
+    }
+
+    Vec2dArray in_place{lhs};
+    rotate<double>(in_place, std::numbers::pi / 3.0, in_place);
+    CHECK_EQ(in_place.toVector(), rotated.toVector());
+
+    CHECK_NO_ALLOC(dot<double>(lhs, rhs, soa_result));
+    CHECK_NO_ALLOC(euclidean<double>(lhs_points, aos_result));
+    CHECK_NO_ALLOC(normalize<double>(lhs, normalized));
+    CHECK_NO_ALLOC(rotate<double>(in_place, std::numbers::pi / 3.0, in_place));
+    CHECK_NO_ALLOC(nearestIndex<double>(lhs, Vec2d{0.0, 0.0}));
+}
+
+TEST_CASE("NearestIndex") {
+    const std::vector<Vec2d> points{randomPoints(5000, 4)};
+    const Vec2dArray array{points};
+    const std::vector<Vec2d> queries{randomPoints(100, 5)};
+    for (const Vec2d& query : queries) {
+        std::size_t expected{0};
+        for (std::size_t i{1}; i < points.size(); ++i) {
+            if (points[i].euclideanSqrTo(query) < points[expected].euclideanSqrTo(query)) {
+                expected = i;
+            }
+        }
+        CHECK_EQ(nearestIndex<double>(array, query), expected);
+        CHECK_EQ(nearestIndex<double>(points, query), expected);
+    }
+    const Vec2dArray duplicates{std::vector<Vec2d>(19, Vec2d{1.0, 1.0})};
+    CHECK_EQ(nearestIndex<double>(duplicates, Vec2d{0.0, 0.0}), 0);
+}
+
+} // namespace boyle::math
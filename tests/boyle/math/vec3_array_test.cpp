@@ -0,0 +1,93 @@
+/**
+ * @file vec3_array_test.cpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2024-06-25
+ *
+ * @copyright Copyright (c) 2024 Boyle Development Team
+ *            All rights reserved.
+ *
+ */
+
+#include "boyle/math/vec3_array.hpp"
+
+#include <cmath>
+#include <numbers>
+#include <random>
+#include <vector>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+
+namespace boyle::math {
+
+namespace {
+
+auto randomPoints(std::size_t size, unsigned int seed) -> std::vector<Vec3d> {
+    std::mt19937 engine{seed};
+    std::uniform_real_distribution<double> dist{-100.0, 100.0};
+    std::vector<Vec3d> points;
+    points.reserve(size);
+    for (std::size_t i{0}; i < size; ++i) {
+        points.emplace_back(dist(engine), dist(engine), dist(engine));
+    }
+    return points;
+}
+
+} // namespace
+
+TEST_CASE("Kernels") {
+    constexpr std::size_t kSize{517};
+    const std::vector<Vec3d> lhs_points{randomPoints(kSize, 2)};
+    const std::vector<Vec3d> rhs_points{randomPoints(kSize, 3)};
+    const Vec3dArray lhs{lhs_points};
+    const Vec3dArray rhs{rhs_points};
+    CHECK(Vec3dArrayView{lhs_points}.interleaved());
+    CHECK_EQ(Vec3dArrayView{lhs_points}.toSpan().data(), lhs_points.data());
+
+    std::vector<double> result(kSize);
+    dot<double>(lhs, rhs_points, result);
+    Vec3dArray crossed;
+    cross<double>(lhs, rhs, crossed);
+    for (std::size_t i{0}; i < kSize; ++i) {
+        CHECK_EQ(result[i], doctest::Approx(lhs_points[i].dot(rhs_points[i])));
+        const Vec3d expected{lhs_points[i].cross(rhs_points[i])};
+        CHECK_EQ(crossed[i].x, doctest::Approx(expected.x));
+        CHECK_EQ(crossed[i].y, doctest::Approx(expected.y));
+        CHECK_EQ(crossed[i].z, doctest::Approx(expected.z));
+    }
+
+    euclidean<double>(lhs, result);
+    Vec3dArray normalized;
+    normalize<double>(lhs, normalized);
+    for (std::size_t i{0}; i < kSize; ++i) {
+        CHECK_EQ(result[i], doctest::Approx(lhs_points[i].euclidean()));
+        CHECK_EQ(normalized[i].euclidean(), doctest::Approx(1.0));
+    }
+
+    Vec3dArray rotated;
+    rotate<double>(lhs, Vec3d{0.0, 0.0, 2.0}, std::numbers::pi * 0.5, rotated);
+    for (std::size_t i{0}; i < kSize; ++i) {
+        CHECK_EQ(rotated[i].x, doctest::Approx(-lhs_points[i].y));
+        CHECK_EQ(rotated[i].y, doctest::Approx(lhs_points[i].x));
+        CHECK_EQ(rotated[i].z, doctest::Approx(lhs_points[i].z));
+    }
+}
+
+TEST_CASE("NearestIndex") {
+    const std::vector<Vec3d> points{randomPoints(3000, 4)};
+    const Vec3dArray array{points};
+    for (const Vec3d& query : randomPoints(50, 5)) {
+        std::size_t expected{0};
+        for (std::size_t i{1}; i < points.size(); ++i) {
+            if (points[i].euclideanSqrTo(query) < points[expected].euclideanSqrTo(query)) {
+                expected = i;
+            }
+        }
+        CHECK_EQ(nearestIndex<double>(array, query), expected);
+        CHECK_EQ(nearestIndex<double>(points, query), expected);
+    }
+}
+
+} // namespace boyle::math
@@ -0,0 +1,263 @@
+/**
+ * @file qp_benchmark_tool.cpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief Solves a directory of captured QP problems under a grid of solver settings and reports
+ *        iterations, setup/solve time and residuals per variant.
+ * @version 0.1
+ * @date 2025-03-02
+ *
+ * @copyright Copyright (c) 2025 Boyle Development Team.
+ *            All rights reserved.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <exception>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "cxxopts.hpp"
+#include "fmt/format.h"
+#include "fmt/os.h"
+
+#include "boyle/cvxopm/info.hpp"
+#include "boyle/cvxopm/qp_capture.hpp"
+#include "boyle/cvxopm/settings.hpp"
+#include "boyle/cvxopm/solvers/osqp_solver.hpp"
+
+namespace {
+
+using ::boyle::cvxopm::Info;
+using ::boyle::cvxopm::QpCapture;
+using ::boyle::cvxopm::Settings;
+
+// OSQP reports status_val 1 for "solved".
+constexpr int kOsqpSolved{1};
+
+/**
+ * @brief Overrides applied on top of the captured settings; unset fields keep the captured value.
+ */
+struct Variant {
+    std::optional<double> rho{};
+    std::optional<int> scaling{};
+    std::optional<bool> polishing{};
+    std::optional<int> linsys_solver{};
+
+    auto name() const -> std::string {
+        std::string result;
+        if (rho) {
+            result += fmt::format("rho={0:g} ", *rho);
+        }
+        if (scaling) {
+            result += fmt::format("scaling={0:d} ", *scaling);
+        }
+        if (polishing) {
+            result += fmt::format("polishing={0:d} ", static_cast<int>(*polishing));
+        }
+        if (linsys_solver) {
+            result += fmt::format("linsys={0:d} ", *linsys_solver);
+        }
+        return result.empty() ? std::string{"captured"} : result.substr(0, result.size() - 1);
+    }
+
+    auto apply(Settings<double, int> settings) const -> Settings<double, int> {
+        settings.verbose = 0;
+        settings.rho = rho.value_or(settings.rho);
+        settings.scaling = scaling.value_or(settings.scaling);
+        settings.polishing = polishing.value_or(settings.polishing);
+        settings.linsys_solver = linsys_solver.value_or(settings.linsys_solver);
+        return settings;
+    }
+};
+
+struct Measurement {
+    bool ok{false};
+    Info<double, int> info{};
+};
+
+/**
+ * @brief Cartesian product of the given values; an empty list leaves that setting untouched.
+ */
+auto makeVariants(
+    const std::vector<double>& rhos, const std::vector<int>& scalings,
+    const std::vector<int>& polishings, const std::vector<int>& linsys_solvers
+) -> std::vector<Variant> {
+    std::vector<Variant> variants{Variant{}};
+    const auto expand = [&variants](const auto& values, auto setter) -> void {
+        if (values.empty()) {
+            return;
+        }
+        std::vector<Variant> expanded;
+        expanded.reserve(variants.size() * values.size());
+        for (const Variant& variant : variants) {
+            for (const auto value : values) {
+                Variant copy{variant};
+                setter(copy, value);
+                expanded.push_back(copy);
+            }
+        }
+        variants = std::move(expanded);
+        return;
+    };
+    expand(rhos, [](Variant& variant, double value) -> void { variant.rho = value; });
+    expand(scalings, [](Variant& variant, int value) -> void { variant.scaling = value; });
+    expand(polishings, [](Variant& variant, int value) -> void { variant.polishing = value != 0; });
+    expand(linsys_solvers, [](Variant& variant, int value) -> void {
+        variant.linsys_solver = value;
+    });
+    if (variants.front().name() != "captured") {
+        variants.insert(variants.begin(), Variant{});
+    }
+    return variants;
+}
+
+/**
+ * @brief Solves `repeat` times and keeps the fastest setup and solve time; iterations and
+ * residuals are deterministic.
+ */
+auto measure(const QpCapture<double, int>& capture, const Variant& variant, int repeat)
+    -> Measurement {
+    const ::boyle::cvxopm::OsqpSolver<double, int> solver{variant.apply(capture.settings)};
+    Measurement measurement;
+    for (int i{0}; i < repeat; ++i) {
+        try {
+            const auto [result, info] =
+                solver.solve(capture.qp_problem, capture.prim_vars_0, capture.dual_vars_0);
+            if (!measurement.ok) {
+                measurement.ok = true;
+                measurement.info = info;
+            } else {
+                Info<double, int>& best{measurement.info};
+                best.setup_time = std::min(best.setup_time, info.setup_time);
+                best.solve_time = std::min(best.solve_time, info.solve_time);
+            }
+        } catch (const std::exception&) {
+            // Backends that are not compiled into OSQP fail at setup.
+            return Measurement{};
+        }
+    }
+    return measurement;
+}
+
+template <typename T>
+auto optionList(const cxxopts::ParseResult& result, const std::string& name) -> std::vector<T> {
+    return result.count(name) != 0 ? result[name].as<std::vector<T>>() : std::vector<T>{};
+}
+
+auto percentile(std::vector<double> values, double q) -> double {
+    if (values.empty()) {
+        return std::nan("");
+    }
+    const auto k{static_cast<std::size_t>(std::ceil(q * static_cast<double>(values.size())))};
+    const std::size_t index{std::clamp<std::size_t>(k, 1, values.size()) - 1};
+    std::ranges::nth_element(values, values.begin() + index);
+    return values[index];
+}
+
+} // namespace
+
+auto main(int argc, char* argv[]) -> int {
+    cxxopts::Options options(
+        "cvxopm_qp_benchmark_tool", "benchmark solver settings on captured QP problems"
+    );
+    options.add_options()(
+        "captures", "directory written by enableQpCapture", cxxopts::value<std::string>()
+    );
+    options.add_options()("rho", "rho values to try", cxxopts::value<std::vector<double>>());
+    options.add_options()(
+        "scaling", "scaling iterations to try", cxxopts::value<std::vector<int>>()
+    );
+    options.add_options()(
+        "polishing", "polishing flags to try", cxxopts::value<std::vector<int>>()
+    );
+    options.add_options()(
+        "linsys-solver", "linear system backends to try, 1 = direct, 2 = indirect",
+        cxxopts::value<std::vector<int>>()
+    );
+    options.add_options()(
+        "repeat", "solves per problem and variant, the fastest is kept",
+        cxxopts::value<int>()->default_value("3")
+    );
+    options.add_options()("csv", "write per-problem results as csv", cxxopts::value<std::string>());
+    options.add_options()("h,help", "print usage");
+    options.parse_positional({"captures"});
+    const cxxopts::ParseResult result = options.parse(argc, argv);
+    if (result.count("help") != 0 || result.count("captures") == 0) {
+        fmt::print("{0:s}\n", options.help());
+        return result.count("help") != 0 ? 0 : 1;
+    }
+
+    try {
+        const std::vector<Variant> variants{makeVariants(
+            optionList<double>(result, "rho"), optionList<int>(result, "scaling"),
+            optionList<int>(result, "polishing"), optionList<int>(result, "linsys-solver")
+        )};
+        const int repeat{std::max(result["repeat"].as<int>(), 1)};
+        const std::filesystem::path directory{result["captures"].as<std::string>()};
+        const auto captures{::boyle::cvxopm::loadQpCaptures(directory)};
+        fmt::print("{0:d} problems, {1:d} variants\n", captures.size(), variants.size());
+
+        std::optional<fmt::ostream> csv;
+        if (result.count("csv") != 0) {
+            csv.emplace(fmt::output_file(result["csv"].as<std::string>()));
+            csv->print("problem,variant,ok,status_val,iter,setup_us,solve_us,obj_val,prim_res,"
+                       "dual_res\n");
+        }
+
+        fmt::print(
+            "{0:<40s} {1:>9s} {2:>8s} {3:>10s} {4:>10s} {5:>10s} {6:>10s} {7:>10s} {8:>10s}\n",
+            "variant", "solved", "p50 iter", "p50 setup", "p99 setup", "p50 solve", "p99 solve",
+            "max prim", "max dual"
+        );
+        for (const Variant& variant : variants) {
+            std::size_t num_solved{0};
+            std::vector<double> iters;
+            std::vector<double> setup_times;
+            std::vector<double> solve_times;
+            double max_prim_res{0.0};
+            double max_dual_res{0.0};
+            for (const auto& [path, capture] : captures) {
+                const Measurement measurement{measure(capture, variant, repeat)};
+                const Info<double, int>& info{measurement.info};
+                if (csv) {
+                    csv->print(
+                        "{0:s},{1:s},{2:d},{3:d},{4:d},{5:.3f},{6:.3f},{7:.9e},{8:.3e},{9:.3e}\n",
+                        path.filename().string(), variant.name(), static_cast<int>(measurement.ok),
+                        info.status_val, info.iter, info.setup_time * 1e6, info.solve_time * 1e6,
+                        info.obj_val, info.prim_res, info.dual_res
+                    );
+                }
+                if (!measurement.ok) {
+                    continue;
+                }
+                num_solved += info.status_val == kOsqpSolved ? 1 : 0;
+                iters.push_back(static_cast<double>(info.iter));
+                setup_times.push_back(info.setup_time * 1e6);
+                solve_times.push_back(info.solve_time * 1e6);
+                max_prim_res = std::max(max_prim_res, info.prim_res);
+                max_dual_res = std::max(max_dual_res, info.dual_res);
+            }
+            if (iters.empty()) {
+                fmt::print("{0:<40s} {1:>9s}\n", variant.name(), "n/a");
+                continue;
+            }
+            fmt::print(
+                "{0:<40s} {1:>9s} {2:>8.0f} {3:>10.1f} {4:>10.1f} {5:>10.1f} {6:>10.1f} "
+                "{7:>10.2e} {8:>10.2e}\n",
+                variant.name(), fmt::format("{0:d}/{1:d}", num_solved, captures.size()),
+                percentile(iters, 0.5), percentile(setup_times, 0.5),
+                percentile(setup_times, 0.99), percentile(solve_times, 0.5),
+                percentile(solve_times, 0.99), max_prim_res, max_dual_res
+            );
+        }
+    } catch (const std::exception& e) {
+        fmt::print(stderr, "error: {0:s}\n", e.what());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,281 @@
+/**
+ * @file model_replay_tool.cpp
+ * @author Houchen Li (houchen_li@hotmail.com)
+ * @brief Replays recorded route line model inputs and reports per-stage latency. Run one build
+ *        with --output, then another build on the same recording with --baseline to compare.
+ * @version 0.1
+ * @date 2025-02-27
+ *
+ * @copyright Copyright (c) 2025 Boyle Development Team.
+ *            All rights reserved.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "boost/archive/binary_iarchive.hpp"
+#include "boost/archive/binary_oarchive.hpp"
+#include "boost/serialization/string.hpp"
+#include "boost/serialization/vector.hpp"
+#include "cxxopts.hpp"
+#include "fmt/format.h"
+#include "fmt/os.h"
+
+#include "boyle/kinetics/models/model_inputs.hpp"
+#include "boyle/kinetics/models/model_recorder.hpp"
+#include "boyle/kinetics/models/model_replay.hpp"
+
+namespace {
+
+using ::boyle::kinetics::ModelCallKind;
+using ::boyle::kinetics::ModelRecorder;
+using ::boyle::kinetics::ReplayReport;
+using ::boyle::kinetics::ReplayStage;
+using ::boyle::kinetics::RouteLineQuinticAccInputs;
+using ::boyle::kinetics::RouteLineQuinticOffsetInputs;
+
+struct ReplayRun {
+    std::string model_name{};
+    std::vector<std::uint64_t> sequences{};
+    std::vector<ReplayReport> reports{};
+
+    template <typename Archive>
+    auto serialize(Archive& archive, [[maybe_unused]] const unsigned int version) -> void {
+        archive & model_name;
+        archive & sequences;
+        archive & reports;
+        return;
+    }
+};
+
+auto totalNs(const ReplayReport& report) noexcept -> std::int64_t {
+    std::int64_t total{report.build_ns};
+    for (const ReplayStage& stage : report.stages) {
+        total += stage.elapsed_ns;
+    }
+    return total;
+}
+
+auto solveNs(const ReplayReport& report) noexcept -> std::int64_t {
+    std::int64_t total{0};
+    for (const ReplayStage& stage : report.stages) {
+        if (stage.kind == ModelCallKind::SOLVE) {
+            total += stage.elapsed_ns;
+        }
+    }
+    return total;
+}
+
+auto percentile(std::vector<std::int64_t> values, double q) -> double {
+    if (values.empty()) {
+        return 0.0;
+    }
+    const auto k{static_cast<std::size_t>(std::ceil(q * static_cast<double>(values.size())))};
+    const std::size_t index{std::clamp<std::size_t>(k, 1, values.size()) - 1};
+    std::ranges::nth_element(values, values.begin() + index);
+    return static_cast<double>(values[index]) * 1e-3;
+}
+
+/**
+ * @brief Replays every cycle `repeat` times and keeps, per stage, the fastest observation: the
+ * minimum is the least noisy latency estimate on a shared machine.
+ */
+template <typename Inputs>
+auto replayRecording(std::istream& is, int repeat) -> ReplayRun {
+    ReplayRun run;
+    run.model_name = Inputs::kModelName;
+    const std::vector<::boyle::kinetics::RecordedCycle<Inputs>> cycles{
+        ModelRecorder<Inputs>::load(is)
+    };
+    run.sequences.reserve(cycles.size());
+    run.reports.reserve(cycles.size());
+    for (const auto& cycle : cycles) {
+        ReplayReport best{::boyle::kinetics::replay(cycle.inputs)};
+        for (int i{1}; i < repeat; ++i) {
+            const ReplayReport report{::boyle::kinetics::replay(cycle.inputs)};
+            best.build_ns = std::min(best.build_ns, report.build_ns);
+            for (std::size_t j{0}; j < best.stages.size(); ++j) {
+                best.stages[j].elapsed_ns =
+                    std::min(best.stages[j].elapsed_ns, report.stages[j].elapsed_ns);
+            }
+        }
+        run.sequences.push_back(cycle.sequence);
+        run.reports.push_back(std::move(best));
+    }
+    return run;
+}
+
+auto printStageSummary(const ReplayRun& run) -> void {
+    std::map<std::string_view, std::vector<std::int64_t>> stage_times;
+    std::vector<std::int64_t> totals;
+    totals.reserve(run.reports.size());
+    for (const ReplayReport& report : run.reports) {
+        stage_times["construct"].push_back(report.build_ns);
+        for (const ReplayStage& stage : report.stages) {
+            stage_times[::boyle::kinetics::modelCallName(stage.kind)].push_back(stage.elapsed_ns);
+        }
+        totals.push_back(totalNs(report));
+    }
+    fmt::print("{0:s}: {1:d} cycles\n", run.model_name, run.reports.size());
+    fmt::print(
+        "{0:<20s} {1:>8s} {2:>12s} {3:>12s} {4:>12s}\n", "stage", "calls", "p50 [us]", "p99 [us]",
+        "max [us]"
+    );
+    for (auto& [name, times] : stage_times) {
+        fmt::print(
+            "{0:<20s} {1:>8d} {2:>12.1f} {3:>12.1f} {4:>12.1f}\n", name, times.size(),
+            percentile(times, 0.5), percentile(times, 0.99), percentile(times, 1.0)
+        );
+    }
+    fmt::print(
+        "{0:<20s} {1:>8d} {2:>12.1f} {3:>12.1f} {4:>12.1f}\n", "cycle", totals.size(),
+        percentile(totals, 0.5), percentile(totals, 0.99), percentile(totals, 1.0)
+    );
+    return;
+}
+
+auto writeCsv(const std::string& file_path, const ReplayRun& run) -> void {
+    fmt::ostream out{fmt::output_file(file_path)};
+    out.print("sequence,total_ns,build_ns,solve_ns,solves,iter,status_val,obj_val,prim_res,"
+              "dual_res\n");
+    for (std::size_t i{0}; i < run.reports.size(); ++i) {
+        const ReplayReport& report{run.reports[i]};
+        const auto& info{report.infos.back()};
+        out.print(
+            "{0:d},{1:d},{2:d},{3:d},{4:d},{5:d},{6:d},{7:.9e},{8:.3e},{9:.3e}\n", run.sequences[i],
+            totalNs(report), report.build_ns, solveNs(report), report.infos.size(), info.iter,
+            info.status_val, info.obj_val, info.prim_res, info.dual_res
+        );
+    }
+    return;
+}
+
+auto compareWithBaseline(const ReplayRun& run, const ReplayRun& baseline, double tolerance)
+    -> int {
+    if (run.model_name != baseline.model_name || run.sequences != baseline.sequences) {
+        throw std::runtime_error("Baseline was not produced from the same recording.");
+    }
+    std::vector<std::int64_t> totals;
+    std::vector<std::int64_t> baseline_totals;
+    int num_deviations{0};
+    for (std::size_t i{0}; i < run.reports.size(); ++i) {
+        const ReplayReport& report{run.reports[i]};
+        const ReplayReport& other{baseline.reports[i]};
+        totals.push_back(totalNs(report));
+        baseline_totals.push_back(totalNs(other));
+        double deviation{report.solution.size() == other.solution.size()
+                             ? 0.0
+                             : std::numeric_limits<double>::infinity()};
+        for (std::size_t j{0}; j < std::min(report.solution.size(), other.solution.size()); ++j) {
+            deviation = std::max(deviation, std::abs(report.solution[j] - other.solution[j]));
+        }
+        if (deviation > tolerance) {
+            ++num_deviations;
+            fmt::print(
+                "cycle {0:d}: solution deviates by {1:.3e}, iterations {2:d} -> {3:d}\n",
+                run.sequences[i], deviation, other.infos.back().iter, report.infos.back().iter
+            );
+        }
+    }
+    fmt::print(
+        "{0:<12s} {1:>14s} {2:>14s} {3:>10s}\n", "cycle time", "baseline [us]", "this [us]", "ratio"
+    );
+    for (const double q : {0.5, 0.9, 0.99, 1.0}) {
+        const double lhs{percentile(baseline_totals, q)};
+        const double rhs{percentile(totals, q)};
+        fmt::print(
+            "p{0:<11.0f} {1:>14.1f} {2:>14.1f} {3:>10.3f}\n", q * 100.0, lhs, rhs,
+            lhs > 0.0 ? rhs / lhs : 0.0
+        );
+    }
+    fmt::print(
+        "{0:d} of {1:d} cycles deviate beyond {2:.1e}\n", num_deviations, totals.size(), tolerance
+    );
+    return num_deviations == 0 ? 0 : 1;
+}
+
+} // namespace
+
+auto main(int argc, char* argv[]) -> int {
+    cxxopts::Options options(
+        "kinetics_model_replay_tool", "replay recorded route line model inputs and time them"
+    );
+    options.add_options()(
+        "recording", "recording dumped by ModelRecorder", cxxopts::value<std::string>()
+    );
+    options.add_options()(
+        "repeat", "replays per cycle, the fastest is kept",
+        cxxopts::value<int>()->default_value("5")
+    );
+    options.add_options()(
+        "output", "save the results for a later --baseline run", cxxopts::value<std::string>()
+    );
+    options.add_options()(
+        "baseline", "results of another build to compare against", cxxopts::value<std::string>()
+    );
+    options.add_options()("csv", "write per-cycle results as csv", cxxopts::value<std::string>());
+    options.add_options()(
+        "tolerance", "allowed solution deviation from the baseline",
+        cxxopts::value<double>()->default_value("1e-6")
+    );
+    options.add_options()("h,help", "print usage");
+    options.parse_positional({"recording"});
+    const cxxopts::ParseResult result = options.parse(argc, argv);
+    if (result.count("help") != 0 || result.count("recording") == 0) {
+        fmt::print("{0:s}\n", options.help());
+        return result.count("help") != 0 ? 0 : 1;
+    }
+
+    try {
+        const std::string recording{result["recording"].as<std::string>()};
+        const int repeat{std::max(result["repeat"].as<int>(), 1)};
+        std::ifstream ifs{recording, std::ios::binary};
+        if (!ifs) {
+            throw std::runtime_error(fmt::format("Cannot open {0:s}.", recording));
+        }
+        const std::string model_name{ModelRecorder<RouteLineQuinticAccInputs>::peekModelName(ifs)};
+        ifs.seekg(0);
+
+        ReplayRun run;
+        if (model_name == RouteLineQuinticOffsetInputs::kModelName) {
+            run = replayRecording<RouteLineQuinticOffsetInputs>(ifs, repeat);
+        } else if (model_name == RouteLineQuinticAccInputs::kModelName) {
+            run = replayRecording<RouteLineQuinticAccInputs>(ifs, repeat);
+        } else {
+            throw std::runtime_error(fmt::format("Unknown model {0:s} in recording.", model_name));
+        }
+        printStageSummary(run);
+
+        if (result.count("csv") != 0) {
+            writeCsv(result["csv"].as<std::string>(), run);
+        }
+        if (result.count("output") != 0) {
+            std::ofstream ofs{result["output"].as<std::string>(), std::ios::binary};
+            boost::archive::binary_oarchive oa{ofs};
+            oa << run;
+        }
+        if (result.count("baseline") != 0) {
+            std::ifstream bfs{result["baseline"].as<std::string>(), std::ios::binary};
+            boost::archive::binary_iarchive ia{bfs};
+            ReplayRun baseline;
+            ia >> baseline;
+            return compareWithBaseline(run, baseline, result["tolerance"].as<double>());
+        }
+    } catch (const std::exception& e) {
+        fmt::print(stderr, "error: {0:s}\n", e.what());
+        return 1;
+    }
+    return 0;
+}